@@ -17,6 +17,7 @@
 #define ACTIVATION_QUEUE_H
 
 #include <Arduino.h>
+#include "config.h"
 #include "platform.h"
 
 // Forward declarations
@@ -66,8 +67,11 @@ struct MotorEvent {
  * @class ActivationQueue
  * @brief Unified queue for motor events (activations AND deactivations)
  *
- * Manages a fixed-size array of motor events. The motor task processes
- * events in time order using FreeRTOS timing with busy-wait for precision.
+ * Events are kept in a time-sorted ring buffer: the earliest event is always
+ * at the head, so peek/dequeue are O(1) under the mutex (the motor task takes
+ * the lock right before its busy-wait deadline). Insertion is O(n) from the
+ * tail, which is short in practice since macrocycle events arrive nearly in
+ * time order. Events with equal times are dequeued in insertion order.
  *
  * Usage:
  * 1. Call enqueue() to add motor activations (auto-adds deactivation event)
@@ -77,7 +81,7 @@ struct MotorEvent {
  */
 class ActivationQueue {
 public:
-    static constexpr uint8_t MAX_EVENTS = 64;  // MACROCYCLE_MAX_EVENTS activations + deactivations (30 at 5 motors) + margin
+    static constexpr uint8_t MAX_EVENTS = ACTIVATION_QUEUE_MAX_EVENTS;  // MACROCYCLE_MAX_EVENTS activations + deactivations (30 at 5 motors) + margin
 
     ActivationQueue();
 
@@ -119,6 +123,32 @@ public:
      */
     bool dequeueNextEvent(MotorEvent& event);
 
+    /**
+     * @brief Dequeue every event due at or before a deadline (time order)
+     * @param untilUs Latest event time to include (local clock, microseconds)
+     * @param events Output buffer
+     * @param maxEvents Capacity of events
+     * @return Number of events dequeued (0 if none due or lock unavailable)
+     */
+    uint8_t dequeueDueEvents(uint64_t untilUs, MotorEvent* events, uint8_t maxEvents);
+
+    /**
+     * @brief Remove a late head activation and its paired deactivation
+     * @param activation The activation, as returned by peekNextEvent()
+     * @return false if it is no longer at the head (queue changed meanwhile)
+     *
+     * The pair is the first DEACTIVATE for the same finger after the
+     * activation's time (a previous pulse's deactivation at the same instant
+     * is queued before it and is kept).
+     */
+    bool dropActivation(const MotorEvent& activation);
+
+    /**
+     * @brief Delay every pending event by the same amount (order is kept)
+     * @param delayUs Shift in microseconds
+     */
+    void delayPending(uint64_t delayUs);
+
     /**
      * @brief Get time of next event
      * @return Next event time, or UINT64_MAX if queue empty
@@ -126,14 +156,28 @@ public:
     uint64_t getNextEventTime() const;
 
     /**
-     * @brief Get count of pending events
+     * @brief Get count of pending events (O(1), lock-free snapshot)
      */
-    uint8_t eventCount() const;
+    uint8_t eventCount() const { return _count; }
 
     /**
-     * @brief Check if queue is empty
+     * @brief Check if queue is empty (O(1), lock-free snapshot)
      */
-    bool isEmpty() const;
+    bool isEmpty() const { return _count == 0; }
+
+    /**
+     * @brief Visit every pending event in time order (under the queue mutex)
+     * @param visit Called once per event; must not call back into the queue
+     * @return Number of events visited (0 if empty or lock unavailable)
+     */
+    uint8_t forEachEvent(void (*visit)(const MotorEvent& event)) const;
+
+    /**
+     * @brief Change counter, bumped by enqueue() and clear() (not dequeues)
+     *
+     * The motor task re-plans pre-selection when this moves.
+     */
+    uint32_t revision() const { return _revision; }
 
     /**
      * @brief Notify motor task that new event was added
@@ -189,29 +233,36 @@ public:
     uint64_t getNextActivationTime() const { return getNextEventTime(); }
 
 private:
-    MotorEvent _events[MAX_EVENTS];
+    static_assert((MAX_EVENTS & (MAX_EVENTS - 1)) == 0, "MAX_EVENTS must be a power of two");
+    static_assert(MAX_EVENTS >= 2 && MAX_EVENTS <= 128, "ACTIVATION_QUEUE_MAX_EVENTS out of range");
+
+    MotorEvent _events[MAX_EVENTS];  // Ring buffer, sorted by timeUs from _head
+    uint8_t _head;                   // Ring index of earliest event
+    volatile uint8_t _count;         // Pending events (written under mutex)
+    volatile uint32_t _revision;     // Bumped under mutex by enqueue()/clear()
     HapticController* _haptic;
     TaskHandle_t _motorTaskHandle;
     SemaphoreHandle_t _queueMutex;   // Mutex for thread-safe queue access
     bool _initialized;
 
     /**
-     * @brief Find an empty slot in the queue
-     * @return Slot index, or -1 if full
+     * @brief Map a sorted position (0 = earliest) to a ring index
      */
-    int8_t findEmptySlot() const;
+    uint8_t ringIndex(uint8_t pos) const {
+        return static_cast<uint8_t>((_head + pos) & (MAX_EVENTS - 1));
+    }
 
     /**
-     * @brief Find next event by time
-     * @return Slot index of earliest event, or -1 if none
+     * @brief Remove the event at a sorted position, closing the gap
+     * @note Caller must hold mutex
      */
-    int8_t findNextEvent() const;
+    void removeAt(uint8_t pos);
 
     /**
-     * @brief Add a single event to queue
-     * @return Slot index if added, -1 if full
+     * @brief Insert a single event at its time-sorted position
+     * @note Caller must hold mutex and have checked capacity
      */
-    int8_t addEvent(const MotorEvent& event);
+    void insertSorted(const MotorEvent& event);
 };
 
 // Global instance
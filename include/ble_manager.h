@@ -9,7 +9,7 @@
  *
  * Both backends implement:
  * - Nordic UART Service for data transfer
- * - Multi-connection support (PRIMARY: phone + SECONDARY)
+ * - Multi-connection support (PRIMARY: phone + BLE_MAX_SECONDARIES SECONDARYs)
  * - EOT-framed message protocol
  * - Callback-driven event handling
  */
@@ -24,6 +24,12 @@
 
 #include "config.h"
 #include "types.h"
+#include "ble_tx_queue.h"
+#include "conn_param_controller.h"
+#include "phone_protocol.h"
+#include "ble_rx_framer.h"
+
+class SyncCommand;
 
 // =============================================================================
 // BLE CONSTANTS
@@ -36,7 +42,7 @@
 
 // Connection identifiers
 #define CONN_HANDLE_INVALID 0xFFFF
-#define MAX_CONNECTIONS 2
+#define MAX_CONNECTIONS (1 + BLE_MAX_SECONDARIES)  // Phone + SECONDARY link(s)
 
 // Message protocol
 #define EOT_CHAR 0x04  // End of transmission marker
@@ -72,10 +78,13 @@ struct BBConnection {
     uint32_t connectedAt;
     volatile bool pendingIdentify;       // Waiting for IDENTIFY message
     uint32_t identifyStartTime; // When identification period started
+    uint8_t phoneProtocol;      // PHONE_PROTOCOL_* negotiated at IDENTIFY:PHONE
+    uint16_t attMtu;            // Negotiated ATT MTU (chunk size = bleNotifyPayload(attMtu))
+    uint32_t identifyOrder;     // Identification order; the oldest SECONDARY is the first
 
-    // Message receive buffer
+    // Message receive buffer (frames are views into rxBuffer, see BLERxFramer)
     char rxBuffer[RX_BUFFER_SIZE];
-    uint16_t rxIndex;
+    BLERxFramer rx;
     uint64_t rxTimestamp;  // Timestamp when first byte of current message was received
 
     // Connection interval tracking (for diagnostics)
@@ -91,7 +100,10 @@ struct BBConnection {
         connectedAt(0),
         pendingIdentify(false),
         identifyStartTime(0),
-        rxIndex(0),
+        phoneProtocol(PHONE_PROTOCOL_TEXT),
+        attMtu(BLE_ATT_MTU_MIN),
+        identifyOrder(0),
+        rx(rxBuffer, sizeof(rxBuffer)),
         rxTimestamp(0),
         negotiatedIntervalUnits(0),
         intervalQueriedAt(0),
@@ -100,6 +112,10 @@ struct BBConnection {
         memset(rxBuffer, 0, sizeof(rxBuffer));
     }
 
+    // rx points into this connection's own rxBuffer
+    BBConnection(const BBConnection&) = delete;
+    BBConnection& operator=(const BBConnection&) = delete;
+
     void reset() {
         connHandle = CONN_HANDLE_INVALID;
         type = ConnectionType::NONE;
@@ -107,7 +123,10 @@ struct BBConnection {
         connectedAt = 0;
         pendingIdentify = false;
         identifyStartTime = 0;
-        rxIndex = 0;
+        phoneProtocol = PHONE_PROTOCOL_TEXT;
+        attMtu = BLE_ATT_MTU_MIN;
+        identifyOrder = 0;
+        rx.reset();
         rxTimestamp = 0;
         negotiatedIntervalUnits = 0;
         intervalQueriedAt = 0;
@@ -124,17 +143,15 @@ struct BBConnection {
 // Callback function types
 typedef void (*BLEConnectCallback)(uint16_t connHandle, ConnectionType type);
 typedef void (*BLEDisconnectCallback)(uint16_t connHandle, ConnectionType type, uint8_t reason);
-typedef void (*BLEMessageCallback)(uint16_t connHandle, const char* message, uint64_t rxTimestamp);
-
-// Deferred-timestamp kinds for sync messages (serialized at radio handoff)
-enum class TxStampKind : uint8_t {
-    NONE = 0,
-    PING_T1,   // PRIMARY -> SECONDARY: stamp T1 at write time
-    PONG_T3    // SECONDARY -> PRIMARY: stamp T3 at write time
-};
+// message is NUL-terminated and valid only for the duration of the call
+typedef void (*BLEMessageCallback)(uint16_t connHandle, const char* message, size_t length, uint64_t rxTimestamp);
 
 typedef void (*BLETxStampCallback)(TxStampKind kind, uint32_t seqId, uint64_t txTimeUs);
 
+// data is one complete periodic advertising payload, valid only for the call;
+// rxTimestamp is getMicros() at its first fragment
+typedef void (*BLEScheduleBroadcastCallback)(const uint8_t* data, size_t length, uint64_t rxTimestamp);
+
 // =============================================================================
 // BLE MANAGER CLASS
 // =============================================================================
@@ -248,6 +265,22 @@ public:
      */
     bool isPhoneConnected() const;
 
+    /**
+     * @brief Response format the phone asked for (PHONE_PROTOCOL_TEXT if none)
+     */
+    uint8_t getPhoneProtocol() const;
+
+    /**
+     * @brief Number of messages waiting in the TX queue
+     *
+     * Unlocked read - approximate, intended for low-priority senders that
+     * back off while the queue is busy.
+     */
+    uint8_t getTxQueueCount() const { return _txQueue.count(); }
+
+    /** @brief Received frames dropped for exceeding RX_BUFFER_SIZE (all connections, since boot) */
+    uint32_t getRxOversizeCount() const { return _rxOversizeFrames; }
+
     /**
      * @brief Get the type of an active connection
      * @param connHandle Connection handle to look up
@@ -288,30 +321,65 @@ public:
      * @brief Send message to a specific connection
      * @param connHandle Connection handle
      * @param message Message string (EOT will be appended automatically)
+     * @param priority TX class (DEFAULT: MACROCYCLE for a glove, RESPONSE for the phone)
      * @return true if sent successfully
      */
-    bool send(uint16_t connHandle, const char* message);
+    bool send(uint16_t connHandle, const char* message, TxPriority priority = TxPriority::DEFAULT);
+
+    /**
+     * @brief Reserve a TX slot to serialize a message into (zero-copy send)
+     *
+     * Every reserved span must be passed to commitTx(), even on a serialize
+     * failure (len 0), or its class stalls behind it. Reservation order is
+     * transmit order within a class.
+     *
+     * @param connHandle Connection handle
+     * @param maxLen Buffer size the serializer needs, including the NUL
+     * @param priority TX class (DEFAULT: MACROCYCLE for a glove, RESPONSE for the phone)
+     * @return Span; empty if not connected, maxLen exceeds the slot, or the class is full
+     */
+    BLETxSpan reserveTx(uint16_t connHandle, size_t maxLen, TxPriority priority = TxPriority::DEFAULT);
+
+    /**
+     * @brief Queue a reserved span for transmission
+     * @param span Span from reserveTx() (an empty span is ignored)
+     * @param len Message length without NUL; 0 abandons the slot unsent
+     * @return true if queued
+     */
+    bool commitTx(BLETxSpan& span, size_t len);
+
+    /**
+     * @brief Serialize a sync command straight into a TX slot
+     * @param connHandle Connection handle
+     * @param command Command to serialize
+     * @param priority TX class (DEFAULT resolved from the connection type)
+     * @return true if queued
+     */
+    bool sendCommand(uint16_t connHandle, const SyncCommand& command, TxPriority priority = TxPriority::DEFAULT);
 
     /**
-     * @brief Send message to SECONDARY device (PRIMARY mode)
+     * @brief Send message to every SECONDARY device (PRIMARY mode)
      * @param message Message string
-     * @return true if sent successfully
+     * @param priority TX class
+     * @return true if queued for every connected SECONDARY (false if none)
      */
-    bool sendToSecondary(const char* message);
+    bool sendToSecondary(const char* message, TxPriority priority = TxPriority::DEFAULT);
 
     /**
      * @brief Send message to phone (PRIMARY mode)
      * @param message Message string
+     * @param priority TX class
      * @return true if sent successfully
      */
-    bool sendToPhone(const char* message);
+    bool sendToPhone(const char* message, TxPriority priority = TxPriority::DEFAULT);
 
     /**
      * @brief Send message to PRIMARY device (SECONDARY mode)
      * @param message Message string
+     * @param priority TX class
      * @return true if sent successfully
      */
-    bool sendToPrimary(const char* message);
+    bool sendToPrimary(const char* message, TxPriority priority = TxPriority::DEFAULT);
 
     /**
      * @brief Broadcast message to all connections
@@ -322,9 +390,10 @@ public:
 
     /**
      * @brief Enqueue a PING whose T1 is stamped at SoftDevice handoff (PRIMARY)
+     * @param connHandle Target SECONDARY (CONN_HANDLE_INVALID = the first one)
      * @return true if enqueued
      */
-    bool sendPingStamped(uint32_t seqId);
+    bool sendPingStamped(uint32_t seqId, uint16_t connHandle = CONN_HANDLE_INVALID);
 
     /**
      * @brief Enqueue a PONG whose T3 is stamped at SoftDevice handoff (SECONDARY)
@@ -339,6 +408,40 @@ public:
      */
     void setTxStampCallback(BLETxStampCallback callback);
 
+    // =========================================================================
+    // SCHEDULE BROADCAST (SYNC_PERIODIC_ADV_ENABLED, ESP32-S3 only)
+    // =========================================================================
+
+    /**
+     * @brief Replace the periodic advertising payload with a macrocycle (PRIMARY)
+     *
+     * The train runs from begin() on; see schedule_broadcast.h for the payload.
+     *
+     * @param macrocycle Schedule to broadcast (its clockOffset is not sent)
+     * @return false if the train is not running or the payload does not fit
+     */
+    bool broadcastSchedule(const Macrocycle& macrocycle);
+
+    /**
+     * @brief Sync to the connected PRIMARY's periodic train (SECONDARY)
+     *
+     * Scans passively until the controller syncs, then delivers every report
+     * through the schedule broadcast callback. Sync loss restarts the scan.
+     *
+     * @return false if unsupported, not connected or the scan failed to start
+     */
+    bool startScheduleListener();
+
+    /**
+     * @brief Drop the train sync and stop its scan (SECONDARY)
+     */
+    void stopScheduleListener();
+
+    /**
+     * @brief Register callback for received schedule broadcasts (SECONDARY)
+     */
+    void setScheduleBroadcastCallback(BLEScheduleBroadcastCallback callback);
+
     // =========================================================================
     // CALLBACKS
     // =========================================================================
@@ -368,10 +471,18 @@ public:
     DeviceRole getRole() const { return _role; }
 
     /**
-     * @brief Get SECONDARY connection handle (PRIMARY mode)
+     * @brief Get the first SECONDARY connection handle (PRIMARY mode)
      */
     uint16_t getSecondaryHandle() const;
 
+    /**
+     * @brief Get every connected SECONDARY handle, first one first (PRIMARY mode)
+     * @param handles Output array
+     * @param maxHandles Capacity of handles
+     * @return Number of handles written
+     */
+    uint8_t getSecondaryHandles(uint16_t* handles, uint8_t maxHandles) const;
+
     /**
      * @brief Get phone connection handle (PRIMARY mode)
      */
@@ -395,6 +506,44 @@ public:
      */
     float getSecondaryConnectionIntervalMs() const;
 
+    /**
+     * @brief Peer identity address of a connection
+     * @param connHandle Connection handle
+     * @param addrOut 6 bytes, LSB first (as the stack reports it)
+     * @return false if the handle is not connected
+     */
+    bool getPeerAddress(uint16_t connHandle, uint8_t* addrOut) const;
+
+    /**
+     * @brief Ask for a PHY on one link (TX and RX)
+     *
+     * The peer decides: a refusal only shows up as getPhy() not changing.
+     *
+     * @param connHandle Connection handle
+     * @param phyMask PHY bit: 0x01 1M, 0x02 2M, 0x04 Coded (S2 where the stack lets us pick)
+     * @return false if the request could not be issued
+     */
+    bool requestPhy(uint16_t connHandle, uint8_t phyMask);
+
+    /**
+     * @brief TX PHY of a link
+     * @return PHY bit (0x01 1M, 0x02 2M, 0x04 Coded), 0 if not connected
+     */
+    uint8_t getPhy(uint16_t connHandle) const;
+
+    /**
+     * @brief Request a connection-parameter profile on every identified link
+     *
+     * TIGHT also re-requests 2M PHY. The central decides: a refused or
+     * ignored request only shows up in the next interval log.
+     *
+     * @param profile Profile to request
+     */
+    void applyConnParamProfile(ConnParamProfile profile);
+
+    /** @brief Profile last requested (TIGHT until the first request) */
+    ConnParamProfile getConnParamProfile() const { return _connParamProfile; }
+
     // =========================================================================
     // STATIC CALLBACKS (for the BLE stack)
     // =========================================================================
@@ -408,6 +557,12 @@ public:
 #if defined(BOARD_BLUEBUZZAH_NRF52)
     static void _onScanCallback(ble_gap_evt_adv_report_t* report);
     static void _onClientUartRx(BLEClientUart& clientUart);
+#else
+    static void _onMtuChange(uint16_t connHandle, uint16_t mtu);  // nRF polls getMtu() in update()
+    static void _onScheduleReport(const uint8_t* data, size_t length, uint64_t rxTimestamp);
+#endif
+#if TASK_PINNING_ENABLED
+    static void _txTask(void* arg);
 #endif
 
 private:
@@ -431,43 +586,24 @@ private:
     BLEConnectCallback _connectCallback;
     BLEDisconnectCallback _disconnectCallback;
     BLEMessageCallback _messageCallback;
+    uint32_t _rxOversizeFrames;
+    uint32_t _identifyCounter;  // Source of BBConnection::identifyOrder
 
     // =========================================================================
     // TX QUEUE (non-blocking message transmission)
     // =========================================================================
 
-    static constexpr uint8_t TX_QUEUE_SIZE = 12;
-
-    struct TxEntry {
-        char data[MESSAGE_BUFFER_SIZE];
-        uint16_t length;
-        uint16_t bytesSent;
-        uint16_t connHandle;
-        volatile bool pending;   // publish flag: set last (after fields + barrier)
-        TxStampKind stampKind;   // NONE for normal messages
-        uint32_t stampSeqId;     // sequence id for deferred serialization
-        uint64_t stampT2;        // PONG only: T2 echoed back
-        uint64_t stampAnchor;    // PONG only: rx anchor timestamp (0 = absent)
-    };
-
-    // Accessed from BLE task (enqueue via rx callbacks) and main loop (enqueue +
-    // processTxQueue) - concurrently across cores on ESP32-S3. Head/tail/count
-    // mutations are critical-section-guarded; entries use reserve-fill-publish
-    // (pending set last, behind a memory barrier).
-    TxEntry _txQueue[TX_QUEUE_SIZE];
-    uint8_t _txHead;
-    uint8_t _txTail;
-    uint8_t _txCount;
+    // Accessed from BLE task (enqueue via rx callbacks), main loop (enqueue)
+    // and the single consumer processTxQueue (update() on nRF52, the core-0
+    // TX task with TASK_PINNING_ENABLED) - concurrently across cores on
+    // ESP32-S3. See ble_tx_queue.h for the reserve-fill-publish protocol.
+    BLETxQueue _txQueue;
 
     BLETxStampCallback _txStampCallback;
+    BLEScheduleBroadcastCallback _scheduleBroadcastCallback;
 
-    /**
-     * @brief Enqueue message for non-blocking transmission
-     * @param connHandle Target connection
-     * @param message Message to send (EOT will be appended)
-     * @return true if enqueued successfully
-     */
-    bool enqueueTx(uint16_t connHandle, const char* message);
+    // Last profile requested via applyConnParamProfile()
+    ConnParamProfile _connParamProfile;
 
     /**
      * @brief Enqueue an unserialized sync message for stamping at write time
@@ -477,7 +613,8 @@ private:
 
     /**
      * @brief Process pending TX queue entries
-     * Called from update() to drain the queue incrementally
+     * Called from update() to drain the queue incrementally, or from the
+     * pinned TX task (_txTask) with TASK_PINNING_ENABLED
      */
     void processTxQueue();
 
@@ -499,7 +636,8 @@ private:
 
     void processIncomingData(uint16_t connHandle, const uint8_t* data, uint16_t len, uint64_t rxTimestamp);
     void processClientIncomingData(const uint8_t* data, uint16_t len, uint64_t rxTimestamp);
-    void deliverMessage(BBConnection* conn, uint16_t connHandle);
+    void deliverMessage(BBConnection* conn, uint16_t connHandle, const char* frame, size_t length);
+    void receiveFrames(BBConnection* conn, const uint8_t* data, uint16_t len, uint64_t rxTimestamp);
     ConnectionType identifyConnectionType(uint16_t connHandle);
 
     /**
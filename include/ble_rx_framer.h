@@ -0,0 +1,87 @@
+/**
+ * @file ble_rx_framer.h
+ * @brief EOT-delimited frame reassembly for one BLE connection
+ *
+ * Incoming writes/notifications are scanned for the delimiter with memchr()
+ * and copied into the frame buffer in whole runs (memcpy), CRs dropped
+ * the same way - no per-byte loop. Each completed frame is handed out as a
+ * (pointer, length) view of the buffer; the delimiter's slot is overwritten
+ * with a NUL in place, so C-string consumers need no copy either.
+ *
+ * Frames are handed out as soon as their delimiter arrives, so the buffer
+ * only ever holds the one partial frame: it restarts at offset 0 after every
+ * delimiter instead of wrapping, which keeps every view contiguous.
+ *
+ * A frame longer than the buffer is dropped whole (bytes discarded up to its
+ * delimiter) and counted, instead of being cut into a garbage prefix and a
+ * garbage tail.
+ *
+ * Not thread-safe: one producer (the BLE RX callback for the connection).
+ * Pure C++ (no Arduino dependencies) so it builds in native test envs.
+ */
+
+#ifndef BLE_RX_FRAMER_H
+#define BLE_RX_FRAMER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @class BLERxFramer
+ * @brief Linear frame buffer fed with raw BLE payloads
+ *
+ * Usage:
+ *   const char* frame;
+ *   size_t frameLength;
+ *   while (framer.feed(data, len, frame, frameLength)) {
+ *       handle(frame, frameLength);  // valid until the next feed()
+ *   }
+ */
+class BLERxFramer {
+public:
+    /** @brief Frame delimiter (EOT) */
+    static constexpr uint8_t DELIMITER = 0x04;
+
+    /**
+     * @param buffer Frame storage (one byte is reserved for the NUL)
+     * @param capacity Size of buffer
+     */
+    BLERxFramer(char* buffer, size_t capacity);
+
+    /** @brief Drop any partial frame (counters are kept) */
+    void clear();
+
+    /** @brief Drop any partial frame and zero the counters (new connection) */
+    void reset();
+
+    /** @brief No partial frame buffered (next byte starts a frame) */
+    bool idle() const { return _length == 0 && !_discarding; }
+
+    /**
+     * @brief Consume input up to and including the next complete frame
+     *
+     * Advances data/len past what was consumed. Empty frames are skipped.
+     *
+     * @param data In/out: remaining input
+     * @param len In/out: remaining input length
+     * @param frame Out: NUL-terminated frame (delimiter excluded)
+     * @param frameLength Out: frame length without the NUL
+     * @return true if a frame completed; false once the input is used up
+     *         (a trailing partial frame stays buffered)
+     */
+    bool feed(const uint8_t*& data, size_t& len, const char*& frame, size_t& frameLength);
+
+    /** @brief Frames dropped for exceeding the buffer since reset() */
+    uint32_t oversizeCount() const { return _oversize; }
+
+private:
+    void append(const uint8_t* run, size_t runLength);
+
+    char* _buffer;
+    size_t _capacity;
+    size_t _length;
+    bool _discarding;   // Inside an oversize frame: drop until delimiter
+    uint32_t _oversize;
+};
+
+#endif // BLE_RX_FRAMER_H
@@ -0,0 +1,198 @@
+/**
+ * @file ble_tx_queue.h
+ * @brief Priority-class BLE TX queue shared by both BLE backends
+ * @version 1.0.0
+ *
+ * One FIFO ring per priority class, each with its own slot count and slot
+ * size (config.h BLE_TX_*), so a stamped PING no longer pins a 512 B slot
+ * or waits behind a multi-chunk HELP response. BLEManager::processTxQueue()
+ * asks for the next entry before every write, so a sync message queued
+ * while a bulk message is mid-transfer goes out before the bulk message's
+ * next chunk.
+ *
+ * Framing constraint: the link is an EOT-framed byte stream per connection,
+ * so a partially sent entry owns its connection until it completes. Other
+ * classes preempt it only on other connections (e.g. PING to SECONDARY
+ * between chunks of a HELP to the phone).
+ *
+ * Concurrency: producers (BLE task, main loop) reserve a slot inside
+ * PLATFORM_CRITICAL_ENTER/EXIT and publish it after filling it
+ * (reserve-fill-publish, pending set last behind a barrier). The single
+ * consumer (processTxQueue: update() on nRF52, the pinned core-0 TX task
+ * on ESP32-S3) reads published heads and releases them under the same lock.
+ */
+
+#ifndef BLE_TX_QUEUE_H
+#define BLE_TX_QUEUE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+// Deferred-timestamp kinds for sync messages (serialized at radio handoff)
+enum class TxStampKind : uint8_t {
+    NONE = 0,
+    PING_T1,   // PRIMARY -> SECONDARY: stamp T1 at write time
+    PONG_T3    // SECONDARY -> PRIMARY: stamp T3 at write time
+};
+
+/**
+ * @brief TX priority class, highest first
+ *
+ * DEFAULT lets BLEManager pick by destination: MACROCYCLE for the other
+ * glove, RESPONSE for the phone.
+ */
+enum class TxPriority : uint8_t {
+    SYNC = 0,        // Stamped PING/PONG, MC_ACK
+    MACROCYCLE = 1,  // Glove-to-glove control and MC: frames
+    RESPONSE = 2,    // Phone command responses
+    TELEMETRY = 3,   // LATS frames
+    DEFAULT = 0xFF
+};
+
+constexpr uint8_t TX_PRIORITY_COUNT = 4;
+
+// Notification / write-command header: opcode + attribute handle
+constexpr uint16_t BLE_ATT_HEADER_BYTES = 3;
+
+/**
+ * @brief Largest chunk one notification carries at a negotiated ATT MTU
+ *
+ * Clamped to [BLE_ATT_MTU_MIN, BLE_ATT_MTU]: 20 bytes before the exchange,
+ * 244 at the requested MTU.
+ */
+inline uint16_t bleNotifyPayload(uint16_t attMtu) {
+    if (attMtu < BLE_ATT_MTU_MIN) {
+        attMtu = BLE_ATT_MTU_MIN;
+    } else if (attMtu > BLE_ATT_MTU) {
+        attMtu = BLE_ATT_MTU;
+    }
+    return static_cast<uint16_t>(attMtu - BLE_ATT_HEADER_BYTES);
+}
+
+/**
+ * @brief One queued message
+ */
+struct BLETxEntry {
+    char* data;              // Slot in the class slab (message + EOT)
+    uint16_t capacity;       // Slot size in bytes
+    uint16_t length;
+    uint16_t bytesSent;
+    uint16_t connHandle;
+    volatile bool pending;   // publish flag: set last (after fields + barrier)
+    TxStampKind stampKind;   // NONE for normal messages
+    uint32_t stampSeqId;     // sequence id for deferred serialization
+    uint64_t stampT2;        // PONG only: T2 echoed back
+    uint64_t stampAnchor;    // PONG only: rx anchor timestamp (0 = absent)
+};
+
+/**
+ * @brief Writable view of a reserved slot (zero-copy send)
+ *
+ * Returned by BLEManager::reserveTx(); the caller serializes straight into
+ * data and hands the length to commitTx(). capacity counts the terminating
+ * NUL, whose byte commitTx() overwrites with the EOT.
+ */
+struct BLETxSpan {
+    char* data = nullptr;        // nullptr if no slot was available
+    size_t capacity = 0;
+    BLETxEntry* entry = nullptr;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// =============================================================================
+// BLE TX QUEUE
+// =============================================================================
+
+/**
+ * @class BLETxQueue
+ * @brief Per-class slot rings with strict-priority selection
+ */
+class BLETxQueue {
+public:
+    static constexpr uint8_t SLOTS[TX_PRIORITY_COUNT] = {
+        BLE_TX_SYNC_SLOTS, BLE_TX_MACROCYCLE_SLOTS, BLE_TX_RESPONSE_SLOTS, BLE_TX_TELEMETRY_SLOTS
+    };
+    static constexpr uint16_t SLOT_BYTES[TX_PRIORITY_COUNT] = {
+        BLE_TX_SYNC_SLOT_BYTES, BLE_TX_MACROCYCLE_SLOT_BYTES,
+        BLE_TX_RESPONSE_SLOT_BYTES, BLE_TX_TELEMETRY_SLOT_BYTES
+    };
+    static constexpr uint8_t TOTAL_SLOTS =
+        BLE_TX_SYNC_SLOTS + BLE_TX_MACROCYCLE_SLOTS + BLE_TX_RESPONSE_SLOTS + BLE_TX_TELEMETRY_SLOTS;
+    static constexpr size_t TOTAL_BYTES =
+        BLE_TX_SYNC_SLOTS * BLE_TX_SYNC_SLOT_BYTES +
+        BLE_TX_MACROCYCLE_SLOTS * BLE_TX_MACROCYCLE_SLOT_BYTES +
+        BLE_TX_RESPONSE_SLOTS * BLE_TX_RESPONSE_SLOT_BYTES +
+        BLE_TX_TELEMETRY_SLOTS * BLE_TX_TELEMETRY_SLOT_BYTES;
+
+    BLETxQueue();
+
+    // Entries point into _slab: not copyable
+    BLETxQueue(const BLETxQueue&) = delete;
+    BLETxQueue& operator=(const BLETxQueue&) = delete;
+
+    /**
+     * @brief Reserve a slot (any producer)
+     *
+     * The caller fills the entry, then calls publish().
+     *
+     * @param priority Class (not DEFAULT)
+     * @param bytes Bytes needed, including the EOT
+     * @return Entry, or nullptr if the class is full or bytes exceeds its slot
+     */
+    BLETxEntry* reserve(TxPriority priority, size_t bytes);
+
+    /**
+     * @brief Make a filled entry visible to the consumer
+     */
+    void publish(BLETxEntry* entry);
+
+    /**
+     * @brief Next entry to write (consumer only)
+     *
+     * Highest class first, FIFO within a class. Skips classes whose head is
+     * unpublished, whose connection is in skipHandles (congested this pass),
+     * or whose connection is owned by another class's partially sent head.
+     *
+     * @return Entry, or nullptr if nothing is writable
+     */
+    BLETxEntry* next(const uint16_t* skipHandles, uint8_t skipCount);
+
+    /**
+     * @brief Release a finished (or abandoned) head entry (consumer only)
+     */
+    void release(BLETxEntry* entry);
+
+    /**
+     * @brief Queued entries across all classes (approximate)
+     */
+    uint8_t count() const;
+
+    /**
+     * @brief Queued entries in one class (approximate)
+     */
+    uint8_t count(TxPriority priority) const;
+
+private:
+    struct ClassRing {
+        BLETxEntry* entries;   // SLOTS[class] entries in _entries
+        uint8_t slots;
+        volatile uint8_t head;
+        volatile uint8_t tail;
+        volatile uint8_t count;
+    };
+
+    BLETxEntry _entries[TOTAL_SLOTS];
+    char _slab[TOTAL_BYTES];
+    ClassRing _rings[TX_PRIORITY_COUNT];
+
+    bool classOf(const BLETxEntry* entry, uint8_t& cls) const;
+};
+
+#endif // BLE_TX_QUEUE_H
@@ -23,6 +23,10 @@
   #define ADC_REFERENCE_VOLTAGE    3.6f
   #define BATTERY_VOLTAGE_DIVIDER  2.0f
   #define MOTOR_SILK_PORT(finger)  (finger)       // no labeled motor ports on this board
+  // Task topology: single core. The motor task preempts the BLE task (prio 3)
+  // and loop() (prio 1) by priority alone; the SoftDevice runs above all tasks.
+  #define TASK_PINNING_ENABLED     0
+  #define MOTOR_TASK_PRIORITY      TASK_PRIO_HIGHEST
 #elif defined(BOARD_PENTABUZZER_ESP32S3)
   #define MAX_ACTUATORS            5
   #define NEOPIXEL_PIN_OVERRIDE    4              // RGB LED data (GPIO4)
@@ -41,6 +45,21 @@
   // firmware finger N drives the port labeled (5 - N). Wire the glove
   // harness accordingly - therapy patterns are per-finger.
   #define MOTOR_SILK_PORT(finger)  (5 - (finger))
+  // Task topology (dual core). Core 0: radio - NimBLE host task (pinned by
+  // the core's sdkconfig) and the BLE TX drain, so notifies and late T1/T3
+  // stamping never wait for loop(). Core 1: timing - motor task and its async
+  // I2C worker at the top application priority, with loop() (Arduino loop
+  // task, prio 1) taking what is left for housekeeping. BLE stack bursts stay
+  // on core 0 and cannot delay motor dispatch.
+  #define TASK_PINNING_ENABLED     1
+  #define BLE_TX_TASK_CORE         0
+  #define BLE_TX_TASK_PRIORITY     5              // Above loop(), below the NimBLE host
+  #define BLE_TX_TASK_STACK        4096           // bytes (ESP-IDF units)
+  #define BLE_TX_TASK_POLL_MS      1              // Retry period while entries remain queued
+  #define MOTOR_TASK_CORE          1
+  #define MOTOR_TASK_PRIORITY      (configMAX_PRIORITIES - 3)
+  #define HAPTIC_I2C_TASK_CORE     MOTOR_TASK_CORE
+  #define HAPTIC_I2C_TASK_STACK    4096           // bytes (ESP-IDF units)
 #else
   #error "No board macro defined (BOARD_BLUEBUZZAH_NRF52 or BOARD_PENTABUZZER_ESP32S3)"
 #endif
@@ -0,0 +1,113 @@
+/**
+ * @file clock_servo.h
+ * @brief 2-state (offset, skew) Kalman clock servo for PTP quadruples
+ *
+ * Alternative to SimpleSyncProtocol's median buffer + offset EMA + drift EMA
+ * (SYNC_CLOCK_SERVO_ENABLED). Each accepted PING/PONG exchange is one
+ * measurement of the offset; its variance comes from the exchange's excess
+ * RTT over the tracked minimum, since queuing on either leg can skew the
+ * PTP midpoint by at most half of it. Skew is a filter state rather than an
+ * offset difference over a fixed window, so it converges from the first few
+ * exchanges and keeps extrapolating between sparse PINGs.
+ *
+ * The filter runs on an int64 base plus a float residual so the large
+ * boot-time offsets (seconds) don't eat float precision.
+ *
+ * Pure C++ (no Arduino dependencies) so it builds in native test envs.
+ */
+
+#ifndef CLOCK_SERVO_H
+#define CLOCK_SERVO_H
+
+#include <stdint.h>
+#include "config.h"
+
+class ClockServo {
+public:
+    ClockServo();
+
+    /** @brief Forget all state (cold start) */
+    void reset();
+
+    /**
+     * @brief Start from a known offset and skew (warm start)
+     * @param offsetUs Projected offset at nowMs
+     * @param skewUsPerMs Cached skew
+     * @param offsetSigmaUs Uncertainty of the projection
+     * @param nowMs Sync timebase (ms)
+     */
+    void seed(int64_t offsetUs, float skewUsPerMs, float offsetSigmaUs, uint32_t nowMs);
+
+    /**
+     * @brief Known skew, unknown offset (persisted calibration)
+     *
+     * Resets the filter; the first measurement then sets the offset and
+     * the skew starts from skewUsPerMs instead of zero.
+     */
+    void setSkewPrior(float skewUsPerMs, float skewSigmaUsPerMs);
+
+    /**
+     * @brief Fold in one PTP offset measurement
+     *
+     * Rejects exchanges above SYNC_RTT_QUALITY_THRESHOLD_US and, once
+     * seeded, innovations beyond SYNC_SERVO_GATE_SIGMA. A step that persists
+     * for SYNC_INNOVATION_REJECT_LIMIT samples re-anchors the offset
+     * (genuine clock step) and keeps the skew.
+     *
+     * @param offsetUs PTP offset (SECONDARY - PRIMARY)
+     * @param rttUs Exchange round-trip time
+     * @param nowMs Sync timebase (ms) of the measurement
+     * @return true if the sample was applied
+     */
+    [[nodiscard]] bool update(int64_t offsetUs, uint32_t rttUs, uint32_t nowMs);
+
+    /**
+     * @brief Offset projected to nowMs
+     *
+     * Same safety caps as the EMA path: elapsed <= SYNC_MAX_CORRECTION_ELAPSED_MS,
+     * skew <= SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS.
+     */
+    int64_t offsetAt(uint32_t nowMs) const;
+
+    /** @brief Offset estimate at the last measurement */
+    int64_t offset() const { return _base + static_cast<int64_t>(_x0); }
+
+    /** @brief Skew estimate (us of offset change per ms) */
+    float skew() const { return _x1; }
+
+    /** @brief Offset standard deviation estimate (us) */
+    float offsetSigma() const;
+
+    /** @brief Skew standard deviation estimate (us/ms) */
+    float skewSigma() const;
+
+    /** @brief syncNowMs() of the last applied measurement */
+    uint32_t lastUpdateMs() const { return _lastMs; }
+
+    /** @brief Measurements applied since reset()/seed() */
+    uint16_t sampleCount() const { return _samples; }
+
+    bool isSeeded() const { return _seeded; }
+
+    /** @brief Tracked minimum RTT (reference for measurement variance) */
+    uint32_t minRtt() const { return _minRttUs; }
+
+    /** @brief Swap in another link's minimum RTT (PHY switch) */
+    void setMinRtt(uint32_t minRttUs) { _minRttUs = minRttUs; }
+
+private:
+    void predict(uint32_t nowMs);
+    void rebase();
+
+    int64_t _base;       // Integer part of the offset state
+    float _x0;           // Offset residual above _base (us)
+    float _x1;           // Skew (us/ms)
+    float _p00, _p01, _p11;  // State covariance
+    uint32_t _lastMs;
+    uint32_t _minRttUs;
+    uint16_t _samples;
+    uint8_t _gateRejects;
+    bool _seeded;
+};
+
+#endif // CLOCK_SERVO_H
@@ -0,0 +1,158 @@
+/**
+ * @file command_table.h
+ * @brief BLE message classification and phone-command lookup
+ *
+ * Two compile-time tables replace the strcmp/strncmp chains that every
+ * received message used to walk:
+ * - Internal (PRIMARY<->SECONDARY) prefixes, bucketed by first character:
+ *   classifyMessage() compares only the prefixes sharing the message's
+ *   first letter (at most five) and returns the longest match.
+ * - Phone commands, placed by a perfect hash of (length, first, last
+ *   character); a static_assert proves the hash collision-free, so
+ *   lookupMenuCommand() is one hash and one string compare.
+ *
+ * splitCommand() tokenizes "CMD:p1:p2..." into std::string_view slices of
+ * the received buffer - no per-parameter copies.
+ *
+ * Pure C++ (no Arduino dependencies) so it builds in native test envs.
+ */
+
+#ifndef COMMAND_TABLE_H
+#define COMMAND_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string_view>
+
+// Maximum parameters in a command
+#define MAX_COMMAND_PARAMS 16
+
+// =============================================================================
+// INTERNAL MESSAGES
+// =============================================================================
+
+/**
+ * @brief Internal message families (by prefix; NONE = phone command)
+ */
+enum class InternalMessage : uint8_t {
+    NONE = 0,
+    BUZZ,
+    PING,
+    PONG,
+    PARAM_UPDATE,
+    SEED,
+    SEED_ACK,
+    GET_BATTERY,
+    BATRESPONSE,
+    ACK_PARAM_UPDATE,
+    SYNC,            // "SYNC_" - SYNC_ADJ, SYNC_PROBE, SYNC_PROBE_ACK
+    FIRST_SYNC,
+    ACK_SYNC,        // Covers ACK_SYNC_ADJ
+    START_SESSION,
+    PAUSE_SESSION,
+    RESUME_SESSION,
+    STOP_SESSION,
+    IDENTIFY,        // "IDENTIFY:"
+    LED_OFF_SYNC,
+    DEBUG_FLASH,
+    DEBUG_SYNC,
+    MC,              // "MC:" macrocycle batch
+    MC_ACK,          // "MC_ACK:"
+    MC_VER,          // "MC_VER:" wire-format negotiation
+    CALIB_BUZZ,      // "CALIB_BUZZ:"
+    CALIB_STOP,
+    MC_RESYNC        // "MC_RESYNC:" SECONDARY lost a macrocycle to lateness
+};
+
+/**
+ * @brief Longest internal prefix the message starts with
+ * @return InternalMessage::NONE if it matches none (a phone command)
+ */
+InternalMessage classifyMessage(std::string_view message);
+
+/** @brief The prefix classifyMessage() matched for kind ("" for NONE) */
+std::string_view internalPrefix(InternalMessage kind);
+
+// =============================================================================
+// PHONE COMMANDS
+// =============================================================================
+
+enum class MenuCommand : uint8_t {
+    UNKNOWN = 0,
+    INFO,
+    BATTERY,
+    PING,
+    PROFILE_LIST,
+    PROFILE_LOAD,
+    PROFILE_GET,
+    PROFILE_CUSTOM,
+    SESSION_START,
+    SESSION_PAUSE,
+    SESSION_RESUME,
+    SESSION_STOP,
+    SESSION_STATUS,
+    PARAM_SET,
+    CALIBRATE_START,
+    CALIBRATE_BUZZ,
+    CALIBRATE_STOP,
+    HELP,
+    RESTART,
+    THERAPY_LED_OFF,
+    DEBUG,
+    LATENCY_STREAM,
+    JOURNAL_GET,
+    PERF
+};
+
+/**
+ * @brief Look up a command name (case-insensitive)
+ * @return MenuCommand::UNKNOWN if not a command
+ */
+MenuCommand lookupMenuCommand(std::string_view name);
+
+/** @brief Upper-case name of a command ("" for UNKNOWN) */
+std::string_view menuCommandName(MenuCommand command);
+
+/**
+ * @brief A command split into views of the received message
+ */
+struct CommandArgs {
+    std::string_view name;
+    std::string_view params[MAX_COMMAND_PARAMS];
+    uint8_t count = 0;
+};
+
+/**
+ * @brief Split "CMD:p1:p2..." on ':'
+ *
+ * Stops at the first newline, CR or EOT and skips leading spaces. Empty
+ * fields are skipped (as strtok did); parameters past MAX_COMMAND_PARAMS
+ * are dropped.
+ *
+ * @return false if no command name remains
+ */
+bool splitCommand(std::string_view message, CommandArgs& args);
+
+// =============================================================================
+// PARAMETER HELPERS
+// =============================================================================
+
+/** @brief atoi() on a view: optional spaces and sign, digits up to the first non-digit; 0 if none */
+int32_t argToInt(std::string_view arg);
+
+/** @brief Case-insensitive equality */
+bool argEqualsIgnoreCase(std::string_view arg, std::string_view expected);
+
+/**
+ * @brief Parse a boolean parameter ("true"/"false" any case, "1"/"0")
+ * @return false if arg is neither
+ */
+bool argToBool(std::string_view arg, bool& value);
+
+/**
+ * @brief Copy a view into a NUL-terminated buffer (truncating)
+ * @return Characters copied
+ */
+size_t argCopy(std::string_view arg, char* out, size_t size);
+
+#endif // COMMAND_TABLE_H
@@ -39,7 +39,19 @@
 // TCA9548A_ADDRESS / DRV2605_ADDRESS come from board_config.h (identical on
 // both boards).
 
-#define I2C_FREQUENCY 400000  // 400kHz Fast Mode
+#define I2C_FREQUENCY 400000  // 400kHz Fast Mode (boot/fallback speed)
+
+// Fast-mode Plus bus profile: after every channel initializes at
+// I2C_FREQUENCY, the bus is raised to I2C_FREQUENCY_MAX and each enabled
+// channel must pass a register read-back; any failure drops the whole bus
+// back to I2C_FREQUENCY (one Wire bus, so the slowest branch sets the speed).
+// The nRF52840 TWIM tops out at 400kHz, so the profile is ESP32-S3 only.
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+#define I2C_FREQUENCY_MAX 1000000  // 1MHz Fast-mode Plus (DRV2605 + TCA9548A)
+#else
+#define I2C_FREQUENCY_MAX I2C_FREQUENCY
+#endif
+#define I2C_PROBE_READBACK_COUNT 4  // Read-back rounds per channel at I2C_FREQUENCY_MAX
 
 // I2C timing
 #define I2C_INIT_DELAY_MS 5      // Delay after channel select (fingers 0-3)
@@ -54,6 +66,16 @@
 // Boot sequence
 #define STARTUP_WINDOW_MS 30000      // 30 seconds boot timeout
 #define CONNECTION_TIMEOUT_MS 30000  // 30 seconds connection timeout
+#define BOOT_SERIAL_WAIT_MS 3000     // Wait for a USB serial host (not with fast boot)
+
+// Fast boot: BLE becomes connectable before the motors are up. DRV2605 init
+// (and the PentaBuzzer presence probe) runs in the motor task before it
+// serves its first event; until the probe finishes, patterns use the
+// presence mask saved by the previous boot. Skips the USB serial wait, so
+// build with 0 to capture the full boot log.
+#ifndef FAST_BOOT_ENABLED
+#define FAST_BOOT_ENABLED 1
+#endif
 
 // BLE parameters
 #define BLE_INTERVAL_MIN_MS 7.5f     // Minimum connection interval (7.5ms = 6 units, BLE spec minimum)
@@ -63,6 +85,40 @@
 #define BLE_USE_2M_PHY 1             // Enable 2M PHY for faster BLE transmission
 #define BLE_INTERVAL_WARNING_THRESHOLD_MS 12.0f  // Warn if negotiated interval > 12ms
 
+// Connection-parameter controller (PRIMARY requests, centrals decide): the
+// tight interval above while a session runs or clock sync warms up, a
+// relaxed interval with slave latency otherwise. Relaxed values follow the
+// iOS accessory rules (min >= 15ms, max >= min + 15ms, max * (latency + 1) <= 2s).
+#ifndef BLE_CONN_PARAM_CONTROL_ENABLED
+#define BLE_CONN_PARAM_CONTROL_ENABLED 1
+#endif
+#define BLE_RELAXED_INTERVAL_MIN_MS 45     // Relaxed minimum connection interval
+#define BLE_RELAXED_INTERVAL_MAX_MS 60     // Relaxed maximum connection interval
+#define BLE_RELAXED_SLAVE_LATENCY 4        // PRIMARY may skip 4 events (<= 300ms wake-up)
+#define BLE_CONN_PARAM_RELAX_DELAY_MS 5000 // Stay tight this long after the last reason to (STOP -> START churn)
+
+// Automatic PHY selection (PRIMARY picks the SECONDARY link's PHY): steps
+// 2M -> 1M -> Coded when PING/PONG exchanges show retransmissions (RTT above
+// the PHY's minimum, in connection intervals) or lost PONGs, and probes back
+// up after a quiet spell. RTT statistics and lead time are cached per PHY.
+#ifndef BLE_PHY_AUTO_ENABLED
+#define BLE_PHY_AUTO_ENABLED 1
+#endif
+#ifndef BLE_PHY_AUTO_CODED_ENABLED
+#define BLE_PHY_AUTO_CODED_ENABLED 1       // Allow the Coded (S2 where selectable) rung
+#endif
+#define BLE_PHY_AUTO_EVAL_MS 1000          // Read back the link PHY this often (NimBLE has no PHY event here)
+#define BLE_PHY_AUTO_MIN_SAMPLES 6         // Exchanges on a PHY before it is judged
+#define BLE_PHY_AUTO_DEGRADE_RETX_Q8 384   // Step down at >= 1.5 retransmissions per exchange (EMA, Q8)
+#define BLE_PHY_AUTO_RECOVER_RETX_Q8 64    // Probe up only at <= 0.25 retransmissions per exchange
+#define BLE_PHY_AUTO_MISS_LIMIT 2          // Consecutive lost PONGs step down without waiting for samples
+#define BLE_PHY_AUTO_MISS_RETX 4           // A lost PONG counts as this many retransmissions
+#define BLE_PHY_AUTO_MAX_RETX 8            // Per-exchange cap (one stall must not dominate the EMA)
+#define BLE_PHY_AUTO_MIN_DWELL_MS 5000     // No decision this soon after a switch
+#define BLE_PHY_AUTO_PROBE_MS 60000        // Quiet time before probing the next faster PHY
+#define BLE_PHY_AUTO_PROBE_MAX_MS 600000   // Probe back-off ceiling (doubles after each failed probe)
+#define BLE_PHY_AUTO_REQUEST_TIMEOUT_MS 2000 // Unanswered request: the peer refused that PHY
+
 // Sync protocol
 #define SYNC_TIMEOUT_MS 2000         // Sync command timeout
 #define COMMAND_TIMEOUT_MS 5000      // General BLE command timeout
@@ -81,20 +137,78 @@
 // blocking bug. The old code's delayMicroseconds() blocked BLE callbacks for ~300ms,
 // making it appear that MACROCYCLE transmission took much longer than it actually does.
 // Actual MACROCYCLE BLE transmission is ~40-50ms (included in RTT-based calculation).
+
+// Filter, lead-time and PING cadence tunables below are #ifndef-guarded so
+// the host sync simulator (scripts/sync_sim.py) can sweep them with -D.
+
+// Clock servo: 2-state (offset, skew) Kalman filter fed every PTP quadruple,
+// with measurement variance from the sample's excess RTT. Replaces the median
+// buffer, offset/drift EMAs and lucky-packet gate when enabled; converges in
+// fewer PINGs and tracks skew well enough to hold sync at the idle PING rate.
+#ifndef SYNC_CLOCK_SERVO_ENABLED
+#define SYNC_CLOCK_SERVO_ENABLED 0
+#endif
+#ifndef SYNC_SERVO_MEAS_FLOOR_US
+#define SYNC_SERVO_MEAS_FLOOR_US 300.0f       // Measurement sigma of a minimum-RTT sample
+#endif
+#ifndef SYNC_SERVO_OFFSET_NOISE
+#define SYNC_SERVO_OFFSET_NOISE 0.01f         // Offset process noise (us^2 per ms, timestamp wander)
+#endif
+#ifndef SYNC_SERVO_SKEW_NOISE
+#define SYNC_SERVO_SKEW_NOISE 1.0e-11f        // Skew process noise ((us/ms)^2 per ms, ~1 ppm per 100 s)
+#endif
+#ifndef SYNC_SERVO_GATE_SIGMA
+#define SYNC_SERVO_GATE_SIGMA 4.0f            // Reject innovations beyond 4 sigma of the prediction...
+                                               // ...unless persistent (SYNC_INNOVATION_REJECT_LIMIT)
+#endif
+
+#if SYNC_CLOCK_SERVO_ENABLED
+#ifndef SYNC_MIN_VALID_SAMPLES
+#define SYNC_MIN_VALID_SAMPLES 3     // Servo prior + per-sample variance converge faster
+#endif
+#ifndef SYNC_ACTIVE_INTERVAL_MS
+#define SYNC_ACTIVE_INTERVAL_MS KEEPALIVE_INTERVAL_MS  // Skew is tracked - no 4Hz therapy cadence
+#endif
+#else
+#ifndef SYNC_MIN_VALID_SAMPLES
 #define SYNC_MIN_VALID_SAMPLES 5     // Minimum samples before clock sync is valid
-#define SYNC_OFFSET_EMA_ALPHA_NUM 1  // Slow EMA α = 1/10 = 0.1 for continuous updates
-#define SYNC_OFFSET_EMA_ALPHA_DEN 10
+#endif
+#ifndef SYNC_ACTIVE_INTERVAL_MS
 #define SYNC_ACTIVE_INTERVAL_MS 250       // PING cadence while therapy is running (4Hz)
                                            // Idle cadence stays KEEPALIVE_INTERVAL_MS (1Hz)
+#endif
+#endif
+#ifndef SYNC_OFFSET_EMA_ALPHA_NUM
+#define SYNC_OFFSET_EMA_ALPHA_NUM 1  // Slow EMA α = 1/10 = 0.1 for continuous updates
+#endif
+#ifndef SYNC_OFFSET_EMA_ALPHA_DEN
+#define SYNC_OFFSET_EMA_ALPHA_DEN 10
+#endif
+#ifndef SYNC_RTT_QUALITY_THRESHOLD_US
 #define SYNC_RTT_QUALITY_THRESHOLD_US 60000 // 60ms RTT threshold - reject retransmission-affected samples
                                              // (reduced from 120ms for stricter quality filtering)
+#endif
+#ifndef SYNC_OUTLIER_THRESHOLD_US
 #define SYNC_OUTLIER_THRESHOLD_US 5000   // 5ms threshold for offset outlier rejection (was hardcoded)
+#endif
+#ifndef SYNC_OFFSET_WINDOW_SIZE
+#define SYNC_OFFSET_WINDOW_SIZE 10       // Offset samples in the median/MAD window (max 255);
+                                          // kept sorted incrementally, so 32+ stays cheap
+#endif
 
 // Maintenance-mode sample gating (post-convergence quality filters)
+#ifndef SYNC_LUCKY_RTT_MARGIN_US
 #define SYNC_LUCKY_RTT_MARGIN_US 10000      // Accept only RTT <= minRTT + 10ms ("lucky packets")
+#endif
+#ifndef SYNC_MIN_RTT_DECAY_US
 #define SYNC_MIN_RTT_DECAY_US 200           // Per-sample creep of tracked min RTT (adapts to degradation)
+#endif
+#ifndef SYNC_INNOVATION_GATE_US
 #define SYNC_INNOVATION_GATE_US 5000        // Reject offset jumps > 5ms...
+#endif
+#ifndef SYNC_INNOVATION_REJECT_LIMIT
 #define SYNC_INNOVATION_REJECT_LIMIT 5      // ...unless persistent across this many samples
+#endif
 #define SYNC_MAX_DRIFT_RATE_US_PER_MS 0.15f  // 150 ppm max drift rate (cap for safety)
 #define SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS 0.1f  // 100 ppm max for corrections
                                                      // More conservative than measurement cap (0.15f)
@@ -105,6 +219,21 @@
 #define SYNC_WARM_START_MIN_SAMPLES 3        // Confirmatory samples required for warm-start
 #define SYNC_WARM_START_TOLERANCE_US 5000    // 5ms tolerance for confirmatory sample validation
 
+// Persisted skew calibration: the glove pair's relative crystal skew is
+// stable, so PRIMARY stores it per SECONDARY address and seeds the drift
+// estimate on the next cold connect (sync valid after fewer samples).
+#ifndef SYNC_SKEW_CAL_ENABLED
+#define SYNC_SKEW_CAL_ENABLED 1
+#endif
+#define SYNC_SKEW_CAL_MAX_PEERS 4             // Peers remembered (least recently used is evicted)
+#define SYNC_SKEW_CAL_MIN_SAMPLES 3           // Samples to valid sync when seeded
+#define SYNC_SKEW_CAL_MIN_TRACK_MS 120000     // Skew tracked this long before it is saved
+#define SYNC_SKEW_CAL_SAVE_INTERVAL_MS 600000 // Refresh at most every 10 min (flash wear)
+#define SYNC_SKEW_CAL_MAX_AGE_BOOTS 64        // Discard entries not refreshed for this many boots
+#define SYNC_SKEW_CAL_MAX_TEMP_DELTA_C 15.0f  // Discard if the die is this far from the saved temperature
+#define SYNC_SKEW_CAL_SIGMA_US_PER_MS 0.002f  // Seed uncertainty floor (2 ppm)
+#define SYNC_SKEW_CAL_TEMP_SIGMA_PER_C 0.0005f // Extra seed uncertainty per degree C of drift (0.5 ppm)
+
 // Connection-anchor timestamping (EXPERIMENTAL)
 // Hardware-timestamps BLE radio events via SoftDevice radio notifications and
 // derives clock offset from paired anchors. Falls back to PTP per-sample.
@@ -128,15 +257,101 @@
 
 // Drift rate and lead time calculation constants
 #define SYNC_MAX_CORRECTION_ELAPSED_MS 10000  // 10s max elapsed time for drift correction
+#ifndef SYNC_MIN_DRIFT_INTERVAL_MS
 #define SYNC_MIN_DRIFT_INTERVAL_MS 500        // 500ms min interval for drift rate calculation
+#endif
+#ifndef SYNC_DRIFT_EMA_ALPHA
 #define SYNC_DRIFT_EMA_ALPHA 0.3f             // Drift rate EMA smoothing factor (α=0.3)
+#endif
+#ifndef SYNC_MIN_LEAD_TIME_US
 #define SYNC_MIN_LEAD_TIME_US 70000           // 70ms minimum lead time for MACROCYCLE
+#endif
+#ifndef SYNC_MAX_LEAD_TIME_US
 #define SYNC_MAX_LEAD_TIME_US 150000          // 150ms maximum lead time for MACROCYCLE
+#endif
+
+// Connection-event lead time: once the SECONDARY link's interval is known,
+// the MACROCYCLE lead is bounded by the wait for the next connection event
+// (predicted from radio anchors, else one full interval) plus a fixed number
+// of events for delivery and link-layer retransmissions - instead of the
+// measured RTT + 3 sigma, which double-counts the return path.
+#define SYNC_ANCHORED_LEAD_ENABLED 1
+#define SYNC_ANCHORED_LEAD_EVENTS 3           // 1 delivery event + 2 retransmissions (MC fits in one 12.5ms event)
+#define SYNC_ANCHORED_MIN_LEAD_TIME_US 30000  // Floor for the connection-event bound
+#define SYNC_ANCHOR_PREDICT_TOLERANCE_US 300  // Max anchor-gap deviation from a whole interval
+
+// Closed-loop lead time: SECONDARY reports its slack (baseTime minus
+// staging-complete time) in each MC_ACK; the PRIMARY sizes the lead from
+// the measured send-to-staged delays instead of the open-loop bound above.
+// Older SECONDARYs send no slack and keep the open-loop lead.
+#ifndef SYNC_SLACK_FEEDBACK_ENABLED
+#define SYNC_SLACK_FEEDBACK_ENABLED 1
+#endif
+#define SYNC_SLACK_TARGET_US 5000             // Slack kept at the delay percentile
+#define SYNC_SLACK_PERCENTILE 99              // Delay percentile the lead covers
+#define SYNC_SLACK_WINDOW 32                  // Delay samples (one per macrocycle)
+#define SYNC_SLACK_MIN_SAMPLES 8              // Open-loop lead until this many
+#define SYNC_SLACK_MIN_LEAD_US 20000          // Closed-loop floor
+#define SYNC_SLACK_STALE_MS 10000             // No feedback this long: open loop again
+#define SYNC_SLACK_PENDING 8                  // Sent leads / queued ACKs awaiting a match
+
+// Pipelined macrocycle streaming: macrocycle N+1 is generated and sent (its
+// baseTime chained to the end of N's relax window) while N is still in
+// flight, so the adaptive lead time is no longer dead air every cycle.
+// Negotiated per link via the MC_VER capability field; older peers stay
+// stop-and-wait. 1 disables. Each in-flight macrocycle can hold
+// 2 * MACROCYCLE_MAX_EVENTS ActivationQueue slots (depth 2 = 60 of 64).
+#ifndef MACROCYCLE_PIPELINE_DEPTH
+#define MACROCYCLE_PIPELINE_DEPTH 2
+#endif
+#define MACROCYCLE_PIPELINE_HORIZON_MS 1000   // Send N+1 this long before its baseTime
+                                               // (well inside SECONDARY's 5s acceptance window)
+
+// Seeded macrocycles (MC_VER capability MACROCYCLE_CAP_SEEDED, V7 links):
+// SECONDARY regenerates every macrocycle from the session seed, so only a
+// "cycle N at baseTime T" tick crosses the link. On a pipelined link it also
+// plays up to MACROCYCLE_SEEDED_COAST_CYCLES cycles on its own when a tick is
+// late, starting each one MACROCYCLE_SEEDED_COAST_GUARD_MS before its chained
+// baseTime. 0 disables seeding.
+#ifndef MACROCYCLE_SEEDED_ENABLED
+#define MACROCYCLE_SEEDED_ENABLED 1
+#endif
+#define MACROCYCLE_SEEDED_COAST_CYCLES 2
+#define MACROCYCLE_SEEDED_COAST_GUARD_MS 30
 
 // Unified keepalive + clock sync (PING/PONG)
 #define KEEPALIVE_INTERVAL_MS 1000   // 1 second between PING messages (unified keepalive + clock sync)
 #define KEEPALIVE_TIMEOUT_MS 6000    // 6 seconds = 6 missed keepalives
 
+// Adaptive PING cadence (PRIMARY): burst on link-up / PHY change, then back
+// off from the base cadence (SYNC_ACTIVE_INTERVAL_MS / KEEPALIVE_INTERVAL_MS)
+// while the sync uncertainty stays low; any rejected sample, missed PONG or
+// high uncertainty snaps back to the base cadence.
+#ifndef SYNC_ADAPTIVE_PING_ENABLED
+#define SYNC_ADAPTIVE_PING_ENABLED 1
+#endif
+#ifndef SYNC_PING_BURST_COUNT
+#define SYNC_PING_BURST_COUNT 8               // PINGs per burst (fills the offset median buffer)
+#endif
+#ifndef SYNC_PING_BURST_GAP_MS
+#define SYNC_PING_BURST_GAP_MS 20             // Gap after each burst PONG
+#endif
+#ifndef SYNC_PING_BURST_TIMEOUT_MS
+#define SYNC_PING_BURST_TIMEOUT_MS 200        // Next burst PING if a PONG never arrives
+#endif
+#ifndef SYNC_PING_MAX_INTERVAL_MS
+#define SYNC_PING_MAX_INTERVAL_MS 3000        // Backoff ceiling: one lost PING stays inside the timeout
+#endif
+#ifndef SYNC_PING_STABLE_UNCERTAINTY_US
+#define SYNC_PING_STABLE_UNCERTAINTY_US 2000  // Double the interval at or below this...
+#endif
+#ifndef SYNC_PING_UNSTABLE_UNCERTAINTY_US
+#define SYNC_PING_UNSTABLE_UNCERTAINTY_US 5000 // ...snap back to base above this
+#endif
+#if SYNC_PING_MAX_INTERVAL_MS * 2 > KEEPALIVE_TIMEOUT_MS
+#error "SYNC_PING_MAX_INTERVAL_MS must leave room for one lost PING within KEEPALIVE_TIMEOUT_MS"
+#endif
+
 // How long the CONNECTION_LOST state (purple blink) is shown after losing the
 // peer before demoting to IDLE (blue breathe). Scanning/advertising for the
 // peer continues either way; this only affects the LED indication.
@@ -169,6 +384,18 @@ constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 // DRV2605 VBAT backend (PentaBuzzer): number of readings taken per burst
 #define VBAT_BURST_SAMPLES 9
 
+// Scheduled VBAT sampling: after boot, the motor task takes one VBAT sample
+// per idle gap (empty queue, or the next event at least
+// VBAT_SAMPLE_MIN_GAP_US away with no motor driven), at most one every
+// VBAT_SAMPLE_INTERVAL_MS, so battery reads never contend with a scheduled
+// activation. readVoltage() then returns the running estimate. Set 0 to
+// read a burst on demand from the caller's task instead.
+#ifndef VBAT_SCHEDULED_SAMPLING_ENABLED
+#define VBAT_SCHEDULED_SAMPLING_ENABLED 1
+#endif
+#define VBAT_SAMPLE_INTERVAL_MS 1000
+#define VBAT_SAMPLE_MIN_GAP_US 5000     // One select + 2 reads + close is ~0.5ms
+
 // =============================================================================
 // HAPTIC CONFIGURATION
 // =============================================================================
@@ -182,6 +409,14 @@ constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 #define MAX_FREQUENCY_HZ 255            // Maximum LRA resonant frequency (v1 randrange excludes 260)
 #define DEFAULT_FREQUENCY_HZ 250        // Default/standard LRA frequency (v1 reference: 250Hz)
 
+// Motor presence probe (boot / MOTOR_PRESENT): every DRV2605 auto-calibrates
+// at once and is polled round-robin, so the probe takes as long as the
+// slowest motor instead of the sum. A pass that dips the supply (all motors
+// driving together) is retried one port at a time.
+#ifndef MOTOR_PROBE_PARALLEL_ENABLED
+#define MOTOR_PROBE_PARALLEL_ENABLED 1
+#endif
+
 // Finger indices (boards with MAX_ACTUATORS == 5 add the thumb on index 4)
 #define FINGER_INDEX 0
 #define FINGER_MIDDLE 1
@@ -189,6 +424,98 @@ constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 #define FINGER_PINKY 3
 #define FINGER_THUMB 4
 
+// Motor event dispatch: the motor task arms a one-shot compare on the 1MHz
+// hardware timebase and blocks until it fires, instead of spinning on
+// getMicros() for the last millisecond. The alarm fires LEAD_US early and the
+// remainder is spun to absorb ISR entry + context switch. Falls back to the
+// sleep + busy-wait path when the timebase is unavailable.
+#ifndef MOTOR_TIMER_DISPATCH_ENABLED
+#define MOTOR_TIMER_DISPATCH_ENABLED 1
+#endif
+#define MOTOR_TIMER_DISPATCH_LEAD_US 50        // Alarm fires this far before the event
+#define MOTOR_TIMER_DISPATCH_MAX_US 1000000    // Longer waits use FreeRTOS sleep first
+
+// Motor event batching: events due within this window of the first due event
+// are executed as one I2C burst (shared mux selections, one channel close)
+// instead of one select/write/close per event. Later events in a cluster fire
+// up to this much early rather than ~500us late per preceding event. 0 disables.
+#define MOTOR_BATCH_WINDOW_US 300
+
+// Late-event recovery: an activation the motor task reaches more than
+// LATE_EVENT_THRESHOLD_US after its time (I2C retry, BLE burst) is dropped
+// with its deactivation, or the whole pending schedule is shifted by the
+// lateness, instead of firing a back-to-back chain of late activations.
+// Deactivations always run. LATE_EVENT_RESYNC_RUN consecutive late
+// activations (a macrocycle's worth) ask the PRIMARY to resync. 0 disables.
+#define LATE_EVENT_EXECUTE 0                  // Fire anyway (previous behaviour)
+#define LATE_EVENT_DROP 1                     // Keep bilateral sync, lose the pulse
+#define LATE_EVENT_SHIFT 2                    // Keep the pattern; queued cycles lag the other glove
+#ifndef LATE_EVENT_POLICY
+#define LATE_EVENT_POLICY LATE_EVENT_DROP
+#endif
+#define LATE_EVENT_THRESHOLD_US 5000
+#define LATE_EVENT_RESYNC_RUN 12              // One 4-finger macrocycle (3 x 4 activations)
+
+// Asynchronous haptic I2C (EXPERIMENTAL, PentaBuzzer ESP32-S3 only): the motor
+// task posts select/frequency/RTP commands to a ring drained by a dedicated
+// I2C worker task (haptic_i2c_engine.h) instead of performing the blocking
+// Wire transactions itself. Drift metrics come from the completion callback.
+// Clustered events are submitted back-to-back (MOTOR_BATCH_WINDOW_US unused).
+#ifndef HAPTIC_ASYNC_I2C_ENABLED
+#define HAPTIC_ASYNC_I2C_ENABLED 0
+#endif
+#if HAPTIC_ASYNC_I2C_ENABLED && !defined(BOARD_PENTABUZZER_ESP32S3)
+#error "HAPTIC_ASYNC_I2C_ENABLED is only supported on the PentaBuzzer ESP32-S3"
+#endif
+
+// Look-ahead I2C pre-selection (preselect_planner.h): the motor task opens
+// each activation's mux channel and writes its frequency PRESELECT_LEAD_US
+// ahead, after the gap's other I2C work, so the activation itself is one RTP
+// write ([FAST]). Whenever the queue changes the whole schedule is planned;
+// activations whose gap cannot fit a pre-selection get their frequency write
+// staged into an earlier gap instead. Costs are worst-case bus estimates.
+#define PRESELECT_LEAD_US 1000         // Pre-select this far ahead of an activation
+#define PRESELECT_COST_US 300          // Mux select + CONTROL1 write (also one staged write)
+#define PRESELECT_EVENT_COST_US 500    // Bus time of one executed event (slow path)
+#define PRESELECT_STAGE_SLOTS 16       // Staged frequency writes per plan
+
+// Motor health monitor (motor_health.h): the motor task reads back one
+// DRV2605 register per idle gap when the slice fits before the next
+// pre-select slot, reconfigures chips found reset, and loop() drops a motor
+// with repeated bad readbacks from the therapy finger map until it recovers.
+// Replaces the macrocycle-boundary verifyAndHeal() probe when enabled.
+#ifndef MOTOR_HEALTH_MONITOR_ENABLED
+#define MOTOR_HEALTH_MONITOR_ENABLED 1
+#endif
+#define MOTOR_HEALTH_SLICE_BUDGET_US 400     // One select + register read + close
+#define MOTOR_HEALTH_HEAL_COST_US 2000       // Reconfigure one chip
+#define MOTOR_HEALTH_IDLE_INTERVAL_MS 250    // Slice period with nothing queued
+#define MOTOR_HEALTH_FAIL_THRESHOLD 3        // Bad readbacks in a row before a motor is dropped
+#define MOTOR_HEALTH_RECOVER_READS 9         // Clean readbacks in a row to restore it (3 passes)
+
+// Idle power mode (PowerController): loop() blocks between housekeeping
+// passes and the motor task blocks through long gaps with idle sleep allowed,
+// so the scheduler idles - tickless idle + WFE on nRF52 (TIMER4 keeps
+// running), automatic light sleep / frequency scaling on ESP32-S3 under a PM
+// lock the motor task holds for every final approach. loop() waits on its
+// wake set (loop_wake.h) until the nearest software-timer deadline, capped
+// by the LOOP_WAKE_* ceilings below. Waits under POWER_IDLE_MIN_MS stay on
+// the awake path.
+#ifndef POWER_IDLE_SLEEP_ENABLED
+#define POWER_IDLE_SLEEP_ENABLED 1
+#endif
+#define POWER_IDLE_MIN_MS 5      // Shortest motor-task gap worth sleeping through
+#define POWER_IDLE_GUARD_MS 3    // Wake this far ahead of a motor event (sleep exit + pre-select)
+#define POWER_IDLE_LOOP_MS 10    // Longest loop() block during a session (therapy, coast, menu timers)
+#define LOOP_WAKE_MAX_MS 100       // Longest block otherwise (serial console, module-internal timers)
+#define LOOP_WAKE_TX_RETRY_MS 2    // TX queue not empty: retry a congested link (TX-complete wakes earlier)
+#if POWER_IDLE_MIN_MS <= POWER_IDLE_GUARD_MS
+#error "POWER_IDLE_MIN_MS must exceed POWER_IDLE_GUARD_MS (the post-wake gap must stay awake)"
+#endif
+#if POWER_IDLE_LOOP_MS >= MACROCYCLE_SEEDED_COAST_GUARD_MS
+#error "POWER_IDLE_LOOP_MS must stay below MACROCYCLE_SEEDED_COAST_GUARD_MS (coast runs from loop())"
+#endif
+
 // =============================================================================
 // LED COLORS (RGB values)
 // =============================================================================
@@ -229,10 +556,51 @@ constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 // =============================================================================
 
 #define BLE_EOT_CHAR 0x04               // End of transmission marker (ASCII EOT)
-#define BLE_CHUNK_SIZE 100              // Max bytes per BLE packet
+#define BLE_CHUNK_SIZE 100              // Single-notification budget for compact frames (MC V6); links chunk at bleNotifyPayload()
+#define BLE_ATT_MTU 247                 // ATT MTU requested on connect (one 251-byte LL PDU)
+#define BLE_ATT_MTU_MIN 23              // Spec default until the MTU exchange completes
+#define BLE_DLE_TX_OCTETS 251           // LE Data Length Extension: max LL payload
+#define BLE_DLE_TX_TIME_US 2120         // Air time for a 251-byte PDU on 1M PHY
+#define BLE_TX_WRITES_PER_PASS 8        // Notifications processTxQueue hands over per pass (= HVN queue)
 #define BLE_MAX_MESSAGE_SIZE 512        // Max total message size
 #define BLE_NAME "BlueBuzzah"           // Default BLE device name
 
+// Multi-SECONDARY fan-out (PRIMARY): SECONDARY links the PRIMARY accepts
+// alongside the phone. The first keeps the full single-peer sync path; each
+// further one (ankle/foot units) gets its own PING/PONG clock offset and
+// full V6 macrocycles with that offset patched in at send time
+// (secondary_peers.h). 1 = the classic phone + one glove pair. ESP32-S3:
+// NimBLE's CONFIG_BT_NIMBLE_MAX_CONNECTIONS (3 in the Arduino core) must
+// cover 1 + BLE_MAX_SECONDARIES.
+#ifndef BLE_MAX_SECONDARIES
+#define BLE_MAX_SECONDARIES 1
+#endif
+
+// Schedule broadcast (schedule_broadcast.h, ESP32-S3 only, EXPERIMENTAL):
+// PRIMARY also publishes each macrocycle on a BLE 5 periodic advertising
+// train; every SECONDARY syncs to it and timestamps the same train events,
+// a shared anchor with no connection-event or retransmission jitter. The
+// GATT copy still goes out (ACKs, fallback); whichever arrives first is
+// scheduled. Needs a NimBLE build with CONFIG_BT_NIMBLE_EXT_ADV=1,
+// CONFIG_BT_NIMBLE_MAX_EXT_ADV_INSTANCES=2 and
+// CONFIG_BT_NIMBLE_ENABLE_PERIODIC_ADV=1 / ..._PERIODIC_SYNC=1.
+#ifndef SYNC_PERIODIC_ADV_ENABLED
+#define SYNC_PERIODIC_ADV_ENABLED 0
+#endif
+#define SYNC_PERIODIC_ADV_INSTANCE 1          // Ext-adv instance (0 is the connectable advertiser)
+#define SYNC_PERIODIC_ADV_SID 1               // Advertising set ID listeners sync to
+#define SYNC_PERIODIC_ADV_INTERVAL_MS 100     // Train interval (1.25ms multiple)
+#define SYNC_PERIODIC_ADV_MAX_DATA 247        // One AUX_SYNC_IND: no chained fragments
+#define SYNC_PERIODIC_ADV_ANCHOR_WINDOW 8     // Train events in the lucky-packet minimum
+#define SYNC_PERIODIC_ADV_BIAS_EMA_DIV 8      // Train-start bias EMA (1/8 per GATT macrocycle)
+#define SYNC_PERIODIC_ADV_MIN_BIAS_SAMPLES 4  // Calibrations before the anchor is used
+
+// Binary TLV phone responses (phone_protocol.h), granted to phones that
+// identify with "IDENTIFY:PHONE:3". 0 answers every phone in text.
+#ifndef PHONE_PROTOCOL_V3_ENABLED
+#define PHONE_PROTOCOL_V3_ENABLED 1
+#endif
+
 // =============================================================================
 // DEVELOPMENT/DEBUG FLAGS
 // =============================================================================
@@ -253,6 +621,29 @@ constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 #endif
 #define SYNC_DEBUG_GPIO_PIN PIN_A0
 
+// Self-measured skew (skew_capture.h): the SECONDARY captures the PRIMARY's
+// SYNC_DEBUG_GPIO pulse (PRIMARY SYNC_DEBUG_GPIO_PIN wired to SECONDARY
+// SYNC_SKEW_CAPTURE_PIN, grounds joined), pairs it with its own activations
+// and feeds the skew into the latency metrics. Compile-time only.
+#ifndef SYNC_SKEW_CAPTURE_ENABLED
+#define SYNC_SKEW_CAPTURE_ENABLED 0
+#endif
+#if SYNC_SKEW_CAPTURE_ENABLED && !SYNC_DEBUG_GPIO_ENABLED
+#error "SYNC_SKEW_CAPTURE_ENABLED needs SYNC_DEBUG_GPIO_ENABLED (both gloves pulse the debug pin)"
+#endif
+#define SYNC_SKEW_CAPTURE_PIN PIN_A1
+#define SYNC_SKEW_CAPTURE_WINDOW_US 20000     // Max |skew| paired; older lone edges expire
+#define SYNC_SKEW_CAPTURE_RING_SIZE 16        // Staged edges per side (power of two)
+#define SYNC_SKEW_CAPTURE_PPI_CHANNEL 7       // nRF52: PPI channel GPIOTE -> TIMER4 capture
+#define SYNC_SKEW_CAPTURE_TIMER_CC 3          // nRF52: TIMER4 CC register (CC[4]/CC[5] are hires_clock's)
+
+// Cycle-count profiling of hot paths (perf_profile.h): PERF_SCOPE() markers
+// record min/max/avg CPU cycles per scope, dumped by the GET_PERF serial and
+// PERF phone commands. Compile-time only - the markers vanish when 0.
+#ifndef PERF_PROFILE_ENABLED
+#define PERF_PROFILE_ENABLED 0
+#endif
+
 // Debug macros
 #if DEBUG_ENABLED
     #define DEBUG_PRINT(x) Serial.print(x)
@@ -272,6 +663,72 @@ constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 #define LATENCY_REPORT_INTERVAL_MS 30000  // Auto-report every 30s when enabled
 #define LATENCY_LATE_THRESHOLD_US 1000    // >1ms considered "late"
 
+// Log-linear histograms (percentile reporting). Each octave is split into
+// 2^SUB_BITS linear buckets (12.5% resolution at 3); magnitudes at or above
+// 2^MAX_BITS us land in the last bucket. Each signed histogram takes
+// 2 * 2^SUB_BITS * (MAX_BITS - SUB_BITS + 1) uint16_t counters (480 B).
+#define LATENCY_HIST_SUB_BITS 3
+#define LATENCY_HIST_MAX_BITS 17          // 131ms
+
+// Binary telemetry stream to the phone (LATENCY_STREAM menu command).
+// Frames are sent only while the BLE TX queue is at or below the backlog
+// limit, so commands and sync traffic always go first.
+#define LATENCY_STREAM_INTERVAL_MS 250    // Frame cadence while streaming
+#define LATENCY_STREAM_RING_SIZE 64       // Staged samples per ring (power of 2)
+#define LATENCY_STREAM_MAX_SAMPLES 24     // Samples per frame (178 B binary, 245 B text)
+#define LATENCY_STREAM_MAX_TX_BACKLOG 2   // Max queued TX messages to send a frame
+
+// =============================================================================
+// SESSION JOURNAL
+// =============================================================================
+
+// Binary session log (session_journal.h): 16-byte records collected in two
+// RAM pages and appended to a ring of segment files one page at a time,
+// from loop() only while the motor task has a gap. Sized per filesystem:
+// nRF52 InternalFS is 28 KB in total, PentaBuzzer LittleFS is 1.9 MB.
+#ifndef SESSION_JOURNAL_ENABLED
+#define SESSION_JOURNAL_ENABLED 1
+#endif
+#define SESSION_JOURNAL_PAGE_BYTES 512          // One flash write (31 records + header)
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+#define SESSION_JOURNAL_SEGMENT_PAGES 32        // 16 KB per segment file
+#define SESSION_JOURNAL_SEGMENTS 64             // 1 MB: ~3 h of events
+#else
+#define SESSION_JOURNAL_SEGMENT_PAGES 8         // 4 KB (one InternalFS block)
+#define SESSION_JOURNAL_SEGMENTS 2              // 8 KB: the last few minutes
+#endif
+#define SESSION_JOURNAL_FLUSH_CHECK_MS 250      // loop() polls for a full page
+#define SESSION_JOURNAL_FLUSH_GUARD_US 100000   // Motor gap a flush needs (covers an ~85 ms nRF52 page erase)
+#define SESSION_JOURNAL_CHUNK_BYTES 128         // JOURNAL_GET payload (256 hex chars in text)
+
+// =============================================================================
+// SETTINGS STORE
+// =============================================================================
+
+// Settings are appended as changed byte ranges (settings_log.h) and written
+// from loop() once changes have been quiet for the debounce, so a burst of
+// phone toggles costs one short append. The log is compacted into the other
+// of two files when it would outgrow SETTINGS_LOG_MAX_BYTES.
+#define SETTINGS_LOG_MAX_BYTES 512        // Log file bound before compaction
+#define SETTINGS_SAVE_DEBOUNCE_MS 2000    // Quiet time before a deferred save
+#define SETTINGS_SAVE_CHECK_MS 500        // loop() polls for a due save
+
+// =============================================================================
+// DEFERRED WORK
+// =============================================================================
+
+// Work deferred from BLE callbacks to loop() (deferred_queue.h). loop()
+// drains items, haptic feedback first, while their budgeted cost fits before
+// the next motor event minus the guard, so deferred I2C never overlaps a
+// scheduled activation. Costs are worst-case estimates per item.
+#define DEFERRED_QUEUE_SLOTS 8                 // Ring size per priority (holds SLOTS - 1)
+#define DEFERRED_MOTOR_GUARD_US 1000           // Keep this much clear before a motor event
+#define DEFERRED_WORK_COST_US 300              // Pulse enqueue, deactivate, scanner, LED
+#define DEFERRED_HEAL_COST_US 2000             // DRV2605 reset check (a rare reconfigure overruns)
+#if DEFERRED_MOTOR_GUARD_US < PRESELECT_LEAD_US
+#error "DEFERRED_MOTOR_GUARD_US must cover PRESELECT_LEAD_US (deferred I2C would undo a pre-selection)"
+#endif
+
 // =============================================================================
 // MEMORY MANAGEMENT
 // =============================================================================
@@ -281,4 +738,41 @@ constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 #define RX_BUFFER_SIZE MESSAGE_BUFFER_SIZE  // BLE receive buffer
 #define TX_BUFFER_SIZE MESSAGE_BUFFER_SIZE  // BLE transmit buffer
 
+// BLE TX queue: one FIFO per priority class (BLETxQueue), drained highest
+// class first. Slots hold message + EOT; short classes get short slots.
+#define BLE_TX_SYNC_SLOTS 6                             // Stamped PING/PONG, MC_ACK
+#define BLE_TX_SYNC_SLOT_BYTES 128                      // Stamped PONG is ~82 B
+#define BLE_TX_MACROCYCLE_SLOTS 4                       // Glove-to-glove control + MC
+#define BLE_TX_MACROCYCLE_SLOT_BYTES MESSAGE_BUFFER_SIZE
+#define BLE_TX_RESPONSE_SLOTS 6                         // Phone responses (HELP, PROFILE_GET)
+#define BLE_TX_RESPONSE_SLOT_BYTES MESSAGE_BUFFER_SIZE
+#define BLE_TX_TELEMETRY_SLOTS 2                        // LATS frames
+#define BLE_TX_TELEMETRY_SLOT_BYTES 256                 // 245 B text + EOT
+
+// Motor scheduling rings (powers of two). The activation queue holds one
+// macrocycle's activations plus their deactivations with margin; the staging
+// ring carries events from BLE callbacks to the motor task.
+#ifndef ACTIVATION_QUEUE_MAX_EVENTS
+#define ACTIVATION_QUEUE_MAX_EVENTS 64
+#endif
+#ifndef MOTOR_EVENT_BUFFER_SLOTS
+#define MOTOR_EVENT_BUFFER_SLOTS 32
+#endif
+
+// Motor task stack in bytes (the nRF52 core takes words: bytes / 4). Fast
+// boot runs the Serial.printf-heavy driver bring-up on this stack too.
+#ifndef MOTOR_TASK_STACK_BYTES
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+#define MOTOR_TASK_STACK_BYTES 4096
+#elif FAST_BOOT_ENABLED
+#define MOTOR_TASK_STACK_BYTES 3072
+#else
+#define MOTOR_TASK_STACK_BYTES 2048
+#endif
+#endif
+
+// MEMORY command (memory_report.h): static footprint rows and tracked tasks
+#define MEMORY_REPORT_MAX_REGIONS 24
+#define MEMORY_REPORT_MAX_TASKS 6
+
 #endif // CONFIG_H
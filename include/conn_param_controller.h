@@ -0,0 +1,88 @@
+/**
+ * @file conn_param_controller.h
+ * @brief Connection-parameter policy driven by therapy state
+ *
+ * The radio duty cycle dominates idle drain, so the 7.5-10ms interval is
+ * only worth paying while it buys something: a running session (macrocycle
+ * lead time) or clock-sync warm-up (RTT quality). Everywhere else the links
+ * relax to BLE_RELAXED_INTERVAL_* with slave latency.
+ *
+ * Tightening is immediate - the state callback fires on START/RESUME,
+ * before the therapy engine generates the session's first macrocycle.
+ * Relaxing waits BLE_CONN_PARAM_RELAX_DELAY_MS so STOP -> START doesn't
+ * bounce the link through two parameter updates.
+ *
+ * Pure policy; BLEManager::applyConnParamProfile() issues the requests.
+ */
+
+#ifndef CONN_PARAM_CONTROLLER_H
+#define CONN_PARAM_CONTROLLER_H
+
+#include <stdint.h>
+#include "config.h"
+#include "types.h"
+
+/**
+ * @brief Connection-parameter profile applied to every link
+ */
+enum class ConnParamProfile : uint8_t {
+    TIGHT = 0,   // BLE_INTERVAL_MIN/MAX_MS, no latency, 2M PHY
+    RELAXED      // BLE_RELAXED_INTERVAL_*, BLE_RELAXED_SLAVE_LATENCY
+};
+
+/**
+ * @class ConnParamController
+ * @brief Decides when the links should switch profile
+ */
+class ConnParamController {
+public:
+    ConnParamController();
+
+    /**
+     * @brief Feed a state-machine transition
+     *
+     * PHONE_DISCONNECTED is informational (a session may keep running
+     * through it), so it keeps the previous state's policy.
+     */
+    void onStateChange(TherapyState toState);
+
+    /** @brief Clock sync is collecting its first offset samples */
+    void setSyncWarmup(bool warmingUp) { _syncWarmup = warmingUp; }
+
+    /** @brief External power present: relax unless a session needs the link */
+    void setCharging(bool charging) { _charging = charging; }
+
+    /**
+     * @brief A link came up on the connect-time (tight) parameters
+     *
+     * Restarts the relax delay so the new link is relaxed too once idle.
+     * Safe from BLE callbacks; update() picks it up.
+     */
+    void onLinkUp() { _linkUpPending = true; }
+
+    /** @brief Profile the current inputs call for (before the relax delay) */
+    ConnParamProfile desired() const;
+
+    /** @brief Profile last handed out by update() */
+    ConnParamProfile applied() const { return _applied; }
+
+    /**
+     * @brief Advance the policy (main loop)
+     * @param nowMs millis()
+     * @param profile Profile to apply when returning true
+     * @return true when the links should switch to profile
+     */
+    bool update(uint32_t nowMs, ConnParamProfile& profile);
+
+private:
+    static bool stateNeedsTightLink(TherapyState state);
+
+    volatile bool _sessionNeedsTight;   // Written from state callbacks (BLE task)
+    volatile bool _syncWarmup;
+    volatile bool _linkUpPending;
+    bool _charging;
+    ConnParamProfile _applied;
+    uint32_t _tightSinceMs;             // Last time the inputs asked for TIGHT
+};
+
+#endif // CONN_PARAM_CONTROLLER_H
@@ -6,12 +6,18 @@
  * Provides a mechanism to defer work from ISR/callback context to main loop.
  * Operations that aren't safe in callback context (blocking I2C, delays)
  * are enqueued here and processed in the main loop.
+ *
+ * Work has two priorities: haptic feedback drains ahead of housekeeping. The loop drains as many items as fit before the
+ * next motor event with processUntil(); each work type has a conservative
+ * cost estimate, so an item only starts if it is expected to finish by the
+ * deadline and the motor task never finds the I2C bus busy with deferred work.
  */
 
 #ifndef DEFERRED_QUEUE_H
 #define DEFERRED_QUEUE_H
 
 #include <Arduino.h>
+#include "config.h"
 
 /**
  * @brief Types of work that can be deferred
@@ -26,6 +32,25 @@ enum class DeferredWorkType : uint8_t {
     LED_FLASH            // r, g, b (packed in param1/2/3)
 };
 
+/**
+ * @brief Drain order (FEEDBACK first); set by the work type
+ */
+enum class DeferredPriority : uint8_t {
+    FEEDBACK = 0,   // Haptic feedback the user is waiting on
+    HOUSEKEEPING,   // Heal, scanner restart, LED
+    COUNT
+};
+
+/**
+ * @brief Queue counters (GET_LATENCY)
+ */
+struct DeferredQueueStats {
+    uint32_t processed;                                                 // Items executed
+    uint32_t overflows[static_cast<uint8_t>(DeferredPriority::COUNT)];  // Rejected enqueues
+    uint32_t maxLatencyUs;                                              // Worst enqueue-to-execute
+    uint32_t motorWaits;                                                // Drains cut short by a motor event
+};
+
 /**
  * @class DeferredQueue
  * @brief ISR-safe queue for deferring work to main loop
@@ -38,18 +63,25 @@ enum class DeferredWorkType : uint8_t {
  *   deferredQueue.enqueue(DeferredWorkType::HAPTIC_PULSE, finger, amplitude, durationMs);
  *
  *   // In main loop:
- *   deferredQueue.processOne();  // Executes one item per loop iteration
+ *   deferredQueue.processUntil(getMicros(), nextMotorEventUs - guardUs);
  *
- * CONSTRAINT: single-producer / single-consumer. The lock-free ring buffer
- * is only safe with ONE producing context (the BLE callback task) and ONE
- * consuming context (the main loop). Do not enqueue from any other task.
+ * CONSTRAINT: single-producer / single-consumer. Each priority's lock-free
+ * ring buffer is only safe with ONE producing context (the BLE callback task)
+ * and ONE consuming context (the main loop). Do not enqueue from any other
+ * task. Overflow counters belong to the producer, the rest to the consumer.
  */
 class DeferredQueue {
 public:
     DeferredQueue();
 
+    static constexpr uint8_t MAX_WORK = DEFERRED_QUEUE_SLOTS;  // Per priority (one slot stays empty)
+    static constexpr uint8_t PRIORITY_COUNT = static_cast<uint8_t>(DeferredPriority::COUNT);
+
     /**
      * @brief Enqueue work for deferred execution
+     *
+     * The item joins the ring of priorityOf(type).
+     *
      * @param type Type of work
      * @param param1 First parameter (work-type specific)
      * @param param2 Second parameter (work-type specific)
@@ -61,22 +93,53 @@ public:
     bool enqueue(DeferredWorkType type, uint8_t param1 = 0, uint8_t param2 = 0, uint32_t param3 = 0);
 
     /**
-     * @brief Process one queued work item
+     * @brief Process one queued work item (highest priority first)
      *
-     * Call from main loop. Processes at most one item per call
-     * to maintain loop responsiveness.
+     * Ignores cost estimates; use processUntil() near motor events.
      *
      * @return true if work was processed, false if queue empty
      */
     bool processOne();
 
+    /**
+     * @brief Process items, highest priority first, while they fit
+     *
+     * An item runs only if nowUs plus the estimated cost of everything
+     * run so far and of the item itself stays within deadlineUs. Stops at
+     * the first item that does not fit, so a lower-priority item never
+     * overtakes a waiting higher-priority one.
+     *
+     * @param nowUs Current time (getMicros() timebase)
+     * @param deadlineUs Latest finish time (UINT64_MAX: no motor event pending)
+     * @return Number of items executed
+     */
+    uint8_t processUntil(uint64_t nowUs, uint64_t deadlineUs);
+
+    /**
+     * @brief Whether the next item would run under processUntil()
+     * @return false if the queue is empty or the item does not fit
+     */
+    bool nextFits(uint64_t nowUs, uint64_t deadlineUs) const;
+
+    /** @brief Priority of a work type */
+    static DeferredPriority priorityOf(DeferredWorkType type);
+
+    /** @brief Budgeted execution time of a work type (config.h DEFERRED_*_COST_US) */
+    static uint32_t costUs(DeferredWorkType type);
+
+    /** @brief Counter snapshot */
+    DeferredQueueStats getStats() const;
+
+    /** @brief Zero the counters */
+    void resetStats();
+
     /**
      * @brief Check if queue has pending work
      */
     bool hasPending() const;
 
     /**
-     * @brief Get number of pending items
+     * @brief Get number of pending items (all priorities)
      */
     uint8_t getPendingCount() const;
 
@@ -94,21 +157,49 @@ public:
     typedef void (*WorkExecutor)(DeferredWorkType type, uint8_t p1, uint8_t p2, uint32_t p3);
     void setExecutor(WorkExecutor executor);
 
-private:
-    static constexpr uint8_t MAX_WORK = 8;
+    /**
+     * @brief Set callback run after each successful enqueue()
+     *
+     * Runs in the producer's context; used to wake the main loop.
+     */
+    typedef void (*WakeCallback)();
+    void setWakeCallback(WakeCallback callback);
 
+private:
     struct Work {
         DeferredWorkType type;
         uint8_t param1;
         uint8_t param2;
         uint32_t param3;
+        uint32_t enqueuedUs;  // micros() at enqueue (latency counter)
+    };
+
+    struct Ring {
+        volatile Work items[MAX_WORK];
+        volatile uint8_t head;  // Write index (producer)
+        volatile uint8_t tail;  // Read index (consumer)
     };
 
-    volatile Work _queue[MAX_WORK];
-    volatile uint8_t _head;  // Write index (producer)
-    volatile uint8_t _tail;  // Read index (consumer)
+    /** @brief Highest-priority non-empty ring, nullptr if all are empty */
+    Ring* nextRing();
+    const Ring* nextRing() const;
+
+    /** @brief Type of the ring's oldest item (ring must be non-empty) */
+    static DeferredWorkType peekType(const Ring& ring);
+
+    /** @brief Pop the ring's oldest item and execute it */
+    void runOne(Ring& ring);
+
+    Ring _rings[PRIORITY_COUNT];
 
     WorkExecutor _executor;
+    WakeCallback _wake;
+
+    // Counters: overflows are written by the producer only, the rest by the consumer
+    volatile uint32_t _overflows[PRIORITY_COUNT];
+    uint32_t _processed;
+    uint32_t _maxLatencyUs;
+    uint32_t _motorWaits;
 };
 
 // Global instance
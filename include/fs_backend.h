@@ -32,6 +32,16 @@ bool readFile(const char* path, uint8_t* buf, size_t cap, size_t& outLen);
 /** Write len bytes to a file from the start (overwrites existing content). */
 bool writeFile(const char* path, const uint8_t* buf, size_t len);
 
+/** Append len bytes to a file, creating it if missing. */
+bool appendFile(const char* path, const uint8_t* buf, size_t len);
+
+/**
+ * Read up to cap bytes starting at offset.
+ * @param outLen receives the number of bytes read (0 at or past the end)
+ * @return true if the file opened
+ */
+bool readAt(const char* path, size_t offset, uint8_t* buf, size_t cap, size_t& outLen);
+
 /** Remove a file. @return true if removed */
 bool removeFile(const char* path);
 
@@ -0,0 +1,117 @@
+/**
+ * @file haptic_i2c_engine.h
+ * @brief Asynchronous haptic I2C command engine (PentaBuzzer ESP32-S3)
+ * @version 1.0.0
+ * @platform Seeed XIAO ESP32-S3 (PentaBuzzer)
+ *
+ * Moves DRV2605/TCA9548A bus traffic off the motor task: the motor task posts
+ * small commands (select channel, write frequency, write RTP, close channels)
+ * to a lock-free ring and returns immediately. A dedicated worker task drains
+ * the ring through HapticController - which still owns the I2C mutex, so
+ * battery reads and self-heal probes interleave at transaction granularity -
+ * and reports completion (with a timestamp) via callback.
+ *
+ * Arduino Wire owns the I2C controller (Adafruit_DRV2605 uses it directly),
+ * so the worker issues blocking Wire transactions; the asynchrony is between
+ * the motor task and the bus, not inside the driver.
+ *
+ * Enabled with HAPTIC_ASYNC_I2C_ENABLED (config.h).
+ */
+
+#ifndef HAPTIC_I2C_ENGINE_H
+#define HAPTIC_I2C_ENGINE_H
+
+#include <Arduino.h>
+#include "platform.h"
+#include "types.h"
+
+class HapticController;
+
+/**
+ * @brief Haptic bus operation
+ */
+enum class HapticI2CCommandType : uint8_t {
+    SELECT_CHANNEL,   // selectChannelPersistent(finger) - exclusive
+    WRITE_FREQUENCY,  // setFrequencyDirect(finger, frequencyHz) - channel pre-selected
+    WRITE_RTP,        // activatePreSelected(finger, amplitude) - re-selects if needed
+    CLOSE_CHANNELS    // closeAllChannels()
+};
+
+/**
+ * @brief One queued haptic bus operation
+ */
+struct HapticI2CCommand {
+    uint64_t dueUs;             // Scheduled event time (for drift reporting)
+    HapticI2CCommandType type;
+    uint8_t finger;             // Finger index (0 to MAX_ACTUATORS-1)
+    uint8_t amplitude;          // WRITE_RTP: amplitude percentage (0 = off)
+    bool notify;                // Invoke the completion callback after execution
+    bool fastPath;              // WRITE_RTP: issued on a pre-selected channel (metrics)
+    uint16_t frequencyHz;       // WRITE_FREQUENCY: LRA frequency in Hz
+};
+
+/**
+ * @class HapticI2CEngine
+ * @brief Single-producer command ring drained by an I2C worker task
+ *
+ * CONSTRAINT: single-producer / single-consumer. Only the motor task may
+ * submit(); only the worker task consumes.
+ */
+class HapticI2CEngine {
+public:
+    /**
+     * @brief Completion callback, invoked from the worker task
+     * @param cmd The executed command (notify == true)
+     * @param result HapticController result code
+     * @param completedUs getMicros() right after the bus transaction
+     */
+    typedef void (*CompletionCallback)(const HapticI2CCommand& cmd, Result result, uint64_t completedUs);
+
+    static constexpr uint8_t RING_SIZE = 16;  // Power of two
+
+    HapticI2CEngine();
+
+    /**
+     * @brief Create the worker task
+     * @param haptic Controller that executes the commands
+     * @param onComplete Completion callback (may be nullptr)
+     * @return true if the worker is running
+     */
+    bool begin(HapticController* haptic, CompletionCallback onComplete);
+
+    /**
+     * @brief Whether the worker task is running
+     */
+    bool isRunning() const { return _worker != nullptr; }
+
+    /**
+     * @brief Queue a command without blocking
+     * @return false if the ring is full or the engine is not running
+     */
+    bool submit(const HapticI2CCommand& cmd);
+
+    /**
+     * @brief Number of queued commands (excludes the one in flight)
+     */
+    uint8_t pendingCount() const;
+
+private:
+    static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of two");
+
+    HapticI2CCommand _ring[RING_SIZE];
+    volatile uint8_t _head;  // Write index (producer)
+    volatile uint8_t _tail;  // Read index (consumer)
+
+    HapticController* _haptic;
+    CompletionCallback _onComplete;
+    TaskHandle_t _worker;
+
+    static void workerTask(void* param);
+    void drain();
+    Result execute(const HapticI2CCommand& cmd);
+};
+
+// Global instance
+extern HapticI2CEngine hapticI2CEngine;
+
+#endif // HAPTIC_I2C_ENGINE_H
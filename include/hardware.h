@@ -24,11 +24,69 @@
 #include "config.h"
 #include "types.h"
 #include "vbat_estimator.h"
+#include "led_waveform.h"  // LEDPattern
 
 // =============================================================================
 // HAPTIC CONTROLLER
 // =============================================================================
 
+/**
+ * @brief One motor update in a HapticController::applyBatch() burst
+ */
+struct HapticBatchOp {
+    uint8_t finger;        // Finger index (0 to MAX_ACTUATORS-1)
+    uint8_t amplitude;     // Amplitude percentage (0 = deactivate)
+    uint16_t frequencyHz;  // LRA frequency for activations (0 = unchanged)
+};
+
+/**
+ * @brief Last values written to the DRV2605 registers touched at runtime
+ *
+ * A slot is trusted only while its valid bit is set. invalidate() drops all
+ * of them whenever the chip may hold something else: configureDRV2605()
+ * (which runs after every detected POR reset) and a failed bus negotiation.
+ */
+struct DRV2605Shadow {
+    enum Slot : uint8_t { MODE, RTP, RATEDV, CONTROL1, CONTROL3, SLOT_COUNT };
+
+    uint8_t value[SLOT_COUNT] = {0};
+    uint8_t validMask = 0;
+
+    bool matches(Slot slot, uint8_t v) const {
+        return (validMask & (1u << slot)) && value[slot] == v;
+    }
+    void set(Slot slot, uint8_t v) {
+        value[slot] = v;
+        validMask |= static_cast<uint8_t>(1u << slot);
+    }
+    void invalidate() { validMask = 0; }
+};
+
+/**
+ * @brief DRV2605 register values, computed at compile time
+ *
+ * Events carry amplitude (%) and frequency (Hz) on the wire, so the register
+ * conversions stay in the driver; these tables keep the divides out of the
+ * activation path. Values outside the table range fall back to the formula.
+ */
+struct DRV2605Lookup {
+    static constexpr uint8_t FREQUENCY_SPAN = MAX_FREQUENCY_HZ - MIN_FREQUENCY_HZ + 1;
+
+    uint8_t rtp[MAX_AMPLITUDE + 1];        // amplitude % -> RTP (0-DRV2605_MAX_RTP)
+    uint8_t driveTime[FREQUENCY_SPAN];     // Hz - MIN_FREQUENCY_HZ -> CONTROL1 drive time
+
+    constexpr DRV2605Lookup() : rtp{}, driveTime{} {
+        for (uint16_t a = 0; a <= MAX_AMPLITUDE; a++) {
+            rtp[a] = static_cast<uint8_t>((a * DRV2605_MAX_RTP) / MAX_AMPLITUDE);
+        }
+        for (uint16_t i = 0; i < FREQUENCY_SPAN; i++) {
+            driveTime[i] = static_cast<uint8_t>((5000 / (MIN_FREQUENCY_HZ + i)) & 0x1F);  // DRV2605 datasheet
+        }
+    }
+};
+
+inline constexpr DRV2605Lookup DRV2605_LOOKUP{};
+
 /**
  * @brief Controls MAX_ACTUATORS DRV2605 haptic drivers via TCA9548A I2C multiplexer
  *
@@ -61,6 +119,26 @@ public:
      */
     bool initializeFinger(uint8_t finger);
 
+    /**
+     * @brief Raise the bus to I2C_FREQUENCY_MAX if every enabled channel
+     * passes a register read-back there, else stay at I2C_FREQUENCY
+     *
+     * Called by begin() after all fingers are configured. Blocking (a few
+     * transactions per channel); re-run after re-initializing drivers.
+     * @return Negotiated bus frequency in Hz
+     */
+    uint32_t negotiateBusSpeed();
+
+    /**
+     * @brief Bus frequency chosen by the last negotiateBusSpeed() (Hz)
+     */
+    uint32_t getBusFrequency() const { return _busFrequency; }
+
+    /**
+     * @brief Channels that failed the last fast-bus read-back (bit f = finger f)
+     */
+    uint8_t getBusProbeFailMask() const { return _busProbeFailMask; }
+
     /**
      * @brief Activate motor on specified finger
      * @param finger Finger index (0 to MAX_ACTUATORS-1)
@@ -76,6 +154,23 @@ public:
      */
     Result deactivate(uint8_t finger);
 
+    /**
+     * @brief Apply several motor updates in a single I2C burst
+     *
+     * Resolves the ops to one final state per finger (later ops win), then
+     * writes each distinct CONTROL1 drive time and RTP value once with a
+     * multiplexer mask covering every finger that needs it. All DRV2605s
+     * share one address, so a mask with several channels open broadcasts
+     * the write. Channels are closed once at the end (invalidates any
+     * pre-selection).
+     *
+     * @param ops Updates in time order
+     * @param count Number of ops
+     * @return OK if at least one enabled finger was updated, ERROR_DISABLED
+     *         if none were, ERROR_BUSY if the I2C mutex was unavailable
+     */
+    Result applyBatch(const HapticBatchOp* ops, uint8_t count);
+
     /**
      * @brief Stop all active motors
      */
@@ -96,6 +191,25 @@ public:
      */
     uint8_t verifyAndHeal();
 
+    /**
+     * @brief Read one DRV2605 register for the health monitor (motor_health.h)
+     * One select-read-close (~150us). Never waits for the I2C mutex: a busy
+     * bus returns false so the slice stays inside its budget.
+     * @param finger Finger index (0 to MAX_ACTUATORS-1)
+     * @param reg Register address
+     * @param value Output: register value
+     * @return false if the finger is disabled or the bus is busy
+     */
+    bool readHealthRegister(uint8_t finger, uint8_t reg, uint8_t& value);
+
+    /**
+     * @brief Reconfigure one DRV2605 found at POR defaults (health monitor)
+     * Same recovery as verifyAndHeal() for a single chip; never waits for
+     * the I2C mutex.
+     * @return false if the finger is disabled or the bus is busy
+     */
+    bool healFinger(uint8_t finger);
+
     /**
      * @brief Read a burst of DRV2605 VBAT register (0x21) samples.
      * The drivers run directly from VBat, so with the chip active (EN high,
@@ -115,6 +229,15 @@ public:
      */
     uint8_t readVBatBurst(uint8_t* out, uint8_t maxSamples);
 
+    /**
+     * @brief Read one DRV2605 VBAT sample (scheduled idle-gap sampling)
+     * Same source and guards as readVBatBurst(), in a single
+     * select-read-close: the reset canary is checked on every call.
+     * @param raw Output: raw VBAT register value
+     * @return false if a motor is active, the bus is busy, or the chip PORed
+     */
+    bool readVBatSample(uint8_t& raw);
+
     /**
      * @brief Whether any motor is currently being driven
      */
@@ -135,7 +258,9 @@ public:
      * motor's resonant back-EMF to converge, so an empty JST fails
      * (DIAG_RESULT set). Prints PRESENT / NO MOTOR per port, restores the
      * LRA open-loop run config, and stores the result (see isMotorPresent()).
-     * Blocking (up to ~2s per channel); stop therapy before calling.
+     * With MOTOR_PROBE_PARALLEL_ENABLED all channels calibrate at once
+     * (retried per channel if the supply dips). Blocking (up to ~2s per
+     * pass); stop therapy before calling.
      * Populated motors buzz ~0.5s each; needs battery power.
      * @return Number of motors detected
      */
@@ -148,6 +273,14 @@ public:
         return finger < MAX_ACTUATORS && (_motorPresentMask & (1u << finger));
     }
 
+    /**
+     * @brief Seed the presence map with a previous boot's probe result
+     * (fast boot: patterns are restricted before this boot's probe runs)
+     */
+    void restoreMotorPresence(uint8_t mask) {
+        _motorPresentMask = static_cast<uint8_t>(mask & ((1u << MAX_ACTUATORS) - 1));
+    }
+
     /**
      * @brief Motor count from the last probeMotorPresence()
      */
@@ -215,6 +348,7 @@ public:
      *
      * Unlike selectChannel(), this does NOT close the channel after use.
      * Call closeChannels() explicitly when done with pre-selected operations.
+     * Exclusive: any other open channel is closed in the same mux write.
      */
     bool selectChannelPersistent(uint8_t finger);
 
@@ -259,26 +393,105 @@ private:
     bool _lastProbeDipped = false;  // last probe saw a mid-cal chip reset (supply dip)
     bool _initialized;
     int8_t _preSelectedFinger;  // Tracks which finger has mux channel pre-selected (-1 = none)
-    uint16_t _lastFrequency[MAX_ACTUATORS] = {0};  // Cached frequency per finger (skip I2C if unchanged)
+    DRV2605Shadow _shadow[MAX_ACTUATORS];  // Register shadow per driver (skip I2C if unchanged)
+    uint8_t _muxMask = 0;     // TCA9548A control register shadow
+    bool _muxValid = false;   // _muxMask matches the chip
+    uint32_t _busFrequency = I2C_FREQUENCY;  // Negotiated Wire clock (Hz)
+    uint8_t _busProbeFailMask = 0;  // bit f set = finger f failed the fast-bus read-back
     SemaphoreHandle_t _i2cMutex;  // Protects I2C operations from concurrent access
 
     /**
      * @brief Select multiplexer channel and prepare for DRV2605 communication
+     *
+     * Exclusive: any other open channel is closed. Free when the channel is
+     * already the only one open (e.g. left open by selectChannelPersistent()).
      * @param finger Finger index (0 to MAX_ACTUATORS-1)
      * @return true if channel selected successfully
      */
     bool selectChannel(uint8_t finger);
 
+    /**
+     * @brief Write the TCA9548A control register unless the shadow matches
+     * @param mask Channel bitmask (bit f = finger f)
+     */
+    void setMuxMask(uint8_t mask);
+
+    /**
+     * @brief Write a shadowed DRV2605 register and record the value
+     * PRECONDITION: channel selected, I2C mutex held
+     */
+    void writeShadowed(uint8_t finger, DRV2605Shadow::Slot slot, uint8_t value);
+
+    /**
+     * @brief writeShadowed() only if the shadow differs
+     * @return true if a bus write was issued
+     */
+    bool writeIfChanged(uint8_t finger, DRV2605Shadow::Slot slot, uint8_t value);
+
+    /**
+     * @brief Forget every shadowed value (chip and mux state unknown)
+     */
+    void invalidateShadows();
+
+    /**
+     * @brief One port's outcome in an auto-calibration probe pass
+     */
+    struct AutoCalResult {
+        bool started;    // GO written (channel selected)
+        bool done;       // GO self-cleared before the timeout
+        bool dipped;     // FEEDBACK canary cleared: chip reset mid-cal
+        uint8_t status;  // STATUS after GO cleared
+        uint8_t period;  // LRA_PERIOD the calibration locked onto
+    };
+
+    /**
+     * @brief Auto-calibrate every port in fingerMask concurrently
+     *
+     * Starts each port's calibration back to back, polls the ports
+     * round-robin until GO clears (or the timeout), then restores the LRA
+     * open-loop run config on every started port.
+     * @param fingerMask Ports to calibrate (bit f = finger f; must be enabled)
+     * @param results Per-finger outcome (zeroed for ports not in the mask)
+     * @return false if the bus was busy at kick-off (nothing started)
+     */
+    bool runAutoCalPass(uint8_t fingerMask, AutoCalResult results[MAX_ACTUATORS]);
+
+    /**
+     * @brief Print one port's probe verdict and fold it into mask / _lastProbeDipped
+     */
+    void reportAutoCal(uint8_t finger, const AutoCalResult& result, uint8_t& mask);
+
+    /**
+     * @brief First enabled finger (the VBAT voltmeter), or MAX_ACTUATORS
+     */
+    uint8_t vbatFinger() const;
+
+    /**
+     * @brief One locked select-read-close of the VBAT register
+     * @param finger Finger from vbatFinger()
+     * @param checkCanary Abort if the FEEDBACK reset canary shows a POR
+     * @param raw Output: raw VBAT register value
+     * @return false if the bus was busy, the select failed or the canary tripped
+     */
+    bool readVBatRegister(uint8_t finger, bool checkCanary, uint8_t& raw);
+
+    /**
+     * @brief Write/read-back check of one channel at the current bus speed
+     * @param finger Finger index (must be enabled); caller holds the I2C mutex
+     * @return true if every read-back matched
+     */
+    bool probeChannelReadback(uint8_t finger);
+
     /**
      * @brief Close all multiplexer channels
      */
     void closeChannels();
 
     /**
-     * @brief Configure DRV2605 for LRA mode with RTP
-     * @param drv Reference to DRV2605 driver
+     * @brief Configure DRV2605 for LRA mode with RTP (resets its shadow)
+     * @param finger Finger index; channel must be selected
      */
-    void configureDRV2605(Adafruit_DRV2605& drv);
+    void configureDRV2605(uint8_t finger);
 
     /**
      * @brief Convert amplitude percentage to DRV2605 RTP value
@@ -286,6 +499,17 @@ private:
      * @return RTP value (0-127)
      */
     uint8_t amplitudeToRTP(uint8_t amplitude) const;
+
+    /**
+     * @brief Convert LRA frequency to DRV2605 CONTROL1 drive time
+     * @param frequencyHz Frequency in Hz (MIN_FREQUENCY_HZ-MAX_FREQUENCY_HZ)
+     */
+    static uint8_t frequencyToDriveTime(uint16_t frequencyHz) {
+        if (frequencyHz >= MIN_FREQUENCY_HZ && frequencyHz <= MAX_FREQUENCY_HZ) {
+            return DRV2605_LOOKUP.driveTime[frequencyHz - MIN_FREQUENCY_HZ];
+        }
+        return (uint8_t)((5000 / frequencyHz) & 0x1F);  // Formula from DRV2605 datasheet
+    }
 };
 
 // =============================================================================
@@ -360,10 +584,33 @@ public:
      */
     void attachHaptic(HapticController* haptic) { _haptic = haptic; }
 
+    /**
+     * @brief Hand VBAT sampling to the motor task (scheduled sampling)
+     *
+     * From here on the estimator is only written by
+     * serviceScheduledSample() and readVoltage() stops touching the bus.
+     * Called by begin(), or by the motor task after a fast-boot bring-up.
+     * No-op unless VBAT_SCHEDULED_SAMPLING_ENABLED on a board without a
+     * battery ADC.
+     */
+    void startScheduledSampling();
+
+    /**
+     * @brief Take one VBAT sample if one is due (motor task, idle gap only)
+     *
+     * The caller guarantees the gap: queue empty, or the next event at
+     * least VBAT_SAMPLE_MIN_GAP_US away. Skipped while a motor is driven.
+     * @param nowUs Current getMicros()
+     * @return true if the bus was used (re-evaluate timing / pre-selection)
+     */
+    bool serviceScheduledSample(uint64_t nowUs);
+
 private:
     bool _initialized;
     HapticController* _haptic = nullptr;
     VbatEstimator _estimator;
+    volatile bool _scheduled = false;   // Estimator owned by the motor task
+    uint64_t _lastSampleUs = 0;         // Motor task only
 
     /**
      * @brief LiPo discharge curve for accurate percentage calculation
@@ -380,25 +627,6 @@ private:
     uint8_t interpolatePercentage(float voltage) const;
 };
 
-// =============================================================================
-// LED PATTERN TYPES
-// =============================================================================
-
-/**
- * @brief LED display patterns for status indication
- */
-enum class LEDPattern : uint8_t {
-    SOLID = 0,          // Constant on
-    BREATHE_SLOW,       // Slow fade in/out (2s cycle) - IDLE
-    PULSE_SLOW,         // Slow pulse (1.5s cycle) - RUNNING
-    BLINK_FAST,         // Fast blink (200ms on/off) - STOPPING
-    BLINK_SLOW,         // Slow blink (1s on/off) - ERROR, LOW_BATTERY
-    BLINK_URGENT,       // Urgent blink (150ms on/off) - CRITICAL_BATTERY
-    BLINK_CONNECT,      // Connection blink (250ms on/off) - CONNECTING, CONNECTION_LOST
-    DOUBLE_BLINK,       // Two quick blinks then pause - missing/failed motor(s)
-    OFF                 // LED off
-};
-
 // =============================================================================
 // LED CONTROLLER
 // =============================================================================
@@ -417,7 +645,10 @@ enum class LEDPattern : uint8_t {
  *   led.setPattern(Colors::GREEN, LEDPattern::PULSE_SLOW);   // Running
  *   led.setPattern(Colors::RED, LEDPattern::BLINK_SLOW);     // Error
  *
- * IMPORTANT: Call update() in the main loop for patterns to animate!
+ * Patterns are sampled from led_waveform.h, and the pixel is only written
+ * when its on-the-wire color changes. update() returns when that next
+ * happens; main.cpp runs it from a loop() soft timer armed through the
+ * schedule callback, so nothing polls the LED between changes.
  */
 class LEDController {
 public:
@@ -430,12 +661,20 @@ public:
     bool begin();
 
     /**
-     * @brief Update LED pattern animation
+     * @brief Show the pattern's current frame (if its output changed)
+     *
+     * Safe to call at any time, early or late.
      *
-     * MUST be called regularly in the main loop for animated patterns
-     * (breathe, pulse, blink) to work. Safe to call even for SOLID pattern.
+     * @return ms until the output next changes (0 = static pattern)
      */
-    void update();
+    uint32_t update();
+
+    /**
+     * @brief Install the callback told when the next update() is due
+     *
+     * Called by setPattern() with update()'s return value.
+     */
+    void setScheduleCallback(void (*callback)(uint32_t delayMs));
 
     /**
      * @brief Set LED color and pattern
@@ -490,8 +729,8 @@ private:
 
     // Pattern animation state
     uint32_t _patternStartTime;
-    bool _blinkState;           // For blink patterns: true=on, false=off
-    uint32_t _lastBlinkToggle;
+    uint8_t _brightness;        // Pixel brightness (setBrightness)
+    void (*_onSchedule)(uint32_t delayMs);
 
     /**
      * @brief Apply color to LED hardware
@@ -500,11 +739,14 @@ private:
     void applyColor(const RGBColor& color);
 
     /**
-     * @brief Calculate brightness multiplier for breathe/pulse patterns
-     * @param cycleMs Full cycle duration in milliseconds
-     * @return Brightness multiplier (0.0 - 1.0)
+     * @brief Base color scaled by a waveform level
+     */
+    RGBColor frameColor(uint8_t level) const;
+
+    /**
+     * @brief Whether two colors put the same bits on the wire
      */
-    float calculateBreatheBrightness(uint32_t cycleMs) const;
+    bool sameOnWire(const RGBColor& a, const RGBColor& b) const;
 };
 
 #endif // HARDWARE_H
@@ -1,13 +1,17 @@
 /**
  * @file hires_clock.h
  * @brief 1MHz hardware timebase (NRF_TIMER4 + HFXO) for sync-critical timestamps
- * @version 1.0.0
+ * @version 1.1.0
  *
  * Provides a true microsecond counter to replace the FreeRTOS-tick-backed
  * micros() (~976us resolution). TIMER4 runs at 1MHz in 32-bit mode and keeps
  * counting through CPU sleep. The HF crystal (+-20ppm) is held on via the
  * SoftDevice so both gloves share crystal-grade frequency accuracy.
  *
+ * A one-shot deadline alarm on the same timebase (TIMER4 CC[4] on nRF52,
+ * GPTimer on ESP32-S3) lets the motor task block until an event is due
+ * instead of busy-waiting.
+ *
  * On native test builds all functions are inert stubs and getMicros() keeps
  * using the mocked micros().
  */
@@ -50,4 +54,34 @@ void hiresClockEnsureHfclk();
  */
 [[nodiscard]] uint32_t hiresClockRead32();
 
+/**
+ * @brief Deadline alarm callback, invoked from ISR context
+ * @return true if a higher-priority task was woken (yield on ISR exit)
+ */
+typedef bool (*HiresAlarmCallback)(void);
+
+/**
+ * @brief Install the one-shot deadline alarm. Call once after hiresClockBegin().
+ * @param callback Invoked from ISR context when an armed deadline is reached
+ * @return true if the alarm is available
+ */
+[[nodiscard]] bool hiresClockAlarmBegin(HiresAlarmCallback callback);
+
+/**
+ * @brief Arm (or re-arm) the alarm for an absolute getMicros() deadline
+ *
+ * Replaces any previously armed deadline. The deadline must be less than
+ * ~35 minutes (2^31 us) ahead.
+ *
+ * @param deadlineUs Absolute deadline (getMicros() timebase)
+ * @return false if the alarm is unavailable or the deadline is too close to
+ *         arm reliably - the caller must wait for it by other means
+ */
+[[nodiscard]] bool hiresClockAlarmArm(uint64_t deadlineUs);
+
+/**
+ * @brief Disarm the alarm (no-op if not armed)
+ */
+void hiresClockAlarmCancel();
+
 #endif // HIRES_CLOCK_H
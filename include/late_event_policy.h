@@ -0,0 +1,96 @@
+/**
+ * @file late_event_policy.h
+ * @brief What the motor task does with an event it reaches too late
+ *
+ * The motor task used to execute any past-due event at once. After a stall
+ * (a long I2C retry, a BLE burst) that fires every overdue activation
+ * back-to-back, and the SECONDARY visibly drifts from the PRIMARY. Past
+ * LATE_EVENT_THRESHOLD_US the policy instead picks:
+ *   - EXECUTE: fire anyway (LATE_EVENT_EXECUTE, the previous behaviour);
+ *   - DROP: skip the activation and its paired deactivation, so the next
+ *     on-time activation plays in sync;
+ *   - SHIFT: delay the whole pending schedule by the lateness, so the
+ *     pattern plays intact. This gives up bilateral alignment: the shift
+ *     is local, so every macrocycle already queued plays that much behind
+ *     the other glove, and only macrocycles queued afterwards (timed by
+ *     the PRIMARY) line up again. Meant for single-glove use.
+ * Deactivations are never dropped or shifted on their own: a motor that
+ * was turned on is always turned off.
+ *
+ * LATE_EVENT_RESYNC_RUN consecutive late activations mean a whole
+ * macrocycle was compromised; takeResyncRequest() then reports it once so
+ * loop() can ask the PRIMARY to resync. Runs build up under EXECUTE and
+ * DROP; a SHIFT puts the local schedule back on time at once, so it never
+ * asks for the resync that would realign the gloves.
+ *
+ * decide() runs in the motor task only; takeResyncRequest() in loop().
+ * Pure C++ (no Arduino dependencies) so it builds in native test envs.
+ */
+
+#ifndef LATE_EVENT_POLICY_H
+#define LATE_EVENT_POLICY_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @brief Motor task action for one event
+ */
+enum class LateEventAction : uint8_t {
+    EXECUTE = LATE_EVENT_EXECUTE,
+    DROP = LATE_EVENT_DROP,
+    SHIFT = LATE_EVENT_SHIFT
+};
+
+/**
+ * @class LateEventPolicy
+ * @brief Classifies past-due motor events and spots compromised macrocycles
+ */
+class LateEventPolicy {
+public:
+    /**
+     * @param action Action for activations past the threshold
+     * @param thresholdUs Lateness tolerated before the action applies
+     * @param resyncRun Consecutive late activations that request a resync (0 = never)
+     */
+    explicit LateEventPolicy(LateEventAction action = static_cast<LateEventAction>(LATE_EVENT_POLICY),
+                             uint32_t thresholdUs = LATE_EVENT_THRESHOLD_US,
+                             uint8_t resyncRun = LATE_EVENT_RESYNC_RUN);
+
+    /**
+     * @brief Action for an event reached latenessUs after its time
+     * @param latenessUs Now minus event time (0 if on time)
+     * @param activation true for ACTIVATE, false for DEACTIVATE
+     * @return EXECUTE within the threshold and for every deactivation
+     */
+    LateEventAction decide(uint32_t latenessUs, bool activation);
+
+    /** @brief Whether latenessUs is past the threshold */
+    bool isLate(uint32_t latenessUs) const { return latenessUs > _thresholdUs; }
+
+    /**
+     * @brief A run of LATE_EVENT_RESYNC_RUN late activations ended since the last call
+     */
+    bool takeResyncRequest();
+
+    /** @brief A resync request is waiting for takeResyncRequest() */
+    bool resyncPending() const { return _resyncPending; }
+
+    /** @brief Forget the current run (session start) */
+    void reset();
+
+    LateEventAction action() const { return _action; }
+    uint32_t thresholdUs() const { return _thresholdUs; }
+
+    /** @brief Consecutive late activations so far */
+    uint8_t lateRun() const { return _lateRun; }
+
+private:
+    LateEventAction _action;
+    uint32_t _thresholdUs;
+    uint8_t _resyncRun;
+    uint8_t _lateRun;
+    volatile bool _resyncPending;
+};
+
+#endif // LATE_EVENT_POLICY_H
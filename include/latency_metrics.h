@@ -1,10 +1,12 @@
 /**
  * @file latency_metrics.h
  * @brief Latency measurement and reporting for sync analysis
- * @version 1.0.0
+ * @version 1.1.0
  *
  * Provides runtime-toggleable latency metrics collection for measuring
  * execution drift and BLE timing across PRIMARY/SECONDARY gloves.
+ * Fixed-memory log-linear histograms back the p50/p90/p99/p99.9 figures in
+ * printReport(); min/max alone hide the tail that bilateral sync cares about.
  */
 
 #ifndef LATENCY_METRICS_H
@@ -12,12 +14,90 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "config.h"  // MAX_ACTUATORS, LATENCY_HIST_*
 
 // Forward declaration for config constants
 #ifndef LATENCY_LATE_THRESHOLD_US
 #define LATENCY_LATE_THRESHOLD_US 1000  // >1ms considered "late"
 #endif
 
+// =============================================================================
+// LOG-LINEAR HISTOGRAM
+// =============================================================================
+
+/**
+ * @brief Fixed-memory signed histogram with log-linear buckets
+ *
+ * Magnitudes below 2^SUB_BITS get one bucket each; every octave above is
+ * split into 2^SUB_BITS equal buckets, so resolution is relative (12.5% at
+ * SUB_BITS = 3). Negative and positive values use mirrored bucket sets laid
+ * out in ascending value order. When a counter would overflow, every count
+ * is halved: the distribution shape (and so every percentile) is kept.
+ */
+struct LatencyHistogram {
+    static constexpr uint8_t SUB_BITS = LATENCY_HIST_SUB_BITS;
+    static constexpr uint8_t MAX_BITS = LATENCY_HIST_MAX_BITS;
+    static constexpr uint16_t SUB_COUNT = 1u << SUB_BITS;
+    static constexpr uint16_t SIDE_BUCKETS = SUB_COUNT * (MAX_BITS - SUB_BITS + 1);
+    static constexpr uint16_t BUCKETS = 2 * SIDE_BUCKETS;
+
+    static_assert(SUB_BITS >= 1 && MAX_BITS > SUB_BITS && MAX_BITS <= 30,
+                  "LATENCY_HIST_SUB_BITS/MAX_BITS out of range");
+
+    uint16_t counts[BUCKETS];  ///< Per-bucket sample counts
+    uint32_t total;            ///< Sum of counts (after any halving)
+
+    /**
+     * @brief Clear all buckets
+     */
+    void reset();
+
+    /**
+     * @brief Add one sample
+     * @param value Sample in microseconds
+     */
+    void record(int32_t value);
+
+    /**
+     * @brief Value at or below which the given fraction of samples fall
+     * @param permille Quantile in 0.1% units (500 = p50, 999 = p99.9)
+     * @return Upper edge of the bucket holding that rank, or 0 if empty
+     */
+    int32_t percentile(uint16_t permille) const;
+
+    /**
+     * @brief percentile() of several histograms taken together
+     * @param first First histogram
+     * @param count Number of histograms
+     * @param stride Distance between consecutive histograms (array elements)
+     * @param permille Quantile in 0.1% units
+     *
+     * Walks the buckets in place, so no merged copy (or its stack) is needed.
+     */
+    static int32_t percentileOf(const LatencyHistogram* first, uint8_t count,
+                                uint8_t stride, uint16_t permille);
+
+    /**
+     * @brief Total samples across several histograms (same layout as percentileOf)
+     */
+    static uint32_t totalOf(const LatencyHistogram* first, uint8_t count, uint8_t stride);
+
+    /**
+     * @brief Bucket index (0 to SIDE_BUCKETS-1) for a magnitude
+     */
+    static uint16_t magnitudeBucket(uint32_t magnitude);
+
+    /**
+     * @brief Smallest magnitude mapped to a bucket
+     */
+    static uint32_t bucketLowerBound(uint16_t bucket);
+
+    /**
+     * @brief Largest magnitude mapped to a bucket
+     */
+    static uint32_t bucketUpperBound(uint16_t bucket);
+};
+
 /**
  * @brief Latency metrics collection and reporting
  *
@@ -66,6 +146,40 @@ struct LatencyMetrics {
     uint32_t syncRttSpread_us;  ///< max - min (lower = more stable BLE)
     int64_t calculatedOffset_us;///< Final calculated clock offset
 
+    // ==========================================================================
+    // DISTRIBUTIONS (percentile reporting)
+    // ==========================================================================
+
+    /// Execution drift by [finger][EVENT_ACTIVATE/EVENT_DEACTIVATE][PATH_SLOW/PATH_FAST]
+    LatencyHistogram driftHist[MAX_ACTUATORS][2][2];
+    LatencyHistogram rttHist;          ///< Ongoing RTT
+    LatencyHistogram offsetErrorHist;  ///< Measured offset - filtered offset
+
+    // ==========================================================================
+    // BILATERAL SKEW (SECONDARY with SYNC_SKEW_CAPTURE_ENABLED)
+    // ==========================================================================
+
+    LatencyHistogram skewHist;     ///< SECONDARY - PRIMARY activation edge (signed)
+    LatencyHistogram absSkewHist;  ///< |skew| (acceptance gates are on magnitude)
+    int64_t totalAbsSkew_us;       ///< Sum of |skew| (for average calculation)
+    uint32_t maxAbsSkew_us;        ///< Largest |skew|
+    uint32_t skewSampleCount;      ///< Number of paired edges
+
+    // ==========================================================================
+    // LATE EVENTS (motor task, per session; counted even when disabled)
+    // ==========================================================================
+
+    uint32_t lateEventCount;      ///< Events reached past LATE_EVENT_THRESHOLD_US
+    uint32_t droppedEventCount;   ///< Late activations dropped with their deactivation
+    uint32_t shiftedEventCount;   ///< Late activations that shifted the schedule
+    uint32_t maxLateness_us;      ///< Worst lateness past the threshold
+    uint32_t resyncRequestCount;  ///< Compromised macrocycles (resync requested)
+
+    static constexpr uint8_t EVENT_ACTIVATE = 0;
+    static constexpr uint8_t EVENT_DEACTIVATE = 1;
+    static constexpr uint8_t PATH_SLOW = 0;  ///< Full mux select + writes
+    static constexpr uint8_t PATH_FAST = 1;  ///< Pre-selected channel, RTP write only
+
     // ==========================================================================
     // METHODS
     // ==========================================================================
@@ -92,6 +206,18 @@ struct LatencyMetrics {
      */
     void recordExecution(int32_t drift_us);
 
+    /**
+     * @brief Record an execution drift measurement with its classification
+     * @param drift_us Drift in microseconds (actual - scheduled)
+     * @param finger Finger index (0 to MAX_ACTUATORS-1)
+     * @param activate true for ACTIVATE, false for DEACTIVATE
+     * @param fastPath true if the pre-selected channel was used
+     *
+     * Updates the aggregates like recordExecution(int32_t) and also bins the
+     * sample into its per-motor / per-type / per-path histogram.
+     */
+    void recordExecution(int32_t drift_us, uint8_t finger, bool activate, bool fastPath);
+
     /**
      * @brief Record an RTT measurement (ongoing, during therapy)
      * @param rtt_us Round-trip time in microseconds
@@ -104,6 +230,31 @@ struct LatencyMetrics {
      */
     void recordSyncProbe(uint32_t rtt_us);
 
+    /**
+     * @brief Record a clock offset error (ongoing, during therapy)
+     * @param error_us Measured offset minus the filtered offset in use
+     */
+    void recordOffsetError(int32_t error_us);
+
+    /**
+     * @brief Record a captured bilateral skew (motor task)
+     * @param skew_us SECONDARY activation edge minus PRIMARY's, SECONDARY clock
+     */
+    void recordSkew(int32_t skew_us);
+
+    /**
+     * @brief Record an event the motor task reached past LATE_EVENT_THRESHOLD_US
+     * @param lateness_us Now minus event time
+     * @param dropped The activation was dropped (LATE_EVENT_DROP)
+     * @param shifted The pending schedule was shifted (LATE_EVENT_SHIFT)
+     */
+    void recordLateEvent(uint32_t lateness_us, bool dropped, bool shifted);
+
+    /**
+     * @brief Clear the late-event counters (session start)
+     */
+    void resetLateEvents();
+
     /**
      * @brief Finalize sync probing and record calculated offset
      * @param offset_us Calculated clock offset in microseconds
@@ -128,6 +279,13 @@ struct LatencyMetrics {
      */
     uint32_t getJitter() const;
 
+    /**
+     * @brief Execution drift percentile across all motors, types and paths
+     * @param permille Quantile in 0.1% units (500 = p50, 999 = p99.9)
+     * @return Drift in microseconds (bucket upper edge), or 0 if no samples
+     */
+    int32_t getDriftPercentile(uint16_t permille) const;
+
     /**
      * @brief Get sync confidence level as string
      * @return "HIGH", "MEDIUM", or "LOW" based on RTT spread
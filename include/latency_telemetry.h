@@ -0,0 +1,229 @@
+/**
+ * @file latency_telemetry.h
+ * @brief Batched binary latency telemetry stream to the phone
+ * @version 1.0.0
+ *
+ * Ships raw drift / RTT / offset-error / skew samples to the phone so the app can
+ * plot timing over a whole session instead of reading the 30 s serial
+ * summary (LatencyMetrics). Samples are staged into lock-free SPSC rings by
+ * their producers and drained by the main loop, which packs them into a
+ * compact binary frame and hands it to the BLE TX queue only when the queue
+ * is mostly idle (LATENCY_STREAM_MAX_TX_BACKLOG).
+ *
+ * The phone link is EOT-framed text, so the binary frame travels base64
+ * encoded behind a "LATS:" prefix. Frame layout (little-endian):
+ *
+ *   offset  size  field
+ *   0       1     version (FRAME_VERSION)
+ *   1       2     sequence number (wraps)
+ *   3       4     base time, millis() of the first sample
+ *   7       2     samples dropped since the previous frame (saturating)
+ *   9       1     sample count N
+ *   10      7*N   samples: tag, dt_ms (uint16, from base), value (int32)
+ *
+ * Tag byte: kind in bits 7:6 (LatencyTelemetryKind), activate in bit 5,
+ * fast path in bit 4, finger in bits 3:0 (drift samples only).
+ *
+ * Enabled at runtime with the LATENCY_STREAM menu command.
+ */
+
+#ifndef LATENCY_TELEMETRY_H
+#define LATENCY_TELEMETRY_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// =============================================================================
+// SAMPLE
+// =============================================================================
+
+/**
+ * @brief Sample kind (tag bits 7:6)
+ */
+enum class LatencyTelemetryKind : uint8_t {
+    DRIFT = 0,         // Motor execution drift (us, +late/-early)
+    RTT = 1,           // PING/PONG round-trip time (us)
+    OFFSET_ERROR = 2,  // Raw offset sample minus the estimate in use (us)
+    SKEW = 3           // Captured bilateral skew, SECONDARY - PRIMARY (us, skew_capture.h)
+};
+
+/**
+ * @brief One staged telemetry sample
+ */
+struct LatencyTelemetrySample {
+    uint32_t timeMs;   // millis() when recorded
+    int32_t value;     // Sample value in microseconds
+    uint8_t tag;       // Packed kind / flags / finger (see file header)
+};
+
+// =============================================================================
+// SAMPLE RING (Lock-Free SPSC)
+// =============================================================================
+
+/**
+ * @brief Lock-free ring of telemetry samples
+ *
+ * Same SPSC model as MotorEventBuffer. A full ring drops the new sample and
+ * counts it; the drop counter is written by the producer only, the consumer
+ * reports deltas against its own snapshot.
+ */
+class LatencyTelemetryRing {
+public:
+    static constexpr uint8_t SIZE = LATENCY_STREAM_RING_SIZE;  // Power of two
+
+    LatencyTelemetryRing();
+
+    /**
+     * @brief Stage a sample (producer only)
+     * @return false if the ring was full (sample dropped and counted)
+     */
+    bool push(const LatencyTelemetrySample& sample);
+
+    /**
+     * @brief Read the oldest sample without removing it (consumer only)
+     */
+    bool peek(LatencyTelemetrySample& sample) const;
+
+    /**
+     * @brief Remove the oldest sample (consumer only)
+     */
+    void pop();
+
+    /**
+     * @brief Number of staged samples (approximate under concurrency)
+     */
+    uint8_t count() const;
+
+    /**
+     * @brief Total samples dropped since construction (wraps)
+     */
+    uint16_t dropped() const { return _dropped; }
+
+    /**
+     * @brief Discard staged samples (consumer only)
+     */
+    void clear();
+
+private:
+    static_assert((SIZE & (SIZE - 1)) == 0, "LATENCY_STREAM_RING_SIZE must be a power of two");
+
+    LatencyTelemetrySample _buffer[SIZE];
+    volatile uint8_t _head;      // Next write position (producer)
+    volatile uint8_t _tail;      // Next read position (consumer)
+    volatile uint16_t _dropped;  // Producer-owned drop counter
+};
+
+// =============================================================================
+// LATENCY TELEMETRY
+// =============================================================================
+
+/**
+ * @class LatencyTelemetry
+ * @brief Stages latency samples and packs them into phone frames
+ *
+ * Producers:
+ * - recordExecution(): motor task (or the haptic I2C worker when
+ *   HAPTIC_ASYNC_I2C_ENABLED - the two never run the same events)
+ * - recordRtt() / recordOffsetError(): BLE receive context
+ * - recordSkew(): motor task (SYNC_SKEW_CAPTURE_ENABLED only)
+ *
+ * Consumer: main loop via encodeFrame().
+ */
+class LatencyTelemetry {
+public:
+    static constexpr uint8_t FRAME_VERSION = 1;
+    static constexpr uint8_t FRAME_HEADER_SIZE = 10;
+    static constexpr uint8_t SAMPLE_WIRE_SIZE = 7;
+    static constexpr uint8_t FRAME_MAX_SAMPLES = LATENCY_STREAM_MAX_SAMPLES;
+    static constexpr size_t FRAME_MAX_BINARY = FRAME_HEADER_SIZE + FRAME_MAX_SAMPLES * SAMPLE_WIRE_SIZE;
+
+    // "LATS:" + base64(binary) + NUL
+    static constexpr size_t FRAME_TEXT_SIZE = 5 + ((FRAME_MAX_BINARY + 2) / 3) * 4 + 1;
+
+    static constexpr uint8_t TAG_ACTIVATE = 0x20;
+    static constexpr uint8_t TAG_FAST_PATH = 0x10;
+    static constexpr uint8_t TAG_FINGER_MASK = 0x0F;
+
+    LatencyTelemetry();
+
+    /**
+     * @brief Start or stop streaming
+     *
+     * Starting discards anything staged while stopped.
+     */
+    void setStreaming(bool enabled);
+
+    bool isStreaming() const { return _streaming; }
+
+    /**
+     * @brief Record a motor execution drift sample (motor task)
+     */
+    void recordExecution(int32_t drift_us, uint8_t finger, bool activate, bool fastPath);
+
+    /**
+     * @brief Record a PING/PONG RTT sample (BLE context)
+     */
+    void recordRtt(uint32_t rtt_us);
+
+    /**
+     * @brief Record an offset-error sample (BLE context)
+     */
+    void recordOffsetError(int32_t error_us);
+
+    /**
+     * @brief Record a captured bilateral skew sample (motor task)
+     */
+    void recordSkew(int32_t skew_us);
+
+    /**
+     * @brief Number of staged samples across all rings
+     */
+    uint16_t pendingCount() const;
+
+    /**
+     * @brief Drain up to FRAME_MAX_SAMPLES samples into a text frame (main loop)
+     *
+     * Samples from all rings are merged oldest-first.
+     *
+     * @param out Output buffer, at least FRAME_TEXT_SIZE bytes for a full frame
+     * @param outSize Size of out
+     * @return Length of the NUL-terminated frame, or 0 if nothing was pending
+     *         or out is too small
+     */
+    size_t encodeFrame(char* out, size_t outSize);
+
+    /**
+     * @brief Base64-encode (RFC 4648, padded)
+     * @return Encoded length, or 0 if out (incl. NUL) is too small
+     */
+    static size_t base64Encode(const uint8_t* data, size_t length, char* out, size_t outSize);
+
+private:
+    // One ring per producer context (SPSC each)
+    enum Ring : uint8_t {
+        RING_EXEC,   // Motor task (or haptic I2C worker)
+        RING_SYNC,   // BLE context
+#if SYNC_SKEW_CAPTURE_ENABLED
+        RING_SKEW,   // Motor task skew pairing (never the I2C worker)
+#endif
+        RING_COUNT
+    };
+
+    LatencyTelemetryRing _rings[RING_COUNT];
+    volatile bool _streaming;
+    uint16_t _frameSeq;
+    uint16_t _reportedDrops;         // Consumer snapshot of the summed drop counters
+
+    void push(Ring ring, LatencyTelemetryKind kind, uint8_t flags, int32_t value);
+    uint16_t totalDropped() const;
+};
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+extern LatencyTelemetry latencyTelemetry;
+
+#endif // LATENCY_TELEMETRY_H
@@ -0,0 +1,140 @@
+/**
+ * @file lead_time_controller.h
+ * @brief Closed-loop MACROCYCLE lead time from SECONDARY slack feedback (PRIMARY)
+ *
+ * The open-loop lead (connection-event bound, else RTT + 3 sigma) is a model
+ * of the delivery path; it cannot see SECONDARY-side processing and must pad
+ * for everything it does not measure. With feedback the SECONDARY reports,
+ * in each MC_ACK, how much slack it had left: baseTime minus the moment the
+ * macrocycle was fully staged, on its own clock. The PRIMARY knows the lead
+ * it sent with (baseTime minus send time, on its clock), so
+ *
+ *     delay = lead - slack
+ *
+ * is the true send-to-staged time of that macrocycle, with the clock offset
+ * cancelling out. Over a window of SYNC_SLACK_WINDOW delays the lead becomes
+ *
+ *     SYNC_SLACK_PERCENTILE delay + SYNC_SLACK_TARGET_US
+ *
+ * bounded by [SYNC_SLACK_MIN_LEAD_US, SYNC_MAX_LEAD_TIME_US]. A slow (or
+ * late) delivery enters the window, and so raises the lead, on the very next
+ * macrocycle; the lead only shrinks once it ages out of the window.
+ *
+ * Until SYNC_SLACK_MIN_SAMPLES delays are in, after SYNC_SLACK_STALE_MS
+ * without one (SECONDARY firmware without slack), and after reset(), the
+ * open-loop lead is used unchanged.
+ *
+ * onAck() and requestReset() are safe from the BLE task; everything else
+ * runs in the loop task. Pure C++ (no Arduino dependencies) so it builds in
+ * native test envs.
+ */
+
+#ifndef LEAD_TIME_CONTROLLER_H
+#define LEAD_TIME_CONTROLLER_H
+
+#include <stdint.h>
+#include <atomic>
+#include "config.h"
+
+/**
+ * @class LeadTimeController
+ * @brief Sizes the MACROCYCLE lead from measured delivery delays
+ */
+class LeadTimeController {
+public:
+    LeadTimeController();
+
+    /**
+     * @brief Forget all samples (SECONDARY link up, PHY change)
+     *
+     * Safe from BLE callbacks; update() applies it.
+     */
+    void requestReset() { _resetPending = true; }
+
+    /**
+     * @brief A MACROCYCLE went out (loop task)
+     * @param sequenceId Macrocycle sequence ID
+     * @param leadUs baseTime minus send time, PRIMARY clock
+     */
+    void onSent(uint32_t sequenceId, uint32_t leadUs);
+
+    /**
+     * @brief Its MC_ACK reported slack (BLE task)
+     *
+     * Queued lock-free; update() matches it to the sent lead. Dropped if
+     * SYNC_SLACK_PENDING ACKs are already waiting.
+     */
+    void onAck(uint32_t sequenceId, int32_t slackUs);
+
+    /**
+     * @brief Fold queued ACKs into the delay window (loop task)
+     * @param nowMs millis()
+     */
+    void update(uint32_t nowMs);
+
+    /**
+     * @brief Lead time for the next MACROCYCLE
+     * @param openLoopUs Lead the open-loop model would use
+     * @param nowMs millis()
+     * @return Closed-loop lead while active(), else openLoopUs
+     */
+    uint32_t leadTimeUs(uint32_t openLoopUs, uint32_t nowMs) const;
+
+    /** @brief Enough recent delays to close the loop */
+    bool active(uint32_t nowMs) const;
+
+    /** @brief Delay percentile + target, clamped (valid once a delay is in) */
+    uint32_t closedLoopLeadUs() const { return _closedLoopLeadUs; }
+
+    /** @brief SYNC_SLACK_PERCENTILE send-to-staged delay over the window */
+    uint32_t delayPercentileUs() const { return _delayPercentileUs; }
+
+    /** @brief Delays in the window */
+    uint8_t sampleCount() const { return _count; }
+
+    /** @brief Slack of the latest ACK */
+    int32_t lastSlackUs() const { return _lastSlackUs; }
+
+    /** @brief ACKs whose slack was negative (macrocycle staged late) */
+    uint32_t lateCount() const { return _lateCount; }
+
+    /** @brief ACKs with no matching sent lead, or dropped when queued */
+    uint32_t unmatchedCount() const { return _unmatchedCount; }
+
+private:
+    struct SentLead {
+        uint32_t sequenceId;
+        uint32_t leadUs;
+        bool valid;
+    };
+
+    struct AckSlack {
+        uint32_t sequenceId;
+        int32_t slackUs;
+    };
+
+    void reset();
+    void addDelay(uint32_t delayUs, uint32_t nowMs);
+
+    volatile bool _resetPending;
+
+    // BLE task -> loop task (single producer, single consumer)
+    AckSlack _acks[SYNC_SLACK_PENDING];
+    std::atomic<uint8_t> _ackHead;   // Written by onAck()
+    std::atomic<uint8_t> _ackTail;   // Written by update()
+    std::atomic<uint32_t> _droppedAcks;
+
+    SentLead _sent[SYNC_SLACK_PENDING];  // Indexed by sequenceId % SYNC_SLACK_PENDING
+
+    uint32_t _delays[SYNC_SLACK_WINDOW];
+    uint8_t _next;
+    uint8_t _count;
+    uint32_t _lastSampleMs;
+    uint32_t _delayPercentileUs;
+    uint32_t _closedLoopLeadUs;
+    int32_t _lastSlackUs;
+    uint32_t _lateCount;
+    uint32_t _unmatchedCount;
+};
+
+#endif // LEAD_TIME_CONTROLLER_H
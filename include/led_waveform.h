@@ -0,0 +1,72 @@
+/**
+ * @file led_waveform.h
+ * @brief LED pattern waveforms as brightness levels with change deadlines
+ *
+ * Every LEDPattern is a periodic function of the time since setPattern():
+ * blinks are on/off phases, BREATHE/PULSE step through one cycle of a
+ * precomputed raised-cosine table (LED_WAVEFORM_STEPS entries, 10%-100%).
+ * sample() returns the level at a time and how long it holds, so the LED
+ * is only touched when its output changes and loop() can sleep until then
+ * (main.cpp arms a soft timer for the returned delay).
+ *
+ * Pure C++ (no Arduino dependencies) so it builds in native test envs.
+ */
+
+#ifndef LED_WAVEFORM_H
+#define LED_WAVEFORM_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @brief LED animation patterns
+ */
+enum class LEDPattern : uint8_t {
+    SOLID = 0,          // Constant on
+    BREATHE_SLOW,       // Slow fade in/out (2s cycle) - IDLE
+    PULSE_SLOW,         // Slow pulse (1.5s cycle) - RUNNING
+    BLINK_FAST,         // Fast blink (200ms on/off) - STOPPING
+    BLINK_SLOW,         // Slow blink (1s on/off) - ERROR, LOW_BATTERY
+    BLINK_URGENT,       // Urgent blink (150ms on/off) - CRITICAL_BATTERY
+    BLINK_CONNECT,      // Connection blink (250ms on/off) - CONNECTING, CONNECTION_LOST
+    DOUBLE_BLINK,       // Two quick blinks then pause - missing/failed motor(s)
+    OFF                 // LED off
+};
+
+/** Entries in the BREATHE/PULSE brightness table (one full cycle). */
+constexpr uint8_t LED_WAVEFORM_STEPS = 64;
+
+/** Full brightness level (base color unchanged). */
+constexpr uint8_t LED_LEVEL_FULL = 255;
+
+/**
+ * @brief Level of a pattern at a point in its cycle
+ * @param pattern Pattern being shown
+ * @param elapsedMs Time since the pattern started
+ * @param level Output: brightness applied to the base color (0-255)
+ * @return ms until the level next changes (0 = never: SOLID, OFF)
+ */
+uint32_t ledWaveformSample(LEDPattern pattern, uint32_t elapsedMs, uint8_t& level);
+
+/**
+ * @brief Scale one color channel by a level (rounded)
+ */
+inline uint8_t ledWaveformScale(uint8_t channel, uint8_t level) {
+    return static_cast<uint8_t>((static_cast<uint16_t>(channel) * level + 127) / 255);
+}
+
+/**
+ * @brief Channel value the NeoPixel puts on the wire after setBrightness()
+ *
+ * Matches Adafruit_NeoPixel's scaling ((c * (brightness + 1)) >> 8, none at
+ * 255). At LED_BRIGHTNESS a channel has only a handful of distinct outputs,
+ * so most breathe steps change nothing on the wire.
+ */
+inline uint8_t ledWireLevel(uint8_t channel, uint8_t brightness) {
+    if (brightness == 255) {
+        return channel;
+    }
+    return static_cast<uint8_t>((static_cast<uint16_t>(channel) * (brightness + 1)) >> 8);
+}
+
+#endif // LED_WAVEFORM_H
@@ -0,0 +1,128 @@
+/**
+ * @file loop_wake.h
+ * @brief Wake set for the event-driven main loop
+ *
+ * loop() blocks on its FreeRTOS task notification instead of spinning.
+ * Every producer of loop-side work ORs its bit into the notification value
+ * (BLE RX/link/PHY callbacks, deferred-queue enqueue, the safety semaphore,
+ * the power switch), and the wait times out at the nearest software-timer
+ * deadline gathered with LoopDeadline.
+ *
+ * The bits only end the wait; each handler still checks its own flag or
+ * queue, so a bit that arrives while loop() is running is never lost (it
+ * makes the next wait return at once).
+ */
+
+#ifndef LOOP_WAKE_H
+#define LOOP_WAKE_H
+
+#include <stdint.h>
+
+// =============================================================================
+// WAKE EVENTS
+// =============================================================================
+
+enum LoopWakeEvent : uint32_t {
+    LOOP_WAKE_BLE_RX   = 1u << 0,  // Message delivered (onBLEMessage)
+    LOOP_WAKE_BLE_LINK = 1u << 1,  // Connect / disconnect
+    LOOP_WAKE_BLE_PHY  = 1u << 2,  // PHY update (g_phyChangeDetected)
+    LOOP_WAKE_BLE_TX   = 1u << 3,  // TX queue gained room (nRF52 drains from update())
+    LOOP_WAKE_DEFERRED = 1u << 4,  // DeferredQueue::enqueue()
+    LOOP_WAKE_SAFETY   = 1u << 5,  // safetyShutdownSema given
+    LOOP_WAKE_POWER    = 1u << 6,  // Power switch edge (PentaBuzzer)
+    LOOP_WAKE_MOTORS   = 1u << 7,  // Deferred motor bring-up finished (FAST_BOOT_ENABLED)
+    LOOP_WAKE_HEALTH   = 1u << 8,  // Health monitor dropped/restored a motor
+    LOOP_WAKE_LATE     = 1u << 9,  // Late-event policy asks for a resync
+};
+
+/**
+ * @class LoopWake
+ * @brief The loop task's notification value used as an event set
+ */
+class LoopWake {
+public:
+    /** @brief Record the calling task as the loop task (call from setup()) */
+    void begin();
+
+    /** @brief Set event bits (any task; no-op before begin()) */
+    void notify(uint32_t events);
+
+    /** @brief Set event bits from an interrupt */
+    void notifyFromIsr(uint32_t events);
+
+    /**
+     * @brief Block until an event is set or timeoutMs elapses
+     * @return Events that ended the wait (cleared), 0 on timeout
+     */
+    uint32_t wait(uint32_t timeoutMs);
+
+    /** @brief Waits ended by an event / by the timeout (status print) */
+    uint32_t eventWakes() const { return _eventWakes; }
+    uint32_t timeoutWakes() const { return _timeoutWakes; }
+
+private:
+    void* _task = nullptr;  // TaskHandle_t of loop()
+    uint32_t _eventWakes = 0;
+    uint32_t _timeoutWakes = 0;
+};
+
+extern LoopWake loopWake;
+
+/**
+ * @brief Notify on scope exit
+ *
+ * For callbacks that publish state on several paths: the wake fires after
+ * the last write, so loop() on the other core can't run ahead of it.
+ */
+class LoopWakeScope {
+public:
+    explicit LoopWakeScope(uint32_t events) : _events(events) {}
+    ~LoopWakeScope() { loopWake.notify(_events); }
+
+    LoopWakeScope(const LoopWakeScope&) = delete;
+    LoopWakeScope& operator=(const LoopWakeScope&) = delete;
+
+private:
+    uint32_t _events;
+};
+
+// =============================================================================
+// NEAREST DEADLINE
+// =============================================================================
+
+/**
+ * @class LoopDeadline
+ * @brief The shortest wait that still meets every software timer
+ *
+ * Built fresh each pass from millis() and a cap (the coarsest timer the
+ * loop cannot see, e.g. an LED animation frame). All times wrap like
+ * millis(). Pure C++ so it builds in native test envs.
+ */
+class LoopDeadline {
+public:
+    LoopDeadline(uint32_t nowMs, uint32_t capMs) : _nowMs(nowMs), _timeoutMs(capMs) {}
+
+    /** @brief Work is ready now: don't block */
+    void now() { _timeoutMs = 0; }
+
+    /** @brief Wake no later than dueMs (already due = don't block) */
+    void at(uint32_t dueMs) {
+        int32_t remaining = static_cast<int32_t>(dueMs - _nowMs);
+        if (remaining <= 0) {
+            _timeoutMs = 0;
+        } else if (static_cast<uint32_t>(remaining) < _timeoutMs) {
+            _timeoutMs = static_cast<uint32_t>(remaining);
+        }
+    }
+
+    /** @brief Periodic timer that last fired at lastMs */
+    void every(uint32_t lastMs, uint32_t intervalMs) { at(lastMs + intervalMs); }
+
+    uint32_t timeoutMs() const { return _timeoutMs; }
+
+private:
+    uint32_t _nowMs;
+    uint32_t _timeoutMs;
+};
+
+#endif // LOOP_WAKE_H
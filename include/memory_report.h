@@ -0,0 +1,116 @@
+/**
+ * @file memory_report.h
+ * @brief RAM accounting for fixed buffers, task stacks and the heap
+ *
+ * setup() registers every subsystem's static footprint (sizeof of the
+ * global instance, so the numbers follow the sizing knobs in config.h),
+ * the per-instance size of large stack temporaries, and the FreeRTOS tasks
+ * whose stacks are worth watching. The serial MEMORY command prints the
+ * table together with each task's stack high-water mark and the heap
+ * minimum.
+ *
+ * Tasks owned by the core or the BLE stack can be registered by name with a
+ * null handle; the handle is looked up at report time (platformTaskByName)
+ * and the row reads "not found" on ports without xTaskGetHandle. The heap
+ * minimum is the lower of the port's own low-water mark (ESP-IDF) and the
+ * free heap sampled by sampleHeap() from loop() (the only source on the
+ * nRF52 core).
+ *
+ * Threading: loop() only (registration in setup()).
+ */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+/**
+ * @brief One row of the footprint table
+ */
+struct MemoryRegion {
+    const char* name;
+    uint32_t bytes;
+    bool stackTemporary;    // Per live instance on some stack, not in the static total
+};
+
+/**
+ * @brief One watched task
+ */
+struct MemoryTask {
+    const char* name;       // Row label and, with a null handle, the FreeRTOS task name
+    void* handle;           // TaskHandle_t, or nullptr to look up by name
+    uint32_t stackBytes;    // Configured stack size, 0 if the creator does not expose it
+};
+
+/**
+ * @class MemoryReport
+ * @brief Registry behind the MEMORY command
+ */
+class MemoryReport {
+public:
+    static constexpr uint8_t MAX_REGIONS = MEMORY_REPORT_MAX_REGIONS;
+    static constexpr uint8_t MAX_TASKS = MEMORY_REPORT_MAX_TASKS;
+
+    MemoryReport();
+
+    /**
+     * @brief Register a statically allocated subsystem
+     * @return false if the table is full
+     */
+    bool addRegion(const char* name, size_t bytes);
+
+    /**
+     * @brief Register a large type that lives on task stacks
+     * @return false if the table is full
+     */
+    bool addTemporary(const char* name, size_t bytes);
+
+    /**
+     * @brief Register a task whose stack high-water mark is reported
+     * @param name Row label (FreeRTOS task name when handle is null)
+     * @param handle TaskHandle_t, or nullptr to resolve by name at report time
+     * @param stackBytes Configured stack size in bytes (0 = unknown)
+     * @return false if the table is full
+     */
+    bool addTask(const char* name, void* handle, uint32_t stackBytes);
+
+    /** @brief Fold the current free heap into the minimum (loop(), periodic) */
+    void sampleHeap();
+
+    /**
+     * @brief Fold one heap observation into the minimum
+     * @param freeBytes Free heap now
+     * @param minEverFreeBytes Port low-water mark (UINT32_MAX if none)
+     */
+    void recordHeap(uint32_t freeBytes, uint32_t minEverFreeBytes);
+
+    /** @brief Sum of the static regions */
+    uint32_t staticBytes() const;
+
+    /** @brief Lowest free heap seen (UINT32_MAX before the first sample) */
+    uint32_t heapMinFreeBytes() const { return _heapMinFree; }
+
+    uint8_t regionCount() const { return _regionCount; }
+    const MemoryRegion& region(uint8_t index) const { return _regions[index]; }
+
+    uint8_t taskCount() const { return _taskCount; }
+    const MemoryTask& task(uint8_t index) const { return _tasks[index]; }
+
+    /** @brief Print the footprint, task stacks and heap to Serial (MEMORY) */
+    void printReport();
+
+private:
+    bool add(const char* name, size_t bytes, bool stackTemporary);
+
+    MemoryRegion _regions[MAX_REGIONS];
+    uint8_t _regionCount;
+    MemoryTask _tasks[MAX_TASKS];
+    uint8_t _taskCount;
+    uint32_t _heapMinFree;
+};
+
+extern MemoryReport memoryReport;
+
+#endif // MEMORY_REPORT_H
@@ -4,7 +4,8 @@
  * @version 2.0.0
  * @platform Adafruit Feather nRF52840 Express
  *
- * Implements BLE command parsing and handling for all 18 protocol commands:
+ * Implements BLE command handling for the phone protocol commands
+ * (looked up through command_table.h):
  * - Device info: INFO, BATTERY, PING
  * - Profiles: PROFILE_LIST, PROFILE_LOAD, PROFILE_GET, PROFILE_CUSTOM
  * - Session: SESSION_START, SESSION_PAUSE, SESSION_RESUME, SESSION_STOP, SESSION_STATUS
@@ -19,6 +20,9 @@
 #include <Arduino.h>
 #include "types.h"
 #include "config.h"
+#include "command_table.h"
+#include "phone_protocol.h"
+#include "status_snapshot.h"
 
 // Forward declarations
 class TherapyEngine;
@@ -46,20 +50,9 @@ static_assert(MESSAGE_BUFFER_SIZE >= RESPONSE_BUFFER_SIZE,
 // Timeout for SECONDARY battery response (milliseconds)
 static constexpr uint32_t SECONDARY_BATTERY_TIMEOUT_MS = 1000;
 
-// Parameter buffer size
+// Parameter buffer size (C-string copies for ProfileManager::setParameter)
 #define PARAM_BUFFER_SIZE 64
 
-// Maximum parameters per command
-#define MAX_COMMAND_PARAMS 16
-
-// =============================================================================
-// INTERNAL MESSAGE PREFIXES
-// =============================================================================
-
-// Messages that should be passed through without menu processing
-extern const char* INTERNAL_MESSAGES[];
-extern const uint8_t INTERNAL_MESSAGE_COUNT;
-
 // =============================================================================
 // CALLBACK TYPES
 // =============================================================================
@@ -173,6 +166,15 @@ public:
      */
     void setSendToSecondaryCallback(SendToSecondaryCallback callback);
 
+    /**
+     * @brief Read status (INFO, BATTERY, SESSION_STATUS) from a snapshot
+     *
+     * Status commands then never touch the therapy engine, state machine or
+     * battery monitor from the BLE task. Without one (tests, before setup()
+     * finishes) they read those components directly.
+     */
+    void setStatusSnapshot(const StatusSeqlock* snapshot);
+
     /**
      * @brief Set SECONDARY battery voltage from ISR/BLE callback context
      * @param voltage Battery voltage from SECONDARY glove
@@ -230,6 +232,12 @@ public:
      */
     void updateCalibrationBuzz();
 
+    /**
+     * @brief A battery query or calibration buzz is timing out (loop()
+     *        keeps its short wake cadence until both end)
+     */
+    bool hasTimedWork() const { return _waitingForSecondaryBattery || _calibBuzzFinger >= 0; }
+
 private:
     // Component references
     TherapyEngine* _therapy;
@@ -248,6 +256,7 @@ private:
     SendResponseCallback _sendCallback;
     RestartCallback _restartCallback;
     SendToSecondaryCallback _sendToSecondaryCallback;
+    const StatusSeqlock* _statusSnapshot;
 
     // Deferred command tracking for SECONDARY battery query
     enum class DeferredCommand : uint8_t {
@@ -281,22 +290,11 @@ private:
     volatile bool _calibBuzzCancelPending;
     volatile bool _calibBuzzRequestPending;  // publish flag: set last
 
-    // Response buffer
+    // Response buffer: KEY:VALUE text (v2) or an escaped TLV frame (v3)
     char _responseBuffer[RESPONSE_BUFFER_SIZE];
-
-    // =========================================================================
-    // COMMAND PARSING
-    // =========================================================================
-
-    /**
-     * @brief Parse command and extract parameters
-     * @param message Input message
-     * @param command Output command name (uppercase)
-     * @param params Output parameter array
-     * @param paramCount Output parameter count
-     * @return true if parsing successful
-     */
-    bool parseCommand(const char* message, char* command, char params[][PARAM_BUFFER_SIZE], uint8_t& paramCount);
+    uint8_t _responseProtocol;       // PHONE_PROTOCOL_*, latched per command
+    MenuCommand _responseCommand;    // Command being answered (v3 header)
+    PhoneFrameWriter _frame;
 
     // =========================================================================
     // RESPONSE FORMATTING
@@ -304,15 +302,23 @@ private:
 
     /**
      * @brief Start building a response
+     * @param error Error response (v3 header flag)
      */
-    void beginResponse();
+    void beginResponse(bool error = false);
 
     /**
-     * @brief Add key:value line to response
+     * @brief Add a field: a KEY:VALUE line (v2) or a TLV (v3, no formatting)
      */
+    void addResponseField(PhoneField field, const char* value);
+    void addResponseField(PhoneField field, int32_t value);
+    void addResponseField(PhoneField field, float value, uint8_t decimals = 2);
+    void addResponseField(PhoneField field, bool value);                     // "true"/"false"
+    void addResponseField(PhoneField field, uint8_t id, const char* name);  // "id:name"
+    void addResponseField(PhoneField field, MenuCommand command);           // Command name
+    void addResponseField(PhoneField field, const uint8_t* data, size_t length);  // Hex (v2), raw (v3)
+
+    /** @brief Append a formatted KEY:VALUE line (v2 only) */
     void addResponseLine(const char* key, const char* value);
-    void addResponseLine(const char* key, int32_t value);
-    void addResponseLine(const char* key, float value, uint8_t decimals = 2);
 
     /**
      * @brief Finalize and send response
@@ -336,14 +342,19 @@ private:
      */
     void handleSecondaryBatteryResponse(float voltage);
 
+    /**
+     * @brief Current status: the published snapshot, else read live
+     */
+    StatusSnapshot readStatus() const;
+
     void handleInfo();
     void handleBattery();
     void handlePing();
 
     void handleProfileList();
-    void handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleProfileLoad(const CommandArgs& args);
     void handleProfileGet();
-    void handleProfileCustom(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleProfileCustom(const CommandArgs& args);
 
     void handleSessionStart();
     void handleSessionPause();
@@ -351,17 +362,20 @@ private:
     void handleSessionStop();
     void handleSessionStatus();
 
-    void handleParamSet(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleParamSet(const CommandArgs& args);
 
     void handleCalibrateStart();
-    void handleCalibrateBuzz(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleCalibrateBuzz(const CommandArgs& args);
     void handleCalibrateStop();
 
     void handleHelp();
     void handleRestart();
 
-    void handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
-    void handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleTherapyLedOff(const CommandArgs& args);
+    void handleDebug(const CommandArgs& args);
+    void handleLatencyStream(const CommandArgs& args);
+    void handleJournalGet(const CommandArgs& args);
+    void handlePerf(const CommandArgs& args);
 };
 
 #endif // MENU_CONTROLLER_H
@@ -1,18 +1,21 @@
 /**
  * @file motor_event_buffer.h
- * @brief Lock-free motor event staging buffer for BLE callback -> main loop
+ * @brief Lock-free motor event staging buffer for BLE callback -> motor task
  * @version 1.0.0
  * @platform Adafruit Feather nRF52840 Express
  *
  * TP-1: Provides ISR-safe staging of motor events from BLE callbacks.
- * Events are staged without mutex acquisition, then forwarded to
- * ActivationQueue in the main loop context.
+ * Events are staged without mutex acquisition, then drained into
+ * ActivationQueue by the motor task itself, so reception-to-schedule
+ * latency no longer includes a main-loop iteration.
  *
  * Design:
  * - Lock-free SPSC (single-producer, single-consumer) ring buffer
  * - BLE callbacks (producer) write via stage()
- * - Main loop (consumer) reads via unstage()
+ * - Motor task (consumer) reads via unstage()
  * - Memory barriers (DMB) ensure ARM memory ordering
+ * - "Macrocycle replaces queue" travels in-band on the batch's first event
+ *   (replacesQueue), so a consumer draining mid-batch clears exactly once
  */
 
 #ifndef MOTOR_EVENT_BUFFER_H
@@ -20,6 +23,7 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "config.h"
 
 // =============================================================================
 // STAGED MOTOR EVENT
@@ -29,7 +33,7 @@
  * @brief Motor event staged from BLE callback for later processing
  *
  * Contains all parameters needed to call activationQueue.enqueue()
- * from the main loop context.
+ * from the motor task.
  */
 struct StagedMotorEvent {
     uint64_t activateTimeUs;   // Absolute activation time (microseconds)
@@ -38,6 +42,7 @@ struct StagedMotorEvent {
     uint16_t durationMs;       // Duration in milliseconds
     uint16_t frequencyHz;      // Frequency in Hz
     bool isMacrocycleLast;     // True if this is the last event in a macrocycle batch
+    bool replacesQueue;        // First event of a macrocycle batch: clear the queue before enqueuing
     volatile bool valid;       // Marks slot as ready for consumption
 
     StagedMotorEvent() :
@@ -47,6 +52,7 @@ struct StagedMotorEvent {
         durationMs(0),
         frequencyHz(0),
         isMacrocycleLast(false),
+        replacesQueue(false),
         valid(false) {}
 
     void clear() {
@@ -56,6 +62,7 @@ struct StagedMotorEvent {
         durationMs = 0;
         frequencyHz = 0;
         isMacrocycleLast = false;
+        replacesQueue = false;
         valid = false;
     }
 };
@@ -69,27 +76,30 @@ struct StagedMotorEvent {
  *
  * Uses SPSC (single-producer, single-consumer) model:
  * - Producer: BLE callbacks (ISR context)
- * - Consumer: Main loop
+ * - Consumer: Motor task
  *
  * Thread safety:
- * - stage() is ISR-safe (no mutex, uses memory barriers)
- * - unstage() is main-loop-only (no mutex needed)
+ * - stage()/beginMacrocycle() are ISR-safe (no mutex, uses memory barriers)
+ * - unstage() is consumer-only (no mutex needed)
  * - hasPending() is safe from any context
  *
  * Usage:
  *   // In BLE callback:
+ *   motorEventBuffer.beginMacrocycle();   // batch replaces the queue
  *   motorEventBuffer.stage(timeUs, finger, amp, dur, freq);
+ *   activationQueue.notifyMotorTask();
  *
- *   // In main loop():
+ *   // In motor task:
  *   StagedMotorEvent event;
  *   while (motorEventBuffer.unstage(event)) {
+ *       if (event.replacesQueue) activationQueue.clear();
  *       activationQueue.enqueue(event.activateTimeUs, event.finger,
  *                               event.amplitude, event.durationMs, event.frequencyHz);
  *   }
  */
 class MotorEventBuffer {
 public:
-    static constexpr uint8_t MAX_STAGED = 32;  // Power of 2 for efficient modulo; headroom for a full 5-motor macrocycle (15 events)
+    static constexpr uint8_t MAX_STAGED = MOTOR_EVENT_BUFFER_SLOTS;  // Power of 2 for efficient modulo; headroom for a full 5-motor macrocycle (15 events)
 
     MotorEventBuffer();
 
@@ -110,10 +120,10 @@ public:
                uint16_t durationMs, uint16_t frequencyHz, bool isMacrocycleLast = false);
 
     /**
-     * @brief Begin a new macrocycle batch (ISR-safe)
+     * @brief Begin a new macrocycle batch (ISR-safe, producer only)
      *
-     * Sets flag indicating incoming events are part of a macrocycle.
-     * Main loop will clear the activation queue before processing these events.
+     * The next staged event carries replacesQueue: the consumer clears the
+     * activation queue right before enqueuing it, once per batch.
      */
     void beginMacrocycle();
 
@@ -125,9 +135,9 @@ public:
     bool isMacrocyclePending() const;
 
     /**
-     * @brief Unstage the next pending event (main loop only)
+     * @brief Unstage the next pending event (consumer only)
      *
-     * Must only be called from main loop context.
+     * Must only be called from the single consumer (motor task).
      *
      * @param event Output: The unstaged event data
      * @return true if an event was unstaged, false if buffer empty
@@ -155,15 +165,19 @@ public:
     /**
      * @brief Clear all pending events
      *
-     * Should only be called from main loop when no staging is occurring.
+     * Should only be called when neither side is running (init, tests).
      */
     void clear();
 
 private:
+    static_assert((MAX_STAGED & (MAX_STAGED - 1)) == 0 && MAX_STAGED >= 2 && MAX_STAGED <= 128,
+                  "MOTOR_EVENT_BUFFER_SLOTS must be a power of two in 2..128");
+
     StagedMotorEvent _buffer[MAX_STAGED];
     volatile uint8_t _head;  // Next write position (producer)
     volatile uint8_t _tail;  // Next read position (consumer)
     volatile bool _macrocyclePending;  // True when macrocycle batch needs processing
+    bool _replaceNext;                 // Producer-only: stamp replacesQueue on the next stage()
 };
 
 // =============================================================================
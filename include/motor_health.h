@@ -0,0 +1,173 @@
+/**
+ * @file motor_health.h
+ * @brief Continuous DRV2605 health monitor, time-sliced into motor idle gaps
+ *
+ * The motor task reads back one register of one driver per idle gap (one
+ * select + read + close), round-robin over every enabled motor and
+ * MotorHealthCheck, and only when the slice's MOTOR_HEALTH_SLICE_BUDGET_US
+ * fits before the next pre-select slot - health checking runs all the time
+ * and never delays a therapy event. With no events queued it takes one slice
+ * every MOTOR_HEALTH_IDLE_INTERVAL_MS.
+ *
+ * Each readback is judged on its own:
+ * - STATUS: over-temperature or over-current flag (an absent chip reads 0xFF)
+ * - MODE: anything but RTP; the POR default (standby) counts as a reset
+ * - FEEDBACK: N_ERM_LRA cleared is the reset canary (see verifyAndHeal())
+ *
+ * A reset queues a reconfigure of that one chip, run in a later gap with room
+ * for MOTOR_HEALTH_HEAL_COST_US. MOTOR_HEALTH_FAIL_THRESHOLD bad readbacks in
+ * a row mark the motor failed: loop() drops it from the therapy engine's
+ * finger map (setActiveFingers). A failed motor keeps being checked and is
+ * restored after MOTOR_HEALTH_RECOVER_READS clean readbacks in a row.
+ *
+ * Threading: nextSlice()/record*() in the motor task; failedMask() and
+ * printReport() from loop() (counters are read without a lock).
+ */
+
+#ifndef MOTOR_HEALTH_H
+#define MOTOR_HEALTH_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @brief Register checked by one readback slice
+ */
+enum class MotorHealthCheck : uint8_t {
+    STATUS = 0,     // Fault flags
+    MODE,           // Run mode (RTP, not standby)
+    FEEDBACK,       // LRA bit = reset canary
+    COUNT
+};
+
+/**
+ * @brief Verdict on one readback
+ */
+enum class MotorHealthVerdict : uint8_t {
+    OK,
+    FAULT,          // Implausible value or fault flag
+    RESET           // Chip back at POR defaults (VBat brownout)
+};
+
+/**
+ * @brief Work for one slice
+ */
+struct MotorHealthSlice {
+    uint8_t finger;
+    bool heal;                  // Reconfigure the chip instead of a readback
+    MotorHealthCheck check;     // Register to read (readback slices)
+};
+
+/**
+ * @brief Per-motor counters (MOTOR_HEALTH)
+ */
+struct MotorHealthCounters {
+    uint32_t reads;             // Readbacks taken
+    uint32_t errors;            // ...judged FAULT or RESET
+    uint32_t resets;            // ...judged RESET
+    uint32_t heals;             // Chip reconfigures
+    uint32_t failures;          // Times the motor was dropped from the finger map
+    uint8_t badStreak;          // Consecutive bad readbacks
+    uint8_t goodStreak;         // Consecutive clean readbacks
+    bool failed;                // Out of the finger map
+};
+
+/**
+ * @class MotorHealthMonitor
+ * @brief Round-robin register readback with per-motor fault tracking
+ */
+class MotorHealthMonitor {
+public:
+    MotorHealthMonitor();
+
+    /**
+     * @brief Start watching a set of motors (clears counters)
+     * @param watchMask bit f set = check motor f
+     */
+    void begin(uint8_t watchMask);
+
+    /**
+     * @brief Pick the next slice that fits a budget
+     * @param budgetUs Time available before the next motor deadline
+     * @param slice Output: the slice to run
+     * @return false if nothing fits (or nothing is watched)
+     */
+    bool nextSlice(uint32_t budgetUs, MotorHealthSlice& slice);
+
+    /**
+     * @brief Judge and record a completed readback
+     * @return The verdict (RESET queues a heal for the motor)
+     */
+    MotorHealthVerdict recordRead(uint8_t finger, MotorHealthCheck check, uint8_t value);
+
+    /**
+     * @brief Record a slice that could not take the I2C bus (not the motor's fault)
+     */
+    void recordBusy();
+
+    /**
+     * @brief Record a reconfigure attempt
+     * @param done false if the bus was busy (heal stays queued)
+     */
+    void recordHeal(uint8_t finger, bool done);
+
+    /**
+     * @brief Record a slice's run time against its budget
+     */
+    void recordSliceTime(const MotorHealthSlice& slice, uint32_t elapsedUs);
+
+    /**
+     * @brief Motors currently out of the finger map
+     */
+    uint8_t failedMask() const { return _failedMask; }
+
+    /**
+     * @brief Per-motor counters
+     */
+    const MotorHealthCounters& counters(uint8_t finger) const { return _motors[finger]; }
+
+    /**
+     * @brief Judge one readback value
+     */
+    static MotorHealthVerdict judge(MotorHealthCheck check, uint8_t value);
+
+    /**
+     * @brief DRV2605 register address behind a check
+     */
+    static uint8_t registerOf(MotorHealthCheck check);
+
+    /**
+     * @brief Budget a slice is planned against
+     */
+    static uint32_t costUs(const MotorHealthSlice& slice) {
+        return slice.heal ? MOTOR_HEALTH_HEAL_COST_US : MOTOR_HEALTH_SLICE_BUDGET_US;
+    }
+
+    uint32_t sliceCount() const { return _slices; }
+    uint32_t overrunCount() const { return _overruns; }
+
+    /**
+     * @brief Print the per-motor table and slice counters
+     */
+    void printReport() const;
+
+private:
+    static constexpr uint8_t CHECK_COUNT = static_cast<uint8_t>(MotorHealthCheck::COUNT);
+
+    uint8_t _watchMask;
+    uint8_t _healMask;          // bit f set = reconfigure queued
+    volatile uint8_t _failedMask;
+    uint8_t _nextFinger;
+    uint8_t _nextCheck;
+    MotorHealthCounters _motors[MAX_ACTUATORS];
+
+    uint32_t _slices;
+    uint32_t _busy;             // Slices that found the bus taken
+    uint32_t _overruns;         // Slices that ran past their budget
+    uint32_t _maxSliceUs;
+};
+
+// Global instance
+extern MotorHealthMonitor motorHealth;
+
+#endif // MOTOR_HEALTH_H
@@ -0,0 +1,113 @@
+/**
+ * @file perf_profile.h
+ * @brief Cycle-accurate per-scope cost of the firmware's hot paths
+ *
+ * PERF_SCOPE(name) at the top of a function times it to the end of the
+ * enclosing block with the CPU cycle counter (DWT CYCCNT on the nRF52840,
+ * CCOUNT on the ESP32-S3; see platformCycleCount()) and folds the result
+ * into a static per-scope table: count, min, max and total cycles. The
+ * serial GET_PERF command prints the table, the phone PERF command returns
+ * it, and both can reset it.
+ *
+ * Compiled in only with PERF_PROFILE_ENABLED; otherwise PERF_SCOPE()
+ * expands to nothing and the table is never linked in. Scopes are a fixed
+ * enum rather than runtime strings so recording is an index, not a lookup.
+ *
+ * Recording takes a short critical section, so scopes may be used from
+ * the motor task, BLE callbacks and loop() alike. The counter is 32 bits:
+ * a scope longer than 2^32 cycles (67 s at 64 MHz) wraps.
+ */
+
+#ifndef PERF_PROFILE_H
+#define PERF_PROFILE_H
+
+#include <stdint.h>
+#include "config.h"
+#include "platform.h"
+
+/**
+ * @brief Instrumented scopes (PerfProfile::scopeName() gives the label)
+ */
+enum class PerfScope : uint8_t {
+    EXECUTE_MOTOR_EVENT,       // main.cpp executeMotorEvent()
+    PROCESS_TX_QUEUE,          // BLEManager::processTxQueue()
+    ON_BLE_MESSAGE,            // main.cpp onBLEMessage()
+    GENERATE_MACROCYCLE,       // TherapyEngine::generateMacrocycle()
+    DESERIALIZE_MACROCYCLE,    // SyncCommand::deserializeMacrocycle()
+    COUNT
+};
+
+/**
+ * @brief Accumulated cost of one scope
+ */
+struct PerfScopeStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+
+    uint32_t avgCycles() const {
+        return count > 0 ? static_cast<uint32_t>(totalCycles / count) : 0;
+    }
+};
+
+/**
+ * @class PerfProfile
+ * @brief Static table of per-scope cycle statistics
+ */
+class PerfProfile {
+public:
+    static constexpr uint8_t SCOPE_COUNT = static_cast<uint8_t>(PerfScope::COUNT);
+
+    PerfProfile();
+
+    /** @brief Start the cycle counter (setup(), before the first scope) */
+    void begin();
+
+    /** @brief Fold one measurement into scope's statistics (any context) */
+    void record(PerfScope scope, uint32_t cycles);
+
+    /** @brief Consistent copy of one scope's statistics */
+    PerfScopeStats get(PerfScope scope) const;
+
+    /** @brief Clear every scope */
+    void reset();
+
+    /** @brief Cycles to microseconds at the counter's clock */
+    static uint32_t cyclesToUs(uint32_t cycles);
+
+    /** @brief Label for a scope ("?" if out of range) */
+    static const char* scopeName(PerfScope scope);
+
+    /** @brief Print the table to Serial (GET_PERF) */
+    void printReport() const;
+
+private:
+    PerfScopeStats _stats[SCOPE_COUNT];
+};
+
+/**
+ * @class PerfScopeTimer
+ * @brief RAII cycle timer behind PERF_SCOPE()
+ */
+class PerfScopeTimer {
+public:
+    explicit PerfScopeTimer(PerfScope scope) : _scope(scope), _start(platformCycleCount()) {}
+    ~PerfScopeTimer();
+
+    PerfScopeTimer(const PerfScopeTimer&) = delete;
+    PerfScopeTimer& operator=(const PerfScopeTimer&) = delete;
+
+private:
+    PerfScope _scope;
+    uint32_t _start;
+};
+
+#if PERF_PROFILE_ENABLED
+extern PerfProfile perfProfile;
+#define PERF_SCOPE(scope) PerfScopeTimer _perfScopeTimer(PerfScope::scope)
+#else
+#define PERF_SCOPE(scope) do {} while (0)
+#endif
+
+#endif // PERF_PROFILE_H
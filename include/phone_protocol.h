@@ -0,0 +1,192 @@
+/**
+ * @file phone_protocol.h
+ * @brief Phone response wire formats: text (v2) and binary TLV (v3)
+ *
+ * v2 (default): "KEY:VALUE\n" lines, EOT-terminated (MenuController).
+ *
+ * v3 (opt-in): the phone sends "IDENTIFY:PHONE:3" instead of
+ * "IDENTIFY:PHONE". Commands stay text; each response becomes one frame:
+ *
+ *   0x03 (PHONE_V3_MARKER, never the first byte of a text response)
+ *   escaped body:
+ *     command  u8   MenuCommand that produced the response
+ *     flags    u8   bit0 = error (body carries ERROR_TEXT)
+ *     fields   tag u8 (PhoneField), len u8, value[len]
+ *
+ * Integers are little-endian two's complement in the fewest of 1/2/4 bytes
+ * that hold them; fixed-point fields carry value * 10^decimals (BATP/BATS
+ * centivolts, ON/OFF/JITTER tenths); booleans are one byte 0/1; strings are
+ * raw bytes, no NUL. PROFILE is an id byte followed by the name; COMMAND is
+ * a MenuCommand byte. Repeated tags (PROFILE_LIST, HELP) keep their order.
+ *
+ * The body is escaped like MACROCYCLE V6 (XOR 0x80, then NUL/EOT/CR/ESC
+ * sent as ESC, b ^ 0x20), so a frame passes through the EOT-framed C-string
+ * transport unchanged. Firmware without v3 ignores the suffix, classifies
+ * the phone after IDENTIFY_TIMEOUT_MS and answers in text; the phone tells
+ * the two apart by the first byte.
+ *
+ * Pure C++ (no Arduino dependencies) so it builds in native test envs.
+ */
+
+#ifndef PHONE_PROTOCOL_H
+#define PHONE_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string_view>
+
+#define PHONE_PROTOCOL_TEXT 2     // KEY:VALUE lines
+#define PHONE_PROTOCOL_BINARY 3   // TLV frames
+
+static constexpr uint8_t PHONE_V3_MARKER = 0x03;
+static constexpr uint8_t PHONE_V3_FLAG_ERROR = 0x01;
+static constexpr size_t PHONE_V3_MAX_BODY = 512;
+
+// =============================================================================
+// FIELDS
+// =============================================================================
+
+/**
+ * @brief Response fields; the text key of each is phoneFieldKey()
+ *
+ * Wire values: append only, never renumber.
+ */
+enum class PhoneField : uint8_t {
+    ERROR_TEXT = 1,     // "ERROR"            string
+    STATUS,             // "STATUS"           string
+    SESSION_STATUS,     // "SESSION_STATUS"   string
+    ROLE,               // "ROLE"             string
+    NAME,               // "NAME"             string
+    FW,                 // "FW"               string
+    MOTORS,             // "MOTORS"           int
+    PROFILE,            // "PROFILE"          id + name
+    BATP,               // "BATP"             centivolts
+    BATS,               // "BATS"             centivolts
+    PONG,               // "PONG"             empty
+    TYPE,               // "TYPE"             string
+    FREQ,               // "FREQ"             int (Hz)
+    ON,                 // "ON"               tenths of ms
+    OFF,                // "OFF"              tenths of ms
+    SESSION,            // "SESSION"          int (minutes)
+    AMPMIN,             // "AMPMIN"           int
+    AMPMAX,             // "AMPMAX"           int
+    PATTERN,            // "PATTERN"          string
+    MIRROR,             // "MIRROR"           int 0/1
+    JITTER,             // "JITTER"           tenths of %
+    ELAPSED,            // "ELAPSED"          int (s)
+    TOTAL,              // "TOTAL"            int (s)
+    PROGRESS,           // "PROGRESS"         int (%)
+    PARAM,              // "PARAM"            string
+    VALUE,              // "VALUE"            string
+    MODE,               // "MODE"             string
+    FINGER,             // "FINGER"           int
+    INTENSITY,          // "INTENSITY"        int
+    DURATION,           // "DURATION"         int (ms)
+    COMMAND,            // "COMMAND"          MenuCommand
+    THERAPY_LED_OFF,    // "THERAPY_LED_OFF"  bool
+    DEBUG_MODE,         // "DEBUG"            bool
+    LATENCY_STREAM,     // "LATENCY_STREAM"   bool
+    CHUNKS,             // "CHUNKS"           int
+    CHUNK,              // "CHUNK"            int
+    DATA,               // "DATA"             bytes (hex in text)
+    CPU_MHZ,            // "CPU_MHZ"          int
+    SCOPE               // "SCOPE"            string "name,count,min,avg,max" (cycles)
+};
+
+/** @brief Text-protocol key for a field ("" if unknown) */
+const char* phoneFieldKey(PhoneField field);
+
+// =============================================================================
+// NEGOTIATION
+// =============================================================================
+
+/**
+ * @brief Protocol requested by an IDENTIFY:PHONE handshake
+ * @param message "IDENTIFY:PHONE" or "IDENTIFY:PHONE:<version>"
+ * @param latest Newest protocol this build speaks
+ * @return Negotiated protocol (requested capped to latest, at least
+ *         PHONE_PROTOCOL_TEXT), or 0 if message is not IDENTIFY:PHONE
+ */
+uint8_t phoneProtocolFromIdentify(const char* message, uint8_t latest);
+
+// =============================================================================
+// FRAME WRITER
+// =============================================================================
+
+/**
+ * @class PhoneFrameWriter
+ * @brief Escapes v3 fields straight into a response buffer
+ *
+ * A field that does not fit is dropped whole (as the text builder drops a
+ * line) and overflowed() latches.
+ */
+class PhoneFrameWriter {
+public:
+    PhoneFrameWriter();
+
+    /** @brief Start a frame (marker, command, flags) in buffer */
+    void begin(char* buffer, size_t capacity, uint8_t command, uint8_t flags = 0);
+
+    bool putInt(PhoneField field, int32_t value);
+    bool putFixed(PhoneField field, float value, uint8_t decimals);
+    bool putBool(PhoneField field, bool value);
+    bool putString(PhoneField field, std::string_view value);
+    bool putEmpty(PhoneField field);
+
+    /** @brief Id byte followed by a name (PROFILE) */
+    bool putIdString(PhoneField field, uint8_t id, std::string_view name);
+
+    /** @brief Escaped frame length so far (marker included) */
+    size_t length() const { return _pos; }
+
+    bool overflowed() const { return _overflow; }
+
+private:
+    bool putField(PhoneField field, const uint8_t* prefix, size_t prefixLen,
+                  const uint8_t* value, size_t valueLen);
+    bool putByte(uint8_t b);
+
+    char* _buffer;
+    size_t _capacity;
+    size_t _pos;
+    bool _overflow;
+};
+
+// =============================================================================
+// FRAME READER
+// =============================================================================
+
+/**
+ * @class PhoneFrameReader
+ * @brief Decodes a v3 frame (reference for the phone side; used by tests)
+ */
+class PhoneFrameReader {
+public:
+    /**
+     * @brief Unescape a frame
+     * @param frame Received bytes (marker first, EOT stripped)
+     * @return false if not a v3 frame or malformed
+     */
+    bool open(const char* frame, size_t length);
+
+    uint8_t command() const { return _command; }
+    uint8_t flags() const { return _flags; }
+
+    /**
+     * @brief Next field
+     * @return false at the end (or on a truncated field)
+     */
+    bool next(PhoneField& field, const uint8_t*& value, uint8_t& length);
+
+    /** @brief Sign-extend an integer field */
+    static int32_t intValue(const uint8_t* value, uint8_t length);
+
+private:
+    uint8_t _body[PHONE_V3_MAX_BODY];
+    size_t _length = 0;
+    size_t _pos = 0;
+    uint8_t _command = 0;
+    uint8_t _flags = 0;
+};
+
+#endif // PHONE_PROTOCOL_H
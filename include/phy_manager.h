@@ -0,0 +1,184 @@
+/**
+ * @file phy_manager.h
+ * @brief Automatic PHY selection for the PRIMARY-SECONDARY link (PRIMARY)
+ *
+ * 2M halves air time and so the RTT, but it has the least link budget: with
+ * the gloves on opposite sides of a body or under a blanket, packets fail
+ * their CRC, the link layer retransmits them one connection event later,
+ * and RTT blows out. The manager walks a ladder
+ *
+ *     2M  ->  1M  ->  Coded
+ *
+ * from two proxies the PING/PONG exchange already provides (the stacks do
+ * not report CRC errors):
+ *   - retransmissions: RTT above the PHY's tracked minimum, in connection
+ *     intervals (each one is an event where a leg had to be resent);
+ *   - lost PONGs (PingScheduler::missedPongs()), counted as
+ *     BLE_PHY_AUTO_MISS_RETX retransmissions each.
+ * Their EMA (Q8, per exchange) steps the link down at
+ * BLE_PHY_AUTO_DEGRADE_RETX_Q8, and BLE_PHY_AUTO_MISS_LIMIT lost PONGs in
+ * a row step it down at once. After BLE_PHY_AUTO_PROBE_MS at or below
+ * BLE_PHY_AUTO_RECOVER_RETX_Q8 it probes the next faster PHY; a PHY that
+ * was left (or refused) is held off for a back-off that doubles up to
+ * BLE_PHY_AUTO_PROBE_MAX_MS, so a marginal link does not flap.
+ *
+ * Minimum RTTs are kept per PHY across switches; main.cpp keeps the sync
+ * statistics per PHY (PhyManager::slot()).
+ *
+ * onLinkUp() and onExchange() are safe from the BLE task; everything else
+ * runs in the loop task. Pure C++ (no Arduino dependencies) so it builds in
+ * native test envs.
+ */
+
+#ifndef PHY_MANAGER_H
+#define PHY_MANAGER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @brief Ladder rung, fastest first (also the per-PHY cache slot)
+ */
+enum class BlePhy : uint8_t {
+    PHY_2M = 0,
+    PHY_1M,
+    CODED
+};
+
+static constexpr uint8_t BLE_PHY_COUNT = 3;
+
+#ifdef BLE_USE_2M_PHY
+#define BLE_PHY_FASTEST BlePhy::PHY_2M
+#else
+#define BLE_PHY_FASTEST BlePhy::PHY_1M
+#endif
+#if BLE_PHY_AUTO_CODED_ENABLED
+#define BLE_PHY_SLOWEST BlePhy::CODED
+#else
+#define BLE_PHY_SLOWEST BlePhy::PHY_1M
+#endif
+
+/** @brief HCI PHY bit (1M=0x01, 2M=0x02, Coded=0x04), as both stacks take it */
+uint8_t blePhyMask(BlePhy phy);
+
+/** @brief Rung for an HCI PHY bit; false if phyMask names no single PHY */
+bool blePhyFromMask(uint8_t phyMask, BlePhy& phy);
+
+const char* blePhyName(BlePhy phy);
+
+/**
+ * @class PhyManager
+ * @brief Picks the link PHY from retransmission proxies
+ */
+class PhyManager {
+public:
+    /**
+     * @param fastest Top rung (1M without BLE_USE_2M_PHY)
+     * @param slowest Bottom rung (1M without BLE_PHY_AUTO_CODED_ENABLED)
+     */
+    explicit PhyManager(BlePhy fastest = BLE_PHY_FASTEST, BlePhy slowest = BLE_PHY_SLOWEST);
+
+    /**
+     * @brief SECONDARY link came up: forget everything
+     *
+     * Safe from BLE callbacks; update() applies it.
+     */
+    void onLinkUp() { _linkUpPending = true; }
+
+    /**
+     * @brief One PING/PONG round trip (BLE task)
+     *
+     * Only the latest is kept until update() runs; one PING is in flight
+     * at a time, so none is lost in practice.
+     */
+    void onExchange(uint32_t rttUs) {
+        _pendingRttUs = rttUs;
+        _rttPending = true;
+    }
+
+    /**
+     * @brief The link now runs on phy (read back from the stack)
+     *
+     * Whether requested or not: restarts the dwell and the quality EMA.
+     */
+    void onPhyChanged(BlePhy phy, uint32_t nowMs);
+
+    /**
+     * @brief Connection interval changed: minimum RTTs no longer hold
+     */
+    void resetQuality();
+
+    /**
+     * @brief Fold in exchanges and decide (loop task)
+     * @param nowMs millis()
+     * @param intervalUs SECONDARY connection interval (0 = unknown, no retransmission proxy)
+     * @param missedPongs PingScheduler::missedPongs() (monotonic)
+     * @param request PHY to request when returning true
+     * @return true when the link should switch to request
+     */
+    bool update(uint32_t nowMs, uint32_t intervalUs, uint32_t missedPongs, BlePhy& request);
+
+    /** @brief PHY the link is on (as last reported to onPhyChanged) */
+    BlePhy current() const { return _current; }
+
+    /** @brief A request is waiting for its onPhyChanged() */
+    bool requestPending() const { return _requestPending; }
+
+    /** @brief Retransmissions per exchange on the current PHY (EMA, Q8) */
+    uint32_t retxScoreQ8() const { return _retxQ8; }
+
+    /** @brief Exchanges folded in since the last PHY change */
+    uint16_t sampleCount() const { return _samples; }
+
+    /** @brief Tracked minimum RTT of phy (UINT32_MAX = none yet) */
+    uint32_t minRttUs(BlePhy phy) const { return _minRttUs[slot(phy)]; }
+
+    /** @brief Lost PONGs in a row */
+    uint8_t missRun() const { return _missRun; }
+
+    /** @brief PHY changes seen since boot */
+    uint32_t switchCount() const { return _switchCount; }
+
+    /** @brief Requests the peer never answered */
+    uint32_t refusedCount() const { return _refusedCount; }
+
+    /** @brief Cache index of phy */
+    static uint8_t slot(BlePhy phy) { return static_cast<uint8_t>(phy); }
+
+private:
+    void reset();
+    void foldExchange(uint32_t rttUs, uint32_t intervalUs);
+    void foldRetx(uint32_t retxQ8);
+    void holdOff(BlePhy phy, uint32_t nowMs);
+    bool heldOff(uint8_t phySlot, uint32_t nowMs);
+    bool startRequest(BlePhy phy, uint32_t nowMs, BlePhy& out);
+
+    BlePhy _fastest;
+    BlePhy _slowest;
+
+    volatile bool _linkUpPending;
+    volatile bool _rttPending;
+    volatile uint32_t _pendingRttUs;
+
+    BlePhy _current;
+    bool _requestPending;
+    BlePhy _requested;
+    uint32_t _requestMs;
+
+    uint32_t _retxQ8;
+    uint16_t _samples;
+    uint8_t _missRun;
+    uint32_t _lastMissedPongs;
+    bool _missBaselineSet;
+    uint32_t _changedMs;       // Last PHY change (dwell)
+    uint32_t _quietSinceMs;    // Last time the current PHY was not quiet (probe timer)
+
+    uint32_t _minRttUs[BLE_PHY_COUNT];
+    uint32_t _holdUntilMs[BLE_PHY_COUNT];   // 0 = not held off
+    uint32_t _backoffMs[BLE_PHY_COUNT];
+
+    uint32_t _switchCount;
+    uint32_t _refusedCount;
+};
+
+#endif // PHY_MANAGER_H
@@ -0,0 +1,92 @@
+/**
+ * @file ping_scheduler.h
+ * @brief Adaptive PING cadence for keepalive + clock sync (PRIMARY)
+ *
+ * A fixed 4Hz/1Hz cadence spends radio time and CPU on both gloves long
+ * after the offset and drift are characterized. The scheduler instead:
+ *   - bursts SYNC_PING_BURST_COUNT PINGs back-to-back (next one
+ *     SYNC_PING_BURST_GAP_MS after each PONG) on link-up and PHY change,
+ *     so sync converges in well under a second;
+ *   - doubles the interval from the base cadence after every accepted
+ *     sample whose uncertainty is below SYNC_PING_STABLE_UNCERTAINTY_US,
+ *     up to SYNC_PING_MAX_INTERVAL_MS (which leaves room for one lost PING
+ *     inside KEEPALIVE_TIMEOUT_MS);
+ *   - snaps back to the base cadence on a rejected sample, a missed PONG,
+ *     invalid sync or uncertainty above SYNC_PING_UNSTABLE_UNCERTAINTY_US.
+ *
+ * Pure policy; main.cpp sends the PING when update() says so.
+ */
+
+#ifndef PING_SCHEDULER_H
+#define PING_SCHEDULER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @class PingScheduler
+ * @brief Decides when the next PING goes out
+ */
+class PingScheduler {
+public:
+    PingScheduler();
+
+    /**
+     * @brief Start a burst (SECONDARY link up, PHY change)
+     *
+     * Safe from BLE callbacks; update() picks it up.
+     */
+    void requestBurst() { _burstPending = true; }
+
+    /**
+     * @brief A PONG for the last PING arrived (BLE task)
+     * @param accepted Whether its offset sample passed the quality gates
+     */
+    void onPong(bool accepted) {
+        _pongAccepted = accepted;
+        _pongPending = true;
+    }
+
+    /**
+     * @brief Advance the schedule (main loop)
+     * @param nowMs millis()
+     * @param syncValid Clock sync has converged
+     * @param uncertaintyUs SimpleSyncProtocol::getOffsetUncertaintyUs()
+     * @param therapyRunning Base cadence is SYNC_ACTIVE_INTERVAL_MS when true
+     * @return true when a PING should be sent now
+     */
+    bool update(uint32_t nowMs, bool syncValid, uint32_t uncertaintyUs, bool therapyRunning);
+
+    /** @brief Current steady-state interval */
+    uint32_t intervalMs() const { return _intervalMs; }
+
+    /**
+     * @brief millis() at which the next PING is due (loop() wake deadline)
+     *
+     * As of the last update(); a PONG or burst request moves it, and both
+     * wake loop() through LOOP_WAKE_BLE_RX / LOOP_WAKE_BLE_LINK.
+     */
+    uint32_t nextDueMs() const { return _nextDueMs; }
+
+    /** @brief PINGs left in the current burst */
+    uint8_t burstRemaining() const { return _burstRemaining; }
+
+    /** @brief PINGs whose PONG never arrived before the next one went out (monotonic) */
+    uint32_t missedPongs() const { return _missedPongs; }
+
+private:
+    static uint32_t baseIntervalMs(bool therapyRunning);
+    void adapt(bool accepted, bool syncValid, uint32_t uncertaintyUs, uint32_t baseMs);
+
+    volatile bool _burstPending;
+    volatile bool _pongPending;
+    volatile bool _pongAccepted;
+    bool _awaitingPong;
+    uint8_t _burstRemaining;
+    uint32_t _intervalMs;
+    uint32_t _lastPingMs;
+    uint32_t _nextDueMs;
+    uint32_t _missedPongs;
+};
+
+#endif // PING_SCHEDULER_H
@@ -1,7 +1,8 @@
 /**
  * @file platform.h
  * @brief Platform primitives: critical sections, memory barrier, system reset,
- *        RTOS headers, and clock capability flags
+ *        die temperature, CPU cycle counter, heap and task-stack usage, RTOS
+ *        headers, and clock capability flags
  *
  * Exactly one branch is active per build:
  * - PentaBuzzer ESP32-S3 device build (FreeRTOS SMP: spinlock critical sections)
@@ -17,11 +18,34 @@
 #if defined(BOARD_PENTABUZZER_ESP32S3) && !defined(NATIVE_TEST_BUILD)
   #include "freertos/FreeRTOS.h"
   #include "freertos/semphr.h"
+  #include "freertos/task.h"
   #include "esp_system.h"
+  #include "esp_heap_caps.h"
+  #include "esp32-hal.h"
+  #include "esp_cpu.h"
   // Single shared spinlock across all translation units (C++20 inline variable).
   inline portMUX_TYPE g_platformMux = portMUX_INITIALIZER_UNLOCKED;
   inline void platformSystemReset()   { esp_restart(); }
   inline void platformMemoryBarrier() { __sync_synchronize(); }
+  // Die temperature in 0.25 C units (internal sensor, +/-1 C class)
+  inline bool platformDieTemperatureQ(int16_t& quarterC) {
+      quarterC = static_cast<int16_t>(temperatureRead() * 4.0f);
+      return true;
+  }
+  // Xtensa CCOUNT: always running, per core (a scope that migrates between
+  // cores mid-measurement reads two different counters)
+  inline void platformCycleCounterInit() {}
+  inline uint32_t platformCycleCount() { return static_cast<uint32_t>(esp_cpu_get_cycle_count()); }
+  inline uint32_t platformCycleCounterHz() { return getCpuFrequencyMhz() * 1000000UL; }
+  // Heap: ESP-IDF tracks the low-water mark itself
+  inline uint32_t platformHeapTotalBytes() { return heap_caps_get_total_size(MALLOC_CAP_DEFAULT); }
+  inline uint32_t platformHeapFreeBytes() { return esp_get_free_heap_size(); }
+  inline uint32_t platformHeapMinEverFreeBytes() { return esp_get_minimum_free_heap_size(); }
+  // Task stacks: ESP-IDF high-water marks are already in bytes
+  inline uint32_t platformTaskStackFreeBytes(void* task) {
+      return uxTaskGetStackHighWaterMark(static_cast<TaskHandle_t>(task));
+  }
+  inline void* platformTaskByName(const char* name) { return xTaskGetHandle(name); }
   #define PLATFORM_CRITICAL_ENTER()   portENTER_CRITICAL(&g_platformMux)
   #define PLATFORM_CRITICAL_EXIT()    portEXIT_CRITICAL(&g_platformMux)
   #define PLATFORM_HAS_HIRES_CLOCK    1
@@ -33,8 +57,43 @@
 #elif defined(BOARD_BLUEBUZZAH_NRF52) && !defined(NATIVE_TEST_BUILD)
   #include <Arduino.h>
   #include "rtos.h"  // Adafruit nRF52 core FreeRTOS wrapper (SemaphoreHandle_t etc.)
+  #include <nrf_soc.h>
   inline void platformSystemReset()   { NVIC_SystemReset(); }
   inline void platformMemoryBarrier() { __DMB(); }
+  // Die temperature in 0.25 C units (SoftDevice TEMP; needs the SoftDevice enabled)
+  inline bool platformDieTemperatureQ(int16_t& quarterC) {
+      int32_t temp;
+      if (sd_temp_get(&temp) != NRF_SUCCESS) return false;
+      quarterC = static_cast<int16_t>(temp);
+      return true;
+  }
+  // Cortex-M4 DWT CYCCNT: off until trace is enabled in DEMCR
+  inline void platformCycleCounterInit() {
+      CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+      DWT->CYCCNT = 0;
+      DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+  inline uint32_t platformCycleCount() { return DWT->CYCCNT; }
+  inline uint32_t platformCycleCounterHz() { return SystemCoreClock; }
+  // Heap: newlib malloc arena via the core's dbgHeap* helpers (utility/debug.h,
+  // pulled in by Arduino.h). No low-water mark: MemoryReport samples one.
+  inline uint32_t platformHeapTotalBytes() { return static_cast<uint32_t>(dbgHeapTotal()); }
+  inline uint32_t platformHeapFreeBytes() {
+      return static_cast<uint32_t>(dbgHeapTotal() - dbgHeapUsed());
+  }
+  inline uint32_t platformHeapMinEverFreeBytes() { return UINT32_MAX; }
+  // Task stacks: vanilla FreeRTOS high-water marks are in words
+  inline uint32_t platformTaskStackFreeBytes(void* task) {
+      return uxTaskGetStackHighWaterMark(static_cast<TaskHandle_t>(task)) * sizeof(StackType_t);
+  }
+  inline void* platformTaskByName(const char* name) {
+  #if INCLUDE_xTaskGetHandle
+      return xTaskGetHandle(name);
+  #else
+      (void)name;
+      return nullptr;
+  #endif
+  }
   // NOTE: PLATFORM_CRITICAL_ENTER declares a local `_pm`. Each ENTER must be in
   // its own braced block scope; two ENTERs in one block would redeclare `_pm`.
   #define PLATFORM_CRITICAL_ENTER()   uint32_t _pm = __get_PRIMASK(); __disable_irq()
@@ -45,6 +104,15 @@
   // activation_queue.cpp) are excluded from native builds.
   inline void platformSystemReset()   {}
   inline void platformMemoryBarrier() {}
+  inline bool platformDieTemperatureQ(int16_t&) { return false; }
+  inline void platformCycleCounterInit() {}
+  inline uint32_t platformCycleCount() { return 0; }
+  inline uint32_t platformCycleCounterHz() { return 1000000UL; }
+  inline uint32_t platformHeapTotalBytes() { return 0; }
+  inline uint32_t platformHeapFreeBytes() { return 0; }
+  inline uint32_t platformHeapMinEverFreeBytes() { return UINT32_MAX; }
+  inline uint32_t platformTaskStackFreeBytes(void*) { return 0; }
+  inline void* platformTaskByName(const char*) { return nullptr; }
   #define PLATFORM_CRITICAL_ENTER()   do {} while (0)
   #define PLATFORM_CRITICAL_EXIT()    do {} while (0)
   #define PLATFORM_HAS_HIRES_CLOCK    0
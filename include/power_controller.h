@@ -1,16 +1,20 @@
 /**
  * @file power_controller.h
- * @brief Board power-path control (power switch, peripheral rail, deep sleep)
+ * @brief Board power-path control (power switch, peripheral rail, deep sleep,
+ *        idle sleep between motor events)
  *
  * Implementations (build_src_filter-selected):
- * - power_controller_esp32.cpp: PentaBuzzer slide switch + ESP32 deep sleep
- * - power_controller_nrf52.cpp: no-op (the Feather board has no power switch)
+ * - power_controller_esp32.cpp: PentaBuzzer slide switch + ESP32 deep sleep,
+ *   automatic light sleep / DFS under an esp_pm lock
+ * - power_controller_nrf52.cpp: no power switch; idle sleep is the core's
+ *   FreeRTOS tickless idle, entered whenever every task blocks
  */
 
 #ifndef POWER_CONTROLLER_H
 #define POWER_CONTROLLER_H
 
 #include <Arduino.h>
+#include "config.h"
 
 class LEDController;
 
@@ -19,7 +23,11 @@ public:
     /** Configure power pins (Penta); no-op on nRF. Call once in setup(). */
     void begin();
 
-    /** @return true when the power switch requests shutdown (Penta); false on nRF */
+    /**
+     * @return true when the power switch requests shutdown (Penta); false on nRF
+     *
+     * The switch-off edge also sets LOOP_WAKE_POWER, so loop() needn't poll it.
+     */
     bool powerOffRequested();
 
     /** Shutdown animation, peripheral rail off, deep sleep until switch-on (Penta); no-op on nRF */
@@ -27,6 +35,49 @@ public:
 
     /** @return true when USB power is present (Penta); false on nRF */
     bool usbPowerPresent();
+
+    // =========================================================================
+    // IDLE SLEEP (POWER_IDLE_SLEEP_ENABLED)
+    // =========================================================================
+
+    /**
+     * @brief Enable idle sleep; call once in setup() before the motor task starts
+     *
+     * Starts with idle sleep disallowed (held awake). ESP32-S3: configures
+     * esp_pm for light sleep, falling back to frequency scaling only when the
+     * core's sdkconfig lacks tickless idle. nRF52: nothing to configure.
+     *
+     * @return false if the platform offers no idle power mode
+     */
+    bool beginIdleSleep();
+
+    /**
+     * @brief Allow or forbid idle sleep (motor task only)
+     *
+     * The motor task allows it only while blocked through a long gap; its
+     * final approach (alarm + busy-wait) runs with sleep forbidden, at full
+     * CPU frequency. No-op on nRF52, where blocking alone lets the core idle.
+     */
+    void setIdleSleepAllowed(bool allowed);
+
+    /**
+     * @brief Sleepable part of a wait for a motor deadline
+     * @param nowUs Current time (getMicros())
+     * @param deadlineUs Next motor event time
+     * @return ms to block with idle sleep allowed, waking POWER_IDLE_GUARD_MS
+     *         ahead of the deadline; 0 if the gap is under POWER_IDLE_MIN_MS
+     */
+    static uint32_t idleBudgetMs(uint64_t nowUs, uint64_t deadlineUs) {
+        if (deadlineUs <= nowUs) {
+            return 0;
+        }
+        uint64_t gapMs = (deadlineUs - nowUs) / 1000ULL;
+        if (gapMs < POWER_IDLE_MIN_MS) {
+            return 0;
+        }
+        gapMs -= POWER_IDLE_GUARD_MS;
+        return (gapMs > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(gapMs);
+    }
 };
 
 #endif // POWER_CONTROLLER_H
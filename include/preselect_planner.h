@@ -0,0 +1,151 @@
+/**
+ * @file preselect_planner.h
+ * @brief Look-ahead plan of I2C pre-selection over the scheduled motor events
+ *
+ * An activation takes the [FAST] path when its mux channel is already open
+ * and its frequency already written, leaving a single RTP write on the
+ * critical path. The motor task pre-selects every activation just in time,
+ * PRESELECT_LEAD_US ahead of it: VBAT sampling and deferred loop() work
+ * (heal checks) use the gap first and cannot undo the pre-selection.
+ *
+ * Whenever the activation queue changes, the motor task feeds the whole
+ * schedule to the planner in time order. Events are grouped the way the
+ * motor task dispatches them (one I2C burst per MOTOR_BATCH_WINDOW_US
+ * cluster) and every gap between groups is checked:
+ * - A lone activation whose gap fits PRESELECT_COST_US is FAST
+ * - An activation in a burst, or behind a gap too short to pre-select
+ *   (overlapping events of different motors), gets its frequency write
+ *   staged into the latest earlier gap with room that follows its motor's
+ *   previous deactivation (STAGED): only mux + RTP remain on its path
+ *   because the driver skips unchanged registers
+ * - Otherwise it stays on the slow path (SLOW)
+ *
+ * takeStagedWrite() hands the motor task the staged writes as their gaps
+ * come up; a write whose gap has passed is counted as missed.
+ *
+ * Threading: motor task only.
+ */
+
+#ifndef PRESELECT_PLANNER_H
+#define PRESELECT_PLANNER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @brief Plan summary and staged-write counters (GET_LATENCY)
+ */
+struct PreselectPlanStats {
+    uint8_t activations;    // Activations in the last plan
+    uint8_t fast;           // ...pre-selected in their own gap
+    uint8_t staged;         // ...with the frequency write moved to an earlier gap
+    uint8_t slow;           // ...with no room for either
+    uint32_t plans;         // Plans built (one per queue change)
+    uint32_t stagedWrites;  // Staged frequency writes performed
+    uint32_t stagedMissed;  // Staged writes whose gap passed first
+};
+
+/**
+ * @class PreselectPlanner
+ * @brief Classifies upcoming activations and stages frequency writes into gaps
+ */
+class PreselectPlanner {
+public:
+    static constexpr uint8_t MAX_STAGED = PRESELECT_STAGE_SLOTS;
+    static constexpr uint8_t MAX_GROUP = MAX_ACTUATORS * 2;  // One burst (matches dispatch)
+
+    PreselectPlanner();
+
+    /**
+     * @brief Start a plan, discarding the previous one's staged writes
+     * @param nowUs Current time; the first gap starts here
+     * @param batchWindowUs Dispatch cluster window (0 = one event per dispatch)
+     */
+    void begin(uint64_t nowUs, uint32_t batchWindowUs);
+
+    /**
+     * @brief Add the next scheduled event (time order)
+     * @param activate true for ACTIVATE, false for DEACTIVATE
+     * @param frequencyHz Activation frequency (ignored for DEACTIVATE)
+     */
+    void add(uint64_t timeUs, uint8_t finger, bool activate, uint16_t frequencyHz);
+
+    /**
+     * @brief Close the plan (classifies the last group)
+     */
+    void finish();
+
+    /**
+     * @brief Next staged frequency write whose gap is open at nowUs
+     * @param finger Output: motor to write
+     * @param frequencyHz Output: frequency to write
+     * @return true if a write should run now (it is consumed)
+     */
+    bool takeStagedWrite(uint64_t nowUs, uint8_t& finger, uint16_t& frequencyHz);
+
+    /**
+     * @brief Pending staged writes
+     */
+    uint8_t stagedCount() const { return _stagedCount - _stagedHead; }
+
+    /**
+     * @brief Activation is within its pre-select slot (PRESELECT_LEAD_US)
+     */
+    static bool preselectDue(uint64_t nowUs, uint64_t activateUs) {
+        return activateUs <= nowUs + PRESELECT_LEAD_US;
+    }
+
+    /**
+     * @brief A pre-selection started now finishes before the activation
+     */
+    static bool preselectFits(uint64_t nowUs, uint64_t activateUs) {
+        return activateUs >= nowUs + PRESELECT_COST_US;
+    }
+
+    PreselectPlanStats getStats() const;
+    void resetStats();
+
+private:
+    /**
+     * @brief Planned frequency write and the gap it must run in
+     */
+    struct StagedWrite {
+        uint64_t notBeforeUs;   // Gap start (previous burst done)
+        uint64_t deadlineUs;    // Gap end (next pre-select slot)
+        uint8_t finger;
+        uint16_t frequencyHz;
+    };
+
+    void openGroup(uint64_t timeUs);
+    void closeGroup();
+    bool stage(uint8_t finger, uint16_t frequencyHz);
+
+    uint32_t _batchWindowUs;
+    uint64_t _prevEndUs;                    // Bus free after the previous group
+    uint64_t _freeFromUs[MAX_ACTUATORS];    // Motor free after its last deactivation
+
+    // Current group (one dispatch)
+    uint64_t _groupStartUs;
+    uint64_t _groupGapUs;                   // Bus-free time ahead of the group
+    uint8_t _groupSize;
+    uint8_t _groupFinger[MAX_GROUP];
+    uint16_t _groupFrequency[MAX_GROUP];
+    bool _groupActivate[MAX_GROUP];
+
+    // Latest gap with room for staged writes
+    bool _gapValid;
+    uint64_t _gapStartUs;
+    uint64_t _gapEndUs;
+    uint64_t _gapBudgetUs;
+
+    StagedWrite _staged[MAX_STAGED];
+    uint8_t _stagedHead;
+    uint8_t _stagedCount;
+
+    PreselectPlanStats _stats;
+};
+
+// Global instance
+extern PreselectPlanner preselectPlanner;
+
+#endif // PRESELECT_PLANNER_H
@@ -5,7 +5,7 @@
  * @platform Adafruit Feather nRF52840 Express
  *
  * Manages therapy profiles including:
- * - Built-in profiles (stored in flash)
+ * - Built-in profiles (constexpr table in flash)
  * - Custom profile parameters
  * - Profile loading and validation
  * - LittleFS storage for settings
@@ -17,27 +17,20 @@
 #include <Arduino.h>
 #include "types.h"
 #include "config.h"
+#include "settings_log.h"
 
 // =============================================================================
 // CONSTANTS
 // =============================================================================
 
-// Maximum number of profiles
-#define MAX_PROFILES 8
-
-// Profile name max length
-#define PROFILE_NAME_MAX 32
-
-// Profile description max length
-#define PROFILE_DESC_MAX 64
-
 // Pattern type string max length
 #define PATTERN_TYPE_MAX 16
 
-// Settings file path and format
+// Settings file path and format (SETTINGS_FILE: legacy whole-struct file,
+// read once and replaced by the settings log on the next save)
 #define SETTINGS_FILE "/settings.bin"
 #define SETTINGS_MAGIC 0xBB
-#define SETTINGS_VERSION 1
+#define SETTINGS_VERSION 2   // 2: timing in integer us / Q16 (1: float ms / percent)
 
 // =============================================================================
 // BINARY SETTINGS STRUCTURE (for persistent storage)
@@ -47,7 +40,9 @@
  * @brief Packed binary settings structure for InternalFS storage
  *
  * This compact struct replaces JSON serialization, saving ~10-15KB flash
- * by eliminating the ArduinoJson dependency.
+ * by eliminating the ArduinoJson dependency. It is the image SettingsLog
+ * persists: field offsets are the log's keys, so append fields, never
+ * reorder them.
  */
 struct __attribute__((packed)) SettingsData {
     uint8_t magic;               // 0xBB to validate file
@@ -56,20 +51,25 @@ struct __attribute__((packed)) SettingsData {
     uint8_t profileId;           // 1-4 (built-in profile)
     uint8_t actuatorType;        // 0=LRA, 1=ERM
     uint16_t frequencyHz;        // 50-300
-    float timeOnMs;              // Burst duration
-    float timeOffMs;             // Inter-burst interval
-    float jitterPercent;         // 0-100
+    uint32_t timeOnUs;           // Burst duration (v1: float ms)
+    uint32_t timeOffUs;          // Inter-burst interval (v1: float ms)
+    uint32_t jitterQ16;          // jitter% / 100 in Q16 (v1: float percent)
     uint8_t amplitudeMin;        // 0-100
     uint8_t amplitudeMax;        // 0-100
     uint16_t sessionDurationMin; // Minutes
-    char patternType[16];        // "rndp", "sequential", "mirrored"
+    char patternType[PATTERN_TYPE_MAX];  // "rndp", "sequential", "mirrored"
     uint8_t mirrorPattern;       // 0 or 1
     uint8_t numFingers;          // 1-MAX_ACTUATORS
     uint8_t therapyLedOff;       // 0 = LED on (default), 1 = LED off during therapy
     uint8_t debugMode;           // 0 = off (default), 1 = debug mode enabled
-    uint8_t reserved[2];         // Future use, padding
+    uint16_t i2cBusKhz;          // Negotiated haptic I2C speed (0 = never negotiated)
+    uint8_t motorPresentMask;    // Last boot presence probe, bit f = finger f (0 = never probed)
 };
 
+// Shortest image still loaded: the layout before motorPresentMask was
+// appended. Fields past a shorter file read as zero.
+constexpr size_t SETTINGS_DATA_MIN_SIZE = offsetof(SettingsData, motorPresentMask);
+
 // =============================================================================
 // THERAPY PROFILE STRUCTURE
 // =============================================================================
@@ -81,19 +81,22 @@ struct __attribute__((packed)) SettingsData {
  * - Actuator settings (type, frequency)
  * - Timing parameters (on/off times, jitter)
  * - Session settings (duration, pattern)
+ *
+ * Only the active profile exists in RAM. Its strings point into the
+ * flash-resident built-in table (name, description, and one of the
+ * canonical pattern names), so a copy is a plain struct copy and PARAM_SET
+ * edits overlay the numeric fields only.
  */
 struct TherapyProfile {
-    char name[PROFILE_NAME_MAX];
-    char description[PROFILE_DESC_MAX];
+    const char* name;
+    const char* description;
 
     // Actuator settings
     ActuatorType actuatorType;
     uint16_t frequencyHz;
 
     // Timing parameters
-    float timeOnMs;
-    float timeOffMs;
-    float jitterPercent;
+    TherapyTiming timing;
 
     // Amplitude settings
     uint8_t amplitudeMin;
@@ -101,7 +104,7 @@ struct TherapyProfile {
 
     // Session settings
     uint16_t sessionDurationMin;  // Duration in minutes
-    char patternType[PATTERN_TYPE_MAX];
+    const char* patternType;      // "rndp", "sequential" or "mirrored" (flash)
     bool mirrorPattern;
     uint8_t numFingers;
 
@@ -116,75 +119,23 @@ struct TherapyProfile {
     /**
      * @brief Default constructor with noisy vCR defaults
      */
-    TherapyProfile() :
+    constexpr TherapyProfile() :
+        name("default"),
+        description("Default profile"),
         actuatorType(ActuatorType::LRA),
         frequencyHz(250),
-        timeOnMs(100.0f),
-        timeOffMs(67.0f),
-        jitterPercent(23.5f),
+        timing(TherapyTiming::fromMs(100.0f, 67.0f, 23.5f)),
         amplitudeMin(100),
         amplitudeMax(100),
         sessionDurationMin(120),  // 2 hours
+        patternType("rndp"),
         mirrorPattern(true),
         numFingers(MAX_ACTUATORS),
         isDefault(false),
         frequencyRandomization(false),
         frequencyMin(210),
         frequencyMax(260)
-    {
-        strcpy(name, "default");
-        strcpy(description, "Default profile");
-        strcpy(patternType, "rndp");
-    }
-
-    /**
-     * @brief Copy constructor
-     */
-    TherapyProfile(const TherapyProfile& other) {
-        strcpy(name, other.name);
-        strcpy(description, other.description);
-        strcpy(patternType, other.patternType);
-        actuatorType = other.actuatorType;
-        frequencyHz = other.frequencyHz;
-        timeOnMs = other.timeOnMs;
-        timeOffMs = other.timeOffMs;
-        jitterPercent = other.jitterPercent;
-        amplitudeMin = other.amplitudeMin;
-        amplitudeMax = other.amplitudeMax;
-        sessionDurationMin = other.sessionDurationMin;
-        mirrorPattern = other.mirrorPattern;
-        numFingers = other.numFingers;
-        isDefault = other.isDefault;
-        frequencyRandomization = other.frequencyRandomization;
-        frequencyMin = other.frequencyMin;
-        frequencyMax = other.frequencyMax;
-    }
-
-    /**
-     * @brief Assignment operator
-     */
-    TherapyProfile& operator=(const TherapyProfile& other) {
-        if (this != &other) {
-            strcpy(name, other.name);
-            strcpy(description, other.description);
-            strcpy(patternType, other.patternType);
-            actuatorType = other.actuatorType;
-            frequencyHz = other.frequencyHz;
-            timeOnMs = other.timeOnMs;
-            timeOffMs = other.timeOffMs;
-            jitterPercent = other.jitterPercent;
-            amplitudeMin = other.amplitudeMin;
-            amplitudeMax = other.amplitudeMax;
-            sessionDurationMin = other.sessionDurationMin;
-            mirrorPattern = other.mirrorPattern;
-            numFingers = other.numFingers;
-            isDefault = other.isDefault;
-            frequencyRandomization = other.frequencyRandomization;
-            frequencyMin = other.frequencyMin;
-            frequencyMax = other.frequencyMax;
-        }
-        return *this;
-    }
+    {}
 };
 
 // =============================================================================
@@ -206,7 +157,7 @@ struct TherapyProfile {
  *
  *   // List available profiles
  *   uint8_t count;
- *   const char** names = profiles.getProfileNames(&count);
+ *   const char* const* names = profiles.getProfileNames(&count);
  *
  *   // Load profile by ID
  *   profiles.loadProfile(1);
@@ -235,9 +186,9 @@ public:
     /**
      * @brief Get array of profile names
      * @param count Output parameter for number of profiles
-     * @return Array of profile name strings
+     * @return Array of profile name strings (flash-resident, never null)
      */
-    const char** getProfileNames(uint8_t* count);
+    const char* const* getProfileNames(uint8_t* count) const;
 
     /**
      * @brief Load profile by ID (1-based)
@@ -268,7 +219,7 @@ public:
     /**
      * @brief Get number of available profiles
      */
-    uint8_t getProfileCount() const { return _profileCount; }
+    uint8_t getProfileCount() const;
 
     /**
      * @brief Get ID of the currently loaded profile (1-based)
@@ -310,7 +261,11 @@ public:
     // =========================================================================
 
     /**
-     * @brief Save current profile settings to LittleFS
+     * @brief Save current profile settings to LittleFS now
+     *
+     * Appends only the fields that changed since the last save (see
+     * SettingsLog). Use for changes that must land before a reboot.
+     *
      * @return true if saved successfully
      */
     bool saveSettings();
@@ -321,6 +276,29 @@ public:
      */
     bool loadSettings();
 
+    /**
+     * @brief Mark settings changed; saveIfDue() writes them once quiet
+     *
+     * Any context (BLE callbacks included) - never touches flash. Each call
+     * restarts the SETTINGS_SAVE_DEBOUNCE_MS quiet period.
+     */
+    void requestSave();
+
+    /**
+     * @brief Write requested settings if the debounce has elapsed (loop() only)
+     * @return true if a save was attempted
+     */
+    bool saveIfDue();
+
+    /**
+     * @brief Delete every stored settings file (factory reset)
+     * @return true if anything was deleted
+     */
+    bool eraseSettings();
+
+    /** @brief A requested save has not been written yet */
+    bool hasPendingSave() const { return _saveRequested; }
+
     /**
      * @brief Check if LittleFS is available
      */
@@ -380,21 +358,46 @@ public:
      */
     void setDebugMode(bool debug) { _debugMode = debug; }
 
-private:
-    // Built-in profiles
-    TherapyProfile _builtInProfiles[MAX_PROFILES];
-    uint8_t _profileCount;
+    // =========================================================================
+    // HAPTIC BUS PROFILE
+    // =========================================================================
 
-    // Profile name pointers for getProfileNames()
-    const char* _profileNames[MAX_PROFILES];
+    /**
+     * @brief Get the haptic I2C speed recorded at the last negotiation
+     * @return Bus speed in kHz (0 if never negotiated)
+     */
+    uint16_t getI2CBusKhz() const { return _i2cBusKhz; }
 
-    // Current profile (working copy)
+    /**
+     * @brief Record the negotiated haptic I2C speed (persist with saveSettings)
+     * @param khz Bus speed in kHz
+     */
+    void setI2CBusKhz(uint16_t khz) { _i2cBusKhz = khz; }
+
+    /**
+     * @brief Get the motor presence mask recorded by the last boot probe
+     * @return Bit f set = motor on finger f (0 if never probed)
+     */
+    uint8_t getMotorPresentMask() const { return _motorPresentMask; }
+
+    /**
+     * @brief Record the boot probe's motor presence mask (persist with saveSettings)
+     * @param mask Bit f set = motor on finger f
+     */
+    void setMotorPresentMask(uint8_t mask) { _motorPresentMask = mask; }
+
+private:
+    // Current profile (built-in entry plus PARAM_SET edits; built-ins
+    // themselves stay in flash)
     TherapyProfile _currentProfile;
     uint8_t _currentProfileId;
     bool _profileLoaded;
 
     // Storage state
     bool _storageAvailable;
+    SettingsLog _settingsLog;
+    volatile bool _saveRequested;     // requestSave() since the last save
+    volatile uint32_t _saveRequestMs; // millis() of the latest requestSave()
 
     // Device role
     DeviceRole _deviceRole;
@@ -406,15 +409,20 @@ private:
     // Debug mode
     bool _debugMode;
 
-    /**
-     * @brief Initialize built-in profiles
-     */
-    void initBuiltInProfiles();
+    // Haptic bus profile
+    uint16_t _i2cBusKhz;
+    uint8_t _motorPresentMask;
 
     /**
      * @brief Validate parameter value
      */
     bool validateParameter(const char* paramName, const char* value);
+
+    /** @brief Snapshot the persisted fields */
+    void fillSettingsData(SettingsData& data) const;
+
+    /** @brief Apply a stored snapshot (validated) */
+    void applySettingsData(const SettingsData& data);
 };
 
 #endif // PROFILE_MANAGER_H
@@ -17,6 +17,9 @@
 
 #include <stdint.h>
 
+/** Notification distance configured in radioAnchorBegin(): anchor -> radio event */
+constexpr uint32_t RADIO_ANCHOR_DISTANCE_US = 800;
+
 /**
  * @brief Enable radio notifications and the SWI1 IRQ. Call after the
  *        SoftDevice is enabled (after ble.begin()).
@@ -36,4 +39,19 @@
  */
 [[nodiscard]] bool radioAnchorFindAfter(uint64_t timeUs, uint64_t maxAheadUs, uint64_t& anchorOut);
 
+/**
+ * @brief Predict the next anchor of a periodic link
+ *
+ * Uses the two newest anchors, which must be a whole number (1-4) of
+ * periodUs apart within SYNC_ANCHOR_PREDICT_TOLERANCE_US; anything else
+ * (phone link or advertising interleaved) leaves the phase unknown.
+ *
+ * @param timeUs Reference time (getMicros())
+ * @param periodUs Connection interval of the link
+ * @param nextOut First predicted anchor strictly after timeUs; the radio
+ *        event follows RADIO_ANCHOR_DISTANCE_US later
+ * @return true if the phase is known
+ */
+[[nodiscard]] bool radioAnchorPredictNext(uint64_t timeUs, uint32_t periodUs, uint64_t& nextOut);
+
 #endif // RADIO_ANCHOR_H
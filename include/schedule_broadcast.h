@@ -0,0 +1,130 @@
+/**
+ * @file schedule_broadcast.h
+ * @brief Macrocycle schedule over a BLE periodic advertising train
+ *
+ * With SYNC_PERIODIC_ADV_ENABLED the PRIMARY (ESP32-S3, BLE 5) runs a
+ * periodic advertising train and replaces its payload with every
+ * macrocycle. The controller transmits the train at fixed intervals from a
+ * start it chooses, so train event n happens at one physical instant that
+ * every synced listener timestamps alike - no connection-event wait and no
+ * link-layer retransmission in between.
+ *
+ * Payload (one manufacturer-specific AD structure):
+ *
+ *   [len][0xFF][0xFF 0xFF][B Z][ver][trainStartUs:8][intervalUs:4][V6 frame]
+ *
+ * trainStartUs is PRIMARY getMicros() when the train was started and the V6
+ * frame is the usual MC:<0x06> binary macrocycle with clockOffset = 0.
+ *
+ * The PRIMARY's controller does not report when it actually transmits, so
+ * the true train start lies a constant (unknown) time after trainStartUs.
+ * ScheduleAnchorTracker takes the earliest-arriving report over a short
+ * window (host latency only ever adds delay) as the train's local phase and
+ * calibrates that constant once per GATT macrocycle against the PTP
+ * clockOffset. The result is a local-vs-PRIMARY offset that follows the
+ * train rather than each macrocycle's delivery.
+ *
+ * ISO broadcast (BIS) would carry the same payload; the ESP32-S3 controller
+ * does not support it, so periodic advertising is the transport.
+ */
+
+#ifndef SCHEDULE_BROADCAST_H
+#define SCHEDULE_BROADCAST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+#include "types.h"
+
+/**
+ * @brief Train parameters carried in every broadcast
+ */
+struct ScheduleTrain {
+    uint64_t startUs;       // PRIMARY getMicros() at train start
+    uint32_t intervalUs;    // Train interval
+};
+
+/**
+ * @class ScheduleBroadcast
+ * @brief Periodic-advertising payload codec
+ */
+class ScheduleBroadcast {
+public:
+    static constexpr uint16_t COMPANY_ID = 0xFFFF;  // Bluetooth SIG "no company" (testing/internal)
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 2 + 2 + 2 + 1 + 8 + 4;
+
+    /**
+     * @brief Build the advertising payload for a macrocycle
+     * @param out Output buffer
+     * @param outSize Capacity (payloads over SYNC_PERIODIC_ADV_MAX_DATA fail)
+     * @param train Train parameters
+     * @param macrocycle Schedule (its clockOffset is not sent)
+     * @return Payload length, 0 if it does not fit
+     */
+    static size_t encode(uint8_t* out, size_t outSize, const ScheduleTrain& train,
+                         const Macrocycle& macrocycle);
+
+    /**
+     * @brief Parse a received payload
+     * @return false if it is not a schedule broadcast or is malformed
+     */
+    static bool decode(const uint8_t* data, size_t length, ScheduleTrain& train,
+                       Macrocycle& macrocycle);
+};
+
+/**
+ * @class ScheduleAnchorTracker
+ * @brief SECONDARY-side clock offset from the broadcast train
+ *
+ * Threading: all calls from the BLE host task (reports and GATT
+ * macrocycles are delivered there).
+ */
+class ScheduleAnchorTracker {
+public:
+    static constexpr uint8_t WINDOW = SYNC_PERIODIC_ADV_ANCHOR_WINDOW;
+
+    ScheduleAnchorTracker();
+
+    /** @brief Forget the train (sync lost, PRIMARY disconnected) */
+    void reset();
+
+    /**
+     * @brief Record one train report
+     *
+     * The event number is recovered by rounding with the PTP offset, so
+     * reports are ignored until onPtpOffset() has been called once.
+     *
+     * @param train Train parameters from the payload (a change restarts tracking)
+     * @param rxLocalUs Local getMicros() of the report
+     * @return true if the report was used
+     */
+    bool onReport(const ScheduleTrain& train, uint64_t rxLocalUs);
+
+    /**
+     * @brief Calibrate against the PTP offset of a GATT macrocycle
+     * @param ptpOffsetUs Macrocycle clockOffset (local - PRIMARY)
+     */
+    void onPtpOffset(int64_t ptpOffsetUs);
+
+    /** @brief Whether getOffset() may replace the PTP offset */
+    bool isLocked() const;
+
+    /** @brief Local minus PRIMARY time, in the sense of Macrocycle::clockOffset */
+    int64_t getOffset() const;
+
+private:
+    int64_t windowMin() const;
+
+    int64_t _phases[WINDOW];    // rxLocal - nominal PRIMARY event time
+    uint8_t _count;
+    uint8_t _next;
+    ScheduleTrain _train;
+    int64_t _refPhaseUs;        // First report's position within an interval
+    int64_t _ptpOffsetUs;
+    bool _ptpValid;
+    int64_t _biasUs;            // Train-start latency + report latency floor
+    uint8_t _biasSamples;
+};
+
+#endif // SCHEDULE_BROADCAST_H
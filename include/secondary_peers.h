@@ -0,0 +1,145 @@
+/**
+ * @file secondary_peers.h
+ * @brief PRIMARY-side state for SECONDARY peers beyond the first
+ *
+ * With BLE_MAX_SECONDARIES > 1 the PRIMARY accepts several SECONDARY links.
+ * The first one to identify keeps the full single-peer path in main.cpp
+ * (syncProtocol, ping scheduler, V7 template/delta/seeded pipeline). Each
+ * additional peer gets a SecondaryPeer: its own PING/PONG exchange and
+ * SimpleSyncProtocol offset estimate, and its own copy of every macrocycle.
+ *
+ * Macrocycles go to extra peers as full V6 frames. The events are identical
+ * for every peer; only clockOffset differs, so the frame is encoded once
+ * (MacrocycleFanoutFrame::prepare) and each peer's copy is produced by
+ * re-encoding just the 8 offset bytes (MacrocycleFanoutFrame::patch).
+ *
+ * Threading: add/remove/onPong run in the BLE callback context, as the
+ * main peer's PONG handler does. onPingStamped() runs wherever the TX queue
+ * drains (see onTxStamped() in main.cpp), so each peer's T1/seq pair is
+ * published under one critical section, like pingT1/pingSeq.
+ */
+
+#ifndef SECONDARY_PEERS_H
+#define SECONDARY_PEERS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+#include "sync_protocol.h"
+
+/**
+ * @brief One additional SECONDARY link
+ */
+struct SecondaryPeer {
+    uint16_t connHandle;            // 0xFFFF when the slot is free
+    SimpleSyncProtocol sync;        // Per-peer offset/RTT estimate
+    volatile uint64_t pingT1;       // TX stamp of the in-flight PING (0 = none)
+    volatile uint32_t pingSeq;      // Sequence of the in-flight PING
+    uint32_t lastPongMs;            // millis() of the last PONG (keepalive)
+    uint8_t mcWireVersion;          // Newest MACROCYCLE format the peer decodes
+    bool retiring;                  // Main SECONDARY lost: link is being dropped
+};
+
+/**
+ * @class SecondaryPeerSet
+ * @brief Fixed table of additional SECONDARY peers
+ */
+class SecondaryPeerSet {
+public:
+    static constexpr uint16_t HANDLE_NONE = 0xFFFF;
+    static constexpr uint8_t CAPACITY = (BLE_MAX_SECONDARIES > 1) ? (BLE_MAX_SECONDARIES - 1) : 1;
+
+    SecondaryPeerSet();
+
+    /**
+     * @brief Start tracking a newly identified peer (fresh sync state)
+     * @return The peer, or nullptr if the table is full
+     */
+    SecondaryPeer* add(uint16_t connHandle, uint32_t nowMs);
+
+    /** @brief Stop tracking a peer; false if it was not tracked */
+    bool remove(uint16_t connHandle);
+
+    /** @brief Tracked peer for a handle, or nullptr */
+    SecondaryPeer* find(uint16_t connHandle);
+
+    /** @brief Number of tracked peers */
+    uint8_t count() const { return _count; }
+
+    /** @brief Peer by index (0..count()-1) */
+    SecondaryPeer& at(uint8_t index) { return _peers[index]; }
+
+    /** @brief Forget every peer */
+    void clear();
+
+    /**
+     * @brief Mark every peer as being dropped (main SECONDARY lost)
+     *
+     * Retiring peers stay tracked until their own disconnect arrives, so
+     * it is not mistaken for the main SECONDARY's, but get no PINGs or
+     * macrocycles. All peers re-identify on reconnect; the first becomes
+     * the main SECONDARY again.
+     */
+    void retireAll();
+
+    /** @brief Arm a PING exchange: call before queueing the PING */
+    void beginPing(SecondaryPeer& peer, uint32_t seqId);
+
+    /**
+     * @brief Record the TX stamp of a PING sent to an extra peer
+     * @return true if seqId belonged to one of the extra peers
+     */
+    bool onPingStamped(uint32_t seqId, uint64_t txTimeUs);
+
+    /**
+     * @brief Fold a PONG into the peer's offset estimate
+     *
+     * RTT and offset follow the main peer's PTP path: RTT = (T4-T1)-(T3-T2),
+     * then the quality-gated EMA. A PONG whose sequence does not match the
+     * in-flight PING only refreshes the keepalive.
+     *
+     * @return true if the sample was accepted by the quality gates
+     */
+    bool onPong(SecondaryPeer& peer, uint32_t seqId, uint64_t t2, uint64_t t3,
+                uint64_t t4, uint32_t nowMs);
+
+    /**
+     * @brief Largest adaptive lead time over the synced extra peers
+     * @param floorUs Lead time already required by the main peer
+     */
+    uint32_t maxLeadTimeUs(uint32_t floorUs) const;
+
+private:
+    SecondaryPeer _peers[CAPACITY];
+    uint8_t _count;
+};
+
+/**
+ * @class MacrocycleFanoutFrame
+ * @brief One V6 macrocycle encoding, re-emitted per peer offset
+ */
+class MacrocycleFanoutFrame {
+public:
+    MacrocycleFanoutFrame() : _length(0), _offsetPos(0), _offsetLen(0) {}
+
+    /** @brief Encode the macrocycle once; false if it does not fit */
+    bool prepare(const Macrocycle& macrocycle);
+
+    /**
+     * @brief Write the prepared frame with clockOffset replaced
+     * @return Bytes written, NUL excluded (0 if unprepared or out too small)
+     */
+    size_t patch(int64_t clockOffset, char* out, size_t outSize) const;
+
+private:
+    char _frame[MESSAGE_BUFFER_SIZE];
+    size_t _length;
+    size_t _offsetPos;
+    size_t _offsetLen;
+};
+
+#if BLE_MAX_SECONDARIES > 1
+extern SecondaryPeerSet extraPeers;
+#endif
+
+#endif // SECONDARY_PEERS_H
@@ -0,0 +1,194 @@
+/**
+ * @file session_journal.h
+ * @brief On-device binary record of what happened during therapy sessions
+ *
+ * Producers in any context (motor task, BLE task, loop) append fixed
+ * 16-byte records to the active RAM page under a short critical section -
+ * never a flash access, never a wait. A full page is handed to the other
+ * buffer slot and loop() writes it (flushPending()) only while the motor
+ * task has a gap, so flash programming never delays an activation. If the
+ * previous page is still waiting when the active one fills, records are
+ * dropped and counted rather than blocking.
+ *
+ * On flash the log is a ring of SESSION_JOURNAL_SEGMENTS segment files of
+ * SESSION_JOURNAL_SEGMENT_PAGES pages each. Pages are appended (LittleFS
+ * rewrites everything after a mid-file write, so a single preallocated file
+ * overwritten in place would copy the whole tail on every flush); the
+ * oldest segment is removed when the ring wraps. Every page starts with a
+ * header carrying a sequence number that keeps increasing across boots, so
+ * begin() resumes after the newest page and readers can order pages.
+ *
+ * The phone downloads the PRIMARY's log with JOURNAL_GET:<chunk>, oldest
+ * chunk first: chunk i is bytes [i * CHUNK, (i + 1) * CHUNK) of the valid
+ * pages concatenated in sequence order. Each glove keeps its own log.
+ */
+
+#ifndef SESSION_JOURNAL_H
+#define SESSION_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+#define SESSION_JOURNAL_MAGIC 0x5A
+#define SESSION_JOURNAL_VERSION 1
+
+// =============================================================================
+// RECORDS
+// =============================================================================
+
+/**
+ * @brief Record kinds and their fields
+ *
+ * Wire values: append only, never renumber.
+ */
+enum class JournalRecordType : uint8_t {
+    NONE = 0,
+    SESSION_START,  // arg profile id, a duration (s), b session id
+    SESSION_END,    // a cycles completed, b total activations
+    MACROCYCLE,     // aux event count, a sequence id, b clock offset (us, saturated)
+    EVENT,          // arg finger, aux amplitude, a scheduled (us, low 32 bits), b executed - scheduled (us)
+    SYNC,           // aux 1 if the sample was accepted, a offset sample (us, saturated), b RTT (us)
+    BATTERY,        // arg percent, a millivolts
+    HEAL            // arg DRV2605 chips reconfigured after a reset
+};
+
+/**
+ * @brief One record (packed, little-endian on both targets)
+ */
+struct __attribute__((packed)) JournalRecord {
+    uint8_t type;      // JournalRecordType
+    uint8_t arg;
+    uint16_t aux;
+    uint32_t timeMs;   // millis() when recorded
+    int32_t a;
+    int32_t b;
+};
+
+/**
+ * @brief Header at the start of every page
+ */
+struct __attribute__((packed)) JournalPageHeader {
+    uint8_t magic;
+    uint8_t version;
+    uint8_t count;       // Valid records in this page
+    uint8_t recordSize;  // sizeof(JournalRecord)
+    uint32_t sequence;   // Page sequence, increasing across boots
+    uint32_t sessionId;  // Session the page's first record belongs to (0 = none)
+    uint32_t dropped;    // Records dropped (pages busy) since boot, at write time
+};
+
+constexpr size_t SESSION_JOURNAL_RECORDS_PER_PAGE =
+    (SESSION_JOURNAL_PAGE_BYTES - sizeof(JournalPageHeader)) / sizeof(JournalRecord);
+
+/**
+ * @brief One page as written to flash
+ */
+struct __attribute__((packed)) JournalPage {
+    JournalPageHeader header;
+    JournalRecord records[SESSION_JOURNAL_RECORDS_PER_PAGE];
+};
+
+static_assert(sizeof(JournalRecord) == 16, "JournalRecord is a 16-byte wire record");
+static_assert(sizeof(JournalPage) == SESSION_JOURNAL_PAGE_BYTES,
+              "SESSION_JOURNAL_PAGE_BYTES must be the header plus whole records");
+static_assert(SESSION_JOURNAL_PAGE_BYTES % SESSION_JOURNAL_CHUNK_BYTES == 0,
+              "JOURNAL_GET chunks must not straddle pages");
+
+// =============================================================================
+// SESSION JOURNAL
+// =============================================================================
+
+/**
+ * @class SessionJournal
+ * @brief Double-buffered record pages over a ring of segment files
+ */
+class SessionJournal {
+public:
+    SessionJournal();
+
+    /**
+     * @brief Find the newest page on flash and continue after it (setup())
+     * @return false if the filesystem is unavailable (records stay in RAM
+     *         and are discarded)
+     */
+    bool begin();
+
+    /**
+     * @brief Open a session: later records land in the log
+     *
+     * Any context (state-machine callback). Records outside a session are
+     * ignored.
+     */
+    void startSession(uint8_t profileId, uint32_t durationSec);
+
+    /**
+     * @brief Close the session; its partial page is written by the next
+     *        flushPending()
+     */
+    void endSession(uint32_t cyclesCompleted, uint32_t totalActivations);
+
+    /** @brief A session is open */
+    bool isRecording() const { return _recording; }
+
+    /**
+     * @brief Append a record to the active page (any context, never blocks)
+     *
+     * No-op outside a session. Dropped (and counted) if both pages are full.
+     */
+    void record(JournalRecordType type, uint8_t arg, uint16_t aux, int32_t a, int32_t b);
+
+    /** @brief A page is waiting for flushPending() */
+    bool hasPendingPage() const { return _pendingPage >= 0 || (_sealRequested && _fill > 0); }
+
+    /**
+     * @brief Write the waiting page, if any (loop() only, in a motor gap)
+     * @return true if a page was written
+     */
+    bool flushPending();
+
+    /** @brief JOURNAL_GET chunks available (written pages only) */
+    uint32_t chunkCount() const;
+
+    /**
+     * @brief Copy one chunk, oldest first
+     * @param out At least SESSION_JOURNAL_CHUNK_BYTES
+     * @return false if index is out of range or its page is unreadable
+     */
+    bool readChunk(uint32_t index, uint8_t* out, size_t& length) const;
+
+    /** @brief Records dropped because both pages were busy (since boot) */
+    uint32_t droppedRecords() const { return _dropped; }
+
+    /** @brief Page writes that failed (since boot) */
+    uint32_t writeErrors() const { return _writeErrors; }
+
+    /** @brief Session id of the current / last session (0 = none yet) */
+    uint32_t sessionId() const { return _sessionId; }
+
+private:
+    void sealActivePage();
+    bool writePage(JournalPage& page);
+    bool readPageHeader(uint32_t sequence, JournalPageHeader& header) const;
+    static void segmentPath(uint32_t sequence, char* out, size_t size);
+
+    JournalPage _pages[2];
+    uint8_t _activePage;              // Page records go into
+    volatile int8_t _pendingPage;     // Sealed page waiting for flash (-1 = none)
+    volatile uint8_t _fill;           // Records in the active page
+    volatile bool _recording;
+    volatile bool _sealRequested;     // endSession(): write the partial page
+
+    bool _storageReady;
+    uint32_t _nextSequence;           // Sequence of the next page written
+    uint32_t _firstSequence;          // Oldest page still in the ring
+    uint32_t _sessionId;
+    uint32_t _dropped;
+    uint32_t _writeErrors;
+};
+
+#if SESSION_JOURNAL_ENABLED
+extern SessionJournal sessionJournal;
+#endif
+
+#endif // SESSION_JOURNAL_H
@@ -0,0 +1,110 @@
+/**
+ * @file settings_log.h
+ * @brief Append-only settings store with occasional compaction
+ *
+ * Rewriting the whole packed settings file on every change cost a full
+ * file write (and on LittleFS a fresh block) for a one-byte LED or debug
+ * toggle. SettingsLog keeps a RAM copy of what flash holds and save()
+ * appends only the byte ranges that changed, as small self-checking
+ * records:
+ *
+ *   offset u8, length u8, bytes[length], check u8 (CRC-8 of the rest)
+ *
+ * The key of a record is its offset into the packed image, so any field of
+ * the caller's struct is a key and its bytes the value. A record that does
+ * not check ends the replay (a torn append): everything before it stands
+ * and the next save() compacts.
+ *
+ * A log holding a shorter image than the caller's (written before fields
+ * were appended) still loads when it is at least minSize: the appended
+ * fields read as zero and the log is rewritten at the new size at once.
+ *
+ * When the log would outgrow SETTINGS_LOG_MAX_BYTES, save() compacts: the
+ * whole image is written as one record to the other of two files under a
+ * newer generation, and only then is the old file removed. A compaction
+ * torn mid-write leaves the previous file intact, so there is always a
+ * complete image to load.
+ *
+ * Pure C++ over fsb (no Arduino dependencies) so it builds in native test
+ * envs. Flash is touched only by load() and save(), from the main loop.
+ */
+
+#ifndef SETTINGS_LOG_H
+#define SETTINGS_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+#define SETTINGS_LOG_FILE_A "/settings_a.log"
+#define SETTINGS_LOG_FILE_B "/settings_b.log"
+#define SETTINGS_LOG_MAGIC 0xBD
+#define SETTINGS_LOG_VERSION 1
+
+constexpr size_t SETTINGS_LOG_MAX_IMAGE = 64;      // Largest image (record offsets are one byte)
+constexpr size_t SETTINGS_LOG_RECORD_OVERHEAD = 3;  // offset, length, check
+
+/**
+ * @brief File header (packed, stored as-is)
+ */
+struct __attribute__((packed)) SettingsLogHeader {
+    uint8_t magic;
+    uint8_t version;
+    uint8_t imageSize;     // Image the records patch (a larger one is a different format)
+    uint8_t reserved;
+    uint32_t generation;   // Bumped by every compaction; the newer file wins
+};
+
+/**
+ * @class SettingsLog
+ * @brief Persists a small packed image as a log of changed byte ranges
+ */
+class SettingsLog {
+public:
+    SettingsLog();
+
+    /**
+     * @brief Replay the newest valid log into image
+     * @param image Receives the stored image (left untouched if none)
+     * @param size Image size (at most SETTINGS_LOG_MAX_IMAGE)
+     * @param minSize Shortest stored image accepted (0 = size only); bytes
+     *        past a shorter one are zeroed
+     * @return true if a stored image was found
+     */
+    bool load(uint8_t* image, size_t size, size_t minSize = 0);
+
+    /**
+     * @brief Persist image: append what changed, or compact
+     * @return true if flash now holds image (nothing to write counts)
+     */
+    bool save(const uint8_t* image, size_t size);
+
+    /**
+     * @brief Remove both log files and forget the stored image
+     * @return true if a file was removed
+     */
+    bool erase();
+
+    /** @brief Bytes in the active log file (0 = none yet) */
+    size_t logBytes() const { return _logBytes; }
+
+    /** @brief Generation of the active log file */
+    uint32_t generation() const { return _generation; }
+
+private:
+    bool compact(const uint8_t* image, size_t size);
+    bool replay(const char* path, size_t size, size_t minSize, uint8_t* image,
+                uint32_t& generation, size_t& length, size_t& imageSize, bool& torn) const;
+    static size_t putRecord(uint8_t* out, uint8_t offset, const uint8_t* bytes, uint8_t length);
+    static uint8_t crc8(const uint8_t* data, size_t length);
+
+    uint8_t _persisted[SETTINGS_LOG_MAX_IMAGE];  // What flash holds
+    size_t _size;
+    bool _hasImage;            // _persisted mirrors a complete file
+    bool _needsCompaction;     // Torn tail or failed append: next save() rewrites
+    uint8_t _active;           // 0 = SETTINGS_LOG_FILE_A, 1 = SETTINGS_LOG_FILE_B
+    uint32_t _generation;
+    size_t _logBytes;
+};
+
+#endif // SETTINGS_LOG_H
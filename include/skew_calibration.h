@@ -0,0 +1,108 @@
+/**
+ * @file skew_calibration.h
+ * @brief Per-peer clock-skew calibration persisted across reboots
+ *
+ * The relative skew of two gloves' crystals is a property of the pair (and
+ * their temperature), not of the connection, yet every cold boot re-learned
+ * it from zero over several drift windows. PRIMARY saves the converged skew
+ * keyed by the SECONDARY's BLE address and seeds SimpleSyncProtocol with it
+ * on the next connect.
+ *
+ * Each entry carries the die temperature and the boot generation it was
+ * saved in. lookup() drops entries that are too old or were measured too
+ * far from the current temperature, and widens the seed uncertainty with
+ * the temperature difference.
+ *
+ * Stored as one packed file through fsb (SKEW_CAL_FILE); flash is written
+ * only by save(), from the main loop.
+ */
+
+#ifndef SKEW_CALIBRATION_H
+#define SKEW_CALIBRATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+#define SKEW_CAL_FILE "/skewcal.bin"
+#define SKEW_CAL_MAGIC 0x5C
+#define SKEW_CAL_VERSION 1
+
+constexpr size_t SKEW_CAL_ADDR_LEN = 6;
+constexpr int16_t SKEW_CAL_NO_TEMPERATURE = INT16_MIN;  // Die temperature unavailable
+
+/**
+ * @brief One peer's calibration (packed, stored as-is)
+ */
+struct __attribute__((packed)) SkewCalEntry {
+    uint8_t addr[SKEW_CAL_ADDR_LEN];
+    uint16_t generation;      // Boot generation of the last save
+    int16_t temperatureQ;     // Die temperature, 0.25 C units (SKEW_CAL_NO_TEMPERATURE = unknown)
+    float skewUsPerMs;
+    float sigmaUsPerMs;       // Uncertainty of skewUsPerMs when saved
+};
+
+/**
+ * @brief On-flash layout
+ */
+struct __attribute__((packed)) SkewCalFile {
+    uint8_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint8_t reserved;
+    uint16_t generation;      // Advanced on load, persisted by save(): counts boots that saved
+    SkewCalEntry entries[SYNC_SKEW_CAL_MAX_PEERS];  // Most recently used first
+};
+
+/**
+ * @class SkewCalibrationStore
+ * @brief In-RAM copy of the calibration file
+ */
+class SkewCalibrationStore {
+public:
+    SkewCalibrationStore();
+
+    /**
+     * @brief Read the file and start a new boot generation
+     * @return true if a valid file was read (false = start empty)
+     */
+    bool load();
+
+    /**
+     * @brief Write the file if record() changed it
+     * @return true if written (or nothing to write)
+     */
+    bool save();
+
+    /**
+     * @brief Find a usable calibration for a peer
+     * @param addr Peer BLE address
+     * @param temperatureQ Current die temperature (0.25 C units)
+     * @param skewOut Saved skew (us/ms)
+     * @param sigmaOut Seed uncertainty: saved sigma, floored at
+     *        SYNC_SKEW_CAL_SIGMA_US_PER_MS, plus the temperature term
+     * @return false if unknown, older than SYNC_SKEW_CAL_MAX_AGE_BOOTS or
+     *         more than SYNC_SKEW_CAL_MAX_TEMP_DELTA_C away
+     */
+    bool lookup(const uint8_t* addr, int16_t temperatureQ, float& skewOut, float& sigmaOut) const;
+
+    /**
+     * @brief Store a peer's converged skew (moves it to the front)
+     */
+    void record(const uint8_t* addr, float skewUsPerMs, float sigmaUsPerMs, int16_t temperatureQ);
+
+    /** @brief Forget every peer (next save() writes an empty file) */
+    void clear();
+
+    uint8_t count() const { return _file.count; }
+    uint16_t generation() const { return _file.generation; }
+    bool isDirty() const { return _dirty; }
+
+private:
+    int findEntry(const uint8_t* addr) const;
+
+    SkewCalFile _file;
+    bool _dirty;
+};
+
+#endif // SKEW_CALIBRATION_H
@@ -0,0 +1,127 @@
+/**
+ * @file skew_capture.h
+ * @brief On-glove bilateral skew measurement from the PRIMARY's debug pulse
+ *
+ * SYNC_DEBUG_GPIO toggles a pin on every motor ACTIVATE. Wiring the
+ * PRIMARY's SYNC_DEBUG_GPIO_PIN (plus ground) to the SECONDARY's
+ * SYNC_SKEW_CAPTURE_PIN lets the SECONDARY measure true skew itself, with
+ * no logic analyzer: each PRIMARY edge is timestamped by a hardware capture
+ * on the getMicros() timebase (nRF52: GPIOTE -> PPI -> TIMER4 CAPTURE;
+ * ESP32-S3: MCPWM capture, referenced to esp_timer), each local activation
+ * is timestamped where it toggles its own pin, and the two streams are
+ * paired in order.
+ *
+ * Skew is SECONDARY - PRIMARY in microseconds: positive means the
+ * SECONDARY fired late. Paired samples go to latencyMetrics.recordSkew()
+ * and the SKEW telemetry kind.
+ *
+ * Pairing is FIFO: the oldest local and remote edges are matched when they
+ * lie within SYNC_SKEW_CAPTURE_WINDOW_US of each other; otherwise the older
+ * one has no partner and is discarded (a missed pulse, a dropped MACROCYCLE
+ * or a loose wire). Unpaired edges older than the window expire.
+ *
+ * Threading: onRemoteEdge() runs in the capture ISR (single producer of the
+ * remote ring); onLocalEdge() and process() run in the motor task.
+ */
+
+#ifndef SKEW_CAPTURE_H
+#define SKEW_CAPTURE_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @brief Pairing counters (totals since begin()/reset())
+ */
+struct SkewCaptureStats {
+    uint32_t paired;
+    uint32_t unmatchedLocal;    // Local activations with no PRIMARY edge in the window
+    uint32_t unmatchedRemote;   // PRIMARY edges with no local activation in the window
+    uint32_t dropped;           // Edges lost to a full ring
+};
+
+/**
+ * @class SkewEdgeRing
+ * @brief Lock-free SPSC ring of edge timestamps
+ */
+class SkewEdgeRing {
+public:
+    static constexpr uint8_t SIZE = SYNC_SKEW_CAPTURE_RING_SIZE;  // Power of two
+
+    SkewEdgeRing();
+
+    /** @brief Stage a timestamp (producer only); false if full */
+    bool push(uint64_t timestampUs);
+
+    /** @brief Oldest timestamp without removing it (consumer only) */
+    bool peek(uint64_t& timestampUs) const;
+
+    /** @brief Remove the oldest timestamp (consumer only) */
+    void pop();
+
+    /** @brief Discard staged timestamps (consumer only) */
+    void clear();
+
+private:
+    static_assert((SIZE & (SIZE - 1)) == 0, "SYNC_SKEW_CAPTURE_RING_SIZE must be a power of two");
+
+    uint64_t _buffer[SIZE];
+    volatile uint8_t _head;
+    volatile uint8_t _tail;
+};
+
+/**
+ * @class SkewCapture
+ * @brief Pairs captured PRIMARY edges with local activations
+ */
+class SkewCapture {
+public:
+    SkewCapture();
+
+    /**
+     * @brief Configure the input capture on SYNC_SKEW_CAPTURE_PIN (SECONDARY only)
+     *
+     * Needs the hardware timebase (call after hiresClockBegin()).
+     *
+     * @return true if edges will be captured; false on native builds or when
+     *         the capture hardware is unavailable
+     */
+    bool begin();
+
+    /** @brief Whether begin() succeeded */
+    bool isActive() const { return _active; }
+
+    /** @brief Record a captured PRIMARY edge (capture ISR) */
+    void onRemoteEdge(uint64_t timestampUs);
+
+    /** @brief Record a local activation (motor task, at the debug-pin toggle) */
+    void onLocalEdge(uint64_t timestampUs);
+
+    /**
+     * @brief Pair staged edges and expire stale ones (motor task)
+     * @param nowUs Current getMicros()
+     * @param skews Output: paired skews, SECONDARY - PRIMARY (us)
+     * @param maxSkews Capacity of skews
+     * @return Number of skews written (call again if it equals maxSkews)
+     */
+    uint8_t process(uint64_t nowUs, int32_t* skews, uint8_t maxSkews);
+
+    /** @brief Pairing counters */
+    SkewCaptureStats getStats() const;
+
+    /** @brief Drop staged edges and zero the counters (motor task) */
+    void reset();
+
+private:
+    SkewEdgeRing _remote;
+    SkewEdgeRing _local;
+    SkewCaptureStats _stats;
+    volatile uint32_t _remoteDropped;   // Written by the ISR only
+    bool _active;
+};
+
+#if SYNC_SKEW_CAPTURE_ENABLED
+extern SkewCapture skewCapture;
+#endif
+
+#endif // SKEW_CAPTURE_H
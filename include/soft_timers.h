@@ -0,0 +1,107 @@
+/**
+ * @file soft_timers.h
+ * @brief Fixed-capacity software timers on millis()
+ *
+ * Replaces the `now - lastX >= INTERVAL` checks loop() ran on every pass.
+ * Timers are registered once (setup) with a callback, then armed as
+ * one-shot or periodic. Armed timers sit in a list sorted by due time, so
+ * the next deadline (for loop()'s wake wait) is the list head: O(1), and a
+ * pass with nothing due costs one comparison. Arming (and re-arming a
+ * periodic timer) walks the list: O(capacity).
+ *
+ * Not internally locked. When timers are armed from other tasks (BLE
+ * callbacks), wrap start()/stop()/popExpired() in a critical section and run
+ * the callbacks outside it (see main.cpp serviceLoopTimers()).
+ *
+ * All times wrap like millis(); delays must stay below 2^31 ms.
+ *
+ * Pure C++ (no Arduino dependencies) so it builds in native test envs.
+ */
+
+#ifndef SOFT_TIMERS_H
+#define SOFT_TIMERS_H
+
+#include <stdint.h>
+
+typedef uint8_t SoftTimerId;
+typedef void (*SoftTimerCallback)();
+
+constexpr SoftTimerId SOFT_TIMER_NONE = 0xFF;
+
+/**
+ * @class SoftTimers
+ * @brief Sorted list of armed millis() deadlines
+ */
+class SoftTimers {
+public:
+    static constexpr uint8_t CAPACITY = 12;
+
+    SoftTimers();
+
+    /**
+     * @brief Register a timer (stopped)
+     * @return Its id, or SOFT_TIMER_NONE when all CAPACITY slots are taken
+     */
+    SoftTimerId add(SoftTimerCallback fn);
+
+    /**
+     * @brief Arm (or re-arm) a timer
+     * @param id From add()
+     * @param nowMs millis()
+     * @param delayMs First expiry after nowMs
+     * @param periodMs Re-arm interval after each expiry (0 = one-shot)
+     */
+    void start(SoftTimerId id, uint32_t nowMs, uint32_t delayMs, uint32_t periodMs = 0);
+
+    /** @brief Disarm a timer (no-op if not armed) */
+    void stop(SoftTimerId id);
+
+    bool isActive(SoftTimerId id) const;
+
+    /**
+     * @brief Earliest armed deadline
+     * @param dueMs Set to its millis() when a timer is armed
+     * @return false if no timer is armed
+     */
+    bool nextDue(uint32_t& dueMs) const;
+
+    /**
+     * @brief Take the earliest expired timer
+     *
+     * Periodic timers are re-armed one period after their due time (or one
+     * period after nowMs if more than a whole period late: no catch-up
+     * bursts); one-shots are disarmed.
+     *
+     * @return Its id, SOFT_TIMER_NONE if nothing is due at nowMs
+     */
+    SoftTimerId popExpired(uint32_t nowMs);
+
+    /** @brief Callback registered for id (nullptr if invalid) */
+    SoftTimerCallback callback(SoftTimerId id) const;
+
+    /**
+     * @brief Pop and run every expired timer (single-context use)
+     * @return Number of callbacks run
+     */
+    uint8_t advance(uint32_t nowMs);
+
+    uint8_t count() const { return _count; }
+
+private:
+    struct Slot {
+        SoftTimerCallback callback;
+        uint32_t dueMs;
+        uint32_t periodMs;
+        uint8_t next;       // Index of the next-later armed timer
+        bool active;
+    };
+
+    void link(SoftTimerId id);
+    void unlink(SoftTimerId id);
+
+    Slot _slots[CAPACITY];
+    uint8_t _head;          // Earliest armed timer (SOFT_TIMER_NONE = none)
+    uint8_t _count;         // Registered slots
+};
+
+#endif // SOFT_TIMERS_H
@@ -0,0 +1,116 @@
+/**
+ * @file status_snapshot.h
+ * @brief Consistent device status for readers on any task, without locks
+ *
+ * INFO, BATTERY, SESSION_STATUS and the PRIMARY's GET_BATTERY arrive on the
+ * BLE task (the NimBLE host task on ESP32). Reading TherapyEngine,
+ * TherapyStateMachine, SimpleSyncProtocol and BatteryMonitor directly from
+ * there gives no consistency across fields (a 64-bit clock offset can tear
+ * on a 32-bit core), and BatteryMonitor::readVoltage() may block on the ADC.
+ * Instead loop() gathers one StatusSnapshot per pass and publish()es it;
+ * readers copy the latest one with read().
+ *
+ * The store is a seqlock over two slots: publish() fills the slot readers
+ * are not using, then bumps the sequence. A reader copies the slot the
+ * sequence points at and retries only if a whole publish() completed during
+ * its copy. A writer preempted mid-publish never stalls a reader (it is
+ * writing the other slot), so reads finish in a bounded number of copies even
+ * when a higher-priority task reads on the writer's core, and neither side
+ * ever waits on the other.
+ *
+ * Single writer (loop()). Pure C++ so it builds in native test envs.
+ */
+
+#ifndef STATUS_SNAPSHOT_H
+#define STATUS_SNAPSHOT_H
+
+#include <stdint.h>
+#include <atomic>
+#include "types.h"
+
+/**
+ * @brief Status fields published by loop() once per pass
+ */
+struct StatusSnapshot {
+    uint32_t publishedMs;           // millis() at publish
+
+    // TherapyStateMachine
+    TherapyState state;
+
+    // TherapyEngine
+    bool therapyRunning;
+    uint32_t elapsedSeconds;
+    uint32_t durationSeconds;
+    uint32_t cyclesCompleted;
+
+    // BatteryMonitor (last periodic reading, never read on demand)
+    BatteryStatus battery;
+
+    // SimpleSyncProtocol
+    bool clockSyncValid;
+    int64_t clockOffsetUs;          // Corrected offset
+    uint32_t offsetUncertaintyUs;
+    uint32_t rttUs;                 // Smoothed RTT
+
+    // BLEManager
+    bool secondaryConnected;
+    bool phoneConnected;
+
+    StatusSnapshot() :
+        publishedMs(0), state(TherapyState::IDLE), therapyRunning(false),
+        elapsedSeconds(0), durationSeconds(0), cyclesCompleted(0),
+        clockSyncValid(false), clockOffsetUs(0), offsetUncertaintyUs(0), rttUs(0),
+        secondaryConnected(false), phoneConnected(false) {}
+
+    /**
+     * @brief Phone-facing STATUS value (RUNNING, PAUSED, READY, else IDLE)
+     */
+    const char* phoneStatusString() const {
+        switch (state) {
+            case TherapyState::RUNNING: return "RUNNING";
+            case TherapyState::PAUSED: return "PAUSED";
+            case TherapyState::READY: return "READY";
+            default: return "IDLE";
+        }
+    }
+};
+
+/**
+ * @class StatusSeqlock
+ * @brief Two-slot seqlock holding the latest StatusSnapshot
+ */
+class StatusSeqlock {
+public:
+    /** Copies attempted before read() gives up (a publish per copy) */
+    static constexpr uint8_t READ_ATTEMPTS = 4;
+
+    StatusSeqlock();
+
+    /**
+     * @brief Publish a new snapshot (single writer: loop())
+     */
+    void publish(const StatusSnapshot& snapshot);
+
+    /**
+     * @brief Copy the latest snapshot (any task, never blocks)
+     * @return false before the first publish(), or if READ_ATTEMPTS publishes
+     *         each overlapped a copy (out is then unchanged)
+     */
+    bool read(StatusSnapshot& out) const;
+
+    /** @brief Snapshots published so far */
+    uint32_t publishCount() const { return _sequence.load(std::memory_order_relaxed); }
+
+    /** @brief Copies discarded because a publish overlapped them */
+    uint32_t readRetries() const { return _retries.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> _sequence;    // Publishes; slot (sequence & 1) is current
+    mutable std::atomic<uint32_t> _retries;
+    StatusSnapshot _slots[2];
+};
+
+// Global instance
+extern StatusSeqlock statusSnapshot;
+
+#endif // STATUS_SNAPSHOT_H
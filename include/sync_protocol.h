@@ -19,6 +19,7 @@
 #include <Arduino.h>
 #include "config.h"
 #include "types.h"
+#include "clock_servo.h"
 
 // =============================================================================
 // PROTOCOL CONSTANTS
@@ -292,42 +293,187 @@ public:
      */
     static SyncCommand createMacrocycleAck(uint32_t sequenceId);
 
+    /**
+     * @brief Create MACROCYCLE_ACK response carrying the SECONDARY's slack
+     * @param sequenceId Sequence ID (should match received MACROCYCLE)
+     * @param slackUs First event time minus staging-complete time (SECONDARY
+     *        clock, negative when already late). Field 0; older PRIMARYs
+     *        ignore it.
+     */
+    static SyncCommand createMacrocycleAck(uint32_t sequenceId, int32_t slackUs);
+
     // =========================================================================
     // MACROCYCLE SERIALIZATION (hybrid text header + binary payload)
     // =========================================================================
 
     /**
-     * @brief Serialize a macrocycle to an all-text message
+     * @brief Serialize a macrocycle in the requested wire format
      *
-     * Format: MC:seq|baseHigh|baseLow|offHigh|offLow|dur|count|d,f,a[,fo]|...
+     * V5 (text): MC:seq|baseHigh|baseLow|offHigh|offLow|dur|count|d,f,a[,fo]|...
      * Worst case ~65-byte header + 16 bytes per event; MESSAGE_BUFFER_SIZE is
      * sized for MACROCYCLE_MAX_EVENTS events.
      *
+     * V6 (binary): "MC:" + 0x06 + escaped body. Body is little-endian
+     * seq(u32) baseTime(u64) clockOffset(i64) dur(u16) count(u8), then per
+     * event delta(u16) finger(u8) amplitude(u8) freqOffset(u8). Bytes are
+     * XOR-whitened with 0x80 and NUL/EOT/CR/ESC are escaped, so the frame
+     * survives the EOT-framed C-string transport. 87 bytes for a 4-motor
+     * macrocycle (one BLE_CHUNK_SIZE notification) vs ~200 for V5.
+     *
      * @param buffer Output buffer (use MESSAGE_BUFFER_SIZE)
      * @param bufferSize Size of output buffer
      * @param macrocycle Macrocycle to serialize
+     * @param wireVersion MACROCYCLE_WIRE_V5 or MACROCYCLE_WIRE_V6
      * @return true if serialization successful; false if any event would be
      *         truncated (a partial macrocycle is never produced)
      */
-    static bool serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle);
+    static bool serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                    uint8_t wireVersion = MACROCYCLE_WIRE_V5);
+
+    /**
+     * @brief Serialize a V6 macrocycle once for fan-out to several peers
+     *
+     * Same frame as serializeMacrocycle(V6); additionally reports where the
+     * escaped clockOffset field sits so patchMacrocycleOffset() can re-emit
+     * the frame per peer without re-encoding the events.
+     *
+     * @param offsetPos Output: byte index of the encoded clockOffset
+     * @param offsetLen Output: encoded length of clockOffset (8-16 with escapes)
+     */
+    static bool serializeMacrocycleFanout(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                          size_t& offsetPos, size_t& offsetLen);
+
+    /**
+     * @brief Copy a fan-out frame with a different clockOffset
+     * @param frame Frame from serializeMacrocycleFanout() (frameLen bytes)
+     * @param offsetPos, offsetLen Field position reported for that frame
+     * @param clockOffset The receiving peer's offset
+     * @param out Output buffer (NUL-terminated on success)
+     * @return Length written (0 if out is too small)
+     */
+    static size_t patchMacrocycleOffset(const char* frame, size_t frameLen, size_t offsetPos,
+                                        size_t offsetLen, int64_t clockOffset,
+                                        char* out, size_t outSize);
 
     /**
      * @brief Calculate serialized size of a macrocycle
      * @param macrocycle Macrocycle to measure
+     * @param wireVersion MACROCYCLE_WIRE_V5 (estimate) or MACROCYCLE_WIRE_V6
+     *        (exact pre-escape size; escapes are rare after whitening)
      * @return Total serialized size in bytes
      */
-    static size_t getMacrocycleSerializedSize(const Macrocycle& macrocycle);
+    static size_t getMacrocycleSerializedSize(const Macrocycle& macrocycle,
+                                              uint8_t wireVersion = MACROCYCLE_WIRE_V5);
 
     /**
-     * @brief Deserialize a macrocycle from hybrid format message
+     * @brief Deserialize a macrocycle message (V5 text or V6 binary)
+     *
+     * The format is detected from the byte after "MC:" (a digit for V5, the
+     * version byte for V6), so receivers accept both regardless of what was
+     * negotiated.
      *
-     * @param message Input message (text header + binary payload)
-     * @param messageLen Total message length (including binary)
+     * @param message Input message
+     * @param messageLen Total message length (required for V6)
      * @param macrocycle Output macrocycle struct
      * @return true if deserialization successful
      */
     static bool deserializeMacrocycle(const char* message, size_t messageLen, Macrocycle& macrocycle);
 
+    // -------------------------------------------------------------------------
+    // V7 template + delta frames ("MC:" + 0x07 + escaped body, kind byte first)
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Kind of a "MC:" message
+     * @return MACROCYCLE_FRAME_FULL (V5/V6), _TEMPLATE, _DELTA, _SESSION,
+     *         _TICK or _INVALID
+     */
+    static uint8_t getMacrocycleFrameKind(const char* message, size_t messageLen);
+
+    static constexpr uint8_t MACROCYCLE_FRAME_INVALID = 0;
+    static constexpr uint8_t MACROCYCLE_FRAME_FULL = 1;
+    static constexpr uint8_t MACROCYCLE_FRAME_TEMPLATE = 'T';
+    static constexpr uint8_t MACROCYCLE_FRAME_DELTA = 'D';
+    static constexpr uint8_t MACROCYCLE_FRAME_SESSION = 'S';
+    static constexpr uint8_t MACROCYCLE_FRAME_TICK = 'C';
+
+    /**
+     * @brief Derive the session template from a full macrocycle
+     *
+     * Requires event 0 at delta 0 and every pattern to be a permutation of
+     * the same finger set (true for all generated pattern types).
+     *
+     * @param macrocycle Macrocycle as sent to SECONDARY
+     * @param spacingMs Nominal event spacing (ON + OFF, before jitter)
+     * @param tmpl Output template
+     * @return false if the macrocycle does not fit the template model
+     */
+    static bool buildMacrocycleTemplate(const Macrocycle& macrocycle, uint16_t spacingMs,
+                                        MacrocycleTemplate& tmpl);
+
+    /**
+     * @brief Serialize a template frame
+     *
+     * Body: kind 'T', dur(u16) spacing(u16) amplitude(u8) freqOffset(u8)
+     * patternCount(u8) fingersPerPattern(u8) fingers[fingersPerPattern].
+     */
+    static bool serializeMacrocycleTemplate(char* buffer, size_t bufferSize, const MacrocycleTemplate& tmpl);
+
+    static bool deserializeMacrocycleTemplate(const char* message, size_t messageLen, MacrocycleTemplate& tmpl);
+
+    /**
+     * @brief Serialize a macrocycle as a delta against a template + reference
+     *
+     * Body: kind 'D', seq(u32) refDistance(u8, seq - ref.seq) baseDelta(i32)
+     * offsetDelta(i32) flags(u8), one Lehmer-coded permutation rank (u8) per
+     * pattern, then per flag: (count-1) spacing deviations (i8 ms), count
+     * amplitudes, count freqOffsets. 22 bytes for a 4-motor macrocycle
+     * without jitter or per-event variation (V6 full frame: 87).
+     *
+     * @return false if the macrocycle cannot be expressed as a delta (caller
+     *         sends a full frame instead)
+     */
+    static bool serializeMacrocycleDelta(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                         const MacrocycleTemplate& tmpl, const MacrocycleReference& ref);
+
+    /**
+     * @brief Sequence id of the reference a delta frame was encoded against
+     */
+    static bool getMacrocycleDeltaReference(const char* message, size_t messageLen, uint32_t& refSequenceId);
+
+    /**
+     * @brief Rebuild a full macrocycle from a delta frame
+     * @param ref Reference matching getMacrocycleDeltaReference()
+     */
+    static bool deserializeMacrocycleDelta(const char* message, size_t messageLen,
+                                           const MacrocycleTemplate& tmpl, const MacrocycleReference& ref,
+                                           Macrocycle& macrocycle);
+
+    /**
+     * @brief Serialize seeded-session parameters (MACROCYCLE_CAP_SEEDED)
+     *
+     * Body: kind 'S', seed(u32) patternType(u8) numFingers(u8) mirror(u8)
+     * ampMin(u8) ampMax(u8) freqRandom(u8) freqMin(u16) freqMax(u16)
+     * timeOnUs(u32) timeOffUs(u32) jitterQ16(u32) fingerMapCount(u8), then
+     * per mapped finger: finger(u8) baseFrequencyHz(u16). Timing travels in
+     * its fixed-point form so both gloves generate from identical integers.
+     */
+    static bool serializeSeededSession(char* buffer, size_t bufferSize, const SeededSessionParams& params);
+
+    static bool deserializeSeededSession(const char* message, size_t messageLen, SeededSessionParams& params);
+
+    /**
+     * @brief Serialize a seeded macrocycle tick
+     *
+     * Body: kind 'C', seed(u32) seq(u32) baseTime(u64) clockOffset(i64).
+     * The seed ties the tick to the session it was generated for.
+     */
+    static bool serializeMacrocycleTick(char* buffer, size_t bufferSize, uint32_t seed,
+                                        const MacrocycleReference& tick);
+
+    static bool deserializeMacrocycleTick(const char* message, size_t messageLen, uint32_t& seed,
+                                          MacrocycleReference& tick);
+
 private:
     SyncCommandType _type;
     uint32_t _sequenceId;
@@ -342,6 +488,139 @@ private:
     bool parseData(const char* dataStr);
 };
 
+// =============================================================================
+// MACROCYCLE REFERENCE HISTORY (V7 DELTAS)
+// =============================================================================
+
+/**
+ * @brief Timing references of the most recent macrocycles on a link
+ *
+ * Both ends record every macrocycle they send / accept. PRIMARY encodes a
+ * delta against one SECONDARY has acknowledged, so a macrocycle lost on
+ * the way never breaks the chain; SECONDARY looks the reference up here.
+ */
+class MacrocycleReferenceHistory {
+public:
+    static constexpr uint8_t SIZE = 4;
+
+    MacrocycleReferenceHistory() : _entries{}, _next(0), _count(0) {}
+
+    void clear() { _next = 0; _count = 0; }
+
+    void record(const Macrocycle& macrocycle);
+
+    /**
+     * @brief Find the reference for an exact sequence id
+     */
+    bool find(uint32_t sequenceId, MacrocycleReference& ref) const;
+
+    /**
+     * @brief Newest reference with minSequenceId <= seq <= maxSequenceId
+     */
+    bool findNewestInRange(uint32_t minSequenceId, uint32_t maxSequenceId, MacrocycleReference& ref) const;
+
+private:
+    MacrocycleReference _entries[SIZE];
+    uint8_t _next;
+    uint8_t _count;
+};
+
+// =============================================================================
+// SYNC COMMAND VIEW (ZERO-COPY PARSE)
+// =============================================================================
+
+/**
+ * @brief Read-only, in-place view of a received sync command
+ *
+ * Tokenizes a COMMAND_TYPE:seq|timestamp[|field...] message without copying
+ * it: positional fields are recorded as offsets into the caller's buffer and
+ * decoded on demand. Intended for the receive hot path (PING/PONG), where
+ * SyncCommand's per-instance SyncDataPair storage, memsets and keyed lookup
+ * sit between T4 capture and the offset computation.
+ *
+ * Parsing rules match SyncCommand::deserialize(): empty fields are skipped
+ * and at most SYNC_MAX_DATA_PAIRS fields are recorded.
+ *
+ * @note The view borrows the message buffer; it is only valid while that
+ *       buffer is unchanged.
+ *
+ * Usage:
+ *   SyncCommandView view;
+ *   if (view.parse(message, strlen(message)) &&
+ *       view.getType() == SyncCommandType::PONG) {
+ *       uint64_t t2 = view.u64(0, 1);
+ *   }
+ */
+class SyncCommandView {
+public:
+    SyncCommandView();
+
+    /**
+     * @brief Parse a message in place
+     * @param message Message bytes (need not be NUL-terminated)
+     * @param length Number of bytes in message
+     * @return true if type, sequence ID and timestamp were parsed
+     */
+    bool parse(const char* message, size_t length);
+
+    /**
+     * @brief Get command type
+     */
+    SyncCommandType getType() const { return _type; }
+
+    /**
+     * @brief Get sequence ID
+     */
+    uint32_t getSequenceId() const { return _sequenceId; }
+
+    /**
+     * @brief Get timestamp (microseconds)
+     */
+    uint64_t getTimestamp() const { return _timestamp; }
+
+    /**
+     * @brief Get number of positional data fields
+     */
+    uint8_t getFieldCount() const { return _fieldCount; }
+
+    /**
+     * @brief Check if positional data field exists
+     */
+    bool hasField(uint8_t index) const { return index < _fieldCount; }
+
+    /**
+     * @brief Decode positional field as unsigned 32-bit integer
+     * @param index Field index (0 = first field after the timestamp)
+     * @param defaultValue Value to return if missing, non-numeric or > 2^32-1
+     */
+    uint32_t u32(uint8_t index, uint32_t defaultValue = 0) const;
+
+    /**
+     * @brief Decode positional field as signed 32-bit integer ("-" prefix)
+     * @param index Field index (0 = first field after the timestamp)
+     * @param defaultValue Value to return if missing, non-numeric or out of range
+     */
+    int32_t i32(uint8_t index, int32_t defaultValue = 0) const;
+
+    /**
+     * @brief Decode a 64-bit value split across two 32-bit fields
+     * @param hiIndex Field index of the high 32 bits
+     * @param loIndex Field index of the low 32 bits
+     * @return (hi << 32) | lo, with missing halves decoded as 0
+     */
+    uint64_t u64(uint8_t hiIndex, uint8_t loIndex) const;
+
+private:
+    const char* _message;
+    SyncCommandType _type;
+    uint32_t _sequenceId;
+    uint64_t _timestamp;  // Microseconds
+
+    uint16_t _fieldOffset[SYNC_MAX_DATA_PAIRS];
+    uint16_t _fieldLength[SYNC_MAX_DATA_PAIRS];
+    uint8_t _fieldCount;
+};
+
 // =============================================================================
 // TIMING UTILITIES
 // =============================================================================
@@ -416,6 +695,23 @@ extern SequenceGenerator g_sequenceGenerator;
 // SIMPLE SYNC PROTOCOL
 // =============================================================================
 
+/**
+ * @brief Drift rate in Q16 microseconds per millisecond (65536 = 1000 ppm)
+ *
+ * Drift estimation and correction run on these integers; floats are only
+ * converted at the clock servo and for display/persistence.
+ */
+constexpr int32_t DRIFT_RATE_Q16_ONE = 65536;
+
+constexpr int32_t driftRateToQ16(float usPerMs) {
+    return static_cast<int32_t>(usPerMs * static_cast<float>(DRIFT_RATE_Q16_ONE) +
+                                ((usPerMs >= 0.0f) ? 0.5f : -0.5f));
+}
+
+constexpr float driftRateFromQ16(int32_t rateQ16) {
+    return static_cast<float>(rateQ16) / static_cast<float>(DRIFT_RATE_Q16_ONE);
+}
+
 /**
  * @brief Simple synchronization protocol for timestamp-based coordination
  *
@@ -588,7 +884,8 @@ public:
      * @brief Add a clock offset sample with RTT-based quality filtering
      *
      * Samples with high RTT (indicating retransmissions or asymmetric delay)
-     * are rejected to improve offset accuracy.
+     * are rejected to improve offset accuracy. With SYNC_CLOCK_SERVO_ENABLED
+     * the sample feeds the Kalman servo instead of the median buffer.
      *
      * @param offset Clock offset sample in microseconds
      * @param rttUs Round-trip time in microseconds
@@ -630,6 +927,10 @@ public:
      *   3. Innovation gate: offset jumps > SYNC_INNOVATION_GATE_US rejected
      *      unless persistent for SYNC_INNOVATION_REJECT_LIMIT samples
      *
+     * With SYNC_CLOCK_SERVO_ENABLED both phases feed the Kalman servo, which
+     * weights each sample by its excess RTT and gates on its own innovation
+     * variance; median, offset and drift getters mirror the servo state.
+     *
      * @return true if the sample was accepted
      */
     [[nodiscard]] bool updateOffsetEMAWithQuality(int64_t offset, uint32_t rttUs);
@@ -659,7 +960,29 @@ public:
      * @brief Get estimated drift rate
      * @return Drift rate in microseconds per millisecond
      */
-    float getDriftRate() const { return _driftRateUsPerMs; }
+    float getDriftRate() const { return driftRateFromQ16(_driftRateQ16); }
+
+    /**
+     * @brief Get estimated drift rate in Q16 us/ms (see DRIFT_RATE_Q16_ONE)
+     */
+    int32_t getDriftRateQ16() const { return _driftRateQ16; }
+
+    /**
+     * @brief Drift-rate uncertainty (for persisting the calibration)
+     *
+     * The servo's skew sigma when SYNC_CLOCK_SERVO_ENABLED; the EMA path has
+     * no per-sample estimate and reports SYNC_SKEW_CAL_SIGMA_US_PER_MS.
+     */
+    float getDriftRateSigma() const;
+
+    /**
+     * @brief Start a cold sync from a persisted skew calibration
+     *
+     * Call after resetClockSync(). The drift estimate starts from
+     * skewUsPerMs and sync becomes valid after SYNC_SKEW_CAL_MIN_SAMPLES
+     * instead of SYNC_MIN_VALID_SAMPLES (the offset is still measured).
+     */
+    void seedDriftRate(float skewUsPerMs, float sigmaUsPerMs);
 
     /**
      * @brief Get average RTT in microseconds
@@ -672,6 +995,16 @@ public:
      */
     uint32_t getRTTVariance() const { return _rttVariance; }
 
+    /**
+     * @brief Estimated offset uncertainty (drives the adaptive PING cadence)
+     *
+     * The servo's offset sigma when SYNC_CLOCK_SERVO_ENABLED, otherwise the
+     * smoothed one-way latency deviation (the jitter each PTP sample carries).
+     *
+     * @return Uncertainty in microseconds (UINT32_MAX until sync is valid)
+     */
+    uint32_t getOffsetUncertaintyUs() const;
+
     /**
      * @brief Calculate adaptive lead time based on RTT statistics
      *
@@ -686,6 +1019,22 @@ public:
      */
     uint32_t calculateAdaptiveLeadTime() const;
 
+    /**
+     * @brief Lead time bounded by the SECONDARY link's connection events
+     *
+     * waitUs + SYNC_ANCHORED_LEAD_EVENTS intervals + overheads: the
+     * MACROCYCLE is a one-way transfer, so the RTT-based margin overstates
+     * it roughly twofold. Never below the measured one-way latency + 3-sigma
+     * (a congested or 1M link shows up there first), clamped to
+     * SYNC_ANCHORED_MIN_LEAD_TIME_US..SYNC_MAX_LEAD_TIME_US. Falls back to
+     * calculateAdaptiveLeadTime() until enough RTT samples exist.
+     *
+     * @param waitUs Time until the next connection event (<= intervalUs)
+     * @param intervalUs Negotiated connection interval
+     * @return Lead time in microseconds
+     */
+    uint32_t calculateAnchoredLeadTime(uint32_t waitUs, uint32_t intervalUs) const;
+
     /**
      * @brief Convert PRIMARY clock time to SECONDARY local time
      * @param primaryTime Timestamp in PRIMARY clock (microseconds)
@@ -791,6 +1140,39 @@ public:
      */
     void resetAsymmetryTracking();
 
+    // =========================================================================
+    // PER-LINK STATISTICS (PHY switches)
+    // =========================================================================
+
+    /**
+     * @brief RTT-derived state that belongs to one PHY
+     *
+     * Latency EMA, RTT variance, the lucky-packet minimum RTT and path
+     * asymmetry all move with the air time; the clock offset and drift do
+     * not. A default-constructed value is the reset state.
+     */
+    struct LinkStats {
+        uint32_t smoothedLatencyUs = 0;
+        uint32_t rttVarianceUs = 0;
+        uint32_t minRttUs = UINT32_MAX;
+        uint16_t sampleCount = 0;
+        int64_t smoothedAsymmetryUs = 0;
+        uint32_t asymmetryVarianceUs = 0;
+        uint16_t asymmetrySampleCount = 0;
+    };
+
+    /** @brief Current RTT-derived state (cache it when leaving a PHY) */
+    LinkStats getLinkStats() const;
+
+    /**
+     * @brief Swap in a PHY's cached RTT-derived state
+     *
+     * Warm-starts the lead time and the RTT gates on a PHY seen before; a
+     * default LinkStats is equivalent to resetLatency() +
+     * resetAsymmetryTracking().
+     */
+    void restoreLinkStats(const LinkStats& stats);
+
 private:
     // EMA tuning constants
     static constexpr uint16_t MIN_SAMPLES = 3;        // Minimum before using smoothed
@@ -799,7 +1181,9 @@ private:
     static constexpr uint8_t EMA_ALPHA_DEN = 10;
 
     // PTP clock sync constants
-    static constexpr uint8_t OFFSET_SAMPLE_COUNT = 10;
+    static constexpr uint8_t OFFSET_SAMPLE_COUNT = SYNC_OFFSET_WINDOW_SIZE;
+    static_assert(SYNC_OFFSET_WINDOW_SIZE >= 1 && SYNC_OFFSET_WINDOW_SIZE <= 255,
+                  "SYNC_OFFSET_WINDOW_SIZE must fit the uint8_t sample count");
 
     int64_t _currentOffset;       // Current clock offset (microseconds)
     uint32_t _lastSyncTime;       // syncNowMs() epoch of last sync; UINT32_MAX = never synced
@@ -812,15 +1196,17 @@ private:
 
     // PTP clock synchronization
     int64_t _offsetSamples[OFFSET_SAMPLE_COUNT];  // Circular buffer of offset samples
+    int64_t _sortedOffsets[OFFSET_SAMPLE_COUNT];  // Same samples, ascending (median window)
     uint8_t _offsetSampleIndex;   // Next write position in circular buffer
     uint8_t _offsetSampleCount;   // Number of valid samples (0 to OFFSET_SAMPLE_COUNT)
     int64_t _medianOffset;        // Computed median offset
     bool _clockSyncValid;         // True when enough stable samples collected
+    uint8_t _requiredSamples;     // Samples to valid sync (lowered by seedDriftRate)
 
     // Drift rate compensation
     int64_t _lastMeasuredOffset;  // Previous offset measurement for drift calculation
     uint32_t _lastOffsetTime;     // Time of last offset measurement (millis)
-    float _driftRateUsPerMs;      // Estimated drift rate (microseconds per millisecond)
+    int32_t _driftRateQ16;        // Estimated drift rate (Q16 microseconds per millisecond)
     int64_t _driftAnchorOffset;   // Offset at the start of the current drift-measurement window
     uint32_t _driftAnchorTime;    // syncNowMs() at the start of the window (0 = unset)
 
@@ -831,17 +1217,24 @@ private:
     // Warm-start cache for quick reconnection
     struct WarmStartCache {
         int64_t cachedOffset;        // Last known median offset
-        float cachedDriftRate;       // Last known drift rate (us/ms)
+        int32_t cachedDriftRateQ16;  // Last known drift rate (Q16 us/ms)
         uint32_t cacheTimestamp;     // syncNowMs() epoch (getMicros()/1000) when cached
         bool isValid;                // Cache contains usable data
 
-        WarmStartCache() : cachedOffset(0), cachedDriftRate(0.0f),
+        WarmStartCache() : cachedOffset(0), cachedDriftRateQ16(0),
                            cacheTimestamp(0), isValid(false) {}
     } _warmStartCache;
 
     bool _warmStartMode;             // Currently in warm-start recovery
     uint8_t _warmStartConfirmed;     // Number of validated confirmatory samples
 
+#if SYNC_CLOCK_SERVO_ENABLED
+    ClockServo _servo;
+
+    // Feed the servo and mirror its estimate into the median/drift fields
+    bool applyServoSample(int64_t offset, uint32_t rttUs);
+#endif
+
     // Path asymmetry tracking (measurement only)
     int64_t _lastAsymmetry;          // Most recent asymmetry measurement (µs)
     int64_t _smoothedAsymmetry;      // EMA-smoothed asymmetry (µs)
@@ -20,6 +20,8 @@
 #include "types.h"
 #include <vector>
 #include <ranges>
+#include <array>
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 
@@ -43,6 +45,16 @@ enum class BuzzFlowState : uint8_t {
 // PATTERN CONSTANTS
 // =============================================================================
 
+/**
+ * @brief Upper bound for TherapyEngine::setMacrocyclePipelineDepth()
+ */
+constexpr uint8_t MACROCYCLE_PIPELINE_MAX_DEPTH = 3;
+
+/**
+ * @brief Patterns per macrocycle (v1 parity)
+ */
+constexpr uint8_t PATTERNS_PER_MACROCYCLE = 3;
+
 constexpr const static size_t PATTERN_MAX_FINGERS = 5; // Upper bound across boards (5 with thumb)
 constexpr const static size_t DEFAULT_NUM_FINGERS = MAX_ACTUATORS;
 enum class PatternType{
@@ -51,6 +63,61 @@ enum class PatternType{
     MIRRORED  = 2,
 };
 
+// =============================================================================
+// SEEDED PRNG
+// =============================================================================
+
+/**
+ * @brief PCG32 generator (O'Neill, pcg32_srandom_r seeding)
+ *
+ * Same output on every platform, unlike Arduino random(). Seeded
+ * generation uses one stream per macrocycle: (session seed, sequence id).
+ */
+class PatternRng {
+public:
+    constexpr PatternRng(uint64_t seed, uint64_t stream) :
+        _state(0),
+        _inc((stream << 1u) | 1u)
+    {
+        next();
+        _state += seed;
+        next();
+    }
+
+    /**
+     * @brief Next 32-bit output
+     */
+    constexpr uint32_t next() {
+        uint64_t old = _state;
+        _state = old * 6364136223846793005ULL + _inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    /**
+     * @brief Unbiased value in [lo, hi), like Arduino random(lo, hi)
+     * @return lo if hi <= lo
+     */
+    constexpr long range(long lo, long hi) {
+        if (hi <= lo) {
+            return lo;
+        }
+        uint32_t span = static_cast<uint32_t>(hi - lo);
+        uint32_t threshold = (0u - span) % span;
+        for (;;) {
+            uint32_t r = next();
+            if (r >= threshold) {
+                return lo + static_cast<long>(r % span);
+            }
+        }
+    }
+
+private:
+    uint64_t _state;
+    uint64_t _inc;
+};
+
 // =============================================================================
 // PATTERN STRUCTURE
 // =============================================================================
@@ -61,26 +128,26 @@ enum class PatternType{
  * Contains finger sequences for both hands with timing information.
  *
  * Timing model (matching v1 original):
- *   For each finger: MOTOR_ON(burstDurationMs) → MOTOR_OFF(timeOffMs[i] with jitter)
- *   After all fingers: Wait interBurstIntervalMs (TIME_RELAX = 668ms)
+ *   For each finger: MOTOR_ON(burstDurationUs) → MOTOR_OFF(timeOffUs[i] with jitter)
+ *   After all fingers: Wait interBurstIntervalUs (TIME_RELAX = 668ms)
  */
 struct [[nodiscard]] Pattern {
     std::vector<uint8_t> primarySequence;
     std::vector<uint8_t> secondarySequence;
-    std::vector<float> timeOffMs;   // TIME_OFF + jitter for each finger (v1: 67ms ± jitter)
+    std::vector<uint32_t> timeOffUs;        // TIME_OFF + jitter for each finger (v1: 67ms ± jitter)
     uint8_t numFingers;
-    float burstDurationMs;                  // TIME_ON (v1: 100ms)
-    float interBurstIntervalMs;             // TIME_RELAX after pattern cycle (v1: 668ms fixed)
+    uint32_t burstDurationUs;               // TIME_ON (v1: 100ms)
+    uint32_t interBurstIntervalUs;          // TIME_RELAX after pattern cycle (v1: 668ms fixed)
 
     Pattern(uint8_t _numFingers = DEFAULT_NUM_FINGERS) :
         primarySequence(std::vector<uint8_t>(_numFingers)),
         secondarySequence(std::vector<uint8_t>(_numFingers)),
-        timeOffMs(std::vector<float>(_numFingers, 67.0f)),
+        timeOffUs(std::vector<uint32_t>(_numFingers, 67000)),
         numFingers(_numFingers),
-        burstDurationMs(100.0f),
-        interBurstIntervalMs(668.0f)
+        burstDurationUs(100000),
+        interBurstIntervalUs(668000)
     {
-        assert(primarySequence.size() == secondarySequence.size() && primarySequence.size() == timeOffMs.size());
+        assert(primarySequence.size() == secondarySequence.size() && primarySequence.size() == timeOffUs.size());
         for (uint8_t i = 0; i < primarySequence.size(); i++) {
             primarySequence[i] = i;
             secondarySequence[i] = i;
@@ -88,14 +155,14 @@ struct [[nodiscard]] Pattern {
     }
 
     /**
-     * @brief Get total pattern duration in milliseconds
+     * @brief Get total pattern duration in microseconds
      */
-    float getTotalDurationMs() const {
-        float total = 0;
+    uint32_t getTotalDurationUs() const {
+        uint32_t total = 0;
         for (int i = 0; i < numFingers; i++) {
-            total += burstDurationMs + timeOffMs[i];
+            total += burstDurationUs + timeOffUs[i];
         }
-        return total + interBurstIntervalMs;  // Include TIME_RELAX at end
+        return total + interBurstIntervalUs;  // Include TIME_RELAX at end
     }
 
     /**
@@ -121,8 +188,9 @@ struct [[nodiscard]] Pattern {
 /**
  * @brief Fisher-Yates shuffle for array
  * @param arr Array to shuffle
+ * @param rng Seeded generator, or nullptr for Arduino random()
  */
-constexpr void shuffleArray(std::span<uint8_t> arr);
+constexpr void shuffleArray(std::span<uint8_t> arr, PatternRng* rng = nullptr);
 
 /**
  * @brief Generate random permutation (RNDP) pattern
@@ -131,18 +199,16 @@ constexpr void shuffleArray(std::span<uint8_t> arr);
  * Used for noisy vCR therapy.
  *
  * @param numFingers Number of fingers per hand (1-MAX_ACTUATORS)
- * @param timeOnMs Vibration burst duration
- * @param timeOffMs Time between bursts
- * @param jitterPercent Timing jitter percentage (0-100)
+ * @param timing TIME_ON, TIME_OFF and jitter
  * @param mirrorPattern If true, same finger on both hands (noisy vCR)
+ * @param rng Seeded generator, or nullptr for Arduino random()
  * @return Generated pattern
  */
 Pattern generateRandomPermutation(
     uint8_t numFingers = MAX_ACTUATORS,
-    float timeOnMs = 100.0f,
-    float timeOffMs = 67.0f,
-    float jitterPercent = 0.0f,
-    bool mirrorPattern = false
+    const TherapyTiming& timing = TherapyTiming(),
+    bool mirrorPattern = false,
+    PatternRng* rng = nullptr
 );
 
 /**
@@ -151,20 +217,18 @@ Pattern generateRandomPermutation(
  * Fingers activated in order: 0->1->2->3 (or reverse)
  *
  * @param numFingers Number of fingers per hand (1-MAX_ACTUATORS)
- * @param timeOnMs Vibration burst duration
- * @param timeOffMs Time between bursts
- * @param jitterPercent Timing jitter percentage (0-100)
+ * @param timing TIME_ON, TIME_OFF and jitter
  * @param mirrorPattern If true, same sequence for both hands
  * @param reverse If true, reverse order (3->0)
+ * @param rng Seeded generator, or nullptr for Arduino random()
  * @return Generated pattern
  */
 Pattern generateSequentialPattern(
     uint8_t numFingers = MAX_ACTUATORS,
-    float timeOnMs = 100.0f,
-    float timeOffMs = 67.0f,
-    float jitterPercent = 0.0f,
+    const TherapyTiming& timing = TherapyTiming(),
     bool mirrorPattern = false,
-    bool reverse = false
+    bool reverse = false,
+    PatternRng* rng = nullptr
 );
 
 /**
@@ -173,20 +237,234 @@ Pattern generateSequentialPattern(
  * Both hands use identical finger sequences.
  *
  * @param numFingers Number of fingers per hand (1-MAX_ACTUATORS)
- * @param timeOnMs Vibration burst duration
- * @param timeOffMs Time between bursts
- * @param jitterPercent Timing jitter percentage (0-100)
+ * @param timing TIME_ON, TIME_OFF and jitter
  * @param randomize If true, randomize sequence
+ * @param rng Seeded generator, or nullptr for Arduino random()
  * @return Generated pattern
  */
 Pattern generateMirroredPattern(
     uint8_t numFingers = MAX_ACTUATORS,
-    float timeOnMs = 100.0f,
-    float timeOffMs = 67.0f,
-    float jitterPercent = 0.0f,
-    bool randomize = true
+    const TherapyTiming& timing = TherapyTiming(),
+    bool randomize = true,
+    PatternRng* rng = nullptr
 );
 
+// =============================================================================
+// FIXED-SIZE PATTERN GENERATION (MACROCYCLE HOT PATH)
+// =============================================================================
+
+/**
+ * @brief Seeded generator when given, Arduino random() otherwise
+ */
+constexpr long patternRandom(PatternRng* rng, long lo, long hi) {
+    return rng ? rng->range(lo, hi) : random(lo, hi);
+}
+
+/**
+ * @brief Pattern timing in integer microseconds
+ *
+ * Derived once per session so the generators below stay integer-only.
+ */
+struct PatternTiming {
+    uint32_t timeOnUs;        // TIME_ON
+    uint32_t timeOffUs;       // TIME_OFF before jitter
+    uint32_t jitterAmountUs;  // v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
+
+    static constexpr PatternTiming from(const TherapyTiming& therapy) {
+        PatternTiming timing{};
+        timing.timeOnUs = therapy.timeOnUs;
+        timing.timeOffUs = therapy.timeOffUs;
+        // Q16 fraction / 2 -> shift by 17, rounded to the nearest microsecond
+        uint64_t cycleUs = static_cast<uint64_t>(therapy.timeOnUs) + therapy.timeOffUs;
+        timing.jitterAmountUs = static_cast<uint32_t>((cycleUs * therapy.jitterQ16 + (1ULL << 16)) >> 17);
+        return timing;
+    }
+};
+
+/**
+ * @brief TIME_OFF plus one uniform jitter draw in [-jitterAmountUs, +jitterAmountUs]
+ *
+ * Shared by Pattern and FixedPattern generation; no draw without jitter.
+ */
+constexpr uint32_t patternJitteredOffUs(const PatternTiming& timing, PatternRng* rng) {
+    int64_t offUs = timing.timeOffUs;
+    if (timing.jitterAmountUs > 0) {
+        offUs += patternRandom(rng, -1000, 1001) * static_cast<int64_t>(timing.jitterAmountUs) / 1000;
+        if (offUs < 0) offUs = 0;
+    }
+    return static_cast<uint32_t>(offUs);
+}
+
+/**
+ * @brief n! for n <= PATTERN_MAX_FINGERS
+ */
+constexpr uint8_t patternPermutationCount(uint8_t n) {
+    return (n <= 1) ? 1 : static_cast<uint8_t>(n * patternPermutationCount(static_cast<uint8_t>(n - 1)));
+}
+
+/**
+ * @brief All permutations of 0..N-1 in lexicographic order (flash-resident)
+ *
+ * Row 0 is the identity, row COUNT-1 the reverse. A random pattern is one
+ * draw of a row index instead of an N-step shuffle (120 rows at N = 5).
+ */
+template <uint8_t N>
+struct PatternPermutations {
+    static_assert(N >= 1 && N <= PATTERN_MAX_FINGERS, "N must be 1..PATTERN_MAX_FINGERS");
+
+    static constexpr uint8_t COUNT = patternPermutationCount(N);
+
+    static constexpr std::array<std::array<uint8_t, N>, COUNT> rows = [] {
+        std::array<std::array<uint8_t, N>, COUNT> table{};
+        std::array<uint8_t, N> perm{};
+        for (uint8_t i = 0; i < N; i++) {
+            perm[i] = i;
+        }
+        for (uint8_t row = 0; row < COUNT; row++) {
+            table[row] = perm;
+            std::next_permutation(perm.begin(), perm.end());
+        }
+        return table;
+    }();
+};
+
+/**
+ * @brief Pattern with a compile-time finger count and integer timing
+ *
+ * Same sequences and jitter model as Pattern; TIME_ON and TIME_RELAX are
+ * taken from PatternTiming.
+ */
+template <uint8_t N>
+struct FixedPattern {
+    std::array<uint8_t, N> primarySequence;
+    std::array<uint8_t, N> secondarySequence;
+    std::array<uint32_t, N> timeOffUs;   // TIME_OFF + jitter for each finger
+};
+
+/**
+ * @brief Apply TIME_OFF jitter (one draw per finger when jitter is enabled)
+ */
+template <uint8_t N>
+constexpr void applyPatternJitter(FixedPattern<N>& pattern, const PatternTiming& timing, PatternRng* rng) {
+    for (uint8_t i = 0; i < N; i++) {
+        pattern.timeOffUs[i] = patternJitteredOffUs(timing, rng);
+    }
+}
+
+/**
+ * @brief RNDP pattern for N fingers (see generateRandomPermutation above)
+ */
+template <uint8_t N>
+constexpr FixedPattern<N> generateRandomPermutation(const PatternTiming& timing, bool mirrorPattern,
+                                                    PatternRng* rng = nullptr) {
+    using Table = PatternPermutations<N>;
+    FixedPattern<N> pattern{};
+    pattern.primarySequence = Table::rows[patternRandom(rng, 0, Table::COUNT)];
+    pattern.secondarySequence = mirrorPattern ? pattern.primarySequence
+                                              : Table::rows[patternRandom(rng, 0, Table::COUNT)];
+    applyPatternJitter(pattern, timing, rng);
+    return pattern;
+}
+
+/**
+ * @brief Sequential pattern for N fingers (see generateSequentialPattern above)
+ */
+template <uint8_t N>
+constexpr FixedPattern<N> generateSequentialPattern(const PatternTiming& timing, bool mirrorPattern,
+                                                    bool reverse = false, PatternRng* rng = nullptr) {
+    using Table = PatternPermutations<N>;
+    constexpr uint8_t FORWARD = 0;
+    constexpr uint8_t BACKWARD = Table::COUNT - 1;
+    FixedPattern<N> pattern{};
+    pattern.primarySequence = Table::rows[reverse ? BACKWARD : FORWARD];
+    // Non-mirrored: opposite order
+    pattern.secondarySequence = Table::rows[(reverse == mirrorPattern) ? BACKWARD : FORWARD];
+    applyPatternJitter(pattern, timing, rng);
+    return pattern;
+}
+
+/**
+ * @brief Mirrored pattern for N fingers (see generateMirroredPattern above)
+ */
+template <uint8_t N>
+constexpr FixedPattern<N> generateMirroredPattern(const PatternTiming& timing, bool randomize = true,
+                                                  PatternRng* rng = nullptr) {
+    using Table = PatternPermutations<N>;
+    FixedPattern<N> pattern{};
+    pattern.primarySequence = Table::rows[randomize ? patternRandom(rng, 0, Table::COUNT) : 0];
+    pattern.secondarySequence = pattern.primarySequence;
+    applyPatternJitter(pattern, timing, rng);
+    return pattern;
+}
+
+/**
+ * @brief Gap between macrocycles: 2x TIME_RELAX, TIME_RELAX = 4 * (ON + OFF)
+ */
+constexpr uint32_t macrocycleDoubleRelaxUs(const TherapyTiming& timing) {
+    return 2 * 4 * (timing.timeOnUs + timing.timeOffUs);
+}
+
+// =============================================================================
+// SCHEDULE PLAN
+// =============================================================================
+
+/**
+ * @brief A session compiled for the per-macrocycle generator
+ *
+ * compileSchedulePlan() derives the jitter bound, the 5 Hz step division
+ * and the validation once - at SESSION_START on PRIMARY, on receipt of the
+ * seeded params on SECONDARY. Every macrocycle after that runs on these
+ * integers and indexes the finger map; nothing in the steady-state loop
+ * touches a float.
+ */
+struct SchedulePlan {
+    uint32_t seed;                            // Session PRNG seed (seeded generation)
+    PatternTiming timing;                     // TIME_ON / TIME_OFF / jitter bound (us)
+    uint32_t doubleRelaxUs;                   // Gap after each macrocycle
+    uint16_t durationMs;                      // Common event duration (TIME_ON, rounded)
+    uint8_t patternType;                      // PatternType
+    uint8_t numFingers;                       // Fingers per pattern (0 = empty macrocycles)
+    bool mirrorPattern;
+    uint8_t amplitudeMin;
+    uint8_t amplitudeMax;
+    bool frequencyRandomization;
+    uint16_t frequencyMinHz;
+    uint16_t frequencySteps;                  // 5 Hz steps above frequencyMinHz
+    uint8_t fingerMap[MAX_ACTUATORS];         // Pattern slot -> physical finger (total)
+    uint16_t baseFrequencyHz[MAX_ACTUATORS];  // Per physical finger, without randomization
+
+    SchedulePlan() : seed(0), timing{}, doubleRelaxUs(0), durationMs(0), patternType(0), numFingers(0),
+                     mirrorPattern(false), amplitudeMin(0), amplitudeMax(0), frequencyRandomization(false),
+                     frequencyMinHz(0), frequencySteps(0), fingerMap{}, baseFrequencyHz{} {}
+};
+
+/**
+ * @brief Compile session parameters into a SchedulePlan
+ * @return false if params are inconsistent (e.g. from a corrupt frame); plan
+ *         is still filled but must not be used for seeded regeneration
+ */
+bool compileSchedulePlan(const SeededSessionParams& params, SchedulePlan& plan);
+
+/**
+ * @brief Regenerate macrocycle N of a seeded session
+ *
+ * Runs the same generator TherapyEngine uses, on PatternRng(seed, N), so
+ * PRIMARY and SECONDARY produce identical events. baseTime and clockOffset
+ * are left at zero (they travel in the tick).
+ *
+ * @param plan Compiled session (compileSchedulePlan() returned true)
+ * @param sequenceId Macrocycle sequence id
+ * @param macrocycle Output
+ */
+void generateSeededMacrocycle(const SchedulePlan& plan, uint32_t sequenceId, Macrocycle& macrocycle);
+
+/**
+ * @brief Compile params and regenerate macrocycle N (one-off use)
+ * @param params Session parameters (TherapyEngine::getSeededSessionParams)
+ * @return false if params are inconsistent
+ */
+bool generateSeededMacrocycle(const SeededSessionParams& params, uint32_t sequenceId, Macrocycle& macrocycle);
+
 // =============================================================================
 // CALLBACK TYPES
 // =============================================================================
@@ -321,6 +599,9 @@ public:
      * @param fingers Physical finger indices to use (each < MAX_ACTUATORS)
      * @param count Number of entries (1 to MAX_ACTUATORS); invalid input
      *              resets to the identity map
+     *
+     * Mid-session the pattern size follows the map (never above the
+     * session's request) and the plan is recompiled.
      */
     void setActiveFingers(const uint8_t* fingers, uint8_t count);
 
@@ -337,6 +618,74 @@ public:
      */
     void setFrequencyRandomization(bool enabled, uint16_t minHz = 210, uint16_t maxHz = 255);
 
+    /**
+     * @brief Set how many macrocycles may be in flight at once
+     *
+     * 1 (default) is stop-and-wait: generate, send, play, relax, repeat, with
+     * the adaptive lead time paid before every macrocycle. Higher depths
+     * stream: macrocycle N+1 is generated and sent while N is still in flight,
+     * its baseTime chained to the end of N's relax window, once it is due
+     * within MACROCYCLE_PIPELINE_HORIZON_MS. Both devices must then append
+     * macrocycles to their activation queues instead of replacing them.
+     *
+     * A depth change takes effect at the next macrocycle boundary.
+     *
+     * @param depth 1 to MACROCYCLE_PIPELINE_MAX_DEPTH (clamped)
+     */
+    void setMacrocyclePipelineDepth(uint8_t depth);
+
+    /**
+     * @brief Whether macrocycles are streamed (depth > 1)
+     */
+    bool isMacrocyclePipelined() const { return _pipelineDepth > 1; }
+
+    /**
+     * @brief Record a MACROCYCLE_ACK from SECONDARY
+     *
+     * Safe from BLE callback context (single word write). In pipelined mode
+     * a macrocycle is not followed by another until it is ACKed or has
+     * started playing, so at most one unacknowledged macrocycle is on the
+     * wire. ACKs are cumulative (BLE delivers in order).
+     */
+    void onMacrocycleAck(uint32_t sequenceId);
+
+    /**
+     * @brief Number of pipelined macrocycles scheduled but not yet complete
+     */
+    uint8_t getMacrocyclesInFlight() const { return _inFlightCount; }
+
+    /**
+     * @brief Pipelined macrocycles that completed without an ACK
+     */
+    uint32_t getMacrocycleAckMisses() const { return _macrocycleAckMisses; }
+
+    /**
+     * @brief Nominal event-to-event spacing before jitter (TIME_ON + TIME_OFF)
+     *
+     * Matches the per-event advance in generateMacrocycle(); used as the V7
+     * template spacing so unjittered deltas carry no timing bytes.
+     */
+    uint16_t getNominalEventSpacingMs() const {
+        return static_cast<uint16_t>((_timing.timeOnUs + _timing.timeOffUs) / 1000);
+    }
+
+    /**
+     * @brief Generate macrocycles from the session seed instead of random()
+     *
+     * Every session draws a seed at start; while enabled, macrocycle N comes
+     * from generateSeededMacrocycle(getSeededSessionParams(), N) so a
+     * SECONDARY holding the same params can rebuild it from a tick. Takes
+     * effect at the next macrocycle.
+     */
+    void setSeededGeneration(bool enabled) { _seededGeneration = enabled; }
+
+    bool isSeededGeneration() const { return _seededGeneration; }
+
+    /**
+     * @brief Parameters that reproduce the current session's macrocycles
+     */
+    void getSeededSessionParams(SeededSessionParams& params) const;
+
     // =========================================================================
     // SESSION CONTROL
     // =========================================================================
@@ -345,9 +694,7 @@ public:
      * @brief Start therapy session
      * @param durationSec Total session duration in seconds
      * @param patternType Pattern type (PatternType::RNDP, etc.)
-     * @param timeOnMs Vibration burst duration
-     * @param timeOffMs Time between bursts
-     * @param jitterPercent Timing jitter percentage
+     * @param timing TIME_ON, TIME_OFF and jitter
      * @param numFingers Number of fingers per hand
      * @param mirrorPattern If true, same finger on both hands
      * @param amplitudeMin Minimum motor amplitude (0-100)
@@ -357,9 +704,7 @@ public:
     void startSession(
         uint32_t durationSec,
         PatternType patternType = PatternType::RNDP,
-        float timeOnMs = 100.0f,
-        float timeOffMs = 67.0f,
-        float jitterPercent = 0.0f,
+        const TherapyTiming& timing = TherapyTiming(),
         uint8_t numFingers = MAX_ACTUATORS,
         bool mirrorPattern = false,
         uint8_t amplitudeMin = 100,
@@ -451,10 +796,9 @@ private:
     uint32_t _sessionStartTime;
     uint32_t _sessionDurationSec;
     PatternType _patternType;
-    float _timeOnMs;
-    float _timeOffMs;
-    float _jitterPercent;
+    TherapyTiming _timing;
     uint8_t _numFingers;
+    uint8_t _sessionFingers;       // Requested by startSession (_numFingers is clamped to the map)
     bool _mirrorPattern;
 
     // Physical fingers patterns are generated over (identity by default;
@@ -484,7 +828,6 @@ private:
 
     // Macrocycle tracking (v1 parity: 3 patterns per macrocycle)
     uint8_t _patternsInMacrocycle;      // Count of patterns executed in current macrocycle (0-2)
-    static const uint8_t PATTERNS_PER_MACROCYCLE = 3;  // v1: 3 patterns per macrocycle
 
     // Flow control state machine (used by MACROCYCLE mode)
     BuzzFlowState _buzzFlowState;       // NOTE: Used by MACROCYCLE, not just BUZZ (legacy name)
@@ -509,12 +852,41 @@ private:
     uint8_t _macrocycleEventIndex;       // Current event index within macrocycle (0-11)
     uint64_t _macrocycleBaseTime;        // Base activation time for current macrocycle
 
+    // Pipelined streaming (MACROCYCLE_PIPELINE_DEPTH): oldest-first ring of
+    // scheduled macrocycles, owned by the main loop
+    struct InFlightMacrocycle {
+        uint32_t sequenceId;
+        uint64_t baseTimeUs;             // First activation (PRIMARY clock)
+        uint64_t endTimeUs;              // Last deactivation (relax starts here)
+    };
+    InFlightMacrocycle _inFlight[MACROCYCLE_PIPELINE_MAX_DEPTH];
+    uint8_t _inFlightHead;               // Index of the oldest entry
+    uint8_t _inFlightCount;
+    uint8_t _pipelineDepth;
+    volatile uint32_t _lastAckedSequenceId;  // Written from BLE context
+    volatile bool _ackReceived;              // _lastAckedSequenceId is valid
+    uint32_t _macrocycleAckMisses;
+
+    // Seeded generation (setSeededGeneration)
+    bool _seededGeneration;
+    uint32_t _sessionSeed;               // Drawn by startSession()
+
+    // Session compiled for generateMacrocycle() (startSession, or a finger /
+    // frequency change mid-session)
+    SchedulePlan _plan;
+    bool _planValid;
+
     // Internal methods
     void remapPatternFingers(Pattern& pattern);  // Map slot indices -> physical fingers
     void generateNextPattern();
     void applyFrequencyRandomization();  // Called at start of each pattern cycle
     Macrocycle generateMacrocycle();     // Generate 3*numFingers events for a macrocycle
     void executeMacrocycleStep();        // State machine for macrocycle batching mode
+    void executeMacrocyclePipelined();   // Streaming variant (depth > 1)
+    void sendAndScheduleMacrocycle();    // Send _currentMacrocycle + enqueue PRIMARY events
+    bool isMacrocycleAcked(uint32_t sequenceId) const;
+    uint32_t doubleRelaxUs() const { return _plan.doubleRelaxUs; }  // 2x TIME_RELAX between macrocycles
+    void compilePlan();                  // Rebuild _plan from the session parameters
 };
 
 #endif // THERAPY_ENGINE_H
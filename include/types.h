@@ -431,6 +431,29 @@ constexpr uint8_t MACROCYCLE_MAX_EVENTS = 3 * MAX_ACTUATORS;
 constexpr uint16_t MACROCYCLE_FREQ_BASE = 200;
 constexpr uint8_t MACROCYCLE_FREQ_STEP = 5;
 
+/**
+ * @brief MACROCYCLE wire format versions (negotiated per link via MC_VER)
+ *
+ * V5: all-text "MC:seq|baseHigh|baseLow|..." - understood by every firmware
+ * V6: "MC:" + version byte + escaped little-endian binary body
+ * V7: V6 full frames plus a session template and compact per-cycle deltas
+ * A peer that never announces a version is treated as V5.
+ */
+constexpr uint8_t MACROCYCLE_WIRE_V5 = 5;
+constexpr uint8_t MACROCYCLE_WIRE_V6 = 6;
+constexpr uint8_t MACROCYCLE_WIRE_V7 = 7;
+constexpr uint8_t MACROCYCLE_WIRE_LATEST = MACROCYCLE_WIRE_V7;
+
+/**
+ * @brief MC_VER capability bits ("MC_VER:<version>|<caps>")
+ *
+ * SECONDARY announces what it supports; PRIMARY replies with what it will
+ * use. Older firmware sends and parses the bare version (caps = 0).
+ */
+constexpr uint8_t MACROCYCLE_CAP_PIPELINE = 0x01;  // Macrocycles append to the activation queue
+// 0x02 was generator v1 (float TIME_ON/TIME_OFF/jitter); retired, never announced
+constexpr uint8_t MACROCYCLE_CAP_SEEDED = 0x04;    // Regenerates macrocycles from a seed (generator v2)
+
 /**
  * @brief Single buzz event within a macrocycle (packed for BLE transmission)
  *
@@ -509,4 +532,154 @@ struct Macrocycle {
     }
 };
 
+/**
+ * @brief Session-constant macrocycle structure (V7 delta encoding)
+ *
+ * Cached by SECONDARY so later macrocycles can be sent as deltas carrying
+ * only the per-pattern finger permutations, timing jitter and (when they
+ * vary) per-event amplitudes/frequencies.
+ */
+struct MacrocycleTemplate {
+    uint16_t durationMs;                // Common ON duration (Macrocycle::durationMs)
+    uint16_t spacingMs;                 // Nominal event-to-event spacing (ON + OFF)
+    uint8_t  amplitude;                 // Default amplitude for every event
+    uint8_t  freqOffset;                // Default encoded frequency for every event
+    uint8_t  patternCount;              // Patterns per macrocycle
+    uint8_t  fingersPerPattern;         // Events per pattern (a permutation of fingers[])
+    uint8_t  fingers[MAX_ACTUATORS];    // SECONDARY finger set, ascending
+
+    MacrocycleTemplate() : durationMs(0), spacingMs(0), amplitude(0), freqOffset(0),
+                           patternCount(0), fingersPerPattern(0), fingers{} {}
+
+    /**
+     * @brief Same event layout (defaults may differ - deltas override them)
+     */
+    bool sameStructure(const MacrocycleTemplate& other) const {
+        if (durationMs != other.durationMs || spacingMs != other.spacingMs ||
+            patternCount != other.patternCount || fingersPerPattern != other.fingersPerPattern) {
+            return false;
+        }
+        for (uint8_t i = 0; i < fingersPerPattern; i++) {
+            if (fingers[i] != other.fingers[i]) return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Timing reference a V7 delta macrocycle is encoded against
+ */
+struct MacrocycleReference {
+    uint32_t sequenceId;
+    uint64_t baseTime;
+    int64_t  clockOffset;
+
+    MacrocycleReference() : sequenceId(0), baseTime(0), clockOffset(0) {}
+};
+
+/**
+ * @brief Therapy timing in fixed point (TIME_ON, TIME_OFF, jitter)
+ *
+ * Durations are integer microseconds and the jitter fraction is Q16
+ * (jitter% / 100, 65536 = 100%). Profiles, settings, the therapy engine and
+ * seeded-session frames all carry this form; floats appear only where text
+ * is parsed or printed, so pattern generation is bit-identical on every MCU
+ * and nothing narrows TIME_ON through a cast.
+ */
+struct TherapyTiming {
+    static constexpr uint32_t Q16_ONE = 65536;
+
+    uint32_t timeOnUs;      // TIME_ON
+    uint32_t timeOffUs;     // TIME_OFF before jitter
+    uint32_t jitterQ16;     // jitter% / 100 in Q16
+
+    constexpr TherapyTiming() : timeOnUs(100000), timeOffUs(67000), jitterQ16(0) {}
+    constexpr TherapyTiming(uint32_t onUs, uint32_t offUs, uint32_t jitter)
+        : timeOnUs(onUs), timeOffUs(offUs), jitterQ16(jitter) {}
+
+    /**
+     * @brief Milliseconds to microseconds, rounded (negative -> 0)
+     */
+    static constexpr uint32_t usFromMs(float ms) {
+        return (ms > 0.0f) ? static_cast<uint32_t>(ms * 1000.0f + 0.5f) : 0;
+    }
+
+    /**
+     * @brief Percent to Q16 fraction, rounded (negative -> 0)
+     */
+    static constexpr uint32_t q16FromPercent(float percent) {
+        return (percent > 0.0f)
+            ? static_cast<uint32_t>(percent * (static_cast<float>(Q16_ONE) / 100.0f) + 0.5f)
+            : 0;
+    }
+
+    /**
+     * @brief Build from profile/phone values (ms, ms, percent)
+     */
+    static constexpr TherapyTiming fromMs(float timeOnMs, float timeOffMs, float jitterPercent) {
+        return TherapyTiming(usFromMs(timeOnMs), usFromMs(timeOffMs), q16FromPercent(jitterPercent));
+    }
+
+    // Display only (logs, profile files, phone responses)
+    float timeOnMs() const { return static_cast<float>(timeOnUs) / 1000.0f; }
+    float timeOffMs() const { return static_cast<float>(timeOffUs) / 1000.0f; }
+    float jitterPercent() const {
+        return static_cast<float>(jitterQ16) * 100.0f / static_cast<float>(Q16_ONE);
+    }
+
+    constexpr bool operator==(const TherapyTiming& other) const {
+        return timeOnUs == other.timeOnUs && timeOffUs == other.timeOffUs && jitterQ16 == other.jitterQ16;
+    }
+    constexpr bool operator!=(const TherapyTiming& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Inputs that fully determine a seeded session's macrocycles
+ *
+ * PRIMARY sends these once per session (V7 'S' frame), and again whenever
+ * they change mid-session (motor failover, frequency randomization). Both gloves run
+ * generateSeededMacrocycle() on them, so macrocycle N is a pure function of
+ * (params, N) and only a "cycle N at baseTime T" tick crosses the link.
+ * Changing the generator requires a new MC_VER capability bit.
+ */
+struct SeededSessionParams {
+    uint32_t seed;                              // Session PRNG seed
+    uint8_t  patternType;                       // PatternType
+    uint8_t  numFingers;                        // Fingers per pattern (<= fingerMapCount)
+    bool     mirrorPattern;
+    uint8_t  amplitudeMin;
+    uint8_t  amplitudeMax;
+    bool     frequencyRandomization;
+    uint16_t frequencyMinHz;
+    uint16_t frequencyMaxHz;
+    TherapyTiming timing;                       // TIME_ON / TIME_OFF / jitter
+    uint8_t  fingerMapCount;                    // Physical fingers patterns map onto
+    uint8_t  fingerMap[MAX_ACTUATORS];
+    uint16_t baseFrequencyHz[MAX_ACTUATORS];    // Per physical finger, without randomization
+
+    SeededSessionParams() : seed(0), patternType(0), numFingers(0), mirrorPattern(false),
+                            amplitudeMin(0), amplitudeMax(0), frequencyRandomization(false),
+                            frequencyMinHz(0), frequencyMaxHz(0), timing(0, 0, 0), fingerMapCount(0),
+                            fingerMap{}, baseFrequencyHz{} {}
+
+    /**
+     * @brief Same generator inputs (a different one needs a new 'S' frame)
+     */
+    bool sameSession(const SeededSessionParams& other) const {
+        if (seed != other.seed || patternType != other.patternType || numFingers != other.numFingers ||
+            mirrorPattern != other.mirrorPattern || amplitudeMin != other.amplitudeMin ||
+            amplitudeMax != other.amplitudeMax || frequencyRandomization != other.frequencyRandomization ||
+            frequencyMinHz != other.frequencyMinHz || frequencyMaxHz != other.frequencyMaxHz ||
+            timing != other.timing || fingerMapCount != other.fingerMapCount) {
+            return false;
+        }
+        for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+            if (fingerMap[i] != other.fingerMap[i] || baseFrequencyHz[i] != other.baseFrequencyHz[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
 #endif // TYPES_H
@@ -6,7 +6,9 @@
  * rail, so their VBAT monitor register (0x21) doubles as a battery
  * voltmeter: VDD = raw * 5.6V / 255 (~22mV LSB). The register is noisy and
  * motor pulses sag the rail, so bursts are reduced by median (rejects sag
- * outliers) and folded into an EMA (smooths across bursts).
+ * outliers) and folded into an EMA (smooths across bursts). Single samples
+ * taken one per idle gap (addSample) get the same treatment over a sliding
+ * window of the most recent VBAT_SAMPLE_WINDOW samples.
  *
  * Pure C++ (no Arduino dependencies) so it builds in native test envs.
  */
@@ -20,6 +22,9 @@
 /** Largest burst addBurst() will use; extra samples are silently ignored. */
 constexpr size_t VBAT_MAX_BURST = 16;
 
+/** Samples in addSample()'s running median window (odd, <= VBAT_MAX_BURST). */
+constexpr size_t VBAT_SAMPLE_WINDOW = 9;
+
 /** Convert a DRV2605 VBAT register value to volts (raw * 5.6 / 255). */
 float vbatRawToVolts(uint8_t raw);
 
@@ -34,12 +39,27 @@ public:
      */
     float addBurst(const uint8_t* raw, size_t count);
 
+    /**
+     * @brief Fold one raw VBAT sample into the running estimate.
+     * The sample joins a sliding window of the last VBAT_SAMPLE_WINDOW
+     * samples; the window's median is folded into the same EMA as a burst
+     * (the first sample seeds the estimate directly). A sag outlier is
+     * rejected once the window holds three or more samples.
+     * @return The updated voltage estimate
+     */
+    float addSample(uint8_t raw);
+
     float voltage() const { return _voltage; }
     bool hasReading() const { return _hasReading; }
 
 private:
+    void fold(uint8_t medianRaw);
+
     float _voltage = 0.0f;
     bool _hasReading = false;
+    uint8_t _window[VBAT_SAMPLE_WINDOW] = {};
+    uint8_t _windowCount = 0;
+    uint8_t _windowNext = 0;
 };
 
 #endif // VBAT_ESTIMATOR_H
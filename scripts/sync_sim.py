@@ -0,0 +1,288 @@
+#!/usr/bin/env python3
+"""Host sync simulator: replay PTP sessions through SimpleSyncProtocol.
+
+Compiles scripts/sync_sim/sync_sim.cpp against the firmware's
+sync_protocol.cpp, clock_servo.cpp and ping_scheduler.cpp (native mocks),
+once per combination of SYNC_* overrides, then runs every session against
+every build in parallel across host cores and ranks the builds.
+
+Sessions are either recorded or synthetic:
+
+  --trace FILE|DIR   CSV (t1,t2,t3,t4[,phone[,phy]]) or a serial log from a
+                     PRIMARY in debug mode ([PTP] lines plus "[BLE] PHY
+                     changed" lines). The log carries the low 32 bits of
+                     each timestamp; they are unwrapped here.
+  --synth SPEC       key=value,... link model (see sync_sim.cpp SynthSpec):
+                     duration, seed, ppm, ppm_ramp, ci, retx, loss, phy,
+                     phy_switch=S:PHY, phone=START-END, asym, ...
+                     --seeds N replicates each spec over seeds 1..N.
+
+Overrides are compile-time (config.h guards the tunables with #ifndef):
+
+  -D NAME=VALUE      applied to every build
+  --sweep NAME=a,b   one build per value; several --sweep form a grid
+
+Examples:
+  scripts/sync_sim.py --synth duration=900,phone=300-600 --seeds 200
+  scripts/sync_sim.py --trace logs/ --sweep SYNC_LUCKY_RTT_MARGIN_US=5000,10000,20000
+  scripts/sync_sim.py --synth duration=600 --seeds 100 -D SYNC_CLOCK_SERVO_ENABLED=1 \\
+      --sweep SYNC_PING_MAX_INTERVAL_MS=1000,2000,3000
+
+Recorded sessions have no ground truth: error is measured against a line
+fitted through the session's fastest-decile exchanges (see sync_sim.cpp).
+"""
+
+import argparse
+import concurrent.futures
+import hashlib
+import itertools
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+BUILD_ROOT = os.path.join(ROOT, ".pio", "sync_sim")
+SOURCES = [
+    "scripts/sync_sim/sync_sim.cpp",
+    "src/sync_protocol.cpp",
+    "src/clock_servo.cpp",
+    "src/ping_scheduler.cpp",
+    "test/mocks/src/Arduino.cpp",
+]
+HEADERS = ["include/config.h", "include/sync_protocol.h", "include/clock_servo.h",
+           "include/ping_scheduler.h", "include/board_config.h", "include/platform.h"]
+BASE_FLAGS = ["-std=c++20", "-O2", "-w", "-DNATIVE_TEST_BUILD", "-DARDUINO=100",
+              "-DBOARD_BLUEBUZZAH_NRF52", "-Iinclude", "-Itest/mocks/src"]
+
+PTP_LINE = re.compile(r"\[PTP\] (\d+),(\d+),(\d+),(\d+),(\d)")
+PHY_LINE = re.compile(r"PHY changed to (2M|1M|Coded)")
+PHY_CODES = {"2M": 2, "1M": 1, "Coded": 4}
+MASK32 = 0xFFFFFFFF
+
+
+# =============================================================================
+# BUILD
+# =============================================================================
+
+def build(defines):
+    """Compile one simulator binary for a set of -D overrides (cached)."""
+    flags = BASE_FLAGS + ["-D%s=%s" % item for item in sorted(defines.items())]
+    key = hashlib.sha1(" ".join(flags).encode()).hexdigest()[:12]
+    out_dir = os.path.join(BUILD_ROOT, key)
+    binary = os.path.join(out_dir, "sync_sim")
+
+    inputs = [os.path.join(ROOT, path) for path in SOURCES + HEADERS]
+    if os.path.exists(binary) and os.path.getmtime(binary) >= max(map(os.path.getmtime, inputs)):
+        return binary
+
+    os.makedirs(out_dir, exist_ok=True)
+    cmd = [os.environ.get("CXX", "g++")] + flags + SOURCES + ["-o", binary]
+    result = subprocess.run(cmd, cwd=ROOT, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.exit("build failed for %s:\n%s" % (defines, result.stderr))
+    return binary
+
+
+# =============================================================================
+# SESSIONS
+# =============================================================================
+
+def log_to_csv(path, out_path):
+    """Extract [PTP] quadruples from a serial log and unwrap them to 64 bits."""
+    rows = []
+    phy = 2
+    prev = None
+    with open(path, errors="replace") as log:
+        for line in log:
+            change = PHY_LINE.search(line)
+            if change:
+                phy = PHY_CODES[change.group(1)]
+                continue
+            match = PTP_LINE.search(line)
+            if not match:
+                continue
+            t1, t2, t3, t4, phone = (int(v) for v in match.groups())
+            if prev is None:
+                t1_64 = t1
+                # Offset modulo 2^32 us: the filters are offset-invariant
+                t2_64 = t1_64 + (((t2 - t1 + 2**31) & MASK32) - 2**31)
+                if t2_64 < 0:
+                    t2_64 += 2**32
+            else:
+                t1_64 = prev[0] + ((t1 - prev[0]) & MASK32)
+                t2_64 = prev[1] + ((t2 - prev[1]) & MASK32)
+            prev = (t1_64, t2_64)
+            rows.append((t1_64, t2_64, t2_64 + ((t3 - t2) & MASK32),
+                         t1_64 + ((t4 - t1) & MASK32), phone, phy))
+
+    with open(out_path, "w") as out:
+        out.write("t1,t2,t3,t4,phone,phy\n")
+        for row in rows:
+            out.write("%d,%d,%d,%d,%d,%d\n" % row)
+    return len(rows)
+
+
+def collect_sessions(args):
+    """(label, simulator arguments) for every session."""
+    sessions = []
+    trace_dir = os.path.join(BUILD_ROOT, "traces")
+
+    paths = []
+    for trace in args.trace:
+        if os.path.isdir(trace):
+            paths += sorted(os.path.join(trace, name) for name in os.listdir(trace)
+                            if name.endswith((".csv", ".log", ".txt")))
+        else:
+            paths.append(trace)
+    for path in paths:
+        label = os.path.splitext(os.path.basename(path))[0]
+        with open(path, errors="replace") as f:
+            is_csv = f.readline().startswith("t1,")
+        if not is_csv:
+            os.makedirs(trace_dir, exist_ok=True)
+            csv_path = os.path.join(trace_dir, label + ".csv")
+            if log_to_csv(path, csv_path) == 0:
+                print("skipping %s: no [PTP] lines" % path, file=sys.stderr)
+                continue
+            path = csv_path
+        sessions.append((label, ["--trace", path]))
+
+    for index, spec in enumerate(args.synth):
+        if "seed=" in spec or args.seeds <= 1:
+            sessions.append(("synth%d" % index, ["--synth", spec]))
+        else:
+            for seed in range(1, args.seeds + 1):
+                sessions.append(("synth%d.s%d" % (index, seed), ["--synth", "%s,seed=%d" % (spec, seed)]))
+    return sessions
+
+
+def parse_defines(items):
+    defines = {}
+    for item in items:
+        name, _, value = item.partition("=")
+        defines[name] = value or "1"
+    return defines
+
+
+def sweep_grid(fixed, sweeps):
+    names = [name for name, _ in sweeps]
+    values = [vals for _, vals in sweeps]
+    for combo in itertools.product(*values) if sweeps else [()]:
+        defines = dict(fixed)
+        defines.update(zip(names, combo))
+        yield defines, dict(zip(names, combo))
+
+
+# =============================================================================
+# RUN
+# =============================================================================
+
+def run_one(binary, label, session_args, options, timeline):
+    cmd = [binary, "--label", label] + session_args + options
+    if timeline:
+        cmd += ["--timeline", timeline]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        return {"label": label, "error": result.stderr.strip()}
+    return json.loads(result.stdout.strip().splitlines()[-1])
+
+
+def summarize(results):
+    ok = [r for r in results if "error" not in r]
+    if not ok:
+        return {"sessions": 0, "failed": len(results)}
+    settled = [r["settle_ms"] for r in ok if r["settle_ms"] >= 0]
+    checks = sum(r["late_checks"] for r in ok)
+    samples = sum(r["samples"] for r in ok)
+    return {
+        "sessions": len(ok),
+        "failed": len(results) - len(ok),
+        "err_p95_us_mean": statistics.mean(r["err_p95_us"] for r in ok),
+        "err_max_us": max(r["err_max_us"] for r in ok),
+        "valid_ms_median": statistics.median(r["valid_ms"] for r in ok),
+        "settle_ms_median": statistics.median(settled) if settled else -1,
+        "unsettled": len(ok) - len(settled),
+        "lead_p50_us_mean": statistics.mean(r["lead_p50_us"] for r in ok),
+        "late_pct": 100.0 * sum(r["late"] for r in ok) / checks if checks else 0.0,
+        "accepted_pct": 100.0 * sum(r["accepted"] for r in ok) / samples if samples else 0.0,
+        "pings_mean": statistics.mean(r["pings"] for r in ok),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--trace", action="append", default=[], help="recorded session (CSV or serial log) or directory")
+    parser.add_argument("--synth", action="append", default=[], help="synthetic session spec")
+    parser.add_argument("--seeds", type=int, default=1, help="replicate each --synth over seeds 1..N")
+    parser.add_argument("-D", dest="define", action="append", default=[], help="NAME=VALUE for every build")
+    parser.add_argument("--sweep", action="append", default=[], help="NAME=v1,v2,... (one build per value)")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="parallel sessions (default: all cores)")
+    parser.add_argument("--grid-ms", type=int, default=100, help="offset error sampling period")
+    parser.add_argument("--tol-us", type=int, default=1000, help="settled when |error| stays within this")
+    parser.add_argument("--mc-overhead-us", type=int, default=6000, help="actual MACROCYCLE generation + processing")
+    parser.add_argument("--timeline-dir", help="write a per-session error/lead timeline CSV here")
+    parser.add_argument("--json", help="write every session result and summary here")
+    args = parser.parse_args()
+
+    sessions = collect_sessions(args)
+    if not sessions:
+        parser.error("no sessions: give --trace and/or --synth")
+
+    fixed = parse_defines(args.define)
+    sweeps = []
+    for item in args.sweep:
+        name, _, values = item.partition("=")
+        sweeps.append((name, values.split(",")))
+    configs = list(sweep_grid(fixed, sweeps))
+    options = ["--grid-ms", str(args.grid_ms), "--tol-us", str(args.tol_us),
+               "--mc-overhead-us", str(args.mc_overhead_us)]
+    if args.timeline_dir:
+        os.makedirs(args.timeline_dir, exist_ok=True)
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        binaries = list(pool.map(lambda config: build(config[0]), configs))
+
+        futures = {}
+        for c, binary in enumerate(binaries):
+            for label, session_args in sessions:
+                timeline = None
+                if args.timeline_dir:
+                    timeline = os.path.join(args.timeline_dir, "c%d_%s.csv" % (c, label))
+                future = pool.submit(run_one, binary, label, session_args, options, timeline)
+                futures[future] = c
+
+        results = [[] for _ in configs]
+        for future in concurrent.futures.as_completed(futures):
+            results[futures[future]].append(future.result())
+
+    report = []
+    for (defines, swept), runs in zip(configs, results):
+        runs.sort(key=lambda r: r["label"])
+        report.append({"defines": defines, "swept": swept, "summary": summarize(runs), "sessions": runs})
+        for r in runs:
+            if "error" in r:
+                print("%s: %s" % (r["label"], r["error"]), file=sys.stderr)
+    report.sort(key=lambda entry: entry["summary"].get("err_p95_us_mean", float("inf")))
+
+    print("%d sessions x %d builds" % (len(sessions), len(configs)))
+    print("%-40s %9s %9s %9s %9s %6s %9s %7s %7s" % ("config", "p95_us", "max_us", "valid_ms", "settle_ms",
+                                                   "unset", "lead_us", "late%", "acc%"))
+    for entry in report:
+        s = entry["summary"]
+        if not s["sessions"]:
+            continue
+        name = ",".join("%s=%s" % (k.replace("SYNC_", ""), v) for k, v in entry["swept"].items()) or "baseline"
+        print("%-40s %9.0f %9.0f %9.0f %9.0f %6d %9.0f %7.2f %7.1f" % (
+            name[:40], s["err_p95_us_mean"], s["err_max_us"], s["valid_ms_median"], s["settle_ms_median"],
+            s["unsettled"], s["lead_p50_us_mean"], s["late_pct"], s["accepted_pct"]))
+
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(report, out, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,578 @@
+/**
+ * @file sync_sim.cpp
+ * @brief Host replay of PING/PONG exchanges through SimpleSyncProtocol
+ *
+ * Drives the PRIMARY's clock sync exactly as main.cpp does - PTP offset,
+ * quality-gated update, latency EMA, asymmetry, PHY-change reset - from
+ * either a recorded trace or a synthetic link model, and scores the result:
+ * offset error against the true (or best-fit) offset every --grid-ms,
+ * adaptive lead-time choices, late deliveries and convergence time.
+ *
+ * Built and driven by scripts/sync_sim.py, which compiles one binary per
+ * set of SYNC_* overrides and runs sessions in parallel. One session per
+ * process: getMicros() overflow tracking is global state.
+ *
+ * Usage:
+ *   sync_sim --synth key=value,... | --trace file.csv
+ *            [--label name] [--timeline out.csv] [--dump-trace out.csv]
+ *            [--grid-ms 100] [--tol-us 1000] [--mc-overhead-us 6000]
+ *
+ * Prints one JSON summary line on stdout. --dump-trace writes a synthetic
+ * session's delivered exchanges in the recorded-trace format.
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "config.h"
+#include "ping_scheduler.h"
+#include "sync_protocol.h"
+
+// =============================================================================
+// SESSION MODEL
+// =============================================================================
+
+/**
+ * @brief Synthetic link between PRIMARY and SECONDARY
+ *
+ * One-way delay = stack + wait for the next connection event + link-layer
+ * retransmissions (whole intervals) + 1M PHY airtime, plus, PRIMARY ->
+ * SECONDARY only, the phone link's share of PRIMARY's radio while the phone
+ * is connected. SECONDARY's clock runs ppm fast (ramping ppmRamp per hour,
+ * e.g. warming up) from a fixed boot offset.
+ */
+struct SynthSpec {
+    double durationS = 600.0;
+    uint64_t seed = 1;
+    double ppm = 20.0;
+    double ppmRamp = 0.0;
+    double offsetUs = 123456789.0;
+    double ciMs = 7.5;
+    double stackUs = 1500.0;
+    double retx = 0.05;
+    double loss = 0.01;
+    double procMinUs = 300.0;
+    double procMaxUs = 1500.0;
+    double phy1ExtraUs = 4000.0;
+    double asymUs = 3000.0;
+    double phoneJitterUs = 7500.0;
+    uint8_t phy = 2;
+    bool therapy = true;
+    std::vector<std::pair<double, uint8_t>> phySwitches;   // (time s, PHY)
+    std::vector<std::pair<double, double>> phoneWindows;   // (start s, end s)
+};
+
+/**
+ * @brief One recorded exchange (trace CSV row)
+ */
+struct TraceSample {
+    uint64_t t1, t2, t3, t4;
+    bool phone;
+    uint8_t phy;
+};
+
+struct SimOptions {
+    std::string label = "session";
+    std::string timelinePath;
+    std::string dumpPath;
+    uint32_t gridMs = 100;
+    uint32_t tolUs = 1000;
+    uint32_t mcOverheadUs = 6000;  // Actual MACROCYCLE generation + SECONDARY processing
+};
+
+struct SimResult {
+    uint32_t pings = 0;
+    uint32_t samples = 0;
+    uint32_t accepted = 0;
+    uint32_t late = 0;
+    uint32_t lateChecks = 0;
+    int64_t validMs = -1;
+    int64_t settleMs = -1;
+    std::vector<double> absErrors;
+    std::vector<double> leads;
+};
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+// =============================================================================
+// PRIMARY SIDE (mirrors main.cpp)
+// =============================================================================
+
+static SimpleSyncProtocol g_sync;
+static PingScheduler g_pings;
+
+static void setNowUs(uint64_t nowUs) {
+    _mock_micros = static_cast<uint32_t>(nowUs);
+    _mock_millis = static_cast<uint32_t>(nowUs / 1000);
+    (void)getMicros();  // Keep the 32-bit wrap tracking in step
+}
+
+static void onPhyChange() {
+    g_sync.resetLatency();
+    g_sync.resetAsymmetryTracking();
+    g_pings.requestBurst();
+    if (g_sync.getOffsetSampleCount() > 0 && g_sync.getOffsetSampleCount() < SYNC_MIN_VALID_SAMPLES) {
+        g_sync.resetClockSync();
+    }
+}
+
+static bool onPong(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4, bool phone) {
+    uint32_t processingTime = (t3 < t2) ? 0 : static_cast<uint32_t>(t3 - t2);
+    uint32_t rtt = static_cast<uint32_t>(t4 - t1) - processingTime;
+    int64_t offset = g_sync.calculatePTPOffset(t1, t2, t3, t4);
+    bool accepted = g_sync.updateOffsetEMAWithQuality(offset, rtt);
+    g_pings.onPong(accepted);
+    g_sync.updateLatency(rtt);
+    g_sync.recordAsymmetry(t1, t2, t3, t4, phone);
+    return accepted;
+}
+
+// =============================================================================
+// SCORING
+// =============================================================================
+
+class Scorer {
+public:
+    Scorer(const SimOptions& options, SimResult& result) : _options(options), _result(result) {
+        if (!options.timelinePath.empty()) {
+            _timeline = fopen(options.timelinePath.c_str(), "w");
+            if (_timeline != nullptr) {
+                fprintf(_timeline, "t_ms,valid,error_us,lead_us,interval_ms\n");
+            }
+        }
+    }
+
+    ~Scorer() {
+        if (_timeline != nullptr) {
+            fclose(_timeline);
+        }
+    }
+
+    /** @brief Grid point: estimate in use vs the true offset */
+    void sample(uint64_t tMs, double trueOffsetUs, uint32_t intervalMs) {
+        bool valid = g_sync.isClockSyncValid();
+        double error = valid ? static_cast<double>(g_sync.getCorrectedOffset()) - trueOffsetUs : 0.0;
+        uint32_t lead = g_sync.calculateAdaptiveLeadTime();
+        if (valid) {
+            if (_result.validMs < 0) {
+                _result.validMs = static_cast<int64_t>(tMs);
+            }
+            _result.absErrors.push_back(std::fabs(error));
+        }
+        if (!valid || std::fabs(error) > _options.tolUs) {
+            _lastViolationMs = static_cast<int64_t>(tMs);
+        }
+        _result.leads.push_back(lead);
+        if (_timeline != nullptr) {
+            fprintf(_timeline, "%llu,%d,%.0f,%lu,%lu\n", static_cast<unsigned long long>(tMs), valid ? 1 : 0,
+                    error, static_cast<unsigned long>(lead), static_cast<unsigned long>(intervalMs));
+        }
+        _endMs = tMs;
+    }
+
+    /** @brief Would a MACROCYCLE sent now, with this one-way delay, be late? */
+    void delivery(double forwardUs) {
+        _result.lateChecks++;
+        if (forwardUs + _options.mcOverheadUs > g_sync.calculateAdaptiveLeadTime()) {
+            _result.late++;
+        }
+    }
+
+    void finish() {
+        // Settled after the last grid point out of tolerance (never if it is the last one)
+        if (_lastViolationMs < 0) {
+            _result.settleMs = 0;
+        } else if (static_cast<uint64_t>(_lastViolationMs) < _endMs) {
+            _result.settleMs = _lastViolationMs + _options.gridMs;
+        }
+    }
+
+private:
+    const SimOptions& _options;
+    SimResult& _result;
+    FILE* _timeline = nullptr;
+    int64_t _lastViolationMs = -1;
+    uint64_t _endMs = 0;
+};
+
+// =============================================================================
+// SYNTHETIC SESSION
+// =============================================================================
+
+class SynthLink {
+public:
+    explicit SynthLink(const SynthSpec& spec) : _spec(spec), _rng(spec.seed), _uniform(0.0, 1.0) {}
+
+    double trueOffsetUs(double tUs) const {
+        double hours = tUs / 3.6e9;
+        double ppm = _spec.ppm + 0.5 * _spec.ppmRamp * hours;
+        return _spec.offsetUs + ppm * 1e-6 * tUs;
+    }
+
+    uint64_t secondaryClock(double tUs) const {
+        return static_cast<uint64_t>(tUs + trueOffsetUs(tUs));
+    }
+
+    uint8_t phyAt(double tS) const {
+        uint8_t phy = _spec.phy;
+        for (const auto& change : _spec.phySwitches) {
+            if (tS >= change.first) {
+                phy = change.second;
+            }
+        }
+        return phy;
+    }
+
+    bool phoneAt(double tS) const {
+        for (const auto& window : _spec.phoneWindows) {
+            if (tS >= window.first && tS < window.second) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    double oneWayUs(double tS, bool toSecondary) {
+        double ciUs = _spec.ciMs * 1000.0;
+        double delay = _spec.stackUs + _uniform(_rng) * ciUs;
+        while (_uniform(_rng) < _spec.retx) {
+            delay += ciUs;
+        }
+        if (phyAt(tS) == 1) {
+            delay += _spec.phy1ExtraUs;
+        }
+        if (toSecondary && phoneAt(tS)) {
+            delay += _spec.asymUs + _uniform(_rng) * _spec.phoneJitterUs;
+        }
+        return delay;
+    }
+
+    double processingUs() {
+        return _spec.procMinUs + _uniform(_rng) * (_spec.procMaxUs - _spec.procMinUs);
+    }
+
+    bool lost() {
+        return _uniform(_rng) < _spec.loss;
+    }
+
+private:
+    const SynthSpec& _spec;
+    std::mt19937_64 _rng;
+    std::uniform_real_distribution<double> _uniform;
+};
+
+static void runSynth(const SynthSpec& spec, const SimOptions& options, SimResult& result) {
+    SynthLink link(spec);
+    Scorer scorer(options, result);
+
+    struct PendingPong {
+        bool active;
+        uint64_t t1, t2, t3, t4;
+        bool phone;
+    } pending = {};
+
+    const uint64_t endMs = static_cast<uint64_t>(spec.durationS * 1000.0);
+    uint8_t phy = link.phyAt(0.0);
+    g_pings.requestBurst();  // Link up
+
+    FILE* dump = options.dumpPath.empty() ? nullptr : fopen(options.dumpPath.c_str(), "w");
+    if (dump != nullptr) {
+        fprintf(dump, "t1,t2,t3,t4,phone,phy\n");
+    }
+
+    for (uint64_t nowMs = 0; nowMs <= endMs; nowMs++) {
+        uint64_t nowUs = nowMs * 1000;
+        double tS = nowMs / 1000.0;
+        if (pending.active && pending.t4 <= nowUs) {
+            // PONG handled at its arrival time (the clock never steps back)
+            pending.active = false;
+            setNowUs(pending.t4);
+            result.samples++;
+            if (onPong(pending.t1, pending.t2, pending.t3, pending.t4, pending.phone)) {
+                result.accepted++;
+            }
+            if (dump != nullptr) {
+                fprintf(dump, "%llu,%llu,%llu,%llu,%d,%u\n", static_cast<unsigned long long>(pending.t1),
+                        static_cast<unsigned long long>(pending.t2), static_cast<unsigned long long>(pending.t3),
+                        static_cast<unsigned long long>(pending.t4), pending.phone ? 1 : 0, phy);
+            }
+        }
+        setNowUs(nowUs);
+
+        uint8_t newPhy = link.phyAt(tS);
+        if (newPhy != phy) {
+            phy = newPhy;
+            onPhyChange();
+        }
+
+        if (g_pings.update(static_cast<uint32_t>(nowMs), g_sync.isClockSyncValid(),
+                           g_sync.getOffsetUncertaintyUs(), spec.therapy)) {
+            result.pings++;
+            bool phone = link.phoneAt(tS);
+            double forward = link.oneWayUs(tS, true);
+            double processing = link.processingUs();
+            double back = link.oneWayUs(tS, false);
+            if (!link.lost()) {
+                pending.active = true;
+                pending.t1 = nowUs;
+                pending.t2 = link.secondaryClock(nowUs + forward);
+                pending.t3 = link.secondaryClock(nowUs + forward + processing);
+                pending.t4 = nowUs + static_cast<uint64_t>(forward + processing + back);
+                pending.phone = phone;
+            }
+            if (spec.therapy && g_sync.isClockSyncValid()) {
+                // A MACROCYCLE sent now sees the same forward path
+                scorer.delivery(forward);
+            }
+        }
+
+        if (nowMs % options.gridMs == 0) {
+            scorer.sample(nowMs, link.trueOffsetUs(static_cast<double>(nowUs)), g_pings.intervalMs());
+        }
+    }
+    scorer.finish();
+    if (dump != nullptr) {
+        fclose(dump);
+    }
+}
+
+// =============================================================================
+// RECORDED SESSION
+// =============================================================================
+
+static bool loadTrace(const char* path, std::vector<TraceSample>& trace) {
+    FILE* in = fopen(path, "r");
+    if (in == nullptr) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), in) != nullptr) {
+        if (line[0] == '#' || line[0] == 't' || line[0] == '\n') {
+            continue;  // Comment or header
+        }
+        unsigned long long t1, t2, t3, t4;
+        int phone = 0;
+        int phy = 2;
+        if (sscanf(line, "%llu,%llu,%llu,%llu,%d,%d", &t1, &t2, &t3, &t4, &phone, &phy) >= 4) {
+            trace.push_back({t1, t2, t3, t4, phone != 0, static_cast<uint8_t>(phy)});
+        }
+    }
+    fclose(in);
+    return !trace.empty();
+}
+
+/**
+ * @brief Hindsight reference: least-squares line through the lucky packets
+ *
+ * A recording has no ground truth. Exchanges within the fastest decile of
+ * RTTs carry the least queuing, so a line through their offsets over the
+ * whole session is the best available estimate of the true offset (linear:
+ * assumes a constant skew over the recording).
+ */
+static void fitReference(const std::vector<TraceSample>& trace, double& a, double& b) {
+    std::vector<double> rtts;
+    for (const auto& s : trace) {
+        rtts.push_back(static_cast<double>(static_cast<int64_t>(s.t4 - s.t1) - static_cast<int64_t>(s.t3 - s.t2)));
+    }
+    double threshold = percentile(rtts, 0.1);
+    double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    uint64_t base = trace.front().t1;
+    for (size_t i = 0; i < trace.size(); i++) {
+        if (rtts[i] > threshold && n >= 3) {
+            continue;
+        }
+        const auto& s = trace[i];
+        double x = static_cast<double>(s.t4 - base);
+        double y = 0.5 * ((static_cast<double>(s.t2) - static_cast<double>(s.t1)) +
+                          (static_cast<double>(s.t3) - static_cast<double>(s.t4)));
+        n++;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double denom = n * sxx - sx * sx;
+    b = (n > 1 && denom != 0.0) ? (n * sxy - sx * sy) / denom : 0.0;
+    a = (sy - b * sx) / n;
+}
+
+static void runTrace(const std::vector<TraceSample>& trace, const SimOptions& options, SimResult& result) {
+    Scorer scorer(options, result);
+    double a = 0.0;
+    double b = 0.0;
+    fitReference(trace, a, b);
+
+    // Simulation time starts at the first PING; the reference is relative to it
+    const uint64_t base = trace.front().t1;
+    auto reference = [&](uint64_t primaryUs) { return a + b * static_cast<double>(primaryUs - base); };
+
+    uint8_t phy = trace.front().phy;
+    uint64_t nextGridMs = 0;
+    for (const auto& s : trace) {
+        uint64_t t4Ms = (s.t4 - base) / 1000;
+        while (nextGridMs <= t4Ms) {
+            setNowUs(nextGridMs * 1000);
+            scorer.sample(nextGridMs, reference(base + nextGridMs * 1000), 0);
+            nextGridMs += options.gridMs;
+        }
+
+        setNowUs(s.t4 - base);
+        if (s.phy != phy) {
+            phy = s.phy;
+            onPhyChange();
+        }
+        if (g_sync.isClockSyncValid()) {
+            scorer.delivery(static_cast<double>(s.t2) - reference(s.t1) - static_cast<double>(s.t1));
+        }
+
+        result.pings++;
+        result.samples++;
+        if (onPong(s.t1 - base, s.t2 - base, s.t3 - base, s.t4 - base, s.phone)) {
+            result.accepted++;
+        }
+    }
+    scorer.finish();
+}
+
+// =============================================================================
+// COMMAND LINE
+// =============================================================================
+
+static bool parseSynth(const char* text, SynthSpec& spec) {
+    std::string all(text);
+    size_t pos = 0;
+    while (pos < all.size()) {
+        size_t end = all.find(',', pos);
+        if (end == std::string::npos) {
+            end = all.size();
+        }
+        std::string item = all.substr(pos, end - pos);
+        pos = end + 1;
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            continue;
+        }
+        std::string key = item.substr(0, eq);
+        const char* value = item.c_str() + eq + 1;
+        double number = atof(value);
+
+        if (key == "duration") spec.durationS = number;
+        else if (key == "seed") spec.seed = strtoull(value, nullptr, 10);
+        else if (key == "ppm") spec.ppm = number;
+        else if (key == "ppm_ramp") spec.ppmRamp = number;
+        else if (key == "offset") spec.offsetUs = number;
+        else if (key == "ci") spec.ciMs = number;
+        else if (key == "stack") spec.stackUs = number;
+        else if (key == "retx") spec.retx = number;
+        else if (key == "loss") spec.loss = number;
+        else if (key == "proc_min") spec.procMinUs = number;
+        else if (key == "proc_max") spec.procMaxUs = number;
+        else if (key == "phy1_extra") spec.phy1ExtraUs = number;
+        else if (key == "asym") spec.asymUs = number;
+        else if (key == "phone_jitter") spec.phoneJitterUs = number;
+        else if (key == "phy") spec.phy = static_cast<uint8_t>(number);
+        else if (key == "therapy") spec.therapy = number != 0.0;
+        else if (key == "phy_switch") {
+            // phy_switch=SECONDS:PHY (repeatable)
+            const char* colon = strchr(value, ':');
+            if (colon == nullptr) return false;
+            spec.phySwitches.push_back({number, static_cast<uint8_t>(atoi(colon + 1))});
+        } else if (key == "phone") {
+            // phone=START-END seconds (repeatable)
+            const char* dash = strchr(value, '-');
+            if (dash == nullptr) return false;
+            spec.phoneWindows.push_back({number, atof(dash + 1)});
+        } else {
+            fprintf(stderr, "unknown synth key: %s\n", key.c_str());
+            return false;
+        }
+    }
+    return spec.durationS > 0 && spec.ciMs > 0;
+}
+
+static void printSummary(const SimOptions& options, const SimResult& result) {
+    printf("{\"label\": \"%s\", \"pings\": %lu, \"samples\": %lu, \"accepted\": %lu, "
+           "\"valid_ms\": %lld, \"settle_ms\": %lld, "
+           "\"err_p50_us\": %.0f, \"err_p95_us\": %.0f, \"err_max_us\": %.0f, "
+           "\"lead_p50_us\": %.0f, \"lead_max_us\": %.0f, \"late\": %lu, \"late_checks\": %lu}\n",
+           options.label.c_str(), static_cast<unsigned long>(result.pings),
+           static_cast<unsigned long>(result.samples), static_cast<unsigned long>(result.accepted),
+           static_cast<long long>(result.validMs), static_cast<long long>(result.settleMs),
+           percentile(result.absErrors, 0.5), percentile(result.absErrors, 0.95),
+           percentile(result.absErrors, 1.0), percentile(result.leads, 0.5), percentile(result.leads, 1.0),
+           static_cast<unsigned long>(result.late), static_cast<unsigned long>(result.lateChecks));
+}
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    SynthSpec spec;
+    const char* tracePath = nullptr;
+    bool synth = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 2;
+        }
+        i++;
+        if (strcmp(arg, "--synth") == 0) {
+            if (!parseSynth(value, spec)) {
+                fprintf(stderr, "bad synth spec: %s\n", value);
+                return 2;
+            }
+            synth = true;
+        } else if (strcmp(arg, "--trace") == 0) {
+            tracePath = value;
+        } else if (strcmp(arg, "--label") == 0) {
+            options.label = value;
+        } else if (strcmp(arg, "--timeline") == 0) {
+            options.timelinePath = value;
+        } else if (strcmp(arg, "--dump-trace") == 0) {
+            options.dumpPath = value;
+        } else if (strcmp(arg, "--grid-ms") == 0) {
+            options.gridMs = static_cast<uint32_t>(atoi(value));
+        } else if (strcmp(arg, "--tol-us") == 0) {
+            options.tolUs = static_cast<uint32_t>(atoi(value));
+        } else if (strcmp(arg, "--mc-overhead-us") == 0) {
+            options.mcOverheadUs = static_cast<uint32_t>(atoi(value));
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+    }
+    if (synth == (tracePath != nullptr) || options.gridMs == 0) {
+        fprintf(stderr, "usage: sync_sim --synth key=value,... | --trace file.csv [options]\n");
+        return 2;
+    }
+
+    mockResetTime();
+    resetMicrosOverflow();
+    SimResult result;
+    if (synth) {
+        runSynth(spec, options, result);
+    } else {
+        std::vector<TraceSample> trace;
+        if (!loadTrace(tracePath, trace)) {
+            return 1;
+        }
+        runTrace(trace, options, result);
+    }
+    printSummary(options, result);
+    return 0;
+}
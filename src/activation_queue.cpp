@@ -1,13 +1,14 @@
 /**
  * @file activation_queue.cpp
  * @brief Unified motor event queue for FreeRTOS-based motor control
- * @version 3.1.0
+ * @version 3.2.0
  *
  * Pure FreeRTOS architecture - motor task handles both activations
  * and deactivations with unified timing.
  *
- * Thread Safety: All public methods are protected by FreeRTOS mutex.
+ * Thread Safety: All mutating methods are protected by FreeRTOS mutex.
  * Queue is accessed from main loop, BLE callbacks, and motor task.
+ * eventCount()/isEmpty() read the count without the mutex (snapshot).
  */
 
 #include "activation_queue.h"
@@ -60,7 +61,10 @@ private:
 // =============================================================================
 
 ActivationQueue::ActivationQueue()
-    : _haptic(nullptr)
+    : _head(0)
+    , _count(0)
+    , _revision(0)
+    , _haptic(nullptr)
     , _motorTaskHandle(nullptr)
     , _queueMutex(nullptr)
     , _initialized(false)
@@ -95,54 +99,32 @@ void ActivationQueue::clear() {
     QueueMutexLock lock(_queueMutex);
     // Proceed even if lock not acquired - safety operation
 
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        _events[i].clear();
+    // Only occupied slots need clearing; the rest are already clear
+    for (uint8_t pos = 0; pos < _count; pos++) {
+        _events[ringIndex(pos)].clear();
     }
+    _head = 0;
+    _count = 0;
+    _revision = _revision + 1;
 }
 
-int8_t ActivationQueue::findEmptySlot() const {
-    // NOTE: Caller must hold mutex
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (!_events[i].active) {
-            return static_cast<int8_t>(i);
-        }
-    }
-    return -1;
-}
-
-int8_t ActivationQueue::findNextEvent() const {
-    // NOTE: Caller must hold mutex
-    int8_t earliestIdx = -1;
-    uint64_t earliestTime = UINT64_MAX;
-
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (_events[i].active) {
-            if (_events[i].timeUs < earliestTime) {
-                earliestTime = _events[i].timeUs;
-                earliestIdx = static_cast<int8_t>(i);
-            }
+void ActivationQueue::insertSorted(const MotorEvent& event) {
+    // NOTE: Caller must hold mutex and have checked capacity
+    // Shift later events up by one from the tail. Strict '>' keeps events
+    // with equal times in insertion order.
+    uint8_t pos = _count;
+    while (pos > 0) {
+        const MotorEvent& prev = _events[ringIndex(pos - 1)];
+        if (prev.timeUs <= event.timeUs) {
+            break;
         }
+        _events[ringIndex(pos)] = prev;
+        pos--;
     }
 
-    return earliestIdx;
-}
-
-int8_t ActivationQueue::addEvent(const MotorEvent& event) {
-    // NOTE: Caller must hold mutex
-    int8_t slot = findEmptySlot();
-    if (slot < 0) {
-        // Verbose logging for queue full (M5 fix)
-        Serial.printf("[QUEUE] FULL! Cannot add F%d %s event at T=%lu ms (count=%d/%d)\n",
-                      event.finger,
-                      (event.type == MotorEventType::ACTIVATE) ? "ACTIVATE" : "DEACTIVATE",
-                      static_cast<unsigned long>(event.timeUs / 1000),
-                      eventCount(), MAX_EVENTS);
-        return -1;
-    }
-
-    _events[slot] = event;
-    _events[slot].active = true;
-    return slot;
+    _events[ringIndex(pos)] = event;
+    _events[ringIndex(pos)].active = true;
+    _count = static_cast<uint8_t>(_count + 1);
 }
 
 bool ActivationQueue::enqueue(uint64_t activateTimeUs, uint8_t finger, uint8_t amplitude,
@@ -153,6 +135,17 @@ bool ActivationQueue::enqueue(uint64_t activateTimeUs, uint8_t finger, uint8_t a
         return false;
     }
 
+    // Activation and deactivation are added as a pair: check room for both
+    // up front so a full queue never leaves a half-added activation behind
+    if (_count > MAX_EVENTS - 2) {
+        // Verbose logging for queue full (M5 fix)
+        Serial.printf("[QUEUE] FULL! Cannot add F%d event pair at T=%lu ms (count=%d/%d)\n",
+                      finger,
+                      static_cast<unsigned long>(activateTimeUs / 1000),
+                      _count, MAX_EVENTS);
+        return false;
+    }
+
     // Create activation event
     MotorEvent actEvent;
     actEvent.timeUs = activateTimeUs;
@@ -161,12 +154,7 @@ bool ActivationQueue::enqueue(uint64_t activateTimeUs, uint8_t finger, uint8_t a
     actEvent.frequencyHz = frequencyHz;
     actEvent.type = MotorEventType::ACTIVATE;
     actEvent.active = true;
-
-    // H4 fix: Store slot index for proper rollback
-    int8_t actSlot = addEvent(actEvent);
-    if (actSlot < 0) {
-        return false;
-    }
+    insertSorted(actEvent);
 
     // Create corresponding deactivation event
     MotorEvent deactEvent;
@@ -176,13 +164,8 @@ bool ActivationQueue::enqueue(uint64_t activateTimeUs, uint8_t finger, uint8_t a
     deactEvent.frequencyHz = 0;
     deactEvent.type = MotorEventType::DEACTIVATE;
     deactEvent.active = true;
-
-    int8_t deactSlot = addEvent(deactEvent);
-    if (deactSlot < 0) {
-        // H4 fix: Rollback by known index, not by searching
-        _events[actSlot].clear();
-        return false;
-    }
+    insertSorted(deactEvent);
+    _revision = _revision + 1;
 
     if (profiles.getDebugMode()) {
         Serial.printf("[QUEUE] Enqueued F%d A%d @%dHz (ON at T+%lums, OFF at T+%lums)\n",
@@ -205,13 +188,12 @@ bool ActivationQueue::peekNextEvent(MotorEvent& event) const {
         return false;
     }
 
-    int8_t idx = findNextEvent();
-    if (idx < 0) {
+    if (_count == 0) {
         return false;
     }
 
     // Copy entire event while holding mutex (H5 fix - atomic 64-bit copy)
-    event = _events[idx];
+    event = _events[_head];
     return true;
 }
 
@@ -221,55 +203,119 @@ bool ActivationQueue::dequeueNextEvent(MotorEvent& event) {
         return false;
     }
 
-    int8_t idx = findNextEvent();
-    if (idx < 0) {
+    if (_count == 0) {
         return false;
     }
 
     // Copy and clear while holding mutex (C2 fix - atomic peek+dequeue)
-    event = _events[idx];
-    _events[idx].clear();
+    event = _events[_head];
+    _events[_head].clear();
+    _head = ringIndex(1);
+    _count = static_cast<uint8_t>(_count - 1);
     return true;
 }
 
-uint64_t ActivationQueue::getNextEventTime() const {
+uint8_t ActivationQueue::dequeueDueEvents(uint64_t untilUs, MotorEvent* events, uint8_t maxEvents) {
+    if (events == nullptr || maxEvents == 0) {
+        return 0;
+    }
+
     QueueMutexLock lock(_queueMutex);
     if (!lock.acquired()) {
-        return UINT64_MAX;
+        return 0;
     }
 
-    int8_t idx = findNextEvent();
-    if (idx < 0) {
-        return UINT64_MAX;
+    // Sorted ring: due events are a prefix starting at the head
+    uint8_t taken = 0;
+    while (taken < maxEvents && _count > 0 && _events[_head].timeUs <= untilUs) {
+        events[taken++] = _events[_head];
+        _events[_head].clear();
+        _head = ringIndex(1);
+        _count = static_cast<uint8_t>(_count - 1);
     }
-    return _events[idx].timeUs;
+    return taken;
 }
 
-uint8_t ActivationQueue::eventCount() const {
-    // NOTE: Can be called without mutex for approximate count (used in logging)
-    uint8_t count = 0;
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (_events[i].active) {
-            count++;
-        }
+void ActivationQueue::removeAt(uint8_t pos) {
+    // NOTE: Caller must hold mutex
+    if (pos == 0) {
+        _events[_head].clear();
+        _head = ringIndex(1);
+        _count = static_cast<uint8_t>(_count - 1);
+        return;
+    }
+    for (uint8_t i = pos; i + 1 < _count; i++) {
+        _events[ringIndex(i)] = _events[ringIndex(i + 1)];
     }
-    return count;
+    _events[ringIndex(_count - 1)].clear();
+    _count = static_cast<uint8_t>(_count - 1);
 }
 
-bool ActivationQueue::isEmpty() const {
+bool ActivationQueue::dropActivation(const MotorEvent& activation) {
     QueueMutexLock lock(_queueMutex);
-    if (!lock.acquired()) {
-        return true;  // Assume empty on failure (safe default)
+    if (!lock.acquired() || _count == 0) {
+        return false;
     }
 
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (_events[i].active) {
-            return false;
+    const MotorEvent& head = _events[_head];
+    if (head.type != MotorEventType::ACTIVATE || head.timeUs != activation.timeUs ||
+        head.finger != activation.finger) {
+        return false;
+    }
+
+    for (uint8_t pos = 1; pos < _count; pos++) {
+        const MotorEvent& event = _events[ringIndex(pos)];
+        if (event.type == MotorEventType::DEACTIVATE && event.finger == activation.finger &&
+            event.timeUs > activation.timeUs) {
+            removeAt(pos);
+            break;
         }
     }
+    removeAt(0);
+    _revision = _revision + 1;
     return true;
 }
 
+void ActivationQueue::delayPending(uint64_t delayUs) {
+    QueueMutexLock lock(_queueMutex);
+    if (!lock.acquired()) {
+        return;
+    }
+
+    for (uint8_t pos = 0; pos < _count; pos++) {
+        _events[ringIndex(pos)].timeUs += delayUs;
+    }
+    _revision = _revision + 1;
+}
+
+uint8_t ActivationQueue::forEachEvent(void (*visit)(const MotorEvent& event)) const {
+    if (visit == nullptr) {
+        return 0;
+    }
+
+    QueueMutexLock lock(_queueMutex);
+    if (!lock.acquired()) {
+        return 0;
+    }
+
+    for (uint8_t pos = 0; pos < _count; pos++) {
+        visit(_events[ringIndex(pos)]);
+    }
+    return _count;
+}
+
+uint64_t ActivationQueue::getNextEventTime() const {
+    QueueMutexLock lock(_queueMutex);
+    if (!lock.acquired()) {
+        return UINT64_MAX;
+    }
+
+    if (_count == 0) {
+        return UINT64_MAX;
+    }
+    return _events[_head].timeUs;
+}
+
 void ActivationQueue::notifyMotorTask() {
     // xTaskNotifyGive is ISR-safe, no mutex needed
     if (_motorTaskHandle != nullptr) {
@@ -5,7 +5,7 @@
  *
  * Implements the same BLEManager contract as ble_manager_nrf52.cpp using
  * NimBLE-Arduino 2.x:
- * - Nordic UART Service (same UUIDs, chunking, EOT framing, MTU 200)
+ * - Nordic UART Service (same UUIDs, chunking, EOT framing, MTU 247 + DLE)
  * - PRIMARY = peripheral (phone + SECONDARY connect to it)
  * - SECONDARY = central (scans for and connects to PRIMARY)
  * - 7.5-10 ms connection interval, 0 dBm TX power, 2M PHY request
@@ -18,9 +18,15 @@
 #include "ble_manager.h"
 #include "sync_protocol.h"  // For getMicros() - overflow-safe 64-bit timestamp
 #include "platform.h"
+#include "perf_profile.h"
+#include "schedule_broadcast.h"
 
 #include <NimBLEDevice.h>
 
+#if SYNC_PERIODIC_ADV_ENABLED && !(CONFIG_BT_NIMBLE_EXT_ADV && MYNEWT_VAL(BLE_PERIODIC_ADV))
+#error "SYNC_PERIODIC_ADV_ENABLED needs CONFIG_BT_NIMBLE_EXT_ADV=1 and CONFIG_BT_NIMBLE_ENABLE_PERIODIC_ADV=1"
+#endif
+
 // =============================================================================
 // NORDIC UART SERVICE UUIDS
 // =============================================================================
@@ -33,6 +39,8 @@ static const char* NUS_TX_CHAR_UUID = "6E400003-B5A3-F393-E0A9-E50E24DCCA9E";  /
 static constexpr uint16_t CONN_INTERVAL_MIN_UNITS = static_cast<uint16_t>((BLE_INTERVAL_MIN_MS * 1000) / 1250);  // 7.5ms -> 6
 static constexpr uint16_t CONN_INTERVAL_MAX_UNITS = (BLE_INTERVAL_MAX_MS * 1000) / 1250;                          // 10ms -> 8
 static constexpr uint16_t CONN_SUPERVISION_TIMEOUT_10MS = BLE_TIMEOUT_MS / 10;                                    // 6s -> 600
+static constexpr uint16_t CONN_RELAXED_MIN_UNITS = (BLE_RELAXED_INTERVAL_MIN_MS * 1000) / 1250;                    // 45ms -> 36
+static constexpr uint16_t CONN_RELAXED_MAX_UNITS = (BLE_RELAXED_INTERVAL_MAX_MS * 1000) / 1250;                    // 60ms -> 48
 
 // =============================================================================
 // GLOBAL INSTANCE (needed for static callbacks)
@@ -54,7 +62,8 @@ static NimBLERemoteCharacteristic* s_remoteRx = nullptr;  // PRIMARY's RX char (
 // transmits even when the peer never subscribed, unlike Bluefruit's write()
 // which returns 0 - so we gate sends ourselves to get the same retry-until-
 // subscribed semantics. Written from the host task, read from the loop task.
-static uint16_t s_subscribedConns[MAX_CONNECTIONS] = {CONN_HANDLE_INVALID, CONN_HANDLE_INVALID};
+// Cleared to CONN_HANDLE_INVALID in begin() (MAX_CONNECTIONS varies).
+static uint16_t s_subscribedConns[MAX_CONNECTIONS];
 
 static void setTxSubscribed(uint16_t connHandle, bool subscribed) {
     PLATFORM_CRITICAL_ENTER();
@@ -100,11 +109,55 @@ static volatile bool  s_pendingScanRestart = false;
 static bool s_advertising = false;
 static bool s_scanning = false;
 
+#if CONFIG_BT_NIMBLE_EXT_ADV
+// With extended advertising compiled in, NimBLE only offers the extended API:
+// the connectable advert runs as a legacy-PDU set on instance 0
+static constexpr uint8_t CONN_ADV_INSTANCE = 0;
+#endif
+
+#if SYNC_PERIODIC_ADV_ENABLED
+// Schedule broadcast train (PRIMARY). s_train is written once in begin()
+// before the first broadcastSchedule().
+static constexpr uint16_t TRAIN_INTERVAL_UNITS = (SYNC_PERIODIC_ADV_INTERVAL_MS * 1000) / 1250;
+static constexpr uint16_t TRAIN_SYNC_TIMEOUT_10MS = (SYNC_PERIODIC_ADV_INTERVAL_MS * 6) / 10;  // 6 missed events
+static_assert(TRAIN_SYNC_TIMEOUT_10MS >= 10, "Sync timeout below the 100ms minimum");
+static bool s_trainRunning = false;
+static ScheduleTrain s_train = {};
+
+// Train sync (SECONDARY). Started/stopped from the loop task; the sync
+// events and report reassembly run in the host task.
+static volatile bool s_listenerActive = false;
+static volatile bool s_trainSynced = false;
+static volatile bool s_pendingTrainResync = false;
+static uint16_t s_trainSyncHandle = 0;
+static ble_addr_t s_trainAddr = {};
+static uint8_t s_reportBuf[SYNC_PERIODIC_ADV_MAX_DATA];
+static size_t s_reportLen = 0;
+static bool s_reportOverflow = false;
+static uint64_t s_reportRxUs = 0;
+#endif
+
+#if TASK_PINNING_ENABLED
+// TX drain task on the BLE core (board_config.h task topology); woken by
+// commitTx/enqueueStamped, polls while a connection is congested
+static TaskHandle_t s_txTask = nullptr;
+
+static inline void wakeTxTask() {
+    if (s_txTask != nullptr) {
+        xTaskNotifyGive(s_txTask);
+    }
+}
+#endif
+
 // =============================================================================
 // FORWARD DECLARATIONS FOR CALLBACK CLASSES
 // =============================================================================
 
 static void requestPhy2M(uint16_t connHandle);
+#if SYNC_PERIODIC_ADV_ENABLED
+static void startScheduleTrain();
+static bool startTrainSync();
+#endif
 
 // Peripheral (PRIMARY) callbacks
 class BBServerCallbacks : public NimBLEServerCallbacks {
@@ -115,7 +168,7 @@ class BBServerCallbacks : public NimBLEServerCallbacks {
         BLEManager::_onPeriphDisconnect(connInfo.getConnHandle(), static_cast<uint8_t>(reason));
     }
     void onMTUChange(uint16_t mtu, NimBLEConnInfo& connInfo) override {
-        Serial.printf("[BLE] MTU negotiated: %u (handle=%d)\n", mtu, connInfo.getConnHandle());
+        BLEManager::_onMtuChange(connInfo.getConnHandle(), mtu);
     }
 };
 
@@ -170,10 +223,12 @@ BLEManager::BLEManager() :
     _connectCallback(nullptr),
     _disconnectCallback(nullptr),
     _messageCallback(nullptr),
-    _txHead(0),
-    _txTail(0),
-    _txCount(0),
-    _txStampCallback(nullptr)
+    _rxOversizeFrames(0),
+    _identifyCounter(0),
+    _txQueue(),
+    _txStampCallback(nullptr),
+    _scheduleBroadcastCallback(nullptr),
+    _connParamProfile(ConnParamProfile::TIGHT)
 {
     memset(_deviceName, 0, sizeof(_deviceName));
     memset(_targetName, 0, sizeof(_targetName));
@@ -184,12 +239,6 @@ BLEManager::BLEManager() :
         _connections[i].reset();
     }
 
-    for (uint8_t i = 0; i < TX_QUEUE_SIZE; i++) {
-        _txQueue[i].pending = false;
-        _txQueue[i].length = 0;
-        _txQueue[i].bytesSent = 0;
-    }
-
     g_bleManager = this;
 }
 
@@ -203,16 +252,24 @@ bool BLEManager::begin(DeviceRole role, const char* deviceName) {
 
     Serial.printf("[BLE] Initializing as %s (NimBLE)...\n", deviceRoleToString(role));
 
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        s_subscribedConns[i] = CONN_HANDLE_INVALID;
+    }
+
     NimBLEDevice::init(_deviceName);
 
-    // MTU 200: a 100-byte chunk fits in one notification (protocol parity with
-    // the Bluefruit backend; the 23-byte default would fragment every chunk)
-    NimBLEDevice::setMTU(200);
+    // MTU 247: the largest ATT payload one 251-byte DLE PDU carries (parity
+    // with the Bluefruit backend); chunks follow the per-link result
+    NimBLEDevice::setMTU(BLE_ATT_MTU);
 
     // TX power parity with Bluefruit.setTxPower(0)
     NimBLEDevice::setPower(0);
 
-#ifdef BLE_USE_2M_PHY
+#if BLE_PHY_AUTO_ENABLED
+    // Accept any PHY the PRIMARY's PhyManager asks for (Coded included);
+    // the per-connection 2M request below still starts links on 2M
+    ble_gap_set_prefered_default_le_phy(BLE_GAP_LE_PHY_ANY_MASK, BLE_GAP_LE_PHY_ANY_MASK);
+#elif defined(BLE_USE_2M_PHY)
     // Prefer 2M PHY for all connections (parity with the nRF requestPHY calls);
     // peers that refuse fall back to 1M
     ble_gap_set_prefered_default_le_phy(BLE_GAP_LE_PHY_2M_MASK, BLE_GAP_LE_PHY_2M_MASK);
@@ -224,11 +281,33 @@ bool BLEManager::begin(DeviceRole role, const char* deviceName) {
         setupSecondaryMode();
     }
 
+#if TASK_PINNING_ENABLED
+    if (s_txTask == nullptr &&
+        xTaskCreatePinnedToCore(_txTask, "BleTx", BLE_TX_TASK_STACK, this,
+                                BLE_TX_TASK_PRIORITY, &s_txTask, BLE_TX_TASK_CORE) != pdPASS) {
+        s_txTask = nullptr;
+        Serial.println(F("[BLE] WARNING: TX task creation failed - draining from update()"));
+    }
+#endif
+
     _initialized = true;
     Serial.println(F("[BLE] Initialization complete"));
     return true;
 }
 
+#if TASK_PINNING_ENABLED
+void BLEManager::_txTask(void* arg) {
+    BLEManager* self = static_cast<BLEManager*>(arg);
+    for (;;) {
+        // Idle until a commit wakes us; while entries remain (congested stack
+        // buffer, multi-chunk message) retry on the poll period
+        TickType_t wait = (self->_txQueue.count() > 0) ? pdMS_TO_TICKS(BLE_TX_TASK_POLL_MS) : portMAX_DELAY;
+        ulTaskNotifyTake(pdTRUE, wait);
+        self->processTxQueue();
+    }
+}
+#endif
+
 void BLEManager::setupPrimaryMode() {
     Serial.println(F("[BLE] Setting up PRIMARY mode (peripheral)"));
 
@@ -252,6 +331,10 @@ void BLEManager::setupPrimaryMode() {
 
     // (NimBLE 2.x starts services with the server; no explicit start needed)
     setupAdvertising();
+
+#if SYNC_PERIODIC_ADV_ENABLED
+    startScheduleTrain();
+#endif
 }
 
 void BLEManager::setupSecondaryMode() {
@@ -265,6 +348,30 @@ void BLEManager::setupSecondaryMode() {
 }
 
 void BLEManager::setupAdvertising() {
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    // Same legacy advert + scan response as below, as extended-API instance
+    NimBLEExtAdvertisement adv;
+    adv.setLegacyAdvertising(true);
+    adv.setConnectable(true);
+    adv.setScannable(true);
+    adv.setFlags(BLE_HS_ADV_F_DISC_GEN | BLE_HS_ADV_F_BREDR_UNSUP);
+    adv.addServiceUUID(NUS_SERVICE_UUID);
+    adv.setMinInterval(32);   // 20ms
+    adv.setMaxInterval(244);  // 152.5ms
+
+    NimBLEExtAdvertisement scanResponse;
+    scanResponse.setLegacyAdvertising(true);
+    scanResponse.setConnectable(true);
+    scanResponse.setScannable(true);
+    scanResponse.setName(_deviceName);
+
+    NimBLEExtAdvertising* extAdv = NimBLEDevice::getAdvertising();
+    if (!extAdv->setInstanceData(CONN_ADV_INSTANCE, adv) ||
+        !extAdv->setScanResponseData(CONN_ADV_INSTANCE, scanResponse)) {
+        Serial.println(F("[BLE] ERROR: Failed to set advertising data"));
+    }
+    extAdv->start(CONN_ADV_INSTANCE);
+#else
     NimBLEAdvertising* adv = NimBLEDevice::getAdvertising();
     adv->addServiceUUID(NUS_SERVICE_UUID);
     // Scan response must be enabled BEFORE setName(): NimBLE routes the name
@@ -280,15 +387,29 @@ void BLEManager::setupAdvertising() {
     adv->setMaxInterval(244);  // 152.5ms
 
     adv->start(0);
+#endif
     s_advertising = true;
     Serial.println(F("[BLE] Advertising started"));
 }
 
 void BLEManager::startAdvertisingInternal() {
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    NimBLEDevice::getAdvertising()->start(CONN_ADV_INSTANCE);
+#else
     NimBLEDevice::getAdvertising()->start(0);
+#endif
     s_advertising = true;
 }
 
+static void stopConnectableAdvertising() {
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    // Instance-specific: stop() without one would also end the schedule train
+    NimBLEDevice::getAdvertising()->stop(CONN_ADV_INSTANCE);
+#else
+    NimBLEDevice::getAdvertising()->stop();
+#endif
+}
+
 // =============================================================================
 // UPDATE (call in loop)
 // =============================================================================
@@ -296,8 +417,15 @@ void BLEManager::startAdvertisingInternal() {
 void BLEManager::update() {
     uint32_t now = millis();
 
-    // Process TX queue (non-blocking message transmission)
+    // Process TX queue (non-blocking message transmission); the pinned TX
+    // task owns it when running
+#if TASK_PINNING_ENABLED
+    if (s_txTask == nullptr) {
+        processTxQueue();
+    }
+#else
     processTxQueue();
+#endif
 
     // Deferred central connect (scan callback must not block the host task)
     if (s_pendingConnect) {
@@ -343,6 +471,16 @@ void BLEManager::update() {
         }
     }
 
+#if SYNC_PERIODIC_ADV_ENABLED
+    // Train sync lost or failed: scan for it again while still connected
+    if (s_pendingTrainResync) {
+        s_pendingTrainResync = false;
+        if (s_listenerActive && !startTrainSync()) {
+            Serial.println(F("[BLE] WARN: Schedule train resync failed"));
+        }
+    }
+#endif
+
     // Periodic scanner health check for SECONDARY mode (only when disconnected)
     static uint32_t lastScanCheck = 0;
     if (_role == DeviceRole::SECONDARY && _scannerAutoRestartEnabled && (now - lastScanCheck >= 5000)) {
@@ -396,13 +534,17 @@ bool BLEManager::startAdvertising() {
 }
 
 void BLEManager::stopAdvertising() {
-    NimBLEDevice::getAdvertising()->stop();
+    stopConnectableAdvertising();
     s_advertising = false;
     Serial.println(F("[BLE] Advertising stopped"));
 }
 
 bool BLEManager::isAdvertising() const {
+#if CONFIG_BT_NIMBLE_EXT_ADV
+    return NimBLEDevice::getAdvertising()->isActive(CONN_ADV_INSTANCE);
+#else
     return NimBLEDevice::getAdvertising()->isAdvertising();
+#endif
 }
 
 // =============================================================================
@@ -489,6 +631,15 @@ bool BLEManager::isPhoneConnected() const {
     return false;
 }
 
+uint8_t BLEManager::getPhoneProtocol() const {
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        if (_connections[i].type == ConnectionType::PHONE && _connections[i].isConnected) {
+            return _connections[i].phoneProtocol;
+        }
+    }
+    return PHONE_PROTOCOL_TEXT;
+}
+
 bool BLEManager::isPrimaryConnected() const {
     for (int i = 0; i < MAX_CONNECTIONS; i++) {
         if (_connections[i].type == ConnectionType::PRIMARY && _connections[i].isConnected) {
@@ -527,12 +678,38 @@ void BLEManager::disconnectAll() {
 }
 
 uint16_t BLEManager::getSecondaryHandle() const {
+    // The first SECONDARY is the one that identified earliest, whatever slot it holds
+    uint16_t handle = CONN_HANDLE_INVALID;
+    uint32_t oldest = UINT32_MAX;
     for (int i = 0; i < MAX_CONNECTIONS; i++) {
-        if (_connections[i].type == ConnectionType::SECONDARY && _connections[i].isConnected) {
-            return _connections[i].connHandle;
+        if (_connections[i].type == ConnectionType::SECONDARY && _connections[i].isConnected &&
+            _connections[i].identifyOrder < oldest) {
+            oldest = _connections[i].identifyOrder;
+            handle = _connections[i].connHandle;
         }
     }
-    return CONN_HANDLE_INVALID;
+    return handle;
+}
+
+uint8_t BLEManager::getSecondaryHandles(uint16_t* handles, uint8_t maxHandles) const {
+    // Insertion by identification order (at most BLE_MAX_SECONDARIES entries)
+    uint32_t order[MAX_CONNECTIONS];
+    uint8_t count = 0;
+    for (int i = 0; i < MAX_CONNECTIONS && count < maxHandles; i++) {
+        const BBConnection& conn = _connections[i];
+        if (conn.type != ConnectionType::SECONDARY || !conn.isConnected) {
+            continue;
+        }
+        uint8_t j = count++;
+        while (j > 0 && order[j - 1] > conn.identifyOrder) {
+            order[j] = order[j - 1];
+            handles[j] = handles[j - 1];
+            j--;
+        }
+        order[j] = conn.identifyOrder;
+        handles[j] = conn.connHandle;
+    }
+    return count;
 }
 
 uint16_t BLEManager::getPhoneHandle() const {
@@ -558,79 +735,114 @@ uint16_t BLEManager::getPrimaryHandle() const {
 // tryWriteImmediate talks to the stack)
 // =============================================================================
 
-bool BLEManager::send(uint16_t connHandleParam, const char* message) {
-    if (connHandleParam == CONN_HANDLE_INVALID) {
+bool BLEManager::send(uint16_t connHandleParam, const char* message, TxPriority priority) {
+    // Same limit as the receiving glove's RX buffer, whatever the slot size
+    size_t msgLen = strlen(message);
+    if (msgLen >= MESSAGE_BUFFER_SIZE - 1) {
+        Serial.println(F("[BLE] ERROR: Message too large for TX buffer"));
         return false;
     }
 
-    BBConnection* conn = findConnection(connHandleParam);
-    if (!conn || !conn->isConnected) {
+    BLETxSpan span = reserveTx(connHandleParam, msgLen + 1, priority);
+    if (!span) {
         return false;
     }
-
-    return enqueueTx(connHandleParam, message);
+    memcpy(span.data, message, msgLen);
+    return commitTx(span, msgLen);
 }
 
-bool BLEManager::enqueueTx(uint16_t connHandle, const char* message) {
-    // Validate length before entering the critical section (no shared state read)
-    size_t msgLen = strlen(message);
-    if (msgLen >= MESSAGE_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] ERROR: Message too large for TX buffer"));
-        return false;
+BLETxSpan BLEManager::reserveTx(uint16_t connHandleParam, size_t maxLen, TxPriority priority) {
+    BLETxSpan span;
+    if (connHandleParam == CONN_HANDLE_INVALID) {
+        return span;
     }
 
-    // Reserve a slot atomically (tail/count advance), but do NOT publish it
-    // yet: the NimBLE host task (core 0) and the loop-task consumer (core 1)
-    // run truly concurrently, so the fields must be fully written before
-    // pending flips true - publish-before-fill would let processTxQueue read
-    // a half-filled entry.
-    PLATFORM_CRITICAL_ENTER();
-
-    if (_txCount >= TX_QUEUE_SIZE) {
-        PLATFORM_CRITICAL_EXIT();
-        Serial.println(F("[BLE] TX queue full, dropping message"));
-        return false;
+    BBConnection* conn = findConnection(connHandleParam);
+    if (!conn || !conn->isConnected) {
+        return span;
     }
 
-    TxEntry* entry = &_txQueue[_txTail];
-    if (entry->pending) {
-        PLATFORM_CRITICAL_EXIT();
-        Serial.println(F("[BLE] TX queue corruption detected"));
-        return false;
+    if (priority == TxPriority::DEFAULT) {
+        priority = (conn->type == ConnectionType::PHONE) ? TxPriority::RESPONSE : TxPriority::MACROCYCLE;
     }
 
-    _txTail = static_cast<uint8_t>((_txTail + 1) % TX_QUEUE_SIZE);
-    _txCount++;
+    // Never more than the receiving glove's RX buffer, whatever the slot size
+    const size_t maxMessage = MESSAGE_BUFFER_SIZE - 1;
+    if (maxLen > maxMessage) {
+        maxLen = maxMessage;
+    }
 
-    PLATFORM_CRITICAL_EXIT();
+    // Reserve-fill-publish: the slot is not visible to processTxQueue until
+    // commitTx publishes it (see ble_tx_queue.h)
+    BLETxEntry* entry = _txQueue.reserve(priority, maxLen);
+    if (entry == nullptr) {
+        Serial.printf("[BLE] TX queue full, dropping message (class %u)\n", static_cast<unsigned>(priority));
+        return span;
+    }
 
-    memcpy(entry->data, message, msgLen);
-    entry->data[msgLen] = EOT_CHAR;
-    entry->length = static_cast<uint16_t>(msgLen + 1);
     entry->bytesSent = 0;
-    entry->connHandle = connHandle;
+    entry->connHandle = connHandleParam;
     entry->stampKind = TxStampKind::NONE;
 
-    // Publish: all field stores must be visible before pending reads true
-    platformMemoryBarrier();
-    entry->pending = true;
+    span.data = entry->data;
+    span.capacity = (entry->capacity < maxMessage) ? entry->capacity : maxMessage;
+    span.entry = entry;
+    return span;
+}
 
-    return true;
+bool BLEManager::commitTx(BLETxSpan& span, size_t len) {
+    if (!span) {
+        return false;
+    }
+
+    // An abandoned slot is still published (length 0) so the ring keeps its
+    // order; processTxQueue releases it when it reaches the head
+    BLETxEntry* entry = span.entry;
+    bool queued = (len > 0 && len < span.capacity);
+    if (queued) {
+        entry->data[len] = EOT_CHAR;
+    }
+    entry->length = queued ? static_cast<uint16_t>(len + 1) : 0;
+
+    _txQueue.publish(entry);
+    span = BLETxSpan();
+#if TASK_PINNING_ENABLED
+    wakeTxTask();
+#endif
+    return queued;
+}
+
+bool BLEManager::sendCommand(uint16_t connHandleParam, const SyncCommand& command, TxPriority priority) {
+    // Any SyncCommand fits a SYNC-sized slot, whatever its class
+    BLETxSpan span = reserveTx(connHandleParam, BLE_TX_SYNC_SLOT_BYTES, priority);
+    if (!span) {
+        return false;
+    }
+    bool serialized = command.serialize(span.data, span.capacity);
+    return commitTx(span, serialized ? strlen(span.data) : 0);
 }
 
 void BLEManager::processTxQueue() {
-    // Process up to 4 queue entries per update for responsiveness
-    for (uint8_t i = 0; i < 4 && _txCount > 0; i++) {
-        TxEntry* entry = &_txQueue[_txHead];
-        if (!entry->pending) {
-            // Reserved but not yet published: the producer (possibly on the
-            // other core) is still filling the entry. Retry next update() -
-            // advancing head here would free a slot mid-fill.
+    PERF_SCOPE(PROCESS_TX_QUEUE);
+    // Up to BLE_TX_WRITES_PER_PASS notifications per update - enough for a
+    // whole multi-chunk message to land in one connection event. The
+    // highest-priority writable entry is picked again before every write, so
+    // sync traffic queued mid-transfer goes out ahead of a bulk message's
+    // next chunk. A connection whose stack buffer is full is skipped for the
+    // rest of this pass.
+    uint16_t congested[MAX_CONNECTIONS];
+    uint8_t congestedCount = 0;
+    for (uint8_t i = 0; i < BLE_TX_WRITES_PER_PASS; i++) {
+        BLETxEntry* entry = _txQueue.next(congested, congestedCount);
+        if (entry == nullptr) {
             break;
         }
-        // Acquire: pending was observed true; ensure the field reads below
-        // see the producer's stores (pairs with the publish barrier)
-        platformMemoryBarrier();
+
+        // Abandoned by commitTx: nothing to write
+        if (entry->length == 0 && entry->stampKind == TxStampKind::NONE) {
+            _txQueue.release(entry);
+            continue;
+        }
 
         // Late timestamping: serialize sync messages at radio handoff so the
         // embedded T1/T3 reflects when bytes are handed to the stack.
@@ -647,19 +859,14 @@ void BLEManager::processTxQueue() {
                 cmd = SyncCommand::createPongWithTimestamps(entry->stampSeqId, entry->stampT2, stampTime);
             }
 
-            char msg[128];
-            if (!cmd.serialize(msg, sizeof(msg))) {
+            // Serialized in place; the terminating NUL's byte becomes the EOT
+            if (!cmd.serialize(entry->data, entry->capacity)) {
                 uint32_t seqId = entry->stampSeqId;
-                PLATFORM_CRITICAL_ENTER();
-                entry->pending = false;
-                _txHead = static_cast<uint8_t>((_txHead + 1) % TX_QUEUE_SIZE);
-                _txCount--;
-                PLATFORM_CRITICAL_EXIT();
+                _txQueue.release(entry);
                 Serial.printf("[BLE] ERROR: stamped sync serialize failed seq=%lu\n", (unsigned long)seqId);
                 continue;
             }
-            size_t msgLen = strlen(msg);
-            memcpy(entry->data, msg, msgLen);
+            size_t msgLen = strlen(entry->data);
             entry->data[msgLen] = EOT_CHAR;
             entry->length = static_cast<uint16_t>(msgLen + 1);
         }
@@ -681,22 +888,22 @@ void BLEManager::processTxQueue() {
             entry->bytesSent = static_cast<uint16_t>(entry->bytesSent + written);
 
             if (entry->bytesSent >= entry->length) {
-                PLATFORM_CRITICAL_ENTER();
-                entry->pending = false;
-                _txHead = static_cast<uint8_t>((_txHead + 1) % TX_QUEUE_SIZE);
-                _txCount--;
-                PLATFORM_CRITICAL_EXIT();
+                _txQueue.release(entry);
             }
-        } else {
-            // Stack congested - retry on the next update()
-            break;
+        } else if (congestedCount < MAX_CONNECTIONS) {
+            // Stack congested for this connection - retry it next update()
+            congested[congestedCount++] = entry->connHandle;
         }
     }
 }
 
 size_t BLEManager::tryWriteImmediate(uint16_t connHandle, const uint8_t* data, size_t len) {
-    // Cap at BLE_CHUNK_SIZE per attempt (fits one notification at MTU 200)
-    size_t chunk = len < BLE_CHUNK_SIZE ? len : BLE_CHUNK_SIZE;
+    // One notification per attempt, sized to this link's MTU
+    BBConnection* conn = findConnection(connHandle);
+    size_t chunk = bleNotifyPayload(conn ? conn->attMtu : BLE_ATT_MTU_MIN);
+    if (len < chunk) {
+        chunk = len;
+    }
 
     if (_role == DeviceRole::PRIMARY) {
         // Peripheral -> phone/SECONDARY via notification on the TX characteristic.
@@ -712,31 +919,36 @@ size_t BLEManager::tryWriteImmediate(uint16_t connHandle, const uint8_t* data, s
     }
 }
 
-bool BLEManager::sendToSecondary(const char* message) {
-    uint16_t handle = getSecondaryHandle();
-    if (handle == CONN_HANDLE_INVALID) {
+bool BLEManager::sendToSecondary(const char* message, TxPriority priority) {
+    uint16_t handles[BLE_MAX_SECONDARIES];
+    uint8_t count = getSecondaryHandles(handles, BLE_MAX_SECONDARIES);
+    if (count == 0) {
         Serial.println(F("[BLE] Cannot send: SECONDARY not connected"));
         return false;
     }
-    return send(handle, message);
+    bool allQueued = true;
+    for (uint8_t i = 0; i < count; i++) {
+        allQueued = send(handles[i], message, priority) && allQueued;
+    }
+    return allQueued;
 }
 
-bool BLEManager::sendToPhone(const char* message) {
+bool BLEManager::sendToPhone(const char* message, TxPriority priority) {
     uint16_t handle = getPhoneHandle();
     if (handle == CONN_HANDLE_INVALID) {
         Serial.println(F("[BLE] Cannot send: Phone not connected"));
         return false;
     }
-    return send(handle, message);
+    return send(handle, message, priority);
 }
 
-bool BLEManager::sendToPrimary(const char* message) {
+bool BLEManager::sendToPrimary(const char* message, TxPriority priority) {
     uint16_t handle = getPrimaryHandle();
     if (handle == CONN_HANDLE_INVALID) {
         Serial.println(F("[BLE] Cannot send: PRIMARY not connected"));
         return false;
     }
-    return send(handle, message);
+    return send(handle, message, priority);
 }
 
 uint8_t BLEManager::broadcast(const char* message) {
@@ -771,8 +983,8 @@ void BLEManager::setTxStampCallback(BLETxStampCallback callback) {
     _txStampCallback = callback;
 }
 
-bool BLEManager::sendPingStamped(uint32_t seqId) {
-    uint16_t handle = getSecondaryHandle();
+bool BLEManager::sendPingStamped(uint32_t seqId, uint16_t connHandle) {
+    uint16_t handle = (connHandle != CONN_HANDLE_INVALID) ? connHandle : getSecondaryHandle();
     if (handle == CONN_HANDLE_INVALID) {
         return false;
     }
@@ -788,28 +1000,14 @@ bool BLEManager::sendPongStamped(uint16_t connHandle, uint32_t seqId, uint64_t t
 
 bool BLEManager::enqueueStamped(uint16_t connHandle, TxStampKind kind, uint32_t seqId,
                                 uint64_t t2, uint64_t anchorUs) {
-    // Reserve-fill-publish, same protocol as enqueueTx (see the cross-core
-    // rationale there).
-    PLATFORM_CRITICAL_ENTER();
-
-    if (_txCount >= TX_QUEUE_SIZE) {
-        PLATFORM_CRITICAL_EXIT();
+    // Reserve-fill-publish, same protocol as reserveTx. Serialized at write
+    // time into the SYNC slot (worst case ~82 B + EOT).
+    BLETxEntry* entry = _txQueue.reserve(TxPriority::SYNC, BLE_TX_SYNC_SLOT_BYTES);
+    if (entry == nullptr) {
         Serial.println(F("[BLE] TX queue full, dropping sync message"));
         return false;
     }
 
-    TxEntry* entry = &_txQueue[_txTail];
-    if (entry->pending) {
-        PLATFORM_CRITICAL_EXIT();
-        Serial.println(F("[BLE] TX queue corruption detected"));
-        return false;
-    }
-
-    _txTail = static_cast<uint8_t>((_txTail + 1) % TX_QUEUE_SIZE);
-    _txCount++;
-
-    PLATFORM_CRITICAL_EXIT();
-
     entry->stampKind = kind;
     entry->stampSeqId = seqId;
     entry->stampT2 = t2;
@@ -818,13 +1016,257 @@ bool BLEManager::enqueueStamped(uint16_t connHandle, TxStampKind kind, uint32_t
     entry->bytesSent = 0;
     entry->connHandle = connHandle;
 
-    // Publish: all field stores must be visible before pending reads true
-    platformMemoryBarrier();
-    entry->pending = true;
+    _txQueue.publish(entry);
+#if TASK_PINNING_ENABLED
+    wakeTxTask();
+#endif
+    return true;
+}
+
+// =============================================================================
+// SCHEDULE BROADCAST (periodic advertising train)
+// =============================================================================
+
+void BLEManager::setScheduleBroadcastCallback(BLEScheduleBroadcastCallback callback) {
+    _scheduleBroadcastCallback = callback;
+}
+
+#if SYNC_PERIODIC_ADV_ENABLED
+
+void BLEManager::_onScheduleReport(const uint8_t* data, size_t length, uint64_t rxTimestamp) {
+    if (g_bleManager && g_bleManager->_scheduleBroadcastCallback) {
+        g_bleManager->_scheduleBroadcastCallback(data, length, rxTimestamp);
+    }
+}
+
+static int onTrainAdvEvent(ble_gap_event* event [[maybe_unused]], void* arg [[maybe_unused]]) {
+    return 0;  // Non-connectable, non-scannable: nothing to handle
+}
 
+static void startScheduleTrain() {
+    // Non-connectable extended set carrying the SyncInfo listeners sync from
+    ble_gap_ext_adv_params advParams = {};
+    advParams.own_addr_type = BLE_OWN_ADDR_PUBLIC;  // Same identity the connectable advert uses
+    advParams.primary_phy = BLE_HCI_LE_PHY_1M;
+    advParams.secondary_phy = BLE_HCI_LE_PHY_1M;
+    advParams.sid = SYNC_PERIODIC_ADV_SID;
+    advParams.itvl_min = 160;  // 100ms (0.625ms units) - only needed until listeners sync
+    advParams.itvl_max = 160;
+    advParams.tx_power = 127;  // Host has no preference
+
+    int rc = ble_gap_ext_adv_configure(SYNC_PERIODIC_ADV_INSTANCE, &advParams, nullptr,
+                                       onTrainAdvEvent, nullptr);
+    if (rc != 0) {
+        Serial.printf("[BLE] ERROR: Schedule train set configure failed (rc=%d)\n", rc);
+        return;
+    }
+
+    // min == max: the controller has no interval choice, so the listener
+    // side may assume the configured one exactly
+    ble_gap_periodic_adv_params trainParams = {};
+    trainParams.include_tx_power = 0;
+    trainParams.itvl_min = TRAIN_INTERVAL_UNITS;
+    trainParams.itvl_max = TRAIN_INTERVAL_UNITS;
+    rc = ble_gap_periodic_adv_configure(SYNC_PERIODIC_ADV_INSTANCE, &trainParams);
+    if (rc == 0) {
+#if MYNEWT_VAL(BLE_PERIODIC_ADV_ENH)
+        ble_gap_periodic_adv_start_params startParams = {};
+        rc = ble_gap_periodic_adv_start(SYNC_PERIODIC_ADV_INSTANCE, &startParams);
+#else
+        rc = ble_gap_periodic_adv_start(SYNC_PERIODIC_ADV_INSTANCE);
+#endif
+    }
+    if (rc == 0) {
+        rc = ble_gap_ext_adv_start(SYNC_PERIODIC_ADV_INSTANCE, 0, 0);
+    }
+    if (rc != 0) {
+        Serial.printf("[BLE] ERROR: Schedule train start failed (rc=%d)\n", rc);
+        return;
+    }
+
+    // The periodic train begins with the extended set. Its true start lies a
+    // constant controller latency after this; listeners calibrate that out.
+    s_train.startUs = getMicros();
+    s_train.intervalUs = static_cast<uint32_t>(TRAIN_INTERVAL_UNITS) * 1250;
+    s_trainRunning = true;
+    Serial.printf("[BLE] Schedule train started (%u ms interval)\n", (unsigned)SYNC_PERIODIC_ADV_INTERVAL_MS);
+}
+
+bool BLEManager::broadcastSchedule(const Macrocycle& macrocycle) {
+    if (_role != DeviceRole::PRIMARY || !s_trainRunning) {
+        return false;
+    }
+
+    uint8_t payload[SYNC_PERIODIC_ADV_MAX_DATA];
+    size_t len = ScheduleBroadcast::encode(payload, sizeof(payload), s_train, macrocycle);
+    if (len == 0) {
+        return false;
+    }
+
+    os_mbuf* data = os_msys_get_pkthdr(len, 0);
+    if (data == nullptr) {
+        return false;
+    }
+    if (os_mbuf_append(data, payload, len) != 0) {
+        os_mbuf_free_chain(data);
+        return false;
+    }
+
+    // set_data takes ownership of the mbuf chain
+#if MYNEWT_VAL(BLE_PERIODIC_ADV_ENH)
+    ble_gap_periodic_adv_set_data_params dataParams = {};
+    int rc = ble_gap_periodic_adv_set_data(SYNC_PERIODIC_ADV_INSTANCE, data, &dataParams);
+#else
+    int rc = ble_gap_periodic_adv_set_data(SYNC_PERIODIC_ADV_INSTANCE, data);
+#endif
+    return rc == 0;
+}
+
+static void deliverTrainReport(const ble_gap_event* event, uint64_t rxUs) {
+    // Reports may arrive in fragments; the first one's arrival is the anchor
+    if (s_reportLen == 0 && !s_reportOverflow) {
+        s_reportRxUs = rxUs;
+    }
+
+    uint8_t fragmentLen = event->periodic_report.data_length;
+    if (s_reportOverflow || s_reportLen + fragmentLen > sizeof(s_reportBuf)) {
+        s_reportOverflow = true;
+    } else {
+        memcpy(&s_reportBuf[s_reportLen], event->periodic_report.data, fragmentLen);
+        s_reportLen += fragmentLen;
+    }
+
+    uint8_t status = event->periodic_report.data_status;
+    if (status == BLE_HCI_PERIODIC_DATA_STATUS_INCOMPLETE) {
+        return;
+    }
+
+    // Truncated reports are dropped; the next train event repeats the payload
+    if (status == BLE_HCI_PERIODIC_DATA_STATUS_COMPLETE && !s_reportOverflow && s_reportLen > 0) {
+        BLEManager::_onScheduleReport(s_reportBuf, s_reportLen, s_reportRxUs);
+    }
+    s_reportLen = 0;
+    s_reportOverflow = false;
+}
+
+static int onTrainSyncEvent(ble_gap_event* event, void* arg [[maybe_unused]]) {
+    // Stamp first: everything below only adds latency to the anchor
+    uint64_t rxUs = getMicros();
+
+    switch (event->type) {
+    case BLE_GAP_EVENT_PERIODIC_SYNC:
+        if (event->periodic_sync.status == 0) {
+            s_trainSyncHandle = event->periodic_sync.sync_handle;
+            s_trainSynced = true;
+            ble_gap_disc_cancel();  // Synced: the scan has done its job
+            Serial.println(F("[BLE] Schedule train synced"));
+        } else if (s_listenerActive) {
+            s_pendingTrainResync = true;
+        }
+        break;
+
+    case BLE_GAP_EVENT_PERIODIC_REPORT:
+        if (s_trainSynced && event->periodic_report.sync_handle == s_trainSyncHandle) {
+            deliverTrainReport(event, rxUs);
+        }
+        break;
+
+    case BLE_GAP_EVENT_PERIODIC_SYNC_LOST:
+        s_trainSynced = false;
+        s_reportLen = 0;
+        s_reportOverflow = false;
+        if (s_listenerActive) {
+            Serial.printf("[BLE] Schedule train sync lost (reason=%d)\n", event->periodic_sync_lost.reason);
+            s_pendingTrainResync = true;
+        }
+        break;
+
+    default:
+        break;  // EXT_DISC reports from the sync scan: not needed
+    }
+    return 0;
+}
+
+static bool startTrainSync() {
+    ble_gap_periodic_sync_params syncParams = {};
+    syncParams.skip = 0;
+    syncParams.sync_timeout = TRAIN_SYNC_TIMEOUT_10MS;
+    syncParams.reports_disabled = 0;
+    int rc = ble_gap_periodic_adv_sync_create(&s_trainAddr, SYNC_PERIODIC_ADV_SID, &syncParams,
+                                              onTrainSyncEvent, nullptr);
+    if (rc != 0) {
+        Serial.printf("[BLE] ERROR: Schedule train sync create failed (rc=%d)\n", rc);
+        return false;
+    }
+
+    // The controller needs the PRIMARY's extended adverts (AUX SyncInfo) to
+    // sync: passive, 20% duty so the connection keeps its events
+    ble_gap_ext_disc_params scanParams = {};
+    scanParams.itvl = 160;   // 100ms
+    scanParams.window = 32;  // 20ms
+    scanParams.passive = 1;
+    rc = ble_gap_ext_disc(BLE_OWN_ADDR_PUBLIC, 0, 0, 0, BLE_HCI_SCAN_FILT_NO_WL, 0,
+                          &scanParams, nullptr, onTrainSyncEvent, nullptr);
+    if (rc != 0) {
+        ble_gap_periodic_adv_sync_create_cancel();
+        Serial.printf("[BLE] ERROR: Schedule train scan failed (rc=%d)\n", rc);
+        return false;
+    }
     return true;
 }
 
+bool BLEManager::startScheduleListener() {
+    if (_role != DeviceRole::SECONDARY || s_listenerActive) {
+        return s_listenerActive;
+    }
+
+    // The train comes from the PRIMARY we are connected to, same address
+    ble_gap_conn_desc desc;
+    uint16_t handle = getPrimaryHandle();
+    if (handle == CONN_HANDLE_INVALID || ble_gap_conn_find(handle, &desc) != 0) {
+        return false;
+    }
+    s_trainAddr = desc.peer_ota_addr;
+
+    s_reportLen = 0;
+    s_reportOverflow = false;
+    s_pendingTrainResync = false;
+    s_listenerActive = startTrainSync();
+    return s_listenerActive;
+}
+
+void BLEManager::stopScheduleListener() {
+    if (!s_listenerActive) {
+        return;
+    }
+    s_listenerActive = false;
+    s_pendingTrainResync = false;
+
+    if (s_trainSynced) {
+        s_trainSynced = false;
+        ble_gap_periodic_adv_sync_terminate(s_trainSyncHandle);
+    } else {
+        ble_gap_periodic_adv_sync_create_cancel();
+        ble_gap_disc_cancel();
+    }
+    Serial.println(F("[BLE] Schedule train listener stopped"));
+}
+
+#else
+
+bool BLEManager::broadcastSchedule(const Macrocycle& macrocycle [[maybe_unused]]) {
+    return false;
+}
+
+bool BLEManager::startScheduleListener() {
+    return false;
+}
+
+void BLEManager::stopScheduleListener() {
+}
+
+#endif  // SYNC_PERIODIC_ADV_ENABLED
+
 // =============================================================================
 // INTERNAL HELPERS
 // =============================================================================
@@ -895,7 +1337,9 @@ void BLEManager::queryConnectionInterval(uint16_t connHandleParam) {
                            (conn->type == ConnectionType::SECONDARY) ? "SECONDARY" :
                            (conn->type == ConnectionType::PRIMARY) ? "PRIMARY" : "UNKNOWN";
 
-    if (intervalMs > BLE_INTERVAL_WARNING_THRESHOLD_MS) {
+    if (_connParamProfile == ConnParamProfile::RELAXED) {
+        Serial.printf("[BLE] %s connection interval: %.1fms (relaxed)\n", typeName, intervalMs);
+    } else if (intervalMs > BLE_INTERVAL_WARNING_THRESHOLD_MS) {
         Serial.printf("[BLE] WARN: %s interval %.1fms exceeds target (%.1f-%.1fms)\n",
                       typeName, intervalMs, BLE_INTERVAL_MIN_MS, (float)BLE_INTERVAL_MAX_MS);
     } else {
@@ -923,52 +1367,78 @@ float BLEManager::getSecondaryConnectionIntervalMs() const {
     return 0.0f;
 }
 
+bool BLEManager::getPeerAddress(uint16_t connHandleParam, uint8_t* addrOut) const {
+    struct ble_gap_conn_desc desc;
+    if (ble_gap_conn_find(connHandleParam, &desc) != 0) {
+        return false;
+    }
+    // Identity address: stable across the peer's RPA rotations
+    memcpy(addrOut, desc.peer_id_addr.val, sizeof(desc.peer_id_addr.val));
+    return true;
+}
+
 void BLEManager::processIncomingData(uint16_t connHandleParam, const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
     BBConnection* conn = findConnection(connHandleParam);
     if (!conn) return;
 
-    if (conn->rxIndex == 0) {
-        conn->rxTimestamp = rxTimestamp;
-    }
+    receiveFrames(conn, data, len, rxTimestamp);
+}
+
+void BLEManager::processClientIncomingData(const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
+    // Find PRIMARY connection (SECONDARY mode)
+    BBConnection* conn = findConnectionByType(ConnectionType::PRIMARY);
+    if (!conn) return;
 
-    for (uint16_t i = 0; i < len && conn->rxIndex < RX_BUFFER_SIZE - 1; i++) {
-        uint8_t c = data[i];
+    receiveFrames(conn, data, len, rxTimestamp);
+}
 
-        if (c == '\r') {
-            continue;
-        }
+void BLEManager::receiveFrames(BBConnection* conn, const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
+    // Capture timestamp for first byte of message (if no partial frame)
+    if (conn->rx.idle()) {
+        conn->rxTimestamp = rxTimestamp;
+    }
 
-        if (c == EOT_CHAR) {
-            conn->rxBuffer[conn->rxIndex] = '\0';
-            if (conn->rxIndex > 0) {
-                deliverMessage(conn, connHandleParam);
-            }
-            conn->rxIndex = 0;
-        } else {
-            conn->rxBuffer[conn->rxIndex++] = c;
-        }
+    // NOTE: Partial messages are never delivered - messages can be
+    // fragmented across BLE packets, and only the EOT terminator ends one.
+    // Phone apps MUST send EOT (0x04) for proper message framing.
+    uint32_t oversizeBefore = conn->rx.oversizeCount();
+    size_t remaining = len;
+    const char* frame;
+    size_t frameLength;
+    while (conn->rx.feed(data, remaining, frame, frameLength)) {
+        deliverMessage(conn, conn->connHandle, frame, frameLength);
+        conn->rxTimestamp = rxTimestamp;  // Anything left started in this packet
     }
 
-    if (conn->rxIndex >= RX_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] WARNING: RX buffer overflow, clearing"));
-        conn->rxIndex = 0;
+    uint32_t oversize = conn->rx.oversizeCount() - oversizeBefore;
+    if (oversize > 0) {
+        _rxOversizeFrames += oversize;
+        Serial.printf("[BLE] WARNING: RX frame over %u bytes dropped (handle=%d, total=%lu)\n",
+                      (unsigned)(RX_BUFFER_SIZE - 1), conn->connHandle,
+                      (unsigned long)_rxOversizeFrames);
     }
 }
 
-void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam) {
+void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam, const char* frame, size_t length) {
     if (conn->pendingIdentify) {
-        if (strcmp(conn->rxBuffer, "IDENTIFY:SECONDARY") == 0) {
+        if (std::string_view(frame, length) == "IDENTIFY:SECONDARY") {
             Serial.println(F("[BLE] Received IDENTIFY:SECONDARY"));
             conn->type = ConnectionType::SECONDARY;
+            conn->identifyOrder = ++_identifyCounter;
             conn->pendingIdentify = false;
             queryConnectionInterval(connHandleParam);
             if (_connectCallback) {
                 _connectCallback(connHandleParam, ConnectionType::SECONDARY);
             }
             return;
-        } else if (strcmp(conn->rxBuffer, "IDENTIFY:PHONE") == 0) {
-            Serial.println(F("[BLE] Received IDENTIFY:PHONE"));
+        }
+        // "IDENTIFY:PHONE" (text responses) or "IDENTIFY:PHONE:<version>"
+        uint8_t protocol = phoneProtocolFromIdentify(
+            frame, PHONE_PROTOCOL_V3_ENABLED ? PHONE_PROTOCOL_BINARY : PHONE_PROTOCOL_TEXT);
+        if (protocol != 0) {
+            Serial.printf("[BLE] Received IDENTIFY:PHONE (protocol v%u)\n", protocol);
             conn->type = ConnectionType::PHONE;
+            conn->phoneProtocol = protocol;
             conn->pendingIdentify = false;
             queryConnectionInterval(connHandleParam);
             if (_connectCallback) {
@@ -979,39 +1449,7 @@ void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam) {
     }
 
     if (_messageCallback) {
-        _messageCallback(connHandleParam, conn->rxBuffer, conn->rxTimestamp);
-    }
-}
-
-void BLEManager::processClientIncomingData(const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
-    BBConnection* conn = findConnectionByType(ConnectionType::PRIMARY);
-    if (!conn) return;
-
-    if (conn->rxIndex == 0) {
-        conn->rxTimestamp = rxTimestamp;
-    }
-
-    for (uint16_t i = 0; i < len && conn->rxIndex < RX_BUFFER_SIZE - 1; i++) {
-        uint8_t c = data[i];
-
-        if (c == '\r') {
-            continue;
-        }
-
-        if (c == EOT_CHAR) {
-            conn->rxBuffer[conn->rxIndex] = '\0';
-            if (conn->rxIndex > 0 && _messageCallback) {
-                _messageCallback(conn->connHandle, conn->rxBuffer, conn->rxTimestamp);
-            }
-            conn->rxIndex = 0;
-        } else {
-            conn->rxBuffer[conn->rxIndex++] = c;
-        }
-    }
-
-    if (conn->rxIndex >= RX_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] WARNING: RX buffer overflow, clearing"));
-        conn->rxIndex = 0;
+        _messageCallback(connHandleParam, frame, length, conn->rxTimestamp);
     }
 }
 
@@ -1031,6 +1469,76 @@ static void requestPhy2M(uint16_t connHandle [[maybe_unused]]) {
 #endif
 }
 
+bool BLEManager::requestPhy(uint16_t connHandleParam, uint8_t phyMask) {
+    // S2 rather than S8 on Coded: twice the rate of S8 for most of its
+    // range gain, which keeps a MACROCYCLE inside one connection event
+    uint16_t options = (phyMask == BLE_GAP_LE_PHY_CODED_MASK) ? BLE_GAP_LE_PHY_CODED_S2 : 0;
+    int rc = ble_gap_set_prefered_le_phy(connHandleParam, phyMask, phyMask, options);
+    if (rc != 0) {
+        Serial.printf("[BLE] WARN: PHY request failed for handle %d (rc=%d)\n", connHandleParam, rc);
+        return false;
+    }
+    return true;
+}
+
+uint8_t BLEManager::getPhy(uint16_t connHandleParam) const {
+    uint8_t txPhy = 0;
+    uint8_t rxPhy = 0;
+    if (ble_gap_read_le_phy(connHandleParam, &txPhy, &rxPhy) != 0) {
+        return 0;
+    }
+    // HCI PHY numbers (1M=1, 2M=2, Coded=3) -> PHY bits
+    switch (txPhy) {
+        case BLE_GAP_LE_PHY_1M:    return BLE_GAP_LE_PHY_1M_MASK;
+        case BLE_GAP_LE_PHY_2M:    return BLE_GAP_LE_PHY_2M_MASK;
+        case BLE_GAP_LE_PHY_CODED: return BLE_GAP_LE_PHY_CODED_MASK;
+        default:                   return 0;
+    }
+}
+
+// =============================================================================
+// CONNECTION PARAMETERS
+// =============================================================================
+
+void BLEManager::applyConnParamProfile(ConnParamProfile profile) {
+    _connParamProfile = profile;
+    bool tight = (profile == ConnParamProfile::TIGHT);
+
+    // As peripheral (PRIMARY) this starts a parameter request the central
+    // may refuse; as central (SECONDARY) it updates the link directly
+    ble_gap_upd_params params = {};
+    params.itvl_min = tight ? CONN_INTERVAL_MIN_UNITS : CONN_RELAXED_MIN_UNITS;
+    params.itvl_max = tight ? CONN_INTERVAL_MAX_UNITS : CONN_RELAXED_MAX_UNITS;
+    params.latency = tight ? 0 : BLE_RELAXED_SLAVE_LATENCY;
+    params.supervision_timeout = CONN_SUPERVISION_TIMEOUT_10MS;
+
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        BBConnection* conn = &_connections[i];
+        if (!conn->isConnected || conn->pendingIdentify) {
+            continue;
+        }
+
+        int rc = ble_gap_update_params(conn->connHandle, &params);
+        if (rc != 0) {
+            Serial.printf("[BLE] WARN: connection parameter request failed for handle %d (rc=%d)\n",
+                          conn->connHandle, rc);
+            continue;
+        }
+
+        // The phone may have dropped the link to 1M while it was relaxed
+        // (PhyManager owns the SECONDARY link's PHY)
+        if (tight && !(BLE_PHY_AUTO_ENABLED && conn->type == ConnectionType::SECONDARY)) {
+            requestPhy2M(conn->connHandle);
+        }
+
+        // Log what the central settled on once the update instant has passed
+        conn->pendingIntervalRequery = true;
+        conn->intervalRequeryTime = millis() + 1000;
+    }
+
+    Serial.printf("[BLE] Requested %s connection parameters\n", tight ? "tight" : "relaxed");
+}
+
 // =============================================================================
 // STATIC CALLBACKS (dispatched from the NimBLE host task)
 // =============================================================================
@@ -1047,6 +1555,8 @@ void BLEManager::_onPeriphConnect(uint16_t connHandleParam) {
     if (s_server) {
         s_server->updateConnParams(connHandleParam, CONN_INTERVAL_MIN_UNITS,
                                    CONN_INTERVAL_MAX_UNITS, 0, CONN_SUPERVISION_TIMEOUT_10MS);
+        // 251-byte LL PDUs; the peer central starts the MTU exchange
+        s_server->setDataLen(connHandleParam, BLE_DLE_TX_OCTETS);
     }
 
     BBConnection* conn = g_bleManager->findFreeConnection();
@@ -1062,7 +1572,7 @@ void BLEManager::_onPeriphConnect(uint16_t connHandleParam) {
     conn->connectedAt = millis();
     conn->pendingIdentify = true;
     conn->identifyStartTime = millis();
-    conn->rxIndex = 0;
+    conn->rx.clear();
 
     Serial.println(F("[BLE] Waiting for IDENTIFY message (1000ms timeout)..."));
 
@@ -1073,12 +1583,23 @@ void BLEManager::_onPeriphConnect(uint16_t connHandleParam) {
         g_bleManager->startAdvertisingInternal();
     } else {
         Serial.println(F("[BLE] All connection slots full, stopping advertising"));
-        NimBLEDevice::getAdvertising()->stop();
+        stopConnectableAdvertising();
     }
 
     // Don't fire connect callback yet - wait for identification or timeout
 }
 
+void BLEManager::_onMtuChange(uint16_t connHandle, uint16_t mtu) {
+    if (!g_bleManager) return;
+
+    Serial.printf("[BLE] MTU negotiated: %u (handle=%d)\n", mtu, connHandle);
+
+    BBConnection* conn = g_bleManager->findConnection(connHandle);
+    if (conn) {
+        conn->attMtu = mtu;
+    }
+}
+
 void BLEManager::_onPeriphDisconnect(uint16_t connHandle, uint8_t reason) {
     if (!g_bleManager) return;
 
@@ -1115,7 +1636,14 @@ void BLEManager::_onCentralConnect(uint16_t connHandle) {
     conn->type = ConnectionType::PRIMARY;
     conn->isConnected = true;
     conn->connectedAt = millis();
-    conn->rxIndex = 0;
+    conn->rx.clear();
+
+    // NimBLE's client exchanges MTU during connect(); DLE for 251-byte PDUs
+    if (s_client) {
+        conn->attMtu = s_client->getMTU();
+        s_client->setDataLen(BLE_DLE_TX_OCTETS);
+        Serial.printf("[BLE] MTU negotiated: %u (handle=%d)\n", conn->attMtu, connHandle);
+    }
 
     // Discover the NUS service on PRIMARY and subscribe to its TX notifications
     Serial.println(F("[BLE] Discovering UART service on PRIMARY..."));
@@ -1176,6 +1704,9 @@ void BLEManager::_onCentralDisconnect(uint16_t connHandle, uint8_t reason) {
 
     s_remoteRx = nullptr;
 
+    // The scan for the train would block the PRIMARY rescan
+    g_bleManager->stopScheduleListener();
+
     BBConnection* conn = g_bleManager->findConnection(connHandle);
     if (conn) {
         conn->reset();
@@ -8,6 +8,7 @@
 #include "ble_manager.h"
 #include "sync_protocol.h"  // For getMicros() - overflow-safe 64-bit timestamp
 #include "platform.h"
+#include "perf_profile.h"
 
 // =============================================================================
 // GLOBAL INSTANCE (needed for static callbacks)
@@ -26,10 +27,12 @@ BLEManager::BLEManager() :
     _connectCallback(nullptr),
     _disconnectCallback(nullptr),
     _messageCallback(nullptr),
+    _rxOversizeFrames(0),
+    _identifyCounter(0),
+    _txQueue(),
     _txStampCallback(nullptr),
-    _txHead(0),
-    _txTail(0),
-    _txCount(0)
+    _scheduleBroadcastCallback(nullptr),
+    _connParamProfile(ConnParamProfile::TIGHT)
 {
     memset(_deviceName, 0, sizeof(_deviceName));
     memset(_targetName, 0, sizeof(_targetName));
@@ -41,13 +44,6 @@ BLEManager::BLEManager() :
         _connections[i].reset();
     }
 
-    // Initialize TX queue
-    for (uint8_t i = 0; i < TX_QUEUE_SIZE; i++) {
-        _txQueue[i].pending = false;
-        _txQueue[i].length = 0;
-        _txQueue[i].bytesSent = 0;
-    }
-
     // Set global instance for static callbacks
     g_bleManager = this;
 }
@@ -88,13 +84,14 @@ bool BLEManager::begin(DeviceRole role, const char* deviceName) {
     // ==========================================================================
 
     // Proper BLE configuration for reliable large message transmission
-    // MACROCYCLE messages are ~160 bytes - MTU must exceed this to avoid fragmentation
+    // MTU 247 is the largest ATT payload one 251-byte Data Length Extension
+    // PDU carries: a 512-byte response is 3 notifications instead of 6+.
     // EVENT_LEN and queue sizes must also be increased to prevent SoftDevice instability
     // See: https://github.com/adafruit/Adafruit_nRF52_Arduino/issues/721
-    const uint16_t BLE_MTU = 200;          // Fits MACROCYCLE (~160 bytes) with headroom
+    const uint16_t BLE_MTU = BLE_ATT_MTU;
     const uint16_t BLE_EVENT_LEN = 10;     // 12.5ms - sufficient for full packet + 2 connections
-    const uint8_t  BLE_HVN_QSIZE = 8;      // Handle notification bursts without overflow
-    const uint8_t  BLE_WRCMD_QSIZE = 8;    // Match for write commands
+    const uint8_t  BLE_HVN_QSIZE = BLE_TX_WRITES_PER_PASS;  // One processTxQueue pass fits the queue
+    const uint8_t  BLE_WRCMD_QSIZE = BLE_TX_WRITES_PER_PASS;
 
     // API: configPrphConn(mtu_max, event_len, hvn_qsize, wrcmd_qsize)
     if (role == DeviceRole::PRIMARY) {
@@ -111,14 +108,21 @@ bool BLEManager::begin(DeviceRole role, const char* deviceName) {
 
     // Initialize Bluefruit with appropriate connection counts
     if (role == DeviceRole::PRIMARY) {
-        // PRIMARY: 2 peripheral connections (phone + SECONDARY), 0 central
-        Bluefruit.begin(2, 0);
-        Serial.println(F("[BLE] PRIMARY mode: 2 peripheral connections enabled"));
+        // PRIMARY: phone + SECONDARY link(s) as peripheral connections, 0 central
+        Bluefruit.begin(MAX_CONNECTIONS, 0);
+        Serial.printf("[BLE] PRIMARY mode: %d peripheral connections enabled\n", MAX_CONNECTIONS);
     } else {
         // SECONDARY: 0 peripheral, 1 central connection (to PRIMARY)
         Bluefruit.begin(0, 1);
     }
 
+    // Let a connection event keep going while packets are queued, so several
+    // notifications (one multi-chunk message) share one event instead of
+    // waiting an interval each
+    ble_opt_t connEvtExt = {};
+    connEvtExt.common_opt.conn_evt_ext.enable = 1;
+    sd_ble_opt_set(BLE_COMMON_OPT_CONN_EVT_EXT, &connEvtExt);
+
     // Set device name
     Bluefruit.setName(_deviceName);
 
@@ -275,6 +279,21 @@ void BLEManager::update() {
             queryConnectionInterval(conn->connHandle);
         }
     }
+
+    // Track the negotiated ATT MTU (Bluefruit completes the exchange itself);
+    // the TX chunk size follows it
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        BBConnection* conn = &_connections[i];
+        if (!conn->isConnected) {
+            continue;
+        }
+        BLEConnection* bleConn = Bluefruit.Connection(conn->connHandle);
+        if (bleConn && bleConn->getMtu() != conn->attMtu) {
+            conn->attMtu = bleConn->getMtu();
+            Serial.printf("[BLE] MTU negotiated: %u, data length %u (handle=%d)\n",
+                          conn->attMtu, bleConn->getDataLength(), conn->connHandle);
+        }
+    }
 }
 
 // =============================================================================
@@ -390,6 +409,15 @@ bool BLEManager::isPhoneConnected() const {
     return false;
 }
 
+uint8_t BLEManager::getPhoneProtocol() const {
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        if (_connections[i].type == ConnectionType::PHONE && _connections[i].isConnected) {
+            return _connections[i].phoneProtocol;
+        }
+    }
+    return PHONE_PROTOCOL_TEXT;
+}
+
 bool BLEManager::isPrimaryConnected() const {
     for (int i = 0; i < MAX_CONNECTIONS; i++) {
         if (_connections[i].type == ConnectionType::PRIMARY && _connections[i].isConnected) {
@@ -422,12 +450,38 @@ void BLEManager::disconnectAll() {
 }
 
 uint16_t BLEManager::getSecondaryHandle() const {
+    // The first SECONDARY is the one that identified earliest, whatever slot it holds
+    uint16_t handle = CONN_HANDLE_INVALID;
+    uint32_t oldest = UINT32_MAX;
     for (int i = 0; i < MAX_CONNECTIONS; i++) {
-        if (_connections[i].type == ConnectionType::SECONDARY && _connections[i].isConnected) {
-            return _connections[i].connHandle;
+        if (_connections[i].type == ConnectionType::SECONDARY && _connections[i].isConnected &&
+            _connections[i].identifyOrder < oldest) {
+            oldest = _connections[i].identifyOrder;
+            handle = _connections[i].connHandle;
         }
     }
-    return CONN_HANDLE_INVALID;
+    return handle;
+}
+
+uint8_t BLEManager::getSecondaryHandles(uint16_t* handles, uint8_t maxHandles) const {
+    // Insertion by identification order (at most BLE_MAX_SECONDARIES entries)
+    uint32_t order[MAX_CONNECTIONS];
+    uint8_t count = 0;
+    for (int i = 0; i < MAX_CONNECTIONS && count < maxHandles; i++) {
+        const BBConnection& conn = _connections[i];
+        if (conn.type != ConnectionType::SECONDARY || !conn.isConnected) {
+            continue;
+        }
+        uint8_t j = count++;
+        while (j > 0 && order[j - 1] > conn.identifyOrder) {
+            order[j] = order[j - 1];
+            handles[j] = handles[j - 1];
+            j--;
+        }
+        order[j] = conn.identifyOrder;
+        handles[j] = conn.connHandle;
+    }
+    return count;
 }
 
 uint16_t BLEManager::getPhoneHandle() const {
@@ -452,83 +506,111 @@ uint16_t BLEManager::getPrimaryHandle() const {
 // MESSAGING
 // =============================================================================
 
-bool BLEManager::send(uint16_t connHandleParam, const char* message) {
-    if (connHandleParam == CONN_HANDLE_INVALID) {
+bool BLEManager::send(uint16_t connHandleParam, const char* message, TxPriority priority) {
+    // Same limit as the receiving glove's RX buffer, whatever the slot size
+    size_t msgLen = strlen(message);
+    if (msgLen >= MESSAGE_BUFFER_SIZE - 1) {
+        Serial.println(F("[BLE] ERROR: Message too large for TX buffer"));
         return false;
     }
 
-    // Find the connection
-    BBConnection* conn = findConnection(connHandleParam);
-    if (!conn || !conn->isConnected) {
+    BLETxSpan span = reserveTx(connHandleParam, msgLen + 1, priority);
+    if (!span) {
         return false;
     }
-
-    // Enqueue message for non-blocking transmission
-    return enqueueTx(connHandleParam, message);
+    memcpy(span.data, message, msgLen);
+    return commitTx(span, msgLen);
 }
 
-bool BLEManager::enqueueTx(uint16_t connHandle, const char* message) {
-    // Validate length before entering the critical section (no shared state read)
-    size_t msgLen = strlen(message);
-    if (msgLen >= MESSAGE_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] ERROR: Message too large for TX buffer"));
-        return false;
+BLETxSpan BLEManager::reserveTx(uint16_t connHandleParam, size_t maxLen, TxPriority priority) {
+    BLETxSpan span;
+    if (connHandleParam == CONN_HANDLE_INVALID) {
+        return span;
     }
 
-    // Reserve a slot atomically: capacity check, tail advance and count
-    // increment must be one unit to prevent a BLE-task enqueue racing the
-    // main-loop enqueue or processTxQueue between the check and the claim.
-    // The slot is NOT published (pending=true) until its fields are filled -
-    // the same reserve-fill-publish protocol as the NimBLE backend, where the
-    // consumer runs on another core. Single-core here, but keeping the two
-    // queue implementations identical beats relying on a priority argument.
-    PLATFORM_CRITICAL_ENTER();
-
-    if (_txCount >= TX_QUEUE_SIZE) {
-        PLATFORM_CRITICAL_EXIT();
-        Serial.println(F("[BLE] TX queue full, dropping message"));
-        return false;
+    BBConnection* conn = findConnection(connHandleParam);
+    if (!conn || !conn->isConnected) {
+        return span;
     }
 
-    TxEntry* entry = &_txQueue[_txTail];
-    if (entry->pending) {
-        PLATFORM_CRITICAL_EXIT();
-        Serial.println(F("[BLE] TX queue corruption detected"));
-        return false;
+    if (priority == TxPriority::DEFAULT) {
+        priority = (conn->type == ConnectionType::PHONE) ? TxPriority::RESPONSE : TxPriority::MACROCYCLE;
     }
 
-    _txTail = static_cast<uint8_t>((_txTail + 1) % TX_QUEUE_SIZE);
-    _txCount++;
+    // Never more than the receiving glove's RX buffer, whatever the slot size
+    const size_t maxMessage = MESSAGE_BUFFER_SIZE - 1;
+    if (maxLen > maxMessage) {
+        maxLen = maxMessage;
+    }
 
-    PLATFORM_CRITICAL_EXIT();
+    // Reserve-fill-publish: the slot is not visible to processTxQueue until
+    // commitTx publishes it (see ble_tx_queue.h)
+    BLETxEntry* entry = _txQueue.reserve(priority, maxLen);
+    if (entry == nullptr) {
+        Serial.printf("[BLE] TX queue full, dropping message (class %u)\n", static_cast<unsigned>(priority));
+        return span;
+    }
 
-    memcpy(entry->data, message, msgLen);
-    entry->data[msgLen] = EOT_CHAR;
-    entry->length = static_cast<uint16_t>(msgLen + 1);
     entry->bytesSent = 0;
-    entry->connHandle = connHandle;
+    entry->connHandle = connHandleParam;
     entry->stampKind = TxStampKind::NONE;
 
-    // Publish: all field stores must be visible before pending reads true
-    platformMemoryBarrier();
-    entry->pending = true;
+    span.data = entry->data;
+    span.capacity = (entry->capacity < maxMessage) ? entry->capacity : maxMessage;
+    span.entry = entry;
+    return span;
+}
 
-    return true;
+bool BLEManager::commitTx(BLETxSpan& span, size_t len) {
+    if (!span) {
+        return false;
+    }
+
+    // An abandoned slot is still published (length 0) so the ring keeps its
+    // order; processTxQueue releases it when it reaches the head
+    BLETxEntry* entry = span.entry;
+    bool queued = (len > 0 && len < span.capacity);
+    if (queued) {
+        entry->data[len] = EOT_CHAR;
+    }
+    entry->length = queued ? static_cast<uint16_t>(len + 1) : 0;
+
+    _txQueue.publish(entry);
+    span = BLETxSpan();
+    return queued;
+}
+
+bool BLEManager::sendCommand(uint16_t connHandleParam, const SyncCommand& command, TxPriority priority) {
+    // Any SyncCommand fits a SYNC-sized slot, whatever its class
+    BLETxSpan span = reserveTx(connHandleParam, BLE_TX_SYNC_SLOT_BYTES, priority);
+    if (!span) {
+        return false;
+    }
+    bool serialized = command.serialize(span.data, span.capacity);
+    return commitTx(span, serialized ? strlen(span.data) : 0);
 }
 
 void BLEManager::processTxQueue() {
-    // Process up to 4 queue entries per update for responsiveness
-    for (uint8_t i = 0; i < 4 && _txCount > 0; i++) {
-        TxEntry* entry = &_txQueue[_txHead];
-        if (!entry->pending) {
-            // Reserved but not yet published: the producer is still filling
-            // the entry. Retry next update() - advancing head here would
-            // free a slot mid-fill.
+    PERF_SCOPE(PROCESS_TX_QUEUE);
+    // Up to BLE_TX_WRITES_PER_PASS notifications per update - enough for a
+    // whole multi-chunk message to land in one connection event. The
+    // highest-priority writable entry is picked again before every write, so
+    // sync traffic queued mid-transfer goes out ahead of a bulk message's
+    // next chunk. A connection whose stack buffer is full is skipped for the
+    // rest of this pass.
+    uint16_t congested[MAX_CONNECTIONS];
+    uint8_t congestedCount = 0;
+    for (uint8_t i = 0; i < BLE_TX_WRITES_PER_PASS; i++) {
+        BLETxEntry* entry = _txQueue.next(congested, congestedCount);
+        if (entry == nullptr) {
             break;
         }
-        // Acquire: pending was observed true; ensure the field reads below
-        // see the producer's stores (pairs with the publish barrier)
-        platformMemoryBarrier();
+
+        // Abandoned by commitTx: nothing to write
+        if (entry->length == 0 && entry->stampKind == TxStampKind::NONE) {
+            _txQueue.release(entry);
+            continue;
+        }
 
         // Late timestamping: serialize sync messages at radio handoff so the
         // embedded T1/T3 reflects when bytes actually reach the SoftDevice.
@@ -548,20 +630,14 @@ void BLEManager::processTxQueue() {
                 cmd = SyncCommand::createPongWithTimestamps(entry->stampSeqId, entry->stampT2, stampTime);
             }
 
-            // Worst case ~82 bytes: PONG with 64-bit timestamp + 6 anchor-format data fields
-            char msg[128];
-            if (!cmd.serialize(msg, sizeof(msg))) {
+            // Serialized in place; the terminating NUL's byte becomes the EOT
+            if (!cmd.serialize(entry->data, entry->capacity)) {
                 uint32_t seqId = entry->stampSeqId;
-                PLATFORM_CRITICAL_ENTER();
-                entry->pending = false;
-                _txHead = static_cast<uint8_t>((_txHead + 1) % TX_QUEUE_SIZE);
-                _txCount--;
-                PLATFORM_CRITICAL_EXIT();
+                _txQueue.release(entry);
                 Serial.printf("[BLE] ERROR: stamped sync serialize failed seq=%lu\n", (unsigned long)seqId);
                 continue;
             }
-            size_t msgLen = strlen(msg);
-            memcpy(entry->data, msg, msgLen);
+            size_t msgLen = strlen(entry->data);
             entry->data[msgLen] = EOT_CHAR;
             entry->length = static_cast<uint16_t>(msgLen + 1);
         }
@@ -594,20 +670,24 @@ void BLEManager::processTxQueue() {
                 }
 
                 // Mark slot free and advance head
-                PLATFORM_CRITICAL_ENTER();
-                entry->pending = false;
-                _txHead = static_cast<uint8_t>((_txHead + 1) % TX_QUEUE_SIZE);
-                _txCount--;
-                PLATFORM_CRITICAL_EXIT();
+                _txQueue.release(entry);
             }
-        } else {
-            // Buffer full - stop processing this iteration, will retry next update()
-            break;
+        } else if (congestedCount < MAX_CONNECTIONS) {
+            // Buffer full for this connection - retry it next update()
+            congested[congestedCount++] = entry->connHandle;
         }
     }
 }
 
 size_t BLEManager::tryWriteImmediate(uint16_t connHandle, const uint8_t* data, size_t len) {
+    // One notification per attempt, sized to this link's MTU, so the queue
+    // can re-pick the next entry between chunks
+    BBConnection* conn = findConnection(connHandle);
+    size_t chunk = bleNotifyPayload(conn ? conn->attMtu : BLE_ATT_MTU_MIN);
+    if (len > chunk) {
+        len = chunk;
+    }
+
     // Non-blocking write attempt - use per-connection overload for PRIMARY
     // to target the correct recipient (phone vs secondary)
     if (_role == DeviceRole::PRIMARY) {
@@ -617,31 +697,36 @@ size_t BLEManager::tryWriteImmediate(uint16_t connHandle, const uint8_t* data, s
     }
 }
 
-bool BLEManager::sendToSecondary(const char* message) {
-    uint16_t handle = getSecondaryHandle();
-    if (handle == CONN_HANDLE_INVALID) {
+bool BLEManager::sendToSecondary(const char* message, TxPriority priority) {
+    uint16_t handles[BLE_MAX_SECONDARIES];
+    uint8_t count = getSecondaryHandles(handles, BLE_MAX_SECONDARIES);
+    if (count == 0) {
         Serial.println(F("[BLE] Cannot send: SECONDARY not connected"));
         return false;
     }
-    return send(handle, message);
+    bool allQueued = true;
+    for (uint8_t i = 0; i < count; i++) {
+        allQueued = send(handles[i], message, priority) && allQueued;
+    }
+    return allQueued;
 }
 
-bool BLEManager::sendToPhone(const char* message) {
+bool BLEManager::sendToPhone(const char* message, TxPriority priority) {
     uint16_t handle = getPhoneHandle();
     if (handle == CONN_HANDLE_INVALID) {
         Serial.println(F("[BLE] Cannot send: Phone not connected"));
         return false;
     }
-    return send(handle, message);
+    return send(handle, message, priority);
 }
 
-bool BLEManager::sendToPrimary(const char* message) {
+bool BLEManager::sendToPrimary(const char* message, TxPriority priority) {
     uint16_t handle = getPrimaryHandle();
     if (handle == CONN_HANDLE_INVALID) {
         Serial.println(F("[BLE] Cannot send: PRIMARY not connected"));
         return false;
     }
-    return send(handle, message);
+    return send(handle, message, priority);
 }
 
 uint8_t BLEManager::broadcast(const char* message) {
@@ -676,8 +761,8 @@ void BLEManager::setTxStampCallback(BLETxStampCallback callback) {
     _txStampCallback = callback;
 }
 
-bool BLEManager::sendPingStamped(uint32_t seqId) {
-    uint16_t handle = getSecondaryHandle();
+bool BLEManager::sendPingStamped(uint32_t seqId, uint16_t connHandle) {
+    uint16_t handle = (connHandle != CONN_HANDLE_INVALID) ? connHandle : getSecondaryHandle();
     if (handle == CONN_HANDLE_INVALID) {
         return false;
     }
@@ -691,29 +776,38 @@ bool BLEManager::sendPongStamped(uint16_t connHandle, uint32_t seqId, uint64_t t
     return enqueueStamped(connHandle, TxStampKind::PONG_T3, seqId, t2, anchorUs);
 }
 
+// =============================================================================
+// SCHEDULE BROADCAST
+// =============================================================================
+
+// The S140 SoftDevice in use has no periodic advertising: schedules travel
+// over GATT only
+
+bool BLEManager::broadcastSchedule(const Macrocycle& macrocycle [[maybe_unused]]) {
+    return false;
+}
+
+bool BLEManager::startScheduleListener() {
+    return false;
+}
+
+void BLEManager::stopScheduleListener() {
+}
+
+void BLEManager::setScheduleBroadcastCallback(BLEScheduleBroadcastCallback callback) {
+    _scheduleBroadcastCallback = callback;
+}
+
 bool BLEManager::enqueueStamped(uint16_t connHandle, TxStampKind kind, uint32_t seqId,
                                 uint64_t t2, uint64_t anchorUs) {
-    // Reserve-fill-publish, same protocol as enqueueTx.
-    PLATFORM_CRITICAL_ENTER();
-
-    if (_txCount >= TX_QUEUE_SIZE) {
-        PLATFORM_CRITICAL_EXIT();
+    // Reserve-fill-publish, same protocol as reserveTx. Serialized at write
+    // time into the SYNC slot (worst case ~82 B + EOT).
+    BLETxEntry* entry = _txQueue.reserve(TxPriority::SYNC, BLE_TX_SYNC_SLOT_BYTES);
+    if (entry == nullptr) {
         Serial.println(F("[BLE] TX queue full, dropping sync message"));
         return false;
     }
 
-    TxEntry* entry = &_txQueue[_txTail];
-    if (entry->pending) {
-        PLATFORM_CRITICAL_EXIT();
-        Serial.println(F("[BLE] TX queue corruption detected"));
-        return false;
-    }
-
-    _txTail = static_cast<uint8_t>((_txTail + 1) % TX_QUEUE_SIZE);
-    _txCount++;
-
-    PLATFORM_CRITICAL_EXIT();
-
     entry->stampKind = kind;
     entry->stampSeqId = seqId;
     entry->stampT2 = t2;
@@ -722,10 +816,7 @@ bool BLEManager::enqueueStamped(uint16_t connHandle, TxStampKind kind, uint32_t
     entry->bytesSent = 0;
     entry->connHandle = connHandle;
 
-    // Publish: all field stores must be visible before pending reads true
-    platformMemoryBarrier();
-    entry->pending = true;
-
+    _txQueue.publish(entry);
     return true;
 }
 
@@ -804,7 +895,9 @@ void BLEManager::queryConnectionInterval(uint16_t connHandleParam) {
                            (conn->type == ConnectionType::SECONDARY) ? "SECONDARY" :
                            (conn->type == ConnectionType::PRIMARY) ? "PRIMARY" : "UNKNOWN";
 
-    if (intervalMs > BLE_INTERVAL_WARNING_THRESHOLD_MS) {
+    if (_connParamProfile == ConnParamProfile::RELAXED) {
+        Serial.printf("[BLE] %s connection interval: %.1fms (relaxed)\n", typeName, intervalMs);
+    } else if (intervalMs > BLE_INTERVAL_WARNING_THRESHOLD_MS) {
         Serial.printf("[BLE] WARN: %s interval %.1fms exceeds target (%.1f-%.1fms)\n",
                       typeName, intervalMs, BLE_INTERVAL_MIN_MS, BLE_INTERVAL_MAX_MS);
     } else {
@@ -832,68 +925,145 @@ float BLEManager::getSecondaryConnectionIntervalMs() const {
     return 0.0f;
 }
 
-void BLEManager::processIncomingData(uint16_t connHandleParam, const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
-    BBConnection* conn = findConnection(connHandleParam);
-    if (!conn) return;
+bool BLEManager::getPeerAddress(uint16_t connHandleParam, uint8_t* addrOut) const {
+    BLEConnection* bleConn = Bluefruit.Connection(connHandleParam);
+    if (!bleConn || !bleConn->connected()) {
+        return false;
+    }
+    ble_gap_addr_t addr = bleConn->getPeerAddr();
+    memcpy(addrOut, addr.addr, BLE_GAP_ADDR_LEN);
+    return true;
+}
 
-    // Capture timestamp for first byte of message (if buffer was empty)
-    if (conn->rxIndex == 0) {
-        conn->rxTimestamp = rxTimestamp;
+bool BLEManager::requestPhy(uint16_t connHandleParam, uint8_t phyMask) {
+    // The SoftDevice picks the Coded coding itself (no S2/S8 choice here)
+    BLEConnection* bleConn = Bluefruit.Connection(connHandleParam);
+    if (!bleConn || !bleConn->connected()) {
+        return false;
+    }
+    if (!bleConn->requestPHY(phyMask)) {
+        Serial.printf("[BLE] WARN: PHY request failed for handle %d\n", connHandleParam);
+        return false;
+    }
+    return true;
+}
+
+uint8_t BLEManager::getPhy(uint16_t connHandleParam) const {
+    BLEConnection* bleConn = Bluefruit.Connection(connHandleParam);
+    if (!bleConn || !bleConn->connected()) {
+        return 0;
     }
+    return bleConn->getPHY();  // BLE_GAP_PHY_1MBPS / _2MBPS / _CODED
+}
 
-    // Append data to buffer
-    for (uint16_t i = 0; i < len && conn->rxIndex < RX_BUFFER_SIZE - 1; i++) {
-        uint8_t c = data[i];
+void BLEManager::applyConnParamProfile(ConnParamProfile profile) {
+    _connParamProfile = profile;
+    bool tight = (profile == ConnParamProfile::TIGHT);
+
+    // As peripheral (PRIMARY) this sends a parameter request the central
+    // may refuse; as central (SECONDARY) it updates the link directly
+    ble_gap_conn_params_t connParams = {
+        .min_conn_interval = tight ? static_cast<uint16_t>((BLE_INTERVAL_MIN_MS * 1000) / 1250)
+                                   : static_cast<uint16_t>((BLE_RELAXED_INTERVAL_MIN_MS * 1000) / 1250),
+        .max_conn_interval = tight ? static_cast<uint16_t>((BLE_INTERVAL_MAX_MS * 1000) / 1250)
+                                   : static_cast<uint16_t>((BLE_RELAXED_INTERVAL_MAX_MS * 1000) / 1250),
+        .slave_latency = tight ? static_cast<uint16_t>(0) : static_cast<uint16_t>(BLE_RELAXED_SLAVE_LATENCY),
+        .conn_sup_timeout = BLE_TIMEOUT_MS / 10,
+    };
 
-        // Skip carriage return
-        if (c == '\r') {
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        BBConnection* conn = &_connections[i];
+        if (!conn->isConnected || conn->pendingIdentify) {
             continue;
         }
 
-        // Check for message terminator (EOT only - phone apps must send EOT)
-        if (c == EOT_CHAR) {
-            // End of message - null terminate
-            conn->rxBuffer[conn->rxIndex] = '\0';
+        if (sd_ble_gap_conn_param_update(conn->connHandle, &connParams) != NRF_SUCCESS) {
+            Serial.printf("[BLE] WARN: connection parameter request failed for handle %d\n", conn->connHandle);
+            continue;
+        }
 
-            if (conn->rxIndex > 0) {
-                deliverMessage(conn, connHandleParam);
+#ifdef BLE_USE_2M_PHY
+        // The phone may have dropped the link to 1M while it was relaxed
+        // (PhyManager owns the SECONDARY link's PHY)
+        if (tight && !(BLE_PHY_AUTO_ENABLED && conn->type == ConnectionType::SECONDARY)) {
+            BLEConnection* bleConn = Bluefruit.Connection(conn->connHandle);
+            if (bleConn) {
+                bleConn->requestPHY(BLE_GAP_PHY_2MBPS);
             }
-
-            // Reset buffer for next message
-            conn->rxIndex = 0;
-        } else {
-            // Add to buffer
-            conn->rxBuffer[conn->rxIndex++] = c;
         }
+#endif
+
+        // Log what the central settled on once the update instant has passed
+        conn->pendingIntervalRequery = true;
+        conn->intervalRequeryTime = millis() + 1000;
     }
 
-    // NOTE: Do NOT deliver partial messages here!
-    // Messages can be fragmented across BLE packets.
-    // Only deliver when EOT terminator is received.
-    // Phone apps MUST send EOT (0x04) for proper message framing.
+    Serial.printf("[BLE] Requested %s connection parameters\n", tight ? "tight" : "relaxed");
+}
+
+void BLEManager::processIncomingData(uint16_t connHandleParam, const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
+    BBConnection* conn = findConnection(connHandleParam);
+    if (!conn) return;
+
+    receiveFrames(conn, data, len, rxTimestamp);
+}
+
+void BLEManager::processClientIncomingData(const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
+    // Find PRIMARY connection (SECONDARY mode)
+    BBConnection* conn = findConnectionByType(ConnectionType::PRIMARY);
+    if (!conn) return;
+
+    receiveFrames(conn, data, len, rxTimestamp);
+}
 
-    // Handle buffer overflow
-    if (conn->rxIndex >= RX_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] WARNING: RX buffer overflow, clearing"));
-        conn->rxIndex = 0;
+void BLEManager::receiveFrames(BBConnection* conn, const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
+    // Capture timestamp for first byte of message (if no partial frame)
+    if (conn->rx.idle()) {
+        conn->rxTimestamp = rxTimestamp;
+    }
+
+    // NOTE: Partial messages are never delivered - messages can be
+    // fragmented across BLE packets, and only the EOT terminator ends one.
+    // Phone apps MUST send EOT (0x04) for proper message framing.
+    uint32_t oversizeBefore = conn->rx.oversizeCount();
+    size_t remaining = len;
+    const char* frame;
+    size_t frameLength;
+    while (conn->rx.feed(data, remaining, frame, frameLength)) {
+        deliverMessage(conn, conn->connHandle, frame, frameLength);
+        conn->rxTimestamp = rxTimestamp;  // Anything left started in this packet
+    }
+
+    uint32_t oversize = conn->rx.oversizeCount() - oversizeBefore;
+    if (oversize > 0) {
+        _rxOversizeFrames += oversize;
+        Serial.printf("[BLE] WARNING: RX frame over %u bytes dropped (handle=%d, total=%lu)\n",
+                      (unsigned)(RX_BUFFER_SIZE - 1), conn->connHandle,
+                      (unsigned long)_rxOversizeFrames);
     }
 }
 
-void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam) {
+void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam, const char* frame, size_t length) {
     // Check for IDENTIFY messages (handshake protocol)
     if (conn->pendingIdentify) {
-        if (strcmp(conn->rxBuffer, "IDENTIFY:SECONDARY") == 0) {
+        if (std::string_view(frame, length) == "IDENTIFY:SECONDARY") {
             Serial.println(F("[BLE] Received IDENTIFY:SECONDARY"));
             conn->type = ConnectionType::SECONDARY;
+            conn->identifyOrder = ++_identifyCounter;
             conn->pendingIdentify = false;
             queryConnectionInterval(connHandleParam);
             if (_connectCallback) {
                 _connectCallback(connHandleParam, ConnectionType::SECONDARY);
             }
             return;
-        } else if (strcmp(conn->rxBuffer, "IDENTIFY:PHONE") == 0) {
-            Serial.println(F("[BLE] Received IDENTIFY:PHONE"));
+        }
+        // "IDENTIFY:PHONE" (text responses) or "IDENTIFY:PHONE:<version>"
+        uint8_t protocol = phoneProtocolFromIdentify(
+            frame, PHONE_PROTOCOL_V3_ENABLED ? PHONE_PROTOCOL_BINARY : PHONE_PROTOCOL_TEXT);
+        if (protocol != 0) {
+            Serial.printf("[BLE] Received IDENTIFY:PHONE (protocol v%u)\n", protocol);
             conn->type = ConnectionType::PHONE;
+            conn->phoneProtocol = protocol;
             conn->pendingIdentify = false;
             queryConnectionInterval(connHandleParam);
             if (_connectCallback) {
@@ -905,50 +1075,7 @@ void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam) {
 
     // Normal message - deliver to callback with captured RX timestamp
     if (_messageCallback) {
-        _messageCallback(connHandleParam, conn->rxBuffer, conn->rxTimestamp);
-    }
-}
-
-void BLEManager::processClientIncomingData(const uint8_t* data, uint16_t len, uint64_t rxTimestamp) {
-    // Find PRIMARY connection (SECONDARY mode)
-    BBConnection* conn = findConnectionByType(ConnectionType::PRIMARY);
-    if (!conn) return;
-
-    // Capture timestamp for first byte of message (if buffer was empty)
-    if (conn->rxIndex == 0) {
-        conn->rxTimestamp = rxTimestamp;
-    }
-
-    // Append data to buffer
-    for (uint16_t i = 0; i < len && conn->rxIndex < RX_BUFFER_SIZE - 1; i++) {
-        uint8_t c = data[i];
-
-        // Skip carriage return
-        if (c == '\r') {
-            continue;
-        }
-
-        // Check for message terminator (EOT only - phone apps must send EOT)
-        if (c == EOT_CHAR) {
-            // End of message - null terminate and deliver
-            conn->rxBuffer[conn->rxIndex] = '\0';
-
-            if (conn->rxIndex > 0 && _messageCallback) {
-                _messageCallback(conn->connHandle, conn->rxBuffer, conn->rxTimestamp);
-            }
-
-            // Reset buffer for next message
-            conn->rxIndex = 0;
-        } else {
-            // Add to buffer
-            conn->rxBuffer[conn->rxIndex++] = c;
-        }
-    }
-
-    // Handle buffer overflow
-    if (conn->rxIndex >= RX_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] WARNING: RX buffer overflow, clearing"));
-        conn->rxIndex = 0;
+        _messageCallback(connHandleParam, frame, length, conn->rxTimestamp);
     }
 }
 
@@ -961,15 +1088,22 @@ void BLEManager::_onPeriphConnect(uint16_t connHandleParam) {
 
     Serial.printf("[BLE] Peripheral connected: handle=%d\n", connHandleParam);
 
+    BLEConnection* bleConn = Bluefruit.Connection(connHandleParam);
+
     // Request 2M PHY for faster BLE transmission (reduces latency)
 #ifdef BLE_USE_2M_PHY
-    BLEConnection* bleConn = Bluefruit.Connection(connHandleParam);
     if (bleConn) {
         bleConn->requestPHY(BLE_GAP_PHY_2MBPS);
         Serial.println(F("[BLE] Requested 2M PHY upgrade"));
     }
 #endif
 
+    // 251-byte LL PDUs. The MTU exchange is a GATT client procedure: the
+    // phone / SECONDARY starts it and the SoftDevice answers with BLE_ATT_MTU.
+    if (bleConn) {
+        bleConn->requestDataLengthUpdate();
+    }
+
     // Find free connection slot
     BBConnection* conn = g_bleManager->findFreeConnection();
     if (!conn) {
@@ -985,7 +1119,7 @@ void BLEManager::_onPeriphConnect(uint16_t connHandleParam) {
     conn->connectedAt = millis();
     conn->pendingIdentify = true;
     conn->identifyStartTime = millis();
-    conn->rxIndex = 0;
+    conn->rx.clear();
 
     Serial.println(F("[BLE] Waiting for IDENTIFY message (1000ms timeout)..."));
 
@@ -1024,15 +1158,22 @@ void BLEManager::_onCentralConnect(uint16_t connHandle) {
 
     Serial.printf("[BLE] Central connected to PRIMARY: handle=%d\n", connHandle);
 
+    BLEConnection* bleConn = Bluefruit.Connection(connHandle);
+
     // Request 2M PHY for faster BLE transmission (reduces latency)
 #ifdef BLE_USE_2M_PHY
-    BLEConnection* bleConn = Bluefruit.Connection(connHandle);
     if (bleConn) {
         bleConn->requestPHY(BLE_GAP_PHY_2MBPS);
         Serial.println(F("[BLE] Requested 2M PHY upgrade"));
     }
 #endif
 
+    // As GATT client we start the MTU exchange; DLE for 251-byte PDUs
+    if (bleConn) {
+        bleConn->requestMtuExchange(BLE_ATT_MTU);
+        bleConn->requestDataLengthUpdate();
+    }
+
     // Find free connection slot
     BBConnection* conn = g_bleManager->findFreeConnection();
     if (!conn) {
@@ -1046,7 +1187,7 @@ void BLEManager::_onCentralConnect(uint16_t connHandle) {
     conn->type = ConnectionType::PRIMARY;
     conn->isConnected = true;
     conn->connectedAt = millis();
-    conn->rxIndex = 0;
+    conn->rx.clear();
 
     // Discover UART service on PRIMARY
     Serial.println(F("[BLE] Discovering UART service on PRIMARY..."));
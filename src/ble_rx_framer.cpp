@@ -0,0 +1,91 @@
+/**
+ * @file ble_rx_framer.cpp
+ * @brief EOT-delimited frame reassembly - Implementation
+ */
+
+#include "ble_rx_framer.h"
+#include <string.h>
+
+BLERxFramer::BLERxFramer(char* buffer, size_t capacity) :
+    _buffer(buffer),
+    _capacity(capacity),
+    _length(0),
+    _discarding(false),
+    _oversize(0)
+{
+}
+
+void BLERxFramer::clear() {
+    _length = 0;
+    _discarding = false;
+}
+
+void BLERxFramer::reset() {
+    clear();
+    _oversize = 0;
+}
+
+void BLERxFramer::append(const uint8_t* run, size_t runLength) {
+    if (_discarding) {
+        return;
+    }
+
+    // Copy the run minus CRs (line endings some phone apps add before EOT)
+    while (runLength > 0) {
+        const uint8_t* cr = static_cast<const uint8_t*>(memchr(run, '\r', runLength));
+        size_t piece = cr ? static_cast<size_t>(cr - run) : runLength;
+
+        if (_length + piece > _capacity - 1) {
+            // Oversize: drop the whole frame, not just the overflow
+            _discarding = true;
+            _length = 0;
+            _oversize++;
+            return;
+        }
+        memcpy(_buffer + _length, run, piece);
+        _length += piece;
+
+        if (!cr) {
+            return;
+        }
+        run = cr + 1;
+        runLength -= piece + 1;
+    }
+}
+
+bool BLERxFramer::feed(const uint8_t*& data, size_t& len, const char*& frame, size_t& frameLength) {
+    if (_buffer == nullptr || _capacity == 0) {
+        len = 0;
+        return false;
+    }
+
+    while (len > 0) {
+        const uint8_t* end = static_cast<const uint8_t*>(memchr(data, DELIMITER, len));
+        if (!end) {
+            append(data, len);
+            data += len;
+            len = 0;
+            return false;
+        }
+
+        size_t runLength = static_cast<size_t>(end - data);
+        append(data, runLength);
+        data = end + 1;
+        len -= runLength + 1;
+
+        if (_discarding) {
+            _discarding = false;  // Oversize frame ends here
+            continue;
+        }
+        if (_length == 0) {
+            continue;  // Bare delimiter
+        }
+
+        _buffer[_length] = '\0';
+        frame = _buffer;
+        frameLength = _length;
+        _length = 0;
+        return true;
+    }
+    return false;
+}
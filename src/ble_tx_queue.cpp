@@ -0,0 +1,156 @@
+/**
+ * @file ble_tx_queue.cpp
+ * @brief Priority-class BLE TX queue - Implementation
+ * @version 1.0.0
+ */
+
+#include "ble_tx_queue.h"
+#include "platform.h"
+#include <string.h>
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+BLETxQueue::BLETxQueue() :
+    _entries{},
+    _slab{},
+    _rings{}
+{
+    // Carve the entry pool and the slab into per-class rings
+    uint8_t entryIndex = 0;
+    size_t slabOffset = 0;
+    for (uint8_t cls = 0; cls < TX_PRIORITY_COUNT; cls++) {
+        ClassRing& ring = _rings[cls];
+        ring.entries = &_entries[entryIndex];
+        ring.slots = SLOTS[cls];
+        ring.head = 0;
+        ring.tail = 0;
+        ring.count = 0;
+        for (uint8_t i = 0; i < SLOTS[cls]; i++) {
+            BLETxEntry& entry = _entries[entryIndex++];
+            entry.data = &_slab[slabOffset];
+            entry.capacity = SLOT_BYTES[cls];
+            entry.pending = false;
+            entry.length = 0;
+            entry.bytesSent = 0;
+            slabOffset += SLOT_BYTES[cls];
+        }
+    }
+}
+
+// =============================================================================
+// PRODUCER SIDE
+// =============================================================================
+
+BLETxEntry* BLETxQueue::reserve(TxPriority priority, size_t bytes) {
+    uint8_t cls = static_cast<uint8_t>(priority);
+    if (cls >= TX_PRIORITY_COUNT || bytes > SLOT_BYTES[cls]) {
+        return nullptr;
+    }
+    ClassRing& ring = _rings[cls];
+
+    // Capacity check, tail advance and count increment are one unit so a
+    // BLE-task enqueue cannot race a main-loop enqueue or release
+    BLETxEntry* entry = nullptr;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        if (ring.count < ring.slots && !ring.entries[ring.tail].pending) {
+            entry = &ring.entries[ring.tail];
+            ring.tail = static_cast<uint8_t>((ring.tail + 1) % ring.slots);
+            ring.count = static_cast<uint8_t>(ring.count + 1);
+        }
+        PLATFORM_CRITICAL_EXIT();
+    }
+    return entry;
+}
+
+void BLETxQueue::publish(BLETxEntry* entry) {
+    // All field stores must be visible before pending reads true
+    platformMemoryBarrier();
+    entry->pending = true;
+}
+
+// =============================================================================
+// CONSUMER SIDE
+// =============================================================================
+
+BLETxEntry* BLETxQueue::next(const uint16_t* skipHandles, uint8_t skipCount) {
+    // Published heads; a reserved-but-unpublished head blocks only its class
+    BLETxEntry* heads[TX_PRIORITY_COUNT];
+    for (uint8_t cls = 0; cls < TX_PRIORITY_COUNT; cls++) {
+        ClassRing& ring = _rings[cls];
+        BLETxEntry* head = (ring.count > 0) ? &ring.entries[ring.head] : nullptr;
+        heads[cls] = (head != nullptr && head->pending) ? head : nullptr;
+    }
+    // Acquire: pairs with the publish barrier
+    platformMemoryBarrier();
+
+    for (uint8_t cls = 0; cls < TX_PRIORITY_COUNT; cls++) {
+        BLETxEntry* candidate = heads[cls];
+        if (candidate == nullptr) {
+            continue;
+        }
+
+        bool skip = false;
+        for (uint8_t i = 0; i < skipCount; i++) {
+            if (skipHandles[i] == candidate->connHandle) {
+                skip = true;
+                break;
+            }
+        }
+
+        // A partially sent message owns its connection's byte stream
+        for (uint8_t other = 0; other < TX_PRIORITY_COUNT && !skip; other++) {
+            const BLETxEntry* head = heads[other];
+            if (other != cls && head != nullptr && head->connHandle == candidate->connHandle &&
+                head->bytesSent > 0) {
+                skip = true;
+            }
+        }
+
+        if (!skip) {
+            return candidate;
+        }
+    }
+    return nullptr;
+}
+
+void BLETxQueue::release(BLETxEntry* entry) {
+    uint8_t cls;
+    if (!classOf(entry, cls)) {
+        return;
+    }
+    ClassRing& ring = _rings[cls];
+
+    PLATFORM_CRITICAL_ENTER();
+    if (ring.count > 0 && &ring.entries[ring.head] == entry) {
+        entry->pending = false;
+        ring.head = static_cast<uint8_t>((ring.head + 1) % ring.slots);
+        ring.count = static_cast<uint8_t>(ring.count - 1);
+    }
+    PLATFORM_CRITICAL_EXIT();
+}
+
+uint8_t BLETxQueue::count() const {
+    uint8_t total = 0;
+    for (uint8_t cls = 0; cls < TX_PRIORITY_COUNT; cls++) {
+        total = static_cast<uint8_t>(total + _rings[cls].count);
+    }
+    return total;
+}
+
+uint8_t BLETxQueue::count(TxPriority priority) const {
+    uint8_t cls = static_cast<uint8_t>(priority);
+    return (cls < TX_PRIORITY_COUNT) ? _rings[cls].count : 0;
+}
+
+bool BLETxQueue::classOf(const BLETxEntry* entry, uint8_t& cls) const {
+    for (cls = 0; cls < TX_PRIORITY_COUNT; cls++) {
+        const ClassRing& ring = _rings[cls];
+        if (entry >= ring.entries && entry < ring.entries + ring.slots) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file clock_servo.cpp
+ * @brief 2-state Kalman clock servo - Implementation
+ */
+
+#include "clock_servo.h"
+#include <math.h>
+
+// Skew prior before any measurement: the full crystal tolerance
+static constexpr float SKEW_PRIOR_VAR =
+    SYNC_MAX_DRIFT_RATE_US_PER_MS * SYNC_MAX_DRIFT_RATE_US_PER_MS;
+
+ClockServo::ClockServo() {
+    reset();
+}
+
+void ClockServo::reset() {
+    _base = 0;
+    _x0 = 0.0f;
+    _x1 = 0.0f;
+    _p00 = 0.0f;
+    _p01 = 0.0f;
+    _p11 = SKEW_PRIOR_VAR;
+    _lastMs = 0;
+    _minRttUs = UINT32_MAX;
+    _samples = 0;
+    _gateRejects = 0;
+    _seeded = false;
+}
+
+void ClockServo::seed(int64_t offsetUs, float skewUsPerMs, float offsetSigmaUs, uint32_t nowMs) {
+    reset();
+    _base = offsetUs;
+    _x1 = skewUsPerMs;
+    _p00 = offsetSigmaUs * offsetSigmaUs;
+    _lastMs = nowMs;
+    _seeded = true;
+}
+
+void ClockServo::setSkewPrior(float skewUsPerMs, float skewSigmaUsPerMs) {
+    reset();
+    _x1 = skewUsPerMs;
+    _p11 = skewSigmaUsPerMs * skewSigmaUsPerMs;
+}
+
+float ClockServo::offsetSigma() const {
+    return sqrtf(_p00);
+}
+
+float ClockServo::skewSigma() const {
+    return sqrtf(_p11);
+}
+
+// =============================================================================
+// FILTER
+// =============================================================================
+
+void ClockServo::predict(uint32_t nowMs) {
+    float dt = static_cast<float>(nowMs - _lastMs);
+    if (dt <= 0.0f) {
+        return;
+    }
+    // x = F x, P = F P F' + Q with F = [1 dt; 0 1]
+    _x0 += _x1 * dt;
+    _p00 += dt * (2.0f * _p01 + dt * _p11) + SYNC_SERVO_OFFSET_NOISE * dt;
+    _p01 += dt * _p11;
+    _p11 += SYNC_SERVO_SKEW_NOISE * dt;
+    _lastMs = nowMs;
+}
+
+void ClockServo::rebase() {
+    // Keep the float residual small: whole microseconds move into _base
+    int64_t whole = static_cast<int64_t>(_x0);
+    _base += whole;
+    _x0 -= static_cast<float>(whole);
+}
+
+bool ClockServo::update(int64_t offsetUs, uint32_t rttUs, uint32_t nowMs) {
+    if (rttUs > SYNC_RTT_QUALITY_THRESHOLD_US) {
+        return false;
+    }
+
+    // Decaying minimum RTT: the reference for "no queuing on either leg"
+    if (rttUs < _minRttUs) {
+        _minRttUs = rttUs;
+    } else {
+        _minRttUs += SYNC_MIN_RTT_DECAY_US;
+    }
+
+    // Queuing skews the PTP midpoint by up to half the excess RTT
+    float excess = static_cast<float>(rttUs > _minRttUs ? rttUs - _minRttUs : 0) * 0.5f;
+    float r = SYNC_SERVO_MEAS_FLOOR_US * SYNC_SERVO_MEAS_FLOOR_US + excess * excess;
+
+    if (!_seeded) {
+        // Skew and its variance keep the reset() prior or setSkewPrior()
+        _base = offsetUs;
+        _x0 = 0.0f;
+        _p00 = r;
+        _p01 = 0.0f;
+        _lastMs = nowMs;
+        _samples = 1;
+        _seeded = true;
+        return true;
+    }
+
+    predict(nowMs);
+
+    float y = static_cast<float>(offsetUs - _base) - _x0;
+    float s = _p00 + r;
+
+    // Innovation gate (only once converged - early samples shape the prior)
+    if (_samples >= SYNC_MIN_VALID_SAMPLES &&
+        y * y > SYNC_SERVO_GATE_SIGMA * SYNC_SERVO_GATE_SIGMA * s) {
+        if (_gateRejects < SYNC_INNOVATION_REJECT_LIMIT) {
+            _gateRejects++;
+            return false;
+        }
+        // Persistent step: re-anchor the offset, keep the learned skew
+        _gateRejects = 0;
+        _base = offsetUs;
+        _x0 = 0.0f;
+        _p00 = r;
+        _p01 = 0.0f;
+        if (_samples < 0xFFFF) _samples++;
+        return true;
+    }
+    _gateRejects = 0;
+
+    float k0 = _p00 / s;
+    float k1 = _p01 / s;
+    _x0 += k0 * y;
+    _x1 += k1 * y;
+
+    float p00 = _p00;
+    float p01 = _p01;
+    _p00 = (1.0f - k0) * p00;
+    _p01 = (1.0f - k0) * p01;
+    _p11 -= k1 * p01;
+
+    if (_x1 > SYNC_MAX_DRIFT_RATE_US_PER_MS) _x1 = SYNC_MAX_DRIFT_RATE_US_PER_MS;
+    if (_x1 < -SYNC_MAX_DRIFT_RATE_US_PER_MS) _x1 = -SYNC_MAX_DRIFT_RATE_US_PER_MS;
+
+    rebase();
+    if (_samples < 0xFFFF) _samples++;
+    return true;
+}
+
+int64_t ClockServo::offsetAt(uint32_t nowMs) const {
+    if (!_seeded) {
+        return 0;
+    }
+    uint32_t elapsed = nowMs - _lastMs;
+    if (elapsed > SYNC_MAX_CORRECTION_ELAPSED_MS) {
+        elapsed = SYNC_MAX_CORRECTION_ELAPSED_MS;
+    }
+    float skew = _x1;
+    if (skew > SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS) skew = SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS;
+    if (skew < -SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS) skew = -SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS;
+    return _base + static_cast<int64_t>(_x0 + skew * static_cast<float>(elapsed));
+}
@@ -0,0 +1,333 @@
+/**
+ * @file command_table.cpp
+ * @brief BLE message classification and phone-command lookup - Implementation
+ */
+
+#include "command_table.h"
+#include <string.h>
+
+static constexpr char EOT = '\x04';
+
+static constexpr char toUpperAscii(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// =============================================================================
+// INTERNAL PREFIX TABLE
+// =============================================================================
+
+namespace {
+
+struct PrefixEntry {
+    std::string_view prefix;
+    InternalMessage kind;
+};
+
+constexpr PrefixEntry INTERNAL_PREFIXES[] = {
+    {"BUZZ",             InternalMessage::BUZZ},
+    {"PING",             InternalMessage::PING},
+    {"PONG",             InternalMessage::PONG},
+    {"PARAM_UPDATE",     InternalMessage::PARAM_UPDATE},
+    {"SEED",             InternalMessage::SEED},
+    {"SEED_ACK",         InternalMessage::SEED_ACK},
+    {"GET_BATTERY",      InternalMessage::GET_BATTERY},
+    {"BATRESPONSE",      InternalMessage::BATRESPONSE},
+    {"ACK_PARAM_UPDATE", InternalMessage::ACK_PARAM_UPDATE},
+    {"SYNC_",            InternalMessage::SYNC},
+    {"FIRST_SYNC",       InternalMessage::FIRST_SYNC},
+    {"ACK_SYNC",         InternalMessage::ACK_SYNC},
+    {"START_SESSION",    InternalMessage::START_SESSION},
+    {"PAUSE_SESSION",    InternalMessage::PAUSE_SESSION},
+    {"RESUME_SESSION",   InternalMessage::RESUME_SESSION},
+    {"STOP_SESSION",     InternalMessage::STOP_SESSION},
+    {"IDENTIFY:",        InternalMessage::IDENTIFY},
+    {"LED_OFF_SYNC",     InternalMessage::LED_OFF_SYNC},
+    {"DEBUG_FLASH",      InternalMessage::DEBUG_FLASH},
+    {"DEBUG_SYNC",       InternalMessage::DEBUG_SYNC},
+    {"MC:",              InternalMessage::MC},
+    {"MC_ACK:",          InternalMessage::MC_ACK},
+    {"MC_VER:",          InternalMessage::MC_VER},
+    {"CALIB_BUZZ:",      InternalMessage::CALIB_BUZZ},
+    {"CALIB_STOP",       InternalMessage::CALIB_STOP},
+    {"MC_RESYNC:",       InternalMessage::MC_RESYNC},
+};
+
+constexpr size_t PREFIX_COUNT = sizeof(INTERNAL_PREFIXES) / sizeof(INTERNAL_PREFIXES[0]);
+static_assert(PREFIX_COUNT <= 32, "prefix buckets are 32-bit masks");
+
+// INTERNAL_PREFIXES[i] describes InternalMessage(i + 1), so internalPrefix() is an index
+constexpr bool prefixesInEnumOrder() {
+    for (size_t i = 0; i < PREFIX_COUNT; i++) {
+        if (static_cast<size_t>(INTERNAL_PREFIXES[i].kind) != i + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(prefixesInEnumOrder(), "INTERNAL_PREFIXES must follow InternalMessage order");
+
+// Bit i of buckets[c - 'A'] = INTERNAL_PREFIXES[i] starts with c
+struct PrefixBuckets {
+    uint32_t mask[26];
+};
+
+constexpr bool prefixesStartUppercase() {
+    for (const PrefixEntry& entry : INTERNAL_PREFIXES) {
+        if (entry.prefix.empty() || entry.prefix[0] < 'A' || entry.prefix[0] > 'Z') {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(prefixesStartUppercase(), "internal prefixes must start with A-Z");
+
+constexpr PrefixBuckets buildPrefixBuckets() {
+    PrefixBuckets buckets{};
+    for (size_t i = 0; i < PREFIX_COUNT; i++) {
+        buckets.mask[INTERNAL_PREFIXES[i].prefix[0] - 'A'] |= (1u << i);
+    }
+    return buckets;
+}
+
+constexpr PrefixBuckets PREFIX_BUCKETS = buildPrefixBuckets();
+
+// =============================================================================
+// COMMAND HASH TABLE
+// =============================================================================
+
+struct CommandEntry {
+    std::string_view name;
+    MenuCommand command;
+};
+
+constexpr CommandEntry MENU_COMMANDS[] = {
+    {"INFO",            MenuCommand::INFO},
+    {"BATTERY",         MenuCommand::BATTERY},
+    {"PING",            MenuCommand::PING},
+    {"PROFILE_LIST",    MenuCommand::PROFILE_LIST},
+    {"PROFILE_LOAD",    MenuCommand::PROFILE_LOAD},
+    {"PROFILE_GET",     MenuCommand::PROFILE_GET},
+    {"PROFILE_CUSTOM",  MenuCommand::PROFILE_CUSTOM},
+    {"SESSION_START",   MenuCommand::SESSION_START},
+    {"SESSION_PAUSE",   MenuCommand::SESSION_PAUSE},
+    {"SESSION_RESUME",  MenuCommand::SESSION_RESUME},
+    {"SESSION_STOP",    MenuCommand::SESSION_STOP},
+    {"SESSION_STATUS",  MenuCommand::SESSION_STATUS},
+    {"PARAM_SET",       MenuCommand::PARAM_SET},
+    {"CALIBRATE_START", MenuCommand::CALIBRATE_START},
+    {"CALIBRATE_BUZZ",  MenuCommand::CALIBRATE_BUZZ},
+    {"CALIBRATE_STOP",  MenuCommand::CALIBRATE_STOP},
+    {"HELP",            MenuCommand::HELP},
+    {"RESTART",         MenuCommand::RESTART},
+    {"THERAPY_LED_OFF", MenuCommand::THERAPY_LED_OFF},
+    {"DEBUG",           MenuCommand::DEBUG},
+    {"LATENCY_STREAM",  MenuCommand::LATENCY_STREAM},
+    {"JOURNAL_GET",     MenuCommand::JOURNAL_GET},
+    {"PERF",            MenuCommand::PERF},
+};
+
+constexpr size_t COMMAND_COUNT = sizeof(MENU_COMMANDS) / sizeof(MENU_COMMANDS[0]);
+
+// MENU_COMMANDS[i] is MenuCommand(i + 1), so menuCommandName() is an index
+constexpr bool commandsInEnumOrder() {
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        if (static_cast<size_t>(MENU_COMMANDS[i].command) != i + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(commandsInEnumOrder(), "MENU_COMMANDS must follow MenuCommand order");
+constexpr size_t COMMAND_SLOTS = 64;
+constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+// Case-insensitive; multipliers chosen so the command set above has no collisions
+constexpr size_t commandHash(std::string_view name) {
+    return (name.size() + 4u * static_cast<uint8_t>(toUpperAscii(name.front())) +
+            7u * static_cast<uint8_t>(toUpperAscii(name.back()))) & (COMMAND_SLOTS - 1);
+}
+
+constexpr bool commandHashIsPerfect() {
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        for (size_t j = i + 1; j < COMMAND_COUNT; j++) {
+            if (commandHash(MENU_COMMANDS[i].name) == commandHash(MENU_COMMANDS[j].name)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+static_assert(commandHashIsPerfect(), "menu command hash collides - adjust commandHash()");
+
+struct CommandSlots {
+    uint8_t index[COMMAND_SLOTS];
+};
+
+constexpr CommandSlots buildCommandSlots() {
+    CommandSlots slots{};
+    for (size_t i = 0; i < COMMAND_SLOTS; i++) {
+        slots.index[i] = EMPTY_SLOT;
+    }
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        slots.index[commandHash(MENU_COMMANDS[i].name)] = static_cast<uint8_t>(i);
+    }
+    return slots;
+}
+
+constexpr CommandSlots COMMAND_SLOT_TABLE = buildCommandSlots();
+
+} // namespace
+
+// =============================================================================
+// CLASSIFICATION
+// =============================================================================
+
+InternalMessage classifyMessage(std::string_view message) {
+    if (message.empty() || message[0] < 'A' || message[0] > 'Z') {
+        return InternalMessage::NONE;
+    }
+
+    InternalMessage best = InternalMessage::NONE;
+    size_t bestLength = 0;
+    uint32_t mask = PREFIX_BUCKETS.mask[message[0] - 'A'];
+    while (mask != 0) {
+        size_t i = static_cast<size_t>(__builtin_ctz(mask));
+        mask &= mask - 1;
+        const PrefixEntry& entry = INTERNAL_PREFIXES[i];
+        if (entry.prefix.size() > bestLength &&
+            message.substr(0, entry.prefix.size()) == entry.prefix) {
+            best = entry.kind;
+            bestLength = entry.prefix.size();
+        }
+    }
+    return best;
+}
+
+std::string_view internalPrefix(InternalMessage kind) {
+    size_t index = static_cast<size_t>(kind);
+    if (index == 0 || index > PREFIX_COUNT) {
+        return {};
+    }
+    return INTERNAL_PREFIXES[index - 1].prefix;
+}
+
+MenuCommand lookupMenuCommand(std::string_view name) {
+    if (name.empty()) {
+        return MenuCommand::UNKNOWN;
+    }
+    uint8_t index = COMMAND_SLOT_TABLE.index[commandHash(name)];
+    if (index == EMPTY_SLOT || !argEqualsIgnoreCase(name, MENU_COMMANDS[index].name)) {
+        return MenuCommand::UNKNOWN;
+    }
+    return MENU_COMMANDS[index].command;
+}
+
+std::string_view menuCommandName(MenuCommand command) {
+    size_t index = static_cast<size_t>(command);
+    if (index == 0 || index > COMMAND_COUNT) {
+        return {};
+    }
+    return MENU_COMMANDS[index - 1].name;
+}
+
+// =============================================================================
+// TOKENIZING
+// =============================================================================
+
+bool splitCommand(std::string_view message, CommandArgs& args) {
+    args.name = {};
+    args.count = 0;
+
+    // Strip from the first line ending / EOT
+    size_t end = 0;
+    while (end < message.size() && message[end] != '\n' && message[end] != '\r' && message[end] != EOT) {
+        end++;
+    }
+    message = message.substr(0, end);
+
+    // Trim leading whitespace
+    size_t pos = 0;
+    while (pos < message.size() && message[pos] == ' ') {
+        pos++;
+    }
+
+    bool haveName = false;
+    while (pos < message.size()) {
+        size_t colon = message.find(':', pos);
+        size_t tokenEnd = (colon == std::string_view::npos) ? message.size() : colon;
+        if (tokenEnd > pos) {
+            std::string_view token = message.substr(pos, tokenEnd - pos);
+            if (!haveName) {
+                args.name = token;
+                haveName = true;
+            } else if (args.count < MAX_COMMAND_PARAMS) {
+                args.params[args.count++] = token;
+            } else {
+                break;
+            }
+        }
+        pos = tokenEnd + 1;
+    }
+    return haveName;
+}
+
+// =============================================================================
+// PARAMETER HELPERS
+// =============================================================================
+
+int32_t argToInt(std::string_view arg) {
+    size_t i = 0;
+    while (i < arg.size() && (arg[i] == ' ' || arg[i] == '\t')) {
+        i++;
+    }
+    bool negative = false;
+    if (i < arg.size() && (arg[i] == '-' || arg[i] == '+')) {
+        negative = (arg[i] == '-');
+        i++;
+    }
+    int64_t value = 0;
+    while (i < arg.size() && arg[i] >= '0' && arg[i] <= '9') {
+        if (value < INT32_MAX) {
+            value = value * 10 + (arg[i] - '0');
+        }
+        i++;
+    }
+    if (value > INT32_MAX) {
+        value = INT32_MAX;
+    }
+    return static_cast<int32_t>(negative ? -value : value);
+}
+
+bool argEqualsIgnoreCase(std::string_view arg, std::string_view expected) {
+    if (arg.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < arg.size(); i++) {
+        if (toUpperAscii(arg[i]) != toUpperAscii(expected[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool argToBool(std::string_view arg, bool& value) {
+    if (argEqualsIgnoreCase(arg, "true") || arg == "1") {
+        value = true;
+        return true;
+    }
+    if (argEqualsIgnoreCase(arg, "false") || arg == "0") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+size_t argCopy(std::string_view arg, char* out, size_t size) {
+    if (out == nullptr || size == 0) {
+        return 0;
+    }
+    size_t length = (arg.size() < size - 1) ? arg.size() : size - 1;
+    memcpy(out, arg.data(), length);
+    out[length] = '\0';
+    return length;
+}
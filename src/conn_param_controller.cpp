@@ -0,0 +1,84 @@
+/**
+ * @file conn_param_controller.cpp
+ * @brief Connection-parameter policy - Implementation
+ */
+
+#include "conn_param_controller.h"
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+ConnParamController::ConnParamController() :
+    _sessionNeedsTight(false),
+    _syncWarmup(false),
+    _linkUpPending(false),
+    _charging(false),
+    _applied(ConnParamProfile::TIGHT),  // Links connect on the tight parameters
+    _tightSinceMs(0)
+{
+}
+
+// =============================================================================
+// INPUTS
+// =============================================================================
+
+bool ConnParamController::stateNeedsTightLink(TherapyState state) {
+    switch (state) {
+        case TherapyState::CONNECTING:   // IDENTIFY + MC_VER handshake
+        case TherapyState::RUNNING:
+        case TherapyState::STOPPING:     // STOP_SESSION still in flight
+        case TherapyState::LOW_BATTERY:  // Session continues
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ConnParamController::onStateChange(TherapyState toState) {
+    if (toState == TherapyState::PHONE_DISCONNECTED) {
+        return;
+    }
+    _sessionNeedsTight = stateNeedsTightLink(toState);
+}
+
+ConnParamProfile ConnParamController::desired() const {
+    if (_sessionNeedsTight) {
+        return ConnParamProfile::TIGHT;
+    }
+    // On the charger nobody is waiting for sync: skip the warm-up cost
+    if (_charging) {
+        return ConnParamProfile::RELAXED;
+    }
+    return _syncWarmup ? ConnParamProfile::TIGHT : ConnParamProfile::RELAXED;
+}
+
+// =============================================================================
+// UPDATE
+// =============================================================================
+
+bool ConnParamController::update(uint32_t nowMs, ConnParamProfile& profile) {
+    if (_linkUpPending) {
+        _linkUpPending = false;
+        _applied = ConnParamProfile::TIGHT;
+        _tightSinceMs = nowMs;
+    }
+
+    if (desired() == ConnParamProfile::TIGHT) {
+        _tightSinceMs = nowMs;
+        if (_applied == ConnParamProfile::TIGHT) {
+            return false;
+        }
+        _applied = ConnParamProfile::TIGHT;
+        profile = _applied;
+        return true;
+    }
+
+    if (_applied == ConnParamProfile::RELAXED ||
+        nowMs - _tightSinceMs < BLE_CONN_PARAM_RELAX_DELAY_MS) {
+        return false;
+    }
+    _applied = ConnParamProfile::RELAXED;
+    profile = _applied;
+    return true;
+}
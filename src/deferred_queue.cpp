@@ -9,97 +9,208 @@
 // Global instance
 DeferredQueue deferredQueue;
 
+static_assert(DEFERRED_QUEUE_SLOTS >= 2, "DEFERRED_QUEUE_SLOTS must hold at least one item");
+
 DeferredQueue::DeferredQueue()
-    : _head(0)
-    , _tail(0)
-    , _executor(nullptr)
+    : _executor(nullptr)
+    , _wake(nullptr)
+    , _processed(0)
+    , _maxLatencyUs(0)
+    , _motorWaits(0)
 {
-    for (uint8_t i = 0; i < MAX_WORK; i++) {
-        _queue[i].type = DeferredWorkType::NONE;
-        _queue[i].param1 = 0;
-        _queue[i].param2 = 0;
-        _queue[i].param3 = 0;
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        Ring& ring = _rings[p];
+        ring.head = 0;
+        ring.tail = 0;
+        for (uint8_t i = 0; i < MAX_WORK; i++) {
+            ring.items[i].type = DeferredWorkType::NONE;
+            ring.items[i].param1 = 0;
+            ring.items[i].param2 = 0;
+            ring.items[i].param3 = 0;
+            ring.items[i].enqueuedUs = 0;
+        }
+        _overflows[p] = 0;
     }
 }
 
+DeferredPriority DeferredQueue::priorityOf(DeferredWorkType type) {
+    switch (type) {
+        case DeferredWorkType::HAPTIC_PULSE:
+        case DeferredWorkType::HAPTIC_DOUBLE_PULSE:
+        case DeferredWorkType::HAPTIC_DEACTIVATE:
+            return DeferredPriority::FEEDBACK;
+        default:
+            return DeferredPriority::HOUSEKEEPING;
+    }
+}
+
+uint32_t DeferredQueue::costUs(DeferredWorkType type) {
+    return (type == DeferredWorkType::HAPTIC_HEAL) ? DEFERRED_HEAL_COST_US : DEFERRED_WORK_COST_US;
+}
+
 bool DeferredQueue::enqueue(DeferredWorkType type, uint8_t param1, uint8_t param2, uint32_t param3) {
+    uint8_t priority = static_cast<uint8_t>(priorityOf(type));
+    Ring& ring = _rings[priority];
+
     // Calculate next head position
-    uint8_t nextHead = static_cast<uint8_t>((_head + 1) % MAX_WORK);
+    uint8_t head = ring.head;
+    uint8_t nextHead = static_cast<uint8_t>((head + 1) % MAX_WORK);
 
-    // SP-H4 fix: Memory barrier before reading _tail to ensure we see consumer's updates
+    // SP-H4 fix: Memory barrier before reading tail to ensure we see consumer's updates
     platformMemoryBarrier();
 
     // Check if queue is full
-    if (nextHead == _tail) {
+    if (nextHead == ring.tail) {
+        _overflows[priority] = _overflows[priority] + 1;
         return false;  // Queue full
     }
 
     // Store work item
-    _queue[_head].type = type;
-    _queue[_head].param1 = param1;
-    _queue[_head].param2 = param2;
-    _queue[_head].param3 = param3;
+    ring.items[head].type = type;
+    ring.items[head].param1 = param1;
+    ring.items[head].param2 = param2;
+    ring.items[head].param3 = param3;
+    ring.items[head].enqueuedUs = micros();
 
     // Memory barrier to ensure stores complete before head update
     platformMemoryBarrier();
 
     // Advance head (makes item visible to consumer)
-    _head = nextHead;
+    ring.head = nextHead;
 
+    if (_wake) {
+        _wake();
+    }
     return true;
 }
 
-bool DeferredQueue::processOne() {
-    // SP-H4 fix: Memory barrier before reading _head to ensure we see producer's updates
+DeferredQueue::Ring* DeferredQueue::nextRing() {
+    // SP-H4 fix: Memory barrier before reading head to ensure we see producer's updates
     platformMemoryBarrier();
 
-    // Check if queue is empty
-    if (_tail == _head) {
-        return false;  // Queue empty
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        if (_rings[p].tail != _rings[p].head) {
+            return &_rings[p];
+        }
     }
+    return nullptr;
+}
+
+const DeferredQueue::Ring* DeferredQueue::nextRing() const {
+    return const_cast<DeferredQueue*>(this)->nextRing();
+}
 
+DeferredWorkType DeferredQueue::peekType(const Ring& ring) {
+    // Read the item only after seeing the head that published it
+    platformMemoryBarrier();
+    return ring.items[ring.tail].type;
+}
+
+void DeferredQueue::runOne(Ring& ring) {
     // SP-H4 fix: Another barrier to ensure we read data AFTER producer finished writing
     platformMemoryBarrier();
 
     // Read work item
-    DeferredWorkType type = _queue[_tail].type;
-    uint8_t p1 = _queue[_tail].param1;
-    uint8_t p2 = _queue[_tail].param2;
-    uint32_t p3 = _queue[_tail].param3;
+    uint8_t tail = ring.tail;
+    DeferredWorkType type = ring.items[tail].type;
+    uint8_t p1 = ring.items[tail].param1;
+    uint8_t p2 = ring.items[tail].param2;
+    uint32_t p3 = ring.items[tail].param3;
+    uint32_t enqueuedUs = ring.items[tail].enqueuedUs;
 
     // Memory barrier before advancing tail
     platformMemoryBarrier();
 
     // Advance tail (frees slot)
-    _tail = static_cast<uint8_t>((_tail + 1) % MAX_WORK);
+    ring.tail = static_cast<uint8_t>((tail + 1) % MAX_WORK);
+
+    uint32_t latencyUs = micros() - enqueuedUs;
+    if (latencyUs > _maxLatencyUs) {
+        _maxLatencyUs = latencyUs;
+    }
+    _processed++;
 
     // Execute work through callback
     if (_executor && type != DeferredWorkType::NONE) {
         _executor(type, p1, p2, p3);
     }
+}
 
+bool DeferredQueue::processOne() {
+    Ring* ring = nextRing();
+    if (!ring) {
+        return false;  // Queue empty
+    }
+    runOne(*ring);
     return true;
 }
 
+uint8_t DeferredQueue::processUntil(uint64_t nowUs, uint64_t deadlineUs) {
+    uint8_t count = 0;
+    Ring* ring;
+    while ((ring = nextRing()) != nullptr) {
+        uint64_t finishUs = nowUs + costUs(peekType(*ring));
+        if (finishUs > deadlineUs) {
+            _motorWaits++;
+            break;
+        }
+        runOne(*ring);
+        nowUs = finishUs;
+        count++;
+    }
+    return count;
+}
+
+bool DeferredQueue::nextFits(uint64_t nowUs, uint64_t deadlineUs) const {
+    const Ring* ring = nextRing();
+    return ring && nowUs + costUs(peekType(*ring)) <= deadlineUs;
+}
+
 bool DeferredQueue::hasPending() const {
-    return _tail != _head;
+    return nextRing() != nullptr;
 }
 
 uint8_t DeferredQueue::getPendingCount() const {
-    uint8_t head = _head;
-    uint8_t tail = _tail;
-
-    if (head >= tail) {
-        return head - tail;
-    } else {
-        return static_cast<uint8_t>(MAX_WORK - tail + head);
+    uint8_t total = 0;
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        uint8_t head = _rings[p].head;
+        uint8_t tail = _rings[p].tail;
+        total += (head >= tail) ? static_cast<uint8_t>(head - tail)
+                                : static_cast<uint8_t>(MAX_WORK - tail + head);
     }
+    return total;
 }
 
 void DeferredQueue::clear() {
-    _tail = _head;
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        _rings[p].tail = _rings[p].head;
+    }
+}
+
+DeferredQueueStats DeferredQueue::getStats() const {
+    DeferredQueueStats stats = {};
+    stats.processed = _processed;
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        stats.overflows[p] = _overflows[p];
+    }
+    stats.maxLatencyUs = _maxLatencyUs;
+    stats.motorWaits = _motorWaits;
+    return stats;
+}
+
+void DeferredQueue::resetStats() {
+    _processed = 0;
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        _overflows[p] = 0;
+    }
+    _maxLatencyUs = 0;
+    _motorWaits = 0;
 }
 
 void DeferredQueue::setExecutor(WorkExecutor executor) {
     _executor = executor;
 }
+
+void DeferredQueue::setWakeCallback(WakeCallback callback) {
+    _wake = callback;
+}
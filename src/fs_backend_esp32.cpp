@@ -37,6 +37,25 @@ bool writeFile(const char* path, const uint8_t* buf, size_t len) {
     return written == len;
 }
 
+bool appendFile(const char* path, const uint8_t* buf, size_t len) {
+    fs::File file = LittleFS.open(path, "a");  // "a" creates if missing
+    if (!file) return false;
+    size_t written = file.write(buf, len);
+    file.close();
+    return written == len;
+}
+
+bool readAt(const char* path, size_t offset, uint8_t* buf, size_t cap, size_t& outLen) {
+    fs::File file = LittleFS.open(path, "r");
+    if (!file) return false;
+    outLen = 0;
+    if (offset < file.size() && file.seek(offset)) {
+        outLen = file.read(buf, cap);
+    }
+    file.close();
+    return true;
+}
+
 bool removeFile(const char* path) {
     return LittleFS.remove(path);
 }
@@ -41,6 +41,23 @@ bool writeFile(const char* path, const uint8_t* buf, size_t len) {
     return true;
 }
 
+bool appendFile(const char* path, const uint8_t* buf, size_t len) {
+    files()[path].insert(files()[path].end(), buf, buf + len);
+    return true;
+}
+
+bool readAt(const char* path, size_t offset, uint8_t* buf, size_t cap, size_t& outLen) {
+    auto it = files().find(path);
+    if (it == files().end()) return false;
+    size_t size = it->second.size();
+    size_t avail = offset < size ? size - offset : 0;
+    outLen = avail < cap ? avail : cap;
+    if (outLen > 0) {
+        memcpy(buf, it->second.data() + offset, outLen);
+    }
+    return true;
+}
+
 bool removeFile(const char* path) {
     return files().erase(path) != 0;
 }
@@ -39,6 +39,27 @@ bool writeFile(const char* path, const uint8_t* buf, size_t len) {
     return written == len;
 }
 
+bool appendFile(const char* path, const uint8_t* buf, size_t len) {
+    File file(InternalFS);
+    // FILE_O_WRITE creates a missing file and positions at end-of-file
+    if (!file.open(path, FILE_O_WRITE)) return false;
+    size_t written = file.write(buf, len);
+    file.flush();
+    file.close();
+    return written == len;
+}
+
+bool readAt(const char* path, size_t offset, uint8_t* buf, size_t cap, size_t& outLen) {
+    File file(InternalFS);
+    if (!file.open(path, FILE_O_READ)) return false;
+    outLen = 0;
+    if (offset < file.size() && file.seek(offset)) {
+        outLen = file.read(buf, cap);
+    }
+    file.close();
+    return true;
+}
+
 bool removeFile(const char* path) {
     return InternalFS.remove(path);
 }
@@ -0,0 +1,149 @@
+/**
+ * @file haptic_i2c_engine_esp32.cpp
+ * @brief Asynchronous haptic I2C command engine - Implementation
+ * @version 1.0.0
+ * @platform Seeed XIAO ESP32-S3 (PentaBuzzer)
+ */
+
+#include "config.h"
+
+#if HAPTIC_ASYNC_I2C_ENABLED
+
+#include "haptic_i2c_engine.h"
+#include "hardware.h"
+#include "sync_protocol.h"  // getMicros()
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+HapticI2CEngine hapticI2CEngine;
+
+// =============================================================================
+// CONSTRUCTOR / INIT
+// =============================================================================
+
+HapticI2CEngine::HapticI2CEngine() :
+    _ring{},
+    _head(0),
+    _tail(0),
+    _haptic(nullptr),
+    _onComplete(nullptr),
+    _worker(nullptr)
+{
+}
+
+bool HapticI2CEngine::begin(HapticController* haptic, CompletionCallback onComplete) {
+    if (_worker != nullptr) {
+        return true;
+    }
+    if (haptic == nullptr) {
+        return false;
+    }
+
+    _haptic = haptic;
+    _onComplete = onComplete;
+    _head = 0;
+    _tail = 0;
+
+    // Same core and priority as the motor task: a submitted command runs as
+    // soon as the motor task blocks again (ESP-IDF stack depth is in bytes)
+    BaseType_t created = xTaskCreatePinnedToCore(workerTask, "HapticI2C", HAPTIC_I2C_TASK_STACK, this,
+                                                 MOTOR_TASK_PRIORITY, &_worker,
+                                                 HAPTIC_I2C_TASK_CORE);
+    if (created != pdPASS) {
+        _worker = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// PRODUCER (MOTOR TASK ONLY)
+// =============================================================================
+
+bool HapticI2CEngine::submit(const HapticI2CCommand& cmd) {
+    if (_worker == nullptr) {
+        return false;
+    }
+
+    // Memory barrier before reading consumer index (tail)
+    platformMemoryBarrier();
+
+    uint8_t currentHead = _head;
+    uint8_t nextHead = static_cast<uint8_t>((currentHead + 1) & (RING_SIZE - 1));
+    if (nextHead == _tail) {
+        return false;  // Ring full
+    }
+
+    _ring[currentHead] = cmd;
+
+    // Publish data before advancing head
+    platformMemoryBarrier();
+    _head = nextHead;
+
+    xTaskNotifyGive(_worker);
+    return true;
+}
+
+uint8_t HapticI2CEngine::pendingCount() const {
+    platformMemoryBarrier();
+    return static_cast<uint8_t>((_head - _tail) & (RING_SIZE - 1));
+}
+
+// =============================================================================
+// CONSUMER (WORKER TASK ONLY)
+// =============================================================================
+
+void HapticI2CEngine::workerTask(void* param) {
+    HapticI2CEngine* engine = static_cast<HapticI2CEngine*>(param);
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        engine->drain();
+    }
+}
+
+void HapticI2CEngine::drain() {
+    for (;;) {
+        // Memory barrier before reading producer index (head)
+        platformMemoryBarrier();
+
+        uint8_t currentTail = _tail;
+        if (currentTail == _head) {
+            return;
+        }
+
+        HapticI2CCommand cmd = _ring[currentTail];
+
+        // Release the slot before the (slow) bus transaction so the producer
+        // never sees a full ring because of an in-flight command
+        platformMemoryBarrier();
+        _tail = static_cast<uint8_t>((currentTail + 1) & (RING_SIZE - 1));
+
+        Result result = execute(cmd);
+        if (cmd.notify && _onComplete != nullptr) {
+            _onComplete(cmd, result, getMicros());
+        }
+    }
+}
+
+Result HapticI2CEngine::execute(const HapticI2CCommand& cmd) {
+    switch (cmd.type) {
+        case HapticI2CCommandType::SELECT_CHANNEL:
+            // Exclusive select (one mux write, free if already open)
+            return _haptic->selectChannelPersistent(cmd.finger) ? Result::OK : Result::ERROR_BUSY;
+
+        case HapticI2CCommandType::WRITE_FREQUENCY:
+            return _haptic->setFrequencyDirect(cmd.finger, cmd.frequencyHz);
+
+        case HapticI2CCommandType::WRITE_RTP:
+            return _haptic->activatePreSelected(cmd.finger, cmd.amplitude);
+
+        case HapticI2CCommandType::CLOSE_CHANNELS:
+            _haptic->closeAllChannels();
+            return Result::OK;
+    }
+    return Result::ERROR_INVALID_PARAM;
+}
+
+#endif // HAPTIC_ASYNC_I2C_ENABLED
@@ -85,7 +85,8 @@ bool HapticController::begin() {
         Serial.println(F("[WARN] Failed to create I2C mutex - proceeding without thread safety"));
     }
 
-    // Initialize I2C at 400kHz
+    // Initialize I2C at 400kHz (raised by negotiateBusSpeed() once every
+    // channel is configured)
 #if defined(BOARD_PENTABUZZER_ESP32S3)
     Wire.begin(SDA_PIN_OVERRIDE, SCL_PIN_OVERRIDE);
 #else
@@ -95,7 +96,8 @@ bool HapticController::begin() {
 
     // Initialize TCA9548A multiplexer
     _tca.begin(Wire);
-    _tca.closeAll();
+    _muxValid = false;
+    closeChannels();
 
     Serial.printf("[INFO] TCA9548A multiplexer initialized at 0x%02X\n", TCA9548A_ADDRESS);
 
@@ -112,6 +114,10 @@ bool HapticController::begin() {
 
     _initialized = (successCount > 0);
 
+    if (_initialized) {
+        negotiateBusSpeed();
+    }
+
     if (_initialized) {
         Serial.printf("[INFO] Haptic controller ready: %d/%d fingers enabled\n",
                       successCount, MAX_ACTUATORS);
@@ -150,12 +156,10 @@ bool HapticController::initializeFinger(uint8_t finger) {
         // longest PCB trace and needs extra settling time)
         delay(finger == 4 ? I2C_INIT_DELAY_CH4_MS : I2C_INIT_DELAY_MS);
 
-        // Configure for LRA + RTP mode
-        configureDRV2605(_drv[finger]);
-
-        // SAFETY: Immediately stop motor after init - DRV2605 retains RTP value
-        // across MCU resets, so motor may be buzzing from pre-power-off state
-        _drv[finger].setRealtimeValue(0);
+        // Configure for LRA + RTP mode. SAFETY: this also zeroes RTP -
+        // DRV2605 retains the RTP value across MCU resets, so the motor may
+        // be buzzing from the pre-power-off state
+        configureDRV2605(finger);
 
         closeChannels();
 
@@ -171,7 +175,13 @@ bool HapticController::initializeFinger(uint8_t finger) {
     return false;
 }
 
-void HapticController::configureDRV2605(Adafruit_DRV2605& drv) {
+void HapticController::configureDRV2605(uint8_t finger) {
+    Adafruit_DRV2605& drv = _drv[finger];
+
+    // Called at init and after every reset: nothing previously written can
+    // be assumed, so every shadowed write below reaches the chip
+    _shadow[finger].invalidate();
+
     // 0. Read register 0x00 in attempt to un-brick corrupted boards
     drv.readRegister8(DRV2605_REG_STATUS);
 
@@ -180,8 +190,8 @@ void HapticController::configureDRV2605(Adafruit_DRV2605& drv) {
 
     // 2. Enable open-loop mode (v1 requirement for proper LRA operation)
     // Register 0x1D (CONTROL3): Set bits 5 (N_PWM_ANALOG) and 0 (LRA_OPEN_LOOP)
-    uint8_t control3 = drv.readRegister8(0x1D);
-    drv.writeRegister8(0x1D, control3 | 0x21);
+    uint8_t control3 = drv.readRegister8(DRV2605_REG_CONTROL3);
+    writeShadowed(finger, DRV2605Shadow::CONTROL3, control3 | 0x21);
 
     // 3. Set peak voltage to 2.50V (v1 default: ACTUATOR_VOLTAGE = 2.50)
     // Register 0x17 (OD_CLAMP): voltage = value * 0.02122V
@@ -194,10 +204,36 @@ void HapticController::configureDRV2605(Adafruit_DRV2605& drv) {
     drv.writeRegister8(0x20, 40);
 
     // 5. Set Real-Time Playback (RTP) mode
-    drv.setMode(DRV2605_MODE_REALTIME);
+    writeShadowed(finger, DRV2605Shadow::MODE, DRV2605_MODE_REALTIME);
 
     // 6. Initialize RTP value to 0 (motor off)
-    drv.setRealtimeValue(0);
+    writeShadowed(finger, DRV2605Shadow::RTP, 0);
+}
+
+// Register behind each DRV2605Shadow slot
+static const uint8_t SHADOW_REGISTER[DRV2605Shadow::SLOT_COUNT] = {
+    DRV2605_REG_MODE, DRV2605_REG_RTPIN, DRV2605_REG_RATEDV,
+    DRV2605_REG_CONTROL1, DRV2605_REG_CONTROL3
+};
+
+void HapticController::writeShadowed(uint8_t finger, DRV2605Shadow::Slot slot, uint8_t value) {
+    _drv[finger].writeRegister8(SHADOW_REGISTER[slot], value);
+    _shadow[finger].set(slot, value);
+}
+
+bool HapticController::writeIfChanged(uint8_t finger, DRV2605Shadow::Slot slot, uint8_t value) {
+    if (_shadow[finger].matches(slot, value)) {
+        return false;
+    }
+    writeShadowed(finger, slot, value);
+    return true;
+}
+
+void HapticController::invalidateShadows() {
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        _shadow[f].invalidate();
+    }
+    _muxValid = false;
 }
 
 // DRV2605 FEEDBACK register and its N_ERM_LRA bit: set by configureDRV2605
@@ -205,6 +241,69 @@ void HapticController::configureDRV2605(Adafruit_DRV2605& drv) {
 constexpr uint8_t DRV_REG_FEEDBACK = 0x1A;
 constexpr uint8_t DRV_FB_N_ERM_LRA = 0x80;
 
+bool HapticController::probeChannelReadback(uint8_t finger) {
+    // WAVESEQ8 is unused in RTP mode, so alternating bit patterns can be
+    // written and read back without touching the motor. The TCA9548A
+    // control register is read back too: it sits on the same bus segment
+    // and is the first thing to corrupt on a slow edge.
+    static const uint8_t PATTERNS[] = {0x55, 0xAA, 0x0F, 0xF0};
+    const uint8_t channelMask = static_cast<uint8_t>(1u << finger);
+
+    bool ok = selectChannel(finger);
+    for (uint8_t i = 0; ok && i < I2C_PROBE_READBACK_COUNT; i++) {
+        uint8_t pattern = PATTERNS[i % sizeof(PATTERNS)];
+        _drv[finger].writeRegister8(DRV2605_REG_WAVESEQ8, pattern);
+        ok = (_drv[finger].readRegister8(DRV2605_REG_WAVESEQ8) == pattern) &&
+             (_tca.readRegister() == channelMask);
+    }
+    if (ok) {
+        // Run config must also read back intact (RTP mode, LRA feedback)
+        ok = (_drv[finger].readRegister8(DRV2605_REG_MODE) == DRV2605_MODE_REALTIME) &&
+             ((_drv[finger].readRegister8(DRV_REG_FEEDBACK) & DRV_FB_N_ERM_LRA) != 0);
+    }
+    _drv[finger].writeRegister8(DRV2605_REG_WAVESEQ8, 0);
+    closeChannels();
+    return ok;
+}
+
+uint32_t HapticController::negotiateBusSpeed() {
+    _busFrequency = I2C_FREQUENCY;
+    _busProbeFailMask = 0;
+
+    if (I2C_FREQUENCY_MAX <= I2C_FREQUENCY) {
+        Serial.printf("[INFO] I2C bus: %lu kHz (board maximum)\n",
+                      static_cast<unsigned long>(I2C_FREQUENCY / 1000));
+        return _busFrequency;
+    }
+
+    I2CMutexLock lock(_i2cMutex);
+    Wire.setClock(I2C_FREQUENCY_MAX);
+
+    for (uint8_t finger = 0; finger < MAX_ACTUATORS; finger++) {
+        if (!_fingerEnabled[finger]) continue;
+        if (!probeChannelReadback(finger)) {
+            _busProbeFailMask |= static_cast<uint8_t>(1u << finger);
+        }
+    }
+
+    if (_busProbeFailMask == 0) {
+        _busFrequency = I2C_FREQUENCY_MAX;
+        Serial.printf("[INFO] I2C bus: %lu kHz (all channels verified)\n",
+                      static_cast<unsigned long>(_busFrequency / 1000));
+        return _busFrequency;
+    }
+
+    // One shared bus: a single marginal branch (long trace, extra load)
+    // drops every channel back to Fast Mode
+    Wire.setClock(I2C_FREQUENCY);
+    invalidateShadows();  // Writes at the failed speed may not have landed
+    closeChannels();
+    Serial.printf("[WARN] I2C bus: %lu kHz read-back failed (channel mask 0x%02X), using %lu kHz\n",
+                  static_cast<unsigned long>(I2C_FREQUENCY_MAX / 1000), _busProbeFailMask,
+                  static_cast<unsigned long>(I2C_FREQUENCY / 1000));
+    return _busFrequency;
+}
+
 uint8_t HapticController::verifyAndHeal() {
     // A DRV2605 that lost VDD (VBat brownout: sagging/absent/miswired
     // battery) comes back at POR defaults - standby, ERM mode - and then
@@ -236,12 +335,13 @@ uint8_t HapticController::verifyAndHeal() {
     if (!wasReset) return 0;
 
     Serial.printf("[FAULT] DRV2605 F%u reset detected (VBat brownout?) - reconfiguring all\n", probe);
+    // The sag may have glitched the mux too; re-write it on the next select
+    _muxValid = false;
     for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
         if (!_fingerEnabled[f]) continue;
         if (!selectChannel(f)) continue;
         if ((_drv[f].readRegister8(DRV_REG_FEEDBACK) & DRV_FB_N_ERM_LRA) == 0) {
-            configureDRV2605(_drv[f]);
-            _drv[f].setRealtimeValue(0);
+            configureDRV2605(f);  // Drops the stale shadow, re-writes RTP=0
             healed++;
         }
         closeChannels();
@@ -249,23 +349,92 @@ uint8_t HapticController::verifyAndHeal() {
     return healed;
 }
 
+bool HapticController::readHealthRegister(uint8_t finger, uint8_t reg, uint8_t& value) {
+    if (finger >= MAX_ACTUATORS || !_fingerEnabled[finger]) {
+        return false;
+    }
+
+    I2CMutexLock lock(_i2cMutex, 0);
+    if (!lock.acquired()) {
+        return false;  // Bus busy - the slice must not wait
+    }
+
+    if (!selectChannel(finger)) {
+        return false;
+    }
+    value = _drv[finger].readRegister8(reg);
+    closeChannels();
+    return true;
+}
+
+bool HapticController::healFinger(uint8_t finger) {
+    if (finger >= MAX_ACTUATORS || !_fingerEnabled[finger]) {
+        return false;
+    }
+
+    I2CMutexLock lock(_i2cMutex, 0);
+    if (!lock.acquired()) {
+        return false;
+    }
+
+    Serial.printf("[FAULT] DRV2605 F%u reset detected (VBat brownout?) - reconfiguring\n", finger);
+    // The sag may have glitched the mux too; re-write it on this select
+    _muxValid = false;
+    if (!selectChannel(finger)) {
+        return false;
+    }
+    configureDRV2605(finger);  // Drops the stale shadow, re-writes RTP=0
+    closeChannels();
+    return true;
+}
+
 // A burst larger than the estimator's window would be silently truncated
 static_assert(VBAT_BURST_SAMPLES <= VBAT_MAX_BURST,
               "VBAT_BURST_SAMPLES exceeds VbatEstimator's burst window");
 
-uint8_t HapticController::readVBatBurst(uint8_t* out, uint8_t maxSamples) {
+uint8_t HapticController::vbatFinger() const {
+    // First enabled finger is the voltmeter; all chips share the VBat rail.
+    // _fingerEnabled is set at init, so this scan needs no lock.
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        if (_fingerEnabled[f]) {
+            return f;
+        }
+    }
+    return MAX_ACTUATORS;
+}
+
+bool HapticController::readVBatRegister(uint8_t finger, bool checkCanary, uint8_t& raw) {
     constexpr uint8_t DRV_REG_VBAT = 0x21;
 
+    I2CMutexLock lock(_i2cMutex, pdMS_TO_TICKS(5));
+    if (!lock.acquired()) {
+        return false;  // Bus busy
+    }
+
+    if (!selectChannel(finger)) {
+        return false;
+    }
+
+    if (checkCanary) {
+        // POR canary: a brownout resets the chip into standby, where VBAT
+        // is invalid. verifyAndHeal() reconfigures the chip.
+        if ((_drv[finger].readRegister8(DRV_REG_FEEDBACK) & DRV_FB_N_ERM_LRA) == 0) {
+            closeChannels();
+            return false;
+        }
+    }
+
+    raw = _drv[finger].readRegister8(DRV_REG_VBAT);
+    closeChannels();
+    return true;
+}
+
+uint8_t HapticController::readVBatBurst(uint8_t* out, uint8_t maxSamples) {
     if (out == nullptr || maxSamples == 0) {
         return 0;
     }
 
-    // First enabled finger is the voltmeter; all chips share the VBat rail.
-    // _fingerEnabled is set at init, so this scan needs no lock.
-    uint8_t finger = MAX_ACTUATORS;
-    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
-        if (_fingerEnabled[f]) { finger = f; break; }
-    }
+    uint8_t finger = vbatFinger();
     if (finger == MAX_ACTUATORS) {
         return 0;
     }
@@ -273,38 +442,28 @@ uint8_t HapticController::readVBatBurst(uint8_t* out, uint8_t maxSamples) {
     // Each sample takes its own short-lived lock so a pending motor
     // activation is delayed at most one mux-select-read-close, not the
     // whole burst. anyMotorActive() is rechecked every iteration because a
-    // motor can start mid-burst (driven LRA sags VBat).
+    // motor can start mid-burst (driven LRA sags VBat). The reset canary is
+    // only checked on the first sample's transaction.
     for (uint8_t i = 0; i < maxSamples; i++) {
         if (anyMotorActive()) {
             return 0;  // Motor became active mid-burst - discard the partial burst
         }
-
-        I2CMutexLock lock(_i2cMutex, pdMS_TO_TICKS(5));
-        if (!lock.acquired()) {
-            return 0;  // Bus busy - discard the partial burst
-        }
-
-        if (!selectChannel(finger)) {
-            return 0;
+        if (!readVBatRegister(finger, i == 0, out[i])) {
+            return 0;  // Bus busy or chip reset - discard the partial burst
         }
-
-        if (i == 0) {
-            // POR canary: a brownout resets the chip into standby, where VBAT
-            // is invalid. Abort the burst; verifyAndHeal() reconfigures the
-            // chip. Only checked on the first sample's transaction.
-            if ((_drv[finger].readRegister8(DRV_REG_FEEDBACK) & DRV_FB_N_ERM_LRA) == 0) {
-                closeChannels();
-                return 0;
-            }
-        }
-
-        out[i] = _drv[finger].readRegister8(DRV_REG_VBAT);
-        closeChannels();
     }
 
     return maxSamples;
 }
 
+bool HapticController::readVBatSample(uint8_t& raw) {
+    uint8_t finger = vbatFinger();
+    if (finger == MAX_ACTUATORS || anyMotorActive()) {
+        return false;
+    }
+    return readVBatRegister(finger, true, raw);
+}
+
 bool HapticController::anyMotorActive() const {
     // Read cross-task without the mutex: plain bool loads are atomic on
     // Xtensa/Cortex-M, and a stale value only costs one discarded or late
@@ -346,8 +505,8 @@ void HapticController::diagDriveOne(uint8_t finger) {
             return;
         }
         selectChannel(finger);
-        configureDRV2605(_drv[finger]);
-        _drv[finger].setRealtimeValue(127);
+        configureDRV2605(finger);
+        writeShadowed(finger, DRV2605Shadow::RTP, 127);
         closeChannels();  // RTP keeps driving; the mux only routes I2C
     }
 #if defined(BOARD_PENTABUZZER_ESP32S3)
@@ -363,7 +522,7 @@ void HapticController::diagDriveOne(uint8_t finger) {
         // proceed-anyway policy as emergencyStop()
         I2CMutexLock lock(_i2cMutex);
         selectChannel(finger);
-        _drv[finger].setRealtimeValue(0);
+        writeShadowed(finger, DRV2605Shadow::RTP, 0);
         fb = _drv[finger].readRegister8(DRV_REG_FEEDBACK);
         closeChannels();
     }
@@ -403,8 +562,7 @@ void HapticController::diagSweep() {
         for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
             if (!_fingerEnabled[f]) continue;
             selectChannel(f);
-            configureDRV2605(_drv[f]);
-            _drv[f].setRealtimeValue(0);
+            configureDRV2605(f);
             closeChannels();
         }
     }
@@ -429,7 +587,7 @@ void HapticController::diagSweep() {
                 return;
             }
             selectChannel(f);
-            _drv[f].setRealtimeValue(127);
+            writeShadowed(f, DRV2605Shadow::RTP, 127);
             closeChannels();  // RTP keeps driving; the mux only routes I2C
         }
         delay(600);
@@ -440,7 +598,7 @@ void HapticController::diagSweep() {
             // proceed-anyway policy as emergencyStop()
             I2CMutexLock lock(_i2cMutex);
             selectChannel(f);
-            _drv[f].setRealtimeValue(0);
+            writeShadowed(f, DRV2605Shadow::RTP, 0);
             fbSelf = _drv[f].readRegister8(DRV_REG_FEEDBACK);
             closeChannels();
             if (static_cast<uint8_t>(canary) != f) {
@@ -461,8 +619,7 @@ void HapticController::diagSweep() {
             for (uint8_t h = 0; h < MAX_ACTUATORS; h++) {
                 if (!_fingerEnabled[h]) continue;
                 selectChannel(h);
-                configureDRV2605(_drv[h]);
-                _drv[h].setRealtimeValue(0);
+                configureDRV2605(h);
                 closeChannels();
             }
         }
@@ -471,6 +628,16 @@ void HapticController::diagSweep() {
     Serial.println(F("[DIAG] sweep done"));
 }
 
+// Presence probe (LRA auto-calibration, MODE=0x07) register values
+constexpr uint8_t DRV_STATUS_DIAG_RESULT = 0x08;  // STATUS bit3: 1 = cal failed
+constexpr uint32_t DIAG_GO_TIMEOUT_MS = 2000;     // auto-cal can run ~1.2s
+constexpr uint8_t DRV_FB_LRA_DEFAULTS = 0xB6;     // LRA + stock brake/loop/BEMF gains
+constexpr uint8_t DRV_RATEDV_2V0_250HZ = 0x50;    // ~2.0Vrms rated at 250Hz LRA
+constexpr uint8_t DRV_ODCLAMP_2V5 = 118;          // 2.5V clamp (matches run config)
+constexpr uint8_t DRV_CTRL1_DRIVETIME_250HZ = 0x8F;  // DRIVE_TIME=15 = half-period of 250Hz
+constexpr uint8_t DRV_CTRL3_POR = 0xA0;           // closed-loop for calibration
+constexpr uint8_t DRV_REG_LRA_PERIOD = 0x22;      // measured period, 98.46us per LSB
+
 uint8_t HapticController::probeMotorPresence() {
     // Presence detection via LRA auto-calibration (MODE=0x07): calibration
     // locks onto the LRA's resonance using measured back-EMF, which requires
@@ -481,125 +648,184 @@ uint8_t HapticController::probeMotorPresence() {
     // Full LRA open-loop config is restored afterward; the cal coefficients
     // it writes are ignored in open-loop mode. Populated motors buzz
     // noticeably (~0.5s each) during the probe.
-    constexpr uint8_t DRV_STATUS_DIAG_RESULT = 0x08;  // STATUS bit3: 1 = cal failed
-    constexpr uint32_t DIAG_GO_TIMEOUT_MS = 2000;     // auto-cal can run ~1.2s
-    constexpr uint8_t DRV_FB_LRA_DEFAULTS = 0xB6;     // LRA + stock brake/loop/BEMF gains
-    constexpr uint8_t DRV_RATEDV_2V0_250HZ = 0x50;    // ~2.0Vrms rated at 250Hz LRA
-    constexpr uint8_t DRV_ODCLAMP_2V5 = 118;          // 2.5V clamp (matches run config)
-    constexpr uint8_t DRV_CTRL1_DRIVETIME_250HZ = 0x8F;  // DRIVE_TIME=15 = half-period of 250Hz
-    constexpr uint8_t DRV_REG_CONTROL3 = 0x1D;
-    constexpr uint8_t DRV_CTRL3_POR = 0xA0;           // closed-loop for calibration
+    //
+    // Each DRV2605 calibrates on its own once GO is set, so with
+    // MOTOR_PROBE_PARALLEL_ENABLED every port runs in one pass (probe time
+    // = slowest motor). All motors driving at once draws the most current:
+    // a pass that trips the supply-dip canary is retried one port at a time.
+    uint8_t enabledMask = 0;
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        if (_fingerEnabled[f]) {
+            enabledMask |= static_cast<uint8_t>(1u << f);
+        }
+    }
 
     uint8_t mask = 0;
+    AutoCalResult results[MAX_ACTUATORS];
     _lastProbeDipped = false;
-    Serial.println(F("[DIAG] Motor presence probe (all ports)"));
+    bool sequential = true;
+#if MOTOR_PROBE_PARALLEL_ENABLED
+    Serial.println(F("[DIAG] Motor presence probe (all ports, parallel)"));
+    if (!runAutoCalPass(enabledMask, results)) {
+        Serial.println(F("[DIAG] bus busy, probe aborted"));
+        return getMotorPresentCount();  // keep previous result
+    }
     for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
-#if defined(BOARD_PENTABUZZER_ESP32S3)
-        Serial.printf("[DIAG]   silk port %u (F%u): ", MOTOR_SILK_PORT(f), f);
-#else
-        Serial.printf("[DIAG]   F%u: ", f);
+        reportAutoCal(f, results[f], mask);
+    }
+    sequential = _lastProbeDipped;
+    if (sequential) {
+        Serial.println(F("[DIAG] supply dipped with all motors calibrating - retrying one port at a time"));
+        mask = 0;
+        _lastProbeDipped = false;
+    }
 #endif
-        if (!_fingerEnabled[f]) {
-            Serial.println(F("NO DRIVER (init failed - check battery power)"));
-            continue;
-        }
 
-        // Kick off diagnostics in ERM mode
-        {
-            I2CMutexLock lock(_i2cMutex);
-            if (!lock.acquired()) {
-                Serial.println(F("bus busy, probe aborted"));
+    if (sequential) {
+        Serial.println(F("[DIAG] Motor presence probe (all ports)"));
+        for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+            if (!runAutoCalPass(static_cast<uint8_t>(enabledMask & (1u << f)), results)) {
+                Serial.println(F("[DIAG] bus busy, probe aborted"));
                 return getMotorPresentCount();  // keep previous result
             }
-            if (!selectChannel(f)) {
-                Serial.println(F("MUX SELECT FAILED"));
+            reportAutoCal(f, results[f], mask);
+        }
+    }
+
+    if (_lastProbeDipped) {
+        // Supply sagged under cal drive: every verdict this pass is suspect.
+        // Keep the previous mask instead of committing garbage.
+        Serial.println(F("[DIAG] presence probe UNRELIABLE (supply dip) - results discarded"));
+        return getMotorPresentCount();
+    }
+    _motorPresentMask = mask;
+    uint8_t count = getMotorPresentCount();
+    Serial.printf("[DIAG] presence probe done: %u/%u motors detected\n",
+                  count, MAX_ACTUATORS);
+    return count;
+}
+
+bool HapticController::runAutoCalPass(uint8_t fingerMask, AutoCalResult results[MAX_ACTUATORS]) {
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        results[f] = {};
+    }
+
+    // Kick off every calibration back to back
+    {
+        I2CMutexLock lock(_i2cMutex);
+        if (!lock.acquired()) {
+            return false;
+        }
+        for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+            if (!(fingerMask & (1u << f)) || !selectChannel(f)) {
                 continue;
             }
             // Configure for closed-loop LRA auto-calibration
             _drv[f].writeRegister8(DRV_REG_FEEDBACK, DRV_FB_LRA_DEFAULTS);
-            _drv[f].writeRegister8(DRV2605_REG_RATEDV, DRV_RATEDV_2V0_250HZ);
+            writeShadowed(f, DRV2605Shadow::RATEDV, DRV_RATEDV_2V0_250HZ);
             _drv[f].writeRegister8(DRV2605_REG_CLAMPV, DRV_ODCLAMP_2V5);
-            _drv[f].writeRegister8(DRV2605_REG_CONTROL1, DRV_CTRL1_DRIVETIME_250HZ);
-            _drv[f].writeRegister8(DRV_REG_CONTROL3, DRV_CTRL3_POR);
-            _drv[f].writeRegister8(DRV2605_REG_MODE, DRV2605_MODE_AUTOCAL);
+            writeShadowed(f, DRV2605Shadow::CONTROL1, DRV_CTRL1_DRIVETIME_250HZ);
+            writeShadowed(f, DRV2605Shadow::CONTROL3, DRV_CTRL3_POR);
+            writeShadowed(f, DRV2605Shadow::MODE, DRV2605_MODE_AUTOCAL);
             _drv[f].writeRegister8(DRV2605_REG_GO, 1);
-            closeChannels();
+            results[f].started = true;
         }
+        closeChannels();
+    }
 
-        // Poll until GO self-clears (mutex per transaction, never across delays)
-        bool done = false;
-        bool dipped = false;
-        uint8_t status = 0;
-        uint32_t start = millis();
-        while (millis() - start < DIAG_GO_TIMEOUT_MS) {
-            delay(10);
+    // Poll round-robin until every GO self-clears (mutex per transaction,
+    // never across delays)
+    uint8_t pending = 0;
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        if (results[f].started) {
+            pending |= static_cast<uint8_t>(1u << f);
+        }
+    }
+    uint32_t start = millis();
+    while (pending != 0 && millis() - start < DIAG_GO_TIMEOUT_MS) {
+        delay(10);
+        for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+            if (!(pending & (1u << f))) continue;
             I2CMutexLock lock(_i2cMutex);
             if (!lock.acquired()) continue;
             selectChannel(f);
             if ((_drv[f].readRegister8(DRV2605_REG_GO) & 0x01) == 0) {
-                status = _drv[f].readRegister8(DRV2605_REG_STATUS);
+                AutoCalResult& result = results[f];
+                result.status = _drv[f].readRegister8(DRV2605_REG_STATUS);
                 // Brownout canary: we wrote FEEDBACK with N_ERM_LRA (bit7)
                 // set before GO; if it reads back clear the chip hit POR
                 // mid-cal (supply dip, e.g. USB-only power) and STATUS is
                 // POR garbage that would fake a PRESENT verdict
                 uint8_t fb = _drv[f].readRegister8(DRV_REG_FEEDBACK);
-                dipped = (fb & DRV_FB_N_ERM_LRA) == 0;
-                done = true;
+                result.dipped = (fb & DRV_FB_N_ERM_LRA) == 0;
+                // Resonance the cal locked onto (before configureDRV2605
+                // puts the chip back in open loop)
+                result.period = _drv[f].readRegister8(DRV_REG_LRA_PERIOD);
+                result.done = true;
+                pending &= static_cast<uint8_t>(~(1u << f));
             }
             closeChannels();
-            if (done) break;
         }
+    }
+
+    // Restore LRA open-loop config regardless of outcome (proceed-anyway
+    // on mutex timeout - same policy as emergencyStop)
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        if (!results[f].started) continue;
+        I2CMutexLock lock(_i2cMutex);
+        selectChannel(f);
+        configureDRV2605(f);
+        closeChannels();
+    }
+    return true;
+}
+
+void HapticController::reportAutoCal(uint8_t finger, const AutoCalResult& result, uint8_t& mask) {
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+    Serial.printf("[DIAG]   silk port %u (F%u): ", MOTOR_SILK_PORT(finger), finger);
+#else
+    Serial.printf("[DIAG]   F%u: ", finger);
+#endif
+    if (!_fingerEnabled[finger]) {
+        Serial.println(F("NO DRIVER (init failed - check battery power)"));
+        return;
+    }
+    if (!result.started) {
+        Serial.println(F("MUX SELECT FAILED"));
+        return;
+    }
 
-        // Restore LRA open-loop config regardless of outcome (proceed-anyway
-        // on mutex timeout - same policy as emergencyStop)
+    if (!result.done) {
+        // Discriminate "diag never finished" (GO=0x01, STATUS has valid
+        // device ID 0xE0 in bits 7:5) from "I2C reads failing" (0xFF/0x00)
+        uint8_t rawGo = 0xAA, rawStatus = 0xAA, rawFb = 0xAA;
         {
             I2CMutexLock lock(_i2cMutex);
-            selectChannel(f);
-            configureDRV2605(_drv[f]);
-            _drv[f].setRealtimeValue(0);
-            closeChannels();
-        }
-
-        if (!done) {
-            // Discriminate "diag never finished" (GO=0x01, STATUS has valid
-            // device ID 0xE0 in bits 7:5) from "I2C reads failing" (0xFF/0x00)
-            uint8_t rawGo = 0xAA, rawStatus = 0xAA, rawFb = 0xAA;
-            {
-                I2CMutexLock lock(_i2cMutex);
-                if (lock.acquired() && selectChannel(f)) {
-                    rawGo = _drv[f].readRegister8(DRV2605_REG_GO);
-                    rawStatus = _drv[f].readRegister8(DRV2605_REG_STATUS);
-                    rawFb = _drv[f].readRegister8(DRV_REG_FEEDBACK);
-                    closeChannels();
-                }
-            }
-            Serial.printf("PROBE TIMEOUT (raw GO=0x%02X STATUS=0x%02X FB=0x%02X)\n",
-                          rawGo, rawStatus, rawFb);
-            if (rawFb != 0xAA && (rawFb & DRV_FB_N_ERM_LRA) == 0) {
-                _lastProbeDipped = true;
+            if (lock.acquired() && selectChannel(finger)) {
+                rawGo = _drv[finger].readRegister8(DRV2605_REG_GO);
+                rawStatus = _drv[finger].readRegister8(DRV2605_REG_STATUS);
+                rawFb = _drv[finger].readRegister8(DRV_REG_FEEDBACK);
+                closeChannels();
             }
-        } else if (dipped) {
-            Serial.printf("SUPPLY DIP (chip reset mid-probe, STATUS=0x%02X) - check battery\n",
-                          status);
+        }
+        Serial.printf("PROBE TIMEOUT (raw GO=0x%02X STATUS=0x%02X FB=0x%02X)\n",
+                      rawGo, rawStatus, rawFb);
+        if (rawFb != 0xAA && (rawFb & DRV_FB_N_ERM_LRA) == 0) {
             _lastProbeDipped = true;
-        } else if (status & DRV_STATUS_DIAG_RESULT) {
-            Serial.printf("NO MOTOR (open load, STATUS=0x%02X)\n", status);
-        } else {
-            Serial.printf("MOTOR PRESENT (STATUS=0x%02X)\n", status);
-            mask |= static_cast<uint8_t>(1u << f);
         }
+    } else if (result.dipped) {
+        Serial.printf("SUPPLY DIP (chip reset mid-probe, STATUS=0x%02X) - check battery\n",
+                      result.status);
+        _lastProbeDipped = true;
+    } else if (result.status & DRV_STATUS_DIAG_RESULT) {
+        Serial.printf("NO MOTOR (open load, STATUS=0x%02X)\n", result.status);
+    } else {
+        // period * 98.46us; a zero period is a cal that measured nothing
+        uint32_t resonanceHz = (result.period != 0) ? 100000000UL / (result.period * 9846UL) : 0;
+        Serial.printf("MOTOR PRESENT (STATUS=0x%02X, resonance %lu Hz)\n", result.status,
+                      static_cast<unsigned long>(resonanceHz));
+        mask |= static_cast<uint8_t>(1u << finger);
     }
-    if (_lastProbeDipped) {
-        // Supply sagged under cal drive: every verdict this pass is suspect.
-        // Keep the previous mask instead of committing garbage.
-        Serial.println(F("[DIAG] presence probe UNRELIABLE (supply dip) - results discarded"));
-        return getMotorPresentCount();
-    }
-    _motorPresentMask = mask;
-    uint8_t count = getMotorPresentCount();
-    Serial.printf("[DIAG] presence probe done: %u/%u motors detected\n",
-                  count, MAX_ACTUATORS);
-    return count;
 }
 
 bool HapticController::selectChannel(uint8_t finger) {
@@ -607,15 +833,27 @@ bool HapticController::selectChannel(uint8_t finger) {
         return false;
     }
 
-    _tca.openChannel(finger);
+    setMuxMask(static_cast<uint8_t>(1u << finger));
     return true;
 }
 
 void HapticController::closeChannels() {
-    _tca.closeAll();
+    setMuxMask(0);
     _preSelectedFinger = -1;  // Invalidate pre-selection
 }
 
+void HapticController::setMuxMask(uint8_t mask) {
+    if (!_muxValid || _muxMask != mask) {
+        _tca.writeRegister(mask);
+        _muxMask = mask;
+        _muxValid = true;
+    }
+    // Any other channel set drops the pre-selected one off the bus
+    if (_preSelectedFinger >= 0 && mask != (1u << _preSelectedFinger)) {
+        _preSelectedFinger = -1;
+    }
+}
+
 uint8_t HapticController::amplitudeToRTP(uint8_t amplitude) const {
     // Clamp amplitude to valid range
     if (amplitude > MAX_AMPLITUDE) {
@@ -623,7 +861,7 @@ uint8_t HapticController::amplitudeToRTP(uint8_t amplitude) const {
     }
 
     // Convert 0-100% to 0-127
-    return (uint8_t)((amplitude * DRV2605_MAX_RTP) / MAX_AMPLITUDE);
+    return DRV2605_LOOKUP.rtp[amplitude];
 }
 
 Result HapticController::activate(uint8_t finger, uint8_t amplitude) {
@@ -648,16 +886,15 @@ Result HapticController::activate(uint8_t finger, uint8_t amplitude) {
         return Result::ERROR_BUSY;
     }
 
-    // Select channel
-    if (!selectChannel(finger)) {
-        return Result::ERROR_HARDWARE;
-    }
-
-    // Set RTP value
+    // Skip the bus entirely if the driver already holds this RTP value
     uint8_t rtpValue = amplitudeToRTP(amplitude);
-    _drv[finger].setRealtimeValue(rtpValue);
-
-    closeChannels();
+    if (!_shadow[finger].matches(DRV2605Shadow::RTP, rtpValue)) {
+        if (!selectChannel(finger)) {
+            return Result::ERROR_HARDWARE;
+        }
+        writeShadowed(finger, DRV2605Shadow::RTP, rtpValue);
+        closeChannels();
+    }
 
     // Update state
     _fingerActive[finger] = (amplitude > 0);
@@ -682,22 +919,111 @@ Result HapticController::deactivate(uint8_t finger) {
         return Result::ERROR_BUSY;
     }
 
-    // Select channel
-    if (!selectChannel(finger)) {
-        return Result::ERROR_HARDWARE;
+    // Deactivating an already-stopped driver is free
+    if (!_shadow[finger].matches(DRV2605Shadow::RTP, 0)) {
+        if (!selectChannel(finger)) {
+            return Result::ERROR_HARDWARE;
+        }
+        writeShadowed(finger, DRV2605Shadow::RTP, 0);
+        closeChannels();
     }
 
-    // Set RTP value to 0
-    _drv[finger].setRealtimeValue(0);
-
-    closeChannels();
-
     // Update state
     _fingerActive[finger] = false;
 
     return Result::OK;
 }
 
+Result HapticController::applyBatch(const HapticBatchOp* ops, uint8_t count) {
+    if (ops == nullptr || count == 0) {
+        return Result::ERROR_INVALID_PARAM;
+    }
+
+    // Resolve to one final state per finger (later ops win: a DEACTIVATE
+    // followed by an ACTIVATE of the same finger inside the window leaves it on)
+    uint8_t rtp[MAX_ACTUATORS] = {0};
+    uint8_t driveTime[MAX_ACTUATORS] = {0};  // CONTROL1 value, looked up once per op
+    uint8_t touchedMask = 0;
+    uint8_t frequencyMask = 0;  // Fingers whose op sets a frequency
+    for (uint8_t i = 0; i < count; i++) {
+        const HapticBatchOp& op = ops[i];
+        if (op.finger >= MAX_ACTUATORS || !_fingerEnabled[op.finger]) {
+            continue;
+        }
+        rtp[op.finger] = amplitudeToRTP(op.amplitude);
+        bool validFreq = (op.frequencyHz >= MIN_FREQUENCY_HZ && op.frequencyHz <= MAX_FREQUENCY_HZ);
+        if (op.amplitude > 0 && validFreq) {
+            driveTime[op.finger] = frequencyToDriveTime(op.frequencyHz);
+            frequencyMask |= static_cast<uint8_t>(1u << op.finger);
+        } else {
+            frequencyMask &= static_cast<uint8_t>(~(1u << op.finger));
+        }
+        touchedMask |= static_cast<uint8_t>(1u << op.finger);
+    }
+    if (touchedMask == 0) {
+        return Result::ERROR_DISABLED;
+    }
+
+    // Acquire I2C mutex for thread-safe access
+    I2CMutexLock lock(_i2cMutex);
+    if (!lock.acquired()) {
+        return Result::ERROR_BUSY;
+    }
+
+    // Frequency first (must precede the RTP drive): one mux write + one
+    // CONTROL1 write per distinct drive time, skipping unchanged fingers
+    uint8_t pending = 0;
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        if ((frequencyMask & (1u << f)) && !_shadow[f].matches(DRV2605Shadow::CONTROL1, driveTime[f])) {
+            pending |= static_cast<uint8_t>(1u << f);
+        }
+    }
+    while (pending != 0) {
+        uint8_t lead = static_cast<uint8_t>(__builtin_ctz(pending));
+        uint8_t value = driveTime[lead];
+        uint8_t mask = 0;
+        for (uint8_t f = lead; f < MAX_ACTUATORS; f++) {
+            if ((pending & (1u << f)) && driveTime[f] == value) {
+                mask |= static_cast<uint8_t>(1u << f);
+                _shadow[f].set(DRV2605Shadow::CONTROL1, value);
+            }
+        }
+        setMuxMask(mask);
+        _drv[lead].writeRegister8(DRV2605_REG_CONTROL1, value);
+        pending &= static_cast<uint8_t>(~mask);
+    }
+
+    // RTP: one mux write + one RTP write per distinct value, skipping
+    // fingers whose driver already holds it
+    pending = 0;
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        if (touchedMask & (1u << f)) {
+            _fingerActive[f] = (rtp[f] > 0);
+            if (!_shadow[f].matches(DRV2605Shadow::RTP, rtp[f])) {
+                pending |= static_cast<uint8_t>(1u << f);
+            }
+        }
+    }
+    while (pending != 0) {
+        uint8_t lead = static_cast<uint8_t>(__builtin_ctz(pending));
+        uint8_t value = rtp[lead];
+        uint8_t mask = 0;
+        for (uint8_t f = lead; f < MAX_ACTUATORS; f++) {
+            if ((pending & (1u << f)) && rtp[f] == value) {
+                mask |= static_cast<uint8_t>(1u << f);
+                _shadow[f].set(DRV2605Shadow::RTP, value);
+            }
+        }
+        setMuxMask(mask);
+        _drv[lead].setRealtimeValue(value);
+        pending &= static_cast<uint8_t>(~mask);
+    }
+
+    closeChannels();
+
+    return Result::OK;
+}
+
 void HapticController::stopAll() {
     for (uint8_t finger = 0; finger < MAX_ACTUATORS; finger++) {
         if (_fingerEnabled[finger] && _fingerActive[finger]) {
@@ -711,11 +1037,13 @@ void HapticController::emergencyStop() {
     // If we can't acquire, proceed anyway (emergency takes priority)
     I2CMutexLock lock(_i2cMutex, pdMS_TO_TICKS(200));
 
-    // Stop all motors regardless of tracked state
+    // Stop all motors regardless of tracked state. RTP is written even when
+    // the shadow already says 0: register writes are not acknowledged back
+    // to us, so a stop must never depend on a cached value.
     for (uint8_t finger = 0; finger < MAX_ACTUATORS; finger++) {
         if (_fingerEnabled[finger]) {
             if (selectChannel(finger)) {
-                _drv[finger].setRealtimeValue(0);
+                writeShadowed(finger, DRV2605Shadow::RTP, 0);
             }
         }
     }
@@ -757,34 +1085,30 @@ Result HapticController::setFrequency(uint8_t finger, uint16_t frequencyHz) {
         return Result::ERROR_DISABLED;
     }
 
-    // Skip I2C if frequency unchanged (latency optimization)
-    if (_lastFrequency[finger] == frequencyHz) {
-        return Result::OK;
-    }
-
     // Acquire I2C mutex for thread-safe access
     I2CMutexLock lock(_i2cMutex);
     if (!lock.acquired()) {
         return Result::ERROR_BUSY;
     }
 
+    // Calculate drive time for LRA frequency
+    uint8_t driveTime = frequencyToDriveTime(frequencyHz);
+
+    // Skip I2C if the drive time is unchanged (latency optimization)
+    if (_shadow[finger].matches(DRV2605Shadow::CONTROL1, driveTime)) {
+        return Result::OK;
+    }
+
     // Select channel
     if (!selectChannel(finger)) {
         return Result::ERROR_HARDWARE;
     }
 
-    // Calculate drive time for LRA frequency
-    // Formula from DRV2605 datasheet
-    uint8_t driveTime = (uint8_t)((5000 / frequencyHz) & 0x1F);
-
     // Write to CONTROL1 register (0x1B)
-    _drv[finger].writeRegister8(DRV2605_REG_CONTROL1, driveTime);
+    writeShadowed(finger, DRV2605Shadow::CONTROL1, driveTime);
 
     closeChannels();
 
-    // Cache the frequency for future skip optimization
-    _lastFrequency[finger] = frequencyHz;
-
     return Result::OK;
 }
 
@@ -813,8 +1137,9 @@ bool HapticController::selectChannelPersistent(uint8_t finger) {
         return false;
     }
 
-    // Open channel and leave it open (no closeChannels call)
-    _tca.openChannel(finger);
+    // Open channel and leave it open (no closeChannels call); free if it
+    // is already the open one
+    selectChannel(finger);
     _preSelectedFinger = static_cast<int8_t>(finger);  // Track pre-selected channel
     return true;
 }
@@ -845,10 +1170,10 @@ Result HapticController::setFrequencyDirect(uint8_t finger, uint16_t frequencyHz
     // Write directly to DRV2605 without mux operations
 
     // Calculate drive time for LRA frequency (same formula as setFrequency)
-    uint8_t driveTime = (uint8_t)((5000 / frequencyHz) & 0x1F);
+    uint8_t driveTime = frequencyToDriveTime(frequencyHz);
 
-    // Write to CONTROL1 register (0x1B)
-    _drv[finger].writeRegister8(DRV2605_REG_CONTROL1, driveTime);
+    // Write to CONTROL1 register (0x1B) unless already there
+    writeIfChanged(finger, DRV2605Shadow::CONTROL1, driveTime);
 
     return Result::OK;
 }
@@ -875,21 +1200,19 @@ Result HapticController::activatePreSelected(uint8_t finger, uint8_t amplitude)
         return Result::ERROR_BUSY;
     }
 
-    // Only re-select channel if pre-selection was invalidated
-    // Pre-selection is invalidated when closeChannels() or closeAllChannels() is called
-    // (e.g., by deactivate() on another motor)
-    if (_preSelectedFinger != static_cast<int8_t>(finger)) {
+    // Write RTP value (frequency was already set during pre-selection)
+    // This is the minimal critical-path I2C: just the RTP write (~100-150µs)
+    uint8_t rtpValue = amplitudeToRTP(amplitude);
+    if (!_shadow[finger].matches(DRV2605Shadow::RTP, rtpValue)) {
+        // Re-selecting is free while the pre-selection is intact; it is lost
+        // when closeChannels() or closeAllChannels() is called (e.g., by
+        // deactivate() on another motor)
         if (!selectChannel(finger)) {
             return Result::ERROR_HARDWARE;
         }
-        // Note: selectChannel() doesn't update _preSelectedFinger (it's for persistent selection)
+        writeShadowed(finger, DRV2605Shadow::RTP, rtpValue);
     }
 
-    // Write RTP value (frequency was already set during pre-selection)
-    // This is the minimal critical-path I2C: just the RTP write (~100-150µs)
-    uint8_t rtpValue = amplitudeToRTP(amplitude);
-    _drv[finger].setRealtimeValue(rtpValue);
-
     // Update state
     _fingerActive[finger] = (amplitude > 0);
 
@@ -901,8 +1224,7 @@ void HapticController::closeAllChannels() {
     // (closing is important for safety)
     I2CMutexLock lock(_i2cMutex, pdMS_TO_TICKS(50));
 
-    _tca.closeAll();
-    _preSelectedFinger = -1;  // Invalidate pre-selection
+    closeChannels();  // Invalidates pre-selection
 }
 
 // =============================================================================
@@ -948,6 +1270,7 @@ bool BatteryMonitor::begin() {
     } else {
         Serial.println(F("[ERROR] Battery monitor: no VBAT reading (chips reset? check battery)"));
     }
+    startScheduledSampling();
     return _initialized;
 #endif
 }
@@ -972,6 +1295,16 @@ float BatteryMonitor::readVoltage() {
     float voltage = (average / (float)ADC_MAX_VALUE) * ADC_REFERENCE_VOLTAGE * BATTERY_VOLTAGE_DIVIDER;
 
     return voltage;
+#else
+#if VBAT_SCHEDULED_SAMPLING_ENABLED
+    // The motor task samples the VBAT register in idle gaps
+    // (serviceScheduledSample); report its running estimate without
+    // touching the bus. A failed boot burst recovers on its first sample.
+    if (!_initialized && _estimator.hasReading()) {
+        _initialized = true;
+        Serial.println(F("[INFO] Battery monitor recovered (DRV2605 VBAT)"));
+    }
+    return _estimator.voltage();
 #else
     // Refresh from the DRV2605 VBAT register, but only while no motor is
     // driven - an LRA pulse sags VBat by hundreds of mV and would read
@@ -991,6 +1324,41 @@ float BatteryMonitor::readVoltage() {
     }
     return _estimator.voltage();
 #endif
+#endif
+}
+
+void BatteryMonitor::startScheduledSampling() {
+#if VBAT_SCHEDULED_SAMPLING_ENABLED && !BATTERY_SENSE_ADC
+    // Publish the estimator's boot state before the motor task takes it over
+    platformMemoryBarrier();
+    _scheduled = true;
+#endif
+}
+
+bool BatteryMonitor::serviceScheduledSample(uint64_t nowUs) {
+#if VBAT_SCHEDULED_SAMPLING_ENABLED && !BATTERY_SENSE_ADC
+    if (!_scheduled || _haptic == nullptr ||
+        (_lastSampleUs != 0 && nowUs - _lastSampleUs < VBAT_SAMPLE_INTERVAL_MS * 1000ULL)) {
+        return false;
+    }
+    // An overlapping pulse may still be driven across this gap; its sag
+    // would read low. Retry in the next gap.
+    if (_haptic->anyMotorActive()) {
+        return false;
+    }
+
+    // One attempt per interval, successful or not, so a wedged bus or a
+    // PORed chip is not hammered
+    _lastSampleUs = nowUs;
+    uint8_t raw = 0;
+    if (_haptic->readVBatSample(raw)) {
+        _estimator.addSample(raw);
+    }
+    return true;
+#else
+    (void)nowUs;
+    return false;
+#endif
 }
 
 uint8_t BatteryMonitor::getPercentage(float voltage) {
@@ -1067,8 +1435,8 @@ LEDController::LEDController()
       _pattern(LEDPattern::OFF),
       _initialized(false),
       _patternStartTime(0),
-      _blinkState(false),
-      _lastBlinkToggle(0) {
+      _brightness(LED_BRIGHTNESS),
+      _onSchedule(nullptr) {
 }
 
 bool LEDController::begin() {
@@ -1085,99 +1453,34 @@ bool LEDController::begin() {
     return _initialized;
 }
 
-void LEDController::update() {
+uint32_t LEDController::update() {
     if (!_initialized) {
-        return;
+        return 0;
     }
 
-    uint32_t now = millis();
-
-    switch (_pattern) {
-        case LEDPattern::SOLID:
-            // No animation needed - color already applied
-            break;
-
-        case LEDPattern::BREATHE_SLOW: {
-            float brightness = calculateBreatheBrightness(LED_BREATHE_SLOW_MS);
-            RGBColor modulated(
-                (uint8_t)(_baseColor.r * brightness),
-                (uint8_t)(_baseColor.g * brightness),
-                (uint8_t)(_baseColor.b * brightness)
-            );
-            if (modulated != _displayColor) {
-                applyColor(modulated);
-            }
-            break;
-        }
-
-        case LEDPattern::PULSE_SLOW: {
-            float brightness = calculateBreatheBrightness(LED_PULSE_SLOW_MS);
-            RGBColor modulated(
-                (uint8_t)(_baseColor.r * brightness),
-                (uint8_t)(_baseColor.g * brightness),
-                (uint8_t)(_baseColor.b * brightness)
-            );
-            if (modulated != _displayColor) {
-                applyColor(modulated);
-            }
-            break;
-        }
-
-        case LEDPattern::BLINK_FAST: {
-            uint32_t interval = _blinkState ? LED_BLINK_FAST_ON_MS : LED_BLINK_FAST_OFF_MS;
-            if (now - _lastBlinkToggle >= interval) {
-                _lastBlinkToggle = now;
-                _blinkState = !_blinkState;
-                applyColor(_blinkState ? _baseColor : Colors::OFF);
-            }
-            break;
-        }
-
-        case LEDPattern::BLINK_SLOW: {
-            uint32_t interval = _blinkState ? LED_BLINK_SLOW_ON_MS : LED_BLINK_SLOW_OFF_MS;
-            if (now - _lastBlinkToggle >= interval) {
-                _lastBlinkToggle = now;
-                _blinkState = !_blinkState;
-                applyColor(_blinkState ? _baseColor : Colors::OFF);
-            }
-            break;
-        }
-
-        case LEDPattern::BLINK_URGENT: {
-            uint32_t interval = _blinkState ? LED_BLINK_URGENT_ON_MS : LED_BLINK_URGENT_OFF_MS;
-            if (now - _lastBlinkToggle >= interval) {
-                _lastBlinkToggle = now;
-                _blinkState = !_blinkState;
-                applyColor(_blinkState ? _baseColor : Colors::OFF);
-            }
-            break;
-        }
-
-        case LEDPattern::BLINK_CONNECT: {
-            uint32_t interval = _blinkState ? LED_BLINK_CONNECT_ON_MS : LED_BLINK_CONNECT_OFF_MS;
-            if (now - _lastBlinkToggle >= interval) {
-                _lastBlinkToggle = now;
-                _blinkState = !_blinkState;
-                applyColor(_blinkState ? _baseColor : Colors::OFF);
-            }
-            break;
-        }
-
-        case LEDPattern::DOUBLE_BLINK: {
-            // Two 150ms blinks, then a 650ms pause (1250ms cycle)
-            uint32_t t = (now - _patternStartTime) % 1250;
-            bool on = (t < 150) || (t >= 300 && t < 450);
-            if (on != _blinkState) {
-                _blinkState = on;
-                applyColor(on ? _baseColor : Colors::OFF);
-            }
+    uint32_t elapsed = millis() - _patternStartTime;
+    uint8_t level;
+    uint32_t delayMs = ledWaveformSample(_pattern, elapsed, level);
+    RGBColor frame = frameColor(level);
+    if (!sameOnWire(frame, _displayColor)) {
+        applyColor(frame);
+    }
+
+    // Sleep through the steps that look the same after brightness scaling
+    // (bounded: a pattern that never changes on the wire waits ~1 cycle)
+    for (uint8_t i = 0; delayMs != 0 && i < LED_WAVEFORM_STEPS; i++) {
+        uint8_t nextLevel;
+        uint32_t holdMs = ledWaveformSample(_pattern, elapsed + delayMs, nextLevel);
+        if (!sameOnWire(frameColor(nextLevel), frame)) {
             break;
         }
-
-        case LEDPattern::OFF:
-            // LED is off, nothing to update
-            break;
+        delayMs += holdMs;
     }
+    return delayMs;
+}
+
+void LEDController::setScheduleCallback(void (*callback)(uint32_t delayMs)) {
+    _onSchedule = callback;
 }
 
 void LEDController::setPattern(const RGBColor& color, LEDPattern pattern) {
@@ -1188,33 +1491,11 @@ void LEDController::setPattern(const RGBColor& color, LEDPattern pattern) {
     _baseColor = color;
     _pattern = pattern;
     _patternStartTime = millis();
-    _lastBlinkToggle = millis();
-    _blinkState = true;  // Start blink patterns in ON state
 
-    // Immediately apply the initial state
-    switch (pattern) {
-        case LEDPattern::SOLID:
-            applyColor(color);
-            break;
-
-        case LEDPattern::BREATHE_SLOW:
-        case LEDPattern::PULSE_SLOW:
-            // Start at full brightness, update() will animate
-            applyColor(color);
-            break;
-
-        case LEDPattern::BLINK_FAST:
-        case LEDPattern::BLINK_SLOW:
-        case LEDPattern::BLINK_URGENT:
-        case LEDPattern::BLINK_CONNECT:
-        case LEDPattern::DOUBLE_BLINK:
-            // Start in ON state
-            applyColor(color);
-            break;
-
-        case LEDPattern::OFF:
-            applyColor(Colors::OFF);
-            break;
+    // Show the first frame now (blinks start ON, breathe/pulse at the floor)
+    uint32_t delayMs = update();
+    if (_onSchedule) {
+        _onSchedule(delayMs);
     }
 }
 
@@ -1236,8 +1517,8 @@ void LEDController::setBrightness(uint8_t brightness) {
     }
 
     // Cap brightness to prevent external code from exceeding max
-    uint8_t cappedBrightness = (brightness > LED_BRIGHTNESS) ? LED_BRIGHTNESS : brightness;
-    _pixel.setBrightness(cappedBrightness);
+    _brightness = (brightness > LED_BRIGHTNESS) ? LED_BRIGHTNESS : brightness;
+    _pixel.setBrightness(_brightness);
     _pixel.show();
 }
 
@@ -1255,18 +1536,14 @@ void LEDController::applyColor(const RGBColor& color) {
     _pixel.show();
 }
 
-float LEDController::calculateBreatheBrightness(uint32_t cycleMs) const {
-    // Calculate position in cycle (0.0 to 1.0)
-    uint32_t elapsed = millis() - _patternStartTime;
-    float position = (float)(elapsed % cycleMs) / (float)cycleMs;
-
-    // Use sine wave for smooth breathing effect
-    // sin goes from -1 to 1, we want 0 to 1
-    // Position 0 = brightness 0.5, position 0.25 = brightness 1.0
-    // position 0.5 = brightness 0.5, position 0.75 = brightness 0.0
-    float brightness = (sinf(position * 2.0f * static_cast<float>(PI) - static_cast<float>(PI) / 2.0f) + 1.0f) / 2.0f;
+RGBColor LEDController::frameColor(uint8_t level) const {
+    return RGBColor(ledWaveformScale(_baseColor.r, level),
+                    ledWaveformScale(_baseColor.g, level),
+                    ledWaveformScale(_baseColor.b, level));
+}
 
-    // Clamp to ensure we don't go below a minimum visibility threshold
-    const float MIN_BRIGHTNESS = 0.1f;
-    return MIN_BRIGHTNESS + brightness * (1.0f - MIN_BRIGHTNESS);
+bool LEDController::sameOnWire(const RGBColor& a, const RGBColor& b) const {
+    return ledWireLevel(a.r, _brightness) == ledWireLevel(b.r, _brightness) &&
+           ledWireLevel(a.g, _brightness) == ledWireLevel(b.g, _brightness) &&
+           ledWireLevel(a.b, _brightness) == ledWireLevel(b.b, _brightness);
 }
@@ -1,7 +1,7 @@
 /**
  * @file hires_clock.cpp
  * @brief 1MHz hardware timebase implementation
- * @version 1.0.0
+ * @version 1.1.0
  */
 
 #include "hires_clock.h"
@@ -12,8 +12,15 @@
 #include <nrf.h>
 #include <nrf_soc.h>
 #include <nrf_sdm.h>
+#include <nrf_nvic.h>
+#include "platform.h"
 
 static volatile bool s_running = false;
+static volatile HiresAlarmCallback s_alarmCallback = nullptr;
+
+// Deadlines closer than this are not armed: the compare could be written
+// after the counter already passed it (the event would never fire)
+static constexpr int32_t ALARM_MIN_DELAY_US = 10;
 
 bool hiresClockBegin() {
     if (s_running) {
@@ -82,6 +89,69 @@ uint32_t hiresClockRead32() {
     return NRF_TIMER4->CC[5];
 }
 
+extern "C" void TIMER4_IRQHandler(void) {
+    if (NRF_TIMER4->EVENTS_COMPARE[4]) {
+        // One-shot: disarm before notifying so a re-arm from the woken task
+        // is never cleared by this handler
+        NRF_TIMER4->EVENTS_COMPARE[4] = 0;
+        NRF_TIMER4->INTENCLR = TIMER_INTENCLR_COMPARE4_Msk;
+        (void)NRF_TIMER4->EVENTS_COMPARE[4];  // Flush the write before IRQ exit (avoids re-entry)
+
+        HiresAlarmCallback cb = s_alarmCallback;
+        if (cb != nullptr && cb()) {
+            portYIELD_FROM_ISR(pdTRUE);
+        }
+    }
+}
+
+bool hiresClockAlarmBegin(HiresAlarmCallback callback) {
+    if (!s_running || callback == nullptr) {
+        return false;
+    }
+
+    NRF_TIMER4->INTENCLR = TIMER_INTENCLR_COMPARE4_Msk;
+    NRF_TIMER4->EVENTS_COMPARE[4] = 0;
+    s_alarmCallback = callback;
+
+    // Priority 3: below the radio-notification anchor IRQ (2) so anchors keep
+    // their timestamp precision; still within FreeRTOS's FromISR-safe range
+    if (sd_nvic_SetPriority(TIMER4_IRQn, 3) != NRF_SUCCESS) {
+        return false;
+    }
+    sd_nvic_ClearPendingIRQ(TIMER4_IRQn);
+    return sd_nvic_EnableIRQ(TIMER4_IRQn) == NRF_SUCCESS;
+}
+
+bool hiresClockAlarmArm(uint64_t deadlineUs) {
+    if (!s_running || s_alarmCallback == nullptr) {
+        return false;
+    }
+
+    // TIMER4 counts the low 32 bits of getMicros() (same source, re-seeded
+    // together at boot), so the compare value is just the truncated deadline.
+    // IRQ-off: the CC[5] capture in hiresClockRead32() must be exclusive.
+    uint32_t deadline32 = static_cast<uint32_t>(deadlineUs);
+    bool armed = false;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        int32_t delta = static_cast<int32_t>(deadline32 - hiresClockRead32());
+        if (delta >= ALARM_MIN_DELAY_US) {
+            NRF_TIMER4->INTENCLR = TIMER_INTENCLR_COMPARE4_Msk;
+            NRF_TIMER4->CC[4] = deadline32;
+            NRF_TIMER4->EVENTS_COMPARE[4] = 0;
+            NRF_TIMER4->INTENSET = TIMER_INTENSET_COMPARE4_Msk;
+            armed = true;
+        }
+        PLATFORM_CRITICAL_EXIT();
+    }
+    return armed;
+}
+
+void hiresClockAlarmCancel() {
+    NRF_TIMER4->INTENCLR = TIMER_INTENCLR_COMPARE4_Msk;
+    NRF_TIMER4->EVENTS_COMPARE[4] = 0;
+}
+
 #elif defined(BOARD_PENTABUZZER_ESP32S3) && !defined(NATIVE_TEST_BUILD)
 
 // esp_timer is a free-running 64-bit 1MHz counter, always available - no
@@ -89,17 +159,97 @@ uint32_t hiresClockRead32() {
 // getMicros()'s overflow tracking handles the wrap.
 
 #include "esp_timer.h"
+#include "esp_attr.h"
+#include "driver/gptimer.h"
 
 bool hiresClockBegin() { return true; }
 bool hiresClockIsRunning() { return true; }
 void hiresClockEnsureHfclk() {}  // nRF-only HFXO watchdog; nothing to re-assert
 uint32_t hiresClockRead32() { return (uint32_t)esp_timer_get_time(); }
 
+// Deadline alarm: a free-running 1MHz GPTimer whose count is re-zeroed on
+// every arm, so the alarm value is simply the remaining delay. esp_timer
+// callbacks are dispatched from a task, which would add scheduler jitter.
+static gptimer_handle_t s_alarmTimer = nullptr;
+static volatile HiresAlarmCallback s_alarmCallback = nullptr;
+
+// Deadlines closer than this are not armed (set_raw_count + set_alarm_action
+// take a few microseconds; the caller spins instead)
+static constexpr int32_t ALARM_MIN_DELAY_US = 10;
+
+static bool IRAM_ATTR onAlarmIsr(gptimer_handle_t timer,
+                                 const gptimer_alarm_event_data_t* edata,
+                                 void* userCtx) {
+    (void)timer;
+    (void)edata;
+    (void)userCtx;
+    HiresAlarmCallback cb = s_alarmCallback;
+    return (cb != nullptr) && cb();
+}
+
+bool hiresClockAlarmBegin(HiresAlarmCallback callback) {
+    if (callback == nullptr) {
+        return false;
+    }
+    if (s_alarmTimer != nullptr) {
+        s_alarmCallback = callback;
+        return true;
+    }
+
+    gptimer_config_t timerConfig = {};
+    timerConfig.clk_src = GPTIMER_CLK_SRC_DEFAULT;
+    timerConfig.direction = GPTIMER_COUNT_UP;
+    timerConfig.resolution_hz = 1000000;  // 1 tick = 1us
+    if (gptimer_new_timer(&timerConfig, &s_alarmTimer) != ESP_OK) {
+        s_alarmTimer = nullptr;
+        return false;
+    }
+
+    gptimer_event_callbacks_t callbacks = {};
+    callbacks.on_alarm = onAlarmIsr;
+    if (gptimer_register_event_callbacks(s_alarmTimer, &callbacks, nullptr) != ESP_OK ||
+        gptimer_enable(s_alarmTimer) != ESP_OK ||
+        gptimer_start(s_alarmTimer) != ESP_OK) {
+        gptimer_del_timer(s_alarmTimer);
+        s_alarmTimer = nullptr;
+        return false;
+    }
+
+    s_alarmCallback = callback;
+    return true;
+}
+
+bool hiresClockAlarmArm(uint64_t deadlineUs) {
+    if (s_alarmTimer == nullptr) {
+        return false;
+    }
+
+    int32_t delta = static_cast<int32_t>(static_cast<uint32_t>(deadlineUs) - hiresClockRead32());
+    if (delta < ALARM_MIN_DELAY_US) {
+        return false;
+    }
+
+    gptimer_alarm_config_t alarmConfig = {};
+    alarmConfig.alarm_count = static_cast<uint64_t>(delta);
+    alarmConfig.flags.auto_reload_on_alarm = false;
+    gptimer_set_raw_count(s_alarmTimer, 0);
+    return gptimer_set_alarm_action(s_alarmTimer, &alarmConfig) == ESP_OK;
+}
+
+void hiresClockAlarmCancel() {
+    if (s_alarmTimer != nullptr) {
+        gptimer_set_alarm_action(s_alarmTimer, nullptr);
+    }
+}
+
 #else  // Native test build: inert stubs; getMicros() keeps using mocked micros()
 
 bool hiresClockBegin() { return false; }
 bool hiresClockIsRunning() { return false; }
 void hiresClockEnsureHfclk() {}
 uint32_t hiresClockRead32() { return 0; }
+bool hiresClockAlarmBegin(HiresAlarmCallback) { return false; }
+bool hiresClockAlarmArm(uint64_t) { return false; }
+void hiresClockAlarmCancel() {}
 
 #endif
@@ -0,0 +1,54 @@
+/**
+ * @file late_event_policy.cpp
+ * @brief Late motor event policy - Implementation
+ */
+
+#include "late_event_policy.h"
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+LateEventPolicy::LateEventPolicy(LateEventAction action, uint32_t thresholdUs, uint8_t resyncRun) :
+    _action(action),
+    _thresholdUs(thresholdUs),
+    _resyncRun(resyncRun),
+    _lateRun(0),
+    _resyncPending(false)
+{
+}
+
+// =============================================================================
+// POLICY
+// =============================================================================
+
+LateEventAction LateEventPolicy::decide(uint32_t latenessUs, bool activation) {
+    if (!activation) {
+        return LateEventAction::EXECUTE;
+    }
+    if (!isLate(latenessUs)) {
+        _lateRun = 0;
+        return LateEventAction::EXECUTE;
+    }
+
+    _lateRun++;
+    if (_resyncRun > 0 && _lateRun >= _resyncRun) {
+        _resyncPending = true;
+        _lateRun = 0;
+    }
+    return _action;
+}
+
+bool LateEventPolicy::takeResyncRequest() {
+    if (!_resyncPending) {
+        return false;
+    }
+    _resyncPending = false;
+    return true;
+}
+
+void LateEventPolicy::reset() {
+    // Races only with decide() restarting the same run: harmless
+    _lateRun = 0;
+    _resyncPending = false;
+}
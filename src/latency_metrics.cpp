@@ -1,7 +1,7 @@
 /**
  * @file latency_metrics.cpp
  * @brief Latency measurement and reporting implementation
- * @version 1.0.0
+ * @version 1.1.0
  */
 
 #include "latency_metrics.h"
@@ -10,6 +10,110 @@
 // Global instance
 LatencyMetrics latencyMetrics;
 
+// =============================================================================
+// LOG-LINEAR HISTOGRAM
+// =============================================================================
+
+void LatencyHistogram::reset() {
+    memset(counts, 0, sizeof(counts));
+    total = 0;
+}
+
+uint16_t LatencyHistogram::magnitudeBucket(uint32_t magnitude) {
+    if (magnitude < SUB_COUNT) {
+        return static_cast<uint16_t>(magnitude);  // Exact below the first octave
+    }
+    uint8_t msb = static_cast<uint8_t>(31 - __builtin_clz(magnitude));
+    if (msb >= MAX_BITS) {
+        return SIDE_BUCKETS - 1;  // Out of range: clamp into the last bucket
+    }
+    uint8_t shift = static_cast<uint8_t>(msb - SUB_BITS);
+    return static_cast<uint16_t>((shift + 1) * SUB_COUNT + ((magnitude >> shift) - SUB_COUNT));
+}
+
+uint32_t LatencyHistogram::bucketLowerBound(uint16_t bucket) {
+    uint16_t octave = bucket / SUB_COUNT;
+    uint16_t sub = bucket % SUB_COUNT;
+    if (octave == 0) {
+        return sub;
+    }
+    return static_cast<uint32_t>(SUB_COUNT + sub) << (octave - 1);
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(uint16_t bucket) {
+    uint16_t octave = bucket / SUB_COUNT;
+    if (octave == 0) {
+        return bucket;
+    }
+    return bucketLowerBound(bucket) + (1u << (octave - 1)) - 1;
+}
+
+void LatencyHistogram::record(int32_t value) {
+    uint16_t index;
+    if (value < 0) {
+        uint32_t magnitude = static_cast<uint32_t>(-static_cast<int64_t>(value));
+        index = static_cast<uint16_t>(SIDE_BUCKETS - 1 - magnitudeBucket(magnitude));
+    } else {
+        index = static_cast<uint16_t>(SIDE_BUCKETS + magnitudeBucket(static_cast<uint32_t>(value)));
+    }
+
+    if (counts[index] == UINT16_MAX) {
+        // Halve everything rather than saturate one bucket: long sessions
+        // keep valid percentiles, recent samples weigh slightly more
+        total = 0;
+        for (uint16_t i = 0; i < BUCKETS; i++) {
+            counts[i] >>= 1;
+            total += counts[i];
+        }
+    }
+    counts[index]++;
+    total++;
+}
+
+int32_t LatencyHistogram::percentile(uint16_t permille) const {
+    return percentileOf(this, 1, 1, permille);
+}
+
+uint32_t LatencyHistogram::totalOf(const LatencyHistogram* first, uint8_t count, uint8_t stride) {
+    uint32_t sum = 0;
+    for (uint8_t h = 0; h < count; h++) {
+        sum += first[h * stride].total;
+    }
+    return sum;
+}
+
+int32_t LatencyHistogram::percentileOf(const LatencyHistogram* first, uint8_t count,
+                                       uint8_t stride, uint16_t permille) {
+    uint32_t sum = totalOf(first, count, stride);
+    if (sum == 0) {
+        return 0;
+    }
+    if (permille > 1000) {
+        permille = 1000;
+    }
+
+    // Rank of the requested sample (1-based, rounded up)
+    uint32_t rank = static_cast<uint32_t>((static_cast<uint64_t>(sum) * permille + 999) / 1000);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint32_t cumulative = 0;
+    for (uint16_t i = 0; i < BUCKETS; i++) {
+        for (uint8_t h = 0; h < count; h++) {
+            cumulative += first[h * stride].counts[i];
+        }
+        if (cumulative >= rank) {
+            if (i >= SIDE_BUCKETS) {
+                return static_cast<int32_t>(bucketUpperBound(i - SIDE_BUCKETS));
+            }
+            // Negative side: the upper edge is the smallest magnitude
+            return -static_cast<int32_t>(bucketLowerBound(SIDE_BUCKETS - 1 - i));
+        }
+    }
+    return static_cast<int32_t>(bucketUpperBound(SIDE_BUCKETS - 1));
+}
+
 // =============================================================================
 // RESET AND STATE MANAGEMENT
 // =============================================================================
@@ -41,6 +145,34 @@ void LatencyMetrics::reset() {
     syncMaxRtt_us = 0;
     syncRttSpread_us = 0;
     calculatedOffset_us = 0;
+
+    // Distributions
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        for (uint8_t type = 0; type < 2; type++) {
+            for (uint8_t path = 0; path < 2; path++) {
+                driftHist[f][type][path].reset();
+            }
+        }
+    }
+    rttHist.reset();
+    offsetErrorHist.reset();
+
+    // Bilateral skew
+    skewHist.reset();
+    absSkewHist.reset();
+    totalAbsSkew_us = 0;
+    maxAbsSkew_us = 0;
+    skewSampleCount = 0;
+
+    resetLateEvents();
+}
+
+void LatencyMetrics::resetLateEvents() {
+    lateEventCount = 0;
+    droppedEventCount = 0;
+    shiftedEventCount = 0;
+    maxLateness_us = 0;
+    resyncRequestCount = 0;
 }
 
 void LatencyMetrics::enable(bool verbose) {
@@ -97,9 +229,34 @@ void LatencyMetrics::recordExecution(int32_t drift_us) {
     }
 }
 
+void LatencyMetrics::recordExecution(int32_t drift_us, uint8_t finger, bool activate, bool fastPath) {
+    if (!enabled) return;
+
+    if (finger < MAX_ACTUATORS) {
+        driftHist[finger][activate ? EVENT_ACTIVATE : EVENT_DEACTIVATE]
+                 [fastPath ? PATH_FAST : PATH_SLOW].record(drift_us);
+    }
+    recordExecution(drift_us);
+}
+
+void LatencyMetrics::recordLateEvent(uint32_t lateness_us, bool dropped, bool shifted) {
+    // Not gated on enabled: these are session outcomes, not sampled metrics
+    lateEventCount++;
+    if (dropped) droppedEventCount++;
+    if (shifted) shiftedEventCount++;
+    if (lateness_us > maxLateness_us) maxLateness_us = lateness_us;
+
+    if (verboseLogging) {
+        Serial.printf("[LATENCY] Late event: %lu us%s\n", (unsigned long)lateness_us,
+                      dropped ? " (dropped)" : (shifted ? " (shifted)" : ""));
+    }
+}
+
 void LatencyMetrics::recordRtt(uint32_t rtt_us) {
     if (!enabled) return;
 
+    rttHist.record(rtt_us > INT32_MAX ? INT32_MAX : static_cast<int32_t>(rtt_us));
+
     lastRtt_us = rtt_us;
     totalRtt_us += rtt_us;
     rttSampleCount++;
@@ -130,6 +287,26 @@ void LatencyMetrics::recordSyncProbe(uint32_t rtt_us) {
     }
 }
 
+void LatencyMetrics::recordOffsetError(int32_t error_us) {
+    if (!enabled) return;
+
+    offsetErrorHist.record(error_us);
+}
+
+void LatencyMetrics::recordSkew(int32_t skew_us) {
+    if (!enabled) return;
+
+    uint32_t magnitude = (skew_us < 0) ? static_cast<uint32_t>(-static_cast<int64_t>(skew_us))
+                                       : static_cast<uint32_t>(skew_us);
+    skewHist.record(skew_us);
+    absSkewHist.record(static_cast<int32_t>(magnitude > INT32_MAX ? INT32_MAX : magnitude));
+    totalAbsSkew_us += magnitude;
+    if (magnitude > maxAbsSkew_us) {
+        maxAbsSkew_us = magnitude;
+    }
+    skewSampleCount++;
+}
+
 void LatencyMetrics::finalizeSyncProbing(int64_t offset_us) {
     calculatedOffset_us = offset_us;
 
@@ -167,6 +344,10 @@ uint32_t LatencyMetrics::getJitter() const {
     return (uint32_t)(maxDrift_us - minDrift_us);
 }
 
+int32_t LatencyMetrics::getDriftPercentile(uint16_t permille) const {
+    return LatencyHistogram::percentileOf(&driftHist[0][0][0], MAX_ACTUATORS * 4, 1, permille);
+}
+
 const char* LatencyMetrics::getSyncConfidence() const {
     // Confidence based on RTT spread during sync probing
     // Lower spread = more stable BLE = better sync confidence
@@ -185,6 +366,22 @@ const char* LatencyMetrics::getSyncConfidence() const {
 // REPORTING
 // =============================================================================
 
+/**
+ * @brief Print one "label n=... p50 / p90 / p99 / p99.9" line (skipped if empty)
+ */
+static void printPercentiles(const char* label, const LatencyHistogram* first,
+                             uint8_t count, uint8_t stride) {
+    uint32_t n = LatencyHistogram::totalOf(first, count, stride);
+    if (n == 0) {
+        return;
+    }
+    Serial.printf("  %-14s n=%-6lu %+ld / %+ld / %+ld / %+ld\n", label, (unsigned long)n,
+                  (long)LatencyHistogram::percentileOf(first, count, stride, 500),
+                  (long)LatencyHistogram::percentileOf(first, count, stride, 900),
+                  (long)LatencyHistogram::percentileOf(first, count, stride, 990),
+                  (long)LatencyHistogram::percentileOf(first, count, stride, 999));
+}
+
 void LatencyMetrics::printReport() const {
     Serial.println(F(""));
     Serial.println(F("========== LATENCY METRICS =========="));
@@ -240,12 +437,49 @@ void LatencyMetrics::printReport() const {
             Serial.printf("  Early (<0):  %lu (unexpected)\n",
                           (unsigned long)earlyCount);
         }
+
+        // Percentiles: driftHist is [finger][type][path], so one finger's
+        // four histograms are contiguous and one type/path recurs every 4
+        static const char* const KIND_LABELS[2][2] = {
+            {"ACT slow", "ACT fast"}, {"DEACT slow", "DEACT fast"}
+        };
+        const LatencyHistogram* base = &driftHist[0][0][0];
+        Serial.println(F("  Percentiles (us, p50 / p90 / p99 / p99.9):"));
+        printPercentiles("all", base, MAX_ACTUATORS * 4, 1);
+        for (uint8_t type = 0; type < 2; type++) {
+            for (uint8_t path = 0; path < 2; path++) {
+                printPercentiles(KIND_LABELS[type][path], base + type * 2 + path, MAX_ACTUATORS, 4);
+            }
+        }
+        for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+            for (uint8_t type = 0; type < 2; type++) {
+                for (uint8_t path = 0; path < 2; path++) {
+                    char label[16];
+                    snprintf(label, sizeof(label), "F%u %s", f, KIND_LABELS[type][path]);
+                    printPercentiles(label, &driftHist[f][type][path], 1, 1);
+                }
+            }
+        }
     } else {
         Serial.println(F("  (no execution data)"));
     }
 
     Serial.println(F("-------------------------------------"));
 
+    // Late-event recovery section
+    Serial.printf("LATE EVENTS (>%lu us, this session):\n", (unsigned long)LATE_EVENT_THRESHOLD_US);
+    if (lateEventCount > 0) {
+        Serial.printf("  Late:     %lu (max %lu us)\n",
+                      (unsigned long)lateEventCount, (unsigned long)maxLateness_us);
+        Serial.printf("  Dropped:  %lu\n", (unsigned long)droppedEventCount);
+        Serial.printf("  Shifted:  %lu\n", (unsigned long)shiftedEventCount);
+        Serial.printf("  Resyncs:  %lu\n", (unsigned long)resyncRequestCount);
+    } else {
+        Serial.println(F("  (none)"));
+    }
+
+    Serial.println(F("-------------------------------------"));
+
     // Ongoing RTT section
     Serial.println(F("ONGOING RTT (PRIMARY only):"));
     if (rttSampleCount > 0) {
@@ -254,10 +488,25 @@ void LatencyMetrics::printReport() const {
         Serial.printf("  Min:     %lu us\n", (unsigned long)minRtt_us);
         Serial.printf("  Max:     %lu us\n", (unsigned long)maxRtt_us);
         Serial.printf("  Samples: %lu\n", (unsigned long)rttSampleCount);
+        Serial.println(F("  Percentiles (us, p50 / p90 / p99 / p99.9):"));
+        printPercentiles("rtt", &rttHist, 1, 1);
+        printPercentiles("offset error", &offsetErrorHist, 1, 1);
     } else {
         Serial.println(F("  (no RTT data)"));
     }
 
+    // Captured skew section (only when the capture rig produced samples)
+    if (skewSampleCount > 0) {
+        Serial.println(F("-------------------------------------"));
+        Serial.println(F("BILATERAL SKEW (captured, SECONDARY - PRIMARY):"));
+        Serial.printf("  Avg |skew|: %lu us\n", (unsigned long)(totalAbsSkew_us / skewSampleCount));
+        Serial.printf("  Max |skew|: %lu us\n", (unsigned long)maxAbsSkew_us);
+        Serial.printf("  P95 |skew|: %ld us\n", (long)absSkewHist.percentile(950));
+        Serial.printf("  Samples:    %lu\n", (unsigned long)skewSampleCount);
+        Serial.println(F("  Percentiles (us, p50 / p90 / p99 / p99.9):"));
+        printPercentiles("skew", &skewHist, 1, 1);
+    }
+
     Serial.println(F("====================================="));
     Serial.println(F(""));
 }
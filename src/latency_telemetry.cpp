@@ -0,0 +1,250 @@
+/**
+ * @file latency_telemetry.cpp
+ * @brief Batched binary latency telemetry stream - Implementation
+ * @version 1.0.0
+ */
+
+#include "latency_telemetry.h"
+#include "platform.h"
+#include <string.h>
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+LatencyTelemetry latencyTelemetry;
+
+// =============================================================================
+// SAMPLE RING
+// =============================================================================
+
+LatencyTelemetryRing::LatencyTelemetryRing() :
+    _buffer{},
+    _head(0),
+    _tail(0),
+    _dropped(0)
+{
+}
+
+bool LatencyTelemetryRing::push(const LatencyTelemetrySample& sample) {
+    // Memory barrier before reading consumer index (tail)
+    platformMemoryBarrier();
+
+    uint8_t currentHead = _head;
+    uint8_t nextHead = static_cast<uint8_t>((currentHead + 1) & (SIZE - 1));
+    if (nextHead == _tail) {
+        _dropped = static_cast<uint16_t>(_dropped + 1);
+        return false;
+    }
+
+    _buffer[currentHead] = sample;
+
+    // Publish data before advancing head
+    platformMemoryBarrier();
+    _head = nextHead;
+    return true;
+}
+
+bool LatencyTelemetryRing::peek(LatencyTelemetrySample& sample) const {
+    // Memory barrier before reading producer index (head)
+    platformMemoryBarrier();
+
+    uint8_t currentTail = _tail;
+    if (currentTail == _head) {
+        return false;
+    }
+    sample = _buffer[currentTail];
+    return true;
+}
+
+void LatencyTelemetryRing::pop() {
+    platformMemoryBarrier();
+
+    uint8_t currentTail = _tail;
+    if (currentTail == _head) {
+        return;
+    }
+    _tail = static_cast<uint8_t>((currentTail + 1) & (SIZE - 1));
+}
+
+uint8_t LatencyTelemetryRing::count() const {
+    platformMemoryBarrier();
+    return static_cast<uint8_t>((_head - _tail) & (SIZE - 1));
+}
+
+void LatencyTelemetryRing::clear() {
+    platformMemoryBarrier();
+    _tail = _head;
+}
+
+// =============================================================================
+// LATENCY TELEMETRY
+// =============================================================================
+
+LatencyTelemetry::LatencyTelemetry() :
+    _rings(),
+    _streaming(false),
+    _frameSeq(0),
+    _reportedDrops(0)
+{
+}
+
+void LatencyTelemetry::setStreaming(bool enabled) {
+    if (enabled && !_streaming) {
+        for (uint8_t r = 0; r < RING_COUNT; r++) {
+            _rings[r].clear();
+        }
+        _reportedDrops = totalDropped();
+    }
+    _streaming = enabled;
+}
+
+void LatencyTelemetry::push(Ring ring, LatencyTelemetryKind kind, uint8_t flags, int32_t value) {
+    if (!_streaming) {
+        return;
+    }
+    LatencyTelemetrySample sample;
+    sample.timeMs = millis();
+    sample.value = value;
+    sample.tag = static_cast<uint8_t>((static_cast<uint8_t>(kind) << 6) | flags);
+    _rings[ring].push(sample);
+}
+
+void LatencyTelemetry::recordExecution(int32_t drift_us, uint8_t finger, bool activate, bool fastPath) {
+    uint8_t flags = static_cast<uint8_t>(finger & TAG_FINGER_MASK);
+    if (activate) flags |= TAG_ACTIVATE;
+    if (fastPath) flags |= TAG_FAST_PATH;
+    push(RING_EXEC, LatencyTelemetryKind::DRIFT, flags, drift_us);
+}
+
+void LatencyTelemetry::recordRtt(uint32_t rtt_us) {
+    int32_t value = (rtt_us > static_cast<uint32_t>(INT32_MAX)) ? INT32_MAX : static_cast<int32_t>(rtt_us);
+    push(RING_SYNC, LatencyTelemetryKind::RTT, 0, value);
+}
+
+void LatencyTelemetry::recordOffsetError(int32_t error_us) {
+    push(RING_SYNC, LatencyTelemetryKind::OFFSET_ERROR, 0, error_us);
+}
+
+void LatencyTelemetry::recordSkew(int32_t skew_us) {
+#if SYNC_SKEW_CAPTURE_ENABLED
+    push(RING_SKEW, LatencyTelemetryKind::SKEW, 0, skew_us);
+#else
+    (void)skew_us;
+#endif
+}
+
+uint16_t LatencyTelemetry::pendingCount() const {
+    uint16_t pending = 0;
+    for (uint8_t r = 0; r < RING_COUNT; r++) {
+        pending = static_cast<uint16_t>(pending + _rings[r].count());
+    }
+    return pending;
+}
+
+uint16_t LatencyTelemetry::totalDropped() const {
+    uint16_t dropped = 0;
+    for (uint8_t r = 0; r < RING_COUNT; r++) {
+        dropped = static_cast<uint16_t>(dropped + _rings[r].dropped());
+    }
+    return dropped;
+}
+
+// =============================================================================
+// FRAME ENCODING (MAIN LOOP ONLY)
+// =============================================================================
+
+static void putLE16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+static void putLE32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+size_t LatencyTelemetry::encodeFrame(char* out, size_t outSize) {
+    static const char PREFIX[] = "LATS:";
+    static constexpr size_t PREFIX_LEN = sizeof(PREFIX) - 1;
+
+    if (out == nullptr || outSize < FRAME_TEXT_SIZE || pendingCount() == 0) {
+        return 0;
+    }
+
+    uint8_t frame[FRAME_MAX_BINARY];
+    uint8_t* cursor = frame + FRAME_HEADER_SIZE;
+    uint8_t count = 0;
+    uint32_t baseMs = 0;
+
+    while (count < FRAME_MAX_SAMPLES) {
+        // Oldest head across the rings (wrap-safe millis() comparison)
+        LatencyTelemetrySample sample;
+        int8_t oldest = -1;
+        for (uint8_t r = 0; r < RING_COUNT; r++) {
+            LatencyTelemetrySample head;
+            if (_rings[r].peek(head) &&
+                (oldest < 0 || static_cast<int32_t>(head.timeMs - sample.timeMs) < 0)) {
+                sample = head;
+                oldest = static_cast<int8_t>(r);
+            }
+        }
+        if (oldest < 0) {
+            break;
+        }
+        _rings[oldest].pop();
+
+        if (count == 0) {
+            baseMs = sample.timeMs;
+        }
+        uint32_t dt = sample.timeMs - baseMs;
+        if (dt > UINT16_MAX) dt = UINT16_MAX;
+
+        cursor[0] = sample.tag;
+        putLE16(cursor + 1, static_cast<uint16_t>(dt));
+        putLE32(cursor + 3, static_cast<uint32_t>(sample.value));
+        cursor += SAMPLE_WIRE_SIZE;
+        count++;
+    }
+
+    uint16_t totalDrops = totalDropped();
+    uint16_t newDrops = static_cast<uint16_t>(totalDrops - _reportedDrops);
+    _reportedDrops = totalDrops;
+
+    frame[0] = FRAME_VERSION;
+    putLE16(frame + 1, _frameSeq++);
+    putLE32(frame + 3, baseMs);
+    putLE16(frame + 7, newDrops);
+    frame[9] = count;
+
+    memcpy(out, PREFIX, PREFIX_LEN);
+    size_t encoded = base64Encode(frame, static_cast<size_t>(cursor - frame),
+                                  out + PREFIX_LEN, outSize - PREFIX_LEN);
+    return (encoded > 0) ? PREFIX_LEN + encoded : 0;
+}
+
+size_t LatencyTelemetry::base64Encode(const uint8_t* data, size_t length, char* out, size_t outSize) {
+    static const char ALPHABET[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    size_t needed = ((length + 2) / 3) * 4;
+    if (out == nullptr || outSize < needed + 1) {
+        return 0;
+    }
+
+    size_t o = 0;
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t chunk = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < length) chunk |= static_cast<uint32_t>(data[i + 1]) << 8;
+        if (i + 2 < length) chunk |= data[i + 2];
+
+        out[o++] = ALPHABET[(chunk >> 18) & 0x3F];
+        out[o++] = ALPHABET[(chunk >> 12) & 0x3F];
+        out[o++] = (i + 1 < length) ? ALPHABET[(chunk >> 6) & 0x3F] : '=';
+        out[o++] = (i + 2 < length) ? ALPHABET[chunk & 0x3F] : '=';
+    }
+    out[o] = '\0';
+    return o;
+}
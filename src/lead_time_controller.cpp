@@ -0,0 +1,137 @@
+/**
+ * @file lead_time_controller.cpp
+ * @brief Closed-loop MACROCYCLE lead time - Implementation
+ */
+
+#include "lead_time_controller.h"
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+LeadTimeController::LeadTimeController() :
+    _resetPending(false),
+    _ackHead(0),
+    _ackTail(0),
+    _droppedAcks(0)
+{
+    reset();
+}
+
+void LeadTimeController::reset() {
+    for (uint8_t i = 0; i < SYNC_SLACK_PENDING; i++) {
+        _sent[i].valid = false;
+    }
+    _next = 0;
+    _count = 0;
+    _lastSampleMs = 0;
+    _delayPercentileUs = 0;
+    _closedLoopLeadUs = 0;
+    _lastSlackUs = 0;
+    _lateCount = 0;
+    _unmatchedCount = 0;
+}
+
+// =============================================================================
+// FEEDBACK
+// =============================================================================
+
+void LeadTimeController::onSent(uint32_t sequenceId, uint32_t leadUs) {
+    SentLead& slot = _sent[sequenceId % SYNC_SLACK_PENDING];
+    slot.sequenceId = sequenceId;
+    slot.leadUs = leadUs;
+    slot.valid = true;
+}
+
+void LeadTimeController::onAck(uint32_t sequenceId, int32_t slackUs) {
+    uint8_t head = _ackHead.load(std::memory_order_relaxed);
+    uint8_t next = (uint8_t)((head + 1) % SYNC_SLACK_PENDING);
+    if (next == _ackTail.load(std::memory_order_acquire)) {
+        _droppedAcks.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    _acks[head].sequenceId = sequenceId;
+    _acks[head].slackUs = slackUs;
+    _ackHead.store(next, std::memory_order_release);
+}
+
+void LeadTimeController::update(uint32_t nowMs) {
+    if (_resetPending) {
+        _resetPending = false;
+        reset();
+        // ACKs queued before the reset belong to the old link
+        _ackTail.store(_ackHead.load(std::memory_order_acquire), std::memory_order_release);
+        return;
+    }
+
+    uint8_t tail = _ackTail.load(std::memory_order_relaxed);
+    uint8_t head = _ackHead.load(std::memory_order_acquire);
+    while (tail != head) {
+        AckSlack ack = _acks[tail];
+        tail = (uint8_t)((tail + 1) % SYNC_SLACK_PENDING);
+        _ackTail.store(tail, std::memory_order_release);
+
+        _lastSlackUs = ack.slackUs;
+        if (ack.slackUs < 0) {
+            _lateCount++;
+        }
+
+        SentLead& sent = _sent[ack.sequenceId % SYNC_SLACK_PENDING];
+        if (!sent.valid || sent.sequenceId != ack.sequenceId) {
+            _unmatchedCount++;
+            continue;
+        }
+        sent.valid = false;  // A retransmitted ACK must not count twice
+
+        int64_t delayUs = (int64_t)sent.leadUs - ack.slackUs;
+        addDelay(delayUs > 0 ? (uint32_t)(delayUs > UINT32_MAX ? UINT32_MAX : delayUs) : 0, nowMs);
+    }
+    _unmatchedCount += _droppedAcks.exchange(0, std::memory_order_relaxed);
+}
+
+void LeadTimeController::addDelay(uint32_t delayUs, uint32_t nowMs) {
+    _delays[_next] = delayUs;
+    _next = (uint8_t)((_next + 1) % SYNC_SLACK_WINDOW);
+    if (_count < SYNC_SLACK_WINDOW) {
+        _count++;
+    }
+    _lastSampleMs = nowMs;
+
+    // Percentile by insertion sort of a copy (window is a few dozen entries,
+    // once per macrocycle)
+    uint32_t sorted[SYNC_SLACK_WINDOW];
+    for (uint8_t i = 0; i < _count; i++) {
+        uint32_t value = _delays[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    uint8_t rank = (uint8_t)(((uint32_t)_count * SYNC_SLACK_PERCENTILE) / 100);
+    if (rank >= _count) {
+        rank = _count - 1;
+    }
+    _delayPercentileUs = sorted[rank];
+
+    uint64_t leadUs = (uint64_t)_delayPercentileUs + SYNC_SLACK_TARGET_US;
+    if (leadUs < SYNC_SLACK_MIN_LEAD_US) {
+        leadUs = SYNC_SLACK_MIN_LEAD_US;
+    } else if (leadUs > SYNC_MAX_LEAD_TIME_US) {
+        leadUs = SYNC_MAX_LEAD_TIME_US;
+    }
+    _closedLoopLeadUs = (uint32_t)leadUs;
+}
+
+// =============================================================================
+// LEAD TIME
+// =============================================================================
+
+bool LeadTimeController::active(uint32_t nowMs) const {
+    return _count >= SYNC_SLACK_MIN_SAMPLES && (nowMs - _lastSampleMs) <= SYNC_SLACK_STALE_MS;
+}
+
+uint32_t LeadTimeController::leadTimeUs(uint32_t openLoopUs, uint32_t nowMs) const {
+    return active(nowMs) ? _closedLoopLeadUs : openLoopUs;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file led_waveform.cpp
+ * @brief LED pattern waveforms - Implementation
+ */
+
+#include "led_waveform.h"
+
+namespace {
+
+// 255 * (0.1 + 0.9 * (1 - cos(2*pi*i/64)) / 2): starts at the 10% floor,
+// peaks half way through the cycle
+const uint8_t BREATHE_TABLE[LED_WAVEFORM_STEPS] = {
+     26,  26,  28,  30,  34,  39,  45,  52,  59,  67,  76,  86,  96, 107, 118, 129,
+    140, 151, 163, 174, 184, 194, 204, 213, 221, 229, 236, 241, 246, 250, 253, 254,
+    255, 254, 253, 250, 246, 241, 236, 229, 221, 213, 204, 194, 184, 174, 163, 151,
+    140, 129, 118, 107,  96,  86,  76,  67,  59,  52,  45,  39,  34,  30,  28,  26,
+};
+
+// DOUBLE_BLINK: two 150ms blinks, then a 650ms pause
+constexpr uint32_t DOUBLE_BLINK_ON_MS = 150;
+constexpr uint32_t DOUBLE_BLINK_SECOND_MS = 300;
+constexpr uint32_t DOUBLE_BLINK_CYCLE_MS = 1250;
+
+uint32_t sampleTable(uint32_t cycleMs, uint32_t elapsedMs, uint8_t& level) {
+    uint32_t t = elapsedMs % cycleMs;
+    uint32_t step = (t * LED_WAVEFORM_STEPS) / cycleMs;
+    level = BREATHE_TABLE[step];
+    // First ms of the next step: ceil((step + 1) * cycle / STEPS)
+    uint32_t nextMs = ((step + 1) * cycleMs + LED_WAVEFORM_STEPS - 1) / LED_WAVEFORM_STEPS;
+    return nextMs - t;
+}
+
+uint32_t sampleBlink(uint32_t onMs, uint32_t offMs, uint32_t elapsedMs, uint8_t& level) {
+    uint32_t t = elapsedMs % (onMs + offMs);
+    if (t < onMs) {
+        level = LED_LEVEL_FULL;
+        return onMs - t;
+    }
+    level = 0;
+    return onMs + offMs - t;
+}
+
+uint32_t sampleDoubleBlink(uint32_t elapsedMs, uint8_t& level) {
+    uint32_t t = elapsedMs % DOUBLE_BLINK_CYCLE_MS;
+    if (t < DOUBLE_BLINK_ON_MS) {
+        level = LED_LEVEL_FULL;
+        return DOUBLE_BLINK_ON_MS - t;
+    }
+    if (t < DOUBLE_BLINK_SECOND_MS) {
+        level = 0;
+        return DOUBLE_BLINK_SECOND_MS - t;
+    }
+    if (t < DOUBLE_BLINK_SECOND_MS + DOUBLE_BLINK_ON_MS) {
+        level = LED_LEVEL_FULL;
+        return DOUBLE_BLINK_SECOND_MS + DOUBLE_BLINK_ON_MS - t;
+    }
+    level = 0;
+    return DOUBLE_BLINK_CYCLE_MS - t;
+}
+
+}  // namespace
+
+uint32_t ledWaveformSample(LEDPattern pattern, uint32_t elapsedMs, uint8_t& level) {
+    switch (pattern) {
+        case LEDPattern::BREATHE_SLOW:
+            return sampleTable(LED_BREATHE_SLOW_MS, elapsedMs, level);
+        case LEDPattern::PULSE_SLOW:
+            return sampleTable(LED_PULSE_SLOW_MS, elapsedMs, level);
+        case LEDPattern::BLINK_FAST:
+            return sampleBlink(LED_BLINK_FAST_ON_MS, LED_BLINK_FAST_OFF_MS, elapsedMs, level);
+        case LEDPattern::BLINK_SLOW:
+            return sampleBlink(LED_BLINK_SLOW_ON_MS, LED_BLINK_SLOW_OFF_MS, elapsedMs, level);
+        case LEDPattern::BLINK_URGENT:
+            return sampleBlink(LED_BLINK_URGENT_ON_MS, LED_BLINK_URGENT_OFF_MS, elapsedMs, level);
+        case LEDPattern::BLINK_CONNECT:
+            return sampleBlink(LED_BLINK_CONNECT_ON_MS, LED_BLINK_CONNECT_OFF_MS, elapsedMs, level);
+        case LEDPattern::DOUBLE_BLINK:
+            return sampleDoubleBlink(elapsedMs, level);
+        case LEDPattern::OFF:
+            level = 0;
+            return 0;
+        case LEDPattern::SOLID:
+        default:
+            level = LED_LEVEL_FULL;
+            return 0;
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * @file loop_wake.cpp
+ * @brief Wake set for the event-driven main loop - Implementation
+ */
+
+#include "loop_wake.h"
+#include "platform.h"
+
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+#include "esp_attr.h"
+#define LOOP_WAKE_ISR_ATTR IRAM_ATTR  // Called from the power-switch GPIO ISR
+#else
+#define LOOP_WAKE_ISR_ATTR
+#endif
+
+LoopWake loopWake;
+
+void LoopWake::begin() {
+    _task = xTaskGetCurrentTaskHandle();
+}
+
+void LoopWake::notify(uint32_t events) {
+    TaskHandle_t task = static_cast<TaskHandle_t>(_task);
+    if (task != nullptr) {
+        xTaskNotify(task, events, eSetBits);
+    }
+}
+
+void LOOP_WAKE_ISR_ATTR LoopWake::notifyFromIsr(uint32_t events) {
+    TaskHandle_t task = static_cast<TaskHandle_t>(_task);
+    if (task != nullptr) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        xTaskNotifyFromISR(task, events, eSetBits, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
+
+uint32_t LoopWake::wait(uint32_t timeoutMs) {
+    uint32_t events = 0;
+    if (xTaskNotifyWait(0, UINT32_MAX, &events, pdMS_TO_TICKS(timeoutMs)) == pdTRUE) {
+        _eventWakes++;
+        return events;
+    }
+    _timeoutWakes++;
+    return 0;
+}
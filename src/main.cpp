@@ -30,11 +30,30 @@
 #include "menu_controller.h"
 #include "profile_manager.h"
 #include "latency_metrics.h"
+#include "latency_telemetry.h"
 #include "deferred_queue.h"
 #include "activation_queue.h"
 #include "motor_event_buffer.h"
 #include "hires_clock.h"
 #include "radio_anchor.h"
+#include "haptic_i2c_engine.h"
+#include "ping_scheduler.h"
+#include "skew_calibration.h"
+#include "loop_wake.h"
+#include "soft_timers.h"
+#include "command_table.h"
+#include "session_journal.h"
+#include "perf_profile.h"
+#include "skew_capture.h"
+#include "secondary_peers.h"
+#include "schedule_broadcast.h"
+#include "memory_report.h"
+#include "preselect_planner.h"
+#include "motor_health.h"
+#include "status_snapshot.h"
+#include "lead_time_controller.h"
+#include "late_event_policy.h"
+#include "phy_manager.h"
 
 // =============================================================================
 // CONFIGURATION
@@ -59,6 +78,17 @@ TherapyStateMachine stateMachine;
 MenuController menu;
 ProfileManager profiles;
 SimpleSyncProtocol syncProtocol;
+ConnParamController connParams;
+PingScheduler pingScheduler;
+#if SYNC_SLACK_FEEDBACK_ENABLED
+LeadTimeController leadTimeController;
+#endif
+#if BLE_PHY_AUTO_ENABLED
+PhyManager phyManager;
+#endif
+#if SYNC_SKEW_CAL_ENABLED
+SkewCalibrationStore skewCal;
+#endif
 
 // =============================================================================
 // STATE VARIABLES
@@ -68,10 +98,28 @@ DeviceRole deviceRole = DeviceRole::PRIMARY;
 bool hardwareReady = false;
 bool bleReady = false;
 
+// Last periodic battery reading (setup(), onBatteryTimer()): the status
+// snapshot publishes this instead of reading the battery every pass
+static BatteryStatus g_batteryStatus;
+
 // Timing
-uint32_t lastBatteryCheck = 0;
 uint32_t lastKeepalive = 0;        // Time of last keepalive PING sent (PRIMARY)
-uint32_t lastStatusPrint = 0;
+uint32_t lastTelemetryFrame = 0;  // LATENCY_STREAM frame pacing
+
+// loop()'s millis() timers. Armed from any context through armLoopTimer()/
+// stopLoopTimer() (critical section); callbacks run in loop() only.
+static SoftTimers loopTimers;
+static SoftTimerId g_statusTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_batteryTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_hfclkTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_latencyReportTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_debugFlashTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_connectionLostTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_bootWindowTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_autoStartRetryTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_journalTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_settingsTimer = SOFT_TIMER_NONE;
+static SoftTimerId g_ledTimer = SOFT_TIMER_NONE;
 
 // Connection state
 bool wasConnected = false;
@@ -87,9 +135,7 @@ volatile bool bootWindowActive = false;   // Whether we're waiting for phone
 bool autoStartTriggered = false; // Prevent repeated auto-starts (only accessed from main loop)
 
 // Sync validity delayed start (PRIMARY only)
-// If sync not valid when auto-start triggers, retry after 1 second
-bool autoStartScheduled = false;   // Whether we're waiting to retry auto-start
-uint32_t autoStartTime = 0;        // When to retry auto-start (millis)
+// If sync not valid when auto-start triggers, retry after 1 second (g_autoStartRetryTimer)
 uint8_t g_autoStartRetryCount = 0; // Auto-start sync retry counter (reset on SECONDARY disconnect)
 
 // Keepalive monitoring (bidirectional via PING/PONG)
@@ -108,13 +154,77 @@ volatile uint64_t pingStartTime = 0; // Timestamp when PING was sent (micros)
 volatile uint64_t pingT1 = 0;        // T1 for PTP offset calculation
 volatile uint32_t pingSeq = 0;       // Sequence id of the in-flight PING (32-bit: naturally atomic on Cortex-M4)
 
+// MACROCYCLE wire format negotiated with the SECONDARY (PRIMARY only).
+// Written in BLE callback (MC_VER / connect / disconnect), read in main loop.
+// Stays V5 until the SECONDARY announces a newer version after IDENTIFY.
+static volatile uint8_t g_secondaryMcWireVersion = MACROCYCLE_WIRE_V5;
+
+// Pipelined macrocycle streaming agreed for the current PRIMARY<->SECONDARY
+// link (MACROCYCLE_CAP_PIPELINE). Written in BLE callback (MC_VER / connect /
+// disconnect), read in main loop. While set, a new macrocycle is appended to
+// the activation queue instead of replacing it.
+static volatile bool g_mcPipelineActive = false;
+
+// V7 macrocycle delta encoding (PRIMARY side). Template, history and the
+// sent flag are owned by the main loop (onSendMacrocycle). The BLE callback
+// only publishes the newest ACK and requests a reset on connect/disconnect.
+static MacrocycleTemplate g_mcTxTemplate;
+static MacrocycleReferenceHistory g_mcTxHistory;
+static bool g_mcTxTemplateSent = false;
+static uint32_t g_mcTxTemplateFirstSeq = 0;
+static volatile uint32_t g_mcTxLastAckedSeq = 0;
+static volatile bool g_mcTxAckValid = false;
+static volatile bool g_mcTxResetPending = false;
+
+// V7 macrocycle delta decoding (SECONDARY side, BLE callback only)
+static MacrocycleTemplate g_mcRxTemplate;
+static bool g_mcRxTemplateValid = false;
+static MacrocycleReferenceHistory g_mcRxHistory;
+
+#if SYNC_PERIODIC_ADV_ENABLED
+// Schedule broadcast (SECONDARY, BLE callback only): the train's clock offset,
+// and the newest macrocycle staged from either the train or GATT so the
+// slower copy of a cycle is not scheduled twice
+static ScheduleAnchorTracker g_scheduleTracker;
+static bool g_mcRxStagedValid = false;
+static uint32_t g_mcRxStagedSeq = 0;
+#endif
+
+// Seeded macrocycles agreed for the link (MACROCYCLE_CAP_SEEDED, V7 only).
+// Same ownership as g_mcPipelineActive.
+static volatile bool g_mcSeededActive = false;
+
+// PRIMARY: last session params sent (main loop only)
+static bool g_mcTxSessionSent = false;
+static SeededSessionParams g_mcTxSession;
+
+// SECONDARY: the session plan is compiled and written by the BLE callback
+// only, once per SESSION frame. The coast state is shared with the main loop
+// and only touched inside PLATFORM_CRITICAL_ENTER/EXIT (see claimSeededTick /
+// coastSeededMacrocycle).
+static SchedulePlan g_mcRxPlan;
+static volatile bool g_mcRxSessionValid = false;
+struct SeededCoastState {
+    bool seqValid;              // lastSeq holds the newest cycle scheduled
+    bool armed;                 // nextLocalBaseUs is a chained baseTime to coast into
+    uint8_t coasted;            // Cycles played without a tick since the last one
+    uint32_t lastSeq;
+    uint64_t nextLocalBaseUs;   // SECONDARY clock
+};
+static SeededCoastState g_seededCoast = {};
+
+// Compile-time check: the configured depth must fit in the activation queue
+static_assert(MACROCYCLE_PIPELINE_DEPTH >= 1 && MACROCYCLE_PIPELINE_DEPTH <= MACROCYCLE_PIPELINE_MAX_DEPTH,
+              "MACROCYCLE_PIPELINE_DEPTH out of range");
+static_assert(MACROCYCLE_PIPELINE_DEPTH * 2 * MACROCYCLE_MAX_EVENTS <= ActivationQueue::MAX_EVENTS,
+              "ActivationQueue too small for MACROCYCLE_PIPELINE_DEPTH");
+
 // SP-C5 fix: Use binary semaphore instead of volatile bool to prevent missed signals
 // Old pattern had race: callback sets true, loop reads+clears, callback sets again, signal lost
 SemaphoreHandle_t safetyShutdownSema = nullptr;
 
 // Debug flash state (synchronized LED flash at macrocycle start)
 bool debugFlashActive = false;
-uint32_t debugFlashEndTime = 0;
 RGBColor savedLedColor;
 LEDPattern savedLedPattern = LEDPattern::SOLID;
 
@@ -123,14 +233,27 @@ LEDPattern savedLedPattern = LEDPattern::SOLID;
 static volatile bool g_pendingFlashActive = false;
 static volatile uint64_t g_pendingFlashTime = 0;
 
-// PHY change detection (SECONDARY only - resets RTT statistics on PHY upgrade)
+// PHY change detection (nRF52 event - RTT statistics follow the PHY)
 // Written in BLE event callback context, read in main loop
 static volatile bool g_phyChangeDetected = false;
 static volatile uint8_t g_newPhy = 0;  // 1=1M, 2=2M, 4=Coded
 
-// When CONNECTION_LOST was entered (set in onStateChange, which can run in
-// BLE-callback context; consumed by loop() to demote to IDLE after timeout)
-static volatile uint32_t g_connectionLostAt = 0;
+#if BLE_PHY_AUTO_ENABLED
+// Sync link PHY and the RTT-derived state cached per PHY (loop task).
+// g_phyLinkUp is set by the connect callback: a new link starts over.
+static volatile bool g_phyLinkUp = false;
+static BlePhy g_linkPhy = BlePhy::PHY_1M;
+static SimpleSyncProtocol::LinkStats g_phyLinkStats[BLE_PHY_COUNT];
+static uint32_t g_phyLeadUs[BLE_PHY_COUNT] = {};  // Closed-loop lead last used on each PHY
+#endif
+
+#if SYNC_SKEW_CAL_ENABLED
+// SECONDARY identity address (PRIMARY: skew calibration key, captured on connect)
+static uint8_t g_secondaryAddr[SKEW_CAL_ADDR_LEN] = {};
+static volatile bool g_secondaryAddrValid = false;
+// Set on SECONDARY disconnect; loop() records the final skew and saves
+static volatile bool g_skewCalFlushPending = false;
+#endif
 
 // Finger names for display, indexed by finger id (thumb only used at 5 actuators)
 const char *FINGER_NAMES[] = {"Index", "Middle", "Ring", "Pinky", "Thumb"};
@@ -155,6 +278,21 @@ static inline void atomicWrite64(volatile uint64_t* ptr, uint64_t val) {
     PLATFORM_CRITICAL_EXIT();
 }
 
+#if SESSION_JOURNAL_ENABLED
+/** @brief Saturate a signed microsecond value into a journal field */
+static inline int32_t journalClamp(int64_t value) {
+    if (value > INT32_MAX) return INT32_MAX;
+    if (value < INT32_MIN) return INT32_MIN;
+    return static_cast<int32_t>(value);
+}
+
+/** @brief Journal one executed activation (motor task or I2C worker) */
+static inline void journalActivation(uint8_t finger, uint8_t amplitude, uint64_t dueUs, int64_t driftUs) {
+    sessionJournal.record(JournalRecordType::EVENT, finger, amplitude,
+                          static_cast<int32_t>(dueUs), journalClamp(driftUs));
+}
+#endif
+
 // =============================================================================
 // FREERTOS MOTOR TASK
 // =============================================================================
@@ -164,24 +302,59 @@ static inline void atomicWrite64(volatile uint64_t* ptr, uint64_t val) {
 
 static TaskHandle_t motorTaskHandle = nullptr;
 
+#if MOTOR_TIMER_DISPATCH_ENABLED
+static volatile bool motorAlarmReady = false;  // Hardware-timer dispatch available
+
+/**
+ * @brief Deadline alarm ISR callback - wakes the motor task
+ */
+static bool onMotorDispatchAlarm() {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    if (motorTaskHandle != nullptr) {
+        vTaskNotifyGiveFromISR(motorTaskHandle, &xHigherPriorityTaskWoken);
+    }
+    return xHigherPriorityTaskWoken == pdTRUE;
+}
+#endif
+
+#if SYNC_DEBUG_GPIO_ENABLED
 /**
- * @brief Pre-select the next activation's I2C channel
+ * @brief Pulse the sync debug pin for an ACTIVATE
  *
- * Called after a DEACTIVATE to prepare for the next ACTIVATE.
- * This moves the mux selection and frequency setup OFF the critical path,
- * reducing activation latency from ~500μs to ~100μs.
+ * With SYNC_SKEW_CAPTURE_ENABLED a capturing SECONDARY also stages the
+ * edge's time for pairing with the PRIMARY's captured pulse.
  */
-static void preSelectNextActivation() {
-    MotorEvent nextEvent;
-    if (activationQueue.peekNextEvent(nextEvent) &&
-        nextEvent.type == MotorEventType::ACTIVATE &&
-        haptic.isEnabled(nextEvent.finger)) {
-        // Pre-select channel and set frequency (non-critical path)
-        if (haptic.selectChannelPersistent(nextEvent.finger)) {
-            haptic.setFrequencyDirect(nextEvent.finger, nextEvent.frequencyHz);
-        }
+static inline void toggleSyncDebugPin() {
+    digitalToggle(SYNC_DEBUG_GPIO_PIN);
+#if SYNC_SKEW_CAPTURE_ENABLED
+    if (skewCapture.isActive()) {
+        skewCapture.onLocalEdge(getMicros());
     }
+#endif
 }
+#endif
+
+#if SYNC_SKEW_CAPTURE_ENABLED
+/**
+ * @brief Pair staged skew-capture edges into the latency metrics (motor task)
+ *
+ * Called where the motor task has slack (idle queue or >2ms to the next event).
+ */
+static void serviceSkewCapture(uint64_t now) {
+    if (!skewCapture.isActive()) {
+        return;
+    }
+    int32_t skews[8];
+    uint8_t count;
+    do {
+        count = skewCapture.process(now, skews, 8);
+        for (uint8_t i = 0; i < count; i++) {
+            latencyMetrics.recordSkew(skews[i]);
+            latencyTelemetry.recordSkew(skews[i]);
+        }
+    } while (count == 8);
+}
+#endif
 
 /**
  * @brief Execute a motor event (activation or deactivation)
@@ -189,12 +362,14 @@ static void preSelectNextActivation() {
  *
  * M1 fix: Captures lateness AFTER motor I2C operations for accurate timing.
  * H6 fix: Handles 64-bit lateness values correctly in printf.
- * Uses I2C pre-selection for faster activation when available.
+ * Uses I2C pre-selection for faster activation when available (the motor
+ * task pre-selects each activation PRESELECT_LEAD_US ahead).
  */
 static void executeMotorEvent(const MotorEvent& event) {
+    PERF_SCOPE(EXECUTE_MOTOR_EVENT);
 #if SYNC_DEBUG_GPIO_ENABLED
     if (event.type == MotorEventType::ACTIVATE) {
-        digitalToggle(SYNC_DEBUG_GPIO_PIN);
+        toggleSyncDebugPin();
     }
 #endif
     uint64_t beforeOp = getMicros();
@@ -221,8 +396,14 @@ static void executeMotorEvent(const MotorEvent& event) {
 
             // Record latency metrics (if enabled)
             if (latencyMetrics.enabled) {
-                latencyMetrics.recordExecution(static_cast<int32_t>(drift_us));
+                latencyMetrics.recordExecution(static_cast<int32_t>(drift_us), event.finger,
+                                               true, usedFastPath);
             }
+            latencyTelemetry.recordExecution(static_cast<int32_t>(drift_us), event.finger,
+                                             true, usedFastPath);
+#if SESSION_JOURNAL_ENABLED
+            journalActivation(event.finger, event.amplitude, event.timeUs, drift_us);
+#endif
 
             if (profiles.getDebugMode()) {
                 // H6 fix: Handle 64-bit lateness (split into seconds + microseconds if large)
@@ -252,8 +433,11 @@ static void executeMotorEvent(const MotorEvent& event) {
         // Note: Deactivation timing is less critical than activation for bilateral sync,
         // but we record it for completeness and to track overall timing precision
         if (latencyMetrics.enabled) {
-            latencyMetrics.recordExecution(static_cast<int32_t>(drift_us));
+            latencyMetrics.recordExecution(static_cast<int32_t>(drift_us), event.finger,
+                                           false, false);
         }
+        latencyTelemetry.recordExecution(static_cast<int32_t>(drift_us), event.finger,
+                                         false, false);
 
         if (profiles.getDebugMode()) {
             // H6 fix: Handle 64-bit drift
@@ -267,20 +451,440 @@ static void executeMotorEvent(const MotorEvent& event) {
                               static_cast<long>(drift_us % 1000000));
             }
         }
-
-        // Pre-select next activation's channel while we have time
-        // This moves mux selection OFF the critical path for the next ACTIVATE
-        preSelectNextActivation();
     }
     (void)beforeOp;  // Suppress unused warning if debug mode off
 }
 
+#if MOTOR_BATCH_WINDOW_US > 0
+// One activation + one deactivation per motor fits a single burst
+static constexpr uint8_t MOTOR_BATCH_MAX_EVENTS = MAX_ACTUATORS * 2;
+
+/**
+ * @brief Execute a cluster of motor events as one I2C burst
+ * @param events Dequeued events in time order
+ * @param count Number of events (>= 2)
+ *
+ * Same metrics and debug output as executeMotorEvent(); drift is captured
+ * once after the burst, so events later in the cluster may report small
+ * negative drift (fired up to MOTOR_BATCH_WINDOW_US early).
+ */
+static void executeMotorBatch(const MotorEvent* events, uint8_t count) {
+    HapticBatchOp ops[MOTOR_BATCH_MAX_EVENTS];
+    for (uint8_t i = 0; i < count; i++) {
+        bool isActivate = (events[i].type == MotorEventType::ACTIVATE);
+#if SYNC_DEBUG_GPIO_ENABLED
+        if (isActivate) {
+            toggleSyncDebugPin();
+        }
+#endif
+        ops[i].finger = events[i].finger;
+        ops[i].amplitude = isActivate ? events[i].amplitude : 0;
+        ops[i].frequencyHz = isActivate ? events[i].frequencyHz : 0;
+    }
+
+    haptic.applyBatch(ops, count);
+
+    // Capture time AFTER I2C ops for true lateness (same as M1 fix)
+    uint64_t afterOp = getMicros();
+    for (uint8_t i = 0; i < count; i++) {
+        const MotorEvent& event = events[i];
+        bool isActivate = (event.type == MotorEventType::ACTIVATE);
+        if (isActivate && !haptic.isEnabled(event.finger)) {
+            continue;
+        }
+        int64_t drift_us = static_cast<int64_t>(afterOp - event.timeUs);
+
+        // A burst always re-selects the mux, so it counts as the slow path
+        if (latencyMetrics.enabled) {
+            latencyMetrics.recordExecution(static_cast<int32_t>(drift_us), event.finger,
+                                           isActivate, false);
+        }
+        latencyTelemetry.recordExecution(static_cast<int32_t>(drift_us), event.finger,
+                                         isActivate, false);
+#if SESSION_JOURNAL_ENABLED
+        if (isActivate) {
+            journalActivation(event.finger, event.amplitude, event.timeUs, drift_us);
+        }
+#endif
+
+        if (profiles.getDebugMode()) {
+            if (isActivate) {
+                Serial.printf("[MOTOR_TASK] ACTIVATE F%d A%d @%dHz (drift: %ldus) [BATCH %u]\n",
+                              event.finger, event.amplitude, event.frequencyHz,
+                              static_cast<long>(drift_us), count);
+            } else {
+                Serial.printf("[MOTOR_TASK] DEACTIVATE F%d (drift: %ldus) [BATCH %u]\n",
+                              event.finger, static_cast<long>(drift_us), count);
+            }
+        }
+    }
+}
+#endif
+
+#if HAPTIC_ASYNC_I2C_ENABLED
+// Channel the I2C worker will have pre-selected once every submitted command
+// has executed. Only the motor task submits, so this shadow stays in order
+// with the worker without reading HapticController state across tasks.
+static int8_t asyncPreSelectedFinger = -1;
+
+/**
+ * @brief Queue one haptic bus command for the I2C worker
+ */
+static void submitHapticCommand(HapticI2CCommandType type, uint8_t finger,
+                                uint8_t amplitude = 0, uint16_t frequencyHz = 0,
+                                uint64_t dueUs = 0, bool notify = false,
+                                bool fastPath = false) {
+    HapticI2CCommand cmd;
+    cmd.dueUs = dueUs;
+    cmd.type = type;
+    cmd.finger = finger;
+    cmd.amplitude = amplitude;
+    cmd.notify = notify;
+    cmd.fastPath = fastPath;
+    cmd.frequencyHz = frequencyHz;
+    if (!hapticI2CEngine.submit(cmd)) {
+        Serial.printf("[MOTOR_TASK] WARNING: haptic I2C ring full - dropped cmd %u F%d\n",
+                      static_cast<unsigned>(type), finger);
+    }
+}
+
+/**
+ * @brief Queue pre-selection (channel + frequency) of an upcoming activation
+ */
+static void submitPreSelect(uint8_t finger, uint16_t frequencyHz) {
+    submitHapticCommand(HapticI2CCommandType::SELECT_CHANNEL, finger);
+    submitHapticCommand(HapticI2CCommandType::WRITE_FREQUENCY, finger, 0, frequencyHz);
+    asyncPreSelectedFinger = static_cast<int8_t>(finger);
+}
+
+/**
+ * @brief I2C worker completion callback - drift metrics + debug output
+ *
+ * Runs in the worker task; drift is measured after the RTP write, matching
+ * the synchronous path (M1 fix).
+ */
+static void onHapticI2CComplete(const HapticI2CCommand& cmd, Result result, uint64_t completedUs) {
+    if (result != Result::OK) {
+        return;
+    }
+    int64_t drift_us = static_cast<int64_t>(completedUs - cmd.dueUs);
+
+    if (latencyMetrics.enabled) {
+        latencyMetrics.recordExecution(static_cast<int32_t>(drift_us), cmd.finger,
+                                       cmd.amplitude > 0, cmd.fastPath);
+    }
+    latencyTelemetry.recordExecution(static_cast<int32_t>(drift_us), cmd.finger,
+                                     cmd.amplitude > 0, cmd.fastPath);
+#if SESSION_JOURNAL_ENABLED
+    if (cmd.amplitude > 0) {
+        journalActivation(cmd.finger, cmd.amplitude, cmd.dueUs, drift_us);
+    }
+#endif
+
+    if (profiles.getDebugMode()) {
+        if (cmd.amplitude > 0) {
+            Serial.printf("[MOTOR_TASK] ACTIVATE F%d A%d (drift: %ldus) [ASYNC]\n",
+                          cmd.finger, cmd.amplitude, static_cast<long>(drift_us));
+        } else {
+            Serial.printf("[MOTOR_TASK] DEACTIVATE F%d (drift: %ldus) [ASYNC]\n",
+                          cmd.finger, static_cast<long>(drift_us));
+        }
+    }
+}
+
+/**
+ * @brief Execute a motor event by queuing its bus commands (returns immediately)
+ *
+ * Mirrors executeMotorEvent(): activations use the pre-selected fast path
+ * when available.
+ */
+static void executeMotorEventAsync(const MotorEvent& event) {
+    if (!haptic.isEnabled(event.finger)) {
+        return;
+    }
+
+    if (event.type == MotorEventType::ACTIVATE) {
+#if SYNC_DEBUG_GPIO_ENABLED
+        toggleSyncDebugPin();
+#endif
+        bool fastPath = (asyncPreSelectedFinger == static_cast<int8_t>(event.finger));
+        if (!fastPath) {
+            submitPreSelect(event.finger, event.frequencyHz);
+        }
+        submitHapticCommand(HapticI2CCommandType::WRITE_RTP, event.finger,
+                            event.amplitude, 0, event.timeUs, true, fastPath);
+        submitHapticCommand(HapticI2CCommandType::CLOSE_CHANNELS, 0);
+        asyncPreSelectedFinger = -1;
+        return;
+    }
+
+    submitHapticCommand(HapticI2CCommandType::SELECT_CHANNEL, event.finger);
+    submitHapticCommand(HapticI2CCommandType::WRITE_RTP, event.finger, 0, 0, event.timeUs, true);
+    submitHapticCommand(HapticI2CCommandType::CLOSE_CHANNELS, 0);
+    asyncPreSelectedFinger = -1;
+}
+#endif
+
+// =============================================================================
+// LOOK-AHEAD PRE-SELECTION (preselect_planner.h)
+// =============================================================================
+
+// Queue revision the current plan was built from (motor task only)
+static uint32_t g_plannedQueueRevision = 0;
+
+/**
+ * @brief Planner feed for ActivationQueue::forEachEvent()
+ */
+static void addEventToPlan(const MotorEvent& event) {
+    if (!haptic.isEnabled(event.finger)) {
+        return;  // No bus traffic for a disabled motor
+    }
+    preselectPlanner.add(event.timeUs, event.finger,
+                         event.type == MotorEventType::ACTIVATE, event.frequencyHz);
+}
+
+/**
+ * @brief Re-plan pre-selection over the whole queue if it changed
+ */
+static void planPreselection() {
+    uint32_t revision = activationQueue.revision();
+    if (revision == g_plannedQueueRevision) {
+        return;
+    }
+    g_plannedQueueRevision = revision;
+
+    uint32_t batchWindowUs = MOTOR_BATCH_WINDOW_US;
+#if HAPTIC_ASYNC_I2C_ENABLED
+    if (hapticI2CEngine.isRunning()) {
+        batchWindowUs = 0;  // Worker takes events one at a time
+    }
+#endif
+    preselectPlanner.begin(getMicros(), batchWindowUs);
+    activationQueue.forEachEvent(addEventToPlan);
+    preselectPlanner.finish();
+}
+
+/**
+ * @brief Check whether an upcoming event is an activation not yet pre-selected
+ */
+static bool needsPreselect(const MotorEvent& event) {
+    if (event.type != MotorEventType::ACTIVATE || !haptic.isEnabled(event.finger)) {
+        return false;
+    }
+    int8_t finger = static_cast<int8_t>(event.finger);
+#if HAPTIC_ASYNC_I2C_ENABLED
+    if (hapticI2CEngine.isRunning()) {
+        return asyncPreSelectedFinger != finger;
+    }
+#endif
+    return haptic.getPreSelectedFinger() != finger;
+}
+
+/**
+ * @brief Pre-select an activation's I2C channel and frequency
+ *
+ * Moves the mux selection and frequency setup OFF the critical path,
+ * reducing activation latency from ~500us to ~100us.
+ */
+static void preSelectActivation(const MotorEvent& event) {
+#if HAPTIC_ASYNC_I2C_ENABLED
+    if (hapticI2CEngine.isRunning()) {
+        submitPreSelect(event.finger, event.frequencyHz);
+        return;
+    }
+#endif
+    if (haptic.selectChannelPersistent(event.finger)) {
+        haptic.setFrequencyDirect(event.finger, event.frequencyHz);
+    }
+}
+
+/**
+ * @brief Write a staged frequency ahead of an activation that cannot be pre-selected
+ */
+static void writeStagedFrequency(uint8_t finger, uint16_t frequencyHz) {
+#if HAPTIC_ASYNC_I2C_ENABLED
+    if (hapticI2CEngine.isRunning()) {
+        submitHapticCommand(HapticI2CCommandType::SELECT_CHANNEL, finger);
+        submitHapticCommand(HapticI2CCommandType::WRITE_FREQUENCY, finger, 0, frequencyHz);
+        submitHapticCommand(HapticI2CCommandType::CLOSE_CHANNELS, 0);
+        asyncPreSelectedFinger = -1;
+        return;
+    }
+#endif
+    haptic.setFrequency(finger, frequencyHz);  // Skips the bus if unchanged
+}
+
+#if MOTOR_HEALTH_MONITOR_ENABLED
+// =============================================================================
+// MOTOR HEALTH SLICES (motor_health.h)
+// =============================================================================
+
+// Health slice already taken in the current gap (cleared by every dispatch)
+static bool g_healthSliceTaken = false;
+// Next idle-queue slice (motor task only)
+static uint64_t g_healthIdleDueUs = 0;
+
+/**
+ * @brief Run one health slice if it fits the budget (motor task)
+ * @param budgetUs Time available before the next motor deadline
+ * @return true if a slice ran
+ */
+static bool serviceHealthSlice(uint32_t budgetUs) {
+    MotorHealthSlice slice;
+    if (!motorHealth.nextSlice(budgetUs, slice)) {
+        return false;
+    }
+
+    uint8_t failedBefore = motorHealth.failedMask();
+    uint64_t startUs = getMicros();
+    if (slice.heal) {
+        bool healed = haptic.healFinger(slice.finger);
+        motorHealth.recordHeal(slice.finger, healed);
+#if SESSION_JOURNAL_ENABLED
+        if (healed) {
+            sessionJournal.record(JournalRecordType::HEAL, 1, 0, 0, 0);
+        }
+#endif
+    } else {
+        uint8_t value;
+        if (haptic.readHealthRegister(slice.finger, MotorHealthMonitor::registerOf(slice.check), value)) {
+            motorHealth.recordRead(slice.finger, slice.check, value);
+        } else {
+            motorHealth.recordBusy();
+        }
+    }
+    motorHealth.recordSliceTime(slice, static_cast<uint32_t>(getMicros() - startUs));
+
+    if (motorHealth.failedMask() != failedBefore) {
+        loopWake.notify(LOOP_WAKE_HEALTH);  // loop() re-maps patterns
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief Dequeue and execute the due event plus any that fall within the batch window
+ * @param dueTimeUs Time of the earliest due event (as peeked by the motor task)
+ */
+static void dispatchDueEvents(uint64_t dueTimeUs) {
+#if MOTOR_HEALTH_MONITOR_ENABLED
+    g_healthSliceTaken = false;  // The next gap gets its own slice
+#endif
+#if HAPTIC_ASYNC_I2C_ENABLED
+    if (hapticI2CEngine.isRunning()) {
+        // Clustered events are submitted back-to-back; the worker walks them
+        // without the motor task waiting on the bus
+        MotorEvent event;
+        if (activationQueue.dequeueNextEvent(event)) {
+            executeMotorEventAsync(event);
+        }
+        return;
+    }
+#endif
+#if MOTOR_BATCH_WINDOW_US > 0
+    MotorEvent batch[MOTOR_BATCH_MAX_EVENTS];
+    uint8_t count = activationQueue.dequeueDueEvents(dueTimeUs + MOTOR_BATCH_WINDOW_US,
+                                                     batch, MOTOR_BATCH_MAX_EVENTS);
+    if (count == 1) {
+        executeMotorEvent(batch[0]);
+    } else if (count > 1) {
+        executeMotorBatch(batch, count);
+    }
+#else
+    (void)dueTimeUs;
+    MotorEvent event;
+    if (activationQueue.dequeueNextEvent(event)) {
+        executeMotorEvent(event);
+    }
+#endif
+}
+
+// =============================================================================
+// LATE EVENTS (late_event_policy.h)
+// =============================================================================
+
+static LateEventPolicy latePolicy;
+
+/**
+ * @brief Handle a head event whose time has already passed (motor task)
+ *
+ * Within LATE_EVENT_THRESHOLD_US it runs now as before. Beyond it, an
+ * activation is dropped with its deactivation or shifts the whole pending
+ * schedule (LATE_EVENT_POLICY); deactivations always run.
+ */
+static void handleOverdueEvent(const MotorEvent& event, uint64_t nowUs) {
+    uint64_t overdueUs = nowUs - event.timeUs;
+    uint32_t latenessUs = overdueUs > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(overdueUs);
+    LateEventAction action = latePolicy.decide(latenessUs, event.type == MotorEventType::ACTIVATE);
+    if (latePolicy.isLate(latenessUs)) {
+        latencyMetrics.recordLateEvent(latenessUs, action == LateEventAction::DROP,
+                                       action == LateEventAction::SHIFT);
+    }
+    if (latePolicy.resyncPending()) {
+        loopWake.notify(LOOP_WAKE_LATE);  // loop() sends MC_RESYNC
+    }
+
+    if (action == LateEventAction::DROP) {
+        activationQueue.dropActivation(event);
+    } else if (action == LateEventAction::SHIFT) {
+        activationQueue.delayPending(latenessUs);  // Next pass finds it due now
+    } else {
+        dispatchDueEvents(event.timeUs);
+    }
+}
+
+#if FAST_BOOT_ENABLED
+// Deferred motor bring-up result, published by the motor task to loop()
+static volatile bool g_motorBringUpOk = false;
+static volatile bool g_motorBringUpDone = false;
+static bool bringUpMotors();
+static void finishMotorBringUp(bool motorsUp);
+#endif
+
+// Staged-event drain stats for the main loop's debug log (written by motor task)
+static volatile uint8_t g_stagedDrainCount = 0;
+static volatile bool g_stagedDrainMacrocycle = false;
+
+/**
+ * @brief TP-1: Move staged BLE events into the activation queue (motor task only)
+ *
+ * The motor task is the single consumer of motorEventBuffer, so a MACROCYCLE
+ * is schedulable as soon as the BLE callback's notify wakes it, without
+ * waiting for a main-loop iteration. A batch's first event carries
+ * replacesQueue: the queue is cleared right before it, exactly once even if
+ * the drain catches the producer mid-batch.
+ */
+static void drainStagedMotorEvents() {
+    StagedMotorEvent staged;
+    uint8_t drained = 0;
+    bool macrocycle = false;
+    while (motorEventBuffer.unstage(staged)) {
+        if (staged.replacesQueue) {
+            activationQueue.clear();  // Start fresh for macrocycle
+            macrocycle = true;
+        }
+        activationQueue.enqueue(staged.activateTimeUs, staged.finger, staged.amplitude,
+                                staged.durationMs, staged.frequencyHz);
+        drained++;
+        if (staged.isMacrocycleLast) {
+            macrocycle = true;
+        }
+    }
+    if (drained > 0) {
+        g_stagedDrainMacrocycle = macrocycle;
+        g_stagedDrainCount = drained;
+    }
+}
+
 /**
  * @brief High-priority motor task for event-driven activations/deactivations
  *
  * Runs at Priority 4 (HIGHEST) to preempt main loop (Priority 1).
- * Uses FreeRTOS timing for coarse delays, busy-wait for final precision.
- * Processes events from unified ActivationQueue.
+ * Uses FreeRTOS timing for coarse delays. With MOTOR_TIMER_DISPATCH_ENABLED,
+ * the final approach blocks on a hardware deadline alarm and only the last
+ * MOTOR_TIMER_DISPATCH_LEAD_US are busy-waited; otherwise the last ~1ms is.
+ * Processes events from unified ActivationQueue, which it also feeds from
+ * the lock-free staging buffer (drainStagedMotorEvents).
  *
  * Bug fixes applied:
  * - C5: Fixed integer underflow in time calculation
@@ -293,15 +897,64 @@ static void motorTask(void* pvParameters) {
     // TP-4: Wait for initialization signal before processing events
     // This ensures activationQueue.begin() has completed before we access the queue
     ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#if FAST_BOOT_ENABLED
+    // Fast boot: the drivers come up here while BLE is already connectable.
+    // Events staged meanwhile are overdue - drop them rather than fire them
+    // in one burst.
+    g_motorBringUpOk = bringUpMotors();
+    drainStagedMotorEvents();
+    activationQueue.clear();
+#if !BATTERY_SENSE_ADC
+    battery.startScheduledSampling();  // battery.begin() is skipped on fast boot
+#endif
+    g_motorBringUpDone = true;
+    loopWake.notify(LOOP_WAKE_MOTORS);
+#endif
     Serial.println(F("[MOTOR_TASK] Initialization complete, entering main loop"));
 
     for (;;) {
         MotorEvent event;
 
+        // Every wake-up (including the BLE callback's notify) picks up staged
+        // events; any queue change re-plans pre-selection over the schedule
+        drainStagedMotorEvents();
+        planPreselection();
+
         // Check if there are any events in the queue
         if (!activationQueue.peekNextEvent(event)) {
             // No events - block until notified of new event
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            TickType_t idleTicks = portMAX_DELAY;
+#if SYNC_SKEW_CAPTURE_ENABLED
+            serviceSkewCapture(getMicros());
+#endif
+#if VBAT_SCHEDULED_SAMPLING_ENABLED && !BATTERY_SENSE_ADC
+            // Nothing scheduled: the whole wait is an idle gap. Wake once
+            // per interval for the next sample.
+            if (battery.serviceScheduledSample(getMicros())) {
+                continue;
+            }
+            idleTicks = pdMS_TO_TICKS(VBAT_SAMPLE_INTERVAL_MS);
+#endif
+#if MOTOR_HEALTH_MONITOR_ENABLED
+            // Idle: one health slice per MOTOR_HEALTH_IDLE_INTERVAL_MS
+            uint64_t idleNowUs = getMicros();
+            if (idleNowUs >= g_healthIdleDueUs) {
+                g_healthIdleDueUs = idleNowUs + MOTOR_HEALTH_IDLE_INTERVAL_MS * 1000ULL;
+                if (serviceHealthSlice(UINT32_MAX)) {
+                    continue;
+                }
+            }
+            if (idleTicks > pdMS_TO_TICKS(MOTOR_HEALTH_IDLE_INTERVAL_MS)) {
+                idleTicks = pdMS_TO_TICKS(MOTOR_HEALTH_IDLE_INTERVAL_MS);
+            }
+#endif
+#if POWER_IDLE_SLEEP_ENABLED
+            power.setIdleSleepAllowed(true);
+            ulTaskNotifyTake(pdTRUE, idleTicks);
+            power.setIdleSleepAllowed(false);
+#else
+            ulTaskNotifyTake(pdTRUE, idleTicks);
+#endif
             continue;
         }
 
@@ -312,31 +965,96 @@ static void motorTask(void* pvParameters) {
         int64_t delayUs = static_cast<int64_t>(event.timeUs - now);
 
         if (delayUs <= 0) {
-            // Event time already passed - execute immediately
-            if (activationQueue.dequeueNextEvent(event)) {
-                executeMotorEvent(event);
-            }
+            // Event time already passed - execute, drop or shift it
+            handleOverdueEvent(event, now);
             continue;
         }
 
+#if VBAT_SCHEDULED_SAMPLING_ENABLED && !BATTERY_SENSE_ADC
+        // Known idle gap before the next deadline: take the battery sample
+        // here, where it cannot delay an activation. It closes the mux, so
+        // pre-selection below runs after it.
+        if (delayUs > VBAT_SAMPLE_MIN_GAP_US && battery.serviceScheduledSample(now)) {
+            continue;
+        }
+#endif
+
+#if SYNC_SKEW_CAPTURE_ENABLED
         if (delayUs > 2000) {
-            // Use the idle window to pre-select the upcoming activation's I2C
-            // channel + frequency. Covers the FIRST event of a macrocycle,
-            // which otherwise always takes the ~500us slow path (pre-selection
-            // normally only happens after a DEACTIVATE). All I2C stays in
-            // motor-task context.
-            if (event.type == MotorEventType::ACTIVATE &&
-                haptic.isEnabled(event.finger) &&
-                haptic.getPreSelectedFinger() != static_cast<int8_t>(event.finger)) {
-                if (haptic.selectChannelPersistent(event.finger)) {
-                    haptic.setFrequencyDirect(event.finger, event.frequencyHz);
-                }
+            serviceSkewCapture(now);
+        }
+#endif
+
+        // Frequency writes the planner moved into this gap for activations
+        // that cannot be pre-selected in their own (bursts, tight gaps)
+        uint8_t stagedFinger;
+        uint16_t stagedFrequencyHz;
+        if (preselectPlanner.takeStagedWrite(now, stagedFinger, stagedFrequencyHz)) {
+            writeStagedFrequency(stagedFinger, stagedFrequencyHz);
+            continue;  // Re-evaluate timing
+        }
+
+#if MOTOR_HEALTH_MONITOR_ENABLED
+        // One health readback per gap, only if its budget ends before the
+        // pre-select slot
+        if (!g_healthSliceTaken && event.timeUs > now + PRESELECT_LEAD_US) {
+            uint64_t gapUs = event.timeUs - PRESELECT_LEAD_US - now;
+            uint32_t budgetUs = gapUs > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(gapUs);
+            if (serviceHealthSlice(budgetUs)) {
+                g_healthSliceTaken = true;
+                continue;  // Re-evaluate timing
+            }
+        }
+#endif
+
+        // Just-in-time pre-selection: open the activation's channel and
+        // write its frequency PRESELECT_LEAD_US ahead, after the gap's other
+        // I2C work (VBAT above, deferred loop() work up to
+        // DEFERRED_MOTOR_GUARD_US), so it takes the [FAST] path. Until then
+        // the waits below target the pre-select slot, not the event. All I2C
+        // stays in motor-task context (or is queued to the I2C worker).
+        uint64_t waitUntilUs = event.timeUs;
+        if (needsPreselect(event)) {
+            if (!PreselectPlanner::preselectDue(now, event.timeUs)) {
+                waitUntilUs = event.timeUs - PRESELECT_LEAD_US;
+            } else if (PreselectPlanner::preselectFits(now, event.timeUs)) {
+                preSelectActivation(event);
                 continue;  // Re-evaluate timing - pre-selection took ~200-300us
             }
+        }
+        int64_t waitUs = static_cast<int64_t>(waitUntilUs - now);
+
+#if POWER_IDLE_SLEEP_ENABLED
+        // Long gap (e.g. the inter-burst relax): block with idle sleep allowed
+        // and wake POWER_IDLE_GUARD_MS early; the remaining approach (alarm +
+        // spin below) runs awake at full speed. An enqueue still wakes us.
+        uint32_t idleMs = PowerController::idleBudgetMs(now, event.timeUs);
+        if (idleMs > 0) {
+            power.setIdleSleepAllowed(true);
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(idleMs));
+            power.setIdleSleepAllowed(false);
+            continue;
+        }
+#endif
+
+#if MOTOR_TIMER_DISPATCH_ENABLED
+        // Block until the hardware alarm fires LEAD_US before the event or
+        // pre-select slot (or an enqueue notification wakes us for a possibly
+        // earlier event), then re-evaluate: the remaining <= LEAD_US is spun
+        // below. The tick timeout is a safety net against a lost alarm.
+        if (motorAlarmReady &&
+            waitUs > MOTOR_TIMER_DISPATCH_LEAD_US &&
+            waitUs <= MOTOR_TIMER_DISPATCH_MAX_US &&
+            hiresClockAlarmArm(waitUntilUs - MOTOR_TIMER_DISPATCH_LEAD_US)) {
+            ulTaskNotifyTake(pdTRUE, (TickType_t)(pdMS_TO_TICKS(waitUs / 1000) + 2));
+            continue;
+        }
+#endif
 
+        if (waitUs > 2000) {
             // Event is far away (>2ms) - use FreeRTOS sleep
-            // Sleep until 1ms before event, then busy-wait
-            TickType_t ticks = pdMS_TO_TICKS((delayUs - 1000) / 1000);
+            // Sleep until 1ms before event (or pre-select slot), then busy-wait
+            TickType_t ticks = pdMS_TO_TICKS((waitUs - 1000) / 1000);
             if (ticks > 0) {
                 // Wake early if new event is enqueued (may be earlier than current)
                 ulTaskNotifyTake(pdTRUE, ticks);
@@ -354,15 +1072,17 @@ static void motorTask(void* pvParameters) {
             continue;
         }
 
-        // Event is close (<2ms) - busy-wait for precision
-        while (getMicros() < event.timeUs) {
+        // Event is close (<2ms, or <= LEAD_US with timer dispatch) - busy-wait for precision
+        while (getMicros() < waitUntilUs) {
             taskYIELD();  // Allow other tasks to run briefly
         }
-
-        // Execute event - dequeue first to ensure we get the same event we peeked
-        if (activationQueue.dequeueNextEvent(event)) {
-            executeMotorEvent(event);
+        if (waitUntilUs != event.timeUs) {
+            continue;  // Reached the pre-select slot
         }
+
+        // Execute event (plus any others inside the batch window) - dequeue
+        // first to ensure we get the same event we peeked
+        dispatchDueEvents(event.timeUs);
     }
 }
 
@@ -376,6 +1096,7 @@ bool initializeHardware();
 bool initializeBLE();
 bool initializeTherapy();
 void printStatus();
+static void publishStatusSnapshot();
 void startTherapyTest();
 void stopTherapyTest();
 void autoStartTherapy();
@@ -386,9 +1107,23 @@ void sendPing();
 // BLE Callbacks
 void onBLEConnect(uint16_t connHandle, ConnectionType type);
 void onBLEDisconnect(uint16_t connHandle, ConnectionType type, uint8_t reason);
-void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp);
+void onBLEMessage(uint16_t connHandle, const char *message, size_t messageLen, uint64_t rxTimestamp);
 void onTxStamped(TxStampKind kind, uint32_t seqId, uint64_t txTimeUs);
 
+// Received macrocycle scheduling (SECONDARY)
+static bool stageReceivedMacrocycle(const Macrocycle& mc, uint64_t& localBaseTime);
+#if SYNC_PERIODIC_ADV_ENABLED
+static bool claimReceivedMacrocycle(uint32_t sequenceId);
+static void onScheduleBroadcast(const uint8_t* data, size_t length, uint64_t rxTimestamp);
+#endif
+
+#if BLE_MAX_SECONDARIES > 1
+// Extra SECONDARY peers (PRIMARY only)
+static void handleExtraPeerMessage(SecondaryPeer& peer, const char* message, size_t messageLen,
+                                   uint64_t rxTimestamp);
+static void fanOutMacrocycle(const Macrocycle& macrocycle);
+#endif
+
 // Therapy Callbacks
 void onSendMacrocycle(const Macrocycle& macrocycle);
 void onSetFrequency(uint8_t finger, uint16_t frequencyHz);
@@ -403,6 +1138,46 @@ void onStartScheduling();
 bool onIsSchedulingComplete();
 uint32_t onGetLeadTime();
 
+// Seeded macrocycle coasting (SECONDARY)
+static bool claimSeededTick(uint32_t sequenceId);
+static void armSeededCoast(uint64_t nextLocalBaseUs);
+static void disarmSeededCoast();
+static void coastSeededMacrocycle();
+
+#if POWER_IDLE_SLEEP_ENABLED
+static uint32_t loopWaitMs(uint32_t now);
+#endif
+
+// Deferred work runs ahead of the next motor event (DEFERRED_MOTOR_GUARD_US)
+static uint64_t deferredDeadlineUs();
+
+#if MOTOR_HEALTH_MONITOR_ENABLED
+// Health monitor dropped/restored a motor: re-map patterns (loop task)
+static void applyMotorHealthToTherapy();
+#endif
+
+// Late-event resync request (late_event_policy.h)
+static void serviceLateEventResync();
+
+#if BLE_PHY_AUTO_ENABLED
+// Sync link PHY tracking, per-PHY statistics and selection (phy_manager.h)
+static void servicePhy(uint32_t now);
+static void switchPhyStatistics(BlePhy phy, uint32_t now);
+static void clearPhyCache();
+#endif
+
+// loop() software timers (soft_timers.h)
+static void beginLoopTimers();
+static void armLoopTimer(SoftTimerId id, uint32_t delayMs, uint32_t periodMs = 0);
+static void stopLoopTimer(SoftTimerId id);
+static void serviceLoopTimers(uint32_t now);
+
+#if SYNC_SKEW_CAL_ENABLED
+// Persisted skew calibration (PRIMARY)
+static void seedSkewCalibration();
+static void updateSkewCalibration(uint32_t now);
+#endif
+
 // State Machine Callback
 void onStateChange(const StateTransition &transition);
 
@@ -515,6 +1290,82 @@ void safeMotorShutdown()
     haptic.emergencyStop();
 }
 
+// =============================================================================
+// MEMORY REPORT
+// =============================================================================
+
+/**
+ * @brief Register static footprints and watched tasks for MEMORY (setup())
+ *
+ * Runs on the loop task, so the current task handle is loop()'s. The motor
+ * task registers itself in startMotorTask(); the BLE host tasks belong to
+ * the stack and are found by name when the report is printed.
+ */
+static void registerMemoryReport()
+{
+    memoryReport.addRegion("BLEManager", sizeof(ble));
+    memoryReport.addRegion("MenuController", sizeof(menu));
+    memoryReport.addRegion("StatusSeqlock", sizeof(statusSnapshot));
+    memoryReport.addRegion("SimpleSyncProtocol", sizeof(syncProtocol));
+    memoryReport.addRegion("TherapyEngine", sizeof(therapy));
+    memoryReport.addRegion("ActivationQueue", sizeof(activationQueue));
+    memoryReport.addRegion("MotorEventBuffer", sizeof(motorEventBuffer));
+    memoryReport.addRegion("DeferredQueue", sizeof(deferredQueue));
+    memoryReport.addRegion("PreselectPlanner", sizeof(preselectPlanner));
+#if MOTOR_HEALTH_MONITOR_ENABLED
+    memoryReport.addRegion("MotorHealthMonitor", sizeof(motorHealth));
+#endif
+    memoryReport.addRegion("ProfileManager", sizeof(profiles));
+    memoryReport.addRegion("HapticController", sizeof(haptic));
+    memoryReport.addRegion("LatencyMetrics", sizeof(latencyMetrics));
+    memoryReport.addRegion("LatencyTelemetry", sizeof(latencyTelemetry));
+    memoryReport.addRegion("Macrocycle codec state",
+                           sizeof(g_mcTxTemplate) + sizeof(g_mcTxHistory) +
+                           sizeof(g_mcRxTemplate) + sizeof(g_mcRxHistory) + sizeof(g_mcRxPlan));
+    memoryReport.addRegion("Loop timers", sizeof(loopTimers));
+#if SESSION_JOURNAL_ENABLED
+    memoryReport.addRegion("SessionJournal", sizeof(sessionJournal));
+#endif
+#if SYNC_SKEW_CAL_ENABLED
+    memoryReport.addRegion("SkewCalibrationStore", sizeof(skewCal));
+#endif
+#if SYNC_SLACK_FEEDBACK_ENABLED
+    memoryReport.addRegion("LeadTimeController", sizeof(leadTimeController));
+#endif
+#if BLE_PHY_AUTO_ENABLED
+    memoryReport.addRegion("PhyManager + per-PHY cache",
+                           sizeof(phyManager) + sizeof(g_phyLinkStats) + sizeof(g_phyLeadUs));
+#endif
+#if SYNC_SKEW_CAPTURE_ENABLED
+    memoryReport.addRegion("SkewCapture", sizeof(skewCapture));
+#endif
+#if BLE_MAX_SECONDARIES > 1
+    memoryReport.addRegion("SecondaryPeerSet", sizeof(extraPeers));
+#endif
+#if SYNC_PERIODIC_ADV_ENABLED
+    memoryReport.addRegion("ScheduleAnchorTracker", sizeof(g_scheduleTracker));
+#endif
+#if PERF_PROFILE_ENABLED
+    memoryReport.addRegion("PerfProfile", sizeof(perfProfile));
+#endif
+
+    memoryReport.addTemporary("SyncCommand", sizeof(SyncCommand));
+    memoryReport.addTemporary("Macrocycle", sizeof(Macrocycle));
+
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+    memoryReport.addTask("loop", xTaskGetCurrentTaskHandle(), getArduinoLoopTaskStackSize());
+    memoryReport.addTask("nimble_host", nullptr, CONFIG_BT_NIMBLE_HOST_TASK_STACK_SIZE);
+    memoryReport.addTask("BleTx", nullptr, BLE_TX_TASK_STACK);
+#if HAPTIC_ASYNC_I2C_ENABLED
+    memoryReport.addTask("HapticI2C", nullptr, HAPTIC_I2C_TASK_STACK);
+#endif
+#else
+    // Loop and SoftDevice-event task stacks are sized inside the nRF52 core
+    memoryReport.addTask("loop", xTaskGetCurrentTaskHandle(), 0);
+    memoryReport.addTask("BLE", nullptr, 0);
+#endif
+}
+
 // =============================================================================
 // SETUP
 // =============================================================================
@@ -536,12 +1387,14 @@ void setup()
     pinMode(USER_BUTTON_PIN, INPUT_PULLUP);
 #endif
 
+#if !FAST_BOOT_ENABLED
     // Wait for serial with timeout
     uint32_t serialWaitStart = millis();
-    while (!Serial && (millis() - serialWaitStart < 3000))
+    while (!Serial && (millis() - serialWaitStart < BOOT_SERIAL_WAIT_MS))
     {
         delay(10);
     }
+#endif
 
     // Early debug - print immediately after serial ready
     Serial.printf("\n[BOOT] Serial ready at millis=%lu\n", (unsigned long)millis());
@@ -554,11 +1407,25 @@ void setup()
         Serial.println(F("[WARN] Failed to create safety semaphore - operating without ISR protection"));
     }
 
+#if PERF_PROFILE_ENABLED
+    // Before anything that runs an instrumented scope
+    perfProfile.begin();
+#endif
+
+    // setup() runs on the loop task: producers notify it from here on
+    loopWake.begin();
+    beginLoopTimers();
+    registerMemoryReport();
+
     printBanner();
 
     // Enable the board power path FIRST (Penta: peripheral 3V3 rail feeds the
     // LED, mux, and motor drivers; no-op on nRF)
     power.begin();
+#if POWER_IDLE_SLEEP_ENABLED
+    // Before the motor task exists: it owns the awake lock from its first wait
+    power.beginIdleSleep();
+#endif
 
     // Initialize LED FIRST (needed for configuration feedback)
     Serial.println(F("\n--- LED Initialization ---"));
@@ -572,6 +1439,16 @@ void setup()
     Serial.println(F("\n--- Profile Manager Initialization ---"));
     profiles.begin();
     Serial.printf("[PROFILE] Initialized with %d profiles\n", profiles.getProfileCount());
+#if SYNC_SKEW_CAL_ENABLED
+    if (skewCal.load())
+    {
+        Serial.printf("[SYNC] Skew calibration: %u peer(s), generation %u\n",
+                      skewCal.count(), skewCal.generation());
+    }
+#endif
+#if SESSION_JOURNAL_ENABLED
+    sessionJournal.begin();
+#endif
 
     // Check if device has a configured role
     if (!profiles.hasStoredRole())
@@ -585,7 +1462,9 @@ void setup()
     deviceRole = determineRole();
     Serial.printf("\n[ROLE] Device configured as: %s\n", deviceRoleToString(deviceRole));
 
+#if !FAST_BOOT_ENABLED
     delay(500);
+#endif
 
     // Initialize hardware
     Serial.println(F("\n--- Hardware Initialization ---"));
@@ -639,10 +1518,12 @@ void setup()
     menu.setDeviceInfo(deviceRole, FIRMWARE_VERSION, BLE_NAME);
     menu.setSendCallback(onMenuSendResponse);
     menu.setSendToSecondaryCallback(onMenuSendToSecondary);
+    menu.setStatusSnapshot(&statusSnapshot);
     Serial.println(F("[SUCCESS] Menu controller initialized"));
 
     // Initialize Deferred Queue (for ISR-safe callback operations)
     deferredQueue.setExecutor(executeDeferredWork);
+    deferredQueue.setWakeCallback([] { loopWake.notify(LOOP_WAKE_DEFERRED); });
     Serial.println(F("[SUCCESS] Deferred queue initialized"));
 
     // NOTE: Activation queue is initialized later in Hardware Init section
@@ -652,6 +1533,7 @@ void setup()
     Serial.println(F("\n--- Battery Status ---"));
 #if BATTERY_SENSE_ENABLED
     BatteryStatus battStatus = battery.getStatus();
+    g_batteryStatus = battStatus;
     Serial.printf("[BATTERY] %.2fV | %d%% | Status: %s\n",
                   battStatus.voltage, battStatus.percentage, battStatus.statusString());
 #else
@@ -708,42 +1590,41 @@ void loop()
     // Motor events (activations AND deactivations) handled by motor task
     // No polling needed - motor task uses FreeRTOS timing
 
-    // TP-1: Process staged motor events from BLE callbacks
-    // Forward from lock-free staging buffer to mutex-protected activationQueue
-    // Defensive check: only process if motor task is initialized
-    if (motorTaskHandle != nullptr && motorEventBuffer.hasPending()) {
-        // Check if this is a macrocycle batch (needs queue clear first)
-        bool isMacrocycleBatch = motorEventBuffer.isMacrocyclePending();
-        if (isMacrocycleBatch) {
-            activationQueue.clear();  // Start fresh for macrocycle
+    // TP-1: Staged motor events are drained by the motor task itself; only
+    // the debug log stays here (no Serial I/O in motor-task context)
+    if (g_stagedDrainCount > 0) {
+        uint8_t drained = g_stagedDrainCount;
+        g_stagedDrainCount = 0;
+        if (profiles.getDebugMode()) {
+            Serial.printf(g_stagedDrainMacrocycle ? "[MACROCYCLE] Drained %u staged events\n"
+                                                  : "[ACTIVATE] Drained %u staged event(s)\n",
+                          drained);
         }
+    }
 
-        uint8_t eventsForwarded = 0;
-        StagedMotorEvent staged;
-        while (motorEventBuffer.unstage(staged)) {
-            activationQueue.enqueue(staged.activateTimeUs, staged.finger, staged.amplitude,
-                                   staged.durationMs, staged.frequencyHz);
-            eventsForwarded++;
+    // SECONDARY: keep a seeded session playing through a late tick
+    coastSeededMacrocycle();
 
-            // If this was the last event in a macrocycle, start scheduling
-            if (staged.isMacrocycleLast) {
-                activationQueue.scheduleNext();
-                if (profiles.getDebugMode()) {
-                    Serial.printf("[MACROCYCLE] Forwarded %u events, scheduling started\n",
-                                  eventsForwarded);
-                }
-            }
-        }
+    // Process deferred work (haptic feedback from BLE callbacks first) in the
+    // gap before the next motor event
+    deferredQueue.processUntil(getMicros(), deferredDeadlineUs());
 
-        // For single ACTIVATE events (not macrocycle), log if debug enabled
-        if (!isMacrocycleBatch && eventsForwarded > 0 && profiles.getDebugMode()) {
-            Serial.printf("[ACTIVATE] Forwarded %u event(s) from staging buffer\n",
-                          eventsForwarded);
-        }
+#if FAST_BOOT_ENABLED
+    // Motor task finished the deferred bring-up: settings, LED and pattern
+    // follow-up belong to this task
+    if (g_motorBringUpDone)
+    {
+        g_motorBringUpDone = false;
+        finishMotorBringUp(g_motorBringUpOk);
     }
+#endif
 
-    // Process deferred work queue (haptic operations from BLE callbacks)
-    deferredQueue.processOne();
+#if MOTOR_HEALTH_MONITOR_ENABLED
+    applyMotorHealthToTherapy();
+#endif
+
+    // A macrocycle's worth of activations ran late: ask the PRIMARY to resync
+    serviceLateEventResync();
 
     // Process SECONDARY battery response in main loop context (thread-safe)
     menu.checkSecondaryBatteryResponse();
@@ -769,15 +1650,9 @@ void loop()
         }
     }
 
-    // Debug flash restoration check
-    if (debugFlashActive && now >= debugFlashEndTime)
-    {
-        debugFlashActive = false;
-        led.setPattern(savedLedColor, savedLedPattern);
-    }
-
-    // Update LED pattern animation
-    led.update();
+    // Expired timers: debug flash restore, connection-lost demotion, boot
+    // window, auto-start retry, status/battery/HFXO/latency reports
+    serviceLoopTimers(now);
 
     // Power-switch shutdown request (PentaBuzzer only; no-op on nRF)
     if (power.powerOffRequested())
@@ -789,7 +1664,12 @@ void loop()
     // Process BLE events (includes non-blocking TX queue)
     ble.update();
 
-    // Handle PHY change detection (SECONDARY only)
+#if BLE_PHY_AUTO_ENABLED
+    // Sync link PHY: swap RTT statistics to the new PHY's cache (both
+    // roles) and pick the PHY from retransmission proxies (PRIMARY)
+    servicePhy(now);
+#else
+    // Handle PHY change detection
     // When PHY upgrades from 1M to 2M, RTT changes significantly - reset statistics
     if (g_phyChangeDetected)
     {
@@ -801,6 +1681,10 @@ void loop()
 
         syncProtocol.resetLatency();
         syncProtocol.resetAsymmetryTracking();
+        pingScheduler.requestBurst();  // Re-measure RTT on the new PHY now
+#if SYNC_SLACK_FEEDBACK_ENABLED
+        leadTimeController.requestReset();  // Delivery delays changed with the PHY
+#endif
 
         // Reset clock sync if few samples collected during PHY transition
         // (samples before and after PHY change have inconsistent RTT)
@@ -809,8 +1693,35 @@ void loop()
         {
             syncProtocol.resetClockSync();
             Serial.println(F("[SYNC] Clock sync reset due to PHY transition"));
+#if SYNC_SKEW_CAL_ENABLED
+            seedSkewCalibration();
+#endif
         }
     }
+#endif
+
+#if BLE_CONN_PARAM_CONTROL_ENABLED
+    // Connection parameters follow therapy state. PRIMARY owns the session
+    // and the sync warm-up, so it drives both links; SECONDARY (central)
+    // accepts its requests.
+    if (deviceRole == DeviceRole::PRIMARY)
+    {
+        connParams.setSyncWarmup(ble.isSecondaryConnected() && !syncProtocol.isClockSyncValid());
+        connParams.setCharging(power.usbPowerPresent());
+        ConnParamProfile profile;
+        if (connParams.update(now, profile))
+        {
+            ble.applyConnParamProfile(profile);
+            // RTT moves with the interval: keep old samples out of the lead time
+            syncProtocol.resetLatency();
+            syncProtocol.resetAsymmetryTracking();
+#if BLE_PHY_AUTO_ENABLED
+            clearPhyCache();  // Every PHY's RTTs moved with it
+            phyManager.resetQuality();
+#endif
+        }
+    }
+#endif
 
     // Motor events handled by motor task - no polling needed
 
@@ -860,6 +1771,9 @@ void loop()
 
     // Update therapy engine (both roles - PRIMARY generates patterns for sync,
     // SECONDARY needs this for standalone hardware tests)
+    therapy.setMacrocyclePipelineDepth((deviceRole == DeviceRole::PRIMARY && g_mcPipelineActive)
+                                           ? MACROCYCLE_PIPELINE_DEPTH : 1);
+    therapy.setSeededGeneration(deviceRole == DeviceRole::PRIMARY && g_mcSeededActive);
     therapy.update();
 
     // Detect when therapy session ends (for resuming scanning on SECONDARY)
@@ -892,16 +1806,8 @@ void loop()
     }
     wasTherapyRunning = isTherapyRunning;
 
-    // Demote CONNECTION_LOST (purple blink) to IDLE (blue breathe) once the
-    // peer has been gone for CONNECTION_LOST_TIMEOUT_MS. Non-blocking
-    // replacement for the old 3x2s delay() retry loop; scanning/advertising
-    // keeps running and a reconnect from IDLE still lands in READY.
-    if (stateMachine.getCurrentState() == TherapyState::CONNECTION_LOST &&
-        millis() - g_connectionLostAt >= CONNECTION_LOST_TIMEOUT_MS)
-    {
-        Serial.println(F("[RECOVERY] No reconnect within timeout - returning to IDLE"));
-        stateMachine.transition(StateTrigger::RECONNECT_FAILED);
-    }
+    // One consistent status view per pass for status commands on other tasks
+    publishStatusSnapshot();
 
     // SECONDARY: Check for keepalive timeout during active connection
     if (deviceRole == DeviceRole::SECONDARY && ble.isPrimaryConnected())
@@ -941,53 +1847,37 @@ void loop()
             safeMotorShutdown();
             lastSecondaryKeepalive = 0; // Reset to prevent repeated triggers
         }
-    }
-
-    // PRIMARY: Check boot window for auto-start therapy
-    // SP-H1 fix: Capture bootWindowStart once atomically before comparison
-    // This prevents race where callback updates it between read and arithmetic
-    if (deviceRole == DeviceRole::PRIMARY && bootWindowActive && !autoStartTriggered)
-    {
-        uint32_t startSnapshot = bootWindowStart;  // SP-H1: Capture volatile once
-        uint32_t currentTime = millis();
-        uint32_t elapsed = currentTime - startSnapshot;
 
-        if (elapsed >= STARTUP_WINDOW_MS)
+#if BLE_MAX_SECONDARIES > 1
+        // A silent extra SECONDARY is dropped; the session carries on with the rest
+        for (uint8_t i = 0; i < extraPeers.count(); i++)
         {
-            // Boot window expired without phone connecting
-            if (ble.isSecondaryConnected() && !ble.isPhoneConnected())
-            {
-                Serial.printf("[BOOT] 30s window expired (now=%lu, start=%lu, elapsed=%lu) - auto-starting therapy\n",
-                              (unsigned long)currentTime, (unsigned long)startSnapshot, (unsigned long)elapsed);
-                bootWindowActive = false;
-                autoStartTriggered = true;
-                autoStartTherapy();
-            }
-            else
+            SecondaryPeer& peer = extraPeers.at(i);
+            if (!peer.retiring && nowMs - peer.lastPongMs > PRIMARY_KEEPALIVE_TIMEOUT_MS)
             {
-                // SECONDARY disconnected during window, cancel
-                Serial.printf("[BOOT] Window expired but SECONDARY not connected (now=%lu, start=%lu)\n",
-                              (unsigned long)currentTime, (unsigned long)startSnapshot);
-                bootWindowActive = false;
+                Serial.printf("[WARN] Extra SECONDARY %d keepalive timeout - disconnecting\n",
+                              peer.connHandle);
+                peer.retiring = true;
+                ble.disconnect(peer.connHandle);
             }
         }
+#endif
     }
 
-    // Check for scheduled auto-start retry (sync wasn't valid on first attempt)
-    if (autoStartScheduled && millis() >= autoStartTime)
-    {
-        autoStartScheduled = false;
-        autoStartTherapy();
-    }
-
-    // Periodic latency metrics reporting (when enabled and therapy running)
-    static uint32_t lastLatencyReport = 0;
-    if (latencyMetrics.enabled && therapy.isRunning())
+    // Binary latency stream to the phone (LATENCY_STREAM): lowest priority,
+    // one frame per interval and only while the TX queue is nearly idle
+    static_assert(LatencyTelemetry::FRAME_TEXT_SIZE <= BLE_TX_TELEMETRY_SLOT_BYTES,
+                  "LATS frame + EOT must fit a TELEMETRY slot");
+    if (latencyTelemetry.isStreaming() && now - lastTelemetryFrame >= LATENCY_STREAM_INTERVAL_MS)
     {
-        if (now - lastLatencyReport >= LATENCY_REPORT_INTERVAL_MS)
+        lastTelemetryFrame = now;
+        if (ble.isPhoneConnected() && ble.getTxQueueCount() <= LATENCY_STREAM_MAX_TX_BACKLOG)
         {
-            lastLatencyReport = now;
-            latencyMetrics.printReport();
+            char frame[LatencyTelemetry::FRAME_TEXT_SIZE];
+            if (latencyTelemetry.encodeFrame(frame, sizeof(frame)) > 0)
+            {
+                ble.sendToPhone(frame, TxPriority::TELEMETRY);
+            }
         }
     }
 
@@ -1001,47 +1891,372 @@ void loop()
         Serial.println(isConnected ? F("[STATE] Connected!") : F("[STATE] Disconnected"));
     }
 
-    // HFXO watchdog: the SoftDevice HFCLK request is a single shared flag and
-    // TinyUSB releases it on USB suspend - re-assert so TIMER4 stays accurate
-    static uint32_t lastClockCheck = 0;
-    if (now - lastClockCheck >= 1000)
+#if SYNC_ADAPTIVE_PING_ENABLED
+    // Unified keepalive + clock sync (PRIMARY only). Bursts after link-up and
+    // PHY change, then backs off from the 4Hz-therapy / 1Hz-idle base while
+    // the offset uncertainty stays low (never past the keepalive timeout).
+    if (deviceRole == DeviceRole::PRIMARY && isConnected &&
+        pingScheduler.update(now, syncProtocol.isClockSyncValid(),
+                             syncProtocol.getOffsetUncertaintyUs(), therapy.isRunning()))
+    {
+        lastKeepalive = now;
+        sendPing();
+    }
+#else
+    // Unified keepalive + clock sync (PRIMARY only). 4Hz during therapy for
+    // tighter drift tracking and more samples for the quality gates; 1Hz idle.
+    // More PINGs only strengthens keepalive semantics (timeouts unchanged).
+    uint32_t pingIntervalMs = therapy.isRunning() ? SYNC_ACTIVE_INTERVAL_MS : KEEPALIVE_INTERVAL_MS;
+    if (deviceRole == DeviceRole::PRIMARY &&
+        isConnected &&
+        (now - lastKeepalive >= pingIntervalMs))
+    {
+        lastKeepalive = now;
+        sendPing();
+    }
+#endif
+
+#if SYNC_SKEW_CAL_ENABLED
+    if (deviceRole == DeviceRole::PRIMARY)
+    {
+        updateSkewCalibration(now);
+    }
+#endif
+
+#if POWER_IDLE_SLEEP_ENABLED
+    // Block on the wake set until the nearest timer deadline instead of
+    // spinning, so the CPU idles between motor events. Producers (BLE
+    // callbacks, deferred queue, safety, power switch) end the wait early.
+    uint32_t waitMs = loopWaitMs(millis());
+    if (waitMs > 0)
+    {
+        (void)loopWake.wait(waitMs);
+        return;
+    }
+#endif
+
+    // Yield to BLE stack (non-blocking - allows SoftDevice processing)
+    yield();
+}
+
+#if POWER_IDLE_SLEEP_ENABLED
+/**
+ * @brief How long loop() may block before its next deadline
+ *
+ * 0 while loop-side work is ready (serial input, deferred work that fits
+ * before the next motor event, a PHY change, a due debug flash); deferred
+ * work that does not fit wakes loop() just after that event. Otherwise the
+ * nearest timer loop() owns, capped by the coarsest cadence it can't see:
+ * POWER_IDLE_LOOP_MS while a session, seeded coast or menu timer runs,
+ * LOOP_WAKE_MAX_MS when idle. LED frames are a loop timer of their own.
+ */
+static uint32_t loopWaitMs(uint32_t now)
+{
+    uint32_t capMs = LOOP_WAKE_MAX_MS;
+    if (therapy.isRunning() || stateMachine.getCurrentState() == TherapyState::RUNNING ||
+        menu.hasTimedWork())
+    {
+        capMs = POWER_IDLE_LOOP_MS;
+    }
+    LoopDeadline deadline(now, capMs);
+
+    if (Serial.available() || g_phyChangeDetected)
+    {
+        deadline.now();
+    }
+    // Deferred work waits out a motor event it does not fit in front of
+    if (deferredQueue.hasPending())
+    {
+        uint64_t nowUs = getMicros();
+        uint64_t workDeadlineUs = deferredDeadlineUs();
+        if (deferredQueue.nextFits(nowUs, workDeadlineUs))
+        {
+            deadline.now();
+        }
+        else
+        {
+            uint64_t eventUs = workDeadlineUs + DEFERRED_MOTOR_GUARD_US;
+            uint64_t waitMs = eventUs > nowUs ? (eventUs - nowUs) / 1000ULL : 0;
+            deadline.at(now + static_cast<uint32_t>(waitMs) + 1);
+        }
+    }
+    // nRF52 drains TX from update(); a TX-complete event wakes us sooner
+    if (ble.getTxQueueCount() > 0)
+    {
+        deadline.at(now + LOOP_WAKE_TX_RETRY_MS);
+    }
+
+    // PTP-scheduled flash: wake on the preceding ms, then spin to it
+    if (g_pendingFlashActive)
+    {
+        uint64_t nowUs = getMicros();
+        uint64_t flashUs = atomicRead64(&g_pendingFlashTime);
+        uint64_t leadMs = (flashUs > nowUs) ? (flashUs - nowUs) / 1000ULL : 0;
+        deadline.at(now + static_cast<uint32_t>(leadMs > 1 ? leadMs - 1 : 0));
+    }
+    if (deviceRole == DeviceRole::SECONDARY && ble.isPrimaryConnected() && lastKeepaliveReceived > 0)
+    {
+        deadline.every(lastKeepaliveReceived, KEEPALIVE_TIMEOUT_MS + 1);
+    }
+    if (deviceRole == DeviceRole::PRIMARY && ble.isSecondaryConnected())
+    {
+#if SYNC_ADAPTIVE_PING_ENABLED
+        deadline.at(pingScheduler.nextDueMs());
+#else
+        deadline.every(lastKeepalive, therapy.isRunning() ? SYNC_ACTIVE_INTERVAL_MS : KEEPALIVE_INTERVAL_MS);
+#endif
+    }
+    if (latencyTelemetry.isStreaming())
+    {
+        deadline.every(lastTelemetryFrame, LATENCY_STREAM_INTERVAL_MS);
+    }
+
+    // Everything on loopTimers: the list head is the nearest
+    uint32_t timerDueMs = 0;
+    bool timerArmed;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        timerArmed = loopTimers.nextDue(timerDueMs);
+        PLATFORM_CRITICAL_EXIT();
+    }
+    if (timerArmed)
+    {
+        deadline.at(timerDueMs);
+    }
+    return deadline.timeoutMs();
+}
+#endif
+
+// =============================================================================
+// LOOP TIMERS
+// =============================================================================
+
+// Debug flash over: restore the LED state triggerDebugFlash() saved
+static void onDebugFlashEnd()
+{
+    debugFlashActive = false;
+    led.setPattern(savedLedColor, savedLedPattern);
+}
+
+// Next LED frame: runs only when the pattern's output changes
+static void onLedTimer()
+{
+    uint32_t delayMs = led.update();
+    if (delayMs != 0)
+    {
+        armLoopTimer(g_ledTimer, delayMs);
+    }
+}
+
+// setPattern() from any context: (re)schedule the first frame change
+static void onLedSchedule(uint32_t delayMs)
+{
+    if (delayMs != 0)
+    {
+        armLoopTimer(g_ledTimer, delayMs);
+    }
+    else
+    {
+        stopLoopTimer(g_ledTimer);
+    }
+}
+
+// Demote CONNECTION_LOST (purple blink) to IDLE (blue breathe) once the
+// peer has been gone for CONNECTION_LOST_TIMEOUT_MS. Non-blocking
+// replacement for the old 3x2s delay() retry loop; scanning/advertising
+// keeps running and a reconnect from IDLE still lands in READY.
+static void onConnectionLostTimeout()
+{
+    if (stateMachine.getCurrentState() == TherapyState::CONNECTION_LOST)
+    {
+        Serial.println(F("[RECOVERY] No reconnect within timeout - returning to IDLE"));
+        stateMachine.transition(StateTrigger::RECONNECT_FAILED);
+    }
+}
+
+// PRIMARY: boot window expired without a phone - auto-start therapy
+// SP-H1 fix: Capture bootWindowStart once atomically before the arithmetic
+static void onBootWindowExpired()
+{
+    if (deviceRole != DeviceRole::PRIMARY || !bootWindowActive || autoStartTriggered)
+    {
+        return;
+    }
+    uint32_t startSnapshot = bootWindowStart;  // SP-H1: Capture volatile once
+    uint32_t currentTime = millis();
+    uint32_t elapsed = currentTime - startSnapshot;
+
+    if (ble.isSecondaryConnected() && !ble.isPhoneConnected())
+    {
+        Serial.printf("[BOOT] 30s window expired (now=%lu, start=%lu, elapsed=%lu) - auto-starting therapy\n",
+                      (unsigned long)currentTime, (unsigned long)startSnapshot, (unsigned long)elapsed);
+        bootWindowActive = false;
+        autoStartTriggered = true;
+        autoStartTherapy();
+    }
+    else
+    {
+        // SECONDARY disconnected during window, cancel
+        Serial.printf("[BOOT] Window expired but SECONDARY not connected (now=%lu, start=%lu)\n",
+                      (unsigned long)currentTime, (unsigned long)startSnapshot);
+        bootWindowActive = false;
+    }
+}
+
+// Periodic latency metrics reporting (when enabled and therapy running)
+static void onLatencyReportTimer()
+{
+    if (latencyMetrics.enabled && therapy.isRunning())
+    {
+        latencyMetrics.printReport();
+    }
+}
+
+#if BATTERY_SENSE_ENABLED
+static void onBatteryTimer()
+{
+    BatteryStatus status = battery.getStatus();
+    g_batteryStatus = status;
+    Serial.printf("[BATTERY] %.2fV | %d%% | Status: %s\n",
+                  status.voltage, status.percentage, status.statusString());
+#if SESSION_JOURNAL_ENABLED
+    sessionJournal.record(JournalRecordType::BATTERY, status.percentage, 0,
+                          static_cast<int32_t>(status.voltage * 1000.0f), 0);
+#endif
+}
+#endif
+
+/**
+ * @brief Latest finish time for deferred work: the guard before the next motor event
+ * @return UINT64_MAX while no motor event is scheduled
+ */
+static uint64_t deferredDeadlineUs()
+{
+    uint64_t nextEventUs = activationQueue.getNextEventTime();
+    if (nextEventUs == UINT64_MAX)
     {
-        lastClockCheck = now;
-        hiresClockEnsureHfclk();
+        return UINT64_MAX;
     }
+    return nextEventUs > DEFERRED_MOTOR_GUARD_US ? nextEventUs - DEFERRED_MOTOR_GUARD_US : 0;
+}
 
-    // Unified keepalive + clock sync (PRIMARY only). 4Hz during therapy for
-    // tighter drift tracking and more samples for the quality gates; 1Hz idle.
-    // More PINGs only strengthens keepalive semantics (timeouts unchanged).
-    uint32_t pingIntervalMs = therapy.isRunning() ? SYNC_ACTIVE_INTERVAL_MS : KEEPALIVE_INTERVAL_MS;
-    if (deviceRole == DeviceRole::PRIMARY &&
-        isConnected &&
-        (now - lastKeepalive >= pingIntervalMs))
+/**
+ * @brief No motor event is due within a flash write's worst-case stall
+ *
+ * Flash programming (and the occasional erase) stalls the CPU on nRF52, so
+ * deferred writes wait for the next poll rather than delaying an activation.
+ */
+static bool flashWriteWindowOpen()
+{
+    return activationQueue.isEmpty() ||
+           activationQueue.getNextEventTime() > getMicros() + SESSION_JOURNAL_FLUSH_GUARD_US;
+}
+
+#if SESSION_JOURNAL_ENABLED
+/** @brief Write a sealed journal page to flash, only in a motor gap */
+static void onJournalTimer()
+{
+    if (!sessionJournal.hasPendingPage() || !flashWriteWindowOpen())
     {
-        lastKeepalive = now;
-        sendPing();
+        return;
     }
+    sessionJournal.flushPending();
+}
+#endif
 
-    // Print status every 5 seconds
-    if (now - lastStatusPrint >= 5000)
+/** @brief Persist settings changed by the phone once they settle */
+static void onSettingsTimer()
+{
+    if (!profiles.hasPendingSave() || !flashWriteWindowOpen())
     {
-        lastStatusPrint = now;
-        printStatus();
+        return;
     }
+    profiles.saveIfDue();
+}
+
+/**
+ * @brief Register loop()'s timers and start the periodic ones (setup())
+ *
+ * Before the BLE callbacks are installed: they arm the one-shots.
+ */
+static void beginLoopTimers()
+{
+    g_statusTimer = loopTimers.add(printStatus);
+    // HFXO watchdog: the SoftDevice HFCLK request is a single shared flag and
+    // TinyUSB releases it on USB suspend - re-assert so TIMER4 stays accurate
+    g_hfclkTimer = loopTimers.add(hiresClockEnsureHfclk);
+    g_latencyReportTimer = loopTimers.add(onLatencyReportTimer);
+    g_debugFlashTimer = loopTimers.add(onDebugFlashEnd);
+    g_connectionLostTimer = loopTimers.add(onConnectionLostTimeout);
+    g_bootWindowTimer = loopTimers.add(onBootWindowExpired);
+    // Sync wasn't valid on the first auto-start attempt
+    g_autoStartRetryTimer = loopTimers.add(autoStartTherapy);
+#if BATTERY_SENSE_ENABLED
+    g_batteryTimer = loopTimers.add(onBatteryTimer);
+#endif
+#if SESSION_JOURNAL_ENABLED
+    g_journalTimer = loopTimers.add(onJournalTimer);
+#endif
+    g_settingsTimer = loopTimers.add(onSettingsTimer);
+    g_ledTimer = loopTimers.add(onLedTimer);
+    led.setScheduleCallback(onLedSchedule);
 
+    uint32_t now = millis();
+    loopTimers.start(g_statusTimer, now, 5000, 5000);
+    loopTimers.start(g_hfclkTimer, now, 1000, 1000);
+    loopTimers.start(g_latencyReportTimer, now, LATENCY_REPORT_INTERVAL_MS, LATENCY_REPORT_INTERVAL_MS);
 #if BATTERY_SENSE_ENABLED
-    // Check battery every 60 seconds
-    if (now - lastBatteryCheck >= BATTERY_CHECK_INTERVAL_MS)
-    {
-        lastBatteryCheck = now;
-        BatteryStatus status = battery.getStatus();
-        Serial.printf("[BATTERY] %.2fV | %d%% | Status: %s\n",
-                      status.voltage, status.percentage, status.statusString());
-    }
+    loopTimers.start(g_batteryTimer, now, BATTERY_CHECK_INTERVAL_MS, BATTERY_CHECK_INTERVAL_MS);
+#endif
+#if SESSION_JOURNAL_ENABLED
+    loopTimers.start(g_journalTimer, now, SESSION_JOURNAL_FLUSH_CHECK_MS, SESSION_JOURNAL_FLUSH_CHECK_MS);
 #endif
+    loopTimers.start(g_settingsTimer, now, SETTINGS_SAVE_CHECK_MS, SETTINGS_SAVE_CHECK_MS);
+}
 
-    // Yield to BLE stack (non-blocking - allows SoftDevice processing)
-    yield();
+/** @brief Arm a loop() timer from any context (BLE callbacks included) */
+static void armLoopTimer(SoftTimerId id, uint32_t delayMs, uint32_t periodMs)
+{
+    uint32_t now = millis();
+    PLATFORM_CRITICAL_ENTER();
+    loopTimers.start(id, now, delayMs, periodMs);
+    PLATFORM_CRITICAL_EXIT();
+}
+
+/** @brief Disarm a loop() timer from any context */
+static void stopLoopTimer(SoftTimerId id)
+{
+    PLATFORM_CRITICAL_ENTER();
+    loopTimers.stop(id);
+    PLATFORM_CRITICAL_EXIT();
+}
+
+/**
+ * @brief Run every expired loop() timer (loop() only)
+ *
+ * Pops under the critical section, runs each callback outside it; at most
+ * one expiry per timer per pass.
+ */
+static void serviceLoopTimers(uint32_t now)
+{
+    for (uint8_t i = 0; i < SoftTimers::CAPACITY; i++)
+    {
+        SoftTimerId id;
+        {
+            PLATFORM_CRITICAL_ENTER();
+            id = loopTimers.popExpired(now);
+            PLATFORM_CRITICAL_EXIT();
+        }
+        if (id == SOFT_TIMER_NONE)
+        {
+            break;
+        }
+        SoftTimerCallback callback = loopTimers.callback(id);
+        if (callback)
+        {
+            callback();
+        }
+    }
 }
 
 // =============================================================================
@@ -1089,126 +2304,313 @@ DeviceRole determineRole()
 }
 
 /**
- * @brief Feed the last motor-presence probe result into pattern generation
+ * @brief Feed motor presence and health into pattern generation
  *
  * PRIMARY is the source of truth: patterns are generated over present
  * fingers only, and those physical indices reach SECONDARY inside
  * macrocycle events, so both gloves skip the same missing motor.
- * A probe that found nothing (e.g. USB-only bench boot) leaves the map
- * untouched rather than disabling therapy outright.
+ * A probe that found nothing (e.g. USB-only bench boot, or nRF52 where it
+ * never runs at boot) counts every port as present. Motors the health
+ * monitor marked failed are left out until they recover. If that would
+ * leave no motor, the map is left untouched rather than disabling therapy
+ * outright.
  */
 static void applyMotorPresenceToTherapy()
 {
-    uint8_t presentFingers[MAX_ACTUATORS];
-    uint8_t n = 0;
+    uint8_t presentMask = 0;
     for (uint8_t f = 0; f < MAX_ACTUATORS; f++)
     {
         if (haptic.isMotorPresent(f))
         {
-            presentFingers[n++] = f;
+            presentMask |= static_cast<uint8_t>(1u << f);
+        }
+    }
+    if (presentMask == 0)
+    {
+        presentMask = static_cast<uint8_t>((1u << MAX_ACTUATORS) - 1);
+    }
+#if MOTOR_HEALTH_MONITOR_ENABLED
+    presentMask = static_cast<uint8_t>(presentMask & ~motorHealth.failedMask());
+#endif
+
+    uint8_t usableFingers[MAX_ACTUATORS];
+    uint8_t n = 0;
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++)
+    {
+        if (presentMask & (1u << f))
+        {
+            usableFingers[n++] = f;
         }
     }
     if (n == 0)
     {
         return;
     }
-    therapy.setActiveFingers(presentFingers, n);
+    therapy.setActiveFingers(usableFingers, n);
     if (n < MAX_ACTUATORS)
     {
-        Serial.printf("[THERAPY] Patterns restricted to %u present motor(s)\n", n);
+        Serial.printf("[THERAPY] Patterns restricted to %u usable motor(s)\n", n);
     }
 }
 
-bool initializeHardware()
-{
-    bool success = true;
+#if MOTOR_HEALTH_MONITOR_ENABLED
+// Failed-motor mask last applied to the finger map (loop task only)
+static uint8_t g_appliedFailedMotors = 0;
 
-#if SYNC_DEBUG_GPIO_ENABLED
-    pinMode(SYNC_DEBUG_GPIO_PIN, OUTPUT);
-    digitalWrite(SYNC_DEBUG_GPIO_PIN, LOW);
+/**
+ * @brief Re-map patterns when the health monitor drops or restores a motor
+ */
+static void applyMotorHealthToTherapy()
+{
+    uint8_t failed = motorHealth.failedMask();
+    if (failed == g_appliedFailedMotors)
+    {
+        return;
+    }
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++)
+    {
+        uint8_t bit = static_cast<uint8_t>(1u << f);
+        if ((failed & bit) && !(g_appliedFailedMotors & bit))
+        {
+            Serial.printf("[HEALTH] F%u failing readback - removed from patterns\n", f);
+        }
+        else if (!(failed & bit) && (g_appliedFailedMotors & bit))
+        {
+            Serial.printf("[HEALTH] F%u recovered - restored to patterns\n", f);
+        }
+    }
+    g_appliedFailedMotors = failed;
+    applyMotorPresenceToTherapy();
+}
 #endif
 
-    // Initialize haptic controller
+/**
+ * @brief DRV2605 bring-up: driver init, safety stop and (PentaBuzzer) boot probe
+ * @return true if at least one driver initialized
+ *
+ * Runs from setup(), or with FAST_BOOT_ENABLED from the motor task before
+ * its first event. Touches only the haptic controller; settings, LED and
+ * pattern follow-up run on the loop task in finishMotorBringUp().
+ */
+static bool bringUpMotors()
+{
     Serial.println(F("\nInitializing Haptic Controller..."));
     if (!haptic.begin())
     {
         Serial.println(F("[ERROR] Haptic controller initialization failed"));
-        success = false;
+        return false;
     }
-    else
+
+    // Safety: Immediately stop all motors in case they were left on from previous session
+    haptic.emergencyStop();
+
+    Serial.printf("Haptic Controller: %d/%d fingers enabled\n",
+                  haptic.getEnabledCount(), MAX_ACTUATORS);
+
+#if MOTOR_HEALTH_MONITOR_ENABLED
+    uint8_t enabledMask = 0;
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++)
     {
-        // Safety: Immediately stop all motors in case they were left on from previous session
-        haptic.emergencyStop();
+        if (haptic.isEnabled(f))
+        {
+            enabledMask |= static_cast<uint8_t>(1u << f);
+        }
+    }
+    motorHealth.begin(enabledMask);
+#endif
+
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+    // Boot QA: detect unpopulated/broken motor ports (each present motor
+    // buzzes ~0.5s during the auto-cal probe). NOTE: needs battery power;
+    // a USB-only boot can misreport, but motors can't run then anyway.
+    // PentaBuzzer only: the auto-cal presence method is validated on this
+    // board's LRAs. On nRF v2 gloves the probe stays available via the
+    // MOTOR_PRESENT serial command but never runs (or restricts therapy
+    // patterns) automatically at boot.
+    haptic.probeMotorPresence();
+#endif
+    return true;
+}
+
+/**
+ * @brief Loop-task follow-up of bringUpMotors()
+ * @param motorsUp bringUpMotors() result
+ *
+ * Records the negotiated bus speed and probed presence (flash is written
+ * only when they change), reports missing motors and restricts patterns
+ * to the motors found.
+ */
+static void finishMotorBringUp(bool motorsUp)
+{
+    if (!motorsUp)
+    {
+#if FAST_BOOT_ENABLED
+        // setup() finished long ago - flag the failure as it would have
+        led.setPattern(Colors::RED, LEDPattern::BLINK_SLOW);
+#endif
+        return;
+    }
 
-        Serial.printf("Haptic Controller: %d/%d fingers enabled\n",
-                      haptic.getEnabledCount(), MAX_ACTUATORS);
+    bool settingsChanged = false;
+    uint16_t busKhz = static_cast<uint16_t>(haptic.getBusFrequency() / 1000);
+    if (profiles.getI2CBusKhz() != busKhz)
+    {
+        Serial.printf("[SETTINGS] I2C bus speed changed: %u -> %u kHz\n",
+                      profiles.getI2CBusKhz(), busKhz);
+        profiles.setI2CBusKhz(busKhz);
+        settingsChanged = true;
+    }
 
 #if defined(BOARD_PENTABUZZER_ESP32S3)
-        // Boot QA: detect unpopulated/broken motor ports (each present motor
-        // buzzes ~0.5s during the auto-cal probe). NOTE: needs battery power;
-        // a USB-only boot can misreport, but motors can't run then anyway.
-        // PentaBuzzer only: the auto-cal presence method is validated on this
-        // board's LRAs. On nRF v2 gloves the probe stays available via the
-        // MOTOR_PRESENT serial command but never runs (or restricts therapy
-        // patterns) automatically at boot.
-        constexpr uint8_t MIN_REQUIRED_MOTORS = 4;
-        uint8_t motorsPresent = haptic.probeMotorPresence();
-        if (haptic.lastProbeSupplyDipped())
-        {
-            // USB-only bench boot: cal drive browned the chips out, so the
-            // verdicts are garbage. Don't alarm on healthy hardware.
-            Serial.println(F("[WARN] Motor check skipped: supply dipped during probe (USB-only power?)"));
-        }
-        else if (motorsPresent < MIN_REQUIRED_MOTORS)
+    constexpr uint8_t MIN_REQUIRED_MOTORS = 4;
+    uint8_t motorsPresent = haptic.getMotorPresentCount();
+    if (haptic.lastProbeSupplyDipped())
+    {
+        // USB-only bench boot: cal drive browned the chips out, so the
+        // verdicts are garbage. Don't alarm on healthy hardware.
+        Serial.println(F("[WARN] Motor check skipped: supply dipped during probe (USB-only power?)"));
+    }
+    else
+    {
+        uint8_t mask = 0;
+        for (uint8_t f = 0; f < MAX_ACTUATORS; f++)
+        {
+            if (haptic.isMotorPresent(f))
+            {
+                mask |= static_cast<uint8_t>(1u << f);
+            }
+        }
+        if (mask != 0 && profiles.getMotorPresentMask() != mask)
+        {
+            profiles.setMotorPresentMask(mask);
+            settingsChanged = true;
+        }
+
+        if (motorsPresent < MIN_REQUIRED_MOTORS)
         {
             Serial.printf("[ERROR] Missing/failed motor(s): %u/%u detected (minimum %u) - check JST connections\n",
                           motorsPresent, MAX_ACTUATORS, MIN_REQUIRED_MOTORS);
+            led.setPattern(Colors::RED, LEDPattern::DOUBLE_BLINK);
+#if !FAST_BOOT_ENABLED
             // Double-blink red long enough to be seen before connection
             // status colors take over the LED
-            led.setPattern(Colors::RED, LEDPattern::DOUBLE_BLINK);
             uint32_t errorUntil = millis() + 5000;
             while (millis() < errorUntil)
             {
                 led.update();
                 delay(10);
             }
+#endif
         }
-        applyMotorPresenceToTherapy();
+    }
+    applyMotorPresenceToTherapy();
 #endif // BOARD_PENTABUZZER_ESP32S3
 
-        // Create high-priority motor task for preemptive activations
-        // Priority 4 (HIGHEST) ensures motor timing isn't blocked by Serial/BLE
-        // Stack depth units differ per FreeRTOS port: WORDS on the nRF52 core
-        // (512 words = 2KB, increased from 256 to prevent stack overflow during
-        // BLE initialization), BYTES on ESP-IDF (4KB for headroom).
+    if (settingsChanged)
+    {
+        profiles.saveSettings();
+    }
+}
+
+/**
+ * @brief Create the motor task and release it onto the activation queue
+ */
+static void startMotorTask()
+{
+    // Create high-priority motor task for preemptive activations
+    // Priority 4 (HIGHEST) ensures motor timing isn't blocked by Serial/BLE
+    // Stack depth units differ per FreeRTOS port: WORDS on the nRF52 core,
+    // BYTES on ESP-IDF. MOTOR_TASK_STACK_BYTES (config.h) is the size in bytes.
 #if defined(BOARD_PENTABUZZER_ESP32S3)
-        constexpr uint32_t MOTOR_TASK_STACK = 4096;  // bytes (ESP-IDF units)
+    constexpr uint32_t MOTOR_TASK_STACK = MOTOR_TASK_STACK_BYTES;
+#else
+    constexpr uint32_t MOTOR_TASK_STACK = MOTOR_TASK_STACK_BYTES / sizeof(StackType_t);
+#endif
+    // Per-board core and priority: see the task topology in board_config.h
+#if TASK_PINNING_ENABLED
+    BaseType_t taskCreated = xTaskCreatePinnedToCore(
+        motorTask,           // Task function
+        "Motor",             // Name (for debugging)
+        MOTOR_TASK_STACK,    // Stack size (per-port units, see above)
+        nullptr,             // Parameters
+        MOTOR_TASK_PRIORITY, // Top application priority on its core
+        &motorTaskHandle,    // Handle
+        MOTOR_TASK_CORE      // Timing core, away from the BLE host
+    );
+#else
+    BaseType_t taskCreated = xTaskCreate(
+        motorTask,           // Task function
+        "Motor",             // Name (for debugging)
+        MOTOR_TASK_STACK,    // Stack size (per-port units, see above)
+        nullptr,             // Parameters
+        MOTOR_TASK_PRIORITY, // Priority 4 - preempts main loop
+        &motorTaskHandle     // Handle
+    );
+#endif
+
+    if (taskCreated == pdPASS && motorTaskHandle != nullptr) {
+        memoryReport.addTask("Motor", motorTaskHandle, MOTOR_TASK_STACK_BYTES);
+        // Set motor task handle for queue notifications
+        activationQueue.begin(&haptic, motorTaskHandle);
+        // TP-4: Release motor task to run now that queue is initialized
+        xTaskNotifyGive(motorTaskHandle);
+#if TASK_PINNING_ENABLED
+        Serial.printf("[SUCCESS] Motor task created and released on core %d at priority %d\n",
+                      MOTOR_TASK_CORE, (int)MOTOR_TASK_PRIORITY);
 #else
-        constexpr uint32_t MOTOR_TASK_STACK = 512;   // words = 2KB (nRF52 core units)
-#endif
-        BaseType_t taskCreated = xTaskCreate(
-            motorTask,           // Task function
-            "Motor",             // Name (for debugging)
-            MOTOR_TASK_STACK,    // Stack size (per-port units, see above)
-            nullptr,             // Parameters
-            TASK_PRIO_HIGHEST,   // Priority 4 - preempts main loop
-            &motorTaskHandle     // Handle
-        );
-
-        if (taskCreated == pdPASS && motorTaskHandle != nullptr) {
-            // Set motor task handle for queue notifications
-            activationQueue.begin(&haptic, motorTaskHandle);
-            // TP-4: Release motor task to run now that queue is initialized
-            xTaskNotifyGive(motorTaskHandle);
-            Serial.println(F("[SUCCESS] Motor task created and released at Priority 4 (FreeRTOS timing)"));
+        Serial.println(F("[SUCCESS] Motor task created and released at Priority 4 (FreeRTOS timing)"));
+#endif
+#if HAPTIC_ASYNC_I2C_ENABLED
+        if (hapticI2CEngine.begin(&haptic, onHapticI2CComplete)) {
+            Serial.println(F("[MOTOR_TASK] Async haptic I2C worker running"));
         } else {
-            Serial.println(F("[WARN] Motor task creation failed - motors will not function"));
+            Serial.println(F("[MOTOR_TASK] WARNING: async haptic I2C worker failed - using blocking I2C"));
         }
+#endif
+    } else {
+        Serial.println(F("[WARN] Motor task creation failed - motors will not function"));
+    }
+}
+
+bool initializeHardware()
+{
+    bool success = true;
+
+#if SYNC_DEBUG_GPIO_ENABLED
+    pinMode(SYNC_DEBUG_GPIO_PIN, OUTPUT);
+    digitalWrite(SYNC_DEBUG_GPIO_PIN, LOW);
+#endif
+
+#if FAST_BOOT_ENABLED
+    // Motors come up in the motor task (bringUpMotors()); meanwhile patterns
+    // follow the presence the previous boot's probe saved
+#if defined(BOARD_PENTABUZZER_ESP32S3)
+    haptic.restoreMotorPresence(profiles.getMotorPresentMask());
+    applyMotorPresenceToTherapy();
+#endif
+    startMotorTask();
+#else
+    bool motorsUp = bringUpMotors();
+    finishMotorBringUp(motorsUp);
+    if (motorsUp)
+    {
+        startMotorTask();
+    }
+    else
+    {
+        success = false;
     }
+#endif
 
     // Initialize battery monitor
     Serial.println(F("\nInitializing Battery Monitor..."));
     battery.attachHaptic(&haptic);  // VBat voltmeter on boards without battery ADC
+#if FAST_BOOT_ENABLED && !BATTERY_SENSE_ADC
+    // The DRV2605 VBAT voltmeter needs the drivers, which are still coming
+    // up: the motor task starts sampling after bring-up and the first
+    // readVoltage() after a sample lands initializes the monitor
+    Serial.println(F("Battery Monitor: waiting for motor bring-up"));
+#else
     if (!battery.begin())
     {
         Serial.println(F("[ERROR] Battery monitor initialization failed"));
@@ -1218,6 +2620,7 @@ bool initializeHardware()
     {
         Serial.println(F("Battery Monitor: OK"));
     }
+#endif
 
     return success;
 }
@@ -1229,6 +2632,9 @@ bool initializeBLE()
     ble.setDisconnectCallback(onBLEDisconnect);
     ble.setMessageCallback(onBLEMessage);
     ble.setTxStampCallback(onTxStamped);
+#if SYNC_PERIODIC_ADV_ENABLED
+    ble.setScheduleBroadcastCallback(onScheduleBroadcast);
+#endif
 
     // Initialize BLE with appropriate role
     if (!ble.begin(deviceRole, BLE_NAME))
@@ -1243,6 +2649,30 @@ bool initializeBLE()
     if (hiresClockBegin())
     {
         Serial.println(F("[CLOCK] 1MHz hardware timebase active (TIMER4 + HFXO)"));
+#if SYNC_SKEW_CAPTURE_ENABLED
+        if (deviceRole == DeviceRole::SECONDARY)
+        {
+            if (skewCapture.begin())
+            {
+                Serial.println(F("[SYNC] Skew capture active - PRIMARY debug pulse on SYNC_SKEW_CAPTURE_PIN"));
+            }
+            else
+            {
+                Serial.println(F("[SYNC] WARNING: skew capture unavailable"));
+            }
+        }
+#endif
+#if MOTOR_TIMER_DISPATCH_ENABLED
+        if (hiresClockAlarmBegin(onMotorDispatchAlarm))
+        {
+            motorAlarmReady = true;
+            Serial.println(F("[MOTOR_TASK] Hardware-timer event dispatch active"));
+        }
+        else
+        {
+            Serial.println(F("[MOTOR_TASK] WARNING: deadline alarm unavailable - using busy-wait dispatch"));
+        }
+#endif
     }
     else
     {
@@ -1310,8 +2740,36 @@ bool initializeTherapy()
 // BLE EVENT HANDLERS
 // =============================================================================
 
+/**
+ * @brief Publish this pass's status for readers on other tasks (loop() only)
+ */
+static void publishStatusSnapshot()
+{
+    StatusSnapshot status;
+    status.publishedMs = millis();
+    status.state = stateMachine.getCurrentState();
+    status.therapyRunning = therapy.isRunning();
+    if (status.therapyRunning)
+    {
+        status.elapsedSeconds = therapy.getElapsedSeconds();
+        status.durationSeconds = therapy.getDurationSeconds();
+    }
+    status.cyclesCompleted = therapy.getCyclesCompleted();
+    status.battery = g_batteryStatus;
+    status.clockSyncValid = syncProtocol.isClockSyncValid();
+    status.clockOffsetUs = syncProtocol.getCorrectedOffset();
+    status.offsetUncertaintyUs = syncProtocol.getOffsetUncertaintyUs();
+    status.rttUs = syncProtocol.getAverageRTT();
+    status.secondaryConnected = ble.isSecondaryConnected();
+    status.phoneConnected = ble.isPhoneConnected();
+    statusSnapshot.publish(status);
+}
+
 void printStatus()
 {
+    // Periodic heap sample: the nRF52 core keeps no low-water mark of its own
+    memoryReport.sampleHeap();
+
     Serial.println(F("------------------------------------------------------------"));
 
     // Line 1: Role and State
@@ -1347,6 +2805,16 @@ void printStatus()
         }
     }
 
+#if POWER_IDLE_SLEEP_ENABLED
+    // Line 3: how loop() waits end (events vs. timer deadlines)
+    Serial.printf("[LOOP] Wakes: %lu event | %lu timeout\n",
+                  (unsigned long)loopWake.eventWakes(), (unsigned long)loopWake.timeoutWakes());
+#endif
+
+    // Status snapshot: copies a reader on another task had to redo
+    Serial.printf("[SNAPSHOT] Published: %lu | Read retries: %lu\n",
+                  (unsigned long)statusSnapshot.publishCount(), (unsigned long)statusSnapshot.readRetries());
+
     Serial.println(F("------------------------------------------------------------"));
 }
 
@@ -1356,6 +2824,7 @@ void printStatus()
 
 void onBLEConnect(uint16_t connHandle, ConnectionType type)
 {
+    LoopWakeScope wake(LOOP_WAKE_BLE_LINK);  // loop() handles the follow-up (boot window, status)
     const char *typeStr = "UNKNOWN";
     switch (type)
     {
@@ -1377,6 +2846,31 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
 
     Serial.printf("[CONNECT] Handle: %d, Type: %s\n", connHandle, typeStr);
 
+    // New links come up on the tight connect-time parameters
+    connParams.onLinkUp();
+
+#if BLE_MAX_SECONDARIES > 1
+    // SECONDARY links after the first keep their own sync state and leave
+    // the session state machine to the main SECONDARY
+    if (deviceRole == DeviceRole::PRIMARY && type == ConnectionType::SECONDARY &&
+        connHandle != ble.getSecondaryHandle())
+    {
+        // While the previous main link's extras are still dropping, the
+        // oldest of them would stay "main" - let this one retry instead
+        bool mainRetiring = extraPeers.find(ble.getSecondaryHandle()) != nullptr;
+        if (mainRetiring || extraPeers.add(connHandle, millis()) == nullptr)
+        {
+            Serial.printf("[SYNC] Extra SECONDARY %d refused\n", connHandle);
+            ble.disconnect(connHandle);
+            return;
+        }
+        Serial.printf("[SYNC] Extra SECONDARY %d - %u of %u peers\n", connHandle,
+                      (unsigned)(extraPeers.count() + 1), (unsigned)BLE_MAX_SECONDARIES);
+        pingScheduler.requestBurst();
+        return;
+    }
+#endif
+
     // If SECONDARY device connected to PRIMARY, send identification
     // Note: SECONDARY has no warm-start logic because it doesn't maintain sync state.
     // SECONDARY receives clock offset from PRIMARY in every MACROCYCLE message, so it
@@ -1385,6 +2879,29 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
     {
         Serial.println(F("[SECONDARY] Sending IDENTIFY:SECONDARY to PRIMARY"));
         ble.sendToPrimary("IDENTIFY:SECONDARY");
+        // Announce the newest MACROCYCLE format we decode. Sent as its own
+        // message so older PRIMARY firmware still matches IDENTIFY exactly.
+        // Capabilities follow the version; older PRIMARY stops parsing at '|'
+        g_mcPipelineActive = false;
+        g_mcSeededActive = false;
+        g_mcRxTemplateValid = false;
+        g_mcRxHistory.clear();
+        g_mcRxSessionValid = false;
+        disarmSeededCoast();
+#if SYNC_PERIODIC_ADV_ENABLED
+        // New link, new train calibration (the PRIMARY may have rebooted)
+        g_scheduleTracker.reset();
+        g_mcRxStagedValid = false;
+        if (!ble.startScheduleListener())
+        {
+            Serial.println(F("[SYNC] Schedule broadcast unavailable - GATT only"));
+        }
+#endif
+        char verMsg[24];
+        snprintf(verMsg, sizeof(verMsg), "MC_VER:%u|%u", MACROCYCLE_WIRE_LATEST,
+                 ((MACROCYCLE_PIPELINE_DEPTH > 1) ? MACROCYCLE_CAP_PIPELINE : 0) |
+                 (MACROCYCLE_SEEDED_ENABLED ? MACROCYCLE_CAP_SEEDED : 0));
+        ble.sendToPrimary(verMsg);
         // Start keepalive timeout tracking
         lastKeepaliveReceived = millis();
     }
@@ -1394,6 +2911,9 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
         (deviceRole == DeviceRole::SECONDARY && type == ConnectionType::PRIMARY))
     {
         stateMachine.transition(StateTrigger::CONNECTED);
+#if BLE_PHY_AUTO_ENABLED
+        g_phyLinkUp = true;  // New link, new PHY history
+#endif
     }
 
     // PRIMARY: Boot window logic for auto-start
@@ -1404,13 +2924,24 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
             // SECONDARY connected - start 30-second boot window for phone
             bootWindowStart = millis();
             bootWindowActive = true;
+            armLoopTimer(g_bootWindowTimer, STARTUP_WINDOW_MS);
             // Initialize keepalive tracking (timeout detection starts when first PONG received)
             lastSecondaryKeepalive = millis();
             Serial.printf("[BOOT] SECONDARY connected at %lu - starting 30s boot window for phone\n",
                           (unsigned long)bootWindowStart);
 
+            // Older SECONDARY firmware never sends MC_VER: assume V5 text
+            g_secondaryMcWireVersion = MACROCYCLE_WIRE_V5;
+            g_mcPipelineActive = false;
+            g_mcSeededActive = false;
+            g_mcTxAckValid = false;
+            g_mcTxResetPending = true;
+
             // Reset clock sync state
             syncProtocol.resetClockSync();
+#if SYNC_SKEW_CAL_ENABLED
+            g_secondaryAddrValid = ble.getPeerAddress(connHandle, g_secondaryAddr);
+#endif
 
             // Try warm-start if recent disconnect (cache preserved across resetClockSync)
             if (syncProtocol.tryWarmStart())
@@ -1420,12 +2951,20 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
             else
             {
                 Serial.println(F("[SYNC] Cold start - need 5 samples for sync (~5s)"));
+#if SYNC_SKEW_CAL_ENABLED
+                seedSkewCalibration();
+#endif
             }
+            pingScheduler.requestBurst();
+#if SYNC_SLACK_FEEDBACK_ENABLED
+            leadTimeController.requestReset();
+#endif
         }
         else if (type == ConnectionType::PHONE && bootWindowActive)
         {
             // Phone connected within boot window - cancel auto-start
             bootWindowActive = false;
+            stopLoopTimer(g_bootWindowTimer);
             Serial.println(F("[BOOT] Phone connected - boot window cancelled"));
         }
     }
@@ -1439,6 +2978,7 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
 
 void onBLEDisconnect(uint16_t connHandle, ConnectionType type, uint8_t reason)
 {
+    LoopWakeScope wake(LOOP_WAKE_BLE_LINK);
     const char *typeStr = "UNKNOWN";
     switch (type)
     {
@@ -1480,6 +3020,33 @@ void onBLEDisconnect(uint16_t connHandle, ConnectionType type, uint8_t reason)
     }
     Serial.printf("[DISCONNECT] HCI Reason: %s\n", reasonStr);
 
+#if BLE_MAX_SECONDARIES > 1
+    if (deviceRole == DeviceRole::PRIMARY && type == ConnectionType::SECONDARY)
+    {
+        if (extraPeers.remove(connHandle))
+        {
+            Serial.printf("[SYNC] Extra SECONDARY %d gone (%u extra left)\n",
+                          connHandle, (unsigned)extraPeers.count());
+            return;
+        }
+
+        // Main SECONDARY lost: drop the extras too, so whichever peer
+        // re-identifies first becomes the main SECONDARY again. Handles are
+        // copied first - their disconnects remove them from extraPeers.
+        uint16_t handles[SecondaryPeerSet::CAPACITY];
+        uint8_t count = extraPeers.count();
+        for (uint8_t i = 0; i < count; i++)
+        {
+            handles[i] = extraPeers.at(i).connHandle;
+        }
+        extraPeers.retireAll();
+        for (uint8_t i = 0; i < count; i++)
+        {
+            ble.disconnect(handles[i]);
+        }
+    }
+#endif
+
     // Update state machine on relevant disconnections
     if ((deviceRole == DeviceRole::PRIMARY && type == ConnectionType::SECONDARY) ||
         (deviceRole == DeviceRole::SECONDARY && type == ConnectionType::PRIMARY))
@@ -1494,13 +3061,23 @@ void onBLEDisconnect(uint16_t connHandle, ConnectionType type, uint8_t reason)
             BaseType_t xHigherPriorityTaskWoken = pdFALSE;
             xSemaphoreGiveFromISR(safetyShutdownSema, &xHigherPriorityTaskWoken);
             portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+            loopWake.notify(LOOP_WAKE_SAFETY);  // Don't wait out the loop timeout
+        }
+
+#if SYNC_SKEW_CAL_ENABLED
+        // Flash writes belong to the main loop: flag the final skew record
+        if (deviceRole == DeviceRole::PRIMARY)
+        {
+            g_skewCalFlushPending = true;
         }
+#endif
 
         // PRIMARY: Cancel boot window when SECONDARY disconnects (prevents race condition
         // where stale bootWindowStart causes immediate auto-start on reconnection)
         if (deviceRole == DeviceRole::PRIMARY && bootWindowActive)
         {
             bootWindowActive = false;
+            stopLoopTimer(g_bootWindowTimer);
             Serial.println(F("[BOOT] SECONDARY disconnected - boot window cancelled"));
         }
 
@@ -1509,6 +3086,11 @@ void onBLEDisconnect(uint16_t connHandle, ConnectionType type, uint8_t reason)
         if (deviceRole == DeviceRole::PRIMARY)
         {
             g_autoStartRetryCount = 0;
+            g_secondaryMcWireVersion = MACROCYCLE_WIRE_V5;
+            g_mcPipelineActive = false;
+            g_mcSeededActive = false;
+            g_mcTxAckValid = false;
+            g_mcTxResetPending = true;
         }
     }
     else if (deviceRole == DeviceRole::PRIMARY && type == ConnectionType::PHONE)
@@ -1595,7 +3177,15 @@ void executeDeferredWork(DeferredWorkType type, uint8_t p1, uint8_t p2, uint32_t
         // Round-robin DRV2605 reset check (~200us); full reconfigure only
         // when a brownout is actually detected. Runs here (loop task) so
         // the BLE host task never blocks on I2C.
-        haptic.verifyAndHeal();
+        uint8_t healed = haptic.verifyAndHeal();
+#if SESSION_JOURNAL_ENABLED
+        if (healed > 0)
+        {
+            sessionJournal.record(JournalRecordType::HEAL, healed, 0, 0, 0);
+        }
+#else
+        (void)healed;
+#endif
         break;
     }
 
@@ -1621,31 +3211,77 @@ void executeDeferredWork(DeferredWorkType type, uint8_t p1, uint8_t p2, uint32_t
     }
 }
 
-void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp)
+/**
+ * @brief Arguments of a classified "<PREFIX>:<args>" internal message
+ * @return Text after the prefix and its ':', nullptr if the colon is missing
+ */
+static const char *internalMessageArgs(const char *message, InternalMessage kind)
+{
+    std::string_view prefix = internalPrefix(kind);
+    const char *args = message + prefix.size();
+    if (!prefix.empty() && prefix.back() == ':')
+    {
+        return args;
+    }
+    return (*args == ':') ? args + 1 : nullptr;
+}
+
+/** @brief A classified message that is exactly its prefix (no arguments) */
+static bool isExactInternalMessage(const char *message, InternalMessage kind)
+{
+    return message[internalPrefix(kind).size()] == '\0';
+}
+
+void onBLEMessage(uint16_t connHandle, const char *message, size_t messageLen, uint64_t rxTimestamp)
 {
+    PERF_SCOPE(ON_BLE_MESSAGE);
+
     // rxTimestamp is captured at the earliest possible point in the BLE stack
     // (immediately when data is received in _onUartRx/_onClientUartRx)
     // This provides maximum accuracy for PTP clock synchronization
 
+    // Replies, menu work and TX draining (nRF52) happen in loop(); wake it
+    // once this handler has published everything (on return)
+    LoopWakeScope wake(LOOP_WAKE_BLE_RX);
+
+    // Frames arrive with their length (BLERxFramer): compare and parse by
+    // length instead of re-scanning for the NUL
+    std::string_view text(message, messageLen);
+
     // Check for simple text commands first (for testing)
     // Both PRIMARY and SECONDARY can run standalone tests for hardware verification
-    if (strcmp(message, "TEST") == 0 || strcmp(message, "test") == 0)
+    if (text == "TEST" || text == "test")
     {
         startTherapyTest();
         return;
     }
 
-    if (strcmp(message, "STOP") == 0 || strcmp(message, "stop") == 0)
+    if (text == "STOP" || text == "stop")
     {
         stopTherapyTest();
         return;
     }
 
+#if BLE_MAX_SECONDARIES > 1
+    // Extra SECONDARY peers only take part in clock sync: PONG feeds their
+    // own offset estimate, MC_VER picks their MACROCYCLE format
+    if (deviceRole == DeviceRole::PRIMARY)
+    {
+        SecondaryPeer* peer = extraPeers.find(connHandle);
+        if (peer != nullptr)
+        {
+            handleExtraPeerMessage(*peer, message, messageLen, rxTimestamp);
+            return;
+        }
+    }
+#endif
+
     // Try menu controller first for phone/BLE commands (PRIMARY only)
     // Commands from an identified PHONE connection always dispatch, even if
     // they happen to match an internal (PRIMARY<->SECONDARY sync) prefix.
     bool fromPhone = ble.getConnectionType(connHandle) == ConnectionType::PHONE;
-    if (deviceRole == DeviceRole::PRIMARY && (fromPhone || !menu.isInternalMessage(message)))
+    InternalMessage kind = classifyMessage(text);
+    if (deviceRole == DeviceRole::PRIMARY && (fromPhone || kind == InternalMessage::NONE))
     {
         if (menu.handleCommand(message, fromPhone))
         {
@@ -1654,11 +3290,12 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
     }
 
     // Handle LED_OFF_SYNC from PRIMARY (SECONDARY only)
-    if (deviceRole == DeviceRole::SECONDARY && strncmp(message, "LED_OFF_SYNC:", 13) == 0)
+    const char* args = internalMessageArgs(message, kind);
+    if (deviceRole == DeviceRole::SECONDARY && kind == InternalMessage::LED_OFF_SYNC && args != nullptr)
     {
-        int value = atoi(message + 13);
+        int value = atoi(args);
         profiles.setTherapyLedOff(value != 0);
-        profiles.saveSettings();
+        profiles.requestSave();
         Serial.printf("[SYNC] LED_OFF_SYNC received: %d\n", value);
 
         // Update LED immediately if currently running therapy
@@ -1677,10 +3314,10 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
     }
 
     // Handle CALIB_BUZZ from PRIMARY (SECONDARY only)
-    if (deviceRole == DeviceRole::SECONDARY && strncmp(message, "CALIB_BUZZ:", 11) == 0)
+    if (deviceRole == DeviceRole::SECONDARY && kind == InternalMessage::CALIB_BUZZ)
     {
         int finger, intensity, duration;
-        if (sscanf(message + 11, "%d:%d:%d", &finger, &intensity, &duration) == 3 &&
+        if (sscanf(args, "%d:%d:%d", &finger, &intensity, &duration) == 3 &&
             finger >= 0 && finger < MAX_ACTUATORS &&
             intensity >= 0 && intensity <= 100 &&
             duration >= 50 && duration <= 2000)
@@ -1694,7 +3331,7 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
 
     // Handle CALIB_STOP from PRIMARY (SECONDARY only): cancel any relayed
     // one-shot buzz; hardware deactivation happens in loop()
-    if (deviceRole == DeviceRole::SECONDARY && strcmp(message, "CALIB_STOP") == 0)
+    if (deviceRole == DeviceRole::SECONDARY && kind == InternalMessage::CALIB_STOP && isExactInternalMessage(message, kind))
     {
         menu.cancelCalibrationBuzz();
         return;
@@ -1702,13 +3339,14 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
 
     // Handle GET_BATTERY from PRIMARY (SECONDARY only)
     // SECONDARY reads its local battery and sends BATRESPONSE back
-    if (strcmp(message, "GET_BATTERY") == 0)
+    if (kind == InternalMessage::GET_BATTERY && isExactInternalMessage(message, kind))
     {
         if (deviceRole == DeviceRole::SECONDARY)
         {
-            BatteryStatus status = battery.getStatus();
+            StatusSnapshot status;
+            statusSnapshot.read(status);
             char response[32];
-            snprintf(response, sizeof(response), "BATRESPONSE:%.2f", status.voltage);
+            snprintf(response, sizeof(response), "BATRESPONSE:%.2f", status.battery.voltage);
             ble.sendToPrimary(response);
         }
         return;
@@ -1716,142 +3354,210 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
 
     // Handle BATRESPONSE from SECONDARY (PRIMARY only)
     // ISR-safe: only sets volatile fields; actual response is built in loop()
-    if (deviceRole == DeviceRole::PRIMARY && strncmp(message, "BATRESPONSE:", 12) == 0)
+    if (deviceRole == DeviceRole::PRIMARY && kind == InternalMessage::BATRESPONSE && args != nullptr)
     {
-        float voltage = atof(message + 12);
+        float voltage = atof(args);
         menu.setSecondaryBatteryVoltage(voltage);
         return;
     }
 
     // Handle DEBUG_SYNC from PRIMARY (SECONDARY only)
-    if (deviceRole == DeviceRole::SECONDARY && strncmp(message, "DEBUG_SYNC:", 11) == 0)
+    if (deviceRole == DeviceRole::SECONDARY && kind == InternalMessage::DEBUG_SYNC && args != nullptr)
     {
-        int value = atoi(message + 11);
+        int value = atoi(args);
         profiles.setDebugMode(value != 0);
-        profiles.saveSettings();
+        profiles.requestSave();
         Serial.printf("[SYNC] DEBUG_SYNC received: %d\n", value);
         return;
     }
 
+    // Handle MACROCYCLE wire-format negotiation (sent right after IDENTIFY)
+    // SECONDARY -> PRIMARY: newest version it decodes
+    // PRIMARY -> SECONDARY: version PRIMARY will send (informational)
+    if (kind == InternalMessage::MC_VER)
+    {
+        char* end = nullptr;
+        uint32_t peerVersion = strtoul(args, &end, 10);
+        uint32_t peerCaps = (end != nullptr && *end == '|') ? (uint32_t)strtoul(end + 1, nullptr, 10) : 0;
+        if (deviceRole == DeviceRole::PRIMARY)
+        {
+            uint8_t version = (peerVersion >= MACROCYCLE_WIRE_LATEST) ? MACROCYCLE_WIRE_LATEST
+                            : (peerVersion >= MACROCYCLE_WIRE_V6)     ? MACROCYCLE_WIRE_V6
+                                                                      : MACROCYCLE_WIRE_V5;
+            uint8_t caps = (MACROCYCLE_PIPELINE_DEPTH > 1) ? (peerCaps & MACROCYCLE_CAP_PIPELINE) : 0;
+            if (MACROCYCLE_SEEDED_ENABLED && version >= MACROCYCLE_WIRE_V7)
+            {
+                caps |= (peerCaps & MACROCYCLE_CAP_SEEDED);
+            }
+            g_secondaryMcWireVersion = version;
+            g_mcPipelineActive = (caps & MACROCYCLE_CAP_PIPELINE) != 0;
+            g_mcSeededActive = (caps & MACROCYCLE_CAP_SEEDED) != 0;
+            char reply[24];
+            snprintf(reply, sizeof(reply), "MC_VER:%u|%u", version, caps);
+            ble.send(connHandle, reply);
+        }
+        else
+        {
+            g_mcPipelineActive = (peerCaps & MACROCYCLE_CAP_PIPELINE) != 0;
+            g_mcSeededActive = (peerCaps & MACROCYCLE_CAP_SEEDED) != 0;
+        }
+        Serial.printf("[SYNC] MACROCYCLE wire format V%lu%s%s\n", (unsigned long)peerVersion,
+                      g_mcPipelineActive ? " (pipelined)" : "",
+                      g_mcSeededActive ? " (seeded)" : "");
+        return;
+    }
+
     // Handle MACROCYCLE messages (special format - not standard SyncCommand)
-    // Format: MC:seq|baseTime|count|d,f,a,dur,fo|...
-    if (strncmp(message, "MC:", 3) == 0)
+    // Format: MC:seq|baseHigh|baseLow|... (V5), MC:<0x06><binary> (V6) or
+    // MC:<0x07><template|delta> (V7)
+    if (kind == InternalMessage::MC)
     {
         if (deviceRole == DeviceRole::SECONDARY)
         {
             // Track connectivity - MACROCYCLE proves PRIMARY is alive
             lastKeepaliveReceived = millis();
 
-            // Parse macrocycle from V2 format (includes clock offset)
-            Macrocycle mc;
-            if (SyncCommand::deserializeMacrocycle(message, strlen(message), mc))
+            uint8_t frameKind = SyncCommand::getMacrocycleFrameKind(message, messageLen);
+
+            // V7 template: cache for the deltas that follow, nothing to schedule
+            if (frameKind == SyncCommand::MACROCYCLE_FRAME_TEMPLATE)
             {
-                // Apply clock offset from PRIMARY (V2 format)
-                // PRIMARY calculated this offset and sent it in the message
-                // CRITICAL: Cast baseTime to signed before adding signed offset,
-                // otherwise negative offset becomes large positive when implicitly converted
-                // Recover any DRV2605 that reset since configuration (VBat
-                // brownout leaves it in standby, silently ignoring this
-                // macrocycle's activations). Deferred to the main loop: this
-                // handler runs in the BLE host task, which must never block
-                // on I2C - a delayed PING/PONG here would inflate an RTT
-                // sample. The loop picks it up within a few ms, still well
-                // inside the >=35ms scheduling lead window.
-                deferredQueue.enqueue(DeferredWorkType::HAPTIC_HEAL);
-
-                // NOTE: No absolute bound on the offset itself - it is the
-                // boot-time difference between the two devices, which is
-                // arbitrarily large on reconnect (e.g. one glove rebooted).
-                // Validity is checked below via localBaseTime instead.
-                int64_t offset = mc.clockOffset;
-
-                uint64_t localBaseTime = static_cast<uint64_t>(static_cast<int64_t>(mc.baseTime) + offset);
-
-                // SAFETY: Validate localBaseTime is reasonable (within ±30 seconds of now)
-                uint64_t nowUs = getMicros();
-
-                // Debug logging for offset application
-                if (profiles.getDebugMode())
+                g_mcRxTemplateValid = SyncCommand::deserializeMacrocycleTemplate(message, messageLen, g_mcRxTemplate);
+                if (!g_mcRxTemplateValid)
                 {
-                    int64_t timeUntilExec = static_cast<int64_t>(localBaseTime) - static_cast<int64_t>(nowUs);
-                    Serial.printf("[MACROCYCLE] Received seq=%lu offset=%ld baseTime=%lu -> localBaseTime=%lu (rxAt=%lu, timeUntilExec=%ld)\n",
-                                  (unsigned long)mc.sequenceId,
-                                  (long)offset,
-                                  (unsigned long)(mc.baseTime / 1000),
-                                  (unsigned long)(localBaseTime / 1000),
-                                  (unsigned long)(nowUs / 1000),
-                                  (long)(timeUntilExec / 1000));
+                    Serial.println(F("[ERROR] Failed to parse MACROCYCLE template"));
                 }
-                int64_t timeDiff = static_cast<int64_t>(localBaseTime) - static_cast<int64_t>(nowUs);
-                // Corruption guard: legitimate values are now + lead time
-                // (35-50ms) plus BLE delivery jitter. 5s is ~100x that
-                // margin while still rejecting a corrupt offset/baseTime
-                // that would otherwise schedule far-off activations.
-                constexpr int64_t MAX_TIME_DIFF = 5000000LL;  // 5 seconds
-                if (timeDiff > MAX_TIME_DIFF || timeDiff < -MAX_TIME_DIFF)
+                return;
+            }
+
+            // Seeded session params: the ticks that follow are generated from them
+            if (frameKind == SyncCommand::MACROCYCLE_FRAME_SESSION)
+            {
+                SeededSessionParams session;
+                SchedulePlan plan;
+                bool sessionOk = SyncCommand::deserializeSeededSession(message, messageLen, session) &&
+                                 compileSchedulePlan(session, plan);
                 {
-                    // SP-C3 fix: Use split print for 64-bit value (ARM long is 32-bit)
-                    int64_t diffSec = timeDiff / 1000000;
-                    Serial.printf("[ERROR] MACROCYCLE rejected: baseTime %ld seconds from now\n",
-                                  (long)diffSec);  // Division reduces to 32-bit safe range
-                    // Still send ACK to avoid retry storms
-                    SyncCommand ackCmd = SyncCommand::createMacrocycleAck(mc.sequenceId);
-                    char ackBuffer[32];
-                    if (ackCmd.serialize(ackBuffer, sizeof(ackBuffer)))
+                    // coastSeededMacrocycle() copies the plan under the same lock
+                    PLATFORM_CRITICAL_ENTER();
+                    if (sessionOk)
                     {
-                        ble.sendToPrimary(ackBuffer);
+                        g_mcRxPlan = plan;
                     }
-                    return;
+                    g_mcRxSessionValid = sessionOk;
+                    PLATFORM_CRITICAL_EXIT();
                 }
-
-                // TP-1: Stage all events via lock-free buffer (ISR-safe)
-                // Main loop will forward to activationQueue and call scheduleNext()
-                motorEventBuffer.beginMacrocycle();
-                uint8_t validEvents = 0;
-                uint8_t lastValidIndex = 0;
-
-                // First pass: count valid events to mark the last one
-                for (uint8_t i = 0; i < mc.eventCount; i++)
+                disarmSeededCoast();
+                if (!sessionOk)
                 {
-                    const MacrocycleEvent& evt = mc.events[i];
-                    if (evt.amplitude > 0 && evt.finger < MAX_ACTUATORS)
-                    {
-                        lastValidIndex = i;
-                        validEvents++;
-                    }
+                    Serial.println(F("[ERROR] Failed to parse seeded session"));
                 }
+                return;
+            }
 
-                // Second pass: stage all valid events
-                uint8_t stagedCount = 0;
-                for (uint8_t i = 0; i < mc.eventCount; i++)
+            // Parse macrocycle (V5 text, V6 binary, V7 delta or seeded tick;
+            // includes clock offset)
+            Macrocycle mc;
+            bool parsed = false;
+            bool seededTick = false;
+            if (frameKind == SyncCommand::MACROCYCLE_FRAME_TICK)
+            {
+                // Same no-ACK rule as deltas when the session is unknown
+                uint32_t seed = 0;
+                MacrocycleReference tick;
+                parsed = g_mcRxSessionValid &&
+                         SyncCommand::deserializeMacrocycleTick(message, messageLen, seed, tick) &&
+                         seed == g_mcRxPlan.seed;
+                if (parsed)
                 {
-                    const MacrocycleEvent& evt = mc.events[i];
+                    generateSeededMacrocycle(g_mcRxPlan, tick.sequenceId, mc);
+                    mc.baseTime = tick.baseTime;
+                    mc.clockOffset = tick.clockOffset;
+                    seededTick = true;
+                }
+            }
+            else if (frameKind == SyncCommand::MACROCYCLE_FRAME_DELTA)
+            {
+                // No ACK when the reference is unknown: PRIMARY keeps encoding
+                // against older acknowledged macrocycles or falls back to full
+                uint32_t refSeq = 0;
+                MacrocycleReference ref;
+                parsed = g_mcRxTemplateValid &&
+                         SyncCommand::getMacrocycleDeltaReference(message, messageLen, refSeq) &&
+                         g_mcRxHistory.find(refSeq, ref) &&
+                         SyncCommand::deserializeMacrocycleDelta(message, messageLen, g_mcRxTemplate, ref, mc);
+            }
+            else
+            {
+                parsed = SyncCommand::deserializeMacrocycle(message, messageLen, mc);
+            }
 
-                    // Skip invalid events (garbage from truncated messages)
-                    if (evt.amplitude == 0 || evt.finger >= MAX_ACTUATORS)
-                    {
-                        continue;
-                    }
+            if (parsed)
+            {
+                // Any decoded macrocycle is a valid delta reference, even if
+                // the time check below rejects it (it is still ACKed)
+                g_mcRxHistory.record(mc);
+
+                // Seeded: a late tick for a cycle already played while coasting
+                bool alreadyPlayed = false;
+                if (seededTick)
+                {
+                    alreadyPlayed = !claimSeededTick(mc.sequenceId);
+                }
+                else
+                {
+                    disarmSeededCoast();
+                }
+                if (alreadyPlayed)
+                {
+                    ble.sendCommand(connHandle, SyncCommand::createMacrocycleAck(mc.sequenceId), TxPriority::SYNC);
+                    return;
+                }
 
-                    uint64_t localActivateTime = localBaseTime + (evt.deltaTimeMs * 1000ULL);
-                    uint16_t freqHz = evt.getFrequencyHz();
-                    bool isLast = (i == lastValidIndex);
+#if SYNC_PERIODIC_ADV_ENABLED
+                // Calibrate the broadcast train against this PTP offset; once
+                // locked, the train's offset replaces the per-delivery one
+                g_scheduleTracker.onPtpOffset(mc.clockOffset);
+                if (g_scheduleTracker.isLocked())
+                {
+                    mc.clockOffset = g_scheduleTracker.getOffset();
+                }
+                if (!claimReceivedMacrocycle(mc.sequenceId))
+                {
+                    // Already scheduled from the train
+                    ble.sendCommand(connHandle, SyncCommand::createMacrocycleAck(mc.sequenceId), TxPriority::SYNC);
+                    return;
+                }
+#endif
 
-                    motorEventBuffer.stage(localActivateTime, evt.finger, evt.amplitude,
-                                           evt.durationMs, freqHz, isLast);
-                    stagedCount++;
+                uint64_t localBaseTime = 0;
+                if (!stageReceivedMacrocycle(mc, localBaseTime))
+                {
+                    // Still send ACK to avoid retry storms
+                    ble.sendCommand(connHandle, SyncCommand::createMacrocycleAck(mc.sequenceId), TxPriority::SYNC);
+                    return;
                 }
 
-                // Note: scheduleNext() will be called by main loop after forwarding events
-                // Serial.printf moved to main loop to avoid ISR context I/O
+                // Seeded + pipelined: the next cycle's baseTime is predictable
+                if (seededTick && g_mcPipelineActive)
+                {
+                    armSeededCoast(localBaseTime + (static_cast<uint64_t>(mc.getTotalDurationMs()) * 1000ULL) +
+                                   g_mcRxPlan.doubleRelaxUs);
+                }
 
-                // Send ACK immediately
-                SyncCommand ackCmd = SyncCommand::createMacrocycleAck(mc.sequenceId);
-                char ackBuffer[32];
-                if (ackCmd.serialize(ackBuffer, sizeof(ackBuffer)))
+                // Send ACK immediately, with the slack left now the events
+                // are staged (PRIMARY sizes its lead time from it)
+                int64_t slackUs = static_cast<int64_t>(localBaseTime) - static_cast<int64_t>(getMicros());
+                if (slackUs > INT32_MAX)
+                {
+                    slackUs = INT32_MAX;
+                }
+                else if (slackUs < INT32_MIN)
                 {
-                    ble.sendToPrimary(ackBuffer);
+                    slackUs = INT32_MIN;
                 }
+                ble.sendCommand(connHandle, SyncCommand::createMacrocycleAck(mc.sequenceId, static_cast<int32_t>(slackUs)),
+                                TxPriority::SYNC);
             }
             else
             {
@@ -1861,26 +3567,48 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
         return;
     }
 
+    // SECONDARY lost a macrocycle to lateness: re-measure the clock offset
+    // now and send the next macrocycle in full
+    if (deviceRole == DeviceRole::PRIMARY && kind == InternalMessage::MC_RESYNC && args != nullptr)
+    {
+        Serial.printf("[SYNC] SECONDARY resync request (late by up to %lu us)\n",
+                      (unsigned long)strtoul(args, nullptr, 10));
+        pingScheduler.requestBurst();
+        g_mcTxResetPending = true;
+        return;
+    }
+
     // Handle MACROCYCLE_ACK messages
-    if (strncmp(message, "MC_ACK:", 7) == 0)
+    if (kind == InternalMessage::MC_ACK)
     {
         if (deviceRole == DeviceRole::PRIMARY)
         {
             lastSecondaryKeepalive = millis();
-            // TODO: TherapyEngine will handle ACK tracking (future enhancement)
+            uint32_t seqId = strtoul(args, nullptr, 10);
+            therapy.onMacrocycleAck(seqId);
+#if SYNC_SLACK_FEEDBACK_ENABLED
+            // Slack field: absent from older SECONDARYs and from ACKs of
+            // macrocycles that were not staged
+            SyncCommandView ack;
+            if (ack.parse(message, messageLen) && ack.hasField(0))
+            {
+                leadTimeController.onAck(seqId, ack.i32(0));
+            }
+#endif
+            g_mcTxLastAckedSeq = seqId;
+            g_mcTxAckValid = true;
             if (profiles.getDebugMode())
             {
-                // Parse sequence ID from message
-                uint32_t seqId = strtoul(message + 7, nullptr, 10);
                 Serial.printf("[MACROCYCLE] ACK received seq=%lu\n", (unsigned long)seqId);
             }
         }
         return;
     }
 
-    // Parse sync/internal commands
-    SyncCommand cmd;
-    if (cmd.deserialize(message))
+    // Parse sync/internal commands in place (no per-message copy of the
+    // payload - PONG parsing sits between T4 capture and the offset update)
+    SyncCommandView cmd;
+    if (cmd.parse(message, messageLen))
     {
         // Handle specific command types
         switch (cmd.getType())
@@ -1943,29 +3671,24 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
 
                 // Parse T2 and T3 from PONG data
                 // Format depends on whether high bits are used (see createPongWithTimestamps)
-                // C4 fix: Use getDataUnsigned to avoid sign extension when values > 2^31
+                // C4 fix: fields are decoded unsigned to avoid sign extension when values > 2^31
                 uint64_t t2, t3;
                 uint64_t secondaryAnchor = 0;
-                if (cmd.hasData("2"))
+                if (cmd.hasField(2))
                 {
                     // Full 64-bit: T2High|T2Low|T3High|T3Low[|AnchHigh|AnchLow]
-                    uint32_t t2High = cmd.getDataUnsigned("0", 0);
-                    uint32_t t2Low = cmd.getDataUnsigned("1", 0);
-                    uint32_t t3High = cmd.getDataUnsigned("2", 0);
-                    uint32_t t3Low = cmd.getDataUnsigned("3", 0);
-                    t2 = ((uint64_t)t2High << 32) | t2Low;
-                    t3 = ((uint64_t)t3High << 32) | t3Low;
-                    if (cmd.hasData("4"))
+                    t2 = cmd.u64(0, 1);
+                    t3 = cmd.u64(2, 3);
+                    if (cmd.hasField(4))
                     {
-                        secondaryAnchor = ((uint64_t)cmd.getDataUnsigned("4", 0) << 32) |
-                                          cmd.getDataUnsigned("5", 0);
+                        secondaryAnchor = cmd.u64(4, 5);
                     }
                 }
                 else
                 {
                     // Simple 32-bit: T2|T3
-                    t2 = static_cast<uint64_t>(cmd.getDataUnsigned("0", 0));
-                    t3 = static_cast<uint64_t>(cmd.getDataUnsigned("1", 0));
+                    t2 = static_cast<uint64_t>(cmd.u32(0));
+                    t3 = static_cast<uint64_t>(cmd.u32(1));
                 }
                 (void)secondaryAnchor;  // no-op when anchor timestamping is compiled out
 
@@ -2044,11 +3767,28 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
                 }
 #endif
 
+                // Offset error against the estimate in use, before this
+                // sample moves it (tail of this drives the lucky-packet margin)
+                if ((latencyMetrics.enabled || latencyTelemetry.isStreaming()) &&
+                    syncProtocol.isClockSyncValid()) {
+                    int64_t offsetError = offset - syncProtocol.getOffset();
+                    if (offsetError > INT32_MAX) offsetError = INT32_MAX;
+                    if (offsetError < INT32_MIN) offsetError = INT32_MIN;
+                    if (latencyMetrics.enabled) {
+                        latencyMetrics.recordOffsetError(static_cast<int32_t>(offsetError));
+                    }
+                    latencyTelemetry.recordOffsetError(static_cast<int32_t>(offsetError));
+                }
+
                 // Quality-gated update: routes to initial sample collection
                 // until valid, then applies RTT + lucky-packet + innovation
                 // gates before the maintenance EMA (a single retransmission-
                 // affected exchange must not corrupt the offset mid-therapy)
                 bool sampleAccepted = syncProtocol.updateOffsetEMAWithQuality(offset, rtt);
+                pingScheduler.onPong(sampleAccepted);
+#if BLE_PHY_AUTO_ENABLED
+                phyManager.onExchange(rtt);
+#endif
 
                 // Also update RTT-based latency for backward compatibility
                 syncProtocol.updateLatency(rtt);
@@ -2057,6 +3797,11 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
                 if (latencyMetrics.enabled) {
                     latencyMetrics.recordRtt(rtt);
                 }
+                latencyTelemetry.recordRtt(rtt);
+#if SESSION_JOURNAL_ENABLED
+                sessionJournal.record(JournalRecordType::SYNC, 0, sampleAccepted ? 1 : 0,
+                                      journalClamp(offset), static_cast<int32_t>(rtt));
+#endif
 
                 // Record path asymmetry for diagnostics (measurement only)
                 bool phoneConnected = ble.isPhoneConnected();
@@ -2073,6 +3818,10 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
                                   phoneConnected ? 1 : 0,
                                   syncProtocol.getOffsetSampleCount(),
                                   sampleAccepted ? "" : "(rejected)");
+                    // Raw quadruple (low 32 bits) for scripts/sync_sim.py replay
+                    Serial.printf("[PTP] %lu,%lu,%lu,%lu,%d\n",
+                                  (unsigned long)t1, (unsigned long)t2,
+                                  (unsigned long)t3, (unsigned long)t4, phoneConnected ? 1 : 0);
                 }
 
                 // Use atomic writes for consistency with atomic reads
@@ -2116,24 +3865,21 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
             if (deviceRole == DeviceRole::SECONDARY && profiles.getDebugMode())
             {
                 // Check if this is a PTP sync command with scheduled flash time
-                bool hasPTPTime = cmd.hasData("0");
+                bool hasPTPTime = cmd.hasField(0);
                 if (hasPTPTime && syncProtocol.isClockSyncValid())
                 {
                     // Parse flash time from command
                     uint64_t flashTime;
-                    if (cmd.hasData("1"))
+                    if (cmd.hasField(1))
                     {
                         // Full 64-bit: timeHigh|timeLow
-                        // SP-C1 fix: Use getDataUnsigned() to avoid sign extension for values > 2^31
-                        uint32_t timeHigh = cmd.getDataUnsigned("0", 0);
-                        uint32_t timeLow = cmd.getDataUnsigned("1", 0);
-                        flashTime = ((uint64_t)timeHigh << 32) | timeLow;
+                        // SP-C1 fix: fields are decoded unsigned to avoid sign extension for values > 2^31
+                        flashTime = cmd.u64(0, 1);
                     }
                     else
                     {
                         // Simple 32-bit
-                        // SP-C1 fix: Use getDataUnsigned() to avoid sign extension
-                        flashTime = static_cast<uint64_t>(cmd.getDataUnsigned("0", 0));
+                        flashTime = static_cast<uint64_t>(cmd.u32(0));
                     }
 
                     // Convert PRIMARY clock time to local (SECONDARY) clock time
@@ -2167,6 +3913,374 @@ void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp
     }
 }
 
+// =============================================================================
+// RECEIVED MACROCYCLE SCHEDULING (SECONDARY)
+// =============================================================================
+
+// BLE context: convert a macrocycle to the local clock with its clockOffset
+// and stage its events for the motor task. Returns false if the result is
+// implausibly far from now (nothing staged).
+static bool stageReceivedMacrocycle(const Macrocycle& mc, uint64_t& localBaseTime)
+{
+    // Apply clock offset from PRIMARY (V2 format)
+    // PRIMARY calculated this offset and sent it in the message
+    // CRITICAL: Cast baseTime to signed before adding signed offset,
+    // otherwise negative offset becomes large positive when implicitly converted
+    // Recover any DRV2605 that reset since configuration (VBat
+    // brownout leaves it in standby, silently ignoring this
+    // macrocycle's activations). Deferred to the main loop: this
+    // handler runs in the BLE host task, which must never block
+    // on I2C - a delayed PING/PONG here would inflate an RTT
+    // sample. The loop picks it up within a few ms, still well
+    // inside the >=35ms scheduling lead window. The health monitor
+    // covers this continuously when enabled.
+#if !MOTOR_HEALTH_MONITOR_ENABLED
+    deferredQueue.enqueue(DeferredWorkType::HAPTIC_HEAL);
+#endif
+
+    // NOTE: No absolute bound on the offset itself - it is the
+    // boot-time difference between the two devices, which is
+    // arbitrarily large on reconnect (e.g. one glove rebooted).
+    // Validity is checked below via localBaseTime instead.
+    int64_t offset = mc.clockOffset;
+
+    localBaseTime = static_cast<uint64_t>(static_cast<int64_t>(mc.baseTime) + offset);
+
+    // SAFETY: Validate localBaseTime is reasonable (within ±30 seconds of now)
+    uint64_t nowUs = getMicros();
+
+    // Debug logging for offset application
+    if (profiles.getDebugMode())
+    {
+        int64_t timeUntilExec = static_cast<int64_t>(localBaseTime) - static_cast<int64_t>(nowUs);
+        Serial.printf("[MACROCYCLE] Received seq=%lu offset=%ld baseTime=%lu -> localBaseTime=%lu (rxAt=%lu, timeUntilExec=%ld)\n",
+                      (unsigned long)mc.sequenceId,
+                      (long)offset,
+                      (unsigned long)(mc.baseTime / 1000),
+                      (unsigned long)(localBaseTime / 1000),
+                      (unsigned long)(nowUs / 1000),
+                      (long)(timeUntilExec / 1000));
+    }
+    int64_t timeDiff = static_cast<int64_t>(localBaseTime) - static_cast<int64_t>(nowUs);
+    // Corruption guard: legitimate values are now + lead time
+    // (35-50ms) plus BLE delivery jitter. 5s is ~100x that
+    // margin while still rejecting a corrupt offset/baseTime
+    // that would otherwise schedule far-off activations.
+    constexpr int64_t MAX_TIME_DIFF = 5000000LL;  // 5 seconds
+    if (timeDiff > MAX_TIME_DIFF || timeDiff < -MAX_TIME_DIFF)
+    {
+        // SP-C3 fix: Use split print for 64-bit value (ARM long is 32-bit)
+        int64_t diffSec = timeDiff / 1000000;
+        Serial.printf("[ERROR] MACROCYCLE rejected: baseTime %ld seconds from now\n",
+                      (long)diffSec);  // Division reduces to 32-bit safe range
+        return false;
+    }
+
+#if SESSION_JOURNAL_ENABLED
+    sessionJournal.record(JournalRecordType::MACROCYCLE, 0, mc.eventCount,
+                          static_cast<int32_t>(mc.sequenceId), journalClamp(offset));
+#endif
+
+    // TP-1: Stage all events via lock-free buffer (ISR-safe); the
+    // motor task drains them into activationQueue when notified.
+    // Pipelined: the previous macrocycle may still be playing, so
+    // append instead of having the motor task clear the queue
+    if (!g_mcPipelineActive)
+    {
+        motorEventBuffer.beginMacrocycle();
+    }
+    uint8_t validEvents = 0;
+    uint8_t lastValidIndex = 0;
+
+    // First pass: count valid events to mark the last one
+    for (uint8_t i = 0; i < mc.eventCount; i++)
+    {
+        const MacrocycleEvent& evt = mc.events[i];
+        if (evt.amplitude > 0 && evt.finger < MAX_ACTUATORS)
+        {
+            lastValidIndex = i;
+            validEvents++;
+        }
+    }
+
+    // Second pass: stage all valid events
+    uint8_t stagedCount = 0;
+    for (uint8_t i = 0; i < mc.eventCount; i++)
+    {
+        const MacrocycleEvent& evt = mc.events[i];
+
+        // Skip invalid events (garbage from truncated messages)
+        if (evt.amplitude == 0 || evt.finger >= MAX_ACTUATORS)
+        {
+            continue;
+        }
+
+        uint64_t localActivateTime = localBaseTime + (evt.deltaTimeMs * 1000ULL);
+        uint16_t freqHz = evt.getFrequencyHz();
+        bool isLast = (i == lastValidIndex);
+
+        motorEventBuffer.stage(localActivateTime, evt.finger, evt.amplitude,
+                               evt.durationMs, freqHz, isLast);
+        stagedCount++;
+    }
+
+    // Wake the motor task to schedule the batch now
+    // (Serial.printf moved to main loop to avoid ISR context I/O)
+    if (stagedCount > 0)
+    {
+        activationQueue.notifyMotorTask();
+    }
+    return true;
+}
+
+#if SYNC_PERIODIC_ADV_ENABLED
+// BLE context: take ownership of a cycle for whichever path (train or GATT)
+// delivers it first. Returns false if it was already staged.
+static bool claimReceivedMacrocycle(uint32_t sequenceId)
+{
+    if (g_mcRxStagedValid && static_cast<int32_t>(sequenceId - g_mcRxStagedSeq) <= 0)
+    {
+        return false;
+    }
+    g_mcRxStagedValid = true;
+    g_mcRxStagedSeq = sequenceId;
+    return true;
+}
+
+/**
+ * @brief Periodic advertising report from the PRIMARY's train (BLE context)
+ *
+ * Every report refines the train offset. Once it is locked, a macrocycle not
+ * yet staged from GATT is scheduled from here; the GATT copy still carries
+ * the ACK. Seeded sessions stay on GATT (tick and coast bookkeeping).
+ */
+static void onScheduleBroadcast(const uint8_t* data, size_t length, uint64_t rxTimestamp)
+{
+    ScheduleTrain train;
+    Macrocycle mc;
+    if (!ScheduleBroadcast::decode(data, length, train, mc))
+    {
+        return;
+    }
+
+    g_scheduleTracker.onReport(train, rxTimestamp);
+    if (!g_scheduleTracker.isLocked() || g_mcSeededActive || !claimReceivedMacrocycle(mc.sequenceId))
+    {
+        return;
+    }
+
+    mc.clockOffset = g_scheduleTracker.getOffset();
+    uint64_t localBaseTime = 0;
+    stageReceivedMacrocycle(mc, localBaseTime);
+}
+#endif
+
+// =============================================================================
+// SEEDED MACROCYCLE COASTING (SECONDARY)
+// =============================================================================
+
+// BLE context: take ownership of a received tick's cycle. Returns false if
+// the main loop already played that cycle while coasting.
+static bool claimSeededTick(uint32_t sequenceId)
+{
+    bool fresh;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        fresh = !g_seededCoast.seqValid ||
+                static_cast<int32_t>(sequenceId - g_seededCoast.lastSeq) > 0;
+        if (fresh)
+        {
+            g_seededCoast.seqValid = true;
+            g_seededCoast.lastSeq = sequenceId;
+            g_seededCoast.armed = false;
+            g_seededCoast.coasted = 0;
+        }
+        PLATFORM_CRITICAL_EXIT();
+    }
+    return fresh;
+}
+
+// BLE context: the cycle after the one just staged is due at nextLocalBaseUs
+static void armSeededCoast(uint64_t nextLocalBaseUs)
+{
+    PLATFORM_CRITICAL_ENTER();
+    g_seededCoast.nextLocalBaseUs = nextLocalBaseUs;
+    g_seededCoast.armed = true;
+    PLATFORM_CRITICAL_EXIT();
+}
+
+static void disarmSeededCoast()
+{
+    PLATFORM_CRITICAL_ENTER();
+    g_seededCoast.armed = false;
+    g_seededCoast.seqValid = false;
+    PLATFORM_CRITICAL_EXIT();
+}
+
+/**
+ * @brief Play the next seeded cycle locally when its tick is late (main loop)
+ *
+ * Only armed on pipelined links, where PRIMARY chains each baseTime to the
+ * previous cycle's end plus 2x TIME_RELAX, so the SECONDARY can predict it.
+ * A tick that arrives later for a coasted cycle is ACKed but not replayed.
+ */
+static void coastSeededMacrocycle()
+{
+    if (deviceRole != DeviceRole::SECONDARY || motorTaskHandle == nullptr ||
+        stateMachine.getCurrentState() != TherapyState::RUNNING)
+    {
+        return;
+    }
+
+    uint64_t nowUs = getMicros();
+    bool due = false;
+    uint32_t seq = 0;
+    uint64_t localBase = 0;
+    SchedulePlan plan;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        if (g_seededCoast.armed && g_mcRxSessionValid)
+        {
+            if (nowUs > g_seededCoast.nextLocalBaseUs)
+            {
+                g_seededCoast.armed = false;  // Missed it: never play late
+            }
+            else if (g_seededCoast.coasted < MACROCYCLE_SEEDED_COAST_CYCLES &&
+                     nowUs + (MACROCYCLE_SEEDED_COAST_GUARD_MS * 1000ULL) >= g_seededCoast.nextLocalBaseUs)
+            {
+                due = true;
+                seq = ++g_seededCoast.lastSeq;
+                localBase = g_seededCoast.nextLocalBaseUs;
+                g_seededCoast.coasted++;
+                g_seededCoast.armed = false;  // Re-armed below once generated
+                plan = g_mcRxPlan;
+            }
+        }
+        PLATFORM_CRITICAL_EXIT();
+    }
+    if (!due)
+    {
+        return;
+    }
+
+    Macrocycle mc;
+    generateSeededMacrocycle(plan, seq, mc);
+    for (uint8_t i = 0; i < mc.eventCount; i++)
+    {
+        const MacrocycleEvent& evt = mc.events[i];
+        if (evt.amplitude == 0 || evt.finger >= MAX_ACTUATORS)
+        {
+            continue;
+        }
+        activationQueue.enqueue(localBase + (evt.deltaTimeMs * 1000ULL), evt.finger, evt.amplitude,
+                                evt.durationMs, evt.getFrequencyHz());
+    }
+    activationQueue.scheduleNext();
+
+    uint64_t nextBase = localBase + (static_cast<uint64_t>(mc.getTotalDurationMs()) * 1000ULL) +
+                        plan.doubleRelaxUs;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        // A tick may have claimed a newer cycle meanwhile
+        if (g_seededCoast.seqValid && g_seededCoast.lastSeq == seq)
+        {
+            g_seededCoast.nextLocalBaseUs = nextBase;
+            g_seededCoast.armed = true;
+        }
+        PLATFORM_CRITICAL_EXIT();
+    }
+
+    Serial.printf("[MACROCYCLE] Tick late - coasting seq=%lu\n", (unsigned long)seq);
+}
+
+#if SYNC_SKEW_CAL_ENABLED
+// =============================================================================
+// SKEW CALIBRATION (PRIMARY)
+// =============================================================================
+
+static int16_t readDieTemperatureQ()
+{
+    int16_t quarterC;
+    return platformDieTemperatureQ(quarterC) ? quarterC : SKEW_CAL_NO_TEMPERATURE;
+}
+
+/**
+ * @brief Seed the drift estimate from this SECONDARY's saved skew (cold start)
+ */
+static void seedSkewCalibration()
+{
+    if (!g_secondaryAddrValid)
+    {
+        return;
+    }
+    float skew, sigma;
+    if (!skewCal.lookup(g_secondaryAddr, readDieTemperatureQ(), skew, sigma))
+    {
+        return;
+    }
+    syncProtocol.seedDriftRate(skew, sigma);
+    Serial.printf("[SYNC] Skew seeded from calibration: %+.5f us/ms (sigma %.5f) - need %u samples\n",
+                  skew, sigma, SYNC_SKEW_CAL_MIN_SAMPLES);
+}
+
+/**
+ * @brief Record the converged skew and write it out while idle
+ *
+ * Tracked only after SYNC_SKEW_CAL_MIN_TRACK_MS of continuous valid sync so
+ * the drift window has spanned enough time to mean something. Recorded every
+ * SYNC_SKEW_CAL_SAVE_INTERVAL_MS and once more on disconnect; flash is
+ * written only outside therapy.
+ */
+static void updateSkewCalibration(uint32_t now)
+{
+    static uint32_t validSinceMs = 0;
+    static uint32_t lastRecordMs = 0;
+    static bool tracking = false;
+    static bool savePending = false;
+
+    bool flush = g_skewCalFlushPending;
+    bool linked = ble.isSecondaryConnected() && syncProtocol.isClockSyncValid();
+
+    if (!flush && !linked)
+    {
+        tracking = false;
+    }
+    else if (!tracking && linked)
+    {
+        tracking = true;
+        validSinceMs = now;
+        lastRecordMs = now;
+    }
+
+    bool converged = tracking && g_secondaryAddrValid &&
+                     (now - validSinceMs >= SYNC_SKEW_CAL_MIN_TRACK_MS);
+    if (converged && (flush || now - lastRecordMs >= SYNC_SKEW_CAL_SAVE_INTERVAL_MS))
+    {
+        lastRecordMs = now;
+        skewCal.record(g_secondaryAddr, syncProtocol.getDriftRate(),
+                       syncProtocol.getDriftRateSigma(), readDieTemperatureQ());
+        savePending = true;
+    }
+
+    if (flush)
+    {
+        g_skewCalFlushPending = false;
+        g_secondaryAddrValid = false;
+        tracking = false;
+    }
+
+    // One attempt per record: a failing filesystem is not retried every pass
+    if (savePending && !therapy.isRunning())
+    {
+        savePending = false;
+        if (!skewCal.save())
+        {
+            Serial.println(F("[SYNC] Skew calibration save failed"));
+        }
+    }
+}
+#endif
+
 // =============================================================================
 // THERAPY CALLBACKS
 // =============================================================================
@@ -2183,7 +4297,20 @@ void onSendMacrocycle(const Macrocycle& macrocycle)
     }
 
     // Clear activation queue for new macrocycle (PRIMARY will enqueue via callbacks)
-    activationQueue.clear();
+    // unless streaming, where the previous macrocycle may still be playing
+    if (!therapy.isMacrocyclePipelined())
+    {
+        activationQueue.clear();
+    }
+
+#if BLE_MAX_SECONDARIES > 1
+    fanOutMacrocycle(macrocycle);
+#endif
+
+#if SYNC_PERIODIC_ADV_ENABLED
+    // Every listener applies its own train offset: one copy for all
+    ble.broadcastSchedule(macrocycle);
+#endif
 
     // Make a local copy to set clock offset (callback receives const reference)
     Macrocycle mcCopy = macrocycle;
@@ -2192,27 +4319,231 @@ void onSendMacrocycle(const Macrocycle& macrocycle)
     // This allows SECONDARY to convert PRIMARY's baseTime to its local clock
     mcCopy.clockOffset = syncProtocol.getCorrectedOffset();
 
-    // Serialize macrocycle to buffer
-    char buffer[MESSAGE_BUFFER_SIZE];
-    if (SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mcCopy))
+    // Every message is serialized straight into its TX slot. Slots are
+    // reserved in send order: session/template before the cycle itself.
+    uint16_t secondaryHandle = ble.getSecondaryHandle();
+    BLETxSpan span;
+
+    if (g_mcTxResetPending)
+    {
+        g_mcTxResetPending = false;
+        g_mcTxTemplateSent = false;
+        g_mcTxSessionSent = false;
+        g_mcTxHistory.clear();
+    }
+
+    // Seeded: SECONDARY regenerates the events, so only a tick goes out
+    // (preceded by the session params whenever any of them changes)
+    bool sendTick = false;
+    SeededSessionParams params;
+    if (therapy.isSeededGeneration() && g_mcSeededActive &&
+        g_secondaryMcWireVersion >= MACROCYCLE_WIRE_V7)
+    {
+        therapy.getSeededSessionParams(params);
+        if (!g_mcTxSessionSent || !params.sameSession(g_mcTxSession))
+        {
+            span = ble.reserveTx(secondaryHandle, MESSAGE_BUFFER_SIZE);
+            bool ok = span && SyncCommand::serializeSeededSession(span.data, span.capacity, params);
+            g_mcTxSessionSent = ble.commitTx(span, ok ? strlen(span.data) : 0);
+            g_mcTxSession = params;
+        }
+        sendTick = g_mcTxSessionSent;
+    }
+
+    // V7: a delta against a macrocycle SECONDARY already acknowledged, once
+    // it holds the template; anything the delta cannot express goes full
+    bool haveDeltaRef = false;
+    MacrocycleReference ref;
+    if (!sendTick && g_secondaryMcWireVersion >= MACROCYCLE_WIRE_V7)
+    {
+        MacrocycleTemplate tmpl;
+        bool fitsTemplate = SyncCommand::buildMacrocycleTemplate(mcCopy, therapy.getNominalEventSpacingMs(), tmpl);
+        if (fitsTemplate && (!g_mcTxTemplateSent || !tmpl.sameStructure(g_mcTxTemplate)))
+        {
+            g_mcTxTemplateSent = false;
+            span = ble.reserveTx(secondaryHandle, MESSAGE_BUFFER_SIZE);
+            bool ok = span && SyncCommand::serializeMacrocycleTemplate(span.data, span.capacity, tmpl);
+            if (ble.commitTx(span, ok ? strlen(span.data) : 0))
+            {
+                g_mcTxTemplate = tmpl;
+                g_mcTxTemplateSent = true;
+                g_mcTxTemplateFirstSeq = mcCopy.sequenceId;
+            }
+        }
+        else if (fitsTemplate && g_mcTxAckValid)
+        {
+            uint32_t lastAcked = g_mcTxLastAckedSeq;
+            haveDeltaRef = static_cast<int32_t>(lastAcked - g_mcTxTemplateFirstSeq) >= 0 &&
+                           g_mcTxHistory.findNewestInRange(g_mcTxTemplateFirstSeq, lastAcked, ref);
+        }
+    }
+
+    span = ble.reserveTx(secondaryHandle, MESSAGE_BUFFER_SIZE);
+    if (!span)
+    {
+        return;  // Not connected or queue full (logged by BLEManager)
+    }
+
+    bool serialized = false;
+    bool isTick = false;
+    bool isDelta = false;
+    if (sendTick)
+    {
+        MacrocycleReference tick;
+        tick.sequenceId = mcCopy.sequenceId;
+        tick.baseTime = mcCopy.baseTime;
+        tick.clockOffset = mcCopy.clockOffset;
+        isTick = SyncCommand::serializeMacrocycleTick(span.data, span.capacity, params.seed, tick);
+        serialized = isTick;
+    }
+    if (!serialized && haveDeltaRef)
+    {
+        isDelta = SyncCommand::serializeMacrocycleDelta(span.data, span.capacity, mcCopy, g_mcTxTemplate, ref);
+        serialized = isDelta;
+    }
+    if (!serialized)
+    {
+        serialized = SyncCommand::serializeMacrocycle(span.data, span.capacity, mcCopy, g_secondaryMcWireVersion);
+    }
+
+    if (serialized)
     {
-        ble.sendToSecondary(buffer);
+        if (ble.commitTx(span, strlen(span.data)))
+        {
+            g_mcTxHistory.record(mcCopy);
+#if SYNC_SLACK_FEEDBACK_ENABLED
+            int64_t leadUs = static_cast<int64_t>(mcCopy.baseTime) - static_cast<int64_t>(getMicros());
+            leadTimeController.onSent(mcCopy.sequenceId, leadUs > 0 ? static_cast<uint32_t>(leadUs) : 0);
+#endif
+        }
+#if SESSION_JOURNAL_ENABLED
+        sessionJournal.record(JournalRecordType::MACROCYCLE, 0, macrocycle.eventCount,
+                              static_cast<int32_t>(macrocycle.sequenceId), journalClamp(mcCopy.clockOffset));
+#endif
 
         if (profiles.getDebugMode())
         {
-            Serial.printf("[MACROCYCLE] Sent seq=%lu events=%u baseTime=%lu offset=%ld\n",
+            Serial.printf("[MACROCYCLE] Sent seq=%lu events=%u baseTime=%lu offset=%ld%s\n",
                           (unsigned long)macrocycle.sequenceId,
                           macrocycle.eventCount,
                           (unsigned long)(macrocycle.baseTime / 1000),
-                          (long)mcCopy.clockOffset);
+                          (long)mcCopy.clockOffset,
+                          isTick ? " (tick)" : (isDelta ? " (delta)" : ""));
         }
     }
     else
     {
+        ble.commitTx(span, 0);
         Serial.println(F("[ERROR] Failed to serialize MACROCYCLE"));
     }
 }
 
+#if BLE_MAX_SECONDARIES > 1
+/**
+ * @brief Send one macrocycle to every synced extra SECONDARY
+ *
+ * Encoded once as V6; each peer's copy differs only in its clock offset
+ * (MacrocycleFanoutFrame). Peers that predate V6 get a per-peer V5 text
+ * frame. Unsynced peers get nothing - they would fire at the wrong time.
+ */
+static void fanOutMacrocycle(const Macrocycle& macrocycle)
+{
+    static MacrocycleFanoutFrame fanout;  // Loop task only
+    bool prepared = false;
+
+    for (uint8_t i = 0; i < extraPeers.count(); i++)
+    {
+        SecondaryPeer& peer = extraPeers.at(i);
+        if (peer.retiring || !peer.sync.isClockSyncValid())
+        {
+            continue;
+        }
+
+        BLETxSpan span = ble.reserveTx(peer.connHandle, MESSAGE_BUFFER_SIZE);
+        if (!span)
+        {
+            continue;  // That link is congested: it misses this cycle only
+        }
+
+        int64_t offset = peer.sync.getCorrectedOffset();
+        size_t len = 0;
+        if (peer.mcWireVersion >= MACROCYCLE_WIRE_V6)
+        {
+            if (!prepared)
+            {
+                prepared = fanout.prepare(macrocycle);
+            }
+            len = prepared ? fanout.patch(offset, span.data, span.capacity) : 0;
+        }
+        else
+        {
+            Macrocycle mcCopy = macrocycle;
+            mcCopy.clockOffset = offset;
+            if (SyncCommand::serializeMacrocycle(span.data, span.capacity, mcCopy, MACROCYCLE_WIRE_V5))
+            {
+                len = strlen(span.data);
+            }
+        }
+        ble.commitTx(span, len);
+
+        if (profiles.getDebugMode())
+        {
+            Serial.printf("[MACROCYCLE] Fan-out seq=%lu handle=%d offset=%ld%s\n",
+                          (unsigned long)macrocycle.sequenceId, peer.connHandle,
+                          (long)offset, len ? "" : " (failed)");
+        }
+    }
+}
+
+/**
+ * @brief Handle a message from an extra SECONDARY (BLE callback context)
+ */
+static void handleExtraPeerMessage(SecondaryPeer& peer, const char* message, size_t messageLen,
+                                   uint64_t rxTimestamp)
+{
+    std::string_view text(message, messageLen);
+    InternalMessage kind = classifyMessage(text);
+
+    if (kind == InternalMessage::MC_VER)
+    {
+        // Extras get full frames only: no template/delta, pipeline or seeding
+        uint32_t peerVersion = strtoul(internalMessageArgs(message, kind), nullptr, 10);
+        peer.mcWireVersion = (peerVersion >= MACROCYCLE_WIRE_V6) ? MACROCYCLE_WIRE_V6 : MACROCYCLE_WIRE_V5;
+        char reply[24];
+        snprintf(reply, sizeof(reply), "MC_VER:%u|0", peer.mcWireVersion);
+        ble.send(peer.connHandle, reply);
+        return;
+    }
+
+    SyncCommandView cmd;
+    if (!cmd.parse(message, messageLen) || cmd.getType() != SyncCommandType::PONG)
+    {
+        return;  // Only clock sync traffic is expected from extra peers
+    }
+
+    uint64_t t2, t3;
+    if (cmd.hasField(2))
+    {
+        t2 = cmd.u64(0, 1);
+        t3 = cmd.u64(2, 3);
+    }
+    else
+    {
+        t2 = static_cast<uint64_t>(cmd.u32(0));
+        t3 = static_cast<uint64_t>(cmd.u32(1));
+    }
+    bool accepted = extraPeers.onPong(peer, cmd.getSequenceId(), t2, t3, rxTimestamp, millis());
+
+    if (profiles.getDebugMode())
+    {
+        Serial.printf("[SYNC] Extra %d offset=%ld rtt=%lu samples=%u %s\n", peer.connHandle,
+                      (long)peer.sync.getCorrectedOffset(),
+                      (unsigned long)peer.sync.getAverageRTT(),
+                      peer.sync.getOffsetSampleCount(), accepted ? "" : "(rejected)");
+    }
+}
+#endif
+
 void onActivate(uint8_t finger, uint8_t amplitude)
 {
     // When SECONDARY is connected, MACROCYCLE batching handles PRIMARY activation
@@ -2273,12 +4604,59 @@ bool onIsSchedulingComplete()
     return activationQueue.isComplete();
 }
 
-uint32_t onGetLeadTime()
+/**
+ * @brief Open-loop MACROCYCLE lead: connection-event bound, else RTT + 3σ
+ */
+static uint32_t openLoopLeadTimeUs()
 {
-    // Return adaptive lead time based on measured RTT + 3σ margin
+#if SYNC_ANCHORED_LEAD_ENABLED
+    // Bound the handoff-to-delivery time by the SECONDARY link's connection
+    // events. The MACROCYCLE is written to the stack right after this call
+    // and leaves at the next event: predicted from radio anchors when the
+    // link is the only periodic radio user, else up to one full interval.
+    float intervalMs = ble.getSecondaryConnectionIntervalMs();
+    if (intervalMs > 0.0f)
+    {
+        uint32_t intervalUs = static_cast<uint32_t>(intervalMs * 1000.0f);
+        uint32_t waitUs = intervalUs;
+        uint64_t nowUs = getMicros();
+        uint64_t nextAnchorUs;
+        if (radioAnchorPredictNext(nowUs, intervalUs, nextAnchorUs))
+        {
+            waitUs = static_cast<uint32_t>(nextAnchorUs - nowUs) + RADIO_ANCHOR_DISTANCE_US;
+        }
+        return syncProtocol.calculateAnchoredLeadTime(waitUs, intervalUs);
+    }
+#endif
+    // Interval not known yet: measured RTT + 3σ margin
     return syncProtocol.calculateAdaptiveLeadTime();
 }
 
+uint32_t onGetLeadTime()
+{
+    uint32_t leadUs = openLoopLeadTimeUs();
+#if SYNC_SLACK_FEEDBACK_ENABLED
+    // Measured send-to-staged delays from MC_ACK slack replace the model
+    // once enough have arrived
+    uint32_t nowMs = millis();
+    leadTimeController.update(nowMs);
+    leadUs = leadTimeController.leadTimeUs(leadUs, nowMs);
+#if BLE_PHY_AUTO_ENABLED
+    // Until feedback closes the loop on this PHY again, keep at least the
+    // lead it last ran with (the open loop already uses its cached RTTs)
+    uint32_t phyLeadUs = g_phyLeadUs[PhyManager::slot(g_linkPhy)];
+    if (!leadTimeController.active(nowMs) && phyLeadUs > leadUs)
+    {
+        leadUs = phyLeadUs;
+    }
+#endif
+#endif
+#if BLE_MAX_SECONDARIES > 1
+    leadUs = extraPeers.maxLeadTimeUs(leadUs);  // The slowest peer sets the lead
+#endif
+    return leadUs;
+}
+
 void onCycleComplete(uint32_t cycleCount)
 {
     Serial.printf("[THERAPY] Cycle %lu complete\n", cycleCount);
@@ -2290,8 +4668,19 @@ void onMacrocycleStart(uint32_t macrocycleCount)
     // leaves it in standby, silently ignoring the coming activations).
     // Round-robin single-chip probe (~200us); runs here in the loop task
     // during the relax gap, BEFORE the macrocycle base timestamp is
-    // captured, so scheduled event timing is unaffected.
-    haptic.verifyAndHeal();
+    // captured, so scheduled event timing is unaffected. The health
+    // monitor covers this continuously when enabled.
+#if !MOTOR_HEALTH_MONITOR_ENABLED
+    uint8_t healed = haptic.verifyAndHeal();
+#if SESSION_JOURNAL_ENABLED
+    if (healed > 0)
+    {
+        sessionJournal.record(JournalRecordType::HEAL, healed, 0, 0, 0);
+    }
+#else
+    (void)healed;
+#endif
+#endif
 
     // Clock sync handled by main loop 1-second PING interval
     // No additional PING needed at macrocycle boundary
@@ -2409,7 +4798,7 @@ void startTherapyTest()
     Serial.printf("|  STARTING %lu-SECOND TEST SESSION  (send STOP to end)      |\n", durationSec);
     Serial.printf("|  Profile: %-46s |\n", profile->name);
     Serial.printf("|  Pattern: %-4s | Jitter: %5.1f%% | Mirror: %-3s             |\n",
-                  profile->patternType, profile->jitterPercent,
+                  profile->patternType, profile->timing.jitterPercent(),
                   profile->mirrorPattern ? "ON" : "OFF");
     Serial.println(F("+============================================================+\n"));
 
@@ -2442,9 +4831,7 @@ void startTherapyTest()
     therapy.startSession(
         durationSec,
         patternType,
-        profile->timeOnMs,
-        profile->timeOffMs,
-        profile->jitterPercent,
+        profile->timing,
         profile->numFingers,
         profile->mirrorPattern,
         profile->amplitudeMin,
@@ -2515,8 +4902,7 @@ void autoStartTherapy()
         {
             Serial.printf("[AUTO] Sync not valid (attempt %u/10) - retrying in 1 second\n", g_autoStartRetryCount);
             // Schedule retry in 1 second
-            autoStartScheduled = true;
-            autoStartTime = millis() + 1000;
+            armLoopTimer(g_autoStartRetryTimer, 1000);
             return;
         }
     }
@@ -2559,7 +4945,7 @@ void autoStartTherapy()
     Serial.println(F("|  AUTO-STARTING THERAPY (no phone connected)                |"));
     Serial.printf("|  Profile: %-46s |\n", profile->name);
     Serial.printf("|  Duration: %d min | Pattern: %-4s | Jitter: %5.1f%%\n",
-                  profile->sessionDurationMin, profile->patternType, profile->jitterPercent);
+                  profile->sessionDurationMin, profile->patternType, profile->timing.jitterPercent());
     Serial.println(F("+============================================================+\n"));
 
     // Update state machine - abort if the transition is invalid so therapy
@@ -2588,9 +4974,7 @@ void autoStartTherapy()
     therapy.startSession(
         durationSec,
         patternType,
-        profile->timeOnMs,
-        profile->timeOffMs,
-        profile->jitterPercent,
+        profile->timing,
         profile->numFingers,
         profile->mirrorPattern,
         profile->amplitudeMin,
@@ -2621,9 +5005,9 @@ void triggerDebugFlash()
     // Flash WHITE (overrides THERAPY_LED_OFF)
     led.setPattern(Colors::WHITE, LEDPattern::SOLID);
 
-    // Schedule restoration after 50ms (handled in loop())
-    debugFlashEndTime = millis() + 50;
+    // Schedule restoration after 50ms (g_debugFlashTimer, runs in loop())
     debugFlashActive = true;
+    armLoopTimer(g_debugFlashTimer, 50);
 
     if (profiles.getDebugMode())
     {
@@ -2659,18 +5043,41 @@ void sendPing()
     // above, and a queue-full drop just defers this PTP sample one interval -
     // keepalive timeouts are driven by received traffic, not sent PINGs.
     ble.sendPingStamped(g_sequenceGenerator.next());
+
+#if BLE_MAX_SECONDARIES > 1
+    // Each extra SECONDARY gets its own exchange on the same cadence
+    for (uint8_t i = 0; i < extraPeers.count(); i++)
+    {
+        SecondaryPeer& peer = extraPeers.at(i);
+        if (peer.retiring)
+        {
+            continue;
+        }
+        uint32_t seq = g_sequenceGenerator.next();
+        extraPeers.beginPing(peer, seq);
+        ble.sendPingStamped(seq, peer.connHandle);
+    }
+#endif
 }
 
 void onTxStamped(TxStampKind kind, uint32_t seqId, uint64_t txTimeUs)
 {
-    // Runs in main-loop context (processTxQueue via ble.update()), FreeRTOS
-    // loop task (prio 1). The PONG handler runs in the higher-priority BLE
-    // task (prio 3) and can preempt this code mid-update. pingT1 and pingSeq
+    // Runs wherever processTxQueue runs: the main loop (ble.update(), loop
+    // task prio 1) on nRF52, the core-0 BLE TX task on ESP32-S3. The PONG
+    // handler runs in the BLE task (prio 3 / NimBLE host) and can preempt
+    // this code, or run concurrently on the other core. pingT1 and pingSeq
     // must be published as ONE unit: a split update would let the reader pair
     // a stale PONG (matching the old pingSeq) with the freshly written T1.
-    // A single critical section masks the PendSV context switch (PRIMASK), so
-    // the BLE task cannot observe the triple half-updated. Per-store atomicity
+    // A single critical section masks the PendSV context switch (PRIMASK; a
+    // spinlock across cores on ESP32-S3), so the BLE task cannot observe the
+    // triple half-updated. Per-store atomicity
     // (atomicWrite64) is insufficient here — the invariant spans variables.
+#if BLE_MAX_SECONDARIES > 1
+    if (kind == TxStampKind::PING_T1 && extraPeers.onPingStamped(seqId, txTimeUs))
+    {
+        return;  // An extra SECONDARY's PING
+    }
+#endif
     if (kind == TxStampKind::PING_T1)
     {
         PLATFORM_CRITICAL_ENTER();
@@ -2683,6 +5090,148 @@ void onTxStamped(TxStampKind kind, uint32_t seqId, uint64_t txTimeUs)
     // SECONDARY, where no T1 pairing state exists.
 }
 
+// =============================================================================
+// LATE EVENT RESYNC
+// =============================================================================
+
+/**
+ * @brief Send the late-event policy's resync request (loop task)
+ *
+ * The SECONDARY asks the PRIMARY (MC_RESYNC) to re-measure the clock and
+ * restart macrocycle deltas from a full frame. On the PRIMARY a late run is
+ * only counted and logged.
+ */
+static void serviceLateEventResync()
+{
+    if (!latePolicy.takeResyncRequest())
+    {
+        return;
+    }
+    latencyMetrics.resyncRequestCount++;
+    Serial.printf("[LATE] %lu activations late (max %lu us) - macrocycle compromised\n",
+                  (unsigned long)LATE_EVENT_RESYNC_RUN, (unsigned long)latencyMetrics.maxLateness_us);
+
+    if (deviceRole == DeviceRole::SECONDARY && ble.isPrimaryConnected())
+    {
+        char message[32];
+        snprintf(message, sizeof(message), "MC_RESYNC:%lu", (unsigned long)latencyMetrics.maxLateness_us);
+        ble.sendToPrimary(message, TxPriority::SYNC);
+    }
+}
+
+#if BLE_PHY_AUTO_ENABLED
+// =============================================================================
+// SYNC LINK PHY
+// =============================================================================
+
+/**
+ * @brief Forget every PHY's cached statistics (new link, new interval)
+ */
+static void clearPhyCache()
+{
+    for (uint8_t i = 0; i < BLE_PHY_COUNT; i++)
+    {
+        g_phyLinkStats[i] = SimpleSyncProtocol::LinkStats();
+        g_phyLeadUs[i] = 0;
+    }
+}
+
+/**
+ * @brief The sync link moved to phy: swap in its cached RTT statistics
+ *
+ * The clock offset and drift carry over; latency, RTT variance, the
+ * lucky-packet minimum and asymmetry are the new PHY's from its last
+ * stint (or start fresh), so the lead time fits the PHY at once.
+ */
+static void switchPhyStatistics(BlePhy phy, uint32_t now)
+{
+    BlePhy from = g_linkPhy;
+    g_phyLinkStats[PhyManager::slot(from)] = syncProtocol.getLinkStats();
+#if SYNC_SLACK_FEEDBACK_ENABLED
+    if (leadTimeController.active(now))
+    {
+        g_phyLeadUs[PhyManager::slot(from)] = leadTimeController.closedLoopLeadUs();
+    }
+    leadTimeController.requestReset();  // Delivery delays changed with the PHY
+#endif
+
+    const SimpleSyncProtocol::LinkStats& cached = g_phyLinkStats[PhyManager::slot(phy)];
+    syncProtocol.restoreLinkStats(cached);
+    g_linkPhy = phy;
+    phyManager.onPhyChanged(phy, now);
+    pingScheduler.requestBurst();  // Refresh the new PHY's RTT now
+    Serial.printf("[BLE] PHY %s -> %s - %s RTT statistics\n", blePhyName(from), blePhyName(phy),
+                  cached.sampleCount > 0 ? "restored cached" : "starting fresh");
+
+    // Reset clock sync if few samples collected during PHY transition
+    // (samples before and after PHY change have inconsistent RTT)
+    if (syncProtocol.getOffsetSampleCount() > 0 &&
+        syncProtocol.getOffsetSampleCount() < SYNC_MIN_VALID_SAMPLES)
+    {
+        syncProtocol.resetClockSync();
+        Serial.println(F("[SYNC] Clock sync reset due to PHY transition"));
+#if SYNC_SKEW_CAL_ENABLED
+        seedSkewCalibration();
+#endif
+    }
+}
+
+/**
+ * @brief Track the sync link's PHY and, on the PRIMARY, choose it (loop task)
+ *
+ * The PHY is read back from the stack on the nRF52 PHY event and every
+ * BLE_PHY_AUTO_EVAL_MS (NimBLE raises no PHY event here), whichever side
+ * started the change. PhyManager then decides from the PING/PONG exchanges.
+ */
+static void servicePhy(uint32_t now)
+{
+    static uint32_t lastReadMs = 0;
+
+    if (g_phyLinkUp)
+    {
+        g_phyLinkUp = false;
+        clearPhyCache();
+        g_linkPhy = BlePhy::PHY_1M;  // Every link comes up on 1M
+        phyManager.onLinkUp();
+    }
+
+    // The event fires for phone links too: only the sync link is read
+    bool phyEvent = g_phyChangeDetected;
+    g_phyChangeDetected = false;
+
+    bool primary = (deviceRole == DeviceRole::PRIMARY);
+    if (primary ? !ble.isSecondaryConnected() : !ble.isPrimaryConnected())
+    {
+        return;
+    }
+    uint16_t handle = primary ? ble.getSecondaryHandle() : ble.getPrimaryHandle();
+
+    if (phyEvent || now - lastReadMs >= BLE_PHY_AUTO_EVAL_MS)
+    {
+        lastReadMs = now;
+        BlePhy phy;
+        if (blePhyFromMask(ble.getPhy(handle), phy) && phy != g_linkPhy)
+        {
+            switchPhyStatistics(phy, now);
+        }
+    }
+
+    if (!primary)
+    {
+        return;
+    }
+    uint32_t intervalUs = static_cast<uint32_t>(ble.getSecondaryConnectionIntervalMs() * 1000.0f);
+    BlePhy request;
+    if (phyManager.update(now, intervalUs, pingScheduler.missedPongs(), request))
+    {
+        Serial.printf("[BLE] Requesting %s PHY on SECONDARY link (%s: retx %lu/256 per exchange, %u lost PONGs in a row)\n",
+                      blePhyName(request), blePhyName(g_linkPhy),
+                      (unsigned long)phyManager.retxScoreQ8(), phyManager.missRun());
+        ble.requestPhy(handle, blePhyMask(request));
+    }
+}
+#endif
+
 // =============================================================================
 // STATE MACHINE CALLBACK
 // =============================================================================
@@ -2707,6 +5256,48 @@ void onTxStamped(TxStampKind kind, uint32_t seqId, uint64_t txTimeUs)
  */
 void onStateChange(const StateTransition &transition)
 {
+    // Tighten before the engine generates the first macrocycle of a session;
+    // loop() issues the request
+    connParams.onStateChange(transition.toState);
+
+    // Coasting only continues a running session
+    if (transition.toState != TherapyState::RUNNING)
+    {
+        disarmSeededCoast();
+    }
+
+    // Late-event counters are per session (PAUSED/LOW_BATTERY resume it)
+    if (transition.toState == TherapyState::RUNNING &&
+        transition.fromState != TherapyState::PAUSED &&
+        transition.fromState != TherapyState::LOW_BATTERY)
+    {
+        latencyMetrics.resetLateEvents();
+        latePolicy.reset();
+    }
+
+#if SESSION_JOURNAL_ENABLED
+    // One journal session per therapy session (PAUSED/LOW_BATTERY keep it
+    // open), ended before the cases below stop the engine
+    switch (transition.toState)
+    {
+    case TherapyState::RUNNING:
+        if (!sessionJournal.isRecording())
+        {
+            sessionJournal.startSession(profiles.getCurrentProfileId(), therapy.getDurationSeconds());
+        }
+        break;
+    case TherapyState::IDLE:
+    case TherapyState::STOPPING:
+    case TherapyState::ERROR:
+    case TherapyState::CRITICAL_BATTERY:
+    case TherapyState::CONNECTION_LOST:
+        sessionJournal.endSession(therapy.getCyclesCompleted(), therapy.getTotalActivations());
+        break;
+    default:
+        break;
+    }
+#endif
+
     // Update LED pattern based on new state
     switch (transition.toState)
     {
@@ -2736,6 +5327,13 @@ void onStateChange(const StateTransition &transition)
 
     case TherapyState::PAUSED:
         led.setPattern(Colors::YELLOW, LEDPattern::SOLID);
+        // Streamed macrocycles are scheduled ahead: drop them so the pause
+        // takes effect now rather than after the queued macrocycle plays
+        if (g_mcPipelineActive)
+        {
+            activationQueue.clear();
+            haptic.emergencyStop();
+        }
         break;
 
     case TherapyState::STOPPING:
@@ -2763,7 +5361,7 @@ void onStateChange(const StateTransition &transition)
     case TherapyState::CONNECTION_LOST:
         // Start the purple-indication window; loop() demotes to IDLE after
         // CONNECTION_LOST_TIMEOUT_MS if the peer hasn't reconnected
-        g_connectionLostAt = millis();
+        armLoopTimer(g_connectionLostTimer, CONNECTION_LOST_TIMEOUT_MS);
         led.setPattern(Colors::PURPLE, LEDPattern::BLINK_CONNECT);
         // Stop therapy on connection loss
         if (therapy.isRunning())
@@ -2808,21 +5406,34 @@ void onMenuSendToSecondary(const char *message)
 }
 
 // =============================================================================
-// BLE EVENT CALLBACK (PHY Change Detection)
+// BLE EVENT CALLBACK (PHY Change Detection, TX Completion)
 // =============================================================================
 
 #if defined(BOARD_BLUEBUZZAH_NRF52)
 /**
- * @brief BLE event callback for PHY change detection
+ * @brief BLE event callback for PHY change detection and TX wake-ups
  *
  * Runs in SoftDevice context - only sets flags, no I2C/Serial.
+ * A TX-complete event frees SoftDevice buffers: wake loop() to resume
+ * draining a congested TX queue instead of waiting out its retry timeout.
  * When PHY upgrades from 1M to 2M, RTT changes significantly (~20ms to ~10-15ms).
- * This callback detects the transition so main loop can reset RTT statistics.
+ * This callback detects the transition so main loop can reset RTT statistics
+ * (BLE_PHY_AUTO_ENABLED: swap them to the new PHY's cache).
  * (NimBLE requests 2M at connect time before sync traffic starts, so the
- * RTT-reset hook is not needed on the ESP32 backend.)
+ * RTT-reset hook is not needed on the ESP32 backend; servicePhy() reads
+ * the PHY back there instead.)
  */
 void onBLEEvent(ble_evt_t* evt)
 {
+    if (evt->header.evt_id == BLE_GATTS_EVT_HVN_TX_COMPLETE ||
+        evt->header.evt_id == BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE)
+    {
+        if (ble.getTxQueueCount() > 0)
+        {
+            loopWake.notify(LOOP_WAKE_BLE_TX);
+        }
+        return;
+    }
     if (evt->header.evt_id != BLE_GAP_EVT_PHY_UPDATE) return;
 
     ble_gap_evt_phy_update_t* phy = &evt->evt.gap_evt.params.phy_update;
@@ -2830,6 +5441,7 @@ void onBLEEvent(ble_evt_t* evt)
 
     g_newPhy = phy->tx_phy;
     g_phyChangeDetected = true;
+    loopWake.notify(LOOP_WAKE_BLE_PHY);
 }
 #endif
 
@@ -2935,6 +5547,15 @@ void handleSerialCommand(const char *command)
         return;
     }
 
+#if MOTOR_HEALTH_MONITOR_ENABLED
+    // MOTOR_HEALTH - continuous readback monitor: per-motor counters
+    if (strcmp(command, "MOTOR_HEALTH") == 0)
+    {
+        motorHealth.printReport();
+        return;
+    }
+#endif
+
     // MOTOR_TEST:<n> - assembly QA: drive one channel for 2s at full amplitude
     if (strncmp(command, "MOTOR_TEST:", 11) == 0)
     {
@@ -3056,6 +5677,26 @@ void handleSerialCommand(const char *command)
     if (strcmp(command, "GET_LATENCY") == 0)
     {
         latencyMetrics.printReport();
+        DeferredQueueStats deferred = deferredQueue.getStats();
+        Serial.printf("[DEFERRED] %lu run, max latency %lu us, %lu motor waits, overflow feedback %lu / housekeeping %lu\n",
+                      (unsigned long)deferred.processed, (unsigned long)deferred.maxLatencyUs,
+                      (unsigned long)deferred.motorWaits,
+                      (unsigned long)deferred.overflows[static_cast<uint8_t>(DeferredPriority::FEEDBACK)],
+                      (unsigned long)deferred.overflows[static_cast<uint8_t>(DeferredPriority::HOUSEKEEPING)]);
+        PreselectPlanStats preselect = preselectPlanner.getStats();
+        Serial.printf("[PRESELECT] Last plan: %u activations, %u fast, %u staged, %u slow | %lu plans, staged writes %lu done / %lu missed\n",
+                      preselect.activations, preselect.fast, preselect.staged, preselect.slow,
+                      (unsigned long)preselect.plans, (unsigned long)preselect.stagedWrites,
+                      (unsigned long)preselect.stagedMissed);
+#if SYNC_SKEW_CAPTURE_ENABLED
+        if (skewCapture.isActive())
+        {
+            SkewCaptureStats capture = skewCapture.getStats();
+            Serial.printf("[SKEW] Capture: %lu paired, %lu unmatched local, %lu unmatched PRIMARY, %lu dropped\n",
+                          (unsigned long)capture.paired, (unsigned long)capture.unmatchedLocal,
+                          (unsigned long)capture.unmatchedRemote, (unsigned long)capture.dropped);
+        }
+#endif
         return;
     }
 
@@ -3063,10 +5704,44 @@ void handleSerialCommand(const char *command)
     if (strcmp(command, "RESET_LATENCY") == 0)
     {
         latencyMetrics.reset();
+        deferredQueue.resetStats();
+        preselectPlanner.resetStats();
         Serial.println(F("[LATENCY] Metrics reset"));
         return;
     }
 
+    // =========================================================================
+    // PERF PROFILE COMMANDS
+    // =========================================================================
+
+#if PERF_PROFILE_ENABLED
+    // GET_PERF - Print per-scope cycle costs
+    if (strcmp(command, "GET_PERF") == 0)
+    {
+        perfProfile.printReport();
+        return;
+    }
+
+    // RESET_PERF - Clear per-scope cycle costs
+    if (strcmp(command, "RESET_PERF") == 0)
+    {
+        perfProfile.reset();
+        Serial.println(F("[PERF] Profile reset"));
+        return;
+    }
+#endif
+
+    // =========================================================================
+    // MEMORY REPORT
+    // =========================================================================
+
+    // MEMORY - Static footprints, task stack high-water marks, heap minimum
+    if (strcmp(command, "MEMORY") == 0)
+    {
+        memoryReport.printReport();
+        return;
+    }
+
     // GET_CLOCK_SYNC - Print PTP clock synchronization status
     if (strcmp(command, "GET_CLOCK_SYNC") == 0)
     {
@@ -3115,7 +5790,52 @@ void handleSerialCommand(const char *command)
         Serial.printf("Adaptive Lead Time: %lu μs (%.2f ms)\n",
                       (unsigned long)syncProtocol.calculateAdaptiveLeadTime(),
                       syncProtocol.calculateAdaptiveLeadTime() / 1000.0f);
+        Serial.printf("Macrocycle Lead:    %lu μs (open loop %lu μs)\n",
+                      (unsigned long)onGetLeadTime(), (unsigned long)openLoopLeadTimeUs());
+#if SYNC_SLACK_FEEDBACK_ENABLED
+        Serial.printf("Slack Feedback:     %s, %u samples, p%u delay %lu μs -> lead %lu μs\n",
+                      leadTimeController.active(millis()) ? "CLOSED LOOP" : "open loop",
+                      leadTimeController.sampleCount(), (unsigned)SYNC_SLACK_PERCENTILE,
+                      (unsigned long)leadTimeController.delayPercentileUs(),
+                      (unsigned long)leadTimeController.closedLoopLeadUs());
+        Serial.printf("  Last slack %+ld μs, late %lu, unmatched %lu\n",
+                      (long)leadTimeController.lastSlackUs(),
+                      (unsigned long)leadTimeController.lateCount(),
+                      (unsigned long)leadTimeController.unmatchedCount());
+#endif
         Serial.printf("Time Since Sync:    %lu ms\n", (unsigned long)syncProtocol.getTimeSinceSync());
+#if SYNC_ADAPTIVE_PING_ENABLED
+        Serial.printf("PING Interval:      %lu ms (burst %u left)\n",
+                      (unsigned long)pingScheduler.intervalMs(), pingScheduler.burstRemaining());
+#endif
+#if BLE_PHY_AUTO_ENABLED
+        Serial.printf("Link PHY:           %s%s, %u switch(es), %lu refused\n",
+                      blePhyName(g_linkPhy), phyManager.requestPending() ? " (switch pending)" : "",
+                      (unsigned)phyManager.switchCount(), (unsigned long)phyManager.refusedCount());
+        if (deviceRole == DeviceRole::PRIMARY)
+        {
+            Serial.printf("  Retransmissions %lu.%02lu per exchange (%u exchanges), %u lost PONGs in a row\n",
+                          (unsigned long)(phyManager.retxScoreQ8() >> 8),
+                          (unsigned long)(((phyManager.retxScoreQ8() & 0xFF) * 100) >> 8),
+                          phyManager.sampleCount(), phyManager.missRun());
+        }
+        for (uint8_t i = 0; i < BLE_PHY_COUNT; i++)
+        {
+            if (g_phyLinkStats[i].sampleCount > 0 || g_phyLeadUs[i] > 0)
+            {
+                Serial.printf("  Cached %-5s RTT %lu μs (%u samples), lead %lu μs\n",
+                              blePhyName(static_cast<BlePhy>(i)),
+                              (unsigned long)(g_phyLinkStats[i].smoothedLatencyUs * 2),
+                              g_phyLinkStats[i].sampleCount, (unsigned long)g_phyLeadUs[i]);
+            }
+        }
+#endif
+#if SYNC_SKEW_CAL_ENABLED
+        Serial.printf("Drift Rate:         %+.5f us/ms (sigma %.5f)\n",
+                      syncProtocol.getDriftRate(), syncProtocol.getDriftRateSigma());
+        Serial.printf("Skew Calibration:   %u peer(s), generation %u%s\n",
+                      skewCal.count(), skewCal.generation(), skewCal.isDirty() ? " (unsaved)" : "");
+#endif
         Serial.println(F("-------------------------------------"));
 
         // Path Asymmetry diagnostics
@@ -3152,7 +5872,7 @@ void handleSerialCommand(const char *command)
     if (strcmp(command, "FACTORY_RESET") == 0)
     {
         Serial.println(F("[CONFIG] Factory reset - deleting settings..."));
-        if (fsb::removeFile(SETTINGS_FILE))
+        if (profiles.eraseSettings())
         {
             Serial.println(F("[CONFIG] Settings deleted successfully"));
         }
@@ -3171,6 +5891,10 @@ void handleSerialCommand(const char *command)
     // REBOOT - restart the device
     if (strcmp(command, "REBOOT") == 0)
     {
+        if (profiles.hasPendingSave())
+        {
+            profiles.saveSettings();
+        }
         safeMotorShutdown(); // Ensure motors off before reset
         Serial.println(F("[CONFIG] Rebooting..."));
         Serial.flush();
@@ -3181,5 +5905,5 @@ void handleSerialCommand(const char *command)
 
     // Not a serial-only command, pass to regular BLE message handler
     // Use current time as timestamp for serial commands (less critical for serial)
-    onBLEMessage(0, command, getMicros());
+    onBLEMessage(0, command, strlen(command), getMicros());
 }
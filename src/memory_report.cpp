@@ -0,0 +1,128 @@
+/**
+ * @file memory_report.cpp
+ * @brief RAM accounting for fixed buffers, task stacks and the heap - Implementation
+ */
+
+#include "memory_report.h"
+#include "platform.h"
+#include <Arduino.h>
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+MemoryReport memoryReport;
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+MemoryReport::MemoryReport() :
+    _regions{},
+    _regionCount(0),
+    _tasks{},
+    _taskCount(0),
+    _heapMinFree(UINT32_MAX)
+{
+}
+
+bool MemoryReport::add(const char* name, size_t bytes, bool stackTemporary) {
+    if (_regionCount >= MAX_REGIONS) {
+        return false;
+    }
+    _regions[_regionCount++] = {name, static_cast<uint32_t>(bytes), stackTemporary};
+    return true;
+}
+
+bool MemoryReport::addRegion(const char* name, size_t bytes) {
+    return add(name, bytes, false);
+}
+
+bool MemoryReport::addTemporary(const char* name, size_t bytes) {
+    return add(name, bytes, true);
+}
+
+bool MemoryReport::addTask(const char* name, void* handle, uint32_t stackBytes) {
+    if (_taskCount >= MAX_TASKS) {
+        return false;
+    }
+    _tasks[_taskCount++] = {name, handle, stackBytes};
+    return true;
+}
+
+// =============================================================================
+// HEAP
+// =============================================================================
+
+void MemoryReport::sampleHeap() {
+    recordHeap(platformHeapFreeBytes(), platformHeapMinEverFreeBytes());
+}
+
+void MemoryReport::recordHeap(uint32_t freeBytes, uint32_t minEverFreeBytes) {
+    uint32_t lowest = freeBytes < minEverFreeBytes ? freeBytes : minEverFreeBytes;
+    if (lowest < _heapMinFree) {
+        _heapMinFree = lowest;
+    }
+}
+
+uint32_t MemoryReport::staticBytes() const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < _regionCount; i++) {
+        if (!_regions[i].stackTemporary) {
+            total += _regions[i].bytes;
+        }
+    }
+    return total;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+void MemoryReport::printReport() {
+    sampleHeap();
+
+    Serial.println(F("=== Memory ==="));
+    Serial.println(F("static                        bytes"));
+    for (uint8_t i = 0; i < _regionCount; i++) {
+        if (!_regions[i].stackTemporary) {
+            Serial.printf("%-26s %8lu\n", _regions[i].name,
+                          static_cast<unsigned long>(_regions[i].bytes));
+        }
+    }
+    Serial.printf("%-26s %8lu\n", "total", static_cast<unsigned long>(staticBytes()));
+
+    Serial.println(F("stack temporary (each)        bytes"));
+    for (uint8_t i = 0; i < _regionCount; i++) {
+        if (_regions[i].stackTemporary) {
+            Serial.printf("%-26s %8lu\n", _regions[i].name,
+                          static_cast<unsigned long>(_regions[i].bytes));
+        }
+    }
+
+    Serial.println(F("task                   stack  peak_used   min_free"));
+    for (uint8_t i = 0; i < _taskCount; i++) {
+        const MemoryTask& t = _tasks[i];
+        void* handle = t.handle ? t.handle : platformTaskByName(t.name);
+        if (!handle) {
+            Serial.printf("%-18s not found\n", t.name);
+            continue;
+        }
+        uint32_t freeBytes = platformTaskStackFreeBytes(handle);
+        if (t.stackBytes > 0) {
+            uint32_t used = t.stackBytes > freeBytes ? t.stackBytes - freeBytes : 0;
+            Serial.printf("%-18s %9lu %10lu %10lu\n", t.name,
+                          static_cast<unsigned long>(t.stackBytes),
+                          static_cast<unsigned long>(used),
+                          static_cast<unsigned long>(freeBytes));
+        } else {
+            Serial.printf("%-18s %9s %10s %10lu\n", t.name, "?", "?",
+                          static_cast<unsigned long>(freeBytes));
+        }
+    }
+
+    Serial.printf("heap: total %lu, free %lu, min free %lu\n",
+                  static_cast<unsigned long>(platformHeapTotalBytes()),
+                  static_cast<unsigned long>(platformHeapFreeBytes()),
+                  static_cast<unsigned long>(_heapMinFree));
+}
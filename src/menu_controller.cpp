@@ -12,41 +12,11 @@
 #include "profile_manager.h"
 #include "ble_manager.h"
 #include "sync_protocol.h"
+#include "latency_telemetry.h"
+#include "session_journal.h"
+#include "perf_profile.h"
 #include "platform.h"
 
-// =============================================================================
-// INTERNAL MESSAGE PREFIXES
-// =============================================================================
-
-const char* INTERNAL_MESSAGES[] = {
-    "BUZZ",
-    "PING",
-    "PONG",
-    "PARAM_UPDATE",
-    "SEED",
-    "SEED_ACK",
-    "GET_BATTERY",
-    "BATRESPONSE",
-    "ACK_PARAM_UPDATE",
-    "SYNC_",           // Covers SYNC_ADJ, SYNC_PROBE, SYNC_PROBE_ACK
-    "FIRST_SYNC",
-    "ACK_SYNC",        // Covers ACK_SYNC_ADJ
-    "START_SESSION",
-    "PAUSE_SESSION",
-    "RESUME_SESSION",
-    "STOP_SESSION",
-    "IDENTIFY:",
-    "LED_OFF_SYNC",
-    "DEBUG_FLASH",
-    "DEBUG_SYNC",
-    "MC:",             // Macrocycle batch message
-    "MC_ACK:",         // Macrocycle acknowledgment
-    "CALIB_BUZZ:",
-    "CALIB_STOP"
-};
-
-const uint8_t INTERNAL_MESSAGE_COUNT = sizeof(INTERNAL_MESSAGES) / sizeof(INTERNAL_MESSAGES[0]);
-
 // =============================================================================
 // CONSTRUCTOR
 // =============================================================================
@@ -62,6 +32,7 @@ MenuController::MenuController() :
     _sendCallback(nullptr),
     _restartCallback(nullptr),
     _sendToSecondaryCallback(nullptr),
+    _statusSnapshot(nullptr),
     _deferredCommand(DeferredCommand::NONE),
     _secondaryBatteryVoltage(0.0f),
     _waitingForSecondaryBattery(false),
@@ -75,7 +46,9 @@ MenuController::MenuController() :
     _calibBuzzPendingIntensity(0),
     _calibBuzzPendingDuration(0),
     _calibBuzzCancelPending(false),
-    _calibBuzzRequestPending(false)
+    _calibBuzzRequestPending(false),
+    _responseProtocol(PHONE_PROTOCOL_TEXT),
+    _responseCommand(MenuCommand::UNKNOWN)
 {
     strcpy(_firmwareVersion, FIRMWARE_VERSION);
     strcpy(_deviceName, BLE_NAME);
@@ -130,53 +103,61 @@ void MenuController::setSendToSecondaryCallback(SendToSecondaryCallback callback
     _sendToSecondaryCallback = callback;
 }
 
+void MenuController::setStatusSnapshot(const StatusSeqlock* snapshot) {
+    _statusSnapshot = snapshot;
+}
+
+StatusSnapshot MenuController::readStatus() const {
+    StatusSnapshot status;
+    if (_statusSnapshot && _statusSnapshot->read(status)) {
+        return status;
+    }
+
+    if (_stateMachine) {
+        status.state = _stateMachine->getCurrentState();
+    }
+    if (_therapy && _therapy->isRunning()) {
+        status.therapyRunning = true;
+        status.elapsedSeconds = _therapy->getElapsedSeconds();
+        status.durationSeconds = _therapy->getDurationSeconds();
+    }
+    if (_battery) {
+        status.battery = _battery->getStatus();
+    }
+    return status;
+}
+
 // =============================================================================
 // COMMAND PROCESSING
 // =============================================================================
 
 bool MenuController::isInternalMessage(const char* message) {
-    if (!message || strlen(message) == 0) {
+    if (!message) {
         return false;
     }
-
-    for (uint8_t i = 0; i < INTERNAL_MESSAGE_COUNT; i++) {
-        if (strncmp(message, INTERNAL_MESSAGES[i], strlen(INTERNAL_MESSAGES[i])) == 0) {
-            return true;
-        }
-    }
-    return false;
+    return classifyMessage(message) != InternalMessage::NONE;
 }
 
 bool MenuController::handleCommand(const char* message, bool allowInternal) {
-    if (!message || strlen(message) == 0) {
+    if (!message || message[0] == '\0') {
         return false;
     }
 
+    InternalMessage kind = classifyMessage(message);
+
     // Skip internal messages unless caller vouches for the source
     // (messages from an identified PHONE connection are always commands)
-    if (!allowInternal && isInternalMessage(message)) {
+    if (!allowInternal && kind != InternalMessage::NONE) {
         return false;
     }
 
     // Late IDENTIFY handshake (connection already classified) — consume
     // silently, it is never a command and must not generate an error reply
-    if (strncmp(message, "IDENTIFY:", 9) == 0) {
+    if (kind == InternalMessage::IDENTIFY) {
         return true;
     }
 
-    // Parse command
-    char command[32];
-    char params[MAX_COMMAND_PARAMS][PARAM_BUFFER_SIZE];
-    uint8_t paramCount = 0;
-
-    if (!parseCommand(message, command, params, paramCount)) {
-        sendError("Invalid command format");
-        return false;
-    }
-
-    Serial.printf("[MENU] Command: %s, Params: %d\n", command, paramCount);
-
-    // A new command is about to be dispatched: cancel any stale deferred
+    // A new command is about to be answered: cancel any stale deferred
     // INFO/BATTERY response still waiting on the SECONDARY glove's battery
     // reply. Without this, a late reply (or its timeout) would complete
     // against a response buffer this command is about to overwrite, sending
@@ -186,111 +167,55 @@ bool MenuController::handleCommand(const char* message, bool allowInternal) {
         _deferredCommand = DeferredCommand::NONE;
     }
 
-    // Dispatch to handler
-    if (strcmp(command, "INFO") == 0) {
-        handleInfo();
-    } else if (strcmp(command, "BATTERY") == 0) {
-        handleBattery();
-    } else if (strcmp(command, "PING") == 0) {
-        handlePing();
-    } else if (strcmp(command, "PROFILE_LIST") == 0) {
-        handleProfileList();
-    } else if (strcmp(command, "PROFILE_LOAD") == 0) {
-        handleProfileLoad(params, paramCount);
-    } else if (strcmp(command, "PROFILE_GET") == 0) {
-        handleProfileGet();
-    } else if (strcmp(command, "PROFILE_CUSTOM") == 0) {
-        handleProfileCustom(params, paramCount);
-    } else if (strcmp(command, "SESSION_START") == 0) {
-        handleSessionStart();
-    } else if (strcmp(command, "SESSION_PAUSE") == 0) {
-        handleSessionPause();
-    } else if (strcmp(command, "SESSION_RESUME") == 0) {
-        handleSessionResume();
-    } else if (strcmp(command, "SESSION_STOP") == 0) {
-        handleSessionStop();
-    } else if (strcmp(command, "SESSION_STATUS") == 0) {
-        handleSessionStatus();
-    } else if (strcmp(command, "PARAM_SET") == 0) {
-        handleParamSet(params, paramCount);
-    } else if (strcmp(command, "CALIBRATE_START") == 0) {
-        handleCalibrateStart();
-    } else if (strcmp(command, "CALIBRATE_BUZZ") == 0) {
-        handleCalibrateBuzz(params, paramCount);
-    } else if (strcmp(command, "CALIBRATE_STOP") == 0) {
-        handleCalibrateStop();
-    } else if (strcmp(command, "HELP") == 0) {
-        handleHelp();
-    } else if (strcmp(command, "RESTART") == 0) {
-        handleRestart();
-    } else if (strcmp(command, "THERAPY_LED_OFF") == 0) {
-        handleTherapyLedOff(params, paramCount);
-    } else if (strcmp(command, "DEBUG") == 0) {
-        handleDebug(params, paramCount);
-    } else {
-        char errorMsg[64];
-        snprintf(errorMsg, sizeof(errorMsg), "Unknown command: %s", command);
-        sendError(errorMsg);
-        return false;
-    }
+    // Wire format negotiated at IDENTIFY:PHONE; latched so a deferred
+    // response completes in the format it started in
+    _responseProtocol = _ble ? _ble->getPhoneProtocol() : PHONE_PROTOCOL_TEXT;
+    _responseCommand = MenuCommand::UNKNOWN;
 
-    return true;
-}
-
-// =============================================================================
-// COMMAND PARSING
-// =============================================================================
-
-bool MenuController::parseCommand(const char* message, char* command, char params[][PARAM_BUFFER_SIZE], uint8_t& paramCount) {
-    if (!message || !command || !params) {
+    // Split into views of the message (no per-parameter copies)
+    CommandArgs args;
+    if (!splitCommand(message, args)) {
+        sendError("Invalid command format");
         return false;
     }
 
-    // Create a working copy
-    char buffer[256];
-    strncpy(buffer, message, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
+    Serial.printf("[MENU] Command: %.*s, Params: %d\n",
+                  static_cast<int>(args.name.size()), args.name.data(), args.count);
 
-    // Strip newlines and EOT
-    char* p = buffer;
-    while (*p) {
-        if (*p == '\n' || *p == '\r' || *p == EOT_CHAR) {
-            *p = '\0';
-            break;
+    // Dispatch to handler
+    _responseCommand = lookupMenuCommand(args.name);
+    switch (_responseCommand) {
+        case MenuCommand::INFO:            handleInfo(); break;
+        case MenuCommand::BATTERY:         handleBattery(); break;
+        case MenuCommand::PING:            handlePing(); break;
+        case MenuCommand::PROFILE_LIST:    handleProfileList(); break;
+        case MenuCommand::PROFILE_LOAD:    handleProfileLoad(args); break;
+        case MenuCommand::PROFILE_GET:     handleProfileGet(); break;
+        case MenuCommand::PROFILE_CUSTOM:  handleProfileCustom(args); break;
+        case MenuCommand::SESSION_START:   handleSessionStart(); break;
+        case MenuCommand::SESSION_PAUSE:   handleSessionPause(); break;
+        case MenuCommand::SESSION_RESUME:  handleSessionResume(); break;
+        case MenuCommand::SESSION_STOP:    handleSessionStop(); break;
+        case MenuCommand::SESSION_STATUS:  handleSessionStatus(); break;
+        case MenuCommand::PARAM_SET:       handleParamSet(args); break;
+        case MenuCommand::CALIBRATE_START: handleCalibrateStart(); break;
+        case MenuCommand::CALIBRATE_BUZZ:  handleCalibrateBuzz(args); break;
+        case MenuCommand::CALIBRATE_STOP:  handleCalibrateStop(); break;
+        case MenuCommand::HELP:            handleHelp(); break;
+        case MenuCommand::RESTART:         handleRestart(); break;
+        case MenuCommand::THERAPY_LED_OFF: handleTherapyLedOff(args); break;
+        case MenuCommand::DEBUG:           handleDebug(args); break;
+        case MenuCommand::LATENCY_STREAM:  handleLatencyStream(args); break;
+        case MenuCommand::JOURNAL_GET:     handleJournalGet(args); break;
+        case MenuCommand::PERF:            handlePerf(args); break;
+        case MenuCommand::UNKNOWN:
+        default: {
+            char errorMsg[64];
+            snprintf(errorMsg, sizeof(errorMsg), "Unknown command: %.*s",
+                     static_cast<int>(args.name.size()), args.name.data());
+            sendError(errorMsg);
+            return false;
         }
-        p++;
-    }
-
-    // Trim leading whitespace
-    p = buffer;
-    while (*p == ' ') p++;
-
-    if (strlen(p) == 0) {
-        return false;
-    }
-
-    // Split on colon
-    paramCount = 0;
-    char* token = strtok(p, ":");
-
-    if (!token) {
-        return false;
-    }
-
-    // First token is the command (uppercase it)
-    strncpy(command, token, 31);
-    command[31] = '\0';
-
-    // Convert command to uppercase
-    for (char* c = command; *c; c++) {
-        *c = static_cast<char>(toupper(*c));
-    }
-
-    // Remaining tokens are parameters
-    while ((token = strtok(nullptr, ":")) != nullptr && paramCount < MAX_COMMAND_PARAMS) {
-        strncpy(params[paramCount], token, PARAM_BUFFER_SIZE - 1);
-        params[paramCount][PARAM_BUFFER_SIZE - 1] = '\0';
-        paramCount++;
     }
 
     return true;
@@ -300,37 +225,124 @@ bool MenuController::parseCommand(const char* message, char* command, char param
 // RESPONSE FORMATTING
 // =============================================================================
 
-void MenuController::beginResponse() {
+void MenuController::beginResponse(bool error) {
     _responseBuffer[0] = '\0';
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        // Room for the EOT and NUL sendResponse() appends
+        _frame.begin(_responseBuffer, RESPONSE_BUFFER_SIZE - 2, static_cast<uint8_t>(_responseCommand),
+                     error ? PHONE_V3_FLAG_ERROR : 0);
+    }
 }
 
 void MenuController::addResponseLine(const char* key, const char* value) {
-    char line[128];
-    snprintf(line, sizeof(line), "%s:%s\n", key, value ? value : "");
-
+    // Formatted in place (this runs on the BLE task); a line that does not
+    // fit, leaving room for the EOT, is dropped whole
     size_t currentLen = strlen(_responseBuffer);
-    size_t lineLen = strlen(line);
+    if (currentLen >= RESPONSE_BUFFER_SIZE - 2) {
+        return;
+    }
 
-    if (currentLen + lineLen < RESPONSE_BUFFER_SIZE - 2) {
-        strcat(_responseBuffer, line);
+    size_t room = RESPONSE_BUFFER_SIZE - 2 - currentLen;
+    int lineLen = snprintf(_responseBuffer + currentLen, room, "%s:%s\n", key, value ? value : "");
+    if (lineLen < 0 || static_cast<size_t>(lineLen) >= room) {
+        _responseBuffer[currentLen] = '\0';
+    }
+}
+
+void MenuController::addResponseField(PhoneField field, const char* value) {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        if (value == nullptr || value[0] == '\0') {
+            _frame.putEmpty(field);
+        } else {
+            _frame.putString(field, value);
+        }
+        return;
     }
+    addResponseLine(phoneFieldKey(field), value);
 }
 
-void MenuController::addResponseLine(const char* key, int32_t value) {
+void MenuController::addResponseField(PhoneField field, int32_t value) {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        _frame.putInt(field, value);
+        return;
+    }
     char valueStr[16];
     snprintf(valueStr, sizeof(valueStr), "%ld", (long)value);
-    addResponseLine(key, valueStr);
+    addResponseLine(phoneFieldKey(field), valueStr);
 }
 
-void MenuController::addResponseLine(const char* key, float value, uint8_t decimals) {
+void MenuController::addResponseField(PhoneField field, float value, uint8_t decimals) {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        _frame.putFixed(field, value, decimals);
+        return;
+    }
     char valueStr[16];
     char format[8];
     snprintf(format, sizeof(format), "%%.%df", decimals);
     snprintf(valueStr, sizeof(valueStr), format, value);
-    addResponseLine(key, valueStr);
+    addResponseLine(phoneFieldKey(field), valueStr);
+}
+
+void MenuController::addResponseField(PhoneField field, bool value) {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        _frame.putBool(field, value);
+        return;
+    }
+    addResponseLine(phoneFieldKey(field), value ? "true" : "false");
+}
+
+void MenuController::addResponseField(PhoneField field, uint8_t id, const char* name) {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        _frame.putIdString(field, id, name ? name : "");
+        return;
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "%d:%s", id, name ? name : "");
+    addResponseLine(phoneFieldKey(field), line);
+}
+
+void MenuController::addResponseField(PhoneField field, const uint8_t* data, size_t length) {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        _frame.putString(field, std::string_view(reinterpret_cast<const char*>(data), length));
+        return;
+    }
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    char hex[2 * SESSION_JOURNAL_CHUNK_BYTES + 1];
+    size_t n = length < SESSION_JOURNAL_CHUNK_BYTES ? length : SESSION_JOURNAL_CHUNK_BYTES;
+    for (size_t i = 0; i < n; i++) {
+        hex[2 * i] = HEX_DIGITS[data[i] >> 4];
+        hex[2 * i + 1] = HEX_DIGITS[data[i] & 0x0F];
+    }
+    hex[2 * n] = '\0';
+    addResponseLine(phoneFieldKey(field), hex);
+}
+
+void MenuController::addResponseField(PhoneField field, MenuCommand command) {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        _frame.putInt(field, static_cast<int32_t>(command));
+        return;
+    }
+    char name[24];
+    argCopy(menuCommandName(command), name, sizeof(name));
+    addResponseLine(phoneFieldKey(field), name);
 }
 
 void MenuController::sendResponse() {
+    if (_responseProtocol >= PHONE_PROTOCOL_BINARY) {
+        // Escaped frame: NUL-free, so it travels the C-string send path
+        size_t len = _frame.length();
+        _responseBuffer[len] = EOT_CHAR;
+        _responseBuffer[len + 1] = '\0';
+        if (_sendCallback) {
+            _sendCallback(_responseBuffer);
+        }
+        Serial.printf("[MENU-TX] v3 %.*s: %u bytes%s\n",
+                      static_cast<int>(menuCommandName(_responseCommand).size()),
+                      menuCommandName(_responseCommand).data(),
+                      static_cast<unsigned>(len), _frame.overflowed() ? " (truncated)" : "");
+        return;
+    }
+
     // Add EOT terminator
     size_t len = strlen(_responseBuffer);
     if (len < RESPONSE_BUFFER_SIZE - 1) {
@@ -348,8 +360,8 @@ void MenuController::sendResponse() {
 }
 
 void MenuController::sendError(const char* message) {
-    beginResponse();
-    addResponseLine("ERROR", message);
+    beginResponse(true);
+    addResponseField(PhoneField::ERROR_TEXT, message);
     sendResponse();
 }
 
@@ -380,21 +392,11 @@ void MenuController::handleSecondaryBatteryResponse(float voltage) {
     _secondaryBatteryVoltage = voltage;
 
     // Complete the deferred response
-    addResponseLine("BATS", voltage, 2);
+    addResponseField(PhoneField::BATS, voltage, 2);
 
     if (_deferredCommand == DeferredCommand::INFO) {
         // INFO response needs STATUS after BATS
-        const char* statusStr = "IDLE";
-        if (_stateMachine) {
-            if (_stateMachine->isRunning()) {
-                statusStr = "RUNNING";
-            } else if (_stateMachine->isPaused()) {
-                statusStr = "PAUSED";
-            } else if (_stateMachine->isReady()) {
-                statusStr = "READY";
-            }
-        }
-        addResponseLine("STATUS", statusStr);
+        addResponseField(PhoneField::STATUS, readStatus().phoneStatusString());
     }
 
     _deferredCommand = DeferredCommand::NONE;
@@ -418,40 +420,22 @@ void MenuController::checkSecondaryBatteryTimeout() {
 
 void MenuController::handleInfo() {
     beginResponse();
+    StatusSnapshot status = readStatus();
 
-    addResponseLine("ROLE", deviceRoleToString(_role));
-    addResponseLine("NAME", _deviceName);
-    addResponseLine("FW", _firmwareVersion);
-    addResponseLine("MOTORS", static_cast<int32_t>(MAX_ACTUATORS));
+    addResponseField(PhoneField::ROLE, deviceRoleToString(_role));
+    addResponseField(PhoneField::NAME, _deviceName);
+    addResponseField(PhoneField::FW, _firmwareVersion);
+    addResponseField(PhoneField::MOTORS, static_cast<int32_t>(MAX_ACTUATORS));
     if (_profiles) {
-        char profLine[48];
-        snprintf(profLine, sizeof(profLine), "%d:%s",
-                 _profiles->getCurrentProfileId(), _profiles->getCurrentProfileName());
-        addResponseLine("PROFILE", profLine);
+        addResponseField(PhoneField::PROFILE, _profiles->getCurrentProfileId(), _profiles->getCurrentProfileName());
     }
 
-    // Get battery status
-    if (_battery) {
-        BatteryStatus status = _battery->getStatus();
-        addResponseLine("BATP", status.voltage, 2);
-    } else {
-        addResponseLine("BATP", "0.00");
-    }
+    addResponseField(PhoneField::BATP, status.battery.voltage, 2);
 
     // Guard: already waiting for SECONDARY — return 0.00 immediately
     if (_waitingForSecondaryBattery) {
-        addResponseLine("BATS", "0.00");
-        const char* statusStr = "IDLE";
-        if (_stateMachine) {
-            if (_stateMachine->isRunning()) {
-                statusStr = "RUNNING";
-            } else if (_stateMachine->isPaused()) {
-                statusStr = "PAUSED";
-            } else if (_stateMachine->isReady()) {
-                statusStr = "READY";
-            }
-        }
-        addResponseLine("STATUS", statusStr);
+        addResponseField(PhoneField::BATS, 0.0f, 2);
+        addResponseField(PhoneField::STATUS, status.phoneStatusString());
         sendResponse();
         return;
     }
@@ -466,20 +450,9 @@ void MenuController::handleInfo() {
     }
 
     // No SECONDARY connection - respond immediately with 0.00
-    addResponseLine("BATS", "0.00");
+    addResponseField(PhoneField::BATS, 0.0f, 2);
 
-    // Get therapy status
-    const char* statusStr = "IDLE";
-    if (_stateMachine) {
-        if (_stateMachine->isRunning()) {
-            statusStr = "RUNNING";
-        } else if (_stateMachine->isPaused()) {
-            statusStr = "PAUSED";
-        } else if (_stateMachine->isReady()) {
-            statusStr = "READY";
-        }
-    }
-    addResponseLine("STATUS", statusStr);
+    addResponseField(PhoneField::STATUS, status.phoneStatusString());
 
     sendResponse();
 }
@@ -487,16 +460,11 @@ void MenuController::handleInfo() {
 void MenuController::handleBattery() {
     beginResponse();
 
-    if (_battery) {
-        BatteryStatus status = _battery->getStatus();
-        addResponseLine("BATP", status.voltage, 2);
-    } else {
-        addResponseLine("BATP", "0.00");
-    }
+    addResponseField(PhoneField::BATP, readStatus().battery.voltage, 2);
 
     // Guard: already waiting for SECONDARY — return 0.00 immediately
     if (_waitingForSecondaryBattery) {
-        addResponseLine("BATS", "0.00");
+        addResponseField(PhoneField::BATS, 0.0f, 2);
         sendResponse();
         return;
     }
@@ -511,14 +479,14 @@ void MenuController::handleBattery() {
     }
 
     // No SECONDARY connection - respond immediately with 0.00
-    addResponseLine("BATS", "0.00");
+    addResponseField(PhoneField::BATS, 0.0f, 2);
 
     sendResponse();
 }
 
 void MenuController::handlePing() {
     beginResponse();
-    addResponseLine("PONG", "");
+    addResponseField(PhoneField::PONG, "");
     sendResponse();
 }
 
@@ -536,19 +504,17 @@ void MenuController::handleProfileList() {
 
     // Get profile list
     uint8_t count = 0;
-    const char** names = _profiles->getProfileNames(&count);
+    const char* const* names = _profiles->getProfileNames(&count);
 
     for (uint8_t i = 0; i < count; i++) {
-        char line[64];
-        snprintf(line, sizeof(line), "%d:%s", i + 1, names[i]);
-        addResponseLine("PROFILE", line);
+        addResponseField(PhoneField::PROFILE, static_cast<uint8_t>(i + 1), names[i]);
     }
 
     sendResponse();
 }
 
-void MenuController::handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
-    if (paramCount < 1) {
+void MenuController::handleProfileLoad(const CommandArgs& args) {
+    if (args.count < 1) {
         sendError("Profile ID required");
         return;
     }
@@ -563,7 +529,7 @@ void MenuController::handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], u
         return;
     }
 
-    int profileId = atoi(params[0]);
+    int profileId = argToInt(args.params[0]);
     if (!_profiles->loadProfile(static_cast<uint8_t>(profileId))) {
         sendError("Invalid profile ID");
         return;
@@ -585,8 +551,8 @@ void MenuController::handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], u
 
     // Send response before reboot
     beginResponse();
-    addResponseLine("STATUS", "REBOOTING");
-    addResponseLine("PROFILE", _profiles->getCurrentProfileName());
+    addResponseField(PhoneField::STATUS, "REBOOTING");
+    addResponseField(PhoneField::PROFILE, _profiles->getCurrentProfileName());
     sendResponse();
 
     // Give time for response to be sent
@@ -613,27 +579,27 @@ void MenuController::handleProfileGet() {
     }
 
     beginResponse();
-    addResponseLine("TYPE", profile->actuatorType == ActuatorType::LRA ? "LRA" : "ERM");
-    addResponseLine("FREQ", (int32_t)profile->frequencyHz);
-    addResponseLine("ON", profile->timeOnMs, 1);
-    addResponseLine("OFF", profile->timeOffMs, 1);
-    addResponseLine("SESSION", (int32_t)profile->sessionDurationMin);
-    addResponseLine("AMPMIN", (int32_t)profile->amplitudeMin);
-    addResponseLine("AMPMAX", (int32_t)profile->amplitudeMax);
-    addResponseLine("PATTERN", profile->patternType);
-    addResponseLine("MIRROR", (int32_t)(profile->mirrorPattern ? 1 : 0));
-    addResponseLine("JITTER", profile->jitterPercent, 1);
+    addResponseField(PhoneField::TYPE, profile->actuatorType == ActuatorType::LRA ? "LRA" : "ERM");
+    addResponseField(PhoneField::FREQ, (int32_t)profile->frequencyHz);
+    addResponseField(PhoneField::ON, profile->timing.timeOnMs(), 1);
+    addResponseField(PhoneField::OFF, profile->timing.timeOffMs(), 1);
+    addResponseField(PhoneField::SESSION, (int32_t)profile->sessionDurationMin);
+    addResponseField(PhoneField::AMPMIN, (int32_t)profile->amplitudeMin);
+    addResponseField(PhoneField::AMPMAX, (int32_t)profile->amplitudeMax);
+    addResponseField(PhoneField::PATTERN, profile->patternType);
+    addResponseField(PhoneField::MIRROR, (int32_t)(profile->mirrorPattern ? 1 : 0));
+    addResponseField(PhoneField::JITTER, profile->timing.jitterPercent(), 1);
     sendResponse();
 }
 
-void MenuController::handleProfileCustom(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleProfileCustom(const CommandArgs& args) {
     // Check if session is active
     if (_therapy && _therapy->isRunning()) {
         sendError("Cannot modify parameters during active session");
         return;
     }
 
-    if (paramCount < 2 || paramCount % 2 != 0) {
+    if (args.count < 2 || args.count % 2 != 0) {
         sendError("Invalid parameter format (KEY:VALUE pairs required)");
         return;
     }
@@ -643,18 +609,22 @@ void MenuController::handleProfileCustom(const char params[][PARAM_BUFFER_SIZE],
         return;
     }
 
-    // Apply each key-value pair
-    for (uint8_t i = 0; i < paramCount; i += 2) {
-        if (!_profiles->setParameter(params[i], params[i + 1])) {
+    // Apply each key-value pair (setParameter() takes C strings)
+    char key[PARAM_BUFFER_SIZE];
+    char value[PARAM_BUFFER_SIZE];
+    for (uint8_t i = 0; i < args.count; i += 2) {
+        argCopy(args.params[i], key, sizeof(key));
+        argCopy(args.params[i + 1], value, sizeof(value));
+        if (!_profiles->setParameter(key, value)) {
             char errorMsg[64];
-            snprintf(errorMsg, sizeof(errorMsg), "Invalid parameter: %s", params[i]);
+            snprintf(errorMsg, sizeof(errorMsg), "Invalid parameter: %s", key);
             sendError(errorMsg);
             return;
         }
     }
 
     beginResponse();
-    addResponseLine("STATUS", "CUSTOM_LOADED");
+    addResponseField(PhoneField::STATUS, "CUSTOM_LOADED");
     sendResponse();
 }
 
@@ -685,9 +655,7 @@ void MenuController::handleSessionStart() {
     // Get profile parameters
     uint32_t durationSec = 7200;  // Default 2 hours
     PatternType patternType = PatternType::RNDP;
-    float timeOnMs = 100.0f;
-    float timeOffMs = 67.0f;
-    float jitterPercent = 23.5f;
+    TherapyTiming timing = TherapyTiming::fromMs(100.0f, 67.0f, 23.5f);
     uint8_t numFingers = MAX_ACTUATORS;  // Fallback when no profile is active
     bool mirror = true;
 
@@ -695,9 +663,7 @@ void MenuController::handleSessionStart() {
         const TherapyProfile* profile = _profiles->getCurrentProfile();
         if (profile) {
             durationSec = profile->sessionDurationMin * 60;
-            timeOnMs = profile->timeOnMs;
-            timeOffMs = profile->timeOffMs;
-            jitterPercent = profile->jitterPercent;
+            timing = profile->timing;
             numFingers = profile->numFingers;
             mirror = profile->mirrorPattern;
 
@@ -710,7 +676,7 @@ void MenuController::handleSessionStart() {
     }
 
     // Start session
-    _therapy->startSession(durationSec, patternType, timeOnMs, timeOffMs, jitterPercent, numFingers, mirror);
+    _therapy->startSession(durationSec, patternType, timing, numFingers, mirror);
 
     // Update state machine
     if (_stateMachine) {
@@ -727,7 +693,7 @@ void MenuController::handleSessionStart() {
     }
 
     beginResponse();
-    addResponseLine("SESSION_STATUS", "RUNNING");
+    addResponseField(PhoneField::SESSION_STATUS, "RUNNING");
     sendResponse();
 }
 
@@ -753,7 +719,7 @@ void MenuController::handleSessionPause() {
     }
 
     beginResponse();
-    addResponseLine("SESSION_STATUS", "PAUSED");
+    addResponseField(PhoneField::SESSION_STATUS, "PAUSED");
     sendResponse();
 }
 
@@ -784,7 +750,7 @@ void MenuController::handleSessionResume() {
     }
 
     beginResponse();
-    addResponseLine("SESSION_STATUS", "RUNNING");
+    addResponseField(PhoneField::SESSION_STATUS, "RUNNING");
     sendResponse();
 }
 
@@ -811,34 +777,30 @@ void MenuController::handleSessionStop() {
     }
 
     beginResponse();
-    addResponseLine("SESSION_STATUS", "IDLE");
+    addResponseField(PhoneField::SESSION_STATUS, "IDLE");
     sendResponse();
 }
 
 void MenuController::handleSessionStatus() {
     beginResponse();
 
-    const char* statusStr = "IDLE";
+    StatusSnapshot status = readStatus();
     uint32_t elapsed = 0;
     uint32_t total = 0;
     uint8_t progress = 0;
 
-    if (_stateMachine) {
-        statusStr = therapyStateToString(_stateMachine->getCurrentState());
-    }
-
-    if (_therapy && _therapy->isRunning()) {
-        elapsed = _therapy->getElapsedSeconds();
-        total = _therapy->getDurationSeconds();
+    if (status.therapyRunning) {
+        elapsed = status.elapsedSeconds;
+        total = status.durationSeconds;
         if (total > 0) {
             progress = static_cast<uint8_t>((elapsed * 100) / total);
         }
     }
 
-    addResponseLine("SESSION_STATUS", statusStr);
-    addResponseLine("ELAPSED", (int32_t)elapsed);
-    addResponseLine("TOTAL", (int32_t)total);
-    addResponseLine("PROGRESS", (int32_t)progress);
+    addResponseField(PhoneField::SESSION_STATUS, therapyStateToString(status.state));
+    addResponseField(PhoneField::ELAPSED, (int32_t)elapsed);
+    addResponseField(PhoneField::TOTAL, (int32_t)total);
+    addResponseField(PhoneField::PROGRESS, (int32_t)progress);
     sendResponse();
 }
 
@@ -846,13 +808,13 @@ void MenuController::handleSessionStatus() {
 // PARAMETER COMMANDS
 // =============================================================================
 
-void MenuController::handleParamSet(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleParamSet(const CommandArgs& args) {
     if (_therapy && _therapy->isRunning()) {
         sendError("Cannot modify parameters during active session");
         return;
     }
 
-    if (paramCount < 2) {
+    if (args.count < 2) {
         sendError("Parameter name and value required");
         return;
     }
@@ -864,20 +826,21 @@ void MenuController::handleParamSet(const char params[][PARAM_BUFFER_SIZE], uint
 
     // Create local copy and convert param name to uppercase
     char paramName[PARAM_BUFFER_SIZE];
-    strncpy(paramName, params[0], PARAM_BUFFER_SIZE - 1);
-    paramName[PARAM_BUFFER_SIZE - 1] = '\0';
+    char value[PARAM_BUFFER_SIZE];
+    argCopy(args.params[0], paramName, sizeof(paramName));
+    argCopy(args.params[1], value, sizeof(value));
     for (char* c = paramName; *c; c++) {
         *c = static_cast<char>(toupper(*c));
     }
 
-    if (!_profiles->setParameter(paramName, params[1])) {
+    if (!_profiles->setParameter(paramName, value)) {
         sendError("Invalid parameter name or value out of range");
         return;
     }
 
     beginResponse();
-    addResponseLine("PARAM", paramName);
-    addResponseLine("VALUE", params[1]);
+    addResponseField(PhoneField::PARAM, paramName);
+    addResponseField(PhoneField::VALUE, value);
     sendResponse();
 }
 
@@ -895,24 +858,24 @@ void MenuController::handleCalibrateStart() {
     _calibrationStartTime = millis();
 
     beginResponse();
-    addResponseLine("MODE", "CALIBRATION");
+    addResponseField(PhoneField::MODE, "CALIBRATION");
     sendResponse();
 }
 
-void MenuController::handleCalibrateBuzz(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleCalibrateBuzz(const CommandArgs& args) {
     if (!_isCalibrating) {
         sendError("Not in calibration mode");
         return;
     }
 
-    if (paramCount < 3) {
+    if (args.count < 3) {
         sendError("Finger, intensity, and duration required");
         return;
     }
 
-    int finger = atoi(params[0]);
-    int intensity = atoi(params[1]);
-    int duration = atoi(params[2]);
+    int finger = argToInt(args.params[0]);
+    int intensity = argToInt(args.params[1]);
+    int duration = argToInt(args.params[2]);
 
     // Validate ranges. Indices 0..MAX_ACTUATORS-1 are local; the rest map to
     // the SECONDARY glove (4-finger boards: 0-7, 5-finger boards: 0-9).
@@ -952,9 +915,9 @@ void MenuController::handleCalibrateBuzz(const char params[][PARAM_BUFFER_SIZE],
     }
 
     beginResponse();
-    addResponseLine("FINGER", (int32_t)finger);
-    addResponseLine("INTENSITY", (int32_t)intensity);
-    addResponseLine("DURATION", (int32_t)duration);
+    addResponseField(PhoneField::FINGER, (int32_t)finger);
+    addResponseField(PhoneField::INTENSITY, (int32_t)intensity);
+    addResponseField(PhoneField::DURATION, (int32_t)duration);
     sendResponse();
 }
 
@@ -978,7 +941,7 @@ void MenuController::handleCalibrateStop() {
     }
 
     beginResponse();
-    addResponseLine("MODE", "NORMAL");
+    addResponseField(PhoneField::MODE, "NORMAL");
     sendResponse();
 }
 
@@ -1064,26 +1027,10 @@ void MenuController::updateCalibrationBuzz() {
 
 void MenuController::handleHelp() {
     beginResponse();
-    addResponseLine("COMMAND", "INFO");
-    addResponseLine("COMMAND", "BATTERY");
-    addResponseLine("COMMAND", "PING");
-    addResponseLine("COMMAND", "PROFILE_LIST");
-    addResponseLine("COMMAND", "PROFILE_LOAD");
-    addResponseLine("COMMAND", "PROFILE_GET");
-    addResponseLine("COMMAND", "PROFILE_CUSTOM");
-    addResponseLine("COMMAND", "SESSION_START");
-    addResponseLine("COMMAND", "SESSION_PAUSE");
-    addResponseLine("COMMAND", "SESSION_RESUME");
-    addResponseLine("COMMAND", "SESSION_STOP");
-    addResponseLine("COMMAND", "SESSION_STATUS");
-    addResponseLine("COMMAND", "PARAM_SET");
-    addResponseLine("COMMAND", "CALIBRATE_START");
-    addResponseLine("COMMAND", "CALIBRATE_BUZZ");
-    addResponseLine("COMMAND", "CALIBRATE_STOP");
-    addResponseLine("COMMAND", "HELP");
-    addResponseLine("COMMAND", "RESTART");
-    addResponseLine("COMMAND", "THERAPY_LED_OFF");
-    addResponseLine("COMMAND", "DEBUG");
+    for (uint8_t c = static_cast<uint8_t>(MenuCommand::INFO);
+         c <= static_cast<uint8_t>(MenuCommand::PERF); c++) {
+        addResponseField(PhoneField::COMMAND, static_cast<MenuCommand>(c));
+    }
     sendResponse();
 }
 
@@ -1098,9 +1045,12 @@ void MenuController::handleRestart() {
     if (_stateMachine) {
         _stateMachine->transition(StateTrigger::STOP_SESSION);
     }
+    if (_profiles && _profiles->hasPendingSave()) {
+        _profiles->saveSettings();
+    }
 
     beginResponse();
-    addResponseLine("STATUS", "REBOOTING");
+    addResponseField(PhoneField::STATUS, "REBOOTING");
     sendResponse();
 
     // Give time for response to be sent
@@ -1119,29 +1069,23 @@ void MenuController::handleRestart() {
 // LED CONTROL COMMAND
 // =============================================================================
 
-void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleTherapyLedOff(const CommandArgs& args) {
     if (!_profiles) {
         sendError("Profile manager not available");
         return;
     }
 
     // Query mode: no parameter - return current value
-    if (paramCount == 0) {
+    if (args.count == 0) {
         beginResponse();
-        addResponseLine("THERAPY_LED_OFF", _profiles->getTherapyLedOff() ? "true" : "false");
+        addResponseField(PhoneField::THERAPY_LED_OFF, _profiles->getTherapyLedOff());
         sendResponse();
         return;
     }
 
     // Set mode: parse boolean value
     bool newValue = false;
-    const char* value = params[0];
-
-    if (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0) {
-        newValue = true;
-    } else if (strcasecmp(value, "false") == 0 || strcmp(value, "0") == 0) {
-        newValue = false;
-    } else {
+    if (!argToBool(args.params[0], newValue)) {
         sendError("Invalid value. Use: true/false or 1/0");
         return;
     }
@@ -1149,10 +1093,8 @@ void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE],
     // Update setting
     _profiles->setTherapyLedOff(newValue);
 
-    // Persist to flash
-    if (!_profiles->saveSettings()) {
-        Serial.println(F("[MENU] Warning: Failed to save settings"));
-    }
+    // Persisted from loop() once the phone stops toggling
+    _profiles->requestSave();
 
     // Sync to SECONDARY if connected
     if (_ble && _ble->isSecondaryConnected()) {
@@ -1163,7 +1105,7 @@ void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE],
     }
 
     beginResponse();
-    addResponseLine("THERAPY_LED_OFF", newValue ? "true" : "false");
+    addResponseField(PhoneField::THERAPY_LED_OFF, newValue);
     sendResponse();
 }
 
@@ -1171,29 +1113,23 @@ void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE],
 // DEBUG MODE COMMAND
 // =============================================================================
 
-void MenuController::handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleDebug(const CommandArgs& args) {
     if (!_profiles) {
         sendError("Profile manager not available");
         return;
     }
 
     // Query mode: no parameter - return current value
-    if (paramCount == 0) {
+    if (args.count == 0) {
         beginResponse();
-        addResponseLine("DEBUG", _profiles->getDebugMode() ? "true" : "false");
+        addResponseField(PhoneField::DEBUG_MODE, _profiles->getDebugMode());
         sendResponse();
         return;
     }
 
     // Set mode: parse boolean value
     bool newValue = false;
-    const char* value = params[0];
-
-    if (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0) {
-        newValue = true;
-    } else if (strcasecmp(value, "false") == 0 || strcmp(value, "0") == 0) {
-        newValue = false;
-    } else {
+    if (!argToBool(args.params[0], newValue)) {
         sendError("Invalid value. Use: true/false or 1/0");
         return;
     }
@@ -1201,10 +1137,8 @@ void MenuController::handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t
     // Update setting
     _profiles->setDebugMode(newValue);
 
-    // Persist to flash
-    if (!_profiles->saveSettings()) {
-        Serial.println(F("[MENU] Warning: Failed to save settings"));
-    }
+    // Persisted from loop() once the phone stops toggling
+    _profiles->requestSave();
 
     // Sync to SECONDARY if connected
     if (_ble && _ble->isSecondaryConnected()) {
@@ -1215,6 +1149,99 @@ void MenuController::handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t
     }
 
     beginResponse();
-    addResponseLine("DEBUG", newValue ? "true" : "false");
+    addResponseField(PhoneField::DEBUG_MODE, newValue);
+    sendResponse();
+}
+
+// =============================================================================
+// LATENCY STREAM COMMAND
+// =============================================================================
+
+void MenuController::handleLatencyStream(const CommandArgs& args) {
+    // Query mode: no parameter - return current value
+    if (args.count == 0) {
+        beginResponse();
+        addResponseField(PhoneField::LATENCY_STREAM, latencyTelemetry.isStreaming());
+        sendResponse();
+        return;
+    }
+
+    bool newValue = false;
+    if (!argToBool(args.params[0], newValue)) {
+        sendError("Invalid value. Use: true/false or 1/0");
+        return;
+    }
+
+    // Session-scoped: not persisted, frames (LATS:) follow from the main loop
+    latencyTelemetry.setStreaming(newValue);
+
+    beginResponse();
+    addResponseField(PhoneField::LATENCY_STREAM, newValue);
+    sendResponse();
+}
+
+// =============================================================================
+// SESSION JOURNAL COMMAND
+// =============================================================================
+
+void MenuController::handleJournalGet(const CommandArgs& args) {
+#if SESSION_JOURNAL_ENABLED
+    // No parameter: how many chunks to fetch
+    if (args.count == 0) {
+        beginResponse();
+        addResponseField(PhoneField::CHUNKS, static_cast<int32_t>(sessionJournal.chunkCount()));
+        addResponseField(PhoneField::SESSION, static_cast<int32_t>(sessionJournal.sessionId()));
+        sendResponse();
+        return;
+    }
+
+    int32_t index = argToInt(args.params[0]);
+    uint8_t chunk[SESSION_JOURNAL_CHUNK_BYTES];
+    size_t length = 0;
+    if (index < 0 || !sessionJournal.readChunk(static_cast<uint32_t>(index), chunk, length)) {
+        sendError("Invalid chunk");
+        return;
+    }
+
+    beginResponse();
+    addResponseField(PhoneField::CHUNK, index);
+    addResponseField(PhoneField::DATA, chunk, length);
+    sendResponse();
+#else
+    (void)args;
+    sendError("Journal disabled");
+#endif
+}
+
+// =============================================================================
+// PERF PROFILE COMMAND
+// =============================================================================
+
+void MenuController::handlePerf(const CommandArgs& args) {
+#if PERF_PROFILE_ENABLED
+    // PERF:RESET clears the table (then reports it, all zero)
+    if (args.count > 0) {
+        if (!argEqualsIgnoreCase(args.params[0], "RESET")) {
+            sendError("Invalid value. Use: PERF or PERF:RESET");
+            return;
+        }
+        perfProfile.reset();
+    }
+
+    beginResponse();
+    addResponseField(PhoneField::CPU_MHZ, static_cast<int32_t>(platformCycleCounterHz() / 1000000UL));
+    for (uint8_t i = 0; i < PerfProfile::SCOPE_COUNT; i++) {
+        PerfScope scope = static_cast<PerfScope>(i);
+        PerfScopeStats stats = perfProfile.get(scope);
+        char line[64];
+        snprintf(line, sizeof(line), "%s,%lu,%lu,%lu,%lu", PerfProfile::scopeName(scope),
+                 static_cast<unsigned long>(stats.count), static_cast<unsigned long>(stats.minCycles),
+                 static_cast<unsigned long>(stats.avgCycles()), static_cast<unsigned long>(stats.maxCycles));
+        addResponseField(PhoneField::SCOPE, line);
+    }
     sendResponse();
+#else
+    (void)args;
+    sendError("Profiling disabled");
+#endif
 }
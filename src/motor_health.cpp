@@ -0,0 +1,213 @@
+/**
+ * @file motor_health.cpp
+ * @brief Continuous DRV2605 health monitor - Implementation
+ */
+
+#include "motor_health.h"
+#include <Arduino.h>
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+MotorHealthMonitor motorHealth;
+
+// =============================================================================
+// DRV2605 REGISTERS
+// =============================================================================
+
+namespace {
+
+constexpr uint8_t REG_STATUS = 0x00;
+constexpr uint8_t REG_MODE = 0x01;
+constexpr uint8_t REG_FEEDBACK = 0x1A;
+
+constexpr uint8_t STATUS_OC_DETECT = 0x01;
+constexpr uint8_t STATUS_OVER_TEMP = 0x02;
+constexpr uint8_t MODE_REALTIME = 0x05;   // RTP, out of standby (configureDRV2605)
+constexpr uint8_t MODE_POR_DEFAULT = 0x40; // STANDBY, internal trigger
+constexpr uint8_t FEEDBACK_N_ERM_LRA = 0x80;
+
+const char* const CHECK_NAMES[] = {"STATUS", "MODE", "FEEDBACK"};
+
+}  // namespace
+
+// =============================================================================
+// SCHEDULING
+// =============================================================================
+
+MotorHealthMonitor::MotorHealthMonitor() :
+    _watchMask(0),
+    _healMask(0),
+    _failedMask(0),
+    _nextFinger(0),
+    _nextCheck(0),
+    _motors{},
+    _slices(0),
+    _busy(0),
+    _overruns(0),
+    _maxSliceUs(0)
+{
+}
+
+void MotorHealthMonitor::begin(uint8_t watchMask) {
+    *this = MotorHealthMonitor();
+    _watchMask = static_cast<uint8_t>(watchMask & ((1u << MAX_ACTUATORS) - 1));
+}
+
+bool MotorHealthMonitor::nextSlice(uint32_t budgetUs, MotorHealthSlice& slice) {
+    // A queued reconfigure goes first when the gap has room for it
+    if (_healMask != 0 && budgetUs >= MOTOR_HEALTH_HEAL_COST_US) {
+        for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+            if (_healMask & (1u << f)) {
+                slice.finger = f;
+                slice.heal = true;
+                slice.check = MotorHealthCheck::STATUS;
+                return true;
+            }
+        }
+    }
+    if (budgetUs < MOTOR_HEALTH_SLICE_BUDGET_US) {
+        return false;
+    }
+
+    // Round-robin readback; a motor awaiting its reconfigure would only
+    // report the same reset again
+    uint8_t readable = static_cast<uint8_t>(_watchMask & ~_healMask);
+    if (readable == 0) {
+        return false;
+    }
+    while ((readable & (1u << _nextFinger)) == 0) {
+        _nextFinger = static_cast<uint8_t>((_nextFinger + 1) % MAX_ACTUATORS);
+        _nextCheck = 0;
+    }
+
+    slice.finger = _nextFinger;
+    slice.heal = false;
+    slice.check = static_cast<MotorHealthCheck>(_nextCheck);
+
+    _nextCheck++;
+    if (_nextCheck >= CHECK_COUNT) {
+        _nextCheck = 0;
+        _nextFinger = static_cast<uint8_t>((_nextFinger + 1) % MAX_ACTUATORS);
+    }
+    return true;
+}
+
+// =============================================================================
+// RESULTS
+// =============================================================================
+
+MotorHealthVerdict MotorHealthMonitor::judge(MotorHealthCheck check, uint8_t value) {
+    switch (check) {
+        case MotorHealthCheck::STATUS:
+            return (value & (STATUS_OC_DETECT | STATUS_OVER_TEMP)) ? MotorHealthVerdict::FAULT
+                                                                   : MotorHealthVerdict::OK;
+        case MotorHealthCheck::MODE:
+            if (value == MODE_REALTIME) {
+                return MotorHealthVerdict::OK;
+            }
+            return (value == MODE_POR_DEFAULT) ? MotorHealthVerdict::RESET : MotorHealthVerdict::FAULT;
+        case MotorHealthCheck::FEEDBACK:
+            return (value & FEEDBACK_N_ERM_LRA) ? MotorHealthVerdict::OK : MotorHealthVerdict::RESET;
+        default:
+            return MotorHealthVerdict::FAULT;
+    }
+}
+
+uint8_t MotorHealthMonitor::registerOf(MotorHealthCheck check) {
+    switch (check) {
+        case MotorHealthCheck::MODE:
+            return REG_MODE;
+        case MotorHealthCheck::FEEDBACK:
+            return REG_FEEDBACK;
+        default:
+            return REG_STATUS;
+    }
+}
+
+MotorHealthVerdict MotorHealthMonitor::recordRead(uint8_t finger, MotorHealthCheck check, uint8_t value) {
+    MotorHealthVerdict verdict = judge(check, value);
+    if (finger >= MAX_ACTUATORS) {
+        return verdict;
+    }
+    MotorHealthCounters& motor = _motors[finger];
+    const uint8_t bit = static_cast<uint8_t>(1u << finger);
+    motor.reads++;
+
+    if (verdict == MotorHealthVerdict::OK) {
+        motor.badStreak = 0;
+        if (motor.goodStreak < UINT8_MAX) {
+            motor.goodStreak++;
+        }
+        if (motor.failed && motor.goodStreak >= MOTOR_HEALTH_RECOVER_READS) {
+            motor.failed = false;
+            _failedMask = static_cast<uint8_t>(_failedMask & ~bit);
+        }
+        return verdict;
+    }
+
+    motor.errors++;
+    motor.goodStreak = 0;
+    if (motor.badStreak < UINT8_MAX) {
+        motor.badStreak++;
+    }
+    if (verdict == MotorHealthVerdict::RESET) {
+        motor.resets++;
+        _healMask |= bit;
+    }
+    if (!motor.failed && motor.badStreak >= MOTOR_HEALTH_FAIL_THRESHOLD) {
+        motor.failed = true;
+        motor.failures++;
+        _failedMask = static_cast<uint8_t>(_failedMask | bit);
+    }
+    return verdict;
+}
+
+void MotorHealthMonitor::recordBusy() {
+    _busy++;
+}
+
+void MotorHealthMonitor::recordHeal(uint8_t finger, bool done) {
+    if (!done || finger >= MAX_ACTUATORS) {
+        return;
+    }
+    _motors[finger].heals++;
+    _healMask = static_cast<uint8_t>(_healMask & ~(1u << finger));
+}
+
+void MotorHealthMonitor::recordSliceTime(const MotorHealthSlice& slice, uint32_t elapsedUs) {
+    _slices++;
+    if (elapsedUs > _maxSliceUs) {
+        _maxSliceUs = elapsedUs;
+    }
+    if (elapsedUs > costUs(slice)) {
+        _overruns++;
+    }
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+void MotorHealthMonitor::printReport() const {
+    Serial.println(F("=== MOTOR HEALTH ==="));
+    Serial.printf("Slices: %lu (busy %lu, over budget %lu, max %lu us)\n",
+                  static_cast<unsigned long>(_slices), static_cast<unsigned long>(_busy),
+                  static_cast<unsigned long>(_overruns), static_cast<unsigned long>(_maxSliceUs));
+    Serial.printf("Next: F%u %s\n", _nextFinger, CHECK_NAMES[_nextCheck]);
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        if ((_watchMask & (1u << f)) == 0) {
+            Serial.printf("  F%u: not watched\n", f);
+            continue;
+        }
+        const MotorHealthCounters& motor = _motors[f];
+        Serial.printf("  F%u: %-6s reads %lu, errors %lu, resets %lu, heals %lu, failures %lu%s\n",
+                      f, motor.failed ? "FAILED" : "OK",
+                      static_cast<unsigned long>(motor.reads), static_cast<unsigned long>(motor.errors),
+                      static_cast<unsigned long>(motor.resets), static_cast<unsigned long>(motor.heals),
+                      static_cast<unsigned long>(motor.failures),
+                      (_healMask & (1u << f)) ? " [heal queued]" : "");
+    }
+    Serial.println(F("===================="));
+}
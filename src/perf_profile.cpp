@@ -0,0 +1,104 @@
+/**
+ * @file perf_profile.cpp
+ * @brief Cycle-accurate per-scope profiling - Implementation
+ */
+
+#include "perf_profile.h"
+#include <Arduino.h>
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+#if PERF_PROFILE_ENABLED
+PerfProfile perfProfile;
+
+PerfScopeTimer::~PerfScopeTimer() {
+    perfProfile.record(_scope, platformCycleCount() - _start);
+}
+#endif
+
+static const char* const SCOPE_NAMES[] = {
+    "executeMotorEvent",
+    "processTxQueue",
+    "onBLEMessage",
+    "generateMacrocycle",
+    "deserializeMacrocycle",
+};
+
+static_assert(sizeof(SCOPE_NAMES) / sizeof(SCOPE_NAMES[0]) == PerfProfile::SCOPE_COUNT,
+              "SCOPE_NAMES must cover every PerfScope");
+
+// =============================================================================
+// TABLE
+// =============================================================================
+
+PerfProfile::PerfProfile() {
+    reset();
+}
+
+void PerfProfile::begin() {
+    platformCycleCounterInit();
+}
+
+void PerfProfile::record(PerfScope scope, uint32_t cycles) {
+    uint8_t index = static_cast<uint8_t>(scope);
+    if (index >= SCOPE_COUNT) {
+        return;
+    }
+    PLATFORM_CRITICAL_ENTER();
+    PerfScopeStats& stats = _stats[index];
+    if (stats.count == 0 || cycles < stats.minCycles) {
+        stats.minCycles = cycles;
+    }
+    if (cycles > stats.maxCycles) {
+        stats.maxCycles = cycles;
+    }
+    stats.totalCycles += cycles;
+    stats.count++;
+    PLATFORM_CRITICAL_EXIT();
+}
+
+PerfScopeStats PerfProfile::get(PerfScope scope) const {
+    PerfScopeStats copy = {};
+    uint8_t index = static_cast<uint8_t>(scope);
+    if (index < SCOPE_COUNT) {
+        PLATFORM_CRITICAL_ENTER();
+        copy = _stats[index];
+        PLATFORM_CRITICAL_EXIT();
+    }
+    return copy;
+}
+
+void PerfProfile::reset() {
+    PLATFORM_CRITICAL_ENTER();
+    for (uint8_t i = 0; i < SCOPE_COUNT; i++) {
+        _stats[i] = {};
+    }
+    PLATFORM_CRITICAL_EXIT();
+}
+
+uint32_t PerfProfile::cyclesToUs(uint32_t cycles) {
+    uint32_t mhz = platformCycleCounterHz() / 1000000UL;
+    return mhz > 0 ? cycles / mhz : cycles;
+}
+
+const char* PerfProfile::scopeName(PerfScope scope) {
+    uint8_t index = static_cast<uint8_t>(scope);
+    return index < SCOPE_COUNT ? SCOPE_NAMES[index] : "?";
+}
+
+void PerfProfile::printReport() const {
+    Serial.printf("=== Perf Profile (cycles @ %lu MHz) ===\n",
+                  static_cast<unsigned long>(platformCycleCounterHz() / 1000000UL));
+    Serial.println(F("scope                    count        min        avg        max   max_us"));
+    for (uint8_t i = 0; i < SCOPE_COUNT; i++) {
+        PerfScopeStats stats = get(static_cast<PerfScope>(i));
+        Serial.printf("%-22s %7lu %10lu %10lu %10lu %8lu\n", SCOPE_NAMES[i],
+                      static_cast<unsigned long>(stats.count),
+                      static_cast<unsigned long>(stats.minCycles),
+                      static_cast<unsigned long>(stats.avgCycles()),
+                      static_cast<unsigned long>(stats.maxCycles),
+                      static_cast<unsigned long>(cyclesToUs(stats.maxCycles)));
+    }
+}
@@ -0,0 +1,292 @@
+/**
+ * @file phone_protocol.cpp
+ * @brief Phone response wire formats - Implementation
+ */
+
+#include "phone_protocol.h"
+#include <string.h>
+#include <math.h>
+
+// Same escape set and whitening as MACROCYCLE V6 (sync_protocol.cpp)
+static constexpr uint8_t PHONE_V3_ESCAPE = 0x1B;
+static constexpr uint8_t PHONE_V3_ESCAPE_XOR = 0x20;
+static constexpr uint8_t PHONE_V3_WHITEN = 0x80;
+static constexpr uint8_t PHONE_EOT = 0x04;
+
+static inline bool phoneNeedsEscape(uint8_t b) {
+    return b == 0x00 || b == PHONE_EOT || b == '\r' || b == PHONE_V3_ESCAPE;
+}
+
+// =============================================================================
+// FIELD KEYS
+// =============================================================================
+
+static const char* const PHONE_FIELD_KEYS[] = {
+    "",
+    "ERROR",
+    "STATUS",
+    "SESSION_STATUS",
+    "ROLE",
+    "NAME",
+    "FW",
+    "MOTORS",
+    "PROFILE",
+    "BATP",
+    "BATS",
+    "PONG",
+    "TYPE",
+    "FREQ",
+    "ON",
+    "OFF",
+    "SESSION",
+    "AMPMIN",
+    "AMPMAX",
+    "PATTERN",
+    "MIRROR",
+    "JITTER",
+    "ELAPSED",
+    "TOTAL",
+    "PROGRESS",
+    "PARAM",
+    "VALUE",
+    "MODE",
+    "FINGER",
+    "INTENSITY",
+    "DURATION",
+    "COMMAND",
+    "THERAPY_LED_OFF",
+    "DEBUG",
+    "LATENCY_STREAM",
+    "CHUNKS",
+    "CHUNK",
+    "DATA",
+    "CPU_MHZ",
+    "SCOPE",
+};
+
+static_assert(sizeof(PHONE_FIELD_KEYS) / sizeof(PHONE_FIELD_KEYS[0]) ==
+              static_cast<size_t>(PhoneField::SCOPE) + 1,
+              "PHONE_FIELD_KEYS must cover every PhoneField");
+
+const char* phoneFieldKey(PhoneField field) {
+    size_t index = static_cast<size_t>(field);
+    if (index >= sizeof(PHONE_FIELD_KEYS) / sizeof(PHONE_FIELD_KEYS[0])) {
+        return "";
+    }
+    return PHONE_FIELD_KEYS[index];
+}
+
+// =============================================================================
+// NEGOTIATION
+// =============================================================================
+
+uint8_t phoneProtocolFromIdentify(const char* message, uint8_t latest) {
+    static const char PREFIX[] = "IDENTIFY:PHONE";
+    const size_t prefixLen = sizeof(PREFIX) - 1;
+    if (message == nullptr || strncmp(message, PREFIX, prefixLen) != 0) {
+        return 0;
+    }
+
+    const char* p = message + prefixLen;
+    uint32_t requested = PHONE_PROTOCOL_TEXT;
+    if (*p == ':') {
+        p++;
+        if (*p < '0' || *p > '9') {
+            return 0;
+        }
+        requested = 0;
+        while (*p >= '0' && *p <= '9') {
+            if (requested < 256) {
+                requested = requested * 10 + static_cast<uint32_t>(*p - '0');
+            }
+            p++;
+        }
+    }
+    if (*p != '\0') {
+        return 0;
+    }
+
+    if (requested > latest) {
+        requested = latest;
+    }
+    if (requested < PHONE_PROTOCOL_TEXT) {
+        requested = PHONE_PROTOCOL_TEXT;
+    }
+    return static_cast<uint8_t>(requested);
+}
+
+// =============================================================================
+// FRAME WRITER
+// =============================================================================
+
+PhoneFrameWriter::PhoneFrameWriter() :
+    _buffer(nullptr),
+    _capacity(0),
+    _pos(0),
+    _overflow(false)
+{
+}
+
+void PhoneFrameWriter::begin(char* buffer, size_t capacity, uint8_t command, uint8_t flags) {
+    _buffer = buffer;
+    _capacity = capacity;
+    _pos = 0;
+    _overflow = false;
+
+    if (_buffer == nullptr || _capacity < 1) {
+        _overflow = true;
+        return;
+    }
+    _buffer[_pos++] = static_cast<char>(PHONE_V3_MARKER);
+    if (!putByte(command) || !putByte(flags)) {
+        _pos = 0;
+        _overflow = true;
+    }
+}
+
+bool PhoneFrameWriter::putByte(uint8_t b) {
+    b ^= PHONE_V3_WHITEN;
+    if (phoneNeedsEscape(b)) {
+        if (_pos + 2 > _capacity) {
+            return false;
+        }
+        _buffer[_pos++] = static_cast<char>(PHONE_V3_ESCAPE);
+        _buffer[_pos++] = static_cast<char>(b ^ PHONE_V3_ESCAPE_XOR);
+        return true;
+    }
+    if (_pos + 1 > _capacity) {
+        return false;
+    }
+    _buffer[_pos++] = static_cast<char>(b);
+    return true;
+}
+
+bool PhoneFrameWriter::putField(PhoneField field, const uint8_t* prefix, size_t prefixLen,
+                                const uint8_t* value, size_t valueLen) {
+    if (_buffer == nullptr || _pos == 0 || prefixLen + valueLen > 255) {
+        _overflow = true;
+        return false;
+    }
+
+    size_t start = _pos;
+    bool ok = putByte(static_cast<uint8_t>(field)) &&
+              putByte(static_cast<uint8_t>(prefixLen + valueLen));
+    for (size_t i = 0; ok && i < prefixLen; i++) {
+        ok = putByte(prefix[i]);
+    }
+    for (size_t i = 0; ok && i < valueLen; i++) {
+        ok = putByte(value[i]);
+    }
+    if (!ok) {
+        _pos = start;
+        _overflow = true;
+    }
+    return ok;
+}
+
+bool PhoneFrameWriter::putInt(PhoneField field, int32_t value) {
+    uint8_t bytes[4];
+    size_t width = (value >= INT8_MIN && value <= INT8_MAX)   ? 1
+                 : (value >= INT16_MIN && value <= INT16_MAX) ? 2
+                                                              : 4;
+    uint32_t raw = static_cast<uint32_t>(value);
+    for (size_t i = 0; i < width; i++) {
+        bytes[i] = static_cast<uint8_t>(raw >> (8 * i));
+    }
+    return putField(field, nullptr, 0, bytes, width);
+}
+
+bool PhoneFrameWriter::putFixed(PhoneField field, float value, uint8_t decimals) {
+    float scaled = value;
+    for (uint8_t i = 0; i < decimals; i++) {
+        scaled *= 10.0f;
+    }
+    if (scaled >= 2147483647.0f) {
+        return putInt(field, INT32_MAX);
+    }
+    if (scaled <= -2147483648.0f) {
+        return putInt(field, INT32_MIN);
+    }
+    return putInt(field, static_cast<int32_t>(lroundf(scaled)));
+}
+
+bool PhoneFrameWriter::putBool(PhoneField field, bool value) {
+    uint8_t b = value ? 1 : 0;
+    return putField(field, nullptr, 0, &b, 1);
+}
+
+bool PhoneFrameWriter::putString(PhoneField field, std::string_view value) {
+    return putField(field, nullptr, 0, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+bool PhoneFrameWriter::putEmpty(PhoneField field) {
+    return putField(field, nullptr, 0, nullptr, 0);
+}
+
+bool PhoneFrameWriter::putIdString(PhoneField field, uint8_t id, std::string_view name) {
+    return putField(field, &id, 1, reinterpret_cast<const uint8_t*>(name.data()), name.size());
+}
+
+// =============================================================================
+// FRAME READER
+// =============================================================================
+
+bool PhoneFrameReader::open(const char* frame, size_t length) {
+    _length = 0;
+    _pos = 0;
+    if (frame == nullptr || length < 1 || static_cast<uint8_t>(frame[0]) != PHONE_V3_MARKER) {
+        return false;
+    }
+
+    for (size_t i = 1; i < length; i++) {
+        uint8_t b = static_cast<uint8_t>(frame[i]);
+        if (b == PHONE_V3_ESCAPE) {
+            if (++i >= length) {
+                return false;  // dangling escape
+            }
+            b = static_cast<uint8_t>(frame[i]) ^ PHONE_V3_ESCAPE_XOR;
+        }
+        if (_length >= sizeof(_body)) {
+            return false;
+        }
+        _body[_length++] = b ^ PHONE_V3_WHITEN;
+    }
+
+    if (_length < 2) {
+        return false;
+    }
+    _command = _body[0];
+    _flags = _body[1];
+    _pos = 2;
+    return true;
+}
+
+bool PhoneFrameReader::next(PhoneField& field, const uint8_t*& value, uint8_t& length) {
+    if (_pos + 2 > _length) {
+        return false;
+    }
+    uint8_t fieldLen = _body[_pos + 1];
+    if (_pos + 2 + fieldLen > _length) {
+        return false;
+    }
+    field = static_cast<PhoneField>(_body[_pos]);
+    length = fieldLen;
+    value = &_body[_pos + 2];
+    _pos += 2 + fieldLen;
+    return true;
+}
+
+int32_t PhoneFrameReader::intValue(const uint8_t* value, uint8_t length) {
+    if (value == nullptr || length == 0 || length > 4) {
+        return 0;
+    }
+    uint32_t raw = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        raw |= static_cast<uint32_t>(value[i]) << (8 * i);
+    }
+    // Sign-extend from the top byte
+    if (length < 4 && (value[length - 1] & 0x80)) {
+        raw |= 0xFFFFFFFFu << (8 * length);
+    }
+    return static_cast<int32_t>(raw);
+}
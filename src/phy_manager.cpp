@@ -0,0 +1,237 @@
+/**
+ * @file phy_manager.cpp
+ * @brief Automatic PHY selection - Implementation
+ */
+
+#include "phy_manager.h"
+
+// EMA weight of one exchange: 1/4
+static constexpr int32_t RETX_EMA_SHIFT = 2;
+
+// =============================================================================
+// PHY HELPERS
+// =============================================================================
+
+uint8_t blePhyMask(BlePhy phy) {
+    switch (phy) {
+        case BlePhy::PHY_2M: return 0x02;
+        case BlePhy::CODED:  return 0x04;
+        default:             return 0x01;
+    }
+}
+
+bool blePhyFromMask(uint8_t phyMask, BlePhy& phy) {
+    switch (phyMask) {
+        case 0x01: phy = BlePhy::PHY_1M; return true;
+        case 0x02: phy = BlePhy::PHY_2M; return true;
+        case 0x04: phy = BlePhy::CODED;  return true;
+        default:   return false;
+    }
+}
+
+const char* blePhyName(BlePhy phy) {
+    switch (phy) {
+        case BlePhy::PHY_2M: return "2M";
+        case BlePhy::CODED:  return "Coded";
+        default:             return "1M";
+    }
+}
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+PhyManager::PhyManager(BlePhy fastest, BlePhy slowest) :
+    _fastest(fastest),
+    _slowest(slowest),
+    _linkUpPending(false),
+    _rttPending(false),
+    _pendingRttUs(0),
+    _switchCount(0),
+    _refusedCount(0)
+{
+    reset();
+}
+
+void PhyManager::reset() {
+    _current = BlePhy::PHY_1M;  // Every link comes up on 1M
+    _requestPending = false;
+    _requested = BlePhy::PHY_1M;
+    _requestMs = 0;
+    _retxQ8 = 0;
+    _samples = 0;
+    _missRun = 0;
+    _lastMissedPongs = 0;
+    _missBaselineSet = false;
+    _changedMs = 0;
+    _quietSinceMs = 0;
+    _rttPending = false;
+    for (uint8_t i = 0; i < BLE_PHY_COUNT; i++) {
+        _minRttUs[i] = UINT32_MAX;
+        _holdUntilMs[i] = 0;
+        _backoffMs[i] = BLE_PHY_AUTO_PROBE_MS;
+    }
+}
+
+void PhyManager::resetQuality() {
+    for (uint8_t i = 0; i < BLE_PHY_COUNT; i++) {
+        _minRttUs[i] = UINT32_MAX;
+    }
+    _retxQ8 = 0;
+    _samples = 0;
+}
+
+// =============================================================================
+// INPUTS
+// =============================================================================
+
+void PhyManager::onPhyChanged(BlePhy phy, uint32_t nowMs) {
+    _requestPending = false;
+    if (phy == _current) {
+        return;
+    }
+    _current = phy;
+    _switchCount++;
+    _changedMs = nowMs;
+    _quietSinceMs = nowMs;
+    _retxQ8 = 0;
+    _samples = 0;
+    _missRun = 0;
+}
+
+void PhyManager::foldRetx(uint32_t retxQ8) {
+    int32_t ema = static_cast<int32_t>(_retxQ8);
+    ema += (static_cast<int32_t>(retxQ8) - ema) >> RETX_EMA_SHIFT;
+    _retxQ8 = static_cast<uint32_t>(ema < 0 ? 0 : ema);
+    if (_samples < UINT16_MAX) {
+        _samples++;
+    }
+}
+
+void PhyManager::foldExchange(uint32_t rttUs, uint32_t intervalUs) {
+    uint32_t& minRtt = _minRttUs[slot(_current)];
+    if (rttUs < minRtt) {
+        minRtt = rttUs;
+    } else if (minRtt != UINT32_MAX) {
+        minRtt += SYNC_MIN_RTT_DECAY_US;  // Creep up so the reference follows a slower link
+    }
+
+    // Whole connection intervals above the minimum: the sub-interval part
+    // is anchor alignment, not a resend
+    uint32_t retx = 0;
+    if (intervalUs > 0 && rttUs > minRtt) {
+        retx = (rttUs - minRtt) / intervalUs;
+        if (retx > BLE_PHY_AUTO_MAX_RETX) {
+            retx = BLE_PHY_AUTO_MAX_RETX;
+        }
+    }
+    foldRetx(retx << 8);
+}
+
+// =============================================================================
+// POLICY
+// =============================================================================
+
+void PhyManager::holdOff(BlePhy phy, uint32_t nowMs) {
+    uint8_t i = slot(phy);
+    _holdUntilMs[i] = nowMs + _backoffMs[i];
+    if (_holdUntilMs[i] == 0) {
+        _holdUntilMs[i] = 1;  // 0 means no hold
+    }
+    uint32_t doubled = _backoffMs[i] * 2;
+    _backoffMs[i] = (doubled > BLE_PHY_AUTO_PROBE_MAX_MS) ? BLE_PHY_AUTO_PROBE_MAX_MS : doubled;
+}
+
+bool PhyManager::heldOff(uint8_t phySlot, uint32_t nowMs) {
+    if (_holdUntilMs[phySlot] == 0) {
+        return false;
+    }
+    if (static_cast<int32_t>(nowMs - _holdUntilMs[phySlot]) >= 0) {
+        _holdUntilMs[phySlot] = 0;  // Expired: clear before millis() wraps past it
+        return false;
+    }
+    return true;
+}
+
+bool PhyManager::startRequest(BlePhy phy, uint32_t nowMs, BlePhy& out) {
+    _requestPending = true;
+    _requested = phy;
+    _requestMs = nowMs;
+    out = phy;
+    return true;
+}
+
+bool PhyManager::update(uint32_t nowMs, uint32_t intervalUs, uint32_t missedPongs, BlePhy& request) {
+    if (_linkUpPending) {
+        _linkUpPending = false;
+        reset();
+        _changedMs = nowMs;
+        _quietSinceMs = nowMs;
+    }
+
+    if (!_missBaselineSet) {
+        _lastMissedPongs = missedPongs;
+        _missBaselineSet = true;
+    }
+    uint32_t missed = missedPongs - _lastMissedPongs;
+    _lastMissedPongs = missedPongs;
+    for (uint32_t i = 0; i < missed && i < BLE_PHY_AUTO_MISS_LIMIT; i++) {
+        if (_missRun < UINT8_MAX) {
+            _missRun++;
+        }
+        foldRetx(static_cast<uint32_t>(BLE_PHY_AUTO_MISS_RETX) << 8);
+    }
+
+    if (_rttPending) {
+        _rttPending = false;
+        _missRun = 0;
+        foldExchange(_pendingRttUs, intervalUs);
+    }
+
+    bool quiet = _samples >= BLE_PHY_AUTO_MIN_SAMPLES && _missRun == 0 &&
+                 _retxQ8 <= BLE_PHY_AUTO_RECOVER_RETX_Q8;
+    if (!quiet) {
+        _quietSinceMs = nowMs;
+    }
+
+    if (_requestPending) {
+        if (nowMs - _requestMs < BLE_PHY_AUTO_REQUEST_TIMEOUT_MS) {
+            return false;
+        }
+        // Never answered (e.g. peer without Coded support): don't ask again soon
+        _requestPending = false;
+        _refusedCount++;
+        holdOff(_requested, nowMs);
+    }
+
+    if (nowMs - _changedMs < BLE_PHY_AUTO_MIN_DWELL_MS) {
+        return false;
+    }
+
+    // Step down: next slower rung that has not refused recently
+    bool degraded = _missRun >= BLE_PHY_AUTO_MISS_LIMIT ||
+                    (_samples >= BLE_PHY_AUTO_MIN_SAMPLES && _retxQ8 >= BLE_PHY_AUTO_DEGRADE_RETX_Q8);
+    if (degraded) {
+        for (uint8_t i = slot(_current) + 1; i <= slot(_slowest); i++) {
+            if (!heldOff(i, nowMs)) {
+                holdOff(_current, nowMs);
+                return startRequest(static_cast<BlePhy>(i), nowMs, request);
+            }
+        }
+        return false;
+    }
+
+    // Probe up: the current rung has proven itself, so its own back-off restarts
+    if (nowMs - _quietSinceMs < BLE_PHY_AUTO_PROBE_MS) {
+        return false;
+    }
+    _backoffMs[slot(_current)] = BLE_PHY_AUTO_PROBE_MS;
+    if (slot(_current) <= slot(_fastest)) {
+        return false;
+    }
+    uint8_t faster = slot(_current) - 1;
+    if (heldOff(faster, nowMs)) {
+        return false;
+    }
+    return startRequest(static_cast<BlePhy>(faster), nowMs, request);
+}
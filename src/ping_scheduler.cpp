@@ -0,0 +1,93 @@
+/**
+ * @file ping_scheduler.cpp
+ * @brief Adaptive PING cadence - Implementation
+ */
+
+#include "ping_scheduler.h"
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+PingScheduler::PingScheduler() :
+    _burstPending(false),
+    _pongPending(false),
+    _pongAccepted(false),
+    _awaitingPong(false),
+    _burstRemaining(0),
+    _intervalMs(KEEPALIVE_INTERVAL_MS),
+    _lastPingMs(0),
+    _nextDueMs(0),
+    _missedPongs(0)
+{
+}
+
+// =============================================================================
+// POLICY
+// =============================================================================
+
+uint32_t PingScheduler::baseIntervalMs(bool therapyRunning) {
+    return therapyRunning ? SYNC_ACTIVE_INTERVAL_MS : KEEPALIVE_INTERVAL_MS;
+}
+
+void PingScheduler::adapt(bool accepted, bool syncValid, uint32_t uncertaintyUs, uint32_t baseMs) {
+    if (!accepted || !syncValid || uncertaintyUs > SYNC_PING_UNSTABLE_UNCERTAINTY_US) {
+        _intervalMs = baseMs;
+    } else if (uncertaintyUs <= SYNC_PING_STABLE_UNCERTAINTY_US) {
+        uint32_t doubled = _intervalMs * 2;
+        _intervalMs = (doubled > SYNC_PING_MAX_INTERVAL_MS) ? SYNC_PING_MAX_INTERVAL_MS : doubled;
+    }
+}
+
+bool PingScheduler::update(uint32_t nowMs, bool syncValid, uint32_t uncertaintyUs, bool therapyRunning) {
+    uint32_t baseMs = baseIntervalMs(therapyRunning);
+
+    if (_burstPending) {
+        _burstPending = false;
+        _burstRemaining = SYNC_PING_BURST_COUNT;
+        _awaitingPong = false;
+        _intervalMs = baseMs;
+        _nextDueMs = nowMs;
+    }
+
+    if (_pongPending) {
+        _pongPending = false;
+        _awaitingPong = false;
+        if (_burstRemaining > 0) {
+            _nextDueMs = nowMs + SYNC_PING_BURST_GAP_MS;
+        } else {
+            adapt(_pongAccepted, syncValid, uncertaintyUs, baseMs);
+            _nextDueMs = _lastPingMs + _intervalMs;
+        }
+    }
+
+    // Base cadence is a floor: stopping therapy raises it, and invalid sync
+    // (e.g. reset after a PHY change) forfeits the backoff
+    if (_intervalMs < baseMs || (!syncValid && _burstRemaining == 0)) {
+        _intervalMs = baseMs;
+        if (static_cast<int32_t>(_nextDueMs - (_lastPingMs + _intervalMs)) > 0) {
+            _nextDueMs = _lastPingMs + _intervalMs;
+        }
+    }
+
+    if (static_cast<int32_t>(nowMs - _nextDueMs) < 0) {
+        return false;
+    }
+
+    if (_awaitingPong) {
+        _missedPongs++;
+        if (_burstRemaining == 0) {
+            // Previous PING went unanswered: the link is fragile, stay close
+            _intervalMs = baseMs;
+        }
+    }
+    _awaitingPong = true;
+    _lastPingMs = nowMs;
+    if (_burstRemaining > 0) {
+        _burstRemaining--;
+        _nextDueMs = nowMs + SYNC_PING_BURST_TIMEOUT_MS;
+    } else {
+        _nextDueMs = nowMs + _intervalMs;
+    }
+    return true;
+}
@@ -12,6 +12,12 @@
  * in shutdown and holds the mux in reset; driving it HIGH again RESETS EVERY
  * DRV2605 REGISTER TO POR DEFAULTS - any runtime toggle must be followed by
  * re-running the full haptic configuration for all fingers.
+ *
+ * Idle sleep: esp_pm automatic light sleep (needs the core built with
+ * tickless idle) or, failing that, dynamic frequency scaling only. Two PM
+ * locks (no light sleep, max CPU frequency) are held except while the motor
+ * task blocks through a long gap. The NimBLE controller holds its own lock
+ * whenever the radio needs the main clock.
  */
 
 #include "power_controller.h"
@@ -19,12 +25,28 @@
 #include "hardware.h"
 
 #include "esp_sleep.h"
+#include "esp_pm.h"
+#include "esp_attr.h"
+#include "platform.h"
+#include "loop_wake.h"
+
+// Held = awake at full speed (see setIdleSleepAllowed())
+static esp_pm_lock_handle_t s_noSleepLock = nullptr;
+static esp_pm_lock_handle_t s_cpuMaxLock = nullptr;
+static bool s_locksHeld = false;
+
+// Switch-off edge: loop() blocks between events and would otherwise see the
+// request only at its next timeout
+static void IRAM_ATTR onPowerSwitchFalling() {
+    loopWake.notifyFromIsr(LOOP_WAKE_POWER);
+}
 
 void PowerController::begin() {
     pinMode(ENABLE_PIN_OVERRIDE, OUTPUT);
     digitalWrite(ENABLE_PIN_OVERRIDE, HIGH);  // DRV2605 EN + mux out of reset
     pinMode(POWER_SWITCH_PIN_OVERRIDE, INPUT);
     pinMode(USB_POW_DETECT_PIN_OVERRIDE, INPUT);
+    attachInterrupt(digitalPinToInterrupt(POWER_SWITCH_PIN_OVERRIDE), onPowerSwitchFalling, FALLING);
     Serial.println(F("[POWER] Power controller initialized (motor drivers enabled)"));
 }
 
@@ -53,3 +75,52 @@ void PowerController::enterDeepSleep(LEDController& led) {
 bool PowerController::usbPowerPresent() {
     return digitalRead(USB_POW_DETECT_PIN_OVERRIDE) == HIGH;
 }
+
+bool PowerController::beginIdleSleep() {
+    if (s_cpuMaxLock != nullptr) {
+        return true;
+    }
+    if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "motor", &s_noSleepLock) != ESP_OK ||
+        esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "motor", &s_cpuMaxLock) != ESP_OK) {
+        if (s_noSleepLock != nullptr) {
+            esp_pm_lock_delete(s_noSleepLock);
+        }
+        s_noSleepLock = nullptr;
+        s_cpuMaxLock = nullptr;
+        Serial.println(F("[POWER] Idle sleep unavailable (power management disabled)"));
+        return false;
+    }
+    esp_pm_lock_acquire(s_noSleepLock);
+    esp_pm_lock_acquire(s_cpuMaxLock);
+    s_locksHeld = true;
+
+    esp_pm_config_t config = {};
+    config.max_freq_mhz = getCpuFrequencyMhz();
+    config.min_freq_mhz = 80;
+    config.light_sleep_enable = true;
+    if (esp_pm_configure(&config) == ESP_OK) {
+        Serial.println(F("[POWER] Idle sleep: automatic light sleep"));
+        return true;
+    }
+    config.light_sleep_enable = false;
+    if (esp_pm_configure(&config) == ESP_OK) {
+        Serial.println(F("[POWER] Idle sleep: frequency scaling only (no tickless idle in core)"));
+        return true;
+    }
+    Serial.println(F("[POWER] Idle sleep unavailable (esp_pm_configure failed)"));
+    return false;
+}
+
+void PowerController::setIdleSleepAllowed(bool allowed) {
+    if (s_cpuMaxLock == nullptr || allowed == !s_locksHeld) {
+        return;  // Unavailable, or already in the requested state
+    }
+    if (allowed) {
+        esp_pm_lock_release(s_cpuMaxLock);
+        esp_pm_lock_release(s_noSleepLock);
+    } else {
+        esp_pm_lock_acquire(s_noSleepLock);
+        esp_pm_lock_acquire(s_cpuMaxLock);
+    }
+    s_locksHeld = !allowed;
+}
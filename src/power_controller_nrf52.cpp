@@ -1,6 +1,11 @@
 /**
  * @file power_controller_nrf52.cpp
- * @brief Power controller no-op backend (Feather nRF52840 has no power switch)
+ * @brief Power controller nRF52 backend (Feather nRF52840 has no power switch)
+ *
+ * Idle sleep needs no configuration: the Adafruit core runs FreeRTOS with
+ * tickless idle, and its idle hook waits in sd_app_evt_wait() (WFE) once
+ * every task blocks. TIMER4 and its compare interrupt keep running (HFXO
+ * stays requested), so the motor task's hires alarm and BLE events wake it.
  */
 
 #include "power_controller.h"
@@ -16,3 +21,9 @@ void PowerController::enterDeepSleep(LEDController&) {}
 bool PowerController::usbPowerPresent() {
     return false;
 }
+
+bool PowerController::beginIdleSleep() {
+    return true;
+}
+
+void PowerController::setIdleSleepAllowed(bool) {}
@@ -0,0 +1,163 @@
+/**
+ * @file preselect_planner.cpp
+ * @brief Look-ahead I2C pre-selection plan implementation
+ */
+
+#include "preselect_planner.h"
+
+// Global instance
+PreselectPlanner preselectPlanner;
+
+PreselectPlanner::PreselectPlanner()
+    : _batchWindowUs(0)
+    , _prevEndUs(0)
+    , _groupStartUs(0)
+    , _groupGapUs(0)
+    , _groupSize(0)
+    , _gapValid(false)
+    , _gapStartUs(0)
+    , _gapEndUs(0)
+    , _gapBudgetUs(0)
+    , _stagedHead(0)
+    , _stagedCount(0)
+    , _stats()
+{
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        _freeFromUs[f] = 0;
+    }
+}
+
+void PreselectPlanner::begin(uint64_t nowUs, uint32_t batchWindowUs) {
+    _batchWindowUs = batchWindowUs;
+    _prevEndUs = nowUs;
+    for (uint8_t f = 0; f < MAX_ACTUATORS; f++) {
+        _freeFromUs[f] = nowUs;
+    }
+    _groupSize = 0;
+    _gapValid = false;
+    _stagedHead = 0;
+    _stagedCount = 0;
+
+    _stats.activations = 0;
+    _stats.fast = 0;
+    _stats.staged = 0;
+    _stats.slow = 0;
+    _stats.plans++;
+}
+
+void PreselectPlanner::add(uint64_t timeUs, uint8_t finger, bool activate, uint16_t frequencyHz) {
+    if (finger >= MAX_ACTUATORS) {
+        return;
+    }
+
+    // Same split as dispatch: a cluster starts at its first event and takes
+    // everything due within the batch window
+    if (_groupSize > 0 &&
+        (_batchWindowUs == 0 || timeUs > _groupStartUs + _batchWindowUs || _groupSize == MAX_GROUP)) {
+        closeGroup();
+    }
+    if (_groupSize == 0) {
+        openGroup(timeUs);
+    }
+
+    _groupFinger[_groupSize] = finger;
+    _groupFrequency[_groupSize] = frequencyHz;
+    _groupActivate[_groupSize] = activate;
+    _groupSize++;
+}
+
+void PreselectPlanner::finish() {
+    if (_groupSize > 0) {
+        closeGroup();
+    }
+}
+
+void PreselectPlanner::openGroup(uint64_t timeUs) {
+    _groupStartUs = timeUs;
+    _groupGapUs = (timeUs > _prevEndUs) ? timeUs - _prevEndUs : 0;
+
+    // The gap up to this group's pre-select slot takes staged writes
+    uint64_t slotUs = (timeUs > PRESELECT_LEAD_US) ? timeUs - PRESELECT_LEAD_US : 0;
+    if (slotUs >= _prevEndUs + PRESELECT_COST_US) {
+        _gapValid = true;
+        _gapStartUs = _prevEndUs;
+        _gapEndUs = slotUs;
+        _gapBudgetUs = slotUs - _prevEndUs;
+    }
+}
+
+void PreselectPlanner::closeGroup() {
+    // A late group runs as soon as the bus frees up
+    uint64_t startUs = (_groupStartUs > _prevEndUs) ? _groupStartUs : _prevEndUs;
+    uint64_t endUs = startUs + static_cast<uint64_t>(_groupSize) * PRESELECT_EVENT_COST_US;
+
+    bool burst = (_groupSize > 1);
+    for (uint8_t i = 0; i < _groupSize; i++) {
+        uint8_t finger = _groupFinger[i];
+        if (!_groupActivate[i]) {
+            // Marked before later members: a re-activation in the same burst
+            // cannot have its frequency staged under the running pulse
+            _freeFromUs[finger] = endUs;
+            continue;
+        }
+        _stats.activations++;
+        if (!burst && _groupGapUs >= PRESELECT_COST_US) {
+            _stats.fast++;
+        } else if (stage(finger, _groupFrequency[i])) {
+            _stats.staged++;
+        } else {
+            _stats.slow++;
+        }
+    }
+
+    _prevEndUs = endUs;
+    _groupSize = 0;
+}
+
+bool PreselectPlanner::stage(uint8_t finger, uint16_t frequencyHz) {
+    // The write must not change the frequency under the motor's previous
+    // activation, and must fit what earlier staged writes left of the gap
+    if (!_gapValid || _gapStartUs < _freeFromUs[finger] ||
+        _gapBudgetUs < PRESELECT_COST_US || _stagedCount >= MAX_STAGED) {
+        return false;
+    }
+
+    StagedWrite& write = _staged[_stagedCount++];
+    write.notBeforeUs = _gapStartUs;
+    write.deadlineUs = _gapEndUs;
+    write.finger = finger;
+    write.frequencyHz = frequencyHz;
+    _gapBudgetUs -= PRESELECT_COST_US;
+    return true;
+}
+
+bool PreselectPlanner::takeStagedWrite(uint64_t nowUs, uint8_t& finger, uint16_t& frequencyHz) {
+    while (_stagedHead < _stagedCount) {
+        const StagedWrite& write = _staged[_stagedHead];
+        if (nowUs + PRESELECT_COST_US > write.deadlineUs) {
+            // Gap passed (motor task was busy) - the activation runs slow
+            _stagedHead++;
+            _stats.stagedMissed++;
+            continue;
+        }
+        if (nowUs < write.notBeforeUs) {
+            return false;
+        }
+        finger = write.finger;
+        frequencyHz = write.frequencyHz;
+        _stagedHead++;
+        _stats.stagedWrites++;
+        return true;
+    }
+    return false;
+}
+
+PreselectPlanStats PreselectPlanner::getStats() const {
+    return _stats;
+}
+
+void PreselectPlanner::resetStats() {
+    _stats.plans = 0;
+    _stats.stagedWrites = 0;
+    _stats.stagedMissed = 0;
+}
@@ -7,22 +7,129 @@
 
 #include "profile_manager.h"
 #include "fs_backend.h"
+#include <array>
+
+// =============================================================================
+// BUILT-IN PROFILES (flash-resident)
+// =============================================================================
+
+namespace {
+
+// Canonical pattern names; TherapyProfile::patternType always points here
+constexpr const char* PATTERN_TYPE_NAMES[] = {"rndp", "sequential", "mirrored"};
+
+constexpr TherapyProfile builtIn(const char* name, const char* description,
+                                 TherapyTiming timing, uint8_t ampMin, uint8_t ampMax,
+                                 uint16_t durationMin, const char* patternType,
+                                 bool mirror, bool frequencyRandomization = false,
+                                 bool isDefault = false) {
+    TherapyProfile p;
+    p.name = name;
+    p.description = description;
+    p.timing = timing;
+    p.amplitudeMin = ampMin;
+    p.amplitudeMax = ampMax;
+    p.sessionDurationMin = durationMin;
+    p.patternType = patternType;
+    p.mirrorPattern = mirror;
+    p.frequencyRandomization = frequencyRandomization;
+    p.isDefault = isDefault;
+    return p;
+}
+
+// Never copied to RAM as a whole: loadProfile() materializes one entry into
+// the current profile. Actuator LRA @ 250Hz, all fingers, 210-260Hz random
+// range come from the TherapyProfile defaults.
+constexpr TherapyProfile BUILT_IN_PROFILES[] = {
+    // =========================================================================
+    // V1 ORIGINAL PROFILES (research-based vCR therapy)
+    // =========================================================================
+
+    // Profile 1: Regular vCR (Default) - Non-mirrored, no jitter
+    builtIn("regular_vcr", "Regular vCR - non-mirrored, no jitter",
+            TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 100, 100, 120,
+            PATTERN_TYPE_NAMES[0], false, false, true),
+
+    // Profile 2: Noisy vCR - Mirrored with 23.5% jitter
+    builtIn("noisy_vcr", "Noisy vCR - mirrored with 23.5% jitter",
+            TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 100, 100, 120,
+            PATTERN_TYPE_NAMES[0], true),
+
+    // Profile 3: Hybrid vCR - Non-mirrored with 23.5% jitter
+    builtIn("hybrid_vcr", "Hybrid vCR - non-mirrored with 23.5% jitter",
+            TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 100, 100, 120,
+            PATTERN_TYPE_NAMES[0], false),
+
+    // Profile 4: Custom vCR - Variable amplitude, frequency randomization
+    builtIn("custom_vcr", "Custom vCR - variable amplitude & frequency",
+            TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 70, 100, 120,
+            PATTERN_TYPE_NAMES[0], false, true),
+
+    // =========================================================================
+    // V2 ADDITIONAL PROFILES
+    // =========================================================================
+
+    // Profile 5: Gentle - lower amplitude, sequential
+    builtIn("gentle", "Gentle therapy with lower amplitude (v2)",
+            TherapyTiming::fromMs(80.0f, 87.0f, 15.0f), 30, 70, 60,
+            PATTERN_TYPE_NAMES[1], true),
+
+    // Profile 6: Quick test - 5 minute session
+    builtIn("quick_test", "Quick test session - 5 minutes (v2)",
+            TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 50, 100, 5,
+            PATTERN_TYPE_NAMES[0], true),
+};
+
+constexpr uint8_t BUILT_IN_PROFILE_COUNT =
+    sizeof(BUILT_IN_PROFILES) / sizeof(BUILT_IN_PROFILES[0]);
+
+static_assert(BUILT_IN_PROFILE_COUNT <= UINT8_MAX, "profile IDs are uint8_t");
+
+// Name list for getProfileNames(), derived from the table at compile time
+constexpr std::array<const char*, BUILT_IN_PROFILE_COUNT> BUILT_IN_PROFILE_NAMES = [] {
+    std::array<const char*, BUILT_IN_PROFILE_COUNT> names{};
+    for (uint8_t i = 0; i < BUILT_IN_PROFILE_COUNT; i++) {
+        names[i] = BUILT_IN_PROFILES[i].name;
+    }
+    return names;
+}();
+
+/**
+ * @brief Map a pattern name to its flash-resident canonical string
+ * @param value Pattern name (case-insensitive, need not be terminated
+ *              within maxLen)
+ * @param maxLen Bytes of value that may be read
+ * @return Canonical name, or nullptr if unknown
+ */
+const char* canonicalPatternType(const char* value, size_t maxLen) {
+    for (const char* canonical : PATTERN_TYPE_NAMES) {
+        size_t len = strlen(canonical);
+        if (len < maxLen && strncasecmp(value, canonical, len) == 0 && value[len] == '\0') {
+            return canonical;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
 
 // =============================================================================
 // CONSTRUCTOR
 // =============================================================================
 
 ProfileManager::ProfileManager() :
-    _profileCount(0),
     _currentProfileId(0),
     _profileLoaded(false),
     _storageAvailable(false),
+    _saveRequested(false),
+    _saveRequestMs(0),
     _deviceRole(DeviceRole::PRIMARY),
     _roleFromSettings(false),
     _therapyLedOff(false),
-    _debugMode(false)
+    _debugMode(false),
+    _i2cBusKhz(0),
+    _motorPresentMask(0)
 {
-    memset(_profileNames, 0, sizeof(_profileNames));
 }
 
 // =============================================================================
@@ -30,9 +137,6 @@ ProfileManager::ProfileManager() :
 // =============================================================================
 
 bool ProfileManager::begin(bool loadFromStorage) {
-    // Initialize built-in profiles
-    initBuiltInProfiles();
-
     // Try to mount the storage backend
     if (fsb::begin()) {
         _storageAvailable = true;
@@ -52,177 +156,33 @@ bool ProfileManager::begin(bool loadFromStorage) {
         loadProfile(1);  // Load first profile (Regular vCR)
     }
 
-    Serial.printf("[PROFILE] Initialized with %d profiles\n", _profileCount);
+    Serial.printf("[PROFILE] Initialized with %d profiles\n", BUILT_IN_PROFILE_COUNT);
     return true;
 }
 
-void ProfileManager::initBuiltInProfiles() {
-    _profileCount = 0;
-
-    // =========================================================================
-    // V1 ORIGINAL PROFILES (research-based vCR therapy)
-    // =========================================================================
-
-    // Profile 1: Regular vCR (Default) - Non-mirrored, no jitter
-    // Reference: Original v1 defaults_RegVCR.py
-    TherapyProfile& regular = _builtInProfiles[_profileCount];
-    strcpy(regular.name, "regular_vcr");
-    strcpy(regular.description, "Regular vCR - non-mirrored, no jitter");
-    regular.actuatorType = ActuatorType::LRA;
-    regular.frequencyHz = 250;
-    regular.timeOnMs = 100.0f;
-    regular.timeOffMs = 67.0f;
-    regular.jitterPercent = 0.0f;
-    regular.amplitudeMin = 100;
-    regular.amplitudeMax = 100;
-    regular.sessionDurationMin = 120;
-    strcpy(regular.patternType, "rndp");
-    regular.mirrorPattern = false;
-    regular.numFingers = MAX_ACTUATORS;
-    regular.isDefault = true;
-    regular.frequencyRandomization = false;
-    regular.frequencyMin = 210;
-    regular.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 2: Noisy vCR - Mirrored with 23.5% jitter
-    // Reference: Original v1 defaults_NoisyVCR.py
-    TherapyProfile& noisy = _builtInProfiles[_profileCount];
-    strcpy(noisy.name, "noisy_vcr");
-    strcpy(noisy.description, "Noisy vCR - mirrored with 23.5% jitter");
-    noisy.actuatorType = ActuatorType::LRA;
-    noisy.frequencyHz = 250;
-    noisy.timeOnMs = 100.0f;
-    noisy.timeOffMs = 67.0f;
-    noisy.jitterPercent = 23.5f;
-    noisy.amplitudeMin = 100;
-    noisy.amplitudeMax = 100;
-    noisy.sessionDurationMin = 120;
-    strcpy(noisy.patternType, "rndp");
-    noisy.mirrorPattern = true;
-    noisy.numFingers = MAX_ACTUATORS;
-    noisy.isDefault = false;
-    noisy.frequencyRandomization = false;
-    noisy.frequencyMin = 210;
-    noisy.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 3: Hybrid vCR - Non-mirrored with 23.5% jitter
-    // Reference: Original v1 defaults_HybridVCR.py
-    TherapyProfile& hybrid = _builtInProfiles[_profileCount];
-    strcpy(hybrid.name, "hybrid_vcr");
-    strcpy(hybrid.description, "Hybrid vCR - non-mirrored with 23.5% jitter");
-    hybrid.actuatorType = ActuatorType::LRA;
-    hybrid.frequencyHz = 250;
-    hybrid.timeOnMs = 100.0f;
-    hybrid.timeOffMs = 67.0f;
-    hybrid.jitterPercent = 23.5f;
-    hybrid.amplitudeMin = 100;
-    hybrid.amplitudeMax = 100;
-    hybrid.sessionDurationMin = 120;
-    strcpy(hybrid.patternType, "rndp");
-    hybrid.mirrorPattern = false;
-    hybrid.numFingers = MAX_ACTUATORS;
-    hybrid.isDefault = false;
-    hybrid.frequencyRandomization = false;
-    hybrid.frequencyMin = 210;
-    hybrid.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 4: Custom vCR - Non-mirrored, jitter, amplitude range, freq randomization
-    // Reference: Original v1 defaults_CustomVCR.py
-    TherapyProfile& custom = _builtInProfiles[_profileCount];
-    strcpy(custom.name, "custom_vcr");
-    strcpy(custom.description, "Custom vCR - variable amplitude & frequency");
-    custom.actuatorType = ActuatorType::LRA;
-    custom.frequencyHz = 250;
-    custom.timeOnMs = 100.0f;
-    custom.timeOffMs = 67.0f;
-    custom.jitterPercent = 23.5f;
-    custom.amplitudeMin = 70;
-    custom.amplitudeMax = 100;
-    custom.sessionDurationMin = 120;
-    strcpy(custom.patternType, "rndp");
-    custom.mirrorPattern = false;
-    custom.numFingers = MAX_ACTUATORS;
-    custom.isDefault = false;
-    custom.frequencyRandomization = true;
-    custom.frequencyMin = 210;
-    custom.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // =========================================================================
-    // V2 ADDITIONAL PROFILES (convenience/testing)
-    // =========================================================================
-
-    // Profile 5: Gentle (Lower amplitude, v2 addition)
-    TherapyProfile& gentle = _builtInProfiles[_profileCount];
-    strcpy(gentle.name, "gentle");
-    strcpy(gentle.description, "Gentle therapy with lower amplitude (v2)");
-    gentle.actuatorType = ActuatorType::LRA;
-    gentle.frequencyHz = 250;
-    gentle.timeOnMs = 80.0f;
-    gentle.timeOffMs = 87.0f;
-    gentle.jitterPercent = 15.0f;
-    gentle.amplitudeMin = 30;
-    gentle.amplitudeMax = 70;
-    gentle.sessionDurationMin = 60;
-    strcpy(gentle.patternType, "sequential");
-    gentle.mirrorPattern = true;
-    gentle.numFingers = MAX_ACTUATORS;
-    gentle.isDefault = false;
-    gentle.frequencyRandomization = false;
-    gentle.frequencyMin = 210;
-    gentle.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 6: Quick Test (Short duration, v2 addition)
-    TherapyProfile& quick = _builtInProfiles[_profileCount];
-    strcpy(quick.name, "quick_test");
-    strcpy(quick.description, "Quick test session - 5 minutes (v2)");
-    quick.actuatorType = ActuatorType::LRA;
-    quick.frequencyHz = 250;
-    quick.timeOnMs = 100.0f;
-    quick.timeOffMs = 67.0f;
-    quick.jitterPercent = 23.5f;
-    quick.amplitudeMin = 50;
-    quick.amplitudeMax = 100;
-    quick.sessionDurationMin = 5;
-    strcpy(quick.patternType, "rndp");
-    quick.mirrorPattern = true;
-    quick.numFingers = MAX_ACTUATORS;
-    quick.isDefault = false;
-    quick.frequencyRandomization = false;
-    quick.frequencyMin = 210;
-    quick.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-}
-
 // =============================================================================
 // PROFILE ACCESS
 // =============================================================================
 
-const char** ProfileManager::getProfileNames(uint8_t* count) {
+uint8_t ProfileManager::getProfileCount() const {
+    return BUILT_IN_PROFILE_COUNT;
+}
+
+const char* const* ProfileManager::getProfileNames(uint8_t* count) const {
     if (count) {
-        *count = _profileCount;
+        *count = BUILT_IN_PROFILE_COUNT;
     }
-    return _profileNames;
+    return BUILT_IN_PROFILE_NAMES.data();
 }
 
 bool ProfileManager::loadProfile(uint8_t profileId) {
-    if (profileId < 1 || profileId > _profileCount) {
+    if (profileId < 1 || profileId > BUILT_IN_PROFILE_COUNT) {
         Serial.printf("[PROFILE] Invalid profile ID: %d\n", profileId);
         return false;
     }
 
     // Copy built-in profile to current
-    _currentProfile = _builtInProfiles[profileId - 1];
+    _currentProfile = BUILT_IN_PROFILES[profileId - 1];
     _currentProfileId = profileId;
     _profileLoaded = true;
 
@@ -238,8 +198,8 @@ bool ProfileManager::loadProfileByName(const char* name) {
         return false;
     }
 
-    for (uint8_t i = 0; i < _profileCount; i++) {
-        if (strcasecmp(_builtInProfiles[i].name, name) == 0) {
+    for (uint8_t i = 0; i < BUILT_IN_PROFILE_COUNT; i++) {
+        if (strcasecmp(BUILT_IN_PROFILES[i].name, name) == 0) {
             return loadProfile(i + 1);
         }
     }
@@ -297,12 +257,12 @@ bool ProfileManager::setParameter(const char* paramName, const char* value) {
     else if (strcmp(paramUpper, "ON") == 0) {
         float onTime = static_cast<float>(atof(value));
         if (onTime < 10.0f || onTime > 1000.0f) return false;
-        _currentProfile.timeOnMs = onTime;
+        _currentProfile.timing.timeOnUs = TherapyTiming::usFromMs(onTime);
     }
     else if (strcmp(paramUpper, "OFF") == 0) {
         float offTime = static_cast<float>(atof(value));
         if (offTime < 10.0f || offTime > 1000.0f) return false;
-        _currentProfile.timeOffMs = offTime;
+        _currentProfile.timing.timeOffUs = TherapyTiming::usFromMs(offTime);
     }
     else if (strcmp(paramUpper, "SESSION") == 0) {
         int duration = atoi(value);
@@ -320,18 +280,9 @@ bool ProfileManager::setParameter(const char* paramName, const char* value) {
         _currentProfile.amplitudeMax = static_cast<uint8_t>(amp);
     }
     else if (strcmp(paramUpper, "PATTERN") == 0) {
-        if (strcasecmp(value, "rndp") == 0 ||
-            strcasecmp(value, "sequential") == 0 ||
-            strcasecmp(value, "mirrored") == 0) {
-            strncpy(_currentProfile.patternType, value, PATTERN_TYPE_MAX - 1);
-            _currentProfile.patternType[PATTERN_TYPE_MAX - 1] = '\0';
-            // Lowercase for consistency
-            for (char* c = _currentProfile.patternType; *c; c++) {
-                *c = static_cast<char>(tolower(*c));
-            }
-        } else {
-            return false;
-        }
+        const char* canonical = canonicalPatternType(value, strlen(value) + 1);
+        if (!canonical) return false;
+        _currentProfile.patternType = canonical;
     }
     else if (strcmp(paramUpper, "MIRROR") == 0) {
         int mirror = atoi(value);
@@ -340,7 +291,7 @@ bool ProfileManager::setParameter(const char* paramName, const char* value) {
     else if (strcmp(paramUpper, "JITTER") == 0) {
         float jitter = static_cast<float>(atof(value));
         if (jitter < 0.0f || jitter > 100.0f) return false;
-        _currentProfile.jitterPercent = jitter;
+        _currentProfile.timing.jitterQ16 = TherapyTiming::q16FromPercent(jitter);
     }
     else if (strcmp(paramUpper, "FINGERS") == 0) {
         int fingers = atoi(value);
@@ -357,8 +308,8 @@ bool ProfileManager::setParameter(const char* paramName, const char* value) {
 }
 
 void ProfileManager::resetToDefaults() {
-    if (_currentProfileId > 0 && _currentProfileId <= _profileCount) {
-        _currentProfile = _builtInProfiles[_currentProfileId - 1];
+    if (_currentProfileId > 0 && _currentProfileId <= BUILT_IN_PROFILE_COUNT) {
+        _currentProfile = BUILT_IN_PROFILES[_currentProfileId - 1];
         Serial.printf("[PROFILE] Reset to defaults: %s\n", _currentProfile.name);
     }
 }
@@ -367,12 +318,8 @@ void ProfileManager::resetToDefaults() {
 // SETTINGS PERSISTENCE (Binary format)
 // =============================================================================
 
-bool ProfileManager::saveSettings() {
-    if (!_storageAvailable) {
-        return false;
-    }
-
-    SettingsData data{};
+void ProfileManager::fillSettingsData(SettingsData& data) const {
+    memset(&data, 0, sizeof(data));
 
     // Header
     data.magic = SETTINGS_MAGIC;
@@ -380,8 +327,6 @@ bool ProfileManager::saveSettings() {
 
     // Device role
     data.role = (_deviceRole == DeviceRole::SECONDARY) ? 1 : 0;
-    Serial.printf("[SETTINGS] Saving role: %s (value=%d)\n",
-                  deviceRoleToString(_deviceRole), data.role);
 
     // Profile data
     data.profileId = _currentProfileId;
@@ -389,9 +334,9 @@ bool ProfileManager::saveSettings() {
     if (_profileLoaded) {
         data.actuatorType = (_currentProfile.actuatorType == ActuatorType::ERM) ? 1 : 0;
         data.frequencyHz = _currentProfile.frequencyHz;
-        data.timeOnMs = _currentProfile.timeOnMs;
-        data.timeOffMs = _currentProfile.timeOffMs;
-        data.jitterPercent = _currentProfile.jitterPercent;
+        data.timeOnUs = _currentProfile.timing.timeOnUs;
+        data.timeOffUs = _currentProfile.timing.timeOffUs;
+        data.jitterQ16 = _currentProfile.timing.jitterQ16;
         data.amplitudeMin = _currentProfile.amplitudeMin;
         data.amplitudeMax = _currentProfile.amplitudeMax;
         data.sessionDurationMin = _currentProfile.sessionDurationMin;
@@ -407,73 +352,155 @@ bool ProfileManager::saveSettings() {
     // Debug mode
     data.debugMode = _debugMode ? 1 : 0;
 
-    // Write binary data (overwrites from the start of the file)
-    if (!fsb::writeFile(SETTINGS_FILE, (const uint8_t*)&data, sizeof(data))) {
+    // Haptic bus profile
+    data.i2cBusKhz = _i2cBusKhz;
+    data.motorPresentMask = _motorPresentMask;
+}
+
+bool ProfileManager::saveSettings() {
+    if (!_storageAvailable) {
+        return false;
+    }
+
+    // Cleared first: a requestSave() racing this snapshot re-marks it
+    _saveRequested = false;
+
+    SettingsData data;
+    fillSettingsData(data);
+    Serial.printf("[SETTINGS] Saving role: %s (value=%d)\n",
+                  deviceRoleToString(_deviceRole), data.role);
+
+    // Appends only the changed fields (or compacts)
+    size_t logBefore = _settingsLog.logBytes();
+    if (!_settingsLog.save(reinterpret_cast<const uint8_t*>(&data), sizeof(data))) {
         Serial.println(F("[SETTINGS] Write failed"));
         return false;
     }
 
-    Serial.println(F("[SETTINGS] Saved"));
+    // Superseded by the log
+    if (fsb::exists(SETTINGS_FILE)) {
+        fsb::removeFile(SETTINGS_FILE);
+    }
+
+    Serial.printf("[SETTINGS] Saved (log %u -> %u bytes)\n",
+                  static_cast<unsigned>(logBefore), static_cast<unsigned>(_settingsLog.logBytes()));
     return true;
 }
 
-bool ProfileManager::loadSettings() {
-    if (!_storageAvailable) {
+void ProfileManager::requestSave() {
+    _saveRequestMs = millis();
+    _saveRequested = true;
+}
+
+bool ProfileManager::saveIfDue() {
+    if (!_saveRequested || millis() - _saveRequestMs < SETTINGS_SAVE_DEBOUNCE_MS) {
         return false;
     }
+    saveSettings();
+    return true;
+}
 
-    if (!fsb::exists(SETTINGS_FILE)) {
-        Serial.println(F("[SETTINGS] No settings file found"));
+bool ProfileManager::eraseSettings() {
+    _saveRequested = false;
+    bool removedLog = _settingsLog.erase();
+    bool removedLegacy = fsb::removeFile(SETTINGS_FILE);
+    return removedLog || removedLegacy;
+}
+
+bool ProfileManager::loadSettings() {
+    if (!_storageAvailable) {
         return false;
     }
 
     SettingsData data;
-    size_t bytesRead = 0;
-    if (!fsb::readFile(SETTINGS_FILE, (uint8_t*)&data, sizeof(data), bytesRead)) {
-        Serial.println(F("[SETTINGS] Failed to open file"));
-        return false;
+    if (_settingsLog.load(reinterpret_cast<uint8_t*>(&data), sizeof(data), SETTINGS_DATA_MIN_SIZE)) {
+        Serial.printf("[SETTINGS] Log generation %lu, %u bytes\n",
+                      static_cast<unsigned long>(_settingsLog.generation()),
+                      static_cast<unsigned>(_settingsLog.logBytes()));
+    } else {
+        // Legacy whole-struct file (migrated by the next save)
+        if (!fsb::exists(SETTINGS_FILE)) {
+            Serial.println(F("[SETTINGS] No settings file found"));
+            return false;
+        }
+
+        size_t bytesRead = 0;
+        memset(&data, 0, sizeof(data));  // Fields the file predates read as zero
+        if (!fsb::readFile(SETTINGS_FILE, (uint8_t*)&data, sizeof(data), bytesRead)) {
+            Serial.println(F("[SETTINGS] Failed to open file"));
+            return false;
+        }
+
+        if (bytesRead < SETTINGS_DATA_MIN_SIZE) {
+            Serial.println(F("[SETTINGS] Invalid file format"));
+            return false;
+        }
     }
 
-    if (bytesRead != sizeof(data) || data.magic != SETTINGS_MAGIC) {
+    if (data.magic != SETTINGS_MAGIC) {
         Serial.println(F("[SETTINGS] Invalid file format"));
         return false;
     }
 
+    applySettingsData(data);
+    return true;
+}
+
+// Settings written before version 2 hold float ms / ms / percent in the
+// timing fields (same offsets and widths)
+static TherapyTiming settingsTiming(const SettingsData& data) {
+    if (data.version >= 2) {
+        return TherapyTiming(data.timeOnUs, data.timeOffUs, data.jitterQ16);
+    }
+    float timeOnMs, timeOffMs, jitterPercent;
+    memcpy(&timeOnMs, &data.timeOnUs, sizeof(timeOnMs));
+    memcpy(&timeOffMs, &data.timeOffUs, sizeof(timeOffMs));
+    memcpy(&jitterPercent, &data.jitterQ16, sizeof(jitterPercent));
+    return TherapyTiming::fromMs(timeOnMs, timeOffMs, jitterPercent);
+}
+
+void ProfileManager::applySettingsData(const SettingsData& data) {
     // Load device role
     _deviceRole = (data.role == 1) ? DeviceRole::SECONDARY : DeviceRole::PRIMARY;
     _roleFromSettings = true;
     Serial.printf("[SETTINGS] Role: %s\n", deviceRoleToString(_deviceRole));
 
     // Load profile
-    if (data.profileId > 0 && data.profileId <= _profileCount) {
-        _currentProfile = _builtInProfiles[data.profileId - 1];
+    if (data.profileId > 0 && data.profileId <= BUILT_IN_PROFILE_COUNT) {
+        _currentProfile = BUILT_IN_PROFILES[data.profileId - 1];
         _currentProfileId = data.profileId;
 
         // Apply saved customizations
         _currentProfile.actuatorType = (data.actuatorType == 1) ? ActuatorType::ERM : ActuatorType::LRA;
         _currentProfile.frequencyHz = data.frequencyHz;
 
+        TherapyTiming saved = settingsTiming(data);
+
         // Validate timing values - reject if outside v1 reasonable range (10-500ms)
         // This protects against corrupted settings from old firmware versions
-        if (data.timeOnMs >= 10.0f && data.timeOnMs <= 500.0f) {
-            _currentProfile.timeOnMs = data.timeOnMs;
+        if (saved.timeOnUs >= 10000 && saved.timeOnUs <= 500000) {
+            _currentProfile.timing.timeOnUs = saved.timeOnUs;
         } else {
-            Serial.printf("[SETTINGS] WARNING: Invalid timeOnMs %.1f, keeping default %.1f\n",
-                          data.timeOnMs, _currentProfile.timeOnMs);
+            Serial.printf("[SETTINGS] WARNING: Invalid timeOnUs %lu, keeping default %lu\n",
+                          (unsigned long)saved.timeOnUs, (unsigned long)_currentProfile.timing.timeOnUs);
         }
-        if (data.timeOffMs >= 10.0f && data.timeOffMs <= 500.0f) {
-            _currentProfile.timeOffMs = data.timeOffMs;
+        if (saved.timeOffUs >= 10000 && saved.timeOffUs <= 500000) {
+            _currentProfile.timing.timeOffUs = saved.timeOffUs;
         } else {
-            Serial.printf("[SETTINGS] WARNING: Invalid timeOffMs %.1f, keeping default %.1f\n",
-                          data.timeOffMs, _currentProfile.timeOffMs);
+            Serial.printf("[SETTINGS] WARNING: Invalid timeOffUs %lu, keeping default %lu\n",
+                          (unsigned long)saved.timeOffUs, (unsigned long)_currentProfile.timing.timeOffUs);
+        }
+        if (saved.jitterQ16 <= TherapyTiming::Q16_ONE) {
+            _currentProfile.timing.jitterQ16 = saved.jitterQ16;
         }
 
-        _currentProfile.jitterPercent = data.jitterPercent;
         _currentProfile.amplitudeMin = data.amplitudeMin;
         _currentProfile.amplitudeMax = data.amplitudeMax;
         _currentProfile.sessionDurationMin = data.sessionDurationMin;
-        strncpy(_currentProfile.patternType, data.patternType, PATTERN_TYPE_MAX - 1);
-        _currentProfile.patternType[PATTERN_TYPE_MAX - 1] = '\0';
+        // Unknown (or unterminated) pattern names keep the profile's default
+        if (const char* pattern = canonicalPatternType(data.patternType, sizeof(data.patternType))) {
+            _currentProfile.patternType = pattern;
+        }
         _currentProfile.mirrorPattern = (data.mirrorPattern != 0);
         _currentProfile.numFingers = data.numFingers;
 
@@ -481,7 +508,8 @@ bool ProfileManager::loadSettings() {
 
         // Log loaded timing for debugging
         Serial.printf("[SETTINGS] Timing: ON=%.1fms, OFF=%.1fms, Jitter=%.1f%%\n",
-                      _currentProfile.timeOnMs, _currentProfile.timeOffMs, _currentProfile.jitterPercent);
+                      _currentProfile.timing.timeOnMs(), _currentProfile.timing.timeOffMs(),
+                      _currentProfile.timing.jitterPercent());
     }
 
     // Load therapy LED control setting
@@ -492,6 +520,12 @@ bool ProfileManager::loadSettings() {
     _debugMode = (data.debugMode != 0);
     Serial.printf("[SETTINGS] Debug Mode: %s\n", _debugMode ? "true" : "false");
 
+    // Load haptic bus profile (0 in files written before it was recorded)
+    _i2cBusKhz = data.i2cBusKhz;
+    if (_i2cBusKhz != 0) {
+        Serial.printf("[SETTINGS] I2C Bus: %u kHz\n", _i2cBusKhz);
+    }
+    _motorPresentMask = data.motorPresentMask;
+
     Serial.printf("[SETTINGS] Loaded profile: %s\n", _currentProfile.name);
-    return true;
 }
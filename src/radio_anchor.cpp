@@ -120,10 +120,49 @@ bool radioAnchorFindAfter(uint64_t timeUs, uint64_t maxAheadUs, uint64_t& anchor
     return findAnchor(false, timeUs, maxAheadUs, anchorOut);
 }
 
+bool radioAnchorPredictNext(uint64_t timeUs, uint32_t periodUs, uint64_t& nextOut) {
+    nextOut = 0;
+    if (!s_active || periodUs == 0) {
+        return false;
+    }
+
+    // Ring is in insertion order: the two entries behind the head are newest
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t head = s_anchorHead;
+    uint64_t newest = s_anchors[(head + SYNC_ANCHOR_RING_SIZE - 1) % SYNC_ANCHOR_RING_SIZE];
+    uint64_t previous = s_anchors[(head + SYNC_ANCHOR_RING_SIZE - 2) % SYNC_ANCHOR_RING_SIZE];
+    __set_PRIMASK(primask);
+
+    if (newest == 0 || previous == 0 || newest <= previous || newest > timeUs) {
+        return false;
+    }
+
+    // Skipped events (slave latency, a dropped notification) are whole periods
+    uint64_t gap = newest - previous;
+    uint64_t periods = (gap + periodUs / 2) / periodUs;
+    if (periods < 1 || periods > 4) {
+        return false;
+    }
+    int64_t error = static_cast<int64_t>(gap) - static_cast<int64_t>(periods * periodUs);
+    if (error > SYNC_ANCHOR_PREDICT_TOLERANCE_US || error < -SYNC_ANCHOR_PREDICT_TOLERANCE_US) {
+        return false;
+    }
+
+    // Stale phase: clock drift between the link's sleep clocks adds up
+    uint64_t age = timeUs - newest;
+    if (age > 4ULL * periodUs) {
+        return false;
+    }
+    nextOut = newest + (age / periodUs + 1) * periodUs;
+    return true;
+}
+
 #else  // Native stubs
 
 bool radioAnchorBegin() { return false; }
 bool radioAnchorFindBefore(uint64_t, uint64_t, uint64_t& anchorOut) { anchorOut = 0; return false; }
 bool radioAnchorFindAfter(uint64_t, uint64_t, uint64_t& anchorOut) { anchorOut = 0; return false; }
+bool radioAnchorPredictNext(uint64_t, uint32_t, uint64_t& nextOut) { nextOut = 0; return false; }
 
 #endif
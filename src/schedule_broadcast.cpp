@@ -0,0 +1,171 @@
+/**
+ * @file schedule_broadcast.cpp
+ * @brief Macrocycle schedule over a BLE periodic advertising train - Implementation
+ */
+
+#include "schedule_broadcast.h"
+#include "sync_protocol.h"
+#include <string.h>
+
+// =============================================================================
+// PAYLOAD CODEC
+// =============================================================================
+
+static void putLE(uint8_t* out, uint64_t value, uint8_t bytes) {
+    for (uint8_t i = 0; i < bytes; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint64_t getLE(const uint8_t* in, uint8_t bytes) {
+    uint64_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+size_t ScheduleBroadcast::encode(uint8_t* out, size_t outSize, const ScheduleTrain& train,
+                                 const Macrocycle& macrocycle) {
+    if (!out) {
+        return 0;
+    }
+
+    // Each listener applies its own offset: none goes on air
+    Macrocycle mc = macrocycle;
+    mc.clockOffset = 0;
+    char frame[MESSAGE_BUFFER_SIZE];
+    if (!SyncCommand::serializeMacrocycle(frame, sizeof(frame), mc, MACROCYCLE_WIRE_V6)) {
+        return 0;
+    }
+    size_t frameLen = strlen(frame);
+    size_t total = HEADER_SIZE + frameLen;
+    if (total > outSize || total > SYNC_PERIODIC_ADV_MAX_DATA) {
+        return 0;
+    }
+
+    out[0] = static_cast<uint8_t>(total - 1);  // AD length excludes itself
+    out[1] = 0xFF;                              // Manufacturer specific data
+    putLE(&out[2], COMPANY_ID, 2);
+    out[4] = 'B';
+    out[5] = 'Z';
+    out[6] = VERSION;
+    putLE(&out[7], train.startUs, 8);
+    putLE(&out[15], train.intervalUs, 4);
+    memcpy(&out[HEADER_SIZE], frame, frameLen);
+    return total;
+}
+
+bool ScheduleBroadcast::decode(const uint8_t* data, size_t length, ScheduleTrain& train,
+                               Macrocycle& macrocycle) {
+    if (!data || length <= HEADER_SIZE || data[0] + 1U != length || data[1] != 0xFF ||
+        getLE(&data[2], 2) != COMPANY_ID || data[4] != 'B' || data[5] != 'Z' ||
+        data[6] != VERSION) {
+        return false;
+    }
+
+    train.startUs = getLE(&data[7], 8);
+    train.intervalUs = static_cast<uint32_t>(getLE(&data[15], 4));
+    // Only V6 frames travel here; the V5 text parser expects a C string
+    if (train.intervalUs == 0 || length < HEADER_SIZE + 4 ||
+        data[HEADER_SIZE + 3] != MACROCYCLE_WIRE_V6) {
+        return false;
+    }
+    return SyncCommand::deserializeMacrocycle(reinterpret_cast<const char*>(&data[HEADER_SIZE]),
+                                              length - HEADER_SIZE, macrocycle);
+}
+
+// =============================================================================
+// ANCHOR TRACKING
+// =============================================================================
+
+ScheduleAnchorTracker::ScheduleAnchorTracker() {
+    reset();
+}
+
+void ScheduleAnchorTracker::reset() {
+    memset(_phases, 0, sizeof(_phases));
+    _count = 0;
+    _next = 0;
+    _train = {};
+    _refPhaseUs = 0;
+    _ptpOffsetUs = 0;
+    _ptpValid = false;
+    _biasUs = 0;
+    _biasSamples = 0;
+}
+
+bool ScheduleAnchorTracker::onReport(const ScheduleTrain& train, uint64_t rxLocalUs) {
+    if (!_ptpValid || train.intervalUs == 0) {
+        return false;
+    }
+
+    // A restarted train has a new start latency: calibrate from scratch
+    if (train.startUs != _train.startUs || train.intervalUs != _train.intervalUs) {
+        _train = train;
+        _count = 0;
+        _next = 0;
+        _biasSamples = 0;
+    }
+
+    // Event number: the PTP offset places the report to well within half an
+    // interval, counted around the first report's phase so every report of
+    // this train is numbered consistently, wherever the start latency fell
+    int64_t interval = static_cast<int64_t>(train.intervalUs);
+    int64_t sinceStart = static_cast<int64_t>(rxLocalUs - train.startUs) - _ptpOffsetUs;
+    if (sinceStart < 0) {
+        return false;
+    }
+    if (_count == 0) {
+        _refPhaseUs = sinceStart % interval;
+    }
+    int64_t shifted = sinceStart - _refPhaseUs + interval / 2;
+    if (shifted < 0) {
+        return false;
+    }
+    uint64_t nominalUs = train.startUs + static_cast<uint64_t>(shifted / interval) * train.intervalUs;
+
+    _phases[_next] = static_cast<int64_t>(rxLocalUs - nominalUs);
+    _next = static_cast<uint8_t>((_next + 1) % WINDOW);
+    if (_count < WINDOW) {
+        _count++;
+    }
+    return true;
+}
+
+void ScheduleAnchorTracker::onPtpOffset(int64_t ptpOffsetUs) {
+    _ptpOffsetUs = ptpOffsetUs;
+    _ptpValid = true;
+    if (_count < WINDOW) {
+        return;  // Phase not settled yet
+    }
+
+    int64_t bias = windowMin() - ptpOffsetUs;
+    if (_biasSamples == 0) {
+        _biasUs = bias;
+    } else {
+        _biasUs += (bias - _biasUs) / SYNC_PERIODIC_ADV_BIAS_EMA_DIV;
+    }
+    if (_biasSamples < UINT8_MAX) {
+        _biasSamples++;
+    }
+}
+
+bool ScheduleAnchorTracker::isLocked() const {
+    return _count >= WINDOW && _biasSamples >= SYNC_PERIODIC_ADV_MIN_BIAS_SAMPLES;
+}
+
+int64_t ScheduleAnchorTracker::getOffset() const {
+    return windowMin() - _biasUs;
+}
+
+int64_t ScheduleAnchorTracker::windowMin() const {
+    // Report latency only adds delay: the earliest phase is the least delayed
+    int64_t best = _phases[0];
+    for (uint8_t i = 1; i < _count; i++) {
+        if (_phases[i] < best) {
+            best = _phases[i];
+        }
+    }
+    return best;
+}
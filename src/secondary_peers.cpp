@@ -0,0 +1,207 @@
+/**
+ * @file secondary_peers.cpp
+ * @brief PRIMARY-side state for SECONDARY peers beyond the first - Implementation
+ */
+
+#include "secondary_peers.h"
+#include "platform.h"
+#include <string.h>
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+#if BLE_MAX_SECONDARIES > 1
+SecondaryPeerSet extraPeers;
+#endif
+
+// =============================================================================
+// PEER TABLE
+// =============================================================================
+
+SecondaryPeerSet::SecondaryPeerSet() :
+    _count(0)
+{
+    clear();
+}
+
+SecondaryPeer* SecondaryPeerSet::add(uint16_t connHandle, uint32_t nowMs) {
+    SecondaryPeer* peer = find(connHandle);
+    if (!peer) {
+        if (_count >= CAPACITY) {
+            return nullptr;
+        }
+        peer = &_peers[_count++];
+    }
+
+    peer->connHandle = connHandle;
+    peer->sync.reset();
+    peer->sync.resetLatency();
+    peer->sync.resetClockSync();
+    {
+        PLATFORM_CRITICAL_ENTER();
+        peer->pingT1 = 0;
+        peer->pingSeq = 0;
+        PLATFORM_CRITICAL_EXIT();
+    }
+    peer->lastPongMs = nowMs;
+    peer->mcWireVersion = MACROCYCLE_WIRE_V5;  // Until the peer sends MC_VER
+    peer->retiring = false;
+    return peer;
+}
+
+bool SecondaryPeerSet::remove(uint16_t connHandle) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_peers[i].connHandle != connHandle) {
+            continue;
+        }
+        // Keep the table dense: the last peer takes the freed slot
+        PLATFORM_CRITICAL_ENTER();
+        _count--;
+        if (i != _count) {
+            _peers[i].connHandle = _peers[_count].connHandle;
+            _peers[i].sync = _peers[_count].sync;
+            _peers[i].pingT1 = _peers[_count].pingT1;
+            _peers[i].pingSeq = _peers[_count].pingSeq;
+            _peers[i].lastPongMs = _peers[_count].lastPongMs;
+            _peers[i].mcWireVersion = _peers[_count].mcWireVersion;
+            _peers[i].retiring = _peers[_count].retiring;
+        }
+        _peers[_count].connHandle = HANDLE_NONE;
+        _peers[_count].pingT1 = 0;
+        PLATFORM_CRITICAL_EXIT();
+        return true;
+    }
+    return false;
+}
+
+SecondaryPeer* SecondaryPeerSet::find(uint16_t connHandle) {
+    if (connHandle == HANDLE_NONE) {
+        return nullptr;
+    }
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_peers[i].connHandle == connHandle) {
+            return &_peers[i];
+        }
+    }
+    return nullptr;
+}
+
+void SecondaryPeerSet::clear() {
+    _count = 0;
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        _peers[i].connHandle = HANDLE_NONE;
+        _peers[i].pingT1 = 0;
+        _peers[i].pingSeq = 0;
+        _peers[i].lastPongMs = 0;
+        _peers[i].mcWireVersion = MACROCYCLE_WIRE_V5;
+        _peers[i].retiring = false;
+    }
+}
+
+void SecondaryPeerSet::retireAll() {
+    PLATFORM_CRITICAL_ENTER();
+    for (uint8_t i = 0; i < _count; i++) {
+        _peers[i].retiring = true;
+        _peers[i].pingT1 = 0;
+    }
+    PLATFORM_CRITICAL_EXIT();
+}
+
+// =============================================================================
+// PING/PONG
+// =============================================================================
+
+void SecondaryPeerSet::beginPing(SecondaryPeer& peer, uint32_t seqId) {
+    // The TX stamp may land before the caller's next statement (ESP32-S3
+    // drains on the other core), so the sequence is armed first
+    PLATFORM_CRITICAL_ENTER();
+    peer.pingT1 = 0;
+    peer.pingSeq = seqId;
+    PLATFORM_CRITICAL_EXIT();
+}
+
+bool SecondaryPeerSet::onPingStamped(uint32_t seqId, uint64_t txTimeUs) {
+    for (uint8_t i = 0; i < _count; i++) {
+        SecondaryPeer& peer = _peers[i];
+        if (peer.pingSeq != seqId) {
+            continue;
+        }
+        // T1 and seq are read together by onPong(): publish as one unit
+        PLATFORM_CRITICAL_ENTER();
+        peer.pingT1 = txTimeUs;
+        PLATFORM_CRITICAL_EXIT();
+        return true;
+    }
+    return false;
+}
+
+bool SecondaryPeerSet::onPong(SecondaryPeer& peer, uint32_t seqId, uint64_t t2, uint64_t t3,
+                              uint64_t t4, uint32_t nowMs) {
+    peer.lastPongMs = nowMs;
+    if (peer.retiring) {
+        return false;
+    }
+
+    uint64_t t1;
+    uint32_t expectedSeq;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        t1 = peer.pingT1;
+        expectedSeq = peer.pingSeq;
+        PLATFORM_CRITICAL_EXIT();
+    }
+    if (t1 == 0 || seqId != expectedSeq) {
+        return false;  // Late PONG from an earlier exchange
+    }
+
+    uint32_t processingTime = (t3 >= t2) ? static_cast<uint32_t>(t3 - t2) : 0;
+    uint32_t rtt = static_cast<uint32_t>(t4 - t1) - processingTime;
+
+    int64_t offset = peer.sync.calculatePTPOffset(t1, t2, t3, t4);
+    bool accepted = peer.sync.updateOffsetEMAWithQuality(offset, rtt);
+    peer.sync.updateLatency(rtt);
+
+    {
+        PLATFORM_CRITICAL_ENTER();
+        peer.pingT1 = 0;
+        PLATFORM_CRITICAL_EXIT();
+    }
+    return accepted;
+}
+
+uint32_t SecondaryPeerSet::maxLeadTimeUs(uint32_t floorUs) const {
+    uint32_t lead = floorUs;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_peers[i].retiring || !_peers[i].sync.isClockSyncValid()) {
+            continue;  // Not sent macrocycles
+        }
+        uint32_t peerLead = _peers[i].sync.calculateAdaptiveLeadTime();
+        if (peerLead > lead) {
+            lead = peerLead;
+        }
+    }
+    return lead;
+}
+
+// =============================================================================
+// MACROCYCLE FAN-OUT
+// =============================================================================
+
+bool MacrocycleFanoutFrame::prepare(const Macrocycle& macrocycle) {
+    _length = 0;
+    if (!SyncCommand::serializeMacrocycleFanout(_frame, sizeof(_frame), macrocycle,
+                                                _offsetPos, _offsetLen)) {
+        return false;
+    }
+    _length = strlen(_frame);
+    return true;
+}
+
+size_t MacrocycleFanoutFrame::patch(int64_t clockOffset, char* out, size_t outSize) const {
+    if (_length == 0) {
+        return 0;
+    }
+    return SyncCommand::patchMacrocycleOffset(_frame, _length, _offsetPos, _offsetLen,
+                                              clockOffset, out, outSize);
+}
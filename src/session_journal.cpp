@@ -0,0 +1,296 @@
+/**
+ * @file session_journal.cpp
+ * @brief On-device binary session record - Implementation
+ */
+
+#include "session_journal.h"
+#include "fs_backend.h"
+#include "platform.h"
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+
+static constexpr uint32_t JOURNAL_RING_PAGES =
+    static_cast<uint32_t>(SESSION_JOURNAL_SEGMENTS) * SESSION_JOURNAL_SEGMENT_PAGES;
+static constexpr uint32_t JOURNAL_CHUNKS_PER_PAGE =
+    SESSION_JOURNAL_PAGE_BYTES / SESSION_JOURNAL_CHUNK_BYTES;
+
+static_assert(SESSION_JOURNAL_SEGMENTS >= 2,
+              "The ring needs a segment to hold while the oldest is rewritten");
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+#if SESSION_JOURNAL_ENABLED
+SessionJournal sessionJournal;
+#endif
+
+SessionJournal::SessionJournal() :
+    _activePage(0),
+    _pendingPage(-1),
+    _fill(0),
+    _recording(false),
+    _sealRequested(false),
+    _storageReady(false),
+    _nextSequence(0),
+    _firstSequence(0),
+    _sessionId(0),
+    _dropped(0),
+    _writeErrors(0)
+{
+    memset(_pages, 0, sizeof(_pages));
+}
+
+void SessionJournal::segmentPath(uint32_t sequence, char* out, size_t size) {
+    uint32_t segment = (sequence / SESSION_JOURNAL_SEGMENT_PAGES) % SESSION_JOURNAL_SEGMENTS;
+    snprintf(out, size, "/jrnl%02lu.bin", static_cast<unsigned long>(segment));
+}
+
+// =============================================================================
+// RECOVERY
+// =============================================================================
+
+bool SessionJournal::begin() {
+    _storageReady = fsb::begin();
+    if (!_storageReady) {
+        return false;
+    }
+
+    // Newest and oldest page sequence across every segment
+    bool found = false;
+    uint32_t newest = 0;
+    uint32_t oldest = 0;
+    uint32_t newestSession = 0;
+    for (uint32_t segment = 0; segment < SESSION_JOURNAL_SEGMENTS; segment++) {
+        char path[16];
+        segmentPath(segment * SESSION_JOURNAL_SEGMENT_PAGES, path, sizeof(path));
+        for (uint32_t page = 0; page < SESSION_JOURNAL_SEGMENT_PAGES; page++) {
+            JournalPageHeader header;
+            size_t len = 0;
+            if (!fsb::readAt(path, page * SESSION_JOURNAL_PAGE_BYTES,
+                             reinterpret_cast<uint8_t*>(&header), sizeof(header), len) ||
+                len != sizeof(header) || header.magic != SESSION_JOURNAL_MAGIC ||
+                header.version != SESSION_JOURNAL_VERSION) {
+                break;
+            }
+            if (!found || static_cast<int32_t>(header.sequence - newest) > 0) {
+                newest = header.sequence;
+            }
+            if (!found || static_cast<int32_t>(header.sequence - oldest) < 0) {
+                oldest = header.sequence;
+            }
+            if (header.sessionId > newestSession) {
+                newestSession = header.sessionId;
+            }
+            found = true;
+        }
+    }
+
+    if (found) {
+        _nextSequence = newest + 1;
+        _firstSequence = oldest;
+        _sessionId = newestSession;
+
+        // Appending continues the newest segment only if it ends exactly
+        // after the newest page (a torn write leaves it longer or shorter)
+        if (_nextSequence % SESSION_JOURNAL_SEGMENT_PAGES != 0) {
+            char path[16];
+            segmentPath(_nextSequence, path, sizeof(path));
+            size_t end = (_nextSequence % SESSION_JOURNAL_SEGMENT_PAGES) * SESSION_JOURNAL_PAGE_BYTES;
+            uint8_t probe;
+            size_t lastLen = 0;
+            size_t pastLen = 0;
+            fsb::readAt(path, end - 1, &probe, 1, lastLen);
+            fsb::readAt(path, end, &probe, 1, pastLen);
+            if (lastLen != 1 || pastLen != 0) {
+                _nextSequence += SESSION_JOURNAL_SEGMENT_PAGES -
+                                 _nextSequence % SESSION_JOURNAL_SEGMENT_PAGES;
+            }
+        }
+    }
+
+    Serial.printf("[JOURNAL] %lu pages on flash, next sequence %lu\n",
+                  static_cast<unsigned long>(found ? _nextSequence - _firstSequence : 0),
+                  static_cast<unsigned long>(_nextSequence));
+    return true;
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+void SessionJournal::startSession(uint8_t profileId, uint32_t durationSec) {
+    uint32_t sessionId;
+    {
+        PLATFORM_CRITICAL_ENTER();
+        _sessionId++;
+        sessionId = _sessionId;
+        if (_fill == 0) {
+            _pages[_activePage].header.sessionId = sessionId;
+        }
+        _recording = true;
+        PLATFORM_CRITICAL_EXIT();
+    }
+    record(JournalRecordType::SESSION_START, profileId, 0,
+           static_cast<int32_t>(durationSec), static_cast<int32_t>(sessionId));
+}
+
+void SessionJournal::endSession(uint32_t cyclesCompleted, uint32_t totalActivations) {
+    if (!_recording) {
+        return;
+    }
+    record(JournalRecordType::SESSION_END, 0, 0,
+           static_cast<int32_t>(cyclesCompleted), static_cast<int32_t>(totalActivations));
+    _recording = false;
+    _sealRequested = true;
+}
+
+void SessionJournal::sealActivePage() {
+    // Caller holds the critical section
+    _pages[_activePage].header.count = _fill;
+    _pendingPage = static_cast<int8_t>(_activePage);
+    _activePage ^= 1;
+    memset(&_pages[_activePage], 0, sizeof(JournalPage));
+    _pages[_activePage].header.sessionId = _sessionId;
+    _fill = 0;
+}
+
+void SessionJournal::record(JournalRecordType type, uint8_t arg, uint16_t aux, int32_t a, int32_t b) {
+    if (!_recording) {
+        return;
+    }
+
+    JournalRecord rec;
+    rec.type = static_cast<uint8_t>(type);
+    rec.arg = arg;
+    rec.aux = aux;
+    rec.timeMs = millis();
+    rec.a = a;
+    rec.b = b;
+
+    PLATFORM_CRITICAL_ENTER();
+    bool stored = true;
+    if (_fill >= SESSION_JOURNAL_RECORDS_PER_PAGE) {
+        if (_pendingPage < 0) {
+            sealActivePage();
+        } else {
+            stored = false;  // Previous page not on flash yet
+        }
+    }
+    if (stored) {
+        _pages[_activePage].records[_fill] = rec;
+        _fill = _fill + 1;
+    } else {
+        _dropped++;
+    }
+    PLATFORM_CRITICAL_EXIT();
+}
+
+// =============================================================================
+// FLASH
+// =============================================================================
+
+bool SessionJournal::flushPending() {
+    if (_pendingPage < 0 && _sealRequested) {
+        PLATFORM_CRITICAL_ENTER();
+        if (_pendingPage < 0) {
+            if (_fill > 0) {
+                sealActivePage();
+            }
+            _sealRequested = false;
+        }
+        PLATFORM_CRITICAL_EXIT();
+    }
+
+    int8_t pending = _pendingPage;
+    if (pending < 0) {
+        return false;
+    }
+
+    // Producers only touch the active page; the pending one is ours until
+    // it is released below
+    bool written = writePage(_pages[pending]);
+    {
+        PLATFORM_CRITICAL_ENTER();
+        _pendingPage = -1;
+        PLATFORM_CRITICAL_EXIT();
+    }
+    return written;
+}
+
+bool SessionJournal::writePage(JournalPage& page) {
+    if (!_storageReady) {
+        return false;
+    }
+
+    uint32_t sequence = _nextSequence;
+    page.header.magic = SESSION_JOURNAL_MAGIC;
+    page.header.version = SESSION_JOURNAL_VERSION;
+    page.header.recordSize = sizeof(JournalRecord);
+    page.header.sequence = sequence;
+    page.header.dropped = _dropped;
+
+    char path[16];
+    segmentPath(sequence, path, sizeof(path));
+    if (sequence % SESSION_JOURNAL_SEGMENT_PAGES == 0) {
+        // Entering a segment: the ring has wrapped onto (or never wrote) it
+        fsb::removeFile(path);
+        uint32_t kept = (SESSION_JOURNAL_SEGMENTS - 1) * SESSION_JOURNAL_SEGMENT_PAGES;
+        if (sequence >= kept && static_cast<int32_t>(sequence - kept - _firstSequence) > 0) {
+            _firstSequence = sequence - kept;
+        }
+    }
+
+    if (!fsb::appendFile(path, reinterpret_cast<const uint8_t*>(&page), sizeof(page))) {
+        // The segment's tail is unknown now: restart at the next segment
+        _writeErrors++;
+        _nextSequence = sequence + SESSION_JOURNAL_SEGMENT_PAGES -
+                        sequence % SESSION_JOURNAL_SEGMENT_PAGES;
+        Serial.printf("[JOURNAL] WARNING: page %lu write failed\n", static_cast<unsigned long>(sequence));
+        return false;
+    }
+    _nextSequence = sequence + 1;
+    if (_nextSequence - _firstSequence > JOURNAL_RING_PAGES) {
+        _firstSequence = _nextSequence - JOURNAL_RING_PAGES;
+    }
+    return true;
+}
+
+// =============================================================================
+// DOWNLOAD
+// =============================================================================
+
+uint32_t SessionJournal::chunkCount() const {
+    return (_nextSequence - _firstSequence) * JOURNAL_CHUNKS_PER_PAGE;
+}
+
+bool SessionJournal::readPageHeader(uint32_t sequence, JournalPageHeader& header) const {
+    char path[16];
+    segmentPath(sequence, path, sizeof(path));
+    size_t len = 0;
+    size_t offset = (sequence % SESSION_JOURNAL_SEGMENT_PAGES) * SESSION_JOURNAL_PAGE_BYTES;
+    return fsb::readAt(path, offset, reinterpret_cast<uint8_t*>(&header), sizeof(header), len) &&
+           len == sizeof(header) && header.magic == SESSION_JOURNAL_MAGIC &&
+           header.sequence == sequence;
+}
+
+bool SessionJournal::readChunk(uint32_t index, uint8_t* out, size_t& length) const {
+    length = 0;
+    if (!_storageReady || out == nullptr || index >= chunkCount()) {
+        return false;
+    }
+
+    uint32_t sequence = _firstSequence + index / JOURNAL_CHUNKS_PER_PAGE;
+    JournalPageHeader header;
+    if (!readPageHeader(sequence, header)) {
+        return false;  // Lost to a failed write
+    }
+
+    char path[16];
+    segmentPath(sequence, path, sizeof(path));
+    size_t offset = (sequence % SESSION_JOURNAL_SEGMENT_PAGES) * SESSION_JOURNAL_PAGE_BYTES +
+                    (index % JOURNAL_CHUNKS_PER_PAGE) * SESSION_JOURNAL_CHUNK_BYTES;
+    return fsb::readAt(path, offset, out, SESSION_JOURNAL_CHUNK_BYTES, length) &&
+           length == SESSION_JOURNAL_CHUNK_BYTES;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file settings_log.cpp
+ * @brief Append-only settings store - Implementation
+ */
+
+#include "settings_log.h"
+#include "fs_backend.h"
+#include <string.h>
+
+static const char* const LOG_FILES[2] = {SETTINGS_LOG_FILE_A, SETTINGS_LOG_FILE_B};
+
+static_assert(SETTINGS_LOG_MAX_BYTES >= sizeof(SettingsLogHeader) +
+                  SETTINGS_LOG_MAX_IMAGE + SETTINGS_LOG_RECORD_OVERHEAD,
+              "SETTINGS_LOG_MAX_BYTES must hold at least a compacted image");
+
+SettingsLog::SettingsLog() :
+    _size(0),
+    _hasImage(false),
+    _needsCompaction(false),
+    _active(0),
+    _generation(0),
+    _logBytes(0)
+{
+    memset(_persisted, 0, sizeof(_persisted));
+}
+
+uint8_t SettingsLog::crc8(const uint8_t* data, size_t length) {
+    // CRC-8/SMBUS (poly 0x07): catches the torn or erased tail of an append
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t SettingsLog::putRecord(uint8_t* out, uint8_t offset, const uint8_t* bytes, uint8_t length) {
+    out[0] = offset;
+    out[1] = length;
+    memcpy(out + 2, bytes, length);
+    out[2 + length] = crc8(out, 2 + length);
+    return SETTINGS_LOG_RECORD_OVERHEAD + length;
+}
+
+// =============================================================================
+// LOAD
+// =============================================================================
+
+bool SettingsLog::replay(const char* path, size_t size, size_t minSize, uint8_t* image,
+                         uint32_t& generation, size_t& length, size_t& imageSize, bool& torn) const {
+    uint8_t buf[SETTINGS_LOG_MAX_BYTES];
+    size_t bytesRead = 0;
+    if (!fsb::exists(path) || !fsb::readFile(path, buf, sizeof(buf), bytesRead) ||
+        bytesRead < sizeof(SettingsLogHeader)) {
+        return false;
+    }
+
+    SettingsLogHeader header;
+    memcpy(&header, buf, sizeof(header));
+    if (header.magic != SETTINGS_LOG_MAGIC || header.version != SETTINGS_LOG_VERSION ||
+        header.imageSize < minSize || header.imageSize > size) {
+        return false;
+    }
+    size_t stored = header.imageSize;
+
+    size_t pos = sizeof(header);
+    bool first = true;
+    torn = false;
+    while (pos < bytesRead) {
+        if (bytesRead - pos < SETTINGS_LOG_RECORD_OVERHEAD) {
+            torn = true;
+            break;
+        }
+        uint8_t offset = buf[pos];
+        uint8_t len = buf[pos + 1];
+        if (len == 0 || static_cast<size_t>(offset) + len > stored ||
+            bytesRead - pos < SETTINGS_LOG_RECORD_OVERHEAD + len ||
+            crc8(buf + pos, 2 + len) != buf[pos + 2 + len]) {
+            torn = true;
+            break;
+        }
+        // A file opens with the whole image; anything else is a torn compaction
+        if (first && (offset != 0 || len != stored)) {
+            return false;
+        }
+        memcpy(image + offset, buf + pos + 2, len);
+        pos += SETTINGS_LOG_RECORD_OVERHEAD + len;
+        first = false;
+    }
+    if (first) {
+        return false;
+    }
+
+    // Fields appended since the log was written read as zero
+    memset(image + stored, 0, size - stored);
+    generation = header.generation;
+    length = pos;
+    imageSize = stored;
+    return true;
+}
+
+bool SettingsLog::load(uint8_t* image, size_t size, size_t minSize) {
+    _size = size;
+    _hasImage = false;
+    _needsCompaction = false;
+    _logBytes = 0;
+    if (image == nullptr || size == 0 || size > SETTINGS_LOG_MAX_IMAGE) {
+        return false;
+    }
+
+    if (minSize == 0 || minSize > size) {
+        minSize = size;
+    }
+
+    uint8_t candidate[SETTINGS_LOG_MAX_IMAGE];
+    size_t storedSize = size;
+    for (uint8_t f = 0; f < 2; f++) {
+        uint32_t generation = 0;
+        size_t length = 0;
+        size_t imageSize = 0;
+        bool torn = false;
+        if (!replay(LOG_FILES[f], size, minSize, candidate, generation, length, imageSize, torn)) {
+            continue;
+        }
+        if (_hasImage && static_cast<int32_t>(generation - _generation) <= 0) {
+            continue;
+        }
+        memcpy(_persisted, candidate, size);
+        _hasImage = true;
+        _needsCompaction = torn;
+        _active = f;
+        _generation = generation;
+        _logBytes = length;
+        storedSize = imageSize;
+    }
+
+    if (_hasImage) {
+        memcpy(image, _persisted, size);
+        // Older, shorter image: appends at the new offsets would not replay
+        if (storedSize != size && !compact(image, size)) {
+            _needsCompaction = true;
+        }
+    }
+    return _hasImage;
+}
+
+// =============================================================================
+// SAVE
+// =============================================================================
+
+bool SettingsLog::compact(const uint8_t* image, size_t size) {
+    uint8_t buf[sizeof(SettingsLogHeader) + SETTINGS_LOG_MAX_IMAGE + SETTINGS_LOG_RECORD_OVERHEAD];
+    uint8_t target = _hasImage ? static_cast<uint8_t>(_active ^ 1) : _active;
+    uint32_t generation = _generation + 1;
+
+    SettingsLogHeader header = {SETTINGS_LOG_MAGIC, SETTINGS_LOG_VERSION,
+                                static_cast<uint8_t>(size), 0, generation};
+    memcpy(buf, &header, sizeof(header));
+    size_t length = sizeof(header) + putRecord(buf + sizeof(header), 0, image, static_cast<uint8_t>(size));
+
+    if (!fsb::writeFile(LOG_FILES[target], buf, length)) {
+        return false;
+    }
+    // The new file is complete: the old one is no longer needed
+    fsb::removeFile(LOG_FILES[target ^ 1]);
+
+    memcpy(_persisted, image, size);
+    _hasImage = true;
+    _needsCompaction = false;
+    _active = target;
+    _generation = generation;
+    _logBytes = length;
+    return true;
+}
+
+bool SettingsLog::save(const uint8_t* image, size_t size) {
+    if (image == nullptr || size == 0 || size > SETTINGS_LOG_MAX_IMAGE) {
+        return false;
+    }
+    if (size != _size) {
+        _size = size;
+        _hasImage = false;  // Different image: start over
+    }
+    if (!_hasImage || _needsCompaction) {
+        return compact(image, size);
+    }
+
+    // One record per changed run; runs closer than a record's overhead merge
+    uint8_t buf[SETTINGS_LOG_MAX_IMAGE + SETTINGS_LOG_MAX_IMAGE * SETTINGS_LOG_RECORD_OVERHEAD];
+    size_t length = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (image[i] == _persisted[i]) {
+            i++;
+            continue;
+        }
+        size_t start = i;
+        size_t end = i + 1;
+        size_t same = 0;
+        for (size_t j = end; j < size; j++) {
+            if (image[j] != _persisted[j]) {
+                end = j + 1;
+                same = 0;
+            } else if (++same > SETTINGS_LOG_RECORD_OVERHEAD) {
+                break;
+            }
+        }
+        length += putRecord(buf + length, static_cast<uint8_t>(start), image + start,
+                            static_cast<uint8_t>(end - start));
+        i = end;
+    }
+
+    if (length == 0) {
+        return true;  // Nothing changed
+    }
+    if (_logBytes + length > SETTINGS_LOG_MAX_BYTES) {
+        return compact(image, size);
+    }
+    if (!fsb::appendFile(LOG_FILES[_active], buf, length)) {
+        // The tail may hold part of the append: rewrite on the next save
+        _needsCompaction = true;
+        return false;
+    }
+
+    memcpy(_persisted, image, size);
+    _logBytes += length;
+    return true;
+}
+
+bool SettingsLog::erase() {
+    bool removedA = fsb::removeFile(SETTINGS_LOG_FILE_A);
+    bool removedB = fsb::removeFile(SETTINGS_LOG_FILE_B);
+    _hasImage = false;
+    _needsCompaction = false;
+    _generation = 0;
+    _logBytes = 0;
+    return removedA || removedB;
+}
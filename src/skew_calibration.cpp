@@ -0,0 +1,132 @@
+/**
+ * @file skew_calibration.cpp
+ * @brief Per-peer clock-skew calibration - Implementation
+ */
+
+#include "skew_calibration.h"
+#include "fs_backend.h"
+#include <string.h>
+
+SkewCalibrationStore::SkewCalibrationStore() :
+    _file{},
+    _dirty(false)
+{
+    _file.magic = SKEW_CAL_MAGIC;
+    _file.version = SKEW_CAL_VERSION;
+}
+
+// =============================================================================
+// PERSISTENCE
+// =============================================================================
+
+bool SkewCalibrationStore::load() {
+    SkewCalFile data;
+    size_t bytesRead = 0;
+    bool valid = fsb::exists(SKEW_CAL_FILE) &&
+                 fsb::readFile(SKEW_CAL_FILE, reinterpret_cast<uint8_t*>(&data), sizeof(data), bytesRead) &&
+                 bytesRead == sizeof(data) &&
+                 data.magic == SKEW_CAL_MAGIC &&
+                 data.version == SKEW_CAL_VERSION &&
+                 data.count <= SYNC_SKEW_CAL_MAX_PEERS;
+
+    if (valid) {
+        _file = data;
+    } else {
+        clear();
+        _dirty = false;
+    }
+    _file.generation = static_cast<uint16_t>(_file.generation + 1);
+    return valid;
+}
+
+bool SkewCalibrationStore::save() {
+    if (!_dirty) {
+        return true;
+    }
+    if (!fsb::writeFile(SKEW_CAL_FILE, reinterpret_cast<const uint8_t*>(&_file), sizeof(_file))) {
+        return false;
+    }
+    _dirty = false;
+    return true;
+}
+
+void SkewCalibrationStore::clear() {
+    uint16_t generation = _file.generation;
+    memset(&_file, 0, sizeof(_file));
+    _file.magic = SKEW_CAL_MAGIC;
+    _file.version = SKEW_CAL_VERSION;
+    _file.generation = generation;
+    _dirty = true;
+}
+
+// =============================================================================
+// ENTRIES
+// =============================================================================
+
+int SkewCalibrationStore::findEntry(const uint8_t* addr) const {
+    for (uint8_t i = 0; i < _file.count; i++) {
+        if (memcmp(_file.entries[i].addr, addr, SKEW_CAL_ADDR_LEN) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool SkewCalibrationStore::lookup(const uint8_t* addr, int16_t temperatureQ,
+                                  float& skewOut, float& sigmaOut) const {
+    int index = findEntry(addr);
+    if (index < 0) {
+        return false;
+    }
+    const SkewCalEntry& entry = _file.entries[index];
+
+    uint16_t age = static_cast<uint16_t>(_file.generation - entry.generation);
+    if (age > SYNC_SKEW_CAL_MAX_AGE_BOOTS) {
+        return false;
+    }
+
+    float sigma = entry.sigmaUsPerMs;
+    if (sigma < SYNC_SKEW_CAL_SIGMA_US_PER_MS) {
+        sigma = SYNC_SKEW_CAL_SIGMA_US_PER_MS;
+    }
+
+    // Crystal skew moves with temperature; without both readings assume the
+    // worst case the entry is still accepted at
+    float deltaC = SYNC_SKEW_CAL_MAX_TEMP_DELTA_C;
+    if (temperatureQ != SKEW_CAL_NO_TEMPERATURE && entry.temperatureQ != SKEW_CAL_NO_TEMPERATURE) {
+        deltaC = static_cast<float>(temperatureQ - entry.temperatureQ) * 0.25f;
+        if (deltaC < 0.0f) deltaC = -deltaC;
+        if (deltaC > SYNC_SKEW_CAL_MAX_TEMP_DELTA_C) {
+            return false;
+        }
+    }
+
+    skewOut = entry.skewUsPerMs;
+    sigmaOut = sigma + deltaC * SYNC_SKEW_CAL_TEMP_SIGMA_PER_C;
+    return true;
+}
+
+void SkewCalibrationStore::record(const uint8_t* addr, float skewUsPerMs, float sigmaUsPerMs,
+                                  int16_t temperatureQ) {
+    int index = findEntry(addr);
+    if (index < 0) {
+        // New peer: evict the least recently used when full
+        if (_file.count < SYNC_SKEW_CAL_MAX_PEERS) {
+            _file.count++;
+        }
+        index = _file.count - 1;
+    }
+
+    // Shift the more recent entries down and put this one first
+    for (int i = index; i > 0; i--) {
+        _file.entries[i] = _file.entries[i - 1];
+    }
+
+    SkewCalEntry& entry = _file.entries[0];
+    memcpy(entry.addr, addr, SKEW_CAL_ADDR_LEN);
+    entry.generation = _file.generation;
+    entry.temperatureQ = temperatureQ;
+    entry.skewUsPerMs = skewUsPerMs;
+    entry.sigmaUsPerMs = sigmaUsPerMs;
+    _dirty = true;
+}
@@ -0,0 +1,336 @@
+/**
+ * @file skew_capture.cpp
+ * @brief On-glove bilateral skew measurement - Implementation
+ */
+
+#include "skew_capture.h"
+#include "platform.h"
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+#if SYNC_SKEW_CAPTURE_ENABLED
+SkewCapture skewCapture;
+#endif
+
+// Keeps the platform capture's timebase mapping fresh (see PLATFORM CAPTURE)
+static void serviceCaptureReference(uint64_t nowUs);
+
+// =============================================================================
+// EDGE RING
+// =============================================================================
+
+SkewEdgeRing::SkewEdgeRing() :
+    _buffer{},
+    _head(0),
+    _tail(0)
+{
+}
+
+bool SkewEdgeRing::push(uint64_t timestampUs) {
+    // Memory barrier before reading consumer index (tail)
+    platformMemoryBarrier();
+
+    uint8_t currentHead = _head;
+    uint8_t nextHead = static_cast<uint8_t>((currentHead + 1) & (SIZE - 1));
+    if (nextHead == _tail) {
+        return false;
+    }
+
+    _buffer[currentHead] = timestampUs;
+
+    // Publish data before advancing head
+    platformMemoryBarrier();
+    _head = nextHead;
+    return true;
+}
+
+bool SkewEdgeRing::peek(uint64_t& timestampUs) const {
+    // Memory barrier before reading producer index (head)
+    platformMemoryBarrier();
+
+    uint8_t currentTail = _tail;
+    if (currentTail == _head) {
+        return false;
+    }
+    timestampUs = _buffer[currentTail];
+    return true;
+}
+
+void SkewEdgeRing::pop() {
+    platformMemoryBarrier();
+
+    uint8_t currentTail = _tail;
+    if (currentTail == _head) {
+        return;
+    }
+    _tail = static_cast<uint8_t>((currentTail + 1) & (SIZE - 1));
+}
+
+void SkewEdgeRing::clear() {
+    platformMemoryBarrier();
+    _tail = _head;
+}
+
+// =============================================================================
+// PAIRING
+// =============================================================================
+
+SkewCapture::SkewCapture() :
+    _stats{},
+    _remoteDropped(0),
+    _active(false)
+{
+}
+
+void SkewCapture::onRemoteEdge(uint64_t timestampUs) {
+    if (!_remote.push(timestampUs)) {
+        _remoteDropped = _remoteDropped + 1;
+    }
+}
+
+void SkewCapture::onLocalEdge(uint64_t timestampUs) {
+    if (!_local.push(timestampUs)) {
+        _stats.dropped++;
+    }
+}
+
+uint8_t SkewCapture::process(uint64_t nowUs, int32_t* skews, uint8_t maxSkews) {
+    if (_active) {
+        serviceCaptureReference(nowUs);
+    }
+
+    uint8_t written = 0;
+    while (written < maxSkews) {
+        uint64_t localUs = 0;
+        uint64_t remoteUs = 0;
+        bool hasLocal = _local.peek(localUs);
+        bool hasRemote = _remote.peek(remoteUs);
+
+        if (hasLocal && hasRemote) {
+            int64_t skew = static_cast<int64_t>(localUs - remoteUs);
+            int64_t magnitude = skew < 0 ? -skew : skew;
+            if (magnitude <= SYNC_SKEW_CAPTURE_WINDOW_US) {
+                skews[written++] = static_cast<int32_t>(skew);
+                _local.pop();
+                _remote.pop();
+                _stats.paired++;
+            } else if (skew < 0) {
+                _local.pop();  // Local activation far before any PRIMARY edge
+                _stats.unmatchedLocal++;
+            } else {
+                _remote.pop();
+                _stats.unmatchedRemote++;
+            }
+            continue;
+        }
+
+        // A lone edge waits one window for its partner, then expires
+        if (hasLocal && nowUs - localUs > SYNC_SKEW_CAPTURE_WINDOW_US) {
+            _local.pop();
+            _stats.unmatchedLocal++;
+            continue;
+        }
+        if (hasRemote && nowUs - remoteUs > SYNC_SKEW_CAPTURE_WINDOW_US) {
+            _remote.pop();
+            _stats.unmatchedRemote++;
+            continue;
+        }
+        break;
+    }
+    return written;
+}
+
+SkewCaptureStats SkewCapture::getStats() const {
+    SkewCaptureStats copy = _stats;
+    copy.dropped += _remoteDropped;
+    return copy;
+}
+
+void SkewCapture::reset() {
+    _local.clear();
+    _remote.clear();
+    _stats = {};
+    _remoteDropped = 0;
+}
+
+// =============================================================================
+// PLATFORM CAPTURE
+// =============================================================================
+
+#if SYNC_SKEW_CAPTURE_ENABLED && defined(NRF52840_XXAA) && !defined(NATIVE_TEST_BUILD)
+
+// The pin's GPIOTE IN event drives TIMER4 TASKS_CAPTURE[n] over PPI, so the
+// timestamp is latched in hardware on the edge; the GPIOTE interrupt only
+// collects it. TIMER4 counts the low 32 bits of getMicros() (hires_clock.cpp;
+// CC[4]/CC[5] are the alarm and read registers).
+
+#include <Arduino.h>
+#include <nrf.h>
+#include <nrf_soc.h>
+#include "hires_clock.h"
+#include "sync_protocol.h"
+
+static void onCaptureEdge() {
+    uint32_t captured = NRF_TIMER4->CC[SYNC_SKEW_CAPTURE_TIMER_CC];
+    uint64_t now = getMicros();
+    // Extend to 64 bits: the capture precedes now by less than one wrap
+    skewCapture.onRemoteEdge(now - static_cast<uint32_t>(static_cast<uint32_t>(now) - captured));
+}
+
+bool SkewCapture::begin() {
+    if (_active) {
+        return true;
+    }
+    if (!hiresClockIsRunning()) {
+        return false;
+    }
+
+    pinMode(SYNC_SKEW_CAPTURE_PIN, INPUT_PULLDOWN);
+    attachInterrupt(SYNC_SKEW_CAPTURE_PIN, onCaptureEdge, CHANGE);
+
+    // attachInterrupt() allocated a GPIOTE channel for the pin - find it
+    uint32_t psel = g_ADigitalPinMap[SYNC_SKEW_CAPTURE_PIN];
+    int channel = -1;
+    for (int i = 0; i < GPIOTE_CH_NUM; i++) {
+        uint32_t config = NRF_GPIOTE->CONFIG[i];
+        if ((config & GPIOTE_CONFIG_MODE_Msk) == (GPIOTE_CONFIG_MODE_Event << GPIOTE_CONFIG_MODE_Pos) &&
+            ((config >> GPIOTE_CONFIG_PSEL_Pos) & 0x3F) == psel) {
+            channel = i;
+            break;
+        }
+    }
+    if (channel < 0) {
+        detachInterrupt(SYNC_SKEW_CAPTURE_PIN);
+        return false;
+    }
+
+    if (sd_ppi_channel_assign(SYNC_SKEW_CAPTURE_PPI_CHANNEL,
+                              &NRF_GPIOTE->EVENTS_IN[channel],
+                              &NRF_TIMER4->TASKS_CAPTURE[SYNC_SKEW_CAPTURE_TIMER_CC]) != NRF_SUCCESS ||
+        sd_ppi_channel_enable_set(1UL << SYNC_SKEW_CAPTURE_PPI_CHANNEL) != NRF_SUCCESS) {
+        detachInterrupt(SYNC_SKEW_CAPTURE_PIN);
+        return false;
+    }
+
+    reset();
+    _active = true;
+    return true;
+}
+
+static void serviceCaptureReference(uint64_t) {}  // Capture is already on the getMicros() timebase
+
+#elif SYNC_SKEW_CAPTURE_ENABLED && defined(BOARD_PENTABUZZER_ESP32S3) && !defined(NATIVE_TEST_BUILD)
+
+// MCPWM capture latches its free-running APB-clocked timer on the edge.
+// The timer is mapped onto getMicros() (esp_timer, same crystal) through a
+// reference pair taken by a software catch on the same channel, refreshed
+// from process() well inside the capture counter's 32-bit wrap.
+
+#include <Arduino.h>
+#include "esp_attr.h"
+#include "driver/mcpwm_cap.h"
+#include "sync_protocol.h"
+
+static mcpwm_cap_timer_handle_t s_capTimer = nullptr;
+static mcpwm_cap_channel_handle_t s_capChannel = nullptr;
+static uint32_t s_ticksPerUs = 0;
+static volatile bool s_softCatchPending = false;
+static volatile uint32_t s_softCatchTicks = 0;
+static uint32_t s_refTicks = 0;
+static uint64_t s_refUs = 0;
+static uint64_t s_lastRefreshUs = 0;
+
+static constexpr uint64_t REFERENCE_REFRESH_US = 1000000;
+
+static bool IRAM_ATTR onCaptureIsr(mcpwm_cap_channel_handle_t channel,
+                                   const mcpwm_capture_event_data_t* edata,
+                                   void* userCtx) {
+    (void)channel;
+    (void)userCtx;
+    if (s_softCatchPending) {
+        s_softCatchTicks = edata->cap_value;
+        s_softCatchPending = false;
+        return false;
+    }
+    int32_t deltaTicks = static_cast<int32_t>(edata->cap_value - s_refTicks);
+    skewCapture.onRemoteEdge(s_refUs + deltaTicks / static_cast<int32_t>(s_ticksPerUs));
+    return false;
+}
+
+static bool refreshReference() {
+    // Bracket the soft catch with getMicros(); the midpoint is within ~1us
+    s_softCatchPending = true;
+    uint64_t before = getMicros();
+    mcpwm_capture_channel_trigger_soft_catch(s_capChannel);
+    uint64_t after = getMicros();
+    if (s_softCatchPending) {
+        s_softCatchPending = false;
+        return false;
+    }
+    s_refTicks = s_softCatchTicks;
+    s_refUs = before + (after - before) / 2;
+    s_lastRefreshUs = after;
+    return true;
+}
+
+bool SkewCapture::begin() {
+    if (_active) {
+        return true;
+    }
+
+    mcpwm_capture_timer_config_t timerConfig = {};
+    timerConfig.group_id = 0;
+    timerConfig.clk_src = MCPWM_CAPTURE_CLK_SRC_DEFAULT;
+    if (mcpwm_new_capture_timer(&timerConfig, &s_capTimer) != ESP_OK) {
+        s_capTimer = nullptr;
+        return false;
+    }
+
+    mcpwm_capture_channel_config_t channelConfig = {};
+    channelConfig.gpio_num = SYNC_SKEW_CAPTURE_PIN;
+    channelConfig.prescale = 1;
+    channelConfig.flags.pos_edge = true;
+    channelConfig.flags.neg_edge = true;
+    channelConfig.flags.pull_down = true;
+
+    mcpwm_capture_event_callbacks_t callbacks = {};
+    callbacks.on_cap = onCaptureIsr;
+
+    uint32_t resolutionHz = 0;
+    if (mcpwm_new_capture_channel(s_capTimer, &channelConfig, &s_capChannel) != ESP_OK ||
+        mcpwm_capture_channel_register_event_callbacks(s_capChannel, &callbacks, nullptr) != ESP_OK ||
+        mcpwm_capture_channel_enable(s_capChannel) != ESP_OK ||
+        mcpwm_capture_timer_enable(s_capTimer) != ESP_OK ||
+        mcpwm_capture_timer_start(s_capTimer) != ESP_OK ||
+        mcpwm_capture_timer_get_resolution(s_capTimer, &resolutionHz) != ESP_OK ||
+        resolutionHz < 1000000) {
+        return false;
+    }
+    s_ticksPerUs = resolutionHz / 1000000;
+
+    if (!refreshReference()) {
+        return false;
+    }
+
+    reset();
+    _active = true;
+    return true;
+}
+
+static void serviceCaptureReference(uint64_t nowUs) {
+    if (nowUs - s_lastRefreshUs > REFERENCE_REFRESH_US) {
+        refreshReference();
+    }
+}
+
+#else  // Native test build / capture disabled: pairing only, no hardware
+
+bool SkewCapture::begin() {
+    return false;
+}
+
+static void serviceCaptureReference(uint64_t) {}
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * @file soft_timers.cpp
+ * @brief Fixed-capacity software timers - Implementation
+ */
+
+#include "soft_timers.h"
+
+// Wrap-safe "a is before b"
+static bool dueBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+}
+
+SoftTimers::SoftTimers() :
+    _slots{},
+    _head(SOFT_TIMER_NONE),
+    _count(0)
+{
+}
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+SoftTimerId SoftTimers::add(SoftTimerCallback fn) {
+    if (_count >= CAPACITY) {
+        return SOFT_TIMER_NONE;
+    }
+    Slot& slot = _slots[_count];
+    slot.callback = fn;
+    slot.dueMs = 0;
+    slot.periodMs = 0;
+    slot.next = SOFT_TIMER_NONE;
+    slot.active = false;
+    return _count++;
+}
+
+SoftTimerCallback SoftTimers::callback(SoftTimerId id) const {
+    return (id < _count) ? _slots[id].callback : nullptr;
+}
+
+// =============================================================================
+// ARMING
+// =============================================================================
+
+void SoftTimers::link(SoftTimerId id) {
+    // Insert after every timer due at or before it (FIFO among equal deadlines)
+    uint32_t due = _slots[id].dueMs;
+    uint8_t* prev = &_head;
+    while (*prev != SOFT_TIMER_NONE && !dueBefore(due, _slots[*prev].dueMs)) {
+        prev = &_slots[*prev].next;
+    }
+    _slots[id].next = *prev;
+    *prev = id;
+    _slots[id].active = true;
+}
+
+void SoftTimers::unlink(SoftTimerId id) {
+    uint8_t* prev = &_head;
+    while (*prev != SOFT_TIMER_NONE && *prev != id) {
+        prev = &_slots[*prev].next;
+    }
+    if (*prev == id) {
+        *prev = _slots[id].next;
+    }
+    _slots[id].next = SOFT_TIMER_NONE;
+    _slots[id].active = false;
+}
+
+void SoftTimers::start(SoftTimerId id, uint32_t nowMs, uint32_t delayMs, uint32_t periodMs) {
+    if (id >= _count) {
+        return;
+    }
+    if (_slots[id].active) {
+        unlink(id);
+    }
+    _slots[id].dueMs = nowMs + delayMs;
+    _slots[id].periodMs = periodMs;
+    link(id);
+}
+
+void SoftTimers::stop(SoftTimerId id) {
+    if (id < _count && _slots[id].active) {
+        unlink(id);
+    }
+}
+
+bool SoftTimers::isActive(SoftTimerId id) const {
+    return id < _count && _slots[id].active;
+}
+
+// =============================================================================
+// EXPIRY
+// =============================================================================
+
+bool SoftTimers::nextDue(uint32_t& dueMs) const {
+    if (_head == SOFT_TIMER_NONE) {
+        return false;
+    }
+    dueMs = _slots[_head].dueMs;
+    return true;
+}
+
+SoftTimerId SoftTimers::popExpired(uint32_t nowMs) {
+    SoftTimerId id = _head;
+    if (id == SOFT_TIMER_NONE || dueBefore(nowMs, _slots[id].dueMs)) {
+        return SOFT_TIMER_NONE;
+    }
+
+    Slot& slot = _slots[id];
+    _head = slot.next;
+    slot.next = SOFT_TIMER_NONE;
+    slot.active = false;
+
+    if (slot.periodMs > 0) {
+        slot.dueMs += slot.periodMs;
+        if (!dueBefore(nowMs, slot.dueMs)) {
+            slot.dueMs = nowMs + slot.periodMs;
+        }
+        link(id);
+    }
+    return id;
+}
+
+uint8_t SoftTimers::advance(uint32_t nowMs) {
+    // At most one expiry per timer per call: a callback that re-arms
+    // itself with zero delay runs again on the next advance()
+    uint8_t fired = 0;
+    while (fired < _count) {
+        SoftTimerId id = popExpired(nowMs);
+        if (id == SOFT_TIMER_NONE) {
+            break;
+        }
+        fired++;
+        if (_slots[id].callback) {
+            _slots[id].callback();
+        }
+    }
+    return fired;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file status_snapshot.cpp
+ * @brief Two-slot seqlock status snapshot - Implementation
+ */
+
+#include "status_snapshot.h"
+#include <string.h>
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+StatusSeqlock statusSnapshot;
+
+// =============================================================================
+// SEQLOCK
+// =============================================================================
+
+StatusSeqlock::StatusSeqlock() :
+    _sequence(0),
+    _retries(0)
+{
+}
+
+void StatusSeqlock::publish(const StatusSnapshot& snapshot) {
+    uint32_t next = _sequence.load(std::memory_order_relaxed) + 1;
+
+    // Fill the slot readers are not pointed at, then point them at it. The
+    // fence keeps the previous publish's sequence store ahead of these slot
+    // writes, so a reader that sees any of them also sees the new sequence.
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&_slots[next & 1], &snapshot, sizeof(StatusSnapshot));
+    _sequence.store(next, std::memory_order_release);
+}
+
+bool StatusSeqlock::read(StatusSnapshot& out) const {
+    for (uint8_t attempt = 0; attempt < READ_ATTEMPTS; attempt++) {
+        uint32_t before = _sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+
+        StatusSnapshot copy;
+        memcpy(&copy, &_slots[before & 1], sizeof(StatusSnapshot));
+
+        // The next publish() after `before` rewrites this slot: the copy
+        // is whole only if no publish() completed meanwhile
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_sequence.load(std::memory_order_relaxed) == before) {
+            out = copy;
+            return true;
+        }
+        _retries.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+}
@@ -8,6 +8,7 @@
 #include "sync_protocol.h"
 #include "hires_clock.h"
 #include "platform.h"
+#include "perf_profile.h"
 #include <string.h>
 #include <stdlib.h>
 #include <cerrno>
@@ -469,6 +470,147 @@ void SyncCommand::clearData() {
     }
 }
 
+// =============================================================================
+// SYNC COMMAND VIEW - ZERO-COPY PARSE
+// =============================================================================
+
+/**
+ * @brief Parse the leading decimal digits of a length-bounded token
+ *
+ * Mirrors strtoul()/strtoull() as used by SyncCommand: at least one digit
+ * is required, parsing stops at the first non-digit, and values above
+ * maxValue are rejected as overflow.
+ */
+static bool parseDecimalSpan(const char* str, size_t length, uint64_t maxValue, uint64_t& out) {
+    uint64_t value = 0;
+    size_t digits = 0;
+    while (digits < length && str[digits] >= '0' && str[digits] <= '9') {
+        uint8_t d = (uint8_t)(str[digits] - '0');
+        if (value > (maxValue - d) / 10) {
+            return false;  // Overflow
+        }
+        value = value * 10 + d;
+        digits++;
+    }
+    if (digits == 0) {
+        return false;  // No digits consumed
+    }
+    out = value;
+    return true;
+}
+
+SyncCommandView::SyncCommandView() :
+    _message(nullptr),
+    _type(SyncCommandType::PING),
+    _sequenceId(0),
+    _timestamp(0),
+    _fieldCount(0)
+{
+}
+
+bool SyncCommandView::parse(const char* message, size_t length) {
+    _message = message;
+    _fieldCount = 0;
+
+    if (!message || length < 3) {
+        return false;
+    }
+
+    // Command type: everything before the first colon
+    const char* colonPos = static_cast<const char*>(memchr(message, SYNC_CMD_DELIMITER, length));
+    if (!colonPos) {
+        return false;
+    }
+    size_t typeLen = (size_t)(colonPos - message);
+    bool typeFound = false;
+    for (size_t i = 0; i < COMMAND_MAPPINGS_COUNT; i++) {
+        const char* str = COMMAND_MAPPINGS[i].str;
+        if (strncmp(message, str, typeLen) == 0 && str[typeLen] == '\0') {
+            _type = COMMAND_MAPPINGS[i].type;
+            typeFound = true;
+            break;
+        }
+    }
+    if (!typeFound) {
+        return false;
+    }
+
+    // Walk pipe-delimited tokens: seq|timestamp|field|field...
+    // Empty tokens are skipped, matching strtok() in SyncCommand::deserialize()
+    size_t pos = typeLen + 1;
+    uint8_t tokenIndex = 0;
+    while (pos < length) {
+        if (message[pos] == '\0') {
+            break;  // Honour NUL termination inside the given length
+        }
+        if (message[pos] == SYNC_DATA_DELIMITER) {
+            pos++;
+            continue;
+        }
+
+        size_t start = pos;
+        while (pos < length && message[pos] != SYNC_DATA_DELIMITER && message[pos] != '\0') {
+            pos++;
+        }
+        size_t tokenLen = pos - start;
+
+        if (tokenIndex == 0) {
+            uint64_t seq;
+            if (!parseDecimalSpan(message + start, tokenLen, UINT32_MAX, seq)) {
+                return false;
+            }
+            _sequenceId = (uint32_t)seq;
+        } else if (tokenIndex == 1) {
+            if (!parseDecimalSpan(message + start, tokenLen, UINT64_MAX, _timestamp)) {
+                return false;
+            }
+        } else if (_fieldCount < SYNC_MAX_DATA_PAIRS && start <= UINT16_MAX && tokenLen <= UINT16_MAX) {
+            _fieldOffset[_fieldCount] = (uint16_t)start;
+            _fieldLength[_fieldCount] = (uint16_t)tokenLen;
+            _fieldCount++;
+        } else {
+            break;
+        }
+        tokenIndex++;
+    }
+
+    // Need at least seq|timestamp
+    return tokenIndex >= 2;
+}
+
+uint32_t SyncCommandView::u32(uint8_t index, uint32_t defaultValue) const {
+    if (index >= _fieldCount) {
+        return defaultValue;
+    }
+    uint64_t value;
+    if (!parseDecimalSpan(_message + _fieldOffset[index], _fieldLength[index], UINT32_MAX, value)) {
+        return defaultValue;
+    }
+    return (uint32_t)value;
+}
+
+int32_t SyncCommandView::i32(uint8_t index, int32_t defaultValue) const {
+    if (index >= _fieldCount) {
+        return defaultValue;
+    }
+    const char* field = _message + _fieldOffset[index];
+    size_t length = _fieldLength[index];
+    bool negative = (length > 0 && field[0] == '-');
+    if (negative) {
+        field++;
+        length--;
+    }
+    uint64_t value;
+    if (!parseDecimalSpan(field, length, negative ? 2147483648ULL : (uint64_t)INT32_MAX, value)) {
+        return defaultValue;
+    }
+    return negative ? (int32_t)(-(int64_t)value) : (int32_t)value;
+}
+
+uint64_t SyncCommandView::u64(uint8_t hiIndex, uint8_t loIndex) const {
+    return ((uint64_t)u32(hiIndex, 0) << 32) | u32(loIndex, 0);
+}
+
 // =============================================================================
 // SYNC COMMAND - FACTORY METHODS
 // =============================================================================
@@ -571,12 +713,166 @@ SyncCommand SyncCommand::createMacrocycleAck(uint32_t sequenceId) {
     return SyncCommand(SyncCommandType::MACROCYCLE_ACK, sequenceId);
 }
 
+SyncCommand SyncCommand::createMacrocycleAck(uint32_t sequenceId, int32_t slackUs) {
+    SyncCommand cmd(SyncCommandType::MACROCYCLE_ACK, sequenceId);
+    cmd.setData("0", slackUs);
+    return cmd;
+}
+
 // =============================================================================
-// MACROCYCLE SERIALIZATION (all-text format for BLE compatibility)
+// MACROCYCLE SERIALIZATION (V5 all-text / V6 escaped binary)
 // =============================================================================
 
-bool SyncCommand::serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle) {
-    if (!buffer || bufferSize < 200) {
+// V6 body layout (little-endian): seq u32, baseTime u64, clockOffset i64,
+// durationMs u16, eventCount u8, then eventCount x {deltaTimeMs u16, finger u8,
+// amplitude u8, freqOffset u8}. Per-event duration is the header value, as in
+// V5; primaryFinger is PRIMARY-local and never transmitted.
+static constexpr size_t MC_V6_PREFIX_SIZE = 4;   // "MC:" + version byte
+static constexpr size_t MC_V6_HEADER_SIZE = 23;
+static constexpr size_t MC_V6_EVENT_SIZE = 5;
+static constexpr size_t MC_V6_MAX_BODY = MC_V6_HEADER_SIZE + MACROCYCLE_MAX_EVENTS * MC_V6_EVENT_SIZE;
+
+// The transport hands messages around as EOT-framed C strings and drops '\r',
+// so NUL, EOT, CR and the escape byte itself cannot appear raw. Whitening with
+// 0x80 first moves the dominant 0x00/0xFF high bytes of little-endian integers
+// out of the escape set, keeping escapes rare.
+static constexpr uint8_t MC_V6_WHITEN = 0x80;
+static constexpr uint8_t MC_V6_ESCAPE = 0x1B;
+static constexpr uint8_t MC_V6_ESCAPE_XOR = 0x20;
+
+static inline bool mcV6NeedsEscape(uint8_t b) {
+    return b == 0x00 || b == BLE_EOT_CHAR || b == '\r' || b == MC_V6_ESCAPE;
+}
+
+static bool mcV6PutByte(char* buffer, size_t bufferSize, size_t& pos, uint8_t raw) {
+    uint8_t b = raw ^ MC_V6_WHITEN;
+    if (mcV6NeedsEscape(b)) {
+        if (pos + 2 >= bufferSize) return false;  // keep room for the terminator
+        buffer[pos++] = static_cast<char>(MC_V6_ESCAPE);
+        buffer[pos++] = static_cast<char>(b ^ MC_V6_ESCAPE_XOR);
+    } else {
+        if (pos + 1 >= bufferSize) return false;
+        buffer[pos++] = static_cast<char>(b);
+    }
+    return true;
+}
+
+static bool mcV6PutLE(char* buffer, size_t bufferSize, size_t& pos, uint64_t value, uint8_t bytes) {
+    for (uint8_t i = 0; i < bytes; i++) {
+        if (!mcV6PutByte(buffer, bufferSize, pos, static_cast<uint8_t>(value >> (8 * i)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint64_t mcV6GetLE(const uint8_t* raw, uint8_t bytes) {
+    uint64_t value = 0;
+    for (uint8_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(raw[i]) << (8 * i);
+    }
+    return value;
+}
+
+static bool serializeMacrocycleV6(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                  size_t* offsetPos = nullptr, size_t* offsetLen = nullptr) {
+    if (macrocycle.eventCount > MACROCYCLE_MAX_EVENTS || bufferSize <= MC_V6_PREFIX_SIZE) {
+        return false;
+    }
+
+    memcpy(buffer, "MC:", 3);
+    buffer[3] = static_cast<char>(MACROCYCLE_WIRE_V6);
+    size_t pos = MC_V6_PREFIX_SIZE;
+
+    bool ok = mcV6PutLE(buffer, bufferSize, pos, macrocycle.sequenceId, 4) &&
+              mcV6PutLE(buffer, bufferSize, pos, macrocycle.baseTime, 8);
+    size_t offsetStart = pos;
+    ok = ok && mcV6PutLE(buffer, bufferSize, pos, static_cast<uint64_t>(macrocycle.clockOffset), 8);
+    if (offsetPos) *offsetPos = offsetStart;
+    if (offsetLen) *offsetLen = pos - offsetStart;
+    ok = ok && mcV6PutLE(buffer, bufferSize, pos, macrocycle.durationMs, 2) &&
+         mcV6PutByte(buffer, bufferSize, pos, macrocycle.eventCount);
+
+    for (uint8_t i = 0; ok && i < macrocycle.eventCount; i++) {
+        const MacrocycleEvent& evt = macrocycle.events[i];
+        ok = mcV6PutLE(buffer, bufferSize, pos, evt.deltaTimeMs, 2) &&
+             mcV6PutByte(buffer, bufferSize, pos, evt.finger) &&
+             mcV6PutByte(buffer, bufferSize, pos, evt.amplitude) &&
+             mcV6PutByte(buffer, bufferSize, pos, evt.freqOffset);
+    }
+
+    // Never hand out a partial frame
+    if (!ok) {
+        buffer[0] = '\0';
+        return false;
+    }
+    buffer[pos] = '\0';
+    return true;
+}
+
+// Undo escaping + whitening of a binary frame body into a bounded buffer
+static bool mcV6Unescape(const char* message, size_t messageLen, uint8_t* body,
+                         size_t bodyCapacity, size_t& bodyLen) {
+    bodyLen = 0;
+    for (size_t i = MC_V6_PREFIX_SIZE; i < messageLen; i++) {
+        uint8_t b = static_cast<uint8_t>(message[i]);
+        if (b == MC_V6_ESCAPE) {
+            if (++i >= messageLen) return false;  // dangling escape
+            b = static_cast<uint8_t>(message[i]) ^ MC_V6_ESCAPE_XOR;
+        }
+        if (bodyLen >= bodyCapacity) return false;
+        body[bodyLen++] = b ^ MC_V6_WHITEN;
+    }
+    return true;
+}
+
+static bool deserializeMacrocycleV6(const char* message, size_t messageLen, Macrocycle& macrocycle) {
+    uint8_t body[MC_V6_MAX_BODY];
+    size_t bodyLen = 0;
+    if (!mcV6Unescape(message, messageLen, body, sizeof(body), bodyLen)) {
+        return false;
+    }
+
+    if (bodyLen < MC_V6_HEADER_SIZE) return false;
+
+    uint8_t count = body[22];
+    // Binary frames are length-exact: any mismatch is corruption, not a
+    // truncation to salvage
+    if (count > MACROCYCLE_MAX_EVENTS || bodyLen != MC_V6_HEADER_SIZE + count * MC_V6_EVENT_SIZE) {
+        return false;
+    }
+
+    macrocycle.sequenceId = static_cast<uint32_t>(mcV6GetLE(&body[0], 4));
+    macrocycle.baseTime = mcV6GetLE(&body[4], 8);
+    macrocycle.clockOffset = static_cast<int64_t>(mcV6GetLE(&body[12], 8));
+    macrocycle.durationMs = static_cast<uint16_t>(mcV6GetLE(&body[20], 2));
+    macrocycle.eventCount = count;
+
+    const uint8_t* ev = &body[MC_V6_HEADER_SIZE];
+    for (uint8_t i = 0; i < count; i++, ev += MC_V6_EVENT_SIZE) {
+        MacrocycleEvent& evt = macrocycle.events[i];
+        evt.deltaTimeMs = static_cast<uint16_t>(mcV6GetLE(ev, 2));
+        evt.finger = ev[2];
+        evt.amplitude = ev[3];
+        evt.freqOffset = ev[4];
+        evt.durationMs = macrocycle.durationMs;
+    }
+
+    return macrocycle.eventCount > 0;
+}
+
+bool SyncCommand::serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                      uint8_t wireVersion) {
+    if (!buffer) {
+        return false;
+    }
+
+    // V7 links use V6 frames whenever a delta is not possible
+    if (wireVersion >= MACROCYCLE_WIRE_V6) {
+        return serializeMacrocycleV6(buffer, bufferSize, macrocycle);
+    }
+
+    if (bufferSize < 200) {
         return false;
     }
 
@@ -637,16 +933,65 @@ bool SyncCommand::serializeMacrocycle(char* buffer, size_t bufferSize, const Mac
     return true;
 }
 
-size_t SyncCommand::getMacrocycleSerializedSize(const Macrocycle& macrocycle) {
+bool SyncCommand::serializeMacrocycleFanout(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                            size_t& offsetPos, size_t& offsetLen) {
+    if (!buffer) {
+        return false;
+    }
+    return serializeMacrocycleV6(buffer, bufferSize, macrocycle, &offsetPos, &offsetLen);
+}
+
+size_t SyncCommand::patchMacrocycleOffset(const char* frame, size_t frameLen, size_t offsetPos,
+                                          size_t offsetLen, int64_t clockOffset,
+                                          char* out, size_t outSize) {
+    if (!frame || !out || offsetPos + offsetLen > frameLen || offsetPos >= outSize) {
+        return 0;
+    }
+
+    // Prefix and events are copied verbatim; only the offset is re-escaped
+    memcpy(out, frame, offsetPos);
+    size_t pos = offsetPos;
+    if (!mcV6PutLE(out, outSize, pos, static_cast<uint64_t>(clockOffset), 8)) {
+        return 0;
+    }
+    size_t suffixLen = frameLen - offsetPos - offsetLen;
+    if (pos + suffixLen >= outSize) {
+        return 0;
+    }
+    memcpy(out + pos, frame + offsetPos + offsetLen, suffixLen);
+    pos += suffixLen;
+    out[pos] = '\0';
+    return pos;
+}
+
+size_t SyncCommand::getMacrocycleSerializedSize(const Macrocycle& macrocycle, uint8_t wireVersion) {
+    if (wireVersion >= MACROCYCLE_WIRE_V6) {
+        return MC_V6_PREFIX_SIZE + MC_V6_HEADER_SIZE + (macrocycle.eventCount * MC_V6_EVENT_SIZE);
+    }
+
     // Header: "MC:seq|baseTime|offset|dur|count" = ~50 bytes
     // Each event: "|d,f,a" or "|d,f,a,fo" = ~10-12 bytes
     return 50 + (macrocycle.eventCount * 12);
 }
 
 bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen, Macrocycle& macrocycle) {
-    (void)messageLen;  // Not needed for text format
+    PERF_SCOPE(DESERIALIZE_MACROCYCLE);
+    if (!message) {
+        return false;
+    }
 
-    if (!message || strlen(message) < 20) {
+    // V6: version byte right after "MC:" (V5 always has a digit there)
+    if (messageLen > MC_V6_PREFIX_SIZE && strncmp(message, "MC:", 3) == 0 &&
+        static_cast<uint8_t>(message[3]) == MACROCYCLE_WIRE_V6) {
+        return deserializeMacrocycleV6(message, messageLen, macrocycle);
+    }
+
+    // V7 template/delta frames need link state (deserializeMacrocycleDelta)
+    if (messageLen > MC_V6_PREFIX_SIZE && static_cast<uint8_t>(message[3]) == MACROCYCLE_WIRE_V7) {
+        return false;
+    }
+
+    if (strlen(message) < 20) {
         return false;
     }
 
@@ -747,6 +1092,504 @@ bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen,
     return macrocycle.eventCount > 0;
 }
 
+// =============================================================================
+// MACROCYCLE V7 TEMPLATE + DELTA FRAMES
+// =============================================================================
+
+// Same prefix, whitening and escaping as V6; the first body byte is the
+// frame kind. Deltas rebuild deltaTimeMs as a running sum of
+// spacing + deviation, so event 0 must sit at delta 0.
+static constexpr size_t MC_V7_TEMPLATE_HEADER = 9;   // kind + 8 fixed bytes
+static constexpr size_t MC_V7_DELTA_HEADER = 15;     // kind + seq + refDist + base + offset + flags
+static constexpr size_t MC_V7_MAX_BODY = MC_V7_DELTA_HEADER + MACROCYCLE_MAX_EVENTS * 4;
+
+static constexpr uint8_t MC_V7_FLAG_JITTER = 0x01;       // Per-gap spacing deviations present
+static constexpr uint8_t MC_V7_FLAG_AMPLITUDE = 0x02;    // Per-event amplitudes present
+static constexpr uint8_t MC_V7_FLAG_FREQUENCY = 0x04;    // Per-event freqOffsets present
+
+static const uint8_t MC_FACTORIAL[MAX_ACTUATORS + 1] = {
+    1, 1, 2, 6, 24
+#if MAX_ACTUATORS >= 5
+    , 120
+#endif
+};
+static_assert(MAX_ACTUATORS <= 5, "Permutation ranks must fit in one byte");
+
+static bool mcV7PutHeader(char* buffer, size_t bufferSize, size_t& pos, uint8_t kind) {
+    if (bufferSize <= MC_V6_PREFIX_SIZE) return false;
+    memcpy(buffer, "MC:", 3);
+    buffer[3] = static_cast<char>(MACROCYCLE_WIRE_V7);
+    pos = MC_V6_PREFIX_SIZE;
+    return mcV6PutByte(buffer, bufferSize, pos, kind);
+}
+
+static bool mcV7Finish(char* buffer, size_t pos, bool ok) {
+    // Never hand out a partial frame
+    if (!ok) {
+        buffer[0] = '\0';
+        return false;
+    }
+    buffer[pos] = '\0';
+    return true;
+}
+
+// Index of finger in the template's ascending finger set (-1 if absent)
+static int8_t mcV7FingerSlot(const MacrocycleTemplate& tmpl, uint8_t finger) {
+    for (uint8_t i = 0; i < tmpl.fingersPerPattern; i++) {
+        if (tmpl.fingers[i] == finger) return static_cast<int8_t>(i);
+    }
+    return -1;
+}
+
+// Lehmer rank of one pattern's finger order (false if not a permutation)
+static bool mcV7RankPattern(const MacrocycleTemplate& tmpl, const MacrocycleEvent* events, uint8_t& rank) {
+    uint8_t n = tmpl.fingersPerPattern;
+    int8_t slots[MAX_ACTUATORS];
+    uint8_t seen = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        slots[i] = mcV7FingerSlot(tmpl, events[i].finger);
+        if (slots[i] < 0 || (seen & (1u << slots[i]))) return false;
+        seen |= static_cast<uint8_t>(1u << slots[i]);
+    }
+    uint16_t r = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t smallerLater = 0;
+        for (uint8_t j = i + 1; j < n; j++) {
+            if (slots[j] < slots[i]) smallerLater++;
+        }
+        r = static_cast<uint16_t>(r + smallerLater * MC_FACTORIAL[n - 1 - i]);
+    }
+    rank = static_cast<uint8_t>(r);
+    return true;
+}
+
+static bool mcV7UnrankPattern(const MacrocycleTemplate& tmpl, uint8_t rank, uint8_t* fingersOut) {
+    uint8_t n = tmpl.fingersPerPattern;
+    if (rank >= MC_FACTORIAL[n]) return false;
+    uint8_t pool[MAX_ACTUATORS];
+    memcpy(pool, tmpl.fingers, n);
+    uint8_t remaining = n;
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t f = MC_FACTORIAL[n - 1 - i];
+        uint8_t idx = static_cast<uint8_t>(rank / f);
+        rank = static_cast<uint8_t>(rank % f);
+        fingersOut[i] = pool[idx];
+        for (uint8_t j = idx; j + 1 < remaining; j++) pool[j] = pool[j + 1];
+        remaining--;
+    }
+    return true;
+}
+
+uint8_t SyncCommand::getMacrocycleFrameKind(const char* message, size_t messageLen) {
+    if (!message || messageLen < 3 || strncmp(message, "MC:", 3) != 0) {
+        return MACROCYCLE_FRAME_INVALID;
+    }
+    if (messageLen <= MC_V6_PREFIX_SIZE || static_cast<uint8_t>(message[3]) != MACROCYCLE_WIRE_V7) {
+        return MACROCYCLE_FRAME_FULL;
+    }
+    uint8_t b = static_cast<uint8_t>(message[MC_V6_PREFIX_SIZE]);
+    if (b == MC_V6_ESCAPE) {
+        if (messageLen <= MC_V6_PREFIX_SIZE + 1) return MACROCYCLE_FRAME_INVALID;
+        b = static_cast<uint8_t>(message[MC_V6_PREFIX_SIZE + 1]) ^ MC_V6_ESCAPE_XOR;
+    }
+    uint8_t kind = b ^ MC_V6_WHITEN;
+    switch (kind) {
+        case MACROCYCLE_FRAME_TEMPLATE:
+        case MACROCYCLE_FRAME_DELTA:
+        case MACROCYCLE_FRAME_SESSION:
+        case MACROCYCLE_FRAME_TICK:
+            return kind;
+        default:
+            return MACROCYCLE_FRAME_INVALID;
+    }
+}
+
+bool SyncCommand::buildMacrocycleTemplate(const Macrocycle& macrocycle, uint16_t spacingMs,
+                                          MacrocycleTemplate& tmpl) {
+    uint8_t count = macrocycle.eventCount;
+    if (count == 0 || count > MACROCYCLE_MAX_EVENTS || macrocycle.events[0].deltaTimeMs != 0) {
+        return false;
+    }
+
+    // Pattern length = events until the first repeated finger
+    uint8_t n = 0;
+    uint8_t seen = 0;
+    while (n < count && n < MAX_ACTUATORS) {
+        uint8_t finger = macrocycle.events[n].finger;
+        if (finger >= MAX_ACTUATORS || (seen & (1u << finger))) break;
+        seen |= static_cast<uint8_t>(1u << finger);
+        n++;
+    }
+    if (n == 0 || (count % n) != 0) {
+        return false;
+    }
+
+    tmpl.durationMs = macrocycle.durationMs;
+    tmpl.spacingMs = spacingMs;
+    tmpl.amplitude = macrocycle.events[0].amplitude;
+    tmpl.freqOffset = macrocycle.events[0].freqOffset;
+    tmpl.patternCount = static_cast<uint8_t>(count / n);
+    tmpl.fingersPerPattern = n;
+    uint8_t slot = 0;
+    for (uint8_t finger = 0; finger < MAX_ACTUATORS; finger++) {
+        if (seen & (1u << finger)) tmpl.fingers[slot++] = finger;
+    }
+
+    // Every later pattern must permute the same set
+    for (uint8_t p = 1; p < tmpl.patternCount; p++) {
+        uint8_t rank;
+        if (!mcV7RankPattern(tmpl, &macrocycle.events[p * n], rank)) return false;
+    }
+    return true;
+}
+
+bool SyncCommand::serializeMacrocycleTemplate(char* buffer, size_t bufferSize, const MacrocycleTemplate& tmpl) {
+    if (!buffer || tmpl.fingersPerPattern == 0 || tmpl.fingersPerPattern > MAX_ACTUATORS) {
+        return false;
+    }
+    size_t pos = 0;
+    bool ok = mcV7PutHeader(buffer, bufferSize, pos, MACROCYCLE_FRAME_TEMPLATE) &&
+              mcV6PutLE(buffer, bufferSize, pos, tmpl.durationMs, 2) &&
+              mcV6PutLE(buffer, bufferSize, pos, tmpl.spacingMs, 2) &&
+              mcV6PutByte(buffer, bufferSize, pos, tmpl.amplitude) &&
+              mcV6PutByte(buffer, bufferSize, pos, tmpl.freqOffset) &&
+              mcV6PutByte(buffer, bufferSize, pos, tmpl.patternCount) &&
+              mcV6PutByte(buffer, bufferSize, pos, tmpl.fingersPerPattern);
+    for (uint8_t i = 0; ok && i < tmpl.fingersPerPattern; i++) {
+        ok = mcV6PutByte(buffer, bufferSize, pos, tmpl.fingers[i]);
+    }
+    return mcV7Finish(buffer, pos, ok);
+}
+
+bool SyncCommand::deserializeMacrocycleTemplate(const char* message, size_t messageLen, MacrocycleTemplate& tmpl) {
+    if (getMacrocycleFrameKind(message, messageLen) != MACROCYCLE_FRAME_TEMPLATE) {
+        return false;
+    }
+    uint8_t body[MC_V7_TEMPLATE_HEADER + MAX_ACTUATORS];
+    size_t bodyLen = 0;
+    if (!mcV6Unescape(message, messageLen, body, sizeof(body), bodyLen) || bodyLen < MC_V7_TEMPLATE_HEADER) {
+        return false;
+    }
+
+    uint8_t n = body[8];
+    if (n == 0 || n > MAX_ACTUATORS || bodyLen != MC_V7_TEMPLATE_HEADER + n) {
+        return false;
+    }
+    uint8_t patterns = body[7];
+    if (patterns == 0 || patterns * n > MACROCYCLE_MAX_EVENTS) {
+        return false;
+    }
+
+    MacrocycleTemplate parsed;
+    parsed.durationMs = static_cast<uint16_t>(mcV6GetLE(&body[1], 2));
+    parsed.spacingMs = static_cast<uint16_t>(mcV6GetLE(&body[3], 2));
+    parsed.amplitude = body[5];
+    parsed.freqOffset = body[6];
+    parsed.patternCount = patterns;
+    parsed.fingersPerPattern = n;
+    for (uint8_t i = 0; i < n; i++) {
+        // Ascending and in range, so slots are unique
+        if (body[9 + i] >= MAX_ACTUATORS || (i > 0 && body[9 + i] <= body[8 + i])) return false;
+        parsed.fingers[i] = body[9 + i];
+    }
+    tmpl = parsed;
+    return true;
+}
+
+bool SyncCommand::serializeMacrocycleDelta(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                           const MacrocycleTemplate& tmpl, const MacrocycleReference& ref) {
+    if (!buffer) return false;
+
+    uint8_t n = tmpl.fingersPerPattern;
+    uint8_t count = macrocycle.eventCount;
+    if (n == 0 || count != tmpl.patternCount * n || macrocycle.durationMs != tmpl.durationMs ||
+        macrocycle.events[0].deltaTimeMs != 0) {
+        return false;
+    }
+
+    uint32_t refDistance = macrocycle.sequenceId - ref.sequenceId;
+    int64_t baseDelta = static_cast<int64_t>(macrocycle.baseTime - ref.baseTime);
+    int64_t offsetDelta = macrocycle.clockOffset - ref.clockOffset;
+    if (refDistance == 0 || refDistance > UINT8_MAX ||
+        baseDelta > INT32_MAX || baseDelta < INT32_MIN ||
+        offsetDelta > INT32_MAX || offsetDelta < INT32_MIN) {
+        return false;
+    }
+
+    uint8_t ranks[MACROCYCLE_MAX_EVENTS];
+    for (uint8_t p = 0; p < tmpl.patternCount; p++) {
+        if (!mcV7RankPattern(tmpl, &macrocycle.events[p * n], ranks[p])) return false;
+    }
+
+    uint8_t flags = 0;
+    int8_t deviations[MACROCYCLE_MAX_EVENTS];
+    for (uint8_t i = 0; i < count; i++) {
+        const MacrocycleEvent& evt = macrocycle.events[i];
+        if (evt.durationMs != tmpl.durationMs) return false;
+        if (evt.amplitude != tmpl.amplitude) flags |= MC_V7_FLAG_AMPLITUDE;
+        if (evt.freqOffset != tmpl.freqOffset) flags |= MC_V7_FLAG_FREQUENCY;
+        if (i + 1 < count) {
+            int32_t gap = static_cast<int32_t>(macrocycle.events[i + 1].deltaTimeMs) - evt.deltaTimeMs;
+            int32_t dev = gap - tmpl.spacingMs;
+            if (dev > INT8_MAX || dev < INT8_MIN) return false;
+            deviations[i] = static_cast<int8_t>(dev);
+            if (dev != 0) flags |= MC_V7_FLAG_JITTER;
+        }
+    }
+
+    size_t pos = 0;
+    bool ok = mcV7PutHeader(buffer, bufferSize, pos, MACROCYCLE_FRAME_DELTA) &&
+              mcV6PutLE(buffer, bufferSize, pos, macrocycle.sequenceId, 4) &&
+              mcV6PutByte(buffer, bufferSize, pos, static_cast<uint8_t>(refDistance)) &&
+              mcV6PutLE(buffer, bufferSize, pos, static_cast<uint32_t>(static_cast<int32_t>(baseDelta)), 4) &&
+              mcV6PutLE(buffer, bufferSize, pos, static_cast<uint32_t>(static_cast<int32_t>(offsetDelta)), 4) &&
+              mcV6PutByte(buffer, bufferSize, pos, flags);
+    for (uint8_t p = 0; ok && p < tmpl.patternCount; p++) {
+        ok = mcV6PutByte(buffer, bufferSize, pos, ranks[p]);
+    }
+    if (flags & MC_V7_FLAG_JITTER) {
+        for (uint8_t i = 0; ok && i + 1 < count; i++) {
+            ok = mcV6PutByte(buffer, bufferSize, pos, static_cast<uint8_t>(deviations[i]));
+        }
+    }
+    if (flags & MC_V7_FLAG_AMPLITUDE) {
+        for (uint8_t i = 0; ok && i < count; i++) {
+            ok = mcV6PutByte(buffer, bufferSize, pos, macrocycle.events[i].amplitude);
+        }
+    }
+    if (flags & MC_V7_FLAG_FREQUENCY) {
+        for (uint8_t i = 0; ok && i < count; i++) {
+            ok = mcV6PutByte(buffer, bufferSize, pos, macrocycle.events[i].freqOffset);
+        }
+    }
+    return mcV7Finish(buffer, pos, ok);
+}
+
+bool SyncCommand::getMacrocycleDeltaReference(const char* message, size_t messageLen, uint32_t& refSequenceId) {
+    if (getMacrocycleFrameKind(message, messageLen) != MACROCYCLE_FRAME_DELTA) {
+        return false;
+    }
+    uint8_t body[MC_V7_MAX_BODY];
+    size_t bodyLen = 0;
+    if (!mcV6Unescape(message, messageLen, body, sizeof(body), bodyLen) || bodyLen < MC_V7_DELTA_HEADER) {
+        return false;
+    }
+    refSequenceId = static_cast<uint32_t>(mcV6GetLE(&body[1], 4)) - body[5];
+    return true;
+}
+
+bool SyncCommand::deserializeMacrocycleDelta(const char* message, size_t messageLen,
+                                             const MacrocycleTemplate& tmpl, const MacrocycleReference& ref,
+                                             Macrocycle& macrocycle) {
+    if (getMacrocycleFrameKind(message, messageLen) != MACROCYCLE_FRAME_DELTA) {
+        return false;
+    }
+    uint8_t body[MC_V7_MAX_BODY];
+    size_t bodyLen = 0;
+    if (!mcV6Unescape(message, messageLen, body, sizeof(body), bodyLen) || bodyLen < MC_V7_DELTA_HEADER) {
+        return false;
+    }
+
+    uint8_t n = tmpl.fingersPerPattern;
+    uint8_t count = static_cast<uint8_t>(tmpl.patternCount * n);
+    if (n == 0 || count == 0 || count > MACROCYCLE_MAX_EVENTS) {
+        return false;
+    }
+
+    uint32_t seq = static_cast<uint32_t>(mcV6GetLE(&body[1], 4));
+    if (seq - body[5] != ref.sequenceId) {
+        return false;
+    }
+    uint8_t flags = body[14];
+
+    // Length-exact, like V6
+    size_t expected = MC_V7_DELTA_HEADER + tmpl.patternCount;
+    if (flags & MC_V7_FLAG_JITTER) expected += count - 1;
+    if (flags & MC_V7_FLAG_AMPLITUDE) expected += count;
+    if (flags & MC_V7_FLAG_FREQUENCY) expected += count;
+    if (bodyLen != expected) {
+        return false;
+    }
+
+    int32_t baseDelta = static_cast<int32_t>(mcV6GetLE(&body[6], 4));
+    int32_t offsetDelta = static_cast<int32_t>(mcV6GetLE(&body[10], 4));
+
+    const uint8_t* cursor = &body[MC_V7_DELTA_HEADER + tmpl.patternCount];
+    const uint8_t* deviations = nullptr;
+    const uint8_t* amplitudes = nullptr;
+    const uint8_t* frequencies = nullptr;
+    if (flags & MC_V7_FLAG_JITTER) { deviations = cursor; cursor += count - 1; }
+    if (flags & MC_V7_FLAG_AMPLITUDE) { amplitudes = cursor; cursor += count; }
+    if (flags & MC_V7_FLAG_FREQUENCY) { frequencies = cursor; }
+
+    macrocycle.sequenceId = seq;
+    macrocycle.baseTime = ref.baseTime + static_cast<int64_t>(baseDelta);
+    macrocycle.clockOffset = ref.clockOffset + offsetDelta;
+    macrocycle.durationMs = tmpl.durationMs;
+    macrocycle.eventCount = count;
+
+    uint32_t deltaMs = 0;
+    for (uint8_t p = 0; p < tmpl.patternCount; p++) {
+        uint8_t fingers[MAX_ACTUATORS];
+        if (!mcV7UnrankPattern(tmpl, body[MC_V7_DELTA_HEADER + p], fingers)) {
+            return false;
+        }
+        for (uint8_t k = 0; k < n; k++) {
+            uint8_t i = static_cast<uint8_t>(p * n + k);
+            if (i > 0) {
+                int32_t dev = deviations ? static_cast<int8_t>(deviations[i - 1]) : 0;
+                int32_t next = static_cast<int32_t>(deltaMs) + tmpl.spacingMs + dev;
+                if (next < 0 || next > UINT16_MAX) return false;
+                deltaMs = static_cast<uint32_t>(next);
+            }
+            MacrocycleEvent& evt = macrocycle.events[i];
+            evt.deltaTimeMs = static_cast<uint16_t>(deltaMs);
+            evt.finger = fingers[k];
+            evt.amplitude = amplitudes ? amplitudes[i] : tmpl.amplitude;
+            evt.freqOffset = frequencies ? frequencies[i] : tmpl.freqOffset;
+            evt.durationMs = tmpl.durationMs;
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// MACROCYCLE V7 SEEDED SESSION + TICK FRAMES
+// =============================================================================
+
+static constexpr size_t MC_V7_SESSION_HEADER = 28;   // kind through fingerMapCount
+static constexpr size_t MC_V7_SESSION_FINGER = 3;    // finger + baseFrequencyHz
+static constexpr size_t MC_V7_TICK_SIZE = 25;        // kind + seed + seq + base + offset
+
+bool SyncCommand::serializeSeededSession(char* buffer, size_t bufferSize, const SeededSessionParams& params) {
+    if (!buffer || params.fingerMapCount > MAX_ACTUATORS) {
+        return false;
+    }
+    size_t pos = 0;
+    bool ok = mcV7PutHeader(buffer, bufferSize, pos, MACROCYCLE_FRAME_SESSION) &&
+              mcV6PutLE(buffer, bufferSize, pos, params.seed, 4) &&
+              mcV6PutByte(buffer, bufferSize, pos, params.patternType) &&
+              mcV6PutByte(buffer, bufferSize, pos, params.numFingers) &&
+              mcV6PutByte(buffer, bufferSize, pos, params.mirrorPattern ? 1 : 0) &&
+              mcV6PutByte(buffer, bufferSize, pos, params.amplitudeMin) &&
+              mcV6PutByte(buffer, bufferSize, pos, params.amplitudeMax) &&
+              mcV6PutByte(buffer, bufferSize, pos, params.frequencyRandomization ? 1 : 0) &&
+              mcV6PutLE(buffer, bufferSize, pos, params.frequencyMinHz, 2) &&
+              mcV6PutLE(buffer, bufferSize, pos, params.frequencyMaxHz, 2) &&
+              mcV6PutLE(buffer, bufferSize, pos, params.timing.timeOnUs, 4) &&
+              mcV6PutLE(buffer, bufferSize, pos, params.timing.timeOffUs, 4) &&
+              mcV6PutLE(buffer, bufferSize, pos, params.timing.jitterQ16, 4) &&
+              mcV6PutByte(buffer, bufferSize, pos, params.fingerMapCount);
+    for (uint8_t i = 0; ok && i < params.fingerMapCount; i++) {
+        uint8_t finger = params.fingerMap[i];
+        ok = finger < MAX_ACTUATORS &&
+             mcV6PutByte(buffer, bufferSize, pos, finger) &&
+             mcV6PutLE(buffer, bufferSize, pos, params.baseFrequencyHz[finger], 2);
+    }
+    return mcV7Finish(buffer, pos, ok);
+}
+
+bool SyncCommand::deserializeSeededSession(const char* message, size_t messageLen, SeededSessionParams& params) {
+    if (getMacrocycleFrameKind(message, messageLen) != MACROCYCLE_FRAME_SESSION) {
+        return false;
+    }
+    uint8_t body[MC_V7_SESSION_HEADER + MAX_ACTUATORS * MC_V7_SESSION_FINGER];
+    size_t bodyLen = 0;
+    if (!mcV6Unescape(message, messageLen, body, sizeof(body), bodyLen) || bodyLen < MC_V7_SESSION_HEADER) {
+        return false;
+    }
+    uint8_t count = body[27];
+    if (count > MAX_ACTUATORS || bodyLen != MC_V7_SESSION_HEADER + count * MC_V7_SESSION_FINGER) {
+        return false;
+    }
+
+    SeededSessionParams parsed;
+    parsed.seed = static_cast<uint32_t>(mcV6GetLE(&body[1], 4));
+    parsed.patternType = body[5];
+    parsed.numFingers = body[6];
+    parsed.mirrorPattern = body[7] != 0;
+    parsed.amplitudeMin = body[8];
+    parsed.amplitudeMax = body[9];
+    parsed.frequencyRandomization = body[10] != 0;
+    parsed.frequencyMinHz = static_cast<uint16_t>(mcV6GetLE(&body[11], 2));
+    parsed.frequencyMaxHz = static_cast<uint16_t>(mcV6GetLE(&body[13], 2));
+    parsed.timing.timeOnUs = static_cast<uint32_t>(mcV6GetLE(&body[15], 4));
+    parsed.timing.timeOffUs = static_cast<uint32_t>(mcV6GetLE(&body[19], 4));
+    parsed.timing.jitterQ16 = static_cast<uint32_t>(mcV6GetLE(&body[23], 4));
+    parsed.fingerMapCount = count;
+    for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+        parsed.baseFrequencyHz[i] = 250;  // Unmapped fingers never play
+    }
+    const uint8_t* entry = &body[MC_V7_SESSION_HEADER];
+    for (uint8_t i = 0; i < count; i++, entry += MC_V7_SESSION_FINGER) {
+        if (entry[0] >= MAX_ACTUATORS) return false;
+        parsed.fingerMap[i] = entry[0];
+        parsed.baseFrequencyHz[entry[0]] = static_cast<uint16_t>(mcV6GetLE(&entry[1], 2));
+    }
+    params = parsed;
+    return true;
+}
+
+bool SyncCommand::serializeMacrocycleTick(char* buffer, size_t bufferSize, uint32_t seed,
+                                          const MacrocycleReference& tick) {
+    if (!buffer) return false;
+    size_t pos = 0;
+    bool ok = mcV7PutHeader(buffer, bufferSize, pos, MACROCYCLE_FRAME_TICK) &&
+              mcV6PutLE(buffer, bufferSize, pos, seed, 4) &&
+              mcV6PutLE(buffer, bufferSize, pos, tick.sequenceId, 4) &&
+              mcV6PutLE(buffer, bufferSize, pos, tick.baseTime, 8) &&
+              mcV6PutLE(buffer, bufferSize, pos, static_cast<uint64_t>(tick.clockOffset), 8);
+    return mcV7Finish(buffer, pos, ok);
+}
+
+bool SyncCommand::deserializeMacrocycleTick(const char* message, size_t messageLen, uint32_t& seed,
+                                            MacrocycleReference& tick) {
+    if (getMacrocycleFrameKind(message, messageLen) != MACROCYCLE_FRAME_TICK) {
+        return false;
+    }
+    uint8_t body[MC_V7_TICK_SIZE];
+    size_t bodyLen = 0;
+    if (!mcV6Unescape(message, messageLen, body, sizeof(body), bodyLen) || bodyLen != MC_V7_TICK_SIZE) {
+        return false;
+    }
+    seed = static_cast<uint32_t>(mcV6GetLE(&body[1], 4));
+    tick.sequenceId = static_cast<uint32_t>(mcV6GetLE(&body[5], 4));
+    tick.baseTime = mcV6GetLE(&body[9], 8);
+    tick.clockOffset = static_cast<int64_t>(mcV6GetLE(&body[17], 8));
+    return true;
+}
+
+// =============================================================================
+// MACROCYCLE REFERENCE HISTORY
+// =============================================================================
+
+void MacrocycleReferenceHistory::record(const Macrocycle& macrocycle) {
+    MacrocycleReference& entry = _entries[_next];
+    entry.sequenceId = macrocycle.sequenceId;
+    entry.baseTime = macrocycle.baseTime;
+    entry.clockOffset = macrocycle.clockOffset;
+    _next = static_cast<uint8_t>((_next + 1) % SIZE);
+    if (_count < SIZE) _count++;
+}
+
+bool MacrocycleReferenceHistory::find(uint32_t sequenceId, MacrocycleReference& ref) const {
+    return findNewestInRange(sequenceId, sequenceId, ref);
+}
+
+bool MacrocycleReferenceHistory::findNewestInRange(uint32_t minSequenceId, uint32_t maxSequenceId,
+                                                   MacrocycleReference& ref) const {
+    // Walk newest to oldest; wrap-safe range check relative to minSequenceId
+    uint32_t span = maxSequenceId - minSequenceId;
+    for (uint8_t k = 0; k < _count; k++) {
+        uint8_t idx = static_cast<uint8_t>((_next + SIZE - 1 - k) % SIZE);
+        if (_entries[idx].sequenceId - minSequenceId <= span) {
+            ref = _entries[idx];
+            return true;
+        }
+    }
+    return false;
+}
+
 // Milliseconds derived from the sync timebase. Using getMicros()/1000 instead
 // of millis() keeps drift-rate math in a single clock domain (HFXO) - millis()
 // is LFXO/tick-derived and differs by up to ~40ppm, the same magnitude as the
@@ -755,6 +1598,18 @@ static inline uint32_t syncNowMs() {
     return static_cast<uint32_t>(getMicros() / 1000ULL);
 }
 
+// Drift limits and EMA weight in Q16 (see DRIFT_RATE_Q16_ONE)
+static constexpr int32_t MAX_DRIFT_RATE_Q16 = driftRateToQ16(SYNC_MAX_DRIFT_RATE_US_PER_MS);
+static constexpr int32_t MAX_APPLIED_DRIFT_RATE_Q16 = driftRateToQ16(SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS);
+static constexpr int32_t DRIFT_EMA_ALPHA_Q16 = driftRateToQ16(SYNC_DRIFT_EMA_ALPHA);
+
+// Drift accumulated over elapsedMs at the capped (±100 ppm) rate
+static inline int64_t appliedDriftUs(int32_t rateQ16, uint32_t elapsedMs) {
+    if (rateQ16 > MAX_APPLIED_DRIFT_RATE_Q16) rateQ16 = MAX_APPLIED_DRIFT_RATE_Q16;
+    if (rateQ16 < -MAX_APPLIED_DRIFT_RATE_Q16) rateQ16 = -MAX_APPLIED_DRIFT_RATE_Q16;
+    return static_cast<int64_t>(rateQ16) * elapsedMs / DRIFT_RATE_Q16_ONE;
+}
+
 // =============================================================================
 // SIMPLE SYNC PROTOCOL - IMPLEMENTATION
 // =============================================================================
@@ -770,9 +1625,10 @@ SimpleSyncProtocol::SimpleSyncProtocol() :
     _offsetSampleCount(0),
     _medianOffset(0),
     _clockSyncValid(false),
+    _requiredSamples(SYNC_MIN_VALID_SAMPLES),
     _lastMeasuredOffset(0),
     _lastOffsetTime(0),
-    _driftRateUsPerMs(0.0f),
+    _driftRateQ16(0),
     _driftAnchorOffset(0),
     _driftAnchorTime(0),
     _minRttUs(UINT32_MAX), _innovationRejects(0),
@@ -785,6 +1641,7 @@ SimpleSyncProtocol::SimpleSyncProtocol() :
     _phoneConnectedDuringSync(false)
 {
     memset(_offsetSamples, 0, sizeof(_offsetSamples));
+    memset(_sortedOffsets, 0, sizeof(_sortedOffsets));
     // _warmStartCache initialized by struct default constructor
 }
 
@@ -838,7 +1695,38 @@ int64_t SimpleSyncProtocol::calculatePTPOffset(uint64_t t1, uint64_t t2, uint64_
     return offset;
 }
 
+// Median of an ascending run (even count: mean of the middle pair)
+static int64_t sortedMedian(const int64_t* sorted, uint8_t count) {
+    if (count % 2 == 0) {
+        uint8_t mid = count / 2;
+        return (sorted[mid - 1] + sorted[mid]) / 2;
+    }
+    return sorted[count / 2];
+}
+
 void SimpleSyncProtocol::addOffsetSample(int64_t offset) {
+    // The sorted window holds the same samples as the circular buffer in
+    // ascending order: evict the overwritten sample, then insertion-step the
+    // new one in. O(window) moves per sample, no copy and no sort.
+    uint8_t n = _offsetSampleCount;
+    if (n == OFFSET_SAMPLE_COUNT) {
+        int64_t evicted = _offsetSamples[_offsetSampleIndex];
+        uint8_t pos = 0;
+        while (pos < n - 1 && _sortedOffsets[pos] != evicted) {
+            pos++;
+        }
+        for (; pos < n - 1; pos++) {
+            _sortedOffsets[pos] = _sortedOffsets[pos + 1];
+        }
+        n--;
+    }
+    uint8_t slot = n;
+    while (slot > 0 && _sortedOffsets[slot - 1] > offset) {
+        _sortedOffsets[slot] = _sortedOffsets[slot - 1];
+        slot--;
+    }
+    _sortedOffsets[slot] = offset;
+
     // Add sample to circular buffer
     _offsetSamples[_offsetSampleIndex] = offset;
     _offsetSampleIndex = static_cast<uint8_t>((_offsetSampleIndex + 1) % OFFSET_SAMPLE_COUNT);
@@ -873,95 +1761,61 @@ void SimpleSyncProtocol::addOffsetSample(int64_t offset) {
     }
 
     // Compute median when we have enough samples
-    if (_offsetSampleCount >= SYNC_MIN_VALID_SAMPLES) {
-        // Outlier rejection using MAD (Median Absolute Deviation)
-        // Step 1: Compute preliminary median from all samples
-        int64_t sorted[OFFSET_SAMPLE_COUNT];
-        for (uint8_t i = 0; i < _offsetSampleCount; i++) {
-            sorted[i] = _offsetSamples[i];
-        }
-
-        // Simple insertion sort (small array, O(n^2) is fine)
-        for (uint8_t i = 1; i < _offsetSampleCount; i++) {
-            int64_t key = sorted[i];
-            int8_t j = static_cast<int8_t>(i - 1);
-            while (j >= 0 && sorted[j] > key) {
-                sorted[j + 1] = sorted[j];
-                j--;
-            }
-            sorted[j + 1] = key;
-        }
+    if (_offsetSampleCount >= _requiredSamples) {
+        const int64_t* sorted = _sortedOffsets;
+        uint8_t count = _offsetSampleCount;
 
-        // Get preliminary median
-        int64_t prelimMedian;
-        if (_offsetSampleCount % 2 == 0) {
-            uint8_t mid = _offsetSampleCount / 2;
-            prelimMedian = (sorted[mid - 1] + sorted[mid]) / 2;
-        } else {
-            prelimMedian = sorted[_offsetSampleCount / 2];
-        }
+        // Outlier rejection using MAD (Median Absolute Deviation)
+        // Step 1: Preliminary median of the whole (already sorted) window
+        int64_t prelimMedian = sortedMedian(sorted, count);
 
         // Step 2: Compute Median Absolute Deviation (MAD) for adaptive outlier threshold
-        // MAD is a robust measure of variability, less sensitive to outliers than std dev
-        int64_t deviations[OFFSET_SAMPLE_COUNT];
-        for (uint8_t i = 0; i < _offsetSampleCount; i++) {
-            deviations[i] = _offsetSamples[i] - prelimMedian;
-            if (deviations[i] < 0) deviations[i] = -deviations[i];  // abs()
+        // MAD is a robust measure of variability, less sensitive to outliers than std dev.
+        // Deviations grow walking outward from the median in both directions,
+        // so merging the two walks visits them in ascending order.
+        uint8_t right = 0;
+        while (right < count && sorted[right] < prelimMedian) {
+            right++;
         }
-
-        // Sort deviations to find MAD (median of absolute deviations)
-        for (uint8_t i = 1; i < _offsetSampleCount; i++) {
-            int64_t key = deviations[i];
-            int8_t j = static_cast<int8_t>(i - 1);
-            while (j >= 0 && deviations[j] > key) {
-                deviations[j + 1] = deviations[j];
-                j--;
+        int16_t left = static_cast<int16_t>(right) - 1;
+
+        int64_t prevDeviation = 0;
+        int64_t deviation = 0;
+        for (uint8_t rank = 0; rank <= count / 2; rank++) {
+            prevDeviation = deviation;
+            int64_t leftDev = (left >= 0) ? prelimMedian - sorted[left] : INT64_MAX;
+            int64_t rightDev = (right < count) ? sorted[right] - prelimMedian : INT64_MAX;
+            if (leftDev <= rightDev) {
+                deviation = leftDev;
+                left--;
+            } else {
+                deviation = rightDev;
+                right++;
             }
-            deviations[j + 1] = key;
         }
-        int64_t mad = (_offsetSampleCount % 2 == 1)
-            ? deviations[_offsetSampleCount / 2]
-            : (deviations[_offsetSampleCount / 2 - 1] + deviations[_offsetSampleCount / 2]) / 2;
+        int64_t mad = (count % 2 == 1) ? deviation : (prevDeviation + deviation) / 2;
 
         // Step 3: Filter outliers using adaptive threshold (3*MAD or config minimum)
-        // This removes samples affected by BLE retransmissions or interference
+        // This removes samples affected by BLE retransmissions or interference.
+        // In a sorted window the survivors are one contiguous run.
         int64_t outlierThreshold = mad * 3;
         if (outlierThreshold < static_cast<int64_t>(SYNC_OUTLIER_THRESHOLD_US)) {
             outlierThreshold = static_cast<int64_t>(SYNC_OUTLIER_THRESHOLD_US);
         }
 
-        int64_t filtered[OFFSET_SAMPLE_COUNT];
-        uint8_t filteredCount = 0;
-
-        for (uint8_t i = 0; i < _offsetSampleCount; i++) {
-            int64_t deviation = _offsetSamples[i] - prelimMedian;
-            if (deviation < 0) deviation = -deviation;  // abs()
-
-            if (deviation <= outlierThreshold) {
-                filtered[filteredCount++] = _offsetSamples[i];
-            }
+        uint8_t first = 0;
+        while (first < count && prelimMedian - sorted[first] > outlierThreshold) {
+            first++;
+        }
+        uint8_t end = count;
+        while (end > first && sorted[end - 1] - prelimMedian > outlierThreshold) {
+            end--;
         }
+        uint8_t filteredCount = static_cast<uint8_t>(end - first);
 
         // Step 4: Compute final median from filtered samples
-        if (filteredCount >= SYNC_MIN_VALID_SAMPLES) {
-            // Sort filtered samples
-            for (uint8_t i = 1; i < filteredCount; i++) {
-                int64_t key = filtered[i];
-                int8_t j = static_cast<int8_t>(i - 1);
-                while (j >= 0 && filtered[j] > key) {
-                    filtered[j + 1] = filtered[j];
-                    j--;
-                }
-                filtered[j + 1] = key;
-            }
-
-            // Get final median from filtered samples
-            if (filteredCount % 2 == 0) {
-                uint8_t mid = filteredCount / 2;
-                _medianOffset = (filtered[mid - 1] + filtered[mid]) / 2;
-            } else {
-                _medianOffset = filtered[filteredCount / 2];
-            }
+        if (filteredCount >= _requiredSamples) {
+            _medianOffset = sortedMedian(sorted + first, filteredCount);
         } else {
             // Not enough non-outlier samples, use preliminary median
             _medianOffset = prelimMedian;
@@ -999,19 +1853,20 @@ void SimpleSyncProtocol::updateOffsetEMA(int64_t offset) {
         uint32_t elapsed = now - _driftAnchorTime;
         if (elapsed >= SYNC_MIN_DRIFT_INTERVAL_MS) {
             int64_t delta = offset - _driftAnchorOffset;
-            float newRate = (float)delta / (float)elapsed;  // μs per ms
+            int64_t newRate = delta * DRIFT_RATE_Q16_ONE / (int64_t)elapsed;  // Q16 μs per ms
 
             // Cap newRate before EMA smoothing to prevent outlier corruption
             // Extreme values from BLE retransmissions can corrupt the drift estimate
-            if (newRate > SYNC_MAX_DRIFT_RATE_US_PER_MS) {
-                newRate = SYNC_MAX_DRIFT_RATE_US_PER_MS;
+            if (newRate > MAX_DRIFT_RATE_Q16) {
+                newRate = MAX_DRIFT_RATE_Q16;
             }
-            if (newRate < -SYNC_MAX_DRIFT_RATE_US_PER_MS) {
-                newRate = -SYNC_MAX_DRIFT_RATE_US_PER_MS;
+            if (newRate < -MAX_DRIFT_RATE_Q16) {
+                newRate = -MAX_DRIFT_RATE_Q16;
             }
 
             // EMA smooth the CAPPED drift rate (α = 0.3 for reasonable responsiveness)
-            _driftRateUsPerMs = SYNC_DRIFT_EMA_ALPHA * newRate + (1.0f - SYNC_DRIFT_EMA_ALPHA) * _driftRateUsPerMs;
+            _driftRateQ16 += static_cast<int32_t>((newRate - _driftRateQ16) * DRIFT_EMA_ALPHA_Q16 /
+                                                  DRIFT_RATE_Q16_ONE);
 
             _driftAnchorOffset = offset;
             _driftAnchorTime = now;
@@ -1035,7 +1890,7 @@ void SimpleSyncProtocol::updateOffsetEMA(int64_t offset) {
 
     // Update warm-start cache with current state (for quick recovery after disconnect)
     _warmStartCache.cachedOffset = _medianOffset;
-    _warmStartCache.cachedDriftRate = _driftRateUsPerMs;
+    _warmStartCache.cachedDriftRateQ16 = _driftRateQ16;
     _warmStartCache.cacheTimestamp = now;  // FIXED: Use same timestamp for consistency
     _warmStartCache.isValid = true;
 }
@@ -1059,11 +1914,7 @@ int64_t SimpleSyncProtocol::getCorrectedOffset() const {
         // SAFETY: Cap drift rate to reasonable bounds (±100 ppm = ±0.1 µs/ms)
         // Crystal oscillators typically drift ±20-50 ppm
         // Anything larger indicates bad measurements
-        float cappedDriftRate = _driftRateUsPerMs;
-        if (cappedDriftRate > SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS) cappedDriftRate = SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS;
-        if (cappedDriftRate < -SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS) cappedDriftRate = -SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS;
-
-        int64_t driftCorrection = (int64_t)(cappedDriftRate * (float)elapsed);
+        int64_t driftCorrection = appliedDriftUs(_driftRateQ16, elapsed);
 
         // Note: Offset can be large when devices boot at different times
         // The MACROCYCLE handler validates ±30 second reasonableness
@@ -1078,18 +1929,23 @@ int64_t SimpleSyncProtocol::getCorrectedOffset() const {
 
 void SimpleSyncProtocol::resetClockSync() {
     memset(_offsetSamples, 0, sizeof(_offsetSamples));
+    memset(_sortedOffsets, 0, sizeof(_sortedOffsets));
     _offsetSampleIndex = 0;
     _offsetSampleCount = 0;
     _medianOffset = 0;
     _clockSyncValid = false;
+    _requiredSamples = SYNC_MIN_VALID_SAMPLES;
     _lastMeasuredOffset = 0;
     _lastOffsetTime = 0;
-    _driftRateUsPerMs = 0.0f;
+    _driftRateQ16 = 0;
     _driftAnchorOffset = 0;
     _driftAnchorTime = 0;
 
     _innovationRejects = 0;
     _minRttUs = UINT32_MAX;
+#if SYNC_CLOCK_SERVO_ENABLED
+    _servo.reset();
+#endif
 
     // Reset warm-start mode but PRESERVE cache
     // Cache is only cleared by invalidateWarmStartCache() or expiration
@@ -1126,9 +1982,13 @@ bool SimpleSyncProtocol::tryWarmStart() {
     _medianOffset = projected;
     _lastMeasuredOffset = projected;
     _lastOffsetTime = syncNowMs();
-    _driftRateUsPerMs = _warmStartCache.cachedDriftRate;
+    _driftRateQ16 = _warmStartCache.cachedDriftRateQ16;
     _driftAnchorOffset = projected;
     _driftAnchorTime = syncNowMs();
+#if SYNC_CLOCK_SERVO_ENABLED
+    // Projection error is bounded by the confirmation tolerance
+    _servo.seed(projected, getDriftRate(), SYNC_WARM_START_TOLERANCE_US * 0.5f, syncNowMs());
+#endif
 
     return true;
 }
@@ -1145,25 +2005,23 @@ int64_t SimpleSyncProtocol::getProjectedOffset() const {
         elapsed = SYNC_WARM_START_VALIDITY_MS;
     }
 
-    // Cap drift rate for safety (100 ppm max = ±0.1 µs/ms)
-    float cappedDriftRate = _warmStartCache.cachedDriftRate;
-    if (cappedDriftRate > SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS) cappedDriftRate = SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS;
-    if (cappedDriftRate < -SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS) cappedDriftRate = -SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS;
-
-    int64_t driftCorrection = (int64_t)(cappedDriftRate * (float)elapsed);
-    return _warmStartCache.cachedOffset + driftCorrection;
+    // Drift rate capped for safety (100 ppm max = ±0.1 µs/ms)
+    return _warmStartCache.cachedOffset + appliedDriftUs(_warmStartCache.cachedDriftRateQ16, elapsed);
 }
 
 void SimpleSyncProtocol::invalidateWarmStartCache() {
     _warmStartCache.isValid = false;
     _warmStartCache.cachedOffset = 0;
-    _warmStartCache.cachedDriftRate = 0.0f;
+    _warmStartCache.cachedDriftRateQ16 = 0;
     _warmStartCache.cacheTimestamp = 0;
     _warmStartMode = false;
     _warmStartConfirmed = 0;
 }
 
 bool SimpleSyncProtocol::addOffsetSampleWithQuality(int64_t offset, uint32_t rttUs) {
+#if SYNC_CLOCK_SERVO_ENABLED
+    return applyServoSample(offset, rttUs);
+#endif
     // Reject samples with excessive RTT - these likely have asymmetric delays
     // due to retransmissions, connection event misalignment, or radio interference
     if (rttUs > SYNC_RTT_QUALITY_THRESHOLD_US) {
@@ -1177,6 +2035,9 @@ bool SimpleSyncProtocol::addOffsetSampleWithQuality(int64_t offset, uint32_t rtt
 }
 
 bool SimpleSyncProtocol::updateOffsetEMAWithQuality(int64_t offset, uint32_t rttUs) {
+#if SYNC_CLOCK_SERVO_ENABLED
+    return applyServoSample(offset, rttUs);
+#endif
     if (!_clockSyncValid) {
         // Still converging - use the initial sample-collection path
         return addOffsetSampleWithQuality(offset, rttUs);
@@ -1230,6 +2091,86 @@ bool SimpleSyncProtocol::updateOffsetEMAWithQuality(int64_t offset, uint32_t rtt
     return true;
 }
 
+#if SYNC_CLOCK_SERVO_ENABLED
+bool SimpleSyncProtocol::applyServoSample(int64_t offset, uint32_t rttUs) {
+    uint32_t now = syncNowMs();
+
+    // Warm start: the seeded prior stands until a sample contradicts it
+    if (_warmStartMode) {
+        int64_t deviation = offset - getProjectedOffset();
+        if (deviation < 0) deviation = -deviation;
+        if (deviation > SYNC_WARM_START_TOLERANCE_US) {
+            _warmStartMode = false;
+            _warmStartConfirmed = 0;
+            _warmStartCache.isValid = false;
+            _servo.reset();
+        }
+    }
+
+    if (!_servo.update(offset, rttUs, now)) {
+        return false;
+    }
+
+    _medianOffset = _servo.offset();
+    _driftRateQ16 = driftRateToQ16(_servo.skew());
+    _lastMeasuredOffset = offset;
+    _lastOffsetTime = now;
+    _lastSyncTime = now;
+    _minRttUs = _servo.minRtt();
+    uint16_t samples = _servo.sampleCount();
+    _offsetSampleCount = static_cast<uint8_t>(samples < OFFSET_SAMPLE_COUNT ? samples : OFFSET_SAMPLE_COUNT);
+
+    if (_warmStartMode) {
+        if (++_warmStartConfirmed >= SYNC_WARM_START_MIN_SAMPLES) {
+            _warmStartMode = false;
+            _clockSyncValid = true;
+        }
+    } else if (samples >= _requiredSamples) {
+        _clockSyncValid = true;
+    }
+
+    if (_clockSyncValid) {
+        _warmStartCache.cachedOffset = _medianOffset;
+        _warmStartCache.cachedDriftRateQ16 = _driftRateQ16;
+        _warmStartCache.cacheTimestamp = now;
+        _warmStartCache.isValid = true;
+    }
+    return true;
+}
+#endif
+
+float SimpleSyncProtocol::getDriftRateSigma() const {
+#if SYNC_CLOCK_SERVO_ENABLED
+    return _servo.skewSigma();
+#else
+    return SYNC_SKEW_CAL_SIGMA_US_PER_MS;
+#endif
+}
+
+void SimpleSyncProtocol::seedDriftRate(float skewUsPerMs, float sigmaUsPerMs) {
+    if (skewUsPerMs > SYNC_MAX_DRIFT_RATE_US_PER_MS) skewUsPerMs = SYNC_MAX_DRIFT_RATE_US_PER_MS;
+    if (skewUsPerMs < -SYNC_MAX_DRIFT_RATE_US_PER_MS) skewUsPerMs = -SYNC_MAX_DRIFT_RATE_US_PER_MS;
+    _driftRateQ16 = driftRateToQ16(skewUsPerMs);
+    _requiredSamples = SYNC_SKEW_CAL_MIN_SAMPLES;
+#if SYNC_CLOCK_SERVO_ENABLED
+    _servo.setSkewPrior(skewUsPerMs, sigmaUsPerMs);
+#else
+    (void)sigmaUsPerMs;
+#endif
+}
+
+uint32_t SimpleSyncProtocol::getOffsetUncertaintyUs() const {
+    if (!_clockSyncValid) {
+        return UINT32_MAX;
+    }
+#if SYNC_CLOCK_SERVO_ENABLED
+    return static_cast<uint32_t>(_servo.offsetSigma());
+#else
+    // Freshly reset latency stats (PHY/interval change) prove nothing yet
+    return (_sampleCount < MIN_SAMPLES) ? UINT32_MAX : _rttVariance;
+#endif
+}
+
 uint32_t SimpleSyncProtocol::calculateAdaptiveLeadTime() const {
     // If not enough samples, use conservative default
     if (_sampleCount < MIN_SAMPLES) {
@@ -1278,6 +2219,31 @@ uint32_t SimpleSyncProtocol::calculateAdaptiveLeadTime() const {
     return leadTime;
 }
 
+uint32_t SimpleSyncProtocol::calculateAnchoredLeadTime(uint32_t waitUs, uint32_t intervalUs) const {
+    if (_sampleCount < MIN_SAMPLES || intervalUs == 0) {
+        return calculateAdaptiveLeadTime();
+    }
+    if (waitUs > intervalUs) {
+        waitUs = intervalUs;
+    }
+
+    const uint32_t overhead = SYNC_PROCESSING_OVERHEAD_US + SYNC_GENERATION_OVERHEAD_US;
+    uint32_t leadTime = waitUs + SYNC_ANCHORED_LEAD_EVENTS * intervalUs + overhead;
+
+    // Measured one-way delivery (3-sigma) still wins when it is worse
+    uint32_t measured = _smoothedLatencyUs + _rttVariance * 3 + overhead;
+    if (measured > leadTime) {
+        leadTime = measured;
+    }
+
+    if (leadTime < SYNC_ANCHORED_MIN_LEAD_TIME_US) {
+        leadTime = SYNC_ANCHORED_MIN_LEAD_TIME_US;
+    } else if (leadTime > SYNC_MAX_LEAD_TIME_US) {
+        leadTime = SYNC_MAX_LEAD_TIME_US;
+    }
+    return leadTime;
+}
+
 // =============================================================================
 // PATH ASYMMETRY TRACKING - IMPLEMENTATION
 // =============================================================================
@@ -1324,3 +2290,31 @@ void SimpleSyncProtocol::resetAsymmetryTracking() {
     _asymmetrySampleCount = 0;
     _phoneConnectedDuringSync = false;
 }
+
+SimpleSyncProtocol::LinkStats SimpleSyncProtocol::getLinkStats() const {
+    LinkStats stats;
+    stats.smoothedLatencyUs = _smoothedLatencyUs;
+    stats.rttVarianceUs = _rttVariance;
+    stats.minRttUs = _minRttUs;
+    stats.sampleCount = _sampleCount;
+    stats.smoothedAsymmetryUs = _smoothedAsymmetry;
+    stats.asymmetryVarianceUs = _asymmetryVariance;
+    stats.asymmetrySampleCount = _asymmetrySampleCount;
+    return stats;
+}
+
+void SimpleSyncProtocol::restoreLinkStats(const LinkStats& stats) {
+    _measuredLatencyUs = stats.smoothedLatencyUs;
+    _smoothedLatencyUs = stats.smoothedLatencyUs;
+    _rttVariance = stats.rttVarianceUs;
+    _minRttUs = stats.minRttUs;
+    _sampleCount = stats.sampleCount;
+    _lastAsymmetry = stats.smoothedAsymmetryUs;
+    _smoothedAsymmetry = stats.smoothedAsymmetryUs;
+    _asymmetryVariance = stats.asymmetryVarianceUs;
+    _asymmetrySampleCount = stats.asymmetrySampleCount;
+#if SYNC_CLOCK_SERVO_ENABLED
+    // Measurement variance is excess RTT over this minimum
+    _servo.setMinRtt(stats.minRttUs);
+#endif
+}
@@ -7,6 +7,7 @@
 
 #include "therapy_engine.h"
 #include "sync_protocol.h"  // For getMicros() - overflow-safe 64-bit timestamp
+#include "perf_profile.h"
 #include <span>
 
 using namespace std::literals;
@@ -15,10 +16,10 @@ using namespace std::literals;
 // UTILITY FUNCTIONS
 // =============================================================================
 
-constexpr void shuffleArray(std::span<uint8_t> arr) {
+constexpr void shuffleArray(std::span<uint8_t> arr, PatternRng* rng) {
     // Fisher-Yates shuffle
     for (size_t i = arr.size() - 1; i > 0; i--) {
-        size_t const j = static_cast<size_t>(random(0, static_cast<long>(i + 1)));
+        size_t const j = static_cast<size_t>(patternRandom(rng, 0, static_cast<long>(i + 1)));
         std::swap(arr[i], arr[j]);
     }
 }
@@ -29,24 +30,22 @@ constexpr void shuffleArray(std::span<uint8_t> arr) {
 
 Pattern generateRandomPermutation(
     uint8_t numFingers,
-    float timeOnMs,
-    float timeOffMs,
-    float jitterPercent,
-    bool mirrorPattern
+    const TherapyTiming& timing,
+    bool mirrorPattern,
+    PatternRng* rng
 ) {
     Pattern pattern = Pattern(numFingers);
     pattern.numFingers = numFingers;
-    pattern.burstDurationMs = timeOnMs;
+    pattern.burstDurationUs = timing.timeOnUs;
 
     // TIME_RELAX = 4 * (time_on + time_off) - fixed interval between pattern cycles
-    float cycleDurationMs = timeOnMs + timeOffMs;
-    pattern.interBurstIntervalMs = 4.0f * cycleDurationMs;
+    pattern.interBurstIntervalUs = 4 * (timing.timeOnUs + timing.timeOffUs);
 
     // Generate PRIMARY device sequence (random permutation)
     for (uint8_t i = 0; i < numFingers; i++) {
         pattern.primarySequence[i] = i;
     }
-    shuffleArray(pattern.primarySequence);
+    shuffleArray(pattern.primarySequence, rng);
 
     // Generate SECONDARY device sequence based on mirror setting
     if (mirrorPattern) {
@@ -59,24 +58,16 @@ Pattern generateRandomPermutation(
         for (uint8_t i = 0; i < numFingers; i++) {
             pattern.secondarySequence[i] = i;
         }
-        shuffleArray(pattern.secondarySequence);
+        shuffleArray(pattern.secondarySequence, rng);
     }
 
-    // Calculate jitter amount per v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
+    // Jitter amount per v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
     // With 23.5% jitter: 167ms * 0.235 / 2 = 19.6ms
-    float jitterAmount = cycleDurationMs * (jitterPercent / 100.0f) / 2.0f;
-
-    // Apply jitter to TIME_OFF (67ms), NOT the inter-burst interval
+    // Applied to TIME_OFF (67ms), NOT the inter-burst interval
     // v1 behavior: TIME_OFF_actual = TIME_OFF ± jitter (range: 47-87ms with 23.5% jitter)
+    PatternTiming patternTiming = PatternTiming::from(timing);
     for (uint8_t i = 0; i < numFingers; i++) {
-        float offTime = timeOffMs;
-        if (jitterPercent > 0) {
-            // Add random jitter to TIME_OFF
-            float jitter = static_cast<float>(random(-1000, 1001)) / 1000.0f * jitterAmount;
-            offTime += jitter;
-            if (offTime < 0) offTime = 0;
-        }
-        pattern.timeOffMs[i] = offTime;
+        pattern.timeOffUs[i] = patternJitteredOffUs(patternTiming, rng);
     }
 
     return pattern;
@@ -84,19 +75,17 @@ Pattern generateRandomPermutation(
 
 Pattern generateSequentialPattern(
     uint8_t numFingers,
-    float timeOnMs,
-    float timeOffMs,
-    float jitterPercent,
+    const TherapyTiming& timing,
     bool mirrorPattern,
-    bool reverse
+    bool reverse,
+    PatternRng* rng
 ) {
     Pattern pattern = Pattern(numFingers);
     pattern.numFingers = numFingers;
-    pattern.burstDurationMs = timeOnMs;
+    pattern.burstDurationUs = timing.timeOnUs;
 
     // TIME_RELAX = 4 * (time_on + time_off) - fixed interval between pattern cycles
-    float cycleDurationMs = timeOnMs + timeOffMs;
-    pattern.interBurstIntervalMs = 4.0f * cycleDurationMs;
+    pattern.interBurstIntervalUs = 4 * (timing.timeOnUs + timing.timeOffUs);
 
     // Generate sequential list
     for (uint8_t i = 0; i < numFingers; i++) {
@@ -120,18 +109,10 @@ Pattern generateSequentialPattern(
         }
     }
 
-    // Calculate jitter amount per v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
-    float jitterAmount = cycleDurationMs * (jitterPercent / 100.0f) / 2.0f;
-
-    // Apply jitter to TIME_OFF, NOT the inter-burst interval
+    // Jitter per v1 formula, applied to TIME_OFF, NOT the inter-burst interval
+    PatternTiming patternTiming = PatternTiming::from(timing);
     for (uint8_t i = 0; i < numFingers; i++) {
-        float offTime = timeOffMs;
-        if (jitterPercent > 0) {
-            float jitter = static_cast<float>(random(-1000, 1001)) / 1000.0f * jitterAmount;
-            offTime += jitter;
-            if (offTime < 0) offTime = 0;
-        }
-        pattern.timeOffMs[i] = offTime;
+        pattern.timeOffUs[i] = patternJitteredOffUs(patternTiming, rng);
     }
 
     return pattern;
@@ -139,18 +120,16 @@ Pattern generateSequentialPattern(
 
 Pattern generateMirroredPattern(
     uint8_t numFingers,
-    float timeOnMs,
-    float timeOffMs,
-    float jitterPercent,
-    bool randomize
+    const TherapyTiming& timing,
+    bool randomize,
+    PatternRng* rng
 ) {
     Pattern pattern = Pattern(numFingers);
     pattern.numFingers = numFingers;
-    pattern.burstDurationMs = timeOnMs;
+    pattern.burstDurationUs = timing.timeOnUs;
 
     // TIME_RELAX = 4 * (time_on + time_off) - fixed interval between pattern cycles
-    float cycleDurationMs = timeOnMs + timeOffMs;
-    pattern.interBurstIntervalMs = 4.0f * cycleDurationMs;
+    pattern.interBurstIntervalUs = 4 * (timing.timeOnUs + timing.timeOffUs);
 
     // Generate base sequence
     for (uint8_t i = 0; i < numFingers; i++) {
@@ -158,7 +137,7 @@ Pattern generateMirroredPattern(
     }
 
     if (randomize) {
-        shuffleArray(pattern.primarySequence);
+        shuffleArray(pattern.primarySequence, rng);
     }
 
     // Mirror to both devices (identical sequences)
@@ -166,18 +145,10 @@ Pattern generateMirroredPattern(
         pattern.secondarySequence[i] = pattern.primarySequence[i];
     }
 
-    // Calculate jitter amount per v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
-    float jitterAmount = cycleDurationMs * (jitterPercent / 100.0f) / 2.0f;
-
-    // Apply jitter to TIME_OFF, NOT the inter-burst interval
+    // Jitter per v1 formula, applied to TIME_OFF, NOT the inter-burst interval
+    PatternTiming patternTiming = PatternTiming::from(timing);
     for (uint8_t i = 0; i < numFingers; i++) {
-        float offTime = timeOffMs;
-        if (jitterPercent > 0) {
-            float jitter = static_cast<float>(random(-1000, 1001)) / 1000.0f * jitterAmount;
-            offTime += jitter;
-            if (offTime < 0) offTime = 0;
-        }
-        pattern.timeOffMs[i] = offTime;
+        pattern.timeOffUs[i] = patternJitteredOffUs(patternTiming, rng);
     }
 
     return pattern;
@@ -194,10 +165,9 @@ TherapyEngine::TherapyEngine() :
     _sessionStartTime(0),
     _sessionDurationSec(0),
     _patternType(PatternType::RNDP),
-    _timeOnMs(100.0f),
-    _timeOffMs(67.0f),
-    _jitterPercent(0.0f),
+    _timing(),
     _numFingers(MAX_ACTUATORS),
+    _sessionFingers(MAX_ACTUATORS),
     _mirrorPattern(false),
     _amplitudeMin(100),
     _amplitudeMax(100),
@@ -226,7 +196,17 @@ TherapyEngine::TherapyEngine() :
     _getLeadTimeCallback(nullptr),
     _macrocycleSequenceId(0),
     _macrocycleEventIndex(0),
-    _macrocycleBaseTime(0)
+    _macrocycleBaseTime(0),
+    _inFlight{},
+    _inFlightHead(0),
+    _inFlightCount(0),
+    _pipelineDepth(1),
+    _lastAckedSequenceId(0),
+    _ackReceived(false),
+    _macrocycleAckMisses(0),
+    _seededGeneration(false),
+    _sessionSeed(0),
+    _planValid(false)
 {
     // Initialize frequencies to default (250 Hz per v1 ACTUATOR_FREQUENCY)
     for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
@@ -256,18 +236,25 @@ void TherapyEngine::setActiveFingers(const uint8_t* fingers, uint8_t count) {
         for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
             _fingerMap[i] = i;
         }
-        return;
+    } else {
+        _fingerMapCount = count;
+        for (uint8_t i = 0; i < count; i++) {
+            _fingerMap[i] = fingers[i];
+        }
     }
-    _fingerMapCount = count;
-    for (uint8_t i = 0; i < count; i++) {
-        _fingerMap[i] = fingers[i];
+    if (_isRunning) {
+        // Slots past the map would alias a finger that already fires (and
+        // fail plan compilation); a recovered motor brings them back
+        _numFingers = (_sessionFingers < _fingerMapCount) ? _sessionFingers : _fingerMapCount;
+        compilePlan();
     }
 }
 
 void TherapyEngine::remapPatternFingers(Pattern& pattern) {
     // Pattern sequences are permutations of 0.._numFingers-1 (slot indices);
     // map them onto physical fingers so a missing motor is skipped entirely.
-    // _numFingers <= _fingerMapCount is enforced by startSession.
+    // _numFingers <= _fingerMapCount is enforced by startSession and
+    // setActiveFingers.
     for (uint8_t i = 0; i < pattern.numFingers; i++) {
         if (pattern.primarySequence[i] < _fingerMapCount) {
             pattern.primarySequence[i] = _fingerMap[pattern.primarySequence[i]];
@@ -322,6 +309,9 @@ void TherapyEngine::setFrequencyRandomization(bool enabled, uint16_t minHz, uint
     _frequencyRandomization = enabled;
     _frequencyMin = minHz;
     _frequencyMax = maxHz;
+    if (_isRunning) {
+        compilePlan();
+    }
 }
 
 // =============================================================================
@@ -331,9 +321,7 @@ void TherapyEngine::setFrequencyRandomization(bool enabled, uint16_t minHz, uint
 void TherapyEngine::startSession(
     uint32_t durationSec,
     PatternType patternType,
-    float timeOnMs,
-    float timeOffMs,
-    float jitterPercent,
+    const TherapyTiming& timing,
     uint8_t numFingers,
     bool mirrorPattern,
     uint8_t amplitudeMin,
@@ -353,10 +341,9 @@ void TherapyEngine::startSession(
     _sessionStartTime = millis();
     _sessionDurationSec = durationSec;
     _patternType = patternType;
-    _timeOnMs = timeOnMs;
-    _timeOffMs = timeOffMs;
-    _jitterPercent = jitterPercent;
+    _timing = timing;
     // Never more fingers than the active (physically present) set
+    _sessionFingers = numFingers;
     _numFingers = (numFingers < _fingerMapCount) ? numFingers : _fingerMapCount;
     _mirrorPattern = mirrorPattern;
     _amplitudeMin = amplitudeMin;
@@ -372,10 +359,20 @@ void TherapyEngine::startSession(
     // Reset flow control state
     _buzzFlowState = BuzzFlowState::IDLE;
     _buzzSendTime = 0;
+    _inFlightHead = 0;
+    _inFlightCount = 0;
+    _ackReceived = false;
+    _macrocycleAckMisses = 0;
+
+    // Fresh seed per session; only used while seeded generation is enabled
+    _sessionSeed = static_cast<uint32_t>(random(0, 0x7FFFFFFFL)) ^ static_cast<uint32_t>(getMicros());
 
     // Generate first pattern
     generateNextPattern();
 
+    // Everything per-macrocycle generation needs, computed once
+    compilePlan();
+
     // Notify macrocycle start (first macrocycle)
     if (_macrocycleStartCallback) {
         _macrocycleStartCallback(_cyclesCompleted);
@@ -383,9 +380,10 @@ void TherapyEngine::startSession(
 
     Serial.printf("[THERAPY] Session started: %lu sec, pattern=%d\n", durationSec, patternType);
     Serial.printf("[THERAPY] Timing: ON=%.1fms, OFF=%.1fms, Jitter=%.1f%%\n",
-                  timeOnMs, timeOffMs, jitterPercent);
-    Serial.printf("[THERAPY] Pattern duration: %.1fms, Relax: %.1fms\n",
-                  _currentPattern.burstDurationMs, _currentPattern.interBurstIntervalMs);
+                  timing.timeOnMs(), timing.timeOffMs(), timing.jitterPercent());
+    Serial.printf("[THERAPY] Pattern duration: %luus, Relax: %luus\n",
+                  (unsigned long)_currentPattern.burstDurationUs,
+                  (unsigned long)_currentPattern.interBurstIntervalUs);
 }
 
 void TherapyEngine::update() {
@@ -430,6 +428,10 @@ void TherapyEngine::pause() {
         _motorActive = false;
     }
 
+    // Forget streamed macrocycles: the caller flushes the activation queues,
+    // and resume() restarts with a fresh lead time
+    _inFlightCount = 0;
+
     Serial.println(F("[THERAPY] Paused"));
 }
 
@@ -451,6 +453,8 @@ void TherapyEngine::stop() {
         _motorActive = false;
     }
 
+    _inFlightCount = 0;
+
     Serial.printf("[THERAPY] Stopped - Cycles: %lu, Activations: %lu\n",
                   _cyclesCompleted, _totalActivations);
 }
@@ -486,9 +490,7 @@ void TherapyEngine::generateNextPattern() {
         case PatternType::RNDP:
             _currentPattern = generateRandomPermutation(
                 _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
+                _timing,
                 _mirrorPattern
             );
             break;
@@ -496,9 +498,7 @@ void TherapyEngine::generateNextPattern() {
         case PatternType::SEQUENTIAL:
             _currentPattern = generateSequentialPattern(
                 _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
+                _timing,
                 _mirrorPattern,
                 false
             );
@@ -507,9 +507,7 @@ void TherapyEngine::generateNextPattern() {
         case PatternType::MIRRORED:
             _currentPattern = generateMirroredPattern(
                 _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
+                _timing,
                 true
             );
             break;
@@ -518,9 +516,7 @@ void TherapyEngine::generateNextPattern() {
             // Default to RNDP
             _currentPattern = generateRandomPermutation(
                 _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
+                _timing,
                 _mirrorPattern
             );
             break;
@@ -579,89 +575,199 @@ void TherapyEngine::applyFrequencyRandomization() {
 // THERAPY ENGINE - MACROCYCLE BATCHING
 // =============================================================================
 
-Macrocycle TherapyEngine::generateMacrocycle() {
-    // Generate 3 patterns × numFingers events (12 at 4 fingers, 15 at 5)
-    // Each event has a delta time relative to baseTime
-
-    Macrocycle mc;
-    mc.sequenceId = _macrocycleSequenceId++;
-    mc.durationMs = (uint8_t)_timeOnMs;  // Common duration for all events (V2 format)
-    mc.clockOffset = 0;  // Will be set by PRIMARY before sending (V2 format)
-    mc.eventCount = 0;
+// One pattern for N fingers, from the fixed-size generators
+template <uint8_t N>
+static FixedPattern<N> generateFixedPattern(const SchedulePlan& plan, PatternRng* rng) {
+    switch (static_cast<PatternType>(plan.patternType)) {
+        case PatternType::SEQUENTIAL:
+            return generateSequentialPattern<N>(plan.timing, plan.mirrorPattern, false, rng);
+        case PatternType::MIRRORED:
+            return generateMirroredPattern<N>(plan.timing, true, rng);
+        case PatternType::RNDP:
+        default:
+            return generateRandomPermutation<N>(plan.timing, plan.mirrorPattern, rng);
+    }
+}
 
-    uint16_t cumulativeTimeMs = 0;  // Running time offset from base
+template <uint8_t N>
+static void fillMacrocycleEventsN(const SchedulePlan& plan, uint16_t* frequencies, PatternRng* rng,
+                                  Macrocycle& mc) {
+    uint32_t cumulativeUs = 0;  // Running time offset from base
 
     // Generate 3 patterns
     for (uint8_t patternNum = 0; patternNum < PATTERNS_PER_MACROCYCLE; patternNum++) {
-        // Generate pattern based on type
-        Pattern pattern;
-        switch (_patternType) {
-            case PatternType::RNDP:
-                pattern = generateRandomPermutation(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, _mirrorPattern);
-                break;
-            case PatternType::SEQUENTIAL:
-                pattern = generateSequentialPattern(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, _mirrorPattern, false);
-                break;
-            case PatternType::MIRRORED:
-                pattern = generateMirroredPattern(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, true);
-                break;
-            default:
-                pattern = generateRandomPermutation(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, _mirrorPattern);
-                break;
-        }
-
-        remapPatternFingers(pattern);
+        FixedPattern<N> pattern = generateFixedPattern<N>(plan, rng);
 
         // Apply frequency randomization if enabled. Covers all MAX_ACTUATORS
-        // slots (not just _numFingers): events look frequency up by PHYSICAL
-        // finger, which can exceed _numFingers when the finger map skips a
+        // slots (not just numFingers): events look frequency up by PHYSICAL
+        // finger, which can exceed numFingers when the finger map skips a
         // missing motor.
-        if (_frequencyRandomization) {
-            uint16_t range = _frequencyMax - _frequencyMin;
-            uint16_t steps = range / 5;
+        if (plan.frequencyRandomization) {
             for (uint8_t finger = 0; finger < MAX_ACTUATORS; finger++) {
-                _currentFrequency[finger] = _frequencyMin + static_cast<uint16_t>(random(0, steps + 1) * 5);
+                frequencies[finger] = plan.frequencyMinHz +
+                    static_cast<uint16_t>(patternRandom(rng, 0, plan.frequencySteps + 1) * 5);
             }
         }
 
         // Add events for each finger in this pattern
-        for (uint8_t fingerIdx = 0; fingerIdx < pattern.numFingers; fingerIdx++) {
+        for (uint8_t fingerIdx = 0; fingerIdx < N; fingerIdx++) {
             if (mc.eventCount >= MACROCYCLE_MAX_EVENTS) break;
 
-            uint8_t primaryFinger = pattern.primarySequence[fingerIdx];
-            uint8_t secondaryFinger = pattern.secondarySequence[fingerIdx];
-            uint8_t amplitude = (_amplitudeMin == _amplitudeMax)
-                ? _amplitudeMin
-                : (uint8_t)random(_amplitudeMin, _amplitudeMax + 1);
+            // Map slot indices onto physical fingers (see remapPatternFingers)
+            uint8_t primaryFinger = plan.fingerMap[pattern.primarySequence[fingerIdx]];
+            uint8_t secondaryFinger = plan.fingerMap[pattern.secondarySequence[fingerIdx]];
+            uint8_t amplitude = (plan.amplitudeMin == plan.amplitudeMax)
+                ? plan.amplitudeMin
+                : (uint8_t)patternRandom(rng, plan.amplitudeMin, plan.amplitudeMax + 1);
 
             // Create event with both finger indices:
             // - secondaryFinger: transmitted over BLE to SECONDARY device
             // - primaryFinger: used locally on PRIMARY device
             // In mirrored mode these are identical; in non-mirrored mode they differ
             MacrocycleEvent evt(
-                cumulativeTimeMs,
+                static_cast<uint16_t>(cumulativeUs / 1000),
                 secondaryFinger,   // For SECONDARY (BLE transmission)
                 primaryFinger,     // For PRIMARY (local scheduling)
                 amplitude,
-                (uint8_t)pattern.burstDurationMs,
-                _currentFrequency[primaryFinger]  // Use PRIMARY finger for frequency lookup
+                mc.durationMs,
+                frequencies[primaryFinger]  // Use PRIMARY finger for frequency lookup
             );
 
             mc.events[mc.eventCount++] = evt;
 
-            // Advance time: TIME_ON + TIME_OFF (with jitter)
-            cumulativeTimeMs += (uint16_t)pattern.burstDurationMs;
-            cumulativeTimeMs += (uint16_t)pattern.timeOffMs[fingerIdx];
+            // Advance time: TIME_ON + TIME_OFF (with jitter), accumulated in
+            // microseconds so per-step truncation does not drift the cycle
+            cumulativeUs += plan.timing.timeOnUs + pattern.timeOffUs[fingerIdx];
         }
 
         // NO extra time between patterns within a macrocycle
         // (v1 behavior: patterns are back-to-back)
     }
+}
+
+// Shared by TherapyEngine (random() or seeded) and SECONDARY regeneration
+// (seeded). frequencies[] is the per-physical-finger state, updated in place
+// when frequency randomization is enabled. Dispatches once on the finger
+// count; everything below runs on the plan's integers and fixed arrays.
+static void fillMacrocycleEvents(const SchedulePlan& plan, uint16_t* frequencies,
+                                 PatternRng* rng, Macrocycle& mc) {
+    // Generate 3 patterns × numFingers events (12 at 4 fingers, 15 at 5)
+    // Each event has a delta time relative to baseTime
+    mc.durationMs = plan.durationMs;  // Common duration for all events (V2 format)
+    mc.eventCount = 0;
+
+    switch (plan.numFingers) {
+        case 1: fillMacrocycleEventsN<1>(plan, frequencies, rng, mc); break;
+        case 2: fillMacrocycleEventsN<2>(plan, frequencies, rng, mc); break;
+        case 3: fillMacrocycleEventsN<3>(plan, frequencies, rng, mc); break;
+        case 4: fillMacrocycleEventsN<4>(plan, frequencies, rng, mc); break;
+#if MAX_ACTUATORS >= 5
+        case 5: fillMacrocycleEventsN<5>(plan, frequencies, rng, mc); break;
+#endif
+        default: break;  // No fingers (or more than the board has): empty macrocycle
+    }
+}
+
+bool compileSchedulePlan(const SeededSessionParams& params, SchedulePlan& plan) {
+    plan.seed = params.seed;
+    plan.timing = PatternTiming::from(params.timing);
+    plan.doubleRelaxUs = macrocycleDoubleRelaxUs(params.timing);
+    uint32_t durationMs = (params.timing.timeOnUs + 500) / 1000;
+    plan.durationMs = static_cast<uint16_t>((durationMs > UINT16_MAX) ? UINT16_MAX : durationMs);
+    plan.patternType = params.patternType;
+    plan.numFingers = params.numFingers;
+    plan.mirrorPattern = params.mirrorPattern;
+    plan.amplitudeMin = params.amplitudeMin;
+    plan.amplitudeMax = params.amplitudeMax;
+    plan.frequencyRandomization = params.frequencyRandomization;
+    plan.frequencyMinHz = params.frequencyMinHz;
+    plan.frequencySteps = static_cast<uint16_t>(params.frequencyMaxHz - params.frequencyMinHz) / 5;
+
+    // Total map: slots past fingerMapCount stay on their own finger, as
+    // remapPatternFingers leaves them
+    bool valid = params.numFingers > 0 && params.fingerMapCount <= MAX_ACTUATORS &&
+                 params.numFingers <= params.fingerMapCount &&
+                 params.patternType <= static_cast<uint8_t>(PatternType::MIRRORED);
+    for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+        uint8_t finger = (i < params.fingerMapCount) ? params.fingerMap[i] : i;
+        if (finger >= MAX_ACTUATORS) {
+            // Would index past the frequency table
+            valid = false;
+            finger = i;
+        }
+        plan.fingerMap[i] = finger;
+        plan.baseFrequencyHz[i] = params.baseFrequencyHz[i];
+    }
+    return valid;
+}
+
+void generateSeededMacrocycle(const SchedulePlan& plan, uint32_t sequenceId, Macrocycle& macrocycle) {
+    uint16_t frequencies[MAX_ACTUATORS];
+    for (uint8_t finger = 0; finger < MAX_ACTUATORS; finger++) {
+        frequencies[finger] = plan.baseFrequencyHz[finger];
+    }
+
+    PatternRng rng(plan.seed, sequenceId);
+    macrocycle.sequenceId = sequenceId;
+    macrocycle.baseTime = 0;
+    macrocycle.clockOffset = 0;
+    fillMacrocycleEvents(plan, frequencies, &rng, macrocycle);
+}
+
+bool generateSeededMacrocycle(const SeededSessionParams& params, uint32_t sequenceId, Macrocycle& macrocycle) {
+    // Reject anything that would index past the finger map / frequency table
+    SchedulePlan plan;
+    if (!compileSchedulePlan(params, plan)) {
+        return false;
+    }
+    generateSeededMacrocycle(plan, sequenceId, macrocycle);
+    return true;
+}
+
+void TherapyEngine::getSeededSessionParams(SeededSessionParams& params) const {
+    params.seed = _sessionSeed;
+    params.patternType = static_cast<uint8_t>(_patternType);
+    params.numFingers = _numFingers;
+    params.mirrorPattern = _mirrorPattern;
+    params.amplitudeMin = _amplitudeMin;
+    params.amplitudeMax = _amplitudeMax;
+    params.frequencyRandomization = _frequencyRandomization;
+    params.frequencyMinHz = _frequencyMin;
+    params.frequencyMaxHz = _frequencyMax;
+    params.timing = _timing;
+    params.fingerMapCount = _fingerMapCount;
+    for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+        params.fingerMap[i] = (i < _fingerMapCount) ? _fingerMap[i] : 0;
+        // Randomized sessions overwrite every finger before first use
+        params.baseFrequencyHz[i] = _frequencyRandomization ? 0 : _currentFrequency[i];
+    }
+}
+
+Macrocycle TherapyEngine::generateMacrocycle() {
+    PERF_SCOPE(GENERATE_MACROCYCLE);
+    Macrocycle mc;
+    mc.sequenceId = _macrocycleSequenceId++;
+    mc.clockOffset = 0;  // Will be set by PRIMARY before sending (V2 format)
+
+    if (_seededGeneration) {
+        if (_planValid) {
+            generateSeededMacrocycle(_plan, mc.sequenceId, mc);
+        }
+    } else {
+        fillMacrocycleEvents(_plan, _currentFrequency, nullptr, mc);
+    }
 
     return mc;
 }
 
 void TherapyEngine::executeMacrocycleStep() {
+    // Streaming takes over at a macrocycle boundary and keeps running until
+    // everything it scheduled has completed (depth changes are safe mid-session)
+    if ((_pipelineDepth > 1 && _buzzFlowState == BuzzFlowState::IDLE) || _inFlightCount > 0) {
+        executeMacrocyclePipelined();
+        return;
+    }
+
     uint32_t now = millis();
 
     // State machine for macrocycle batching with FreeRTOS motor task scheduling
@@ -686,31 +792,7 @@ void TherapyEngine::executeMacrocycleStep() {
             _macrocycleBaseTime = nowUs + leadTimeUs;
             _currentMacrocycle.baseTime = _macrocycleBaseTime;
 
-            // Send macrocycle to SECONDARY
-            if (_sendMacrocycleCallback) {
-                _sendMacrocycleCallback(_currentMacrocycle);
-            }
-
-            // Schedule all PRIMARY activations locally via ActivationQueue
-            // FreeRTOS motor task handles timing with ~1ms precision
-            // Note: Use primaryFinger for local PRIMARY scheduling (finger is for SECONDARY)
-            if (_scheduleActivationCallback) {
-                for (uint8_t i = 0; i < _currentMacrocycle.eventCount; i++) {
-                    const MacrocycleEvent& evt = _currentMacrocycle.events[i];
-                    uint64_t activateTime = _macrocycleBaseTime + (evt.deltaTimeMs * 1000ULL);
-
-                    // Enqueue to ActivationQueue using PRIMARY's finger index
-                    // Motor task handles timing and frequency via FreeRTOS
-                    _scheduleActivationCallback(activateTime, evt.primaryFinger, evt.amplitude,
-                                                evt.durationMs, evt.getFrequencyHz());
-                    _totalActivations++;
-                }
-
-                // Signal motor task that events are ready for processing
-                if (_startSchedulingCallback) {
-                    _startSchedulingCallback();
-                }
-            }
+            sendAndScheduleMacrocycle();
 
             // Record send time for tracking
             _buzzSendTime = now;
@@ -743,9 +825,7 @@ void TherapyEngine::executeMacrocycleStep() {
 
         case BuzzFlowState::WAITING_RELAX: {
             // Wait for 2x TIME_RELAX (1336ms with default timing)
-            float doubleRelaxMs = 2.0f * 4.0f * (_timeOnMs + _timeOffMs);  // TIME_RELAX = 4 * (ON + OFF)
-
-            if ((now - _buzzSendTime) >= (uint32_t)doubleRelaxMs) {
+            if ((now - _buzzSendTime) >= doubleRelaxUs() / 1000) {
                 // Double TIME_RELAX elapsed - macrocycle complete
                 _cyclesCompleted++;
 
@@ -760,3 +840,127 @@ void TherapyEngine::executeMacrocycleStep() {
         }
     }
 }
+
+void TherapyEngine::sendAndScheduleMacrocycle() {
+    // Send macrocycle to SECONDARY
+    if (_sendMacrocycleCallback) {
+        _sendMacrocycleCallback(_currentMacrocycle);
+    }
+
+    // Schedule all PRIMARY activations locally via ActivationQueue
+    // FreeRTOS motor task handles timing with ~1ms precision
+    // Note: Use primaryFinger for local PRIMARY scheduling (finger is for SECONDARY)
+    if (_scheduleActivationCallback) {
+        for (uint8_t i = 0; i < _currentMacrocycle.eventCount; i++) {
+            const MacrocycleEvent& evt = _currentMacrocycle.events[i];
+            uint64_t activateTime = _macrocycleBaseTime + (evt.deltaTimeMs * 1000ULL);
+
+            // Enqueue to ActivationQueue using PRIMARY's finger index
+            // Motor task handles timing and frequency via FreeRTOS
+            _scheduleActivationCallback(activateTime, evt.primaryFinger, evt.amplitude,
+                                        evt.durationMs, evt.getFrequencyHz());
+            _totalActivations++;
+        }
+
+        // Signal motor task that events are ready for processing
+        if (_startSchedulingCallback) {
+            _startSchedulingCallback();
+        }
+    }
+}
+
+void TherapyEngine::compilePlan() {
+    SeededSessionParams params;
+    getSeededSessionParams(params);
+    _planValid = compileSchedulePlan(params, _plan);
+}
+
+// =============================================================================
+// THERAPY ENGINE - PIPELINED MACROCYCLE STREAMING
+// =============================================================================
+
+void TherapyEngine::setMacrocyclePipelineDepth(uint8_t depth) {
+    if (depth < 1) depth = 1;
+    if (depth > MACROCYCLE_PIPELINE_MAX_DEPTH) depth = MACROCYCLE_PIPELINE_MAX_DEPTH;
+    _pipelineDepth = depth;
+}
+
+void TherapyEngine::onMacrocycleAck(uint32_t sequenceId) {
+    _lastAckedSequenceId = sequenceId;
+    _ackReceived = true;
+}
+
+bool TherapyEngine::isMacrocycleAcked(uint32_t sequenceId) const {
+    // Cumulative: wrap-safe "sequenceId <= last ACK"
+    return _ackReceived &&
+           static_cast<int32_t>(sequenceId - _lastAckedSequenceId) <= 0;
+}
+
+void TherapyEngine::executeMacrocyclePipelined() {
+    uint64_t nowUs = getMicros();
+    uint32_t relaxUs = doubleRelaxUs();
+
+    // Retire macrocycles whose relax window has ended (same accounting as
+    // the stop-and-wait WAITING_RELAX state)
+    while (_inFlightCount > 0) {
+        const InFlightMacrocycle& oldest = _inFlight[_inFlightHead];
+        if (nowUs < oldest.endTimeUs + relaxUs) {
+            break;
+        }
+        if (!isMacrocycleAcked(oldest.sequenceId)) {
+            _macrocycleAckMisses++;
+        }
+        _inFlightHead = static_cast<uint8_t>((_inFlightHead + 1) % MACROCYCLE_PIPELINE_MAX_DEPTH);
+        _inFlightCount--;
+        _cyclesCompleted++;
+
+        if (_cycleCompleteCallback) {
+            _cycleCompleteCallback(_cyclesCompleted);
+        }
+    }
+
+    if (_inFlightCount >= _pipelineDepth) {
+        return;
+    }
+
+    uint64_t chainedBase = 0;
+    if (_inFlightCount > 0) {
+        uint8_t newestIdx = static_cast<uint8_t>((_inFlightHead + _inFlightCount - 1) % MACROCYCLE_PIPELINE_MAX_DEPTH);
+        const InFlightMacrocycle& newest = _inFlight[newestIdx];
+
+        // One unacknowledged macrocycle on the wire at a time; a lost ACK
+        // only delays the next send until the newest one starts playing
+        if (!isMacrocycleAcked(newest.sequenceId) && nowUs < newest.baseTimeUs) {
+            return;
+        }
+
+        chainedBase = newest.endTimeUs + relaxUs;
+        if (chainedBase > nowUs + (MACROCYCLE_PIPELINE_HORIZON_MS * 1000ULL)) {
+            return;  // Not due yet
+        }
+    }
+
+    _currentMacrocycle = generateMacrocycle();
+    _macrocycleEventIndex = 0;
+
+    if (_macrocycleStartCallback) {
+        _macrocycleStartCallback(_cyclesCompleted + _inFlightCount);
+    }
+
+    // Lead time only bounds how soon the chained baseTime may be; it is not
+    // added on top. The first macrocycle (or one that fell behind, e.g. after
+    // a stalled ACK) rebases to now + lead, exactly like stop-and-wait.
+    uint32_t leadTimeUs = _getLeadTimeCallback ? _getLeadTimeCallback() : 50000;
+    uint64_t earliestBase = getMicros() + leadTimeUs;
+    _macrocycleBaseTime = (chainedBase >= earliestBase) ? chainedBase : earliestBase;
+    _currentMacrocycle.baseTime = _macrocycleBaseTime;
+
+    sendAndScheduleMacrocycle();
+
+    uint8_t slot = static_cast<uint8_t>((_inFlightHead + _inFlightCount) % MACROCYCLE_PIPELINE_MAX_DEPTH);
+    _inFlight[slot].sequenceId = _currentMacrocycle.sequenceId;
+    _inFlight[slot].baseTimeUs = _macrocycleBaseTime;
+    _inFlight[slot].endTimeUs = _macrocycleBaseTime +
+        (static_cast<uint64_t>(_currentMacrocycle.getTotalDurationMs()) * 1000ULL);
+    _inFlightCount++;
+}
@@ -8,15 +8,11 @@ float vbatRawToVolts(uint8_t raw) {
     return static_cast<float>(raw) * 5.6f / 255.0f;
 }
 
-float VbatEstimator::addBurst(const uint8_t* raw, size_t count) {
-    if (raw == nullptr || count == 0) {
-        return _voltage;
-    }
-    if (count > VBAT_MAX_BURST) {
-        count = VBAT_MAX_BURST;
-    }
+static_assert(VBAT_SAMPLE_WINDOW <= VBAT_MAX_BURST && (VBAT_SAMPLE_WINDOW & 1) == 1,
+              "VBAT_SAMPLE_WINDOW must be odd and fit the median buffer");
 
-    // Median of the burst (insertion sort on a stack copy; count <= 16)
+// Median of up to VBAT_MAX_BURST samples (insertion sort on a stack copy)
+static uint8_t medianOf(const uint8_t* raw, size_t count) {
     uint8_t sorted[VBAT_MAX_BURST];
     for (size_t i = 0; i < count; i++) {
         uint8_t v = raw[i];
@@ -27,7 +23,11 @@ float VbatEstimator::addBurst(const uint8_t* raw, size_t count) {
         }
         sorted[j] = v;
     }
-    float sample = vbatRawToVolts(sorted[count / 2]);
+    return sorted[count / 2];
+}
+
+void VbatEstimator::fold(uint8_t medianRaw) {
+    float sample = vbatRawToVolts(medianRaw);
 
     if (!_hasReading) {
         _voltage = sample;
@@ -35,5 +35,27 @@ float VbatEstimator::addBurst(const uint8_t* raw, size_t count) {
     } else {
         _voltage += VBAT_EMA_ALPHA * (sample - _voltage);
     }
+}
+
+float VbatEstimator::addBurst(const uint8_t* raw, size_t count) {
+    if (raw == nullptr || count == 0) {
+        return _voltage;
+    }
+    if (count > VBAT_MAX_BURST) {
+        count = VBAT_MAX_BURST;
+    }
+
+    fold(medianOf(raw, count));
+    return _voltage;
+}
+
+float VbatEstimator::addSample(uint8_t raw) {
+    _window[_windowNext] = raw;
+    _windowNext = static_cast<uint8_t>((_windowNext + 1) % VBAT_SAMPLE_WINDOW);
+    if (_windowCount < VBAT_SAMPLE_WINDOW) {
+        _windowCount++;
+    }
+
+    fold(medianOf(_window, _windowCount));
     return _voltage;
 }
@@ -0,0 +1,264 @@
+/**
+ * @file bench_hot_paths.cpp
+ * @brief Host micro-benchmarks for the firmware's steady-state hot paths
+ *
+ * Run with `pio test -e native_bench`. Each benchmark reports the best of
+ * BENCH_RUNS timed runs as ns/op plus the bytes one op produces or consumes,
+ * and the whole set is written as JSON (BENCH_JSON, default
+ * native_bench.json) so a change's cost can be diffed against a baseline.
+ *
+ * Host numbers are for relative comparison only: they say nothing about
+ * absolute cost on the nRF52840 or ESP32-S3.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "therapy_engine.h"
+#include "motor_event_buffer.h"
+#include "command_table.h"
+#include "phone_protocol.h"
+
+// sync_protocol.cpp and therapy_engine.cpp are excluded from the native
+// build_src_filter; include them as the unit tests do
+#include "../../src/sync_protocol.cpp"
+#include "../../src/therapy_engine.cpp"
+
+// =============================================================================
+// HARNESS
+// =============================================================================
+
+constexpr uint8_t BENCH_RUNS = 5;
+constexpr uint32_t BENCH_MAX_RESULTS = 32;
+
+struct BenchResult {
+    const char* name;
+    double nsPerOp;
+    size_t bytes;
+};
+
+static BenchResult g_results[BENCH_MAX_RESULTS];
+static uint32_t g_resultCount = 0;
+static volatile uint32_t g_sink = 0;  // Keeps results observable to the optimizer
+
+static inline void sink(uint32_t value) {
+    g_sink = g_sink + value;
+}
+
+template <typename Op>
+static void bench(const char* name, uint32_t iterations, size_t bytes, Op op) {
+    double best = 0.0;
+    for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            op(i);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        double nsPerOp = elapsed.count() / iterations;
+        if (run == 0 || nsPerOp < best) {
+            best = nsPerOp;
+        }
+    }
+
+    printf("  %-40s %10.1f ns/op %6zu B\n", name, best, bytes);
+    TEST_ASSERT_TRUE(g_resultCount < BENCH_MAX_RESULTS);
+    g_results[g_resultCount++] = {name, best, bytes};
+}
+
+static void writeJson() {
+    const char* path = getenv("BENCH_JSON");
+    if (path == nullptr || path[0] == '\0') {
+        path = "native_bench.json";
+    }
+    FILE* out = fopen(path, "w");
+    if (out == nullptr) {
+        printf("[BENCH] cannot write %s\n", path);
+        return;
+    }
+    fprintf(out, "{\n  \"env\": \"native_bench\",\n  \"actuators\": %u,\n  \"results\": [\n",
+            static_cast<unsigned>(MAX_ACTUATORS));
+    for (uint32_t i = 0; i < g_resultCount; i++) {
+        fprintf(out, "    {\"name\": \"%s\", \"ns_per_op\": %.1f, \"bytes\": %zu}%s\n",
+                g_results[i].name, g_results[i].nsPerOp, g_results[i].bytes,
+                (i + 1 < g_resultCount) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    printf("[BENCH] %u results written to %s\n", static_cast<unsigned>(g_resultCount), path);
+}
+
+// =============================================================================
+// FIXTURES
+// =============================================================================
+
+static void makeSessionParams(SeededSessionParams& params, PatternType type) {
+    params.seed = 0x5EED1234;
+    params.patternType = static_cast<uint8_t>(type);
+    params.numFingers = MAX_ACTUATORS;
+    params.mirrorPattern = false;
+    params.amplitudeMin = 60;
+    params.amplitudeMax = 100;
+    params.frequencyRandomization = true;
+    params.frequencyMinHz = 210;
+    params.frequencyMaxHz = 255;
+    params.timing = TherapyTiming::fromMs(100.0f, 67.0f, 23.5f);
+    params.fingerMapCount = MAX_ACTUATORS;
+    for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+        params.fingerMap[i] = i;
+        params.baseFrequencyHz[i] = 250;
+    }
+}
+
+static Macrocycle makeMacrocycle() {
+    SeededSessionParams params;
+    makeSessionParams(params, PatternType::RNDP);
+    Macrocycle mc;
+    generateSeededMacrocycle(params, 42, mc);
+    mc.baseTime = 1234567890123ULL;
+    mc.clockOffset = -4321;
+    return mc;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =============================================================================
+// BENCHMARKS
+// =============================================================================
+
+void bench_macrocycle_wire(void) {
+    Macrocycle mc = makeMacrocycle();
+    char buffer[MESSAGE_BUFFER_SIZE];
+
+    const uint8_t versions[] = {MACROCYCLE_WIRE_V5, MACROCYCLE_WIRE_V6};
+    const char* serializeNames[] = {"serializeMacrocycle_v5", "serializeMacrocycle_v6"};
+    const char* deserializeNames[] = {"deserializeMacrocycle_v5", "deserializeMacrocycle_v6"};
+    for (uint8_t v = 0; v < 2; v++) {
+        TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, versions[v]));
+        size_t length = strlen(buffer);
+
+        bench(serializeNames[v], 200000, length, [&](uint32_t i) {
+            mc.sequenceId = i;
+            sink(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, versions[v]));
+        });
+
+        SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, versions[v]);
+        length = strlen(buffer);
+        Macrocycle decoded;
+        bench(deserializeNames[v], 200000, length, [&](uint32_t) {
+            sink(SyncCommand::deserializeMacrocycle(buffer, length, decoded));
+        });
+        TEST_ASSERT_EQUAL_UINT8(mc.eventCount, decoded.eventCount);
+    }
+}
+
+void bench_sync_command(void) {
+    SyncCommand ping = SyncCommand::createPingWithT1(7, 1234567890123ULL);
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(ping.serialize(buffer, sizeof(buffer)));
+    size_t length = strlen(buffer);
+
+    bench("SyncCommand_serialize_ping", 500000, length, [&](uint32_t) {
+        sink(ping.serialize(buffer, sizeof(buffer)));
+    });
+
+    SyncCommand received;
+    bench("SyncCommand_deserialize_ping", 500000, length, [&](uint32_t) {
+        sink(received.deserialize(buffer));
+    });
+}
+
+void bench_motor_event_staging(void) {
+    // BLE callback -> motor task handoff for one macrocycle batch
+    static MotorEventBuffer buffer;
+    const uint8_t batchSizes[] = {15, 30};
+    const char* names[] = {"MotorEventBuffer_stage_drain_15", "MotorEventBuffer_stage_drain_30"};
+    for (uint8_t b = 0; b < 2; b++) {
+        uint8_t events = batchSizes[b];
+        TEST_ASSERT_TRUE(events <= MotorEventBuffer::MAX_STAGED);
+        bench(names[b], 100000, events * sizeof(StagedMotorEvent), [&](uint32_t i) {
+            buffer.beginMacrocycle();
+            for (uint8_t e = 0; e < events; e++) {
+                buffer.stage(1000ULL * (i + e), e % MAX_ACTUATORS, 80, 100, 250, e + 1 == events);
+            }
+            StagedMotorEvent event;
+            while (buffer.unstage(event)) {
+                sink(event.finger);
+            }
+        });
+    }
+}
+
+void bench_generate_macrocycle(void) {
+    const PatternType types[] = {PatternType::RNDP, PatternType::SEQUENTIAL, PatternType::MIRRORED};
+    const char* names[] = {"generateSeededMacrocycle_rndp", "generateSeededMacrocycle_sequential",
+                           "generateSeededMacrocycle_mirrored"};
+    for (uint8_t t = 0; t < 3; t++) {
+        SeededSessionParams params;
+        makeSessionParams(params, types[t]);
+        SchedulePlan plan;
+        TEST_ASSERT_TRUE(compileSchedulePlan(params, plan));
+        Macrocycle mc;
+        bench(names[t], 100000, sizeof(Macrocycle), [&](uint32_t i) {
+            generateSeededMacrocycle(plan, i, mc);
+            sink(mc.eventCount);
+        });
+    }
+}
+
+void bench_offset_samples(void) {
+    SimpleSyncProtocol protocol;
+    bench("addOffsetSampleWithQuality", 500000, sizeof(SimpleSyncProtocol), [&](uint32_t i) {
+        // Offsets around 1.5ms with +/-200us spread, RTTs that mostly pass
+        int64_t offset = 1500 + static_cast<int64_t>((i * 2654435761u) % 400) - 200;
+        uint32_t rtt = 8000 + (i * 40503u) % 6000;
+        sink(protocol.addOffsetSampleWithQuality(offset, rtt));
+    });
+}
+
+void bench_phone_command(void) {
+    // MenuController::handleCommand() needs the hardware headers; this is
+    // its portable front half: classify, split, table lookup, v3 response
+    const char* message = "PROFILE_LOAD:2";
+    char response[MESSAGE_BUFFER_SIZE];
+    PhoneFrameWriter writer;
+    bench("phone_command_dispatch", 500000, strlen(message), [&](uint32_t i) {
+        std::string_view view(message);
+        if (classifyMessage(view) != InternalMessage::NONE) {
+            return;
+        }
+        CommandArgs args;
+        splitCommand(view, args);
+        MenuCommand command = lookupMenuCommand(args.name);
+        writer.begin(response, sizeof(response), static_cast<uint8_t>(command));
+        writer.putIdString(PhoneField::PROFILE, static_cast<uint8_t>(argToInt(args.params[0]) + (i & 1)),
+                           "noisy_vcr");
+        sink(static_cast<uint32_t>(writer.length()));
+    });
+}
+
+void bench_write_baseline(void) {
+    writeJson();
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    printf("\n[BENCH] best of %u runs\n", static_cast<unsigned>(BENCH_RUNS));
+    RUN_TEST(bench_macrocycle_wire);
+    RUN_TEST(bench_sync_command);
+    RUN_TEST(bench_motor_event_staging);
+    RUN_TEST(bench_generate_macrocycle);
+    RUN_TEST(bench_offset_samples);
+    RUN_TEST(bench_phone_command);
+    RUN_TEST(bench_write_baseline);
+
+    return UNITY_END();
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_ble_rx_framer.cpp
+ * @brief Unit tests for ble_rx_framer.h/cpp - EOT frame reassembly
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "ble_rx_framer.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static char buffer[16];
+static BLERxFramer framer(buffer, sizeof(buffer));
+static std::vector<std::string> frames;
+
+void setUp(void) {
+    framer.reset();
+    frames.clear();
+}
+
+void tearDown(void) {}
+
+// Feed one BLE payload, collecting every completed frame
+static void feed(const char* payload, size_t len) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(payload);
+    const char* frame;
+    size_t frameLength;
+    while (framer.feed(data, len, frame, frameLength)) {
+        // Views are NUL-terminated in place
+        TEST_ASSERT_EQUAL_UINT(frameLength, strlen(frame));
+        frames.emplace_back(frame, frameLength);
+    }
+    TEST_ASSERT_EQUAL_UINT(0, len);
+}
+
+static void feed(const char* payload) {
+    feed(payload, strlen(payload));
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_single_frame(void) {
+    feed("PING:1\x04");
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("PING:1", frames[0].c_str());
+    TEST_ASSERT_TRUE(framer.idle());
+}
+
+void test_frame_split_across_packets(void) {
+    feed("SESSION");
+    TEST_ASSERT_FALSE(framer.idle());
+    TEST_ASSERT_EQUAL_UINT(0, frames.size());
+    feed("_START\x04");
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("SESSION_START", frames[0].c_str());
+}
+
+void test_several_frames_in_one_packet(void) {
+    feed("A\x04" "BB\x04" "CC");
+    TEST_ASSERT_EQUAL_UINT(2, frames.size());
+    TEST_ASSERT_EQUAL_STRING("A", frames[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("BB", frames[1].c_str());
+    feed("C\x04");
+    TEST_ASSERT_EQUAL_UINT(3, frames.size());
+    TEST_ASSERT_EQUAL_STRING("CCC", frames[2].c_str());
+}
+
+void test_carriage_returns_dropped(void) {
+    feed("IN\rFO\r\n\r\x04");
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("INFO\n", frames[0].c_str());
+}
+
+void test_empty_frames_skipped(void) {
+    feed("\x04\x04\r\x04" "X\x04");
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("X", frames[0].c_str());
+}
+
+void test_full_buffer_frame_accepted(void) {
+    // Capacity 16: 15 bytes plus the NUL
+    feed("0123456789ABCDE\x04");
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_UINT(15, frames[0].size());
+    TEST_ASSERT_EQUAL_UINT32(0, framer.oversizeCount());
+}
+
+void test_oversize_frame_dropped_whole(void) {
+    feed("0123456789");
+    feed("ABCDEF");          // 16 bytes: one too many
+    feed("GHIJ\x04" "OK\x04");
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("OK", frames[0].c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, framer.oversizeCount());
+}
+
+void test_binary_payload_kept(void) {
+    // Escaped binary frames (MC V6, phone v3) may contain any byte but NUL,
+    // EOT and CR
+    const char payload[] = {'M', 'C', ':', 0x06, (char)0x80, (char)0xFF, 0x1B, 0x24, 0x04};
+    feed(payload, sizeof(payload));
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_UINT(8, frames[0].size());
+    TEST_ASSERT_EQUAL_MEMORY(payload, frames[0].data(), 8);
+}
+
+void test_clear_drops_partial_frame(void) {
+    feed("STALE");
+    framer.clear();
+    TEST_ASSERT_TRUE(framer.idle());
+    feed("NEW\x04");
+    TEST_ASSERT_EQUAL_UINT(1, frames.size());
+    TEST_ASSERT_EQUAL_STRING("NEW", frames[0].c_str());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_single_frame);
+    RUN_TEST(test_frame_split_across_packets);
+    RUN_TEST(test_several_frames_in_one_packet);
+    RUN_TEST(test_carriage_returns_dropped);
+    RUN_TEST(test_empty_frames_skipped);
+    RUN_TEST(test_full_buffer_frame_accepted);
+    RUN_TEST(test_oversize_frame_dropped_whole);
+    RUN_TEST(test_binary_payload_kept);
+    RUN_TEST(test_clear_drops_partial_frame);
+
+    return UNITY_END();
+}
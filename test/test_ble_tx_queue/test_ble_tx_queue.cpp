@@ -0,0 +1,198 @@
+/**
+ * @file test_ble_tx_queue.cpp
+ * @brief Unit tests for ble_tx_queue.h/cpp - Priority-class BLE TX queue
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "ble_tx_queue.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static BLETxQueue* queue = nullptr;
+
+static constexpr uint16_t PHONE = 1;
+static constexpr uint16_t GLOVE = 2;
+
+// Entries point into the queue's own slab, so it is rebuilt, not copied
+void setUp(void) {
+    queue = new BLETxQueue();
+}
+
+void tearDown(void) {
+    delete queue;
+    queue = nullptr;
+}
+
+// Reserve, fill and publish a message; returns the entry
+static BLETxEntry* push(TxPriority priority, uint16_t connHandle, const char* text) {
+    size_t len = strlen(text);
+    BLETxEntry* entry = queue->reserve(priority, len + 1);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    memcpy(entry->data, text, len);
+    entry->data[len] = BLE_EOT_CHAR;
+    entry->length = static_cast<uint16_t>(len + 1);
+    entry->bytesSent = 0;
+    entry->connHandle = connHandle;
+    entry->stampKind = TxStampKind::NONE;
+    queue->publish(entry);
+    return entry;
+}
+
+static BLETxEntry* nextEntry() {
+    return queue->next(nullptr, 0);
+}
+
+// =============================================================================
+// ORDERING TESTS
+// =============================================================================
+
+void test_empty_queue_has_nothing_to_send(void) {
+    TEST_ASSERT_NULL(nextEntry());
+    TEST_ASSERT_EQUAL_UINT8(0, queue->count());
+}
+
+void test_higher_class_goes_first(void) {
+    push(TxPriority::TELEMETRY, PHONE, "LATS:x");
+    push(TxPriority::RESPONSE, PHONE, "HELP");
+    push(TxPriority::MACROCYCLE, GLOVE, "MC:1");
+    push(TxPriority::SYNC, GLOVE, "MC_ACK:1");
+    TEST_ASSERT_EQUAL_UINT8(4, queue->count());
+
+    const TxPriority expected[] = {TxPriority::SYNC, TxPriority::MACROCYCLE,
+                                   TxPriority::RESPONSE, TxPriority::TELEMETRY};
+    for (TxPriority priority : expected) {
+        BLETxEntry* entry = nextEntry();
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL_UINT8(1, queue->count(priority));
+        queue->release(entry);
+        TEST_ASSERT_EQUAL_UINT8(0, queue->count(priority));
+    }
+    TEST_ASSERT_NULL(nextEntry());
+}
+
+void test_fifo_within_class_and_wraps(void) {
+    char text[8];
+    for (int round = 0; round < 3; round++) {
+        for (uint8_t i = 0; i < BLETxQueue::SLOTS[0]; i++) {
+            snprintf(text, sizeof(text), "P%u", i);
+            TEST_ASSERT_NOT_NULL(push(TxPriority::SYNC, GLOVE, text));
+        }
+        for (uint8_t i = 0; i < BLETxQueue::SLOTS[0]; i++) {
+            BLETxEntry* entry = nextEntry();
+            TEST_ASSERT_NOT_NULL(entry);
+            snprintf(text, sizeof(text), "P%u", i);
+            TEST_ASSERT_EQUAL_MEMORY(text, entry->data, strlen(text));
+            queue->release(entry);
+        }
+    }
+}
+
+// =============================================================================
+// CAPACITY TESTS
+// =============================================================================
+
+void test_slot_size_is_per_class(void) {
+    TEST_ASSERT_NULL(queue->reserve(TxPriority::SYNC, BLE_TX_SYNC_SLOT_BYTES + 1));
+    TEST_ASSERT_NOT_NULL(queue->reserve(TxPriority::SYNC, BLE_TX_SYNC_SLOT_BYTES));
+    TEST_ASSERT_NOT_NULL(queue->reserve(TxPriority::RESPONSE, BLE_TX_RESPONSE_SLOT_BYTES));
+    TEST_ASSERT_NULL(queue->reserve(TxPriority::DEFAULT, 4));
+}
+
+void test_full_class_does_not_block_others(void) {
+    for (uint8_t i = 0; i < BLE_TX_RESPONSE_SLOTS; i++) {
+        TEST_ASSERT_NOT_NULL(push(TxPriority::RESPONSE, PHONE, "R"));
+    }
+    TEST_ASSERT_NULL(push(TxPriority::RESPONSE, PHONE, "R"));
+    TEST_ASSERT_NOT_NULL(push(TxPriority::SYNC, GLOVE, "S"));
+    TEST_ASSERT_EQUAL_UINT8(BLE_TX_RESPONSE_SLOTS + 1, queue->count());
+}
+
+void test_slabs_do_not_overlap(void) {
+    BLETxEntry* a = queue->reserve(TxPriority::SYNC, 1);
+    BLETxEntry* b = queue->reserve(TxPriority::SYNC, 1);
+    BLETxEntry* c = queue->reserve(TxPriority::MACROCYCLE, 1);
+    TEST_ASSERT_EQUAL(BLE_TX_SYNC_SLOT_BYTES, b->data - a->data);
+    TEST_ASSERT_TRUE(c->data >= b->data + BLE_TX_SYNC_SLOT_BYTES);
+    TEST_ASSERT_EQUAL_UINT16(BLE_TX_MACROCYCLE_SLOT_BYTES, c->capacity);
+}
+
+// =============================================================================
+// SELECTION TESTS
+// =============================================================================
+
+void test_unpublished_head_blocks_only_its_class(void) {
+    BLETxEntry* reserved = queue->reserve(TxPriority::SYNC, 8);
+    TEST_ASSERT_NOT_NULL(reserved);
+    BLETxEntry* response = push(TxPriority::RESPONSE, PHONE, "R");
+
+    TEST_ASSERT_EQUAL_PTR(response, nextEntry());
+}
+
+void test_partial_message_owns_its_connection(void) {
+    BLETxEntry* bulk = push(TxPriority::RESPONSE, PHONE, "HELP...");
+    bulk->bytesSent = 3;  // First chunk already written
+
+    // Same connection: cannot interleave into the EOT-framed stream
+    BLETxEntry* syncSameLink = push(TxPriority::SYNC, PHONE, "S");
+    TEST_ASSERT_EQUAL_PTR(bulk, nextEntry());
+
+    // Other connection: preempts between chunks
+    queue->release(syncSameLink);
+    BLETxEntry* syncOtherLink = push(TxPriority::SYNC, GLOVE, "PING");
+    TEST_ASSERT_EQUAL_PTR(syncOtherLink, nextEntry());
+}
+
+void test_skip_handles_fall_through_to_other_connection(void) {
+    push(TxPriority::SYNC, GLOVE, "PING");
+    BLETxEntry* response = push(TxPriority::RESPONSE, PHONE, "R");
+
+    uint16_t congested[] = {GLOVE};
+    TEST_ASSERT_EQUAL_PTR(response, queue->next(congested, 1));
+    uint16_t both[] = {GLOVE, PHONE};
+    TEST_ASSERT_NULL(queue->next(both, 2));
+}
+
+void test_release_ignores_non_head_entry(void) {
+    BLETxEntry* first = push(TxPriority::SYNC, GLOVE, "A");
+    BLETxEntry* second = push(TxPriority::SYNC, GLOVE, "B");
+    queue->release(second);
+    TEST_ASSERT_EQUAL_UINT8(2, queue->count());
+    queue->release(first);
+    TEST_ASSERT_EQUAL_PTR(second, nextEntry());
+}
+
+void test_notify_payload_tracks_mtu(void) {
+    TEST_ASSERT_EQUAL_UINT16(20, bleNotifyPayload(BLE_ATT_MTU_MIN));
+    TEST_ASSERT_EQUAL_UINT16(185 - BLE_ATT_HEADER_BYTES, bleNotifyPayload(185));
+    TEST_ASSERT_EQUAL_UINT16(244, bleNotifyPayload(BLE_ATT_MTU));
+    // Out-of-range values clamp to what we configured / the spec minimum
+    TEST_ASSERT_EQUAL_UINT16(244, bleNotifyPayload(517));
+    TEST_ASSERT_EQUAL_UINT16(20, bleNotifyPayload(0));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_queue_has_nothing_to_send);
+    RUN_TEST(test_higher_class_goes_first);
+    RUN_TEST(test_fifo_within_class_and_wraps);
+    RUN_TEST(test_slot_size_is_per_class);
+    RUN_TEST(test_full_class_does_not_block_others);
+    RUN_TEST(test_slabs_do_not_overlap);
+    RUN_TEST(test_unpublished_head_blocks_only_its_class);
+    RUN_TEST(test_partial_message_owns_its_connection);
+    RUN_TEST(test_skip_handles_fall_through_to_other_connection);
+    RUN_TEST(test_release_ignores_non_head_entry);
+    RUN_TEST(test_notify_payload_tracks_mtu);
+
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file test_clock_servo.cpp
+ * @brief Unit tests for clock_servo.h/cpp - 2-state Kalman clock servo
+ */
+
+#include <unity.h>
+#include "clock_servo.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static ClockServo servo;
+
+static constexpr uint32_t GOOD_RTT_US = 15000;
+
+void setUp(void) {
+    servo.reset();
+}
+
+void tearDown(void) {
+}
+
+// Deterministic +/- jitter pattern (us)
+static int64_t jitter(uint32_t i) {
+    static const int64_t pattern[] = {120, -80, 40, -150, 90, -30, 10, -60};
+    return pattern[i % 8];
+}
+
+// Feeds offset = base + skew * t at a fixed cadence; returns the last time
+static uint32_t feedLinear(int64_t base, float skewUsPerMs, uint32_t startMs,
+                           uint32_t periodMs, uint32_t count) {
+    uint32_t t = startMs;
+    for (uint32_t i = 0; i < count; i++) {
+        t = startMs + i * periodMs;
+        int64_t offset = base + static_cast<int64_t>(skewUsPerMs * static_cast<float>(t)) + jitter(i);
+        TEST_ASSERT_TRUE(servo.update(offset, GOOD_RTT_US, t));
+    }
+    return t;
+}
+
+// =============================================================================
+// CONVERGENCE TESTS
+// =============================================================================
+
+void test_first_sample_seeds_offset(void) {
+    TEST_ASSERT_FALSE(servo.isSeeded());
+    TEST_ASSERT_TRUE(servo.update(-2500000, GOOD_RTT_US, 1000));
+    TEST_ASSERT_TRUE(servo.isSeeded());
+    TEST_ASSERT_EQUAL_INT64(-2500000, servo.offset());
+    TEST_ASSERT_EQUAL_UINT16(1, servo.sampleCount());
+}
+
+void test_converges_within_min_samples(void) {
+    feedLinear(1000000, 0.0f, 1000, 1000, SYNC_MIN_VALID_SAMPLES);
+    int64_t error = servo.offset() - 1000000;
+    TEST_ASSERT_INT64_WITHIN(150, 0, error);
+    TEST_ASSERT_TRUE(servo.offsetSigma() < SYNC_SERVO_MEAS_FLOOR_US);
+}
+
+void test_tracks_skew(void) {
+    // 20 ppm: offset grows 0.02 us per ms
+    uint32_t last = feedLinear(500000, 0.02f, 1000, 1000, 20);
+    TEST_ASSERT_FLOAT_WITHIN(0.003f, 0.02f, servo.skew());
+
+    // Extrapolates between sparse samples
+    int64_t expected = 500000 + static_cast<int64_t>(0.02f * static_cast<float>(last + 5000));
+    TEST_ASSERT_INT64_WITHIN(200, expected, servo.offsetAt(last + 5000));
+}
+
+void test_large_offsets_keep_precision(void) {
+    // Boot-time offsets of an hour must not lose microseconds to float
+    const int64_t base = 3600000000LL;
+    feedLinear(base, 0.0f, 1000, 1000, 10);
+    TEST_ASSERT_INT64_WITHIN(100, base, servo.offset());
+}
+
+// =============================================================================
+// MEASUREMENT QUALITY TESTS
+// =============================================================================
+
+void test_rejects_rtt_above_ceiling(void) {
+    TEST_ASSERT_FALSE(servo.update(1000, SYNC_RTT_QUALITY_THRESHOLD_US + 1, 1000));
+    TEST_ASSERT_FALSE(servo.isSeeded());
+}
+
+void test_excess_rtt_weighs_less(void) {
+    ClockServo fast;
+    feedLinear(0, 0.0f, 1000, 1000, 5);
+    fast = servo;
+
+    // Same 1ms excursion; one exchange queued 20ms longer than the minimum
+    TEST_ASSERT_TRUE(fast.update(1000, GOOD_RTT_US, 6000));
+    TEST_ASSERT_TRUE(servo.update(1000, GOOD_RTT_US + 20000, 6000));
+    TEST_ASSERT_TRUE(servo.offset() < fast.offset());
+}
+
+void test_gate_rejects_single_outlier(void) {
+    feedLinear(0, 0.0f, 1000, 1000, 5);
+    int64_t predicted = servo.offsetAt(6000);
+    TEST_ASSERT_FALSE(servo.update(20000, GOOD_RTT_US, 6000));
+    TEST_ASSERT_INT64_WITHIN(1, predicted, servo.offset());
+}
+
+void test_persistent_step_reanchors(void) {
+    feedLinear(0, 0.0f, 1000, 1000, 5);
+    uint32_t t = 6000;
+    for (uint8_t i = 0; i < SYNC_INNOVATION_REJECT_LIMIT; i++, t += 1000) {
+        TEST_ASSERT_FALSE(servo.update(20000, GOOD_RTT_US, t));
+    }
+    TEST_ASSERT_TRUE(servo.update(20000, GOOD_RTT_US, t));
+    TEST_ASSERT_EQUAL_INT64(20000, servo.offset());
+}
+
+// =============================================================================
+// WARM START / PROJECTION TESTS
+// =============================================================================
+
+void test_seed_sets_prior(void) {
+    servo.seed(750000, 0.01f, 2500.0f, 1000);
+    TEST_ASSERT_TRUE(servo.isSeeded());
+    TEST_ASSERT_EQUAL_UINT16(0, servo.sampleCount());
+    TEST_ASSERT_EQUAL_INT64(750000 + 10, servo.offsetAt(2000));
+
+    // A confirming sample pulls the offset most of the way (prior is wide)
+    TEST_ASSERT_TRUE(servo.update(751000, GOOD_RTT_US, 2000));
+    TEST_ASSERT_INT64_WITHIN(100, 751000, servo.offset());
+}
+
+void test_projection_caps_elapsed_and_skew(void) {
+    servo.seed(0, 0.5f, 100.0f, 0);
+    int64_t capped = static_cast<int64_t>(SYNC_MAX_APPLIED_DRIFT_RATE_US_PER_MS *
+                                          SYNC_MAX_CORRECTION_ELAPSED_MS);
+    TEST_ASSERT_INT64_WITHIN(1, capped, servo.offsetAt(60000));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_sample_seeds_offset);
+    RUN_TEST(test_converges_within_min_samples);
+    RUN_TEST(test_tracks_skew);
+    RUN_TEST(test_large_offsets_keep_precision);
+    RUN_TEST(test_rejects_rtt_above_ceiling);
+    RUN_TEST(test_excess_rtt_weighs_less);
+    RUN_TEST(test_gate_rejects_single_outlier);
+    RUN_TEST(test_persistent_step_reanchors);
+    RUN_TEST(test_seed_sets_prior);
+    RUN_TEST(test_projection_caps_elapsed_and_skew);
+
+    return UNITY_END();
+}
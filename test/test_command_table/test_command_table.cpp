@@ -0,0 +1,165 @@
+/**
+ * @file test_command_table.cpp
+ * @brief Unit tests for command_table.h/cpp - Message classification and command lookup
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "command_table.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// CLASSIFICATION TESTS
+// =============================================================================
+
+void test_classify_internal_prefixes(void) {
+    TEST_ASSERT_TRUE(classifyMessage("PONG:12|0|1000|2000") == InternalMessage::PONG);
+    TEST_ASSERT_TRUE(classifyMessage("PING:3|0|1000") == InternalMessage::PING);
+    TEST_ASSERT_TRUE(classifyMessage("BUZZ:1|0|5000|0|100") == InternalMessage::BUZZ);
+    TEST_ASSERT_TRUE(classifyMessage("MC:1|2|3") == InternalMessage::MC);
+    TEST_ASSERT_TRUE(classifyMessage("IDENTIFY:SECONDARY") == InternalMessage::IDENTIFY);
+    TEST_ASSERT_TRUE(classifyMessage("SYNC_ADJ:100") == InternalMessage::SYNC);
+    TEST_ASSERT_TRUE(classifyMessage("CALIB_STOP") == InternalMessage::CALIB_STOP);
+}
+
+void test_classify_prefers_longest_prefix(void) {
+    TEST_ASSERT_TRUE(classifyMessage("SEED_ACK:42") == InternalMessage::SEED_ACK);
+    TEST_ASSERT_TRUE(classifyMessage("SEED:42") == InternalMessage::SEED);
+    TEST_ASSERT_TRUE(classifyMessage("MC_ACK:7") == InternalMessage::MC_ACK);
+    TEST_ASSERT_TRUE(classifyMessage("MC_VER:2") == InternalMessage::MC_VER);
+    TEST_ASSERT_TRUE(classifyMessage("MC_RESYNC:9000") == InternalMessage::MC_RESYNC);
+    TEST_ASSERT_TRUE(classifyMessage("ACK_PARAM_UPDATE") == InternalMessage::ACK_PARAM_UPDATE);
+    TEST_ASSERT_TRUE(classifyMessage("ACK_SYNC_ADJ:5") == InternalMessage::ACK_SYNC);
+}
+
+void test_classify_phone_commands_are_none(void) {
+    TEST_ASSERT_TRUE(classifyMessage("INFO") == InternalMessage::NONE);
+    TEST_ASSERT_TRUE(classifyMessage("SESSION_START") == InternalMessage::NONE);
+    TEST_ASSERT_TRUE(classifyMessage("pong") == InternalMessage::NONE);
+    TEST_ASSERT_TRUE(classifyMessage("MC") == InternalMessage::NONE);   // Needs the colon
+    TEST_ASSERT_TRUE(classifyMessage("SYNC") == InternalMessage::NONE); // Needs the underscore
+    TEST_ASSERT_TRUE(classifyMessage("") == InternalMessage::NONE);
+    TEST_ASSERT_TRUE(classifyMessage("1234") == InternalMessage::NONE);
+}
+
+void test_internal_prefix_round_trips(void) {
+    TEST_ASSERT_TRUE(internalPrefix(InternalMessage::MC_ACK) == "MC_ACK:");
+    TEST_ASSERT_TRUE(classifyMessage(internalPrefix(InternalMessage::LED_OFF_SYNC)) == InternalMessage::LED_OFF_SYNC);
+    TEST_ASSERT_TRUE(internalPrefix(InternalMessage::NONE).empty());
+}
+
+// =============================================================================
+// LOOKUP TESTS
+// =============================================================================
+
+void test_lookup_every_command_case_insensitive(void) {
+    TEST_ASSERT_TRUE(lookupMenuCommand("INFO") == MenuCommand::INFO);
+    TEST_ASSERT_TRUE(lookupMenuCommand("info") == MenuCommand::INFO);
+    TEST_ASSERT_TRUE(lookupMenuCommand("Profile_Load") == MenuCommand::PROFILE_LOAD);
+    TEST_ASSERT_TRUE(lookupMenuCommand("SESSION_STATUS") == MenuCommand::SESSION_STATUS);
+    TEST_ASSERT_TRUE(lookupMenuCommand("SESSION_STOP") == MenuCommand::SESSION_STOP);
+    TEST_ASSERT_TRUE(lookupMenuCommand("CALIBRATE_BUZZ") == MenuCommand::CALIBRATE_BUZZ);
+    TEST_ASSERT_TRUE(lookupMenuCommand("latency_stream") == MenuCommand::LATENCY_STREAM);
+    TEST_ASSERT_TRUE(lookupMenuCommand("DEBUG") == MenuCommand::DEBUG);
+    TEST_ASSERT_TRUE(lookupMenuCommand("journal_get") == MenuCommand::JOURNAL_GET);
+    TEST_ASSERT_TRUE(lookupMenuCommand("perf") == MenuCommand::PERF);
+}
+
+void test_command_name_round_trips(void) {
+    for (uint8_t c = static_cast<uint8_t>(MenuCommand::INFO);
+         c <= static_cast<uint8_t>(MenuCommand::PERF); c++) {
+        MenuCommand command = static_cast<MenuCommand>(c);
+        TEST_ASSERT_TRUE(lookupMenuCommand(menuCommandName(command)) == command);
+    }
+    TEST_ASSERT_TRUE(menuCommandName(MenuCommand::UNKNOWN).empty());
+}
+
+void test_lookup_unknown(void) {
+    TEST_ASSERT_TRUE(lookupMenuCommand("") == MenuCommand::UNKNOWN);
+    TEST_ASSERT_TRUE(lookupMenuCommand("FOO") == MenuCommand::UNKNOWN);
+    TEST_ASSERT_TRUE(lookupMenuCommand("INFOX") == MenuCommand::UNKNOWN);
+    TEST_ASSERT_TRUE(lookupMenuCommand("SESSION_") == MenuCommand::UNKNOWN);
+}
+
+// =============================================================================
+// SPLIT TESTS
+// =============================================================================
+
+void test_split_name_and_params(void) {
+    CommandArgs args;
+    TEST_ASSERT_TRUE(splitCommand("  PARAM_SET:ON:0.1:OFF:0.2\n\x04", args));
+    TEST_ASSERT_TRUE(args.name == "PARAM_SET");
+    TEST_ASSERT_EQUAL_UINT8(4, args.count);
+    TEST_ASSERT_TRUE(args.params[0] == "ON");
+    TEST_ASSERT_TRUE(args.params[3] == "0.2");
+}
+
+void test_split_skips_empty_fields_and_caps_params(void) {
+    CommandArgs args;
+    TEST_ASSERT_TRUE(splitCommand("::A::B:", args));
+    TEST_ASSERT_TRUE(args.name == "A");
+    TEST_ASSERT_EQUAL_UINT8(1, args.count);
+    TEST_ASSERT_TRUE(args.params[0] == "B");
+
+    char many[64] = "X";
+    for (int i = 0; i < MAX_COMMAND_PARAMS + 4; i++) {
+        strcat(many, ":1");
+    }
+    TEST_ASSERT_TRUE(splitCommand(many, args));
+    TEST_ASSERT_EQUAL_UINT8(MAX_COMMAND_PARAMS, args.count);
+
+    TEST_ASSERT_FALSE(splitCommand("   \r\n", args));
+    TEST_ASSERT_FALSE(splitCommand(":::", args));
+}
+
+// =============================================================================
+// PARAMETER HELPER TESTS
+// =============================================================================
+
+void test_arg_to_int_matches_atoi(void) {
+    TEST_ASSERT_EQUAL_INT32(42, argToInt("42"));
+    TEST_ASSERT_EQUAL_INT32(-7, argToInt(" -7"));
+    TEST_ASSERT_EQUAL_INT32(3, argToInt("3abc"));
+    TEST_ASSERT_EQUAL_INT32(0, argToInt("abc"));
+    TEST_ASSERT_EQUAL_INT32(0, argToInt(""));
+}
+
+void test_arg_to_bool_and_copy(void) {
+    bool value = false;
+    TEST_ASSERT_TRUE(argToBool("TRUE", value));
+    TEST_ASSERT_TRUE(value);
+    TEST_ASSERT_TRUE(argToBool("0", value));
+    TEST_ASSERT_FALSE(value);
+    TEST_ASSERT_FALSE(argToBool("yes", value));
+
+    char out[4];
+    TEST_ASSERT_EQUAL_UINT32(3, argCopy("ABCDEF", out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("ABC", out);
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_classify_internal_prefixes);
+    RUN_TEST(test_classify_prefers_longest_prefix);
+    RUN_TEST(test_classify_phone_commands_are_none);
+    RUN_TEST(test_internal_prefix_round_trips);
+    RUN_TEST(test_lookup_every_command_case_insensitive);
+    RUN_TEST(test_command_name_round_trips);
+    RUN_TEST(test_lookup_unknown);
+    RUN_TEST(test_split_name_and_params);
+    RUN_TEST(test_split_skips_empty_fields_and_caps_params);
+    RUN_TEST(test_arg_to_int_matches_atoi);
+    RUN_TEST(test_arg_to_bool_and_copy);
+
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_conn_param_controller.cpp
+ * @brief Unit tests for conn_param_controller.h/cpp - Connection-parameter policy
+ */
+
+#include <unity.h>
+#include "conn_param_controller.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static ConnParamController* controller = nullptr;
+
+void setUp(void) {
+    static ConnParamController instance;
+    instance = ConnParamController();
+    controller = &instance;
+}
+
+void tearDown(void) {
+}
+
+// Runs update() and returns whether it asked for a change to expected
+static bool switchesTo(uint32_t nowMs, ConnParamProfile expected) {
+    ConnParamProfile profile = ConnParamProfile::TIGHT;
+    if (!controller->update(nowMs, profile)) {
+        return false;
+    }
+    return profile == expected;
+}
+
+static bool holds(uint32_t nowMs) {
+    ConnParamProfile profile;
+    return !controller->update(nowMs, profile);
+}
+
+// =============================================================================
+// POLICY TESTS
+// =============================================================================
+
+void test_starts_tight_and_relaxes_after_delay(void) {
+    TEST_ASSERT_EQUAL(ConnParamProfile::TIGHT, controller->applied());
+    controller->onStateChange(TherapyState::READY);
+    controller->onLinkUp();
+    TEST_ASSERT_TRUE(holds(1000));
+    TEST_ASSERT_TRUE(holds(1000 + BLE_CONN_PARAM_RELAX_DELAY_MS - 1));
+    TEST_ASSERT_TRUE(switchesTo(1000 + BLE_CONN_PARAM_RELAX_DELAY_MS, ConnParamProfile::RELAXED));
+    TEST_ASSERT_EQUAL(ConnParamProfile::RELAXED, controller->applied());
+    TEST_ASSERT_TRUE(holds(1000 + 2 * BLE_CONN_PARAM_RELAX_DELAY_MS));
+}
+
+void test_running_tightens_immediately(void) {
+    controller->onStateChange(TherapyState::IDLE);
+    TEST_ASSERT_TRUE(switchesTo(BLE_CONN_PARAM_RELAX_DELAY_MS, ConnParamProfile::RELAXED));
+
+    controller->onStateChange(TherapyState::RUNNING);
+    TEST_ASSERT_TRUE(switchesTo(BLE_CONN_PARAM_RELAX_DELAY_MS + 1, ConnParamProfile::TIGHT));
+    TEST_ASSERT_TRUE(holds(BLE_CONN_PARAM_RELAX_DELAY_MS * 10));
+}
+
+void test_paused_relaxes_and_resume_tightens(void) {
+    controller->onStateChange(TherapyState::RUNNING);
+    TEST_ASSERT_TRUE(holds(100));
+    controller->onStateChange(TherapyState::PAUSED);
+    TEST_ASSERT_TRUE(holds(100 + BLE_CONN_PARAM_RELAX_DELAY_MS - 1));
+    TEST_ASSERT_TRUE(switchesTo(100 + BLE_CONN_PARAM_RELAX_DELAY_MS, ConnParamProfile::RELAXED));
+    controller->onStateChange(TherapyState::RUNNING);
+    TEST_ASSERT_TRUE(switchesTo(100 + BLE_CONN_PARAM_RELAX_DELAY_MS + 1, ConnParamProfile::TIGHT));
+}
+
+void test_stop_start_churn_stays_tight(void) {
+    controller->onStateChange(TherapyState::RUNNING);
+    TEST_ASSERT_TRUE(holds(100));
+    controller->onStateChange(TherapyState::IDLE);
+    TEST_ASSERT_TRUE(holds(2000));
+    controller->onStateChange(TherapyState::RUNNING);
+    TEST_ASSERT_TRUE(holds(2000 + BLE_CONN_PARAM_RELAX_DELAY_MS));
+    TEST_ASSERT_EQUAL(ConnParamProfile::TIGHT, controller->applied());
+}
+
+void test_phone_disconnect_keeps_running_policy(void) {
+    controller->onStateChange(TherapyState::RUNNING);
+    controller->onStateChange(TherapyState::PHONE_DISCONNECTED);
+    TEST_ASSERT_EQUAL(ConnParamProfile::TIGHT, controller->desired());
+    TEST_ASSERT_TRUE(holds(BLE_CONN_PARAM_RELAX_DELAY_MS * 2));
+}
+
+void test_low_battery_session_stays_tight(void) {
+    controller->onStateChange(TherapyState::LOW_BATTERY);
+    TEST_ASSERT_EQUAL(ConnParamProfile::TIGHT, controller->desired());
+    controller->onStateChange(TherapyState::CRITICAL_BATTERY);
+    TEST_ASSERT_EQUAL(ConnParamProfile::RELAXED, controller->desired());
+}
+
+// =============================================================================
+// INPUT TESTS
+// =============================================================================
+
+void test_sync_warmup_holds_tight_when_idle(void) {
+    controller->onStateChange(TherapyState::READY);
+    controller->setSyncWarmup(true);
+    TEST_ASSERT_TRUE(holds(BLE_CONN_PARAM_RELAX_DELAY_MS * 2));
+    controller->setSyncWarmup(false);
+    TEST_ASSERT_TRUE(holds(BLE_CONN_PARAM_RELAX_DELAY_MS * 3 - 1));
+    TEST_ASSERT_TRUE(switchesTo(BLE_CONN_PARAM_RELAX_DELAY_MS * 3, ConnParamProfile::RELAXED));
+}
+
+void test_charging_skips_warmup_but_not_session(void) {
+    controller->onStateChange(TherapyState::READY);
+    controller->setSyncWarmup(true);
+    controller->setCharging(true);
+    TEST_ASSERT_EQUAL(ConnParamProfile::RELAXED, controller->desired());
+
+    controller->onStateChange(TherapyState::RUNNING);
+    TEST_ASSERT_EQUAL(ConnParamProfile::TIGHT, controller->desired());
+}
+
+void test_link_up_while_relaxed_restarts_delay(void) {
+    controller->onStateChange(TherapyState::IDLE);
+    TEST_ASSERT_TRUE(switchesTo(BLE_CONN_PARAM_RELAX_DELAY_MS, ConnParamProfile::RELAXED));
+
+    // A phone connects on the connect-time tight parameters
+    controller->onLinkUp();
+    uint32_t t = BLE_CONN_PARAM_RELAX_DELAY_MS + 500;
+    TEST_ASSERT_TRUE(holds(t));
+    TEST_ASSERT_EQUAL(ConnParamProfile::TIGHT, controller->applied());
+    TEST_ASSERT_TRUE(switchesTo(t + BLE_CONN_PARAM_RELAX_DELAY_MS, ConnParamProfile::RELAXED));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_starts_tight_and_relaxes_after_delay);
+    RUN_TEST(test_running_tightens_immediately);
+    RUN_TEST(test_paused_relaxes_and_resume_tightens);
+    RUN_TEST(test_stop_start_churn_stays_tight);
+    RUN_TEST(test_phone_disconnect_keeps_running_policy);
+    RUN_TEST(test_low_battery_session_stays_tight);
+    RUN_TEST(test_sync_warmup_holds_tight_when_idle);
+    RUN_TEST(test_charging_skips_warmup_but_not_session);
+    RUN_TEST(test_link_up_while_relaxed_restarts_delay);
+
+    return UNITY_END();
+}
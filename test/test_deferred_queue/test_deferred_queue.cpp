@@ -0,0 +1,165 @@
+/**
+ * @file test_deferred_queue.cpp
+ * @brief Unit tests for deferred_queue.h/cpp - priorities and budgeted draining
+ */
+
+#include <unity.h>
+#include "deferred_queue.h"
+#include "../../src/deferred_queue.cpp"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static DeferredQueue* queue = nullptr;
+
+static DeferredWorkType executed[16];
+static uint8_t executedCount = 0;
+
+static void recordWork(DeferredWorkType type, uint8_t, uint8_t, uint32_t) {
+    if (executedCount < 16) {
+        executed[executedCount++] = type;
+    }
+}
+
+static constexpr uint8_t FEEDBACK_INDEX = static_cast<uint8_t>(DeferredPriority::FEEDBACK);
+static constexpr uint8_t HOUSEKEEPING_INDEX = static_cast<uint8_t>(DeferredPriority::HOUSEKEEPING);
+
+void setUp(void) {
+    queue = new DeferredQueue();
+    queue->setExecutor(recordWork);
+    executedCount = 0;
+    _mock_micros = 0;
+}
+
+void tearDown(void) {
+    delete queue;
+    queue = nullptr;
+}
+
+// =============================================================================
+// PRIORITY
+// =============================================================================
+
+void test_feedback_drains_before_housekeeping(void) {
+    queue->enqueue(DeferredWorkType::HAPTIC_HEAL);
+    queue->enqueue(DeferredWorkType::SCANNER_RESTART);
+    queue->enqueue(DeferredWorkType::HAPTIC_PULSE, 0, 30, 50);
+    queue->enqueue(DeferredWorkType::HAPTIC_DOUBLE_PULSE, 0, 50, 50);
+
+    TEST_ASSERT_EQUAL_UINT8(4, queue->processUntil(0, UINT64_MAX));
+    TEST_ASSERT_EQUAL_UINT8(4, executedCount);
+    TEST_ASSERT_EQUAL(DeferredWorkType::HAPTIC_PULSE, executed[0]);
+    TEST_ASSERT_EQUAL(DeferredWorkType::HAPTIC_DOUBLE_PULSE, executed[1]);
+    TEST_ASSERT_EQUAL(DeferredWorkType::HAPTIC_HEAL, executed[2]);
+    TEST_ASSERT_EQUAL(DeferredWorkType::SCANNER_RESTART, executed[3]);
+    TEST_ASSERT_FALSE(queue->hasPending());
+}
+
+void test_process_one_takes_highest_priority(void) {
+    queue->enqueue(DeferredWorkType::HAPTIC_HEAL);
+    queue->enqueue(DeferredWorkType::HAPTIC_DEACTIVATE, 2);
+
+    TEST_ASSERT_TRUE(queue->processOne());
+    TEST_ASSERT_EQUAL(DeferredWorkType::HAPTIC_DEACTIVATE, executed[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, queue->getPendingCount());
+}
+
+// =============================================================================
+// BUDGETED DRAINING
+// =============================================================================
+
+void test_process_until_stops_before_deadline(void) {
+    queue->enqueue(DeferredWorkType::HAPTIC_PULSE);
+    queue->enqueue(DeferredWorkType::HAPTIC_PULSE);
+    queue->enqueue(DeferredWorkType::HAPTIC_HEAL);
+
+    // Room for both pulses but not the heal
+    uint64_t now = 10000;
+    uint64_t deadline = now + 2 * DEFERRED_WORK_COST_US + DEFERRED_HEAL_COST_US - 1;
+    TEST_ASSERT_EQUAL_UINT8(2, queue->processUntil(now, deadline));
+    TEST_ASSERT_EQUAL_UINT8(1, queue->getPendingCount());
+    TEST_ASSERT_EQUAL_UINT32(1, queue->getStats().motorWaits);
+
+    // Budget left after the pulses is one microsecond short of the heal
+    uint64_t afterPulses = now + 2 * DEFERRED_WORK_COST_US;
+    TEST_ASSERT_FALSE(queue->nextFits(afterPulses, deadline));
+    TEST_ASSERT_TRUE(queue->nextFits(afterPulses, deadline + 1));
+}
+
+void test_process_until_past_deadline_runs_nothing(void) {
+    queue->enqueue(DeferredWorkType::HAPTIC_PULSE);
+    TEST_ASSERT_EQUAL_UINT8(0, queue->processUntil(5000, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, executedCount);
+    TEST_ASSERT_TRUE(queue->hasPending());
+}
+
+void test_next_fits_false_when_empty(void) {
+    TEST_ASSERT_FALSE(queue->nextFits(0, UINT64_MAX));
+    TEST_ASSERT_EQUAL_UINT8(0, queue->processUntil(0, UINT64_MAX));
+    TEST_ASSERT_EQUAL_UINT32(0, queue->getStats().motorWaits);
+}
+
+// =============================================================================
+// COUNTERS
+// =============================================================================
+
+void test_overflow_counted_per_priority(void) {
+    for (uint8_t i = 0; i < DeferredQueue::MAX_WORK - 1; i++) {
+        TEST_ASSERT_TRUE(queue->enqueue(DeferredWorkType::HAPTIC_PULSE));
+    }
+    TEST_ASSERT_FALSE(queue->enqueue(DeferredWorkType::HAPTIC_PULSE));
+    // A full feedback ring does not block housekeeping
+    TEST_ASSERT_TRUE(queue->enqueue(DeferredWorkType::HAPTIC_HEAL));
+
+    DeferredQueueStats stats = queue->getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overflows[FEEDBACK_INDEX]);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.overflows[HOUSEKEEPING_INDEX]);
+    TEST_ASSERT_EQUAL_UINT8(DeferredQueue::MAX_WORK, queue->getPendingCount());
+}
+
+void test_latency_tracks_worst_item(void) {
+    _mock_micros = 1000;
+    queue->enqueue(DeferredWorkType::HAPTIC_HEAL);
+    _mock_micros = 1500;
+    queue->enqueue(DeferredWorkType::HAPTIC_PULSE);
+
+    _mock_micros = 4000;
+    queue->processUntil(0, UINT64_MAX);
+
+    DeferredQueueStats stats = queue->getStats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.processed);
+    TEST_ASSERT_EQUAL_UINT32(3000, stats.maxLatencyUs);
+
+    queue->resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, queue->getStats().processed);
+    TEST_ASSERT_EQUAL_UINT32(0, queue->getStats().maxLatencyUs);
+}
+
+void test_clear_empties_every_priority(void) {
+    queue->enqueue(DeferredWorkType::HAPTIC_PULSE);
+    queue->enqueue(DeferredWorkType::HAPTIC_HEAL);
+    queue->clear();
+    TEST_ASSERT_FALSE(queue->hasPending());
+    TEST_ASSERT_EQUAL_UINT8(0, queue->getPendingCount());
+    TEST_ASSERT_FALSE(queue->processOne());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_feedback_drains_before_housekeeping);
+    RUN_TEST(test_process_one_takes_highest_priority);
+    RUN_TEST(test_process_until_stops_before_deadline);
+    RUN_TEST(test_process_until_past_deadline_runs_nothing);
+    RUN_TEST(test_next_fits_false_when_empty);
+    RUN_TEST(test_overflow_counted_per_priority);
+    RUN_TEST(test_latency_tracks_worst_item);
+    RUN_TEST(test_clear_empties_every_priority);
+
+    return UNITY_END();
+}
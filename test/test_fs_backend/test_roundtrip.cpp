@@ -53,6 +53,35 @@ void test_read_missing_file_fails(void) {
     TEST_ASSERT_FALSE(fsb::exists("/missing.bin"));
 }
 
+void test_append_creates_then_extends(void) {
+    const uint8_t first[] = {1, 2};
+    const uint8_t second[] = {3, 4, 5};
+    TEST_ASSERT_TRUE(fsb::begin());
+    TEST_ASSERT_TRUE(fsb::appendFile("/a.bin", first, 2));
+    TEST_ASSERT_TRUE(fsb::appendFile("/a.bin", second, 3));
+    const uint8_t expected[] = {1, 2, 3, 4, 5};
+    uint8_t buf[8];
+    size_t n = 0;
+    TEST_ASSERT_TRUE(fsb::readFile("/a.bin", buf, 8, n));
+    TEST_ASSERT_EQUAL_UINT(5, n);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, 5);
+}
+
+void test_read_at_offset(void) {
+    const uint8_t data[] = {10, 11, 12, 13, 14};
+    TEST_ASSERT_TRUE(fsb::begin());
+    TEST_ASSERT_TRUE(fsb::writeFile("/r.bin", data, 5));
+    uint8_t buf[4];
+    size_t n = 0;
+    TEST_ASSERT_TRUE(fsb::readAt("/r.bin", 3, buf, 4, n));
+    TEST_ASSERT_EQUAL_UINT(2, n);
+    TEST_ASSERT_EQUAL_UINT8(13, buf[0]);
+    TEST_ASSERT_EQUAL_UINT8(14, buf[1]);
+    TEST_ASSERT_TRUE(fsb::readAt("/r.bin", 5, buf, 4, n));
+    TEST_ASSERT_EQUAL_UINT(0, n);
+    TEST_ASSERT_FALSE(fsb::readAt("/missing.bin", 0, buf, 4, n));
+}
+
 void test_begin_can_fail(void) {
     fsb::mock::setBeginResult(false);
     TEST_ASSERT_FALSE(fsb::begin());
@@ -65,5 +94,7 @@ int main(int, char**) {
     RUN_TEST(test_remove_deletes_file);
     RUN_TEST(test_read_missing_file_fails);
     RUN_TEST(test_begin_can_fail);
+    RUN_TEST(test_append_creates_then_extends);
+    RUN_TEST(test_read_at_offset);
     return UNITY_END();
 }
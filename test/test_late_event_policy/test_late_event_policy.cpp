@@ -0,0 +1,113 @@
+/**
+ * @file test_late_event_policy.cpp
+ * @brief Unit tests for late_event_policy.h/cpp - past-due motor event handling
+ */
+
+#include <unity.h>
+#include "late_event_policy.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =============================================================================
+// DECISIONS
+// =============================================================================
+
+void test_within_threshold_executes(void) {
+    LateEventPolicy policy(LateEventAction::DROP, 5000, 3);
+    TEST_ASSERT_TRUE(policy.decide(0, true) == LateEventAction::EXECUTE);
+    TEST_ASSERT_TRUE(policy.decide(5000, true) == LateEventAction::EXECUTE);
+    TEST_ASSERT_FALSE(policy.isLate(5000));
+    TEST_ASSERT_EQUAL_UINT8(0, policy.lateRun());
+}
+
+void test_late_activation_gets_configured_action(void) {
+    LateEventPolicy drop(LateEventAction::DROP, 5000, 0);
+    TEST_ASSERT_TRUE(drop.decide(5001, true) == LateEventAction::DROP);
+
+    LateEventPolicy shift(LateEventAction::SHIFT, 5000, 0);
+    TEST_ASSERT_TRUE(shift.decide(20000, true) == LateEventAction::SHIFT);
+
+    LateEventPolicy execute(LateEventAction::EXECUTE, 5000, 0);
+    TEST_ASSERT_TRUE(execute.decide(20000, true) == LateEventAction::EXECUTE);
+}
+
+void test_late_deactivation_always_executes(void) {
+    LateEventPolicy policy(LateEventAction::DROP, 5000, 3);
+    TEST_ASSERT_TRUE(policy.decide(50000, false) == LateEventAction::EXECUTE);
+    TEST_ASSERT_TRUE(policy.isLate(50000));
+    TEST_ASSERT_EQUAL_UINT8(0, policy.lateRun());  // Only activations build a run
+}
+
+// =============================================================================
+// RESYNC
+// =============================================================================
+
+void test_late_run_requests_resync_once(void) {
+    LateEventPolicy policy(LateEventAction::DROP, 5000, 3);
+    policy.decide(9000, true);
+    policy.decide(9000, false);  // Deactivations neither extend nor break the run
+    policy.decide(9000, true);
+    TEST_ASSERT_FALSE(policy.resyncPending());
+
+    policy.decide(9000, true);
+    TEST_ASSERT_TRUE(policy.resyncPending());
+    TEST_ASSERT_EQUAL_UINT8(0, policy.lateRun());
+    TEST_ASSERT_TRUE(policy.takeResyncRequest());
+    TEST_ASSERT_FALSE(policy.takeResyncRequest());
+}
+
+void test_on_time_activation_breaks_run(void) {
+    LateEventPolicy policy(LateEventAction::DROP, 5000, 3);
+    policy.decide(9000, true);
+    policy.decide(9000, true);
+    policy.decide(100, true);
+    policy.decide(9000, true);
+    policy.decide(9000, true);
+    TEST_ASSERT_FALSE(policy.takeResyncRequest());
+    TEST_ASSERT_EQUAL_UINT8(2, policy.lateRun());
+}
+
+void test_zero_run_never_requests_and_reset_clears(void) {
+    LateEventPolicy never(LateEventAction::DROP, 5000, 0);
+    for (uint8_t i = 0; i < 50; i++) {
+        never.decide(9000, true);
+    }
+    TEST_ASSERT_FALSE(never.takeResyncRequest());
+
+    LateEventPolicy policy(LateEventAction::DROP, 5000, 2);
+    policy.decide(9000, true);
+    policy.decide(9000, true);
+    policy.reset();
+    TEST_ASSERT_FALSE(policy.takeResyncRequest());
+    TEST_ASSERT_EQUAL_UINT8(0, policy.lateRun());
+}
+
+void test_defaults_follow_config(void) {
+    LateEventPolicy policy;
+    TEST_ASSERT_EQUAL_UINT8(LATE_EVENT_POLICY, static_cast<uint8_t>(policy.action()));
+    TEST_ASSERT_EQUAL_UINT32(LATE_EVENT_THRESHOLD_US, policy.thresholdUs());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_within_threshold_executes);
+    RUN_TEST(test_late_activation_gets_configured_action);
+    RUN_TEST(test_late_deactivation_always_executes);
+    RUN_TEST(test_late_run_requests_resync_once);
+    RUN_TEST(test_on_time_activation_breaks_run);
+    RUN_TEST(test_zero_run_never_requests_and_reset_clears);
+    RUN_TEST(test_defaults_follow_config);
+
+    return UNITY_END();
+}
@@ -655,6 +655,192 @@ void test_printReport_early_count_displayed(void) {
     TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.earlyCount);
 }
 
+// =============================================================================
+// HISTOGRAM TESTS
+// =============================================================================
+
+void test_histogram_small_values_have_exact_buckets(void) {
+    for (uint32_t v = 0; v < LatencyHistogram::SUB_COUNT; v++) {
+        uint16_t b = LatencyHistogram::magnitudeBucket(v);
+        TEST_ASSERT_EQUAL_UINT32(v, LatencyHistogram::bucketLowerBound(b));
+        TEST_ASSERT_EQUAL_UINT32(v, LatencyHistogram::bucketUpperBound(b));
+    }
+}
+
+void test_histogram_bucket_bounds_contain_value(void) {
+    const uint32_t values[] = {8, 9, 15, 16, 17, 100, 999, 1000, 1024, 65535, 100000};
+    for (uint32_t v : values) {
+        uint16_t b = LatencyHistogram::magnitudeBucket(v);
+        TEST_ASSERT_TRUE(LatencyHistogram::bucketLowerBound(b) <= v);
+        TEST_ASSERT_TRUE(LatencyHistogram::bucketUpperBound(b) >= v);
+        // Relative resolution: bucket width <= value / SUB_COUNT
+        uint32_t width = LatencyHistogram::bucketUpperBound(b) - LatencyHistogram::bucketLowerBound(b) + 1;
+        TEST_ASSERT_TRUE(width * LatencyHistogram::SUB_COUNT <= v + width);
+    }
+}
+
+void test_histogram_out_of_range_clamps_to_last_bucket(void) {
+    TEST_ASSERT_EQUAL_UINT16(LatencyHistogram::SIDE_BUCKETS - 1,
+                             LatencyHistogram::magnitudeBucket(UINT32_MAX));
+    TEST_ASSERT_EQUAL_UINT16(LatencyHistogram::SIDE_BUCKETS - 1,
+                             LatencyHistogram::magnitudeBucket(1u << LatencyHistogram::MAX_BITS));
+}
+
+void test_histogram_empty_percentile_is_zero(void) {
+    LatencyHistogram h;
+    h.reset();
+    TEST_ASSERT_EQUAL_INT32(0, h.percentile(500));
+    TEST_ASSERT_EQUAL_UINT32(0, h.total);
+}
+
+void test_histogram_percentiles_expose_tail(void) {
+    LatencyHistogram h;
+    h.reset();
+    for (int i = 0; i < 990; i++) h.record(100);
+    for (int i = 0; i < 10; i++) h.record(5000);
+
+    // p50/p90 sit in the bulk; p99.9 lands on the outliers
+    int32_t p50 = h.percentile(500);
+    TEST_ASSERT_TRUE(p50 >= 100 && p50 < 113);
+    TEST_ASSERT_EQUAL_INT32(p50, h.percentile(900));
+    TEST_ASSERT_EQUAL_INT32(p50, h.percentile(990));
+    int32_t p999 = h.percentile(999);
+    TEST_ASSERT_TRUE(p999 >= 5000 && p999 < 5000 + 5000 / 8 + 1);
+}
+
+void test_histogram_negative_values_ordered_below_positive(void) {
+    LatencyHistogram h;
+    h.reset();
+    h.record(-300);
+    h.record(-20);
+    h.record(50);
+    h.record(400);
+
+    TEST_ASSERT_TRUE(h.percentile(250) < 0);
+    TEST_ASSERT_TRUE(h.percentile(250) < h.percentile(500));
+    TEST_ASSERT_TRUE(h.percentile(500) < 0);
+    TEST_ASSERT_TRUE(h.percentile(750) > 0);
+    TEST_ASSERT_TRUE(h.percentile(1000) >= 400);
+}
+
+void test_histogram_saturation_halves_counts(void) {
+    LatencyHistogram h;
+    h.reset();
+    h.record(1000);
+    for (uint32_t i = 0; i < UINT16_MAX; i++) h.record(10);
+
+    // Bucket for 10 hit UINT16_MAX and the next sample triggered a halving
+    h.record(10);
+    TEST_ASSERT_TRUE(h.total < 40000);
+    TEST_ASSERT_EQUAL_INT32(h.percentile(500), h.percentile(900));
+    TEST_ASSERT_TRUE(h.percentile(500) >= 10 && h.percentile(500) < 12);
+}
+
+void test_recordExecution_classified_bins_by_finger_type_path(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(120, 1, true, true);
+    latencyMetrics.recordExecution(480, 1, true, false);
+    latencyMetrics.recordExecution(60, 0, false, false);
+
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.driftHist[1][LatencyMetrics::EVENT_ACTIVATE]
+                                                       [LatencyMetrics::PATH_FAST].total);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.driftHist[1][LatencyMetrics::EVENT_ACTIVATE]
+                                                       [LatencyMetrics::PATH_SLOW].total);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.driftHist[0][LatencyMetrics::EVENT_DEACTIVATE]
+                                                       [LatencyMetrics::PATH_SLOW].total);
+    // Aggregates still updated
+    TEST_ASSERT_EQUAL_UINT32(3, latencyMetrics.sampleCount);
+    TEST_ASSERT_EQUAL_INT32(480, latencyMetrics.maxDrift_us);
+}
+
+void test_recordExecution_classified_disabled_records_nothing(void) {
+    latencyMetrics.recordExecution(120, 1, true, true);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.driftHist[1][0][1].total);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.sampleCount);
+}
+
+void test_recordExecution_classified_invalid_finger_only_aggregates(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(120, MAX_ACTUATORS, true, true);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.sampleCount);
+    TEST_ASSERT_EQUAL_INT32(0, latencyMetrics.getDriftPercentile(500));
+}
+
+void test_getDriftPercentile_spans_all_histograms(void) {
+    latencyMetrics.enable();
+    for (int i = 0; i < 99; i++) latencyMetrics.recordExecution(50, 0, true, true);
+    latencyMetrics.recordExecution(3000, 2, false, false);
+
+    TEST_ASSERT_TRUE(latencyMetrics.getDriftPercentile(500) < 60);
+    TEST_ASSERT_TRUE(latencyMetrics.getDriftPercentile(1000) >= 3000);
+}
+
+void test_recordRtt_and_offset_error_fill_histograms(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordRtt(8000);
+    latencyMetrics.recordOffsetError(-250);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.rttHist.total);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.offsetErrorHist.total);
+    TEST_ASSERT_TRUE(latencyMetrics.offsetErrorHist.percentile(500) < 0);
+}
+
+void test_recordSkew_tracks_magnitude(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordSkew(-300);
+    latencyMetrics.recordSkew(100);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.skewSampleCount);
+    TEST_ASSERT_EQUAL_UINT32(300, latencyMetrics.maxAbsSkew_us);
+    TEST_ASSERT_EQUAL_INT64(400, latencyMetrics.totalAbsSkew_us);
+    TEST_ASSERT_TRUE(latencyMetrics.skewHist.percentile(0) < 0);
+    TEST_ASSERT_TRUE(latencyMetrics.absSkewHist.percentile(0) > 0);
+}
+
+void test_recordSkew_ignored_when_disabled(void) {
+    latencyMetrics.recordSkew(500);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.skewSampleCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.skewHist.total);
+}
+
+void test_reset_clears_histograms(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(100, 0, true, false);
+    latencyMetrics.recordRtt(5000);
+    latencyMetrics.recordOffsetError(10);
+    latencyMetrics.recordSkew(-75);
+    latencyMetrics.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.driftHist[0][0][0].total);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.rttHist.total);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.offsetErrorHist.total);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.skewHist.total);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.skewSampleCount);
+}
+
+void test_recordLateEvent_counts_when_disabled_and_resets(void) {
+    latencyMetrics.recordLateEvent(8000, true, false);
+    latencyMetrics.recordLateEvent(12000, false, true);
+    latencyMetrics.recordLateEvent(6000, false, false);
+    TEST_ASSERT_EQUAL_UINT32(3, latencyMetrics.lateEventCount);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.droppedEventCount);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.shiftedEventCount);
+    TEST_ASSERT_EQUAL_UINT32(12000, latencyMetrics.maxLateness_us);
+    latencyMetrics.printReport();
+
+    latencyMetrics.resetLateEvents();
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.lateEventCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.maxLateness_us);
+}
+
+void test_printReport_with_histograms_no_crash(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(100, 0, true, true);
+    latencyMetrics.recordExecution(-20, 3, false, false);
+    latencyMetrics.recordRtt(9000);
+    latencyMetrics.recordOffsetError(-40);
+    latencyMetrics.recordSkew(120);
+    latencyMetrics.printReport();
+    TEST_PASS();
+}
+
 // =============================================================================
 // TEST RUNNER
 // =============================================================================
@@ -769,5 +955,24 @@ int main(int argc, char **argv) {
     RUN_TEST(test_printReport_verbose_mode_no_crash);
     RUN_TEST(test_printReport_early_count_displayed);
 
+    // Histogram Tests
+    RUN_TEST(test_histogram_small_values_have_exact_buckets);
+    RUN_TEST(test_histogram_bucket_bounds_contain_value);
+    RUN_TEST(test_histogram_out_of_range_clamps_to_last_bucket);
+    RUN_TEST(test_histogram_empty_percentile_is_zero);
+    RUN_TEST(test_histogram_percentiles_expose_tail);
+    RUN_TEST(test_histogram_negative_values_ordered_below_positive);
+    RUN_TEST(test_histogram_saturation_halves_counts);
+    RUN_TEST(test_recordExecution_classified_bins_by_finger_type_path);
+    RUN_TEST(test_recordExecution_classified_disabled_records_nothing);
+    RUN_TEST(test_recordExecution_classified_invalid_finger_only_aggregates);
+    RUN_TEST(test_getDriftPercentile_spans_all_histograms);
+    RUN_TEST(test_recordRtt_and_offset_error_fill_histograms);
+    RUN_TEST(test_recordSkew_tracks_magnitude);
+    RUN_TEST(test_recordSkew_ignored_when_disabled);
+    RUN_TEST(test_reset_clears_histograms);
+    RUN_TEST(test_recordLateEvent_counts_when_disabled_and_resets);
+    RUN_TEST(test_printReport_with_histograms_no_crash);
+
     return UNITY_END();
 }
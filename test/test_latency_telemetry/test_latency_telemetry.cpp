@@ -0,0 +1,268 @@
+/**
+ * @file test_latency_telemetry.cpp
+ * @brief Unit tests for latency_telemetry.h/cpp - Phone telemetry stream
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "latency_telemetry.h"
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static int base64Value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+// Decodes "LATS:<base64>" into out, returns decoded length (0 on error)
+static size_t decodeFrame(const char* text, uint8_t* out, size_t outSize) {
+    if (strncmp(text, "LATS:", 5) != 0) {
+        return 0;
+    }
+    const char* p = text + 5;
+    size_t len = strlen(p);
+    if (len % 4 != 0) {
+        return 0;
+    }
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 4) {
+        uint32_t chunk = 0;
+        int pad = 0;
+        for (int j = 0; j < 4; j++) {
+            chunk <<= 6;
+            if (p[i + j] == '=') {
+                pad++;
+            } else {
+                int v = base64Value(p[i + j]);
+                if (v < 0) return 0;
+                chunk |= static_cast<uint32_t>(v);
+            }
+        }
+        for (int j = 0; j < 3 - pad; j++) {
+            if (o >= outSize) return 0;
+            out[o++] = static_cast<uint8_t>(chunk >> (16 - 8 * j));
+        }
+    }
+    return o;
+}
+
+static uint16_t le16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static LatencyTelemetry* telemetry = nullptr;
+static char text[LatencyTelemetry::FRAME_TEXT_SIZE];
+static uint8_t frame[LatencyTelemetry::FRAME_MAX_BINARY];
+
+void setUp(void) {
+    static LatencyTelemetry instance;
+    instance = LatencyTelemetry();
+    telemetry = &instance;
+    mockSetMillis(1000);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// RING TESTS
+// =============================================================================
+
+void test_ring_push_peek_pop_fifo(void) {
+    LatencyTelemetryRing ring;
+    LatencyTelemetrySample s = {10, -5, 1};
+    TEST_ASSERT_TRUE(ring.push(s));
+    s.timeMs = 20;
+    TEST_ASSERT_TRUE(ring.push(s));
+    TEST_ASSERT_EQUAL_UINT8(2, ring.count());
+
+    LatencyTelemetrySample out;
+    TEST_ASSERT_TRUE(ring.peek(out));
+    TEST_ASSERT_EQUAL_UINT32(10, out.timeMs);
+    TEST_ASSERT_EQUAL_INT32(-5, out.value);
+    ring.pop();
+    TEST_ASSERT_TRUE(ring.peek(out));
+    TEST_ASSERT_EQUAL_UINT32(20, out.timeMs);
+    ring.pop();
+    TEST_ASSERT_FALSE(ring.peek(out));
+    TEST_ASSERT_EQUAL_UINT8(0, ring.count());
+}
+
+void test_ring_full_drops_and_counts(void) {
+    LatencyTelemetryRing ring;
+    LatencyTelemetrySample s = {0, 0, 0};
+    for (uint8_t i = 0; i < LatencyTelemetryRing::SIZE - 1; i++) {
+        TEST_ASSERT_TRUE(ring.push(s));
+    }
+    TEST_ASSERT_FALSE(ring.push(s));
+    TEST_ASSERT_FALSE(ring.push(s));
+    TEST_ASSERT_EQUAL_UINT16(2, ring.dropped());
+    TEST_ASSERT_EQUAL_UINT8(LatencyTelemetryRing::SIZE - 1, ring.count());
+}
+
+// =============================================================================
+// RECORDING TESTS
+// =============================================================================
+
+void test_not_streaming_records_nothing(void) {
+    telemetry->recordExecution(100, 1, true, false);
+    telemetry->recordRtt(5000);
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry->pendingCount());
+    TEST_ASSERT_EQUAL(0, telemetry->encodeFrame(text, sizeof(text)));
+}
+
+void test_start_streaming_discards_stale_samples(void) {
+    telemetry->setStreaming(true);
+    telemetry->recordExecution(100, 1, true, false);
+    telemetry->setStreaming(false);
+    telemetry->setStreaming(true);
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry->pendingCount());
+}
+
+// =============================================================================
+// FRAME TESTS
+// =============================================================================
+
+void test_encode_frame_round_trip(void) {
+    telemetry->setStreaming(true);
+    mockSetMillis(1000);
+    telemetry->recordExecution(-250, 3, true, true);
+    mockSetMillis(1005);
+    telemetry->recordRtt(12000);
+    mockSetMillis(1010);
+    telemetry->recordOffsetError(-700);
+
+    size_t len = telemetry->encodeFrame(text, sizeof(text));
+    TEST_ASSERT_EQUAL(strlen(text), len);
+    size_t n = decodeFrame(text, frame, sizeof(frame));
+    TEST_ASSERT_EQUAL(LatencyTelemetry::FRAME_HEADER_SIZE + 3 * LatencyTelemetry::SAMPLE_WIRE_SIZE, n);
+
+    TEST_ASSERT_EQUAL_UINT8(LatencyTelemetry::FRAME_VERSION, frame[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, le16(frame + 1));
+    TEST_ASSERT_EQUAL_UINT32(1000, le32(frame + 3));
+    TEST_ASSERT_EQUAL_UINT16(0, le16(frame + 7));
+    TEST_ASSERT_EQUAL_UINT8(3, frame[9]);
+
+    const uint8_t* s = frame + LatencyTelemetry::FRAME_HEADER_SIZE;
+    // Drift: kind 0, activate + fast path, finger 3
+    TEST_ASSERT_EQUAL_HEX8(0x33, s[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, le16(s + 1));
+    TEST_ASSERT_EQUAL_INT32(-250, static_cast<int32_t>(le32(s + 3)));
+    s += LatencyTelemetry::SAMPLE_WIRE_SIZE;
+    TEST_ASSERT_EQUAL_HEX8(0x40, s[0]);
+    TEST_ASSERT_EQUAL_UINT16(5, le16(s + 1));
+    TEST_ASSERT_EQUAL_INT32(12000, static_cast<int32_t>(le32(s + 3)));
+    s += LatencyTelemetry::SAMPLE_WIRE_SIZE;
+    TEST_ASSERT_EQUAL_HEX8(0x80, s[0]);
+    TEST_ASSERT_EQUAL_UINT16(10, le16(s + 1));
+    TEST_ASSERT_EQUAL_INT32(-700, static_cast<int32_t>(le32(s + 3)));
+
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry->pendingCount());
+}
+
+void test_encode_frame_merges_rings_oldest_first(void) {
+    telemetry->setStreaming(true);
+    mockSetMillis(2000);
+    telemetry->recordRtt(1);
+    mockSetMillis(2001);
+    telemetry->recordExecution(2, 0, false, false);
+    mockSetMillis(2002);
+    telemetry->recordRtt(3);
+
+    telemetry->encodeFrame(text, sizeof(text));
+    decodeFrame(text, frame, sizeof(frame));
+    const uint8_t* s = frame + LatencyTelemetry::FRAME_HEADER_SIZE;
+    for (int32_t expected = 1; expected <= 3; expected++) {
+        TEST_ASSERT_EQUAL_INT32(expected, static_cast<int32_t>(le32(s + 3)));
+        s += LatencyTelemetry::SAMPLE_WIRE_SIZE;
+    }
+}
+
+void test_encode_frame_caps_samples_and_increments_sequence(void) {
+    telemetry->setStreaming(true);
+    for (uint8_t i = 0; i < LatencyTelemetry::FRAME_MAX_SAMPLES + 5; i++) {
+        telemetry->recordExecution(i, 0, true, false);
+    }
+
+    TEST_ASSERT_TRUE(telemetry->encodeFrame(text, sizeof(text)) > 0);
+    TEST_ASSERT_TRUE(strlen(text) < MESSAGE_BUFFER_SIZE);
+    decodeFrame(text, frame, sizeof(frame));
+    TEST_ASSERT_EQUAL_UINT8(LatencyTelemetry::FRAME_MAX_SAMPLES, frame[9]);
+    TEST_ASSERT_EQUAL_UINT16(0, le16(frame + 1));
+
+    TEST_ASSERT_TRUE(telemetry->encodeFrame(text, sizeof(text)) > 0);
+    decodeFrame(text, frame, sizeof(frame));
+    TEST_ASSERT_EQUAL_UINT8(5, frame[9]);
+    TEST_ASSERT_EQUAL_UINT16(1, le16(frame + 1));
+}
+
+void test_encode_frame_reports_drops_once(void) {
+    telemetry->setStreaming(true);
+    for (uint8_t i = 0; i < LatencyTelemetryRing::SIZE + 2; i++) {
+        telemetry->recordRtt(i);
+    }
+
+    telemetry->encodeFrame(text, sizeof(text));
+    decodeFrame(text, frame, sizeof(frame));
+    TEST_ASSERT_EQUAL_UINT16(3, le16(frame + 7));
+
+    telemetry->encodeFrame(text, sizeof(text));
+    decodeFrame(text, frame, sizeof(frame));
+    TEST_ASSERT_EQUAL_UINT16(0, le16(frame + 7));
+}
+
+void test_encode_frame_rejects_small_buffer(void) {
+    telemetry->setStreaming(true);
+    telemetry->recordRtt(1);
+    char small[16];
+    TEST_ASSERT_EQUAL(0, telemetry->encodeFrame(small, sizeof(small)));
+    TEST_ASSERT_EQUAL_UINT16(1, telemetry->pendingCount());
+}
+
+void test_base64_encode_padding(void) {
+    const uint8_t data[] = {'M', 'a', 'n'};
+    char out[8];
+    TEST_ASSERT_EQUAL(4, LatencyTelemetry::base64Encode(data, 3, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("TWFu", out);
+    TEST_ASSERT_EQUAL(4, LatencyTelemetry::base64Encode(data, 2, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("TWE=", out);
+    TEST_ASSERT_EQUAL(4, LatencyTelemetry::base64Encode(data, 1, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("TQ==", out);
+    TEST_ASSERT_EQUAL(0, LatencyTelemetry::base64Encode(data, 3, out, 4));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ring_push_peek_pop_fifo);
+    RUN_TEST(test_ring_full_drops_and_counts);
+    RUN_TEST(test_not_streaming_records_nothing);
+    RUN_TEST(test_start_streaming_discards_stale_samples);
+    RUN_TEST(test_encode_frame_round_trip);
+    RUN_TEST(test_encode_frame_merges_rings_oldest_first);
+    RUN_TEST(test_encode_frame_caps_samples_and_increments_sequence);
+    RUN_TEST(test_encode_frame_reports_drops_once);
+    RUN_TEST(test_encode_frame_rejects_small_buffer);
+    RUN_TEST(test_base64_encode_padding);
+
+    return UNITY_END();
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_lead_time_controller.cpp
+ * @brief Unit tests for lead_time_controller.h/cpp - closed-loop MACROCYCLE lead
+ */
+
+#include <unity.h>
+#include "lead_time_controller.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static LeadTimeController* controller = nullptr;
+static uint32_t nextSeq = 0;
+
+static const uint32_t OPEN_LOOP_US = 60000;
+
+void setUp(void) {
+    controller = new LeadTimeController();
+    nextSeq = 0;
+}
+
+void tearDown(void) {
+    delete controller;
+    controller = nullptr;
+}
+
+// One macrocycle sent with leadUs whose delivery took delayUs
+static void deliver(uint32_t leadUs, uint32_t delayUs, uint32_t nowMs) {
+    uint32_t seq = nextSeq++;
+    controller->onSent(seq, leadUs);
+    controller->onAck(seq, static_cast<int32_t>(leadUs) - static_cast<int32_t>(delayUs));
+    controller->update(nowMs);
+}
+
+// =============================================================================
+// OPEN LOOP
+// =============================================================================
+
+void test_open_loop_until_min_samples(void) {
+    for (uint8_t i = 0; i < SYNC_SLACK_MIN_SAMPLES - 1; i++) {
+        deliver(OPEN_LOOP_US, 10000, 1000);
+        TEST_ASSERT_EQUAL_UINT32(OPEN_LOOP_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+    }
+    deliver(OPEN_LOOP_US, 10000, 1000);
+    TEST_ASSERT_TRUE(controller->active(1000));
+    TEST_ASSERT_EQUAL_UINT32(SYNC_SLACK_MIN_LEAD_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));  // 15ms, floored
+}
+
+void test_stale_feedback_falls_back_to_open_loop(void) {
+    for (uint8_t i = 0; i < SYNC_SLACK_MIN_SAMPLES; i++) {
+        deliver(OPEN_LOOP_US, 30000, 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(30000 + SYNC_SLACK_TARGET_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+    TEST_ASSERT_EQUAL_UINT32(OPEN_LOOP_US, controller->leadTimeUs(OPEN_LOOP_US, 1001 + SYNC_SLACK_STALE_MS));
+}
+
+// =============================================================================
+// CLOSED LOOP
+// =============================================================================
+
+void test_lead_tracks_delay_percentile_and_clamps(void) {
+    for (uint8_t i = 0; i < SYNC_SLACK_WINDOW; i++) {
+        deliver(OPEN_LOOP_US, 1000, 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, controller->delayPercentileUs());
+    TEST_ASSERT_EQUAL_UINT32(SYNC_SLACK_MIN_LEAD_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+
+    deliver(OPEN_LOOP_US, 400000, 1000);
+    TEST_ASSERT_EQUAL_UINT32(SYNC_MAX_LEAD_TIME_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+}
+
+void test_late_delivery_grows_lead_at_once_and_ages_out(void) {
+    for (uint8_t i = 0; i < SYNC_SLACK_WINDOW; i++) {
+        deliver(OPEN_LOOP_US, 20000, 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(20000 + SYNC_SLACK_TARGET_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+
+    // Staged 5ms after baseTime: negative slack, lead covers it next cycle
+    deliver(30000, 35000, 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, controller->lateCount());
+    TEST_ASSERT_EQUAL_INT32(-5000, controller->lastSlackUs());
+    TEST_ASSERT_EQUAL_UINT32(35000 + SYNC_SLACK_TARGET_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+
+    // Shrinks back only after a full window of normal deliveries
+    for (uint8_t i = 0; i < SYNC_SLACK_WINDOW - 1; i++) {
+        deliver(OPEN_LOOP_US, 20000, 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(35000 + SYNC_SLACK_TARGET_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+    deliver(OPEN_LOOP_US, 20000, 1000);
+    TEST_ASSERT_EQUAL_UINT32(20000 + SYNC_SLACK_TARGET_US, controller->leadTimeUs(OPEN_LOOP_US, 1000));
+}
+
+// =============================================================================
+// MATCHING / RESET
+// =============================================================================
+
+void test_unmatched_and_duplicate_acks_are_ignored(void) {
+    controller->onAck(99, 1000);  // Never sent
+    controller->update(1000);
+    TEST_ASSERT_EQUAL_UINT32(1, controller->unmatchedCount());
+    TEST_ASSERT_EQUAL_UINT8(0, controller->sampleCount());
+
+    controller->onSent(5, 50000);
+    controller->onAck(5, 40000);
+    controller->onAck(5, 40000);  // Retransmitted ACK
+    controller->update(1000);
+    TEST_ASSERT_EQUAL_UINT8(1, controller->sampleCount());
+    TEST_ASSERT_EQUAL_UINT32(10000, controller->delayPercentileUs());
+    TEST_ASSERT_EQUAL_UINT32(2, controller->unmatchedCount());
+}
+
+void test_reset_forgets_samples_and_queued_acks(void) {
+    for (uint8_t i = 0; i < SYNC_SLACK_MIN_SAMPLES; i++) {
+        deliver(OPEN_LOOP_US, 10000, 1000);
+    }
+    TEST_ASSERT_TRUE(controller->active(1000));
+
+    controller->onSent(nextSeq, OPEN_LOOP_US);
+    controller->onAck(nextSeq, 1000);
+    controller->requestReset();
+    controller->update(1000);
+    TEST_ASSERT_FALSE(controller->active(1000));
+    TEST_ASSERT_EQUAL_UINT8(0, controller->sampleCount());
+
+    controller->update(1000);  // The queued ACK went with the reset
+    TEST_ASSERT_EQUAL_UINT8(0, controller->sampleCount());
+    TEST_ASSERT_EQUAL_UINT32(0, controller->unmatchedCount());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_open_loop_until_min_samples);
+    RUN_TEST(test_stale_feedback_falls_back_to_open_loop);
+    RUN_TEST(test_lead_tracks_delay_percentile_and_clamps);
+    RUN_TEST(test_late_delivery_grows_lead_at_once_and_ages_out);
+    RUN_TEST(test_unmatched_and_duplicate_acks_are_ignored);
+    RUN_TEST(test_reset_forgets_samples_and_queued_acks);
+
+    return UNITY_END();
+}
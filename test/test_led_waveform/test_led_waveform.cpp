@@ -0,0 +1,143 @@
+/**
+ * @file test_led_waveform.cpp
+ * @brief Unit tests for led_waveform.h/cpp - LED pattern levels and change deadlines
+ */
+
+#include <unity.h>
+#include "led_waveform.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =============================================================================
+// STATIC PATTERNS
+// =============================================================================
+
+void test_static_patterns_never_change(void) {
+    uint8_t level = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, ledWaveformSample(LEDPattern::SOLID, 12345, level));
+    TEST_ASSERT_EQUAL_UINT8(LED_LEVEL_FULL, level);
+    TEST_ASSERT_EQUAL_UINT32(0, ledWaveformSample(LEDPattern::OFF, 12345, level));
+    TEST_ASSERT_EQUAL_UINT8(0, level);
+}
+
+// =============================================================================
+// BLINKS
+// =============================================================================
+
+void test_blink_phases_and_deadlines(void) {
+    uint8_t level = 0;
+    TEST_ASSERT_EQUAL_UINT32(LED_BLINK_SLOW_ON_MS, ledWaveformSample(LEDPattern::BLINK_SLOW, 0, level));
+    TEST_ASSERT_EQUAL_UINT8(LED_LEVEL_FULL, level);
+
+    TEST_ASSERT_EQUAL_UINT32(1, ledWaveformSample(LEDPattern::BLINK_SLOW, LED_BLINK_SLOW_ON_MS - 1, level));
+    TEST_ASSERT_EQUAL_UINT8(LED_LEVEL_FULL, level);
+
+    TEST_ASSERT_EQUAL_UINT32(LED_BLINK_SLOW_OFF_MS,
+                             ledWaveformSample(LEDPattern::BLINK_SLOW, LED_BLINK_SLOW_ON_MS, level));
+    TEST_ASSERT_EQUAL_UINT8(0, level);
+
+    // Periodic: a later cycle starts ON again
+    uint32_t period = LED_BLINK_URGENT_ON_MS + LED_BLINK_URGENT_OFF_MS;
+    ledWaveformSample(LEDPattern::BLINK_URGENT, 7 * period + 1, level);
+    TEST_ASSERT_EQUAL_UINT8(LED_LEVEL_FULL, level);
+}
+
+void test_double_blink_sequence(void) {
+    uint8_t level = 0;
+    TEST_ASSERT_EQUAL_UINT32(150, ledWaveformSample(LEDPattern::DOUBLE_BLINK, 0, level));
+    TEST_ASSERT_EQUAL_UINT8(LED_LEVEL_FULL, level);
+    TEST_ASSERT_EQUAL_UINT32(150, ledWaveformSample(LEDPattern::DOUBLE_BLINK, 150, level));
+    TEST_ASSERT_EQUAL_UINT8(0, level);
+    TEST_ASSERT_EQUAL_UINT32(100, ledWaveformSample(LEDPattern::DOUBLE_BLINK, 350, level));
+    TEST_ASSERT_EQUAL_UINT8(LED_LEVEL_FULL, level);
+    TEST_ASSERT_EQUAL_UINT32(800, ledWaveformSample(LEDPattern::DOUBLE_BLINK, 450, level));
+    TEST_ASSERT_EQUAL_UINT8(0, level);
+}
+
+// =============================================================================
+// BREATHE / PULSE
+// =============================================================================
+
+void test_breathe_floor_peak_and_symmetry(void) {
+    uint8_t start = 0;
+    uint8_t peak = 0;
+    uint8_t quarter = 0;
+    uint8_t threeQuarter = 0;
+    ledWaveformSample(LEDPattern::BREATHE_SLOW, 0, start);
+    ledWaveformSample(LEDPattern::BREATHE_SLOW, LED_BREATHE_SLOW_MS / 2, peak);
+    ledWaveformSample(LEDPattern::BREATHE_SLOW, LED_BREATHE_SLOW_MS / 4, quarter);
+    ledWaveformSample(LEDPattern::BREATHE_SLOW, 3 * LED_BREATHE_SLOW_MS / 4, threeQuarter);
+
+    TEST_ASSERT_EQUAL_UINT8(26, start);  // 10% visibility floor
+    TEST_ASSERT_EQUAL_UINT8(LED_LEVEL_FULL, peak);
+    TEST_ASSERT_EQUAL_UINT8(quarter, threeQuarter);
+}
+
+void test_breathe_deadline_lands_on_next_step(void) {
+    // Walking the returned deadlines visits every step once per cycle
+    uint32_t t = 0;
+    uint8_t steps = 0;
+    while (t < LED_PULSE_SLOW_MS) {
+        uint8_t level;
+        uint32_t delayMs = ledWaveformSample(LEDPattern::PULSE_SLOW, t, level);
+        TEST_ASSERT_TRUE(delayMs > 0);
+        TEST_ASSERT_TRUE(delayMs <= LED_PULSE_SLOW_MS / LED_WAVEFORM_STEPS + 1);
+        t += delayMs;
+        steps++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(LED_PULSE_SLOW_MS, t);
+    TEST_ASSERT_EQUAL_UINT8(LED_WAVEFORM_STEPS, steps);
+}
+
+// =============================================================================
+// QUANTIZATION
+// =============================================================================
+
+void test_scale_and_wire_level(void) {
+    TEST_ASSERT_EQUAL_UINT8(255, ledWaveformScale(255, LED_LEVEL_FULL));
+    TEST_ASSERT_EQUAL_UINT8(0, ledWaveformScale(255, 0));
+    TEST_ASSERT_EQUAL_UINT8(64, ledWaveformScale(128, 128));
+
+    TEST_ASSERT_EQUAL_UINT8(200, ledWireLevel(200, 255));
+    TEST_ASSERT_EQUAL_UINT8(4, ledWireLevel(255, 4));
+    TEST_ASSERT_EQUAL_UINT8(0, ledWireLevel(51, 4));
+}
+
+void test_breathe_has_few_wire_levels_at_default_brightness(void) {
+    uint8_t distinct = 0;
+    int last = -1;
+    for (uint32_t t = 0; t < LED_BREATHE_SLOW_MS; t++) {
+        uint8_t level;
+        ledWaveformSample(LEDPattern::BREATHE_SLOW, t, level);
+        int wire = ledWireLevel(ledWaveformScale(255, level), LED_BRIGHTNESS);
+        if (wire != last) {
+            distinct++;
+            last = wire;
+        }
+    }
+    TEST_ASSERT_TRUE(distinct <= 2 * (LED_BRIGHTNESS + 1));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_static_patterns_never_change);
+    RUN_TEST(test_blink_phases_and_deadlines);
+    RUN_TEST(test_double_blink_sequence);
+    RUN_TEST(test_breathe_floor_peak_and_symmetry);
+    RUN_TEST(test_breathe_deadline_lands_on_next_step);
+    RUN_TEST(test_scale_and_wire_level);
+    RUN_TEST(test_breathe_has_few_wire_levels_at_default_brightness);
+
+    return UNITY_END();
+}
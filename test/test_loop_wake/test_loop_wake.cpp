@@ -0,0 +1,83 @@
+/**
+ * @file test_loop_wake.cpp
+ * @brief Unit tests for loop_wake.h - Nearest loop() deadline
+ *
+ * The FreeRTOS wake set is not built natively; only the pure LoopDeadline
+ * policy is covered here.
+ */
+
+#include <unity.h>
+#include "loop_wake.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint32_t NOW_MS = 100000;
+static constexpr uint32_t CAP_MS = 100;
+
+// =============================================================================
+// DEADLINE TESTS
+// =============================================================================
+
+void test_no_deadlines_waits_the_cap(void) {
+    LoopDeadline deadline(NOW_MS, CAP_MS);
+    TEST_ASSERT_EQUAL_UINT32(CAP_MS, deadline.timeoutMs());
+}
+
+void test_nearest_deadline_wins(void) {
+    LoopDeadline deadline(NOW_MS, CAP_MS);
+    deadline.at(NOW_MS + 40);
+    deadline.at(NOW_MS + 15);
+    deadline.at(NOW_MS + 60);
+    TEST_ASSERT_EQUAL_UINT32(15, deadline.timeoutMs());
+}
+
+void test_deadline_beyond_cap_keeps_cap(void) {
+    LoopDeadline deadline(NOW_MS, CAP_MS);
+    deadline.at(NOW_MS + CAP_MS + 500);
+    TEST_ASSERT_EQUAL_UINT32(CAP_MS, deadline.timeoutMs());
+}
+
+void test_due_or_overdue_does_not_block(void) {
+    LoopDeadline due(NOW_MS, CAP_MS);
+    due.at(NOW_MS);
+    TEST_ASSERT_EQUAL_UINT32(0, due.timeoutMs());
+
+    LoopDeadline overdue(NOW_MS, CAP_MS);
+    overdue.every(NOW_MS - 6000, 5000);
+    TEST_ASSERT_EQUAL_UINT32(0, overdue.timeoutMs());
+}
+
+void test_now_overrides_later_deadlines(void) {
+    LoopDeadline deadline(NOW_MS, CAP_MS);
+    deadline.now();
+    deadline.at(NOW_MS + 10);
+    TEST_ASSERT_EQUAL_UINT32(0, deadline.timeoutMs());
+}
+
+void test_periodic_timer_across_millis_wrap(void) {
+    uint32_t now = 0xFFFFFFF0u;
+    LoopDeadline deadline(now, CAP_MS);
+    deadline.every(now - 980, 1000);  // Due at 0x00000004
+    TEST_ASSERT_EQUAL_UINT32(20, deadline.timeoutMs());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_no_deadlines_waits_the_cap);
+    RUN_TEST(test_nearest_deadline_wins);
+    RUN_TEST(test_deadline_beyond_cap_keeps_cap);
+    RUN_TEST(test_due_or_overdue_does_not_block);
+    RUN_TEST(test_now_overrides_later_deadlines);
+    RUN_TEST(test_periodic_timer_across_millis_wrap);
+
+    return UNITY_END();
+}
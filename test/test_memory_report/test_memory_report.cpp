@@ -0,0 +1,96 @@
+/**
+ * @file test_memory_report.cpp
+ * @brief Unit tests for memory_report.h/cpp - footprint and heap accounting
+ */
+
+#include <unity.h>
+#include "memory_report.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static MemoryReport report;
+
+void setUp(void) {
+    report = MemoryReport();
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_static_total_excludes_stack_temporaries(void) {
+    TEST_ASSERT_TRUE(report.addRegion("a", 6144));
+    TEST_ASSERT_TRUE(report.addTemporary("SyncCommand", 400));
+    TEST_ASSERT_TRUE(report.addRegion("b", 1024));
+
+    TEST_ASSERT_EQUAL_UINT32(7168, report.staticBytes());
+    TEST_ASSERT_EQUAL_UINT8(3, report.regionCount());
+    TEST_ASSERT_TRUE(report.region(1).stackTemporary);
+    TEST_ASSERT_EQUAL_UINT32(400, report.region(1).bytes);
+}
+
+void test_region_table_full_rejects(void) {
+    for (uint8_t i = 0; i < MemoryReport::MAX_REGIONS; i++) {
+        TEST_ASSERT_TRUE(report.addRegion("r", 1));
+    }
+    TEST_ASSERT_FALSE(report.addRegion("overflow", 100));
+    TEST_ASSERT_FALSE(report.addTemporary("overflow", 100));
+    TEST_ASSERT_EQUAL_UINT32(MemoryReport::MAX_REGIONS, report.staticBytes());
+}
+
+void test_task_table_full_rejects(void) {
+    for (uint8_t i = 0; i < MemoryReport::MAX_TASKS; i++) {
+        TEST_ASSERT_TRUE(report.addTask("t", nullptr, 2048));
+    }
+    TEST_ASSERT_FALSE(report.addTask("overflow", nullptr, 2048));
+    TEST_ASSERT_EQUAL_UINT8(MemoryReport::MAX_TASKS, report.taskCount());
+}
+
+void test_heap_minimum_unknown_before_sample(void) {
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, report.heapMinFreeBytes());
+}
+
+void test_heap_minimum_tracks_lowest_sample(void) {
+    // No port low-water mark (nRF52): the sampled free heap is the minimum
+    report.recordHeap(40000, UINT32_MAX);
+    report.recordHeap(31000, UINT32_MAX);
+    report.recordHeap(38000, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(31000, report.heapMinFreeBytes());
+}
+
+void test_heap_minimum_prefers_port_low_water_mark(void) {
+    // ESP-IDF saw a dip between samples
+    report.recordHeap(200000, 150000);
+    TEST_ASSERT_EQUAL_UINT32(150000, report.heapMinFreeBytes());
+    report.recordHeap(190000, 150000);
+    TEST_ASSERT_EQUAL_UINT32(150000, report.heapMinFreeBytes());
+}
+
+void test_print_report_handles_unresolved_tasks(void) {
+    report.addRegion("a", 512);
+    report.addTask("BLE", nullptr, 0);  // Not found on the native build
+    report.printReport();
+    TEST_ASSERT_EQUAL_UINT32(512, report.staticBytes());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_static_total_excludes_stack_temporaries);
+    RUN_TEST(test_region_table_full_rejects);
+    RUN_TEST(test_task_table_full_rejects);
+    RUN_TEST(test_heap_minimum_unknown_before_sample);
+    RUN_TEST(test_heap_minimum_tracks_lowest_sample);
+    RUN_TEST(test_heap_minimum_prefers_port_low_water_mark);
+    RUN_TEST(test_print_report_handles_unresolved_tasks);
+
+    return UNITY_END();
+}
@@ -33,6 +33,7 @@ void test_StagedMotorEvent_default_constructor(void) {
     TEST_ASSERT_EQUAL_UINT16(0, event.durationMs);
     TEST_ASSERT_EQUAL_UINT16(0, event.frequencyHz);
     TEST_ASSERT_FALSE(event.isMacrocycleLast);
+    TEST_ASSERT_FALSE(event.replacesQueue);
     TEST_ASSERT_FALSE(event.valid);
 }
 
@@ -44,6 +45,7 @@ void test_StagedMotorEvent_clear(void) {
     event.durationMs = 100;
     event.frequencyHz = 250;
     event.isMacrocycleLast = true;
+    event.replacesQueue = true;
     event.valid = true;
 
     event.clear();
@@ -54,6 +56,7 @@ void test_StagedMotorEvent_clear(void) {
     TEST_ASSERT_EQUAL_UINT16(0, event.durationMs);
     TEST_ASSERT_EQUAL_UINT16(0, event.frequencyHz);
     TEST_ASSERT_FALSE(event.isMacrocycleLast);
+    TEST_ASSERT_FALSE(event.replacesQueue);
     TEST_ASSERT_FALSE(event.valid);
 }
 
@@ -229,6 +232,42 @@ void test_MotorEventBuffer_full_macrocycle_batch(void) {
     TEST_ASSERT_FALSE(buffer.isMacrocyclePending());
 }
 
+void test_MotorEventBuffer_replacesQueue_marks_first_event_only(void) {
+    buffer.stage(500000, 0, 100, 50, 250, false);  // Stray single activation
+    buffer.beginMacrocycle();
+    buffer.stage(1000000, 1, 100, 50, 250, false);
+    buffer.stage(1100000, 2, 100, 50, 250, true);
+
+    StagedMotorEvent event;
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_FALSE(event.replacesQueue);
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_TRUE(event.replacesQueue);
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_FALSE(event.replacesQueue);
+}
+
+void test_MotorEventBuffer_mid_batch_drain_replaces_once(void) {
+    // Consumer drains while the producer is still staging the batch
+    buffer.beginMacrocycle();
+    buffer.stage(1000000, 0, 100, 50, 250, false);
+
+    StagedMotorEvent event;
+    uint8_t replaces = 0;
+    while (buffer.unstage(event)) {
+        if (event.replacesQueue) replaces++;
+    }
+    TEST_ASSERT_TRUE(buffer.isMacrocyclePending());
+
+    buffer.stage(1100000, 1, 100, 50, 250, false);
+    buffer.stage(1200000, 2, 100, 50, 250, true);
+    while (buffer.unstage(event)) {
+        if (event.replacesQueue) replaces++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(1, replaces);
+    TEST_ASSERT_FALSE(buffer.isMacrocyclePending());
+}
+
 // =============================================================================
 // CLEAR TESTS
 // =============================================================================
@@ -367,6 +406,8 @@ int main(int argc, char **argv) {
     RUN_TEST(test_MotorEventBuffer_beginMacrocycle_sets_pending);
     RUN_TEST(test_MotorEventBuffer_isMacrocycleLast_clears_pending);
     RUN_TEST(test_MotorEventBuffer_full_macrocycle_batch);
+    RUN_TEST(test_MotorEventBuffer_replacesQueue_marks_first_event_only);
+    RUN_TEST(test_MotorEventBuffer_mid_batch_drain_replaces_once);
 
     // Clear tests
     RUN_TEST(test_MotorEventBuffer_clear);
@@ -0,0 +1,180 @@
+/**
+ * @file test_motor_health.cpp
+ * @brief Unit tests for motor_health.h/cpp - sliced readback and fault tracking
+ */
+
+#include <unity.h>
+#include "motor_health.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static MotorHealthMonitor* monitor = nullptr;
+
+static constexpr uint8_t MODE_REALTIME = 0x05;
+static constexpr uint8_t MODE_POR_DEFAULT = 0x40;
+static constexpr uint8_t FEEDBACK_LRA = 0xB6;    // N_ERM_LRA set
+static constexpr uint8_t STATUS_OK = 0xE0;       // DRV2605L device ID, no flags
+
+void setUp(void) {
+    monitor = new MotorHealthMonitor();
+    monitor->begin(0x03);  // F0 + F1
+}
+
+void tearDown(void) {
+    delete monitor;
+    monitor = nullptr;
+}
+
+static void recordBad(uint8_t finger, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        monitor->recordRead(finger, MotorHealthCheck::STATUS, 0xFF);  // Absent chip
+    }
+}
+
+static void recordGood(uint8_t finger, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        monitor->recordRead(finger, MotorHealthCheck::MODE, MODE_REALTIME);
+    }
+}
+
+// =============================================================================
+// VERDICTS
+// =============================================================================
+
+void test_judge_registers(void) {
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::OK, MotorHealthMonitor::judge(MotorHealthCheck::STATUS, STATUS_OK));
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::FAULT, MotorHealthMonitor::judge(MotorHealthCheck::STATUS, 0xE2));
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::OK, MotorHealthMonitor::judge(MotorHealthCheck::MODE, MODE_REALTIME));
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::RESET, MotorHealthMonitor::judge(MotorHealthCheck::MODE, MODE_POR_DEFAULT));
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::FAULT, MotorHealthMonitor::judge(MotorHealthCheck::MODE, 0xFF));
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::OK, MotorHealthMonitor::judge(MotorHealthCheck::FEEDBACK, FEEDBACK_LRA));
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::RESET, MotorHealthMonitor::judge(MotorHealthCheck::FEEDBACK, 0x36));
+}
+
+// =============================================================================
+// SLICING
+// =============================================================================
+
+void test_round_robin_one_register_per_slice(void) {
+    MotorHealthSlice slice;
+    const MotorHealthCheck order[] = {MotorHealthCheck::STATUS, MotorHealthCheck::MODE, MotorHealthCheck::FEEDBACK};
+    for (uint8_t finger = 0; finger < 2; finger++) {
+        for (uint8_t i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE(monitor->nextSlice(MOTOR_HEALTH_SLICE_BUDGET_US, slice));
+            TEST_ASSERT_FALSE(slice.heal);
+            TEST_ASSERT_EQUAL_UINT8(finger, slice.finger);
+            TEST_ASSERT_EQUAL(order[i], slice.check);
+        }
+    }
+    // Unwatched motors are skipped: back to F0
+    TEST_ASSERT_TRUE(monitor->nextSlice(MOTOR_HEALTH_SLICE_BUDGET_US, slice));
+    TEST_ASSERT_EQUAL_UINT8(0, slice.finger);
+}
+
+void test_no_slice_without_budget(void) {
+    MotorHealthSlice slice;
+    TEST_ASSERT_FALSE(monitor->nextSlice(MOTOR_HEALTH_SLICE_BUDGET_US - 1, slice));
+
+    MotorHealthMonitor idle;
+    TEST_ASSERT_FALSE(idle.nextSlice(UINT32_MAX, slice));  // Nothing watched
+}
+
+void test_reset_queues_heal_for_large_gap(void) {
+    TEST_ASSERT_EQUAL(MotorHealthVerdict::RESET,
+                      monitor->recordRead(1, MotorHealthCheck::FEEDBACK, 0x36));
+    TEST_ASSERT_EQUAL_UINT32(1, monitor->counters(1).resets);
+
+    // A short gap skips the reset motor and keeps reading the others
+    MotorHealthSlice slice;
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(monitor->nextSlice(MOTOR_HEALTH_SLICE_BUDGET_US, slice));
+        TEST_ASSERT_FALSE(slice.heal);
+        TEST_ASSERT_EQUAL_UINT8(0, slice.finger);
+    }
+
+    // A gap with room runs the reconfigure
+    TEST_ASSERT_TRUE(monitor->nextSlice(MOTOR_HEALTH_HEAL_COST_US, slice));
+    TEST_ASSERT_TRUE(slice.heal);
+    TEST_ASSERT_EQUAL_UINT8(1, slice.finger);
+
+    // Bus busy: still queued
+    monitor->recordHeal(1, false);
+    TEST_ASSERT_TRUE(monitor->nextSlice(MOTOR_HEALTH_HEAL_COST_US, slice));
+    TEST_ASSERT_TRUE(slice.heal);
+
+    monitor->recordHeal(1, true);
+    TEST_ASSERT_EQUAL_UINT32(1, monitor->counters(1).heals);
+    TEST_ASSERT_TRUE(monitor->nextSlice(MOTOR_HEALTH_HEAL_COST_US, slice));
+    TEST_ASSERT_FALSE(slice.heal);
+}
+
+// =============================================================================
+// FAILURE / RECOVERY
+// =============================================================================
+
+void test_repeated_faults_fail_motor(void) {
+    recordBad(0, MOTOR_HEALTH_FAIL_THRESHOLD - 1);
+    TEST_ASSERT_EQUAL_UINT8(0, monitor->failedMask());
+
+    recordBad(0, 1);
+    TEST_ASSERT_EQUAL_HEX8(0x01, monitor->failedMask());
+    TEST_ASSERT_TRUE(monitor->counters(0).failed);
+    TEST_ASSERT_EQUAL_UINT32(1, monitor->counters(0).failures);
+    TEST_ASSERT_EQUAL_UINT32(MOTOR_HEALTH_FAIL_THRESHOLD, monitor->counters(0).errors);
+}
+
+void test_isolated_fault_does_not_fail_motor(void) {
+    recordBad(0, MOTOR_HEALTH_FAIL_THRESHOLD - 1);
+    recordGood(0, 1);
+    recordBad(0, MOTOR_HEALTH_FAIL_THRESHOLD - 1);
+    TEST_ASSERT_EQUAL_UINT8(0, monitor->failedMask());
+}
+
+void test_failed_motor_recovers_after_clean_streak(void) {
+    recordBad(1, MOTOR_HEALTH_FAIL_THRESHOLD);
+    TEST_ASSERT_EQUAL_HEX8(0x02, monitor->failedMask());
+
+    recordGood(1, MOTOR_HEALTH_RECOVER_READS - 1);
+    recordBad(1, 1);  // Streak broken
+    recordGood(1, MOTOR_HEALTH_RECOVER_READS - 1);
+    TEST_ASSERT_EQUAL_HEX8(0x02, monitor->failedMask());
+
+    recordGood(1, 1);
+    TEST_ASSERT_EQUAL_UINT8(0, monitor->failedMask());
+    TEST_ASSERT_FALSE(monitor->counters(1).failed);
+    TEST_ASSERT_EQUAL_UINT32(1, monitor->counters(1).failures);
+}
+
+void test_slice_time_overrun_counted(void) {
+    MotorHealthSlice read = {0, false, MotorHealthCheck::STATUS};
+    MotorHealthSlice heal = {0, true, MotorHealthCheck::STATUS};
+    monitor->recordSliceTime(read, MOTOR_HEALTH_SLICE_BUDGET_US);
+    monitor->recordSliceTime(heal, MOTOR_HEALTH_SLICE_BUDGET_US + 1);
+    TEST_ASSERT_EQUAL_UINT32(0, monitor->overrunCount());
+
+    monitor->recordSliceTime(read, MOTOR_HEALTH_SLICE_BUDGET_US + 1);
+    TEST_ASSERT_EQUAL_UINT32(1, monitor->overrunCount());
+    TEST_ASSERT_EQUAL_UINT32(3, monitor->sliceCount());
+    monitor->printReport();
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_judge_registers);
+    RUN_TEST(test_round_robin_one_register_per_slice);
+    RUN_TEST(test_no_slice_without_budget);
+    RUN_TEST(test_reset_queues_heal_for_large_gap);
+    RUN_TEST(test_repeated_faults_fail_motor);
+    RUN_TEST(test_isolated_fault_does_not_fail_motor);
+    RUN_TEST(test_failed_motor_recovers_after_clean_streak);
+    RUN_TEST(test_slice_time_overrun_counted);
+
+    return UNITY_END();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test_perf_profile.cpp
+ * @brief Unit tests for perf_profile.h/cpp - per-scope cycle statistics
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "perf_profile.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static PerfProfile profile;
+
+void setUp(void) {
+    profile.reset();
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_empty_scope_reports_zero(void) {
+    PerfScopeStats stats = profile.get(PerfScope::ON_BLE_MESSAGE);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.minCycles);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.maxCycles);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.avgCycles());
+}
+
+void test_record_tracks_min_max_avg(void) {
+    profile.record(PerfScope::EXECUTE_MOTOR_EVENT, 300);
+    profile.record(PerfScope::EXECUTE_MOTOR_EVENT, 100);
+    profile.record(PerfScope::EXECUTE_MOTOR_EVENT, 500);
+
+    PerfScopeStats stats = profile.get(PerfScope::EXECUTE_MOTOR_EVENT);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.minCycles);
+    TEST_ASSERT_EQUAL_UINT32(500, stats.maxCycles);
+    TEST_ASSERT_EQUAL_UINT32(300, stats.avgCycles());
+}
+
+void test_scopes_are_independent(void) {
+    profile.record(PerfScope::GENERATE_MACROCYCLE, 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, profile.get(PerfScope::GENERATE_MACROCYCLE).count);
+    TEST_ASSERT_EQUAL_UINT32(0, profile.get(PerfScope::DESERIALIZE_MACROCYCLE).count);
+}
+
+void test_total_does_not_overflow_32_bits(void) {
+    profile.record(PerfScope::PROCESS_TX_QUEUE, 0xF0000000u);
+    profile.record(PerfScope::PROCESS_TX_QUEUE, 0xF0000000u);
+    TEST_ASSERT_EQUAL_UINT32(0xF0000000u, profile.get(PerfScope::PROCESS_TX_QUEUE).avgCycles());
+}
+
+void test_out_of_range_scope_is_ignored(void) {
+    profile.record(PerfScope::COUNT, 42);
+    TEST_ASSERT_EQUAL_UINT32(0, profile.get(PerfScope::COUNT).count);
+    TEST_ASSERT_EQUAL_STRING("?", PerfProfile::scopeName(PerfScope::COUNT));
+}
+
+void test_reset_clears_every_scope(void) {
+    for (uint8_t i = 0; i < PerfProfile::SCOPE_COUNT; i++) {
+        profile.record(static_cast<PerfScope>(i), 10);
+    }
+    profile.reset();
+    for (uint8_t i = 0; i < PerfProfile::SCOPE_COUNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, profile.get(static_cast<PerfScope>(i)).count);
+    }
+}
+
+void test_scope_names(void) {
+    TEST_ASSERT_EQUAL_STRING("executeMotorEvent", PerfProfile::scopeName(PerfScope::EXECUTE_MOTOR_EVENT));
+    TEST_ASSERT_EQUAL_STRING("deserializeMacrocycle",
+                             PerfProfile::scopeName(PerfScope::DESERIALIZE_MACROCYCLE));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_scope_reports_zero);
+    RUN_TEST(test_record_tracks_min_max_avg);
+    RUN_TEST(test_scopes_are_independent);
+    RUN_TEST(test_total_does_not_overflow_32_bits);
+    RUN_TEST(test_out_of_range_scope_is_ignored);
+    RUN_TEST(test_reset_clears_every_scope);
+    RUN_TEST(test_scope_names);
+
+    return UNITY_END();
+}
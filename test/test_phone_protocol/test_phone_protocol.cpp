@@ -0,0 +1,179 @@
+/**
+ * @file test_phone_protocol.cpp
+ * @brief Unit tests for phone_protocol.h/cpp - v3 binary phone responses
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "phone_protocol.h"
+
+static char frame[128];
+static PhoneFrameWriter writer;
+static PhoneFrameReader reader;
+
+void setUp(void) {
+    memset(frame, 0, sizeof(frame));
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// NEGOTIATION TESTS
+// =============================================================================
+
+void test_identify_negotiation(void) {
+    TEST_ASSERT_EQUAL_UINT8(PHONE_PROTOCOL_TEXT, phoneProtocolFromIdentify("IDENTIFY:PHONE", PHONE_PROTOCOL_BINARY));
+    TEST_ASSERT_EQUAL_UINT8(PHONE_PROTOCOL_BINARY, phoneProtocolFromIdentify("IDENTIFY:PHONE:3", PHONE_PROTOCOL_BINARY));
+    // Newer phones are capped to what this build speaks; disabled v3 falls back to text
+    TEST_ASSERT_EQUAL_UINT8(PHONE_PROTOCOL_BINARY, phoneProtocolFromIdentify("IDENTIFY:PHONE:9", PHONE_PROTOCOL_BINARY));
+    TEST_ASSERT_EQUAL_UINT8(PHONE_PROTOCOL_TEXT, phoneProtocolFromIdentify("IDENTIFY:PHONE:3", PHONE_PROTOCOL_TEXT));
+    TEST_ASSERT_EQUAL_UINT8(PHONE_PROTOCOL_TEXT, phoneProtocolFromIdentify("IDENTIFY:PHONE:1", PHONE_PROTOCOL_BINARY));
+}
+
+void test_identify_rejects_other_messages(void) {
+    TEST_ASSERT_EQUAL_UINT8(0, phoneProtocolFromIdentify("IDENTIFY:SECONDARY", PHONE_PROTOCOL_BINARY));
+    TEST_ASSERT_EQUAL_UINT8(0, phoneProtocolFromIdentify("IDENTIFY:PHONEX", PHONE_PROTOCOL_BINARY));
+    TEST_ASSERT_EQUAL_UINT8(0, phoneProtocolFromIdentify("IDENTIFY:PHONE:", PHONE_PROTOCOL_BINARY));
+    TEST_ASSERT_EQUAL_UINT8(0, phoneProtocolFromIdentify("IDENTIFY:PHONE:3x", PHONE_PROTOCOL_BINARY));
+    TEST_ASSERT_EQUAL_UINT8(0, phoneProtocolFromIdentify(nullptr, PHONE_PROTOCOL_BINARY));
+}
+
+void test_field_keys_match_text_protocol(void) {
+    TEST_ASSERT_EQUAL_STRING("ERROR", phoneFieldKey(PhoneField::ERROR_TEXT));
+    TEST_ASSERT_EQUAL_STRING("DEBUG", phoneFieldKey(PhoneField::DEBUG_MODE));
+    TEST_ASSERT_EQUAL_STRING("BATS", phoneFieldKey(PhoneField::BATS));
+    TEST_ASSERT_EQUAL_STRING("LATENCY_STREAM", phoneFieldKey(PhoneField::LATENCY_STREAM));
+    TEST_ASSERT_EQUAL_STRING("DATA", phoneFieldKey(PhoneField::DATA));
+    TEST_ASSERT_EQUAL_STRING("SCOPE", phoneFieldKey(PhoneField::SCOPE));
+}
+
+// =============================================================================
+// FRAME TESTS
+// =============================================================================
+
+void test_frame_round_trip(void) {
+    writer.begin(frame, sizeof(frame), 6);
+    TEST_ASSERT_TRUE(writer.putInt(PhoneField::FREQ, 250));
+    TEST_ASSERT_TRUE(writer.putFixed(PhoneField::BATP, 3.87f, 2));
+    TEST_ASSERT_TRUE(writer.putBool(PhoneField::MIRROR, true));
+    TEST_ASSERT_TRUE(writer.putIdString(PhoneField::PROFILE, 2, "Noisy vCR"));
+    TEST_ASSERT_EQUAL_UINT8(PHONE_V3_MARKER, static_cast<uint8_t>(frame[0]));
+
+    TEST_ASSERT_TRUE(reader.open(frame, writer.length()));
+    TEST_ASSERT_EQUAL_UINT8(6, reader.command());
+    TEST_ASSERT_EQUAL_UINT8(0, reader.flags());
+
+    PhoneField field;
+    const uint8_t* value;
+    uint8_t len;
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_TRUE(field == PhoneField::FREQ);
+    TEST_ASSERT_EQUAL_UINT8(2, len);
+    TEST_ASSERT_EQUAL_INT32(250, PhoneFrameReader::intValue(value, len));
+
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_TRUE(field == PhoneField::BATP);
+    TEST_ASSERT_EQUAL_INT32(387, PhoneFrameReader::intValue(value, len));
+
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_TRUE(field == PhoneField::MIRROR);
+    TEST_ASSERT_EQUAL_UINT8(1, len);
+    TEST_ASSERT_EQUAL_UINT8(1, value[0]);
+
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_TRUE(field == PhoneField::PROFILE);
+    TEST_ASSERT_EQUAL_UINT8(10, len);
+    TEST_ASSERT_EQUAL_UINT8(2, value[0]);
+    TEST_ASSERT_EQUAL_MEMORY("Noisy vCR", value + 1, 9);
+
+    TEST_ASSERT_FALSE(reader.next(field, value, len));
+}
+
+void test_frame_has_no_transport_bytes(void) {
+    // Values that whiten/escape into NUL, EOT, CR and ESC
+    writer.begin(frame, sizeof(frame), 0x80, PHONE_V3_FLAG_ERROR);
+    TEST_ASSERT_TRUE(writer.putInt(PhoneField::ELAPSED, static_cast<int32_t>(0x8D8480)));
+    TEST_ASSERT_TRUE(writer.putString(PhoneField::ERROR_TEXT, "\x9B\x04\r"));
+
+    size_t len = writer.length();
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = static_cast<uint8_t>(frame[i]);
+        TEST_ASSERT_TRUE(b != 0x00 && b != 0x04 && b != '\r');
+    }
+    TEST_ASSERT_EQUAL_UINT32(len, strlen(frame));
+
+    TEST_ASSERT_TRUE(reader.open(frame, len));
+    TEST_ASSERT_EQUAL_UINT8(0x80, reader.command());
+    TEST_ASSERT_EQUAL_UINT8(PHONE_V3_FLAG_ERROR, reader.flags());
+    PhoneField field;
+    const uint8_t* value;
+    uint8_t vlen;
+    TEST_ASSERT_TRUE(reader.next(field, value, vlen));
+    TEST_ASSERT_EQUAL_INT32(0x8D8480, PhoneFrameReader::intValue(value, vlen));
+    TEST_ASSERT_TRUE(reader.next(field, value, vlen));
+    TEST_ASSERT_EQUAL_MEMORY("\x9B\x04\r", value, 3);
+}
+
+void test_negative_ints_use_minimal_width(void) {
+    writer.begin(frame, sizeof(frame), 1);
+    writer.putInt(PhoneField::VALUE, -5);
+    writer.putInt(PhoneField::VALUE, -1000);
+    writer.putInt(PhoneField::VALUE, INT32_MIN);
+    TEST_ASSERT_TRUE(reader.open(frame, writer.length()));
+
+    PhoneField field;
+    const uint8_t* value;
+    uint8_t len;
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_EQUAL_UINT8(1, len);
+    TEST_ASSERT_EQUAL_INT32(-5, PhoneFrameReader::intValue(value, len));
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_EQUAL_UINT8(2, len);
+    TEST_ASSERT_EQUAL_INT32(-1000, PhoneFrameReader::intValue(value, len));
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_EQUAL_UINT8(4, len);
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, PhoneFrameReader::intValue(value, len));
+}
+
+void test_field_that_does_not_fit_is_dropped_whole(void) {
+    writer.begin(frame, 12, 1);
+    TEST_ASSERT_TRUE(writer.putString(PhoneField::NAME, "ABC"));
+    size_t before = writer.length();
+    TEST_ASSERT_FALSE(writer.putString(PhoneField::FW, "TOO-LONG"));
+    TEST_ASSERT_TRUE(writer.overflowed());
+    TEST_ASSERT_EQUAL_UINT32(before, writer.length());
+
+    TEST_ASSERT_TRUE(reader.open(frame, writer.length()));
+    PhoneField field;
+    const uint8_t* value;
+    uint8_t len;
+    TEST_ASSERT_TRUE(reader.next(field, value, len));
+    TEST_ASSERT_TRUE(field == PhoneField::NAME);
+    TEST_ASSERT_FALSE(reader.next(field, value, len));
+}
+
+void test_reader_rejects_text_and_truncated_frames(void) {
+    TEST_ASSERT_FALSE(reader.open("PONG:\n", 6));
+    const char dangling[] = {static_cast<char>(PHONE_V3_MARKER), static_cast<char>(0x81), 0x1B};
+    TEST_ASSERT_FALSE(reader.open(dangling, sizeof(dangling)));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_identify_negotiation);
+    RUN_TEST(test_identify_rejects_other_messages);
+    RUN_TEST(test_field_keys_match_text_protocol);
+    RUN_TEST(test_frame_round_trip);
+    RUN_TEST(test_frame_has_no_transport_bytes);
+    RUN_TEST(test_negative_ints_use_minimal_width);
+    RUN_TEST(test_field_that_does_not_fit_is_dropped_whole);
+    RUN_TEST(test_reader_rejects_text_and_truncated_frames);
+
+    return UNITY_END();
+}
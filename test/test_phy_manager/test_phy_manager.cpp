@@ -0,0 +1,198 @@
+/**
+ * @file test_phy_manager.cpp
+ * @brief Unit tests for phy_manager.h/cpp - automatic PHY selection
+ */
+
+#include <unity.h>
+#include "phy_manager.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static PhyManager* manager = nullptr;
+static uint32_t missed = 0;
+
+static const uint32_t INTERVAL_US = 7500;
+static const uint32_t MIN_RTT_US = 12000;
+
+void setUp(void) {
+    manager = new PhyManager(BlePhy::PHY_2M, BlePhy::CODED);
+    missed = 0;
+}
+
+void tearDown(void) {
+    delete manager;
+    manager = nullptr;
+}
+
+// Link up at t=0 and settled on phy
+static void linkUpOn(BlePhy phy) {
+    BlePhy request;
+    manager->onLinkUp();
+    (void)manager->update(0, INTERVAL_US, missed, request);
+    manager->onPhyChanged(phy, 0);
+}
+
+// One exchange at nowMs; returns whether a switch was requested
+static bool exchange(uint32_t nowMs, uint32_t rttUs, BlePhy& request) {
+    manager->onExchange(rttUs);
+    return manager->update(nowMs, INTERVAL_US, missed, request);
+}
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+void test_phy_masks_round_trip(void) {
+    BlePhy phy;
+    TEST_ASSERT_TRUE(blePhyFromMask(blePhyMask(BlePhy::CODED), phy));
+    TEST_ASSERT_TRUE(phy == BlePhy::CODED);
+    TEST_ASSERT_EQUAL_UINT8(0x02, blePhyMask(BlePhy::PHY_2M));
+    TEST_ASSERT_FALSE(blePhyFromMask(0x03, phy));  // Not a single PHY
+    TEST_ASSERT_EQUAL_STRING("1M", blePhyName(BlePhy::PHY_1M));
+}
+
+// =============================================================================
+// STEPPING DOWN
+// =============================================================================
+
+void test_clean_link_stays_put(void) {
+    linkUpOn(BlePhy::PHY_2M);
+    BlePhy request;
+    for (uint32_t t = 6000; t < 20000; t += 250) {
+        // Jitter below one interval is anchor alignment, not a resend
+        TEST_ASSERT_FALSE(exchange(t, MIN_RTT_US + (t % 7000), request));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, manager->retxScoreQ8());
+    TEST_ASSERT_TRUE(manager->minRttUs(BlePhy::PHY_2M) < MIN_RTT_US + INTERVAL_US);
+}
+
+void test_retransmissions_step_down_after_dwell(void) {
+    linkUpOn(BlePhy::PHY_2M);
+    BlePhy request;
+    TEST_ASSERT_FALSE(exchange(100, MIN_RTT_US, request));
+    uint32_t t = 200;
+    bool switched = false;
+    while (!switched && t < BLE_PHY_AUTO_MIN_DWELL_MS + 5000) {
+        switched = exchange(t, MIN_RTT_US + 3 * INTERVAL_US, request);
+        if (switched) {
+            TEST_ASSERT_TRUE(t >= BLE_PHY_AUTO_MIN_DWELL_MS);
+        }
+        t += 250;
+    }
+    TEST_ASSERT_TRUE(switched);
+    TEST_ASSERT_TRUE(request == BlePhy::PHY_1M);
+    TEST_ASSERT_TRUE(manager->requestPending());
+
+    manager->onPhyChanged(BlePhy::PHY_1M, t);
+    TEST_ASSERT_FALSE(manager->requestPending());
+    TEST_ASSERT_EQUAL_UINT16(0, manager->sampleCount());
+    TEST_ASSERT_TRUE(manager->minRttUs(BlePhy::PHY_2M) < MIN_RTT_US + INTERVAL_US);  // Kept for the way back
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, manager->minRttUs(BlePhy::PHY_1M));
+}
+
+void test_lost_pongs_step_down_at_once(void) {
+    linkUpOn(BlePhy::PHY_1M);
+    BlePhy request;
+    TEST_ASSERT_FALSE(exchange(BLE_PHY_AUTO_MIN_DWELL_MS, MIN_RTT_US, request));
+    missed += BLE_PHY_AUTO_MISS_LIMIT;
+    TEST_ASSERT_TRUE(manager->update(BLE_PHY_AUTO_MIN_DWELL_MS + 1000, INTERVAL_US, missed, request));
+    TEST_ASSERT_TRUE(request == BlePhy::CODED);
+}
+
+void test_refused_phy_is_held_off(void) {
+    linkUpOn(BlePhy::PHY_1M);
+    BlePhy request;
+    uint32_t t = BLE_PHY_AUTO_MIN_DWELL_MS;
+    missed += BLE_PHY_AUTO_MISS_LIMIT;
+    TEST_ASSERT_TRUE(manager->update(t, INTERVAL_US, missed, request));
+    TEST_ASSERT_TRUE(request == BlePhy::CODED);
+
+    // Peer never switches: counted as refused, Coded is not asked for again
+    missed += BLE_PHY_AUTO_MISS_LIMIT;
+    TEST_ASSERT_FALSE(manager->update(t + BLE_PHY_AUTO_REQUEST_TIMEOUT_MS, INTERVAL_US, missed, request));
+    TEST_ASSERT_EQUAL_UINT32(1, manager->refusedCount());
+    TEST_ASSERT_FALSE(manager->requestPending());
+    missed += BLE_PHY_AUTO_MISS_LIMIT;
+    TEST_ASSERT_FALSE(manager->update(t + BLE_PHY_AUTO_PROBE_MS - 1, INTERVAL_US, missed, request));
+}
+
+void test_slowest_rung_never_steps_down(void) {
+    linkUpOn(BlePhy::CODED);
+    BlePhy request;
+    missed += 10;
+    TEST_ASSERT_FALSE(manager->update(BLE_PHY_AUTO_MIN_DWELL_MS, INTERVAL_US, missed, request));
+    TEST_ASSERT_TRUE(manager->missRun() >= BLE_PHY_AUTO_MISS_LIMIT);
+}
+
+// =============================================================================
+// PROBING UP
+// =============================================================================
+
+void test_quiet_link_probes_up_and_backs_off_on_failure(void) {
+    linkUpOn(BlePhy::PHY_2M);
+    BlePhy request;
+
+    // Fails on 2M -> 1M; 2M is held off for BLE_PHY_AUTO_PROBE_MS
+    missed += BLE_PHY_AUTO_MISS_LIMIT;
+    TEST_ASSERT_TRUE(manager->update(BLE_PHY_AUTO_MIN_DWELL_MS, INTERVAL_US, missed, request));
+    uint32_t t = BLE_PHY_AUTO_MIN_DWELL_MS + 100;
+    manager->onPhyChanged(BlePhy::PHY_1M, t);
+
+    // Quiet on 1M: probes 2M once the quiet spell reaches BLE_PHY_AUTO_PROBE_MS
+    uint32_t probeAt = 0;
+    for (uint32_t now = t + 250; now < t + 3 * BLE_PHY_AUTO_PROBE_MS && probeAt == 0; now += 250) {
+        if (exchange(now, MIN_RTT_US, request)) {
+            probeAt = now;
+        }
+    }
+    TEST_ASSERT_NOT_EQUAL(0, probeAt);
+    TEST_ASSERT_TRUE(request == BlePhy::PHY_2M);
+    TEST_ASSERT_TRUE(probeAt - t >= BLE_PHY_AUTO_PROBE_MS);
+
+    // 2M fails again: the next hold is twice as long
+    manager->onPhyChanged(BlePhy::PHY_2M, probeAt);
+    missed += BLE_PHY_AUTO_MISS_LIMIT;
+    uint32_t failAt = probeAt + BLE_PHY_AUTO_MIN_DWELL_MS;
+    TEST_ASSERT_TRUE(manager->update(failAt, INTERVAL_US, missed, request));
+    TEST_ASSERT_TRUE(request == BlePhy::PHY_1M);
+    manager->onPhyChanged(BlePhy::PHY_1M, failAt);
+
+    uint32_t reprobeAt = 0;
+    for (uint32_t now = failAt + 250; now < failAt + 5 * BLE_PHY_AUTO_PROBE_MS && reprobeAt == 0; now += 250) {
+        if (exchange(now, MIN_RTT_US, request)) {
+            reprobeAt = now;
+        }
+    }
+    TEST_ASSERT_TRUE(reprobeAt - failAt >= 2 * BLE_PHY_AUTO_PROBE_MS);
+    TEST_ASSERT_EQUAL_UINT32(4, manager->switchCount());  // Including the link-up 1M -> 2M
+}
+
+void test_interval_change_resets_quality(void) {
+    linkUpOn(BlePhy::PHY_2M);
+    BlePhy request;
+    (void)exchange(100, MIN_RTT_US, request);
+    manager->resetQuality();
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, manager->minRttUs(BlePhy::PHY_2M));
+    TEST_ASSERT_EQUAL_UINT16(0, manager->sampleCount());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_phy_masks_round_trip);
+    RUN_TEST(test_clean_link_stays_put);
+    RUN_TEST(test_retransmissions_step_down_after_dwell);
+    RUN_TEST(test_lost_pongs_step_down_at_once);
+    RUN_TEST(test_refused_phy_is_held_off);
+    RUN_TEST(test_slowest_rung_never_steps_down);
+    RUN_TEST(test_quiet_link_probes_up_and_backs_off_on_failure);
+    RUN_TEST(test_interval_change_resets_quality);
+
+    return UNITY_END();
+}
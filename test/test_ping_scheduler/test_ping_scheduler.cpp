@@ -0,0 +1,166 @@
+/**
+ * @file test_ping_scheduler.cpp
+ * @brief Unit tests for ping_scheduler.h/cpp - Adaptive PING cadence
+ */
+
+#include <unity.h>
+#include "ping_scheduler.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static PingScheduler* scheduler = nullptr;
+
+static constexpr uint32_t STABLE_US = SYNC_PING_STABLE_UNCERTAINTY_US / 2;
+static constexpr uint32_t UNSTABLE_US = SYNC_PING_UNSTABLE_UNCERTAINTY_US + 1;
+
+void setUp(void) {
+    static PingScheduler instance;
+    instance = PingScheduler();
+    scheduler = &instance;
+}
+
+void tearDown(void) {
+}
+
+// Advances 1ms at a time until a PING is due; returns its time (0 = none by limitMs)
+static uint32_t nextPing(uint32_t fromMs, uint32_t limitMs, bool syncValid,
+                         uint32_t uncertaintyUs, bool running = false) {
+    for (uint32_t t = fromMs; t <= limitMs; t++) {
+        if (scheduler->update(t, syncValid, uncertaintyUs, running)) {
+            return t;
+        }
+    }
+    return 0;
+}
+
+// One steady-state exchange: PING, then an answered PONG 20ms later
+static uint32_t exchange(uint32_t fromMs, bool accepted, uint32_t uncertaintyUs) {
+    uint32_t sent = nextPing(fromMs, fromMs + 10000, true, uncertaintyUs);
+    TEST_ASSERT_NOT_EQUAL(0, sent);
+    scheduler->onPong(accepted);
+    (void)scheduler->update(sent + 20, true, uncertaintyUs, false);
+    return sent;
+}
+
+// =============================================================================
+// BASE CADENCE TESTS
+// =============================================================================
+
+void test_base_cadence_without_sync(void) {
+    uint32_t first = nextPing(1, 5000, false, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(1, first);
+    uint32_t second = nextPing(first + 1, 5000, false, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(first + KEEPALIVE_INTERVAL_MS, second);
+}
+
+void test_therapy_uses_active_base(void) {
+    uint32_t first = nextPing(1, 5000, false, UINT32_MAX, true);
+    uint32_t second = nextPing(first + 1, 5000, false, UINT32_MAX, true);
+    TEST_ASSERT_EQUAL_UINT32(first + SYNC_ACTIVE_INTERVAL_MS, second);
+}
+
+// =============================================================================
+// BURST TESTS
+// =============================================================================
+
+void test_burst_paces_on_pongs(void) {
+    scheduler->requestBurst();
+    uint32_t t = 1000;
+    for (uint8_t i = 0; i < SYNC_PING_BURST_COUNT; i++) {
+        uint32_t sent = nextPing(t, t + 1000, false, UINT32_MAX);
+        TEST_ASSERT_EQUAL_UINT32(t, sent);
+        scheduler->onPong(true);
+        (void)scheduler->update(sent + 15, false, UINT32_MAX, false);
+        t = sent + 15 + SYNC_PING_BURST_GAP_MS;
+        TEST_ASSERT_EQUAL_UINT32(0, nextPing(sent + 16, t - 1, false, UINT32_MAX));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, scheduler->burstRemaining());
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler->missedPongs());
+}
+
+void test_burst_continues_after_lost_pong(void) {
+    scheduler->requestBurst();
+    uint32_t first = nextPing(1000, 2000, false, UINT32_MAX);
+    uint32_t second = nextPing(first + 1, first + 1000, false, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(first + SYNC_PING_BURST_TIMEOUT_MS, second);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler->missedPongs());
+}
+
+// =============================================================================
+// BACKOFF TESTS
+// =============================================================================
+
+void test_stable_samples_back_off_to_ceiling(void) {
+    uint32_t t = exchange(1, true, STABLE_US);
+    for (int i = 0; i < 8; i++) {
+        t = exchange(t + 1, true, STABLE_US);
+    }
+    TEST_ASSERT_EQUAL_UINT32(SYNC_PING_MAX_INTERVAL_MS, scheduler->intervalMs());
+    uint32_t next = nextPing(t + 1, t + 10000, true, STABLE_US);
+    TEST_ASSERT_EQUAL_UINT32(t + SYNC_PING_MAX_INTERVAL_MS, next);
+    TEST_ASSERT_TRUE(SYNC_PING_MAX_INTERVAL_MS * 2 <= KEEPALIVE_TIMEOUT_MS);
+}
+
+void test_rejected_sample_snaps_back(void) {
+    uint32_t t = exchange(1, true, STABLE_US);
+    t = exchange(t + 1, true, STABLE_US);
+    TEST_ASSERT_TRUE(scheduler->intervalMs() > KEEPALIVE_INTERVAL_MS);
+    exchange(t + 1, false, STABLE_US);
+    TEST_ASSERT_EQUAL_UINT32(KEEPALIVE_INTERVAL_MS, scheduler->intervalMs());
+}
+
+void test_high_uncertainty_snaps_back(void) {
+    uint32_t t = exchange(1, true, STABLE_US);
+    t = exchange(t + 1, true, STABLE_US);
+    exchange(t + 1, true, UNSTABLE_US);
+    TEST_ASSERT_EQUAL_UINT32(KEEPALIVE_INTERVAL_MS, scheduler->intervalMs());
+}
+
+void test_missed_pong_snaps_back(void) {
+    uint32_t t = exchange(1, true, STABLE_US);
+    t = exchange(t + 1, true, STABLE_US);
+    uint32_t backedOff = scheduler->intervalMs();
+    uint32_t unanswered = nextPing(t + 1, t + 10000, true, STABLE_US);
+    TEST_ASSERT_EQUAL_UINT32(t + backedOff, unanswered);
+    uint32_t retry = nextPing(unanswered + 1, unanswered + 10000, true, STABLE_US);
+    TEST_ASSERT_EQUAL_UINT32(unanswered + backedOff, retry);
+    TEST_ASSERT_EQUAL_UINT32(KEEPALIVE_INTERVAL_MS, scheduler->intervalMs());
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler->missedPongs());
+}
+
+void test_therapy_start_keeps_backoff_stop_raises_floor(void) {
+    uint32_t t = exchange(1, true, STABLE_US);
+    t = exchange(t + 1, true, STABLE_US);
+    uint32_t backedOff = scheduler->intervalMs();
+    (void)scheduler->update(t + 30, true, STABLE_US, true);
+    TEST_ASSERT_EQUAL_UINT32(backedOff, scheduler->intervalMs());
+
+    // A rejected sample mid-therapy drops to the 4Hz base; stopping raises it
+    scheduler->onPong(false);
+    (void)scheduler->update(t + 40, true, STABLE_US, true);
+    TEST_ASSERT_EQUAL_UINT32(SYNC_ACTIVE_INTERVAL_MS, scheduler->intervalMs());
+    (void)scheduler->update(t + 50, true, STABLE_US, false);
+    TEST_ASSERT_EQUAL_UINT32(KEEPALIVE_INTERVAL_MS, scheduler->intervalMs());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_base_cadence_without_sync);
+    RUN_TEST(test_therapy_uses_active_base);
+    RUN_TEST(test_burst_paces_on_pongs);
+    RUN_TEST(test_burst_continues_after_lost_pong);
+    RUN_TEST(test_stable_samples_back_off_to_ceiling);
+    RUN_TEST(test_rejected_sample_snaps_back);
+    RUN_TEST(test_high_uncertainty_snaps_back);
+    RUN_TEST(test_missed_pong_snaps_back);
+    RUN_TEST(test_therapy_start_keeps_backoff_stop_raises_floor);
+
+    return UNITY_END();
+}
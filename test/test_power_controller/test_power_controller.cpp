@@ -0,0 +1,73 @@
+/**
+ * @file test_power_controller.cpp
+ * @brief Unit tests for power_controller.h - Idle sleep budget
+ *
+ * The board backends are not built natively; only the pure
+ * PowerController::idleBudgetMs() policy is covered here.
+ */
+
+#include <unity.h>
+#include "power_controller.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static constexpr uint64_t NOW_US = 5000000ULL;
+
+// =============================================================================
+// IDLE BUDGET TESTS
+// =============================================================================
+
+void test_past_deadline_stays_awake(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, PowerController::idleBudgetMs(NOW_US, NOW_US));
+    TEST_ASSERT_EQUAL_UINT32(0, PowerController::idleBudgetMs(NOW_US, NOW_US - 1000));
+}
+
+void test_short_gap_stays_awake(void) {
+    uint64_t deadline = NOW_US + (POWER_IDLE_MIN_MS * 1000ULL) - 1;
+    TEST_ASSERT_EQUAL_UINT32(0, PowerController::idleBudgetMs(NOW_US, deadline));
+}
+
+void test_gap_at_threshold_sleeps_until_guard(void) {
+    uint64_t deadline = NOW_US + (POWER_IDLE_MIN_MS * 1000ULL);
+    TEST_ASSERT_EQUAL_UINT32(POWER_IDLE_MIN_MS - POWER_IDLE_GUARD_MS,
+                             PowerController::idleBudgetMs(NOW_US, deadline));
+}
+
+void test_relax_gap_wakes_guard_early(void) {
+    // 668ms inter-burst relax
+    uint64_t deadline = NOW_US + 668000ULL;
+    TEST_ASSERT_EQUAL_UINT32(668 - POWER_IDLE_GUARD_MS,
+                             PowerController::idleBudgetMs(NOW_US, deadline));
+}
+
+void test_post_wake_gap_stays_awake(void) {
+    // After sleeping the budget, the remaining guard window is not slept again
+    uint64_t deadline = NOW_US + 668000ULL;
+    uint64_t woke = NOW_US + PowerController::idleBudgetMs(NOW_US, deadline) * 1000ULL;
+    TEST_ASSERT_EQUAL_UINT32(0, PowerController::idleBudgetMs(woke, deadline));
+}
+
+void test_far_deadline_saturates(void) {
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, PowerController::idleBudgetMs(0, UINT64_MAX));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_past_deadline_stays_awake);
+    RUN_TEST(test_short_gap_stays_awake);
+    RUN_TEST(test_gap_at_threshold_sleeps_until_guard);
+    RUN_TEST(test_relax_gap_wakes_guard_early);
+    RUN_TEST(test_post_wake_gap_stays_awake);
+    RUN_TEST(test_far_deadline_saturates);
+
+    return UNITY_END();
+}
@@ -0,0 +1,204 @@
+/**
+ * @file test_preselect_planner.cpp
+ * @brief Unit tests for preselect_planner.h/cpp - per-gap pre-selection plan
+ */
+
+#include <unity.h>
+#include "preselect_planner.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static PreselectPlanner* planner = nullptr;
+
+static constexpr uint64_t T0 = 1000000;   // Plan start
+static constexpr uint32_t WINDOW = 300;   // MOTOR_BATCH_WINDOW_US default
+
+void setUp(void) {
+    planner = new PreselectPlanner();
+    planner->begin(T0, WINDOW);
+}
+
+void tearDown(void) {
+    delete planner;
+    planner = nullptr;
+}
+
+static void activate(uint64_t timeUs, uint8_t finger, uint16_t frequencyHz = 250) {
+    planner->add(timeUs, finger, true, frequencyHz);
+}
+
+static void deactivate(uint64_t timeUs, uint8_t finger) {
+    planner->add(timeUs, finger, false, 0);
+}
+
+// =============================================================================
+// GAP CLASSIFICATION
+// =============================================================================
+
+void test_spaced_activations_are_fast(void) {
+    // 100ms pulses 67ms apart - every gap has room
+    activate(T0 + 10000, 0);
+    deactivate(T0 + 110000, 0);
+    activate(T0 + 177000, 1);
+    deactivate(T0 + 277000, 1);
+    planner->finish();
+
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT8(2, stats.activations);
+    TEST_ASSERT_EQUAL_UINT8(2, stats.fast);
+    TEST_ASSERT_EQUAL_UINT8(0, planner->stagedCount());
+}
+
+void test_overlapping_fingers_with_room_are_fast(void) {
+    // F1 starts while F0 is still on: the gap after F0's activation fits
+    activate(T0 + 10000, 0);
+    activate(T0 + 12000, 1);
+    deactivate(T0 + 110000, 0);
+    deactivate(T0 + 112000, 1);
+    planner->finish();
+
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT8(2, stats.fast);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.slow);
+}
+
+void test_tight_gap_stages_frequency_earlier(void) {
+    // F1 activates 400us after F0's deactivation: the deactivation holds the
+    // bus for PRESELECT_EVENT_COST_US, leaving no room to pre-select
+    activate(T0 + 10000, 0);
+    deactivate(T0 + 50000, 0);
+    activate(T0 + 50400, 1, 200);
+    deactivate(T0 + 90000, 1);
+    planner->finish();
+
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT8(1, stats.fast);
+    TEST_ASSERT_EQUAL_UINT8(1, stats.staged);
+    TEST_ASSERT_EQUAL_UINT8(1, planner->stagedCount());
+
+    // Not before F0's activation has gone out...
+    uint8_t finger = 0xFF;
+    uint16_t frequencyHz = 0;
+    TEST_ASSERT_FALSE(planner->takeStagedWrite(T0 + 10000, finger, frequencyHz));
+    // ...and in the gap between F0's activation and deactivation
+    TEST_ASSERT_TRUE(planner->takeStagedWrite(T0 + 20000, finger, frequencyHz));
+    TEST_ASSERT_EQUAL_UINT8(1, finger);
+    TEST_ASSERT_EQUAL_UINT16(200, frequencyHz);
+    TEST_ASSERT_EQUAL_UINT8(0, planner->stagedCount());
+    TEST_ASSERT_EQUAL_UINT32(1, planner->getStats().stagedWrites);
+}
+
+void test_burst_activations_are_staged(void) {
+    // Two activations inside one batch window share an I2C burst
+    activate(T0 + 10000, 0, 250);
+    activate(T0 + 10100, 1, 180);
+    deactivate(T0 + 110000, 0);
+    deactivate(T0 + 110100, 1);
+    planner->finish();
+
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT8(2, stats.activations);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.fast);
+    TEST_ASSERT_EQUAL_UINT8(2, stats.staged);
+}
+
+void test_no_batching_splits_equal_times(void) {
+    planner->begin(T0, 0);
+    activate(T0 + 10000, 0);
+    activate(T0 + 10000, 1);
+    planner->finish();
+
+    // The second runs right behind the first: its frequency is staged
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT8(1, stats.fast);
+    TEST_ASSERT_EQUAL_UINT8(1, stats.staged);
+}
+
+void test_stage_never_precedes_same_finger_deactivation(void) {
+    // F0 re-activates at a new frequency right after its own deactivation:
+    // no earlier gap is free of F0's running pulse
+    activate(T0 + 10000, 0, 250);
+    deactivate(T0 + 50000, 0);
+    activate(T0 + 50400, 0, 150);
+    planner->finish();
+
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT8(1, stats.fast);
+    TEST_ASSERT_EQUAL_UINT8(0, stats.staged);
+    TEST_ASSERT_EQUAL_UINT8(1, stats.slow);
+}
+
+void test_no_gap_before_first_event_is_slow(void) {
+    // Overdue burst at plan start: nothing to stage into
+    activate(T0, 0);
+    activate(T0 + 100, 1);
+    planner->finish();
+
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT8(2, stats.slow);
+}
+
+// =============================================================================
+// STAGED WRITES
+// =============================================================================
+
+void test_missed_gap_is_counted(void) {
+    activate(T0 + 10000, 0);
+    activate(T0 + 10100, 1);
+    planner->finish();
+    TEST_ASSERT_EQUAL_UINT8(2, planner->stagedCount());
+
+    // Motor task only looks after the pre-select slot has started
+    uint8_t finger;
+    uint16_t frequencyHz;
+    TEST_ASSERT_FALSE(planner->takeStagedWrite(T0 + 9500, finger, frequencyHz));
+    PreselectPlanStats stats = planner->getStats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.stagedMissed);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.stagedWrites);
+}
+
+void test_replan_drops_staged_writes_and_counts_plans(void) {
+    activate(T0 + 10000, 0);
+    activate(T0 + 10100, 1);
+    planner->finish();
+
+    planner->begin(T0 + 500, WINDOW);
+    planner->finish();
+    TEST_ASSERT_EQUAL_UINT8(0, planner->stagedCount());
+    TEST_ASSERT_EQUAL_UINT8(0, planner->getStats().activations);
+    TEST_ASSERT_EQUAL_UINT32(2, planner->getStats().plans);
+
+    planner->resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, planner->getStats().plans);
+}
+
+void test_preselect_slot_helpers(void) {
+    uint64_t activateUs = T0 + 5000;
+    TEST_ASSERT_FALSE(PreselectPlanner::preselectDue(activateUs - PRESELECT_LEAD_US - 1, activateUs));
+    TEST_ASSERT_TRUE(PreselectPlanner::preselectDue(activateUs - PRESELECT_LEAD_US, activateUs));
+    TEST_ASSERT_TRUE(PreselectPlanner::preselectFits(activateUs - PRESELECT_COST_US, activateUs));
+    TEST_ASSERT_FALSE(PreselectPlanner::preselectFits(activateUs - PRESELECT_COST_US + 1, activateUs));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spaced_activations_are_fast);
+    RUN_TEST(test_overlapping_fingers_with_room_are_fast);
+    RUN_TEST(test_tight_gap_stages_frequency_earlier);
+    RUN_TEST(test_burst_activations_are_staged);
+    RUN_TEST(test_no_batching_splits_equal_times);
+    RUN_TEST(test_stage_never_precedes_same_finger_deactivation);
+    RUN_TEST(test_no_gap_before_first_event_is_slow);
+    RUN_TEST(test_missed_gap_is_counted);
+    RUN_TEST(test_replan_drops_staged_writes_and_counts_plans);
+    RUN_TEST(test_preselect_slot_helpers);
+
+    return UNITY_END();
+}
@@ -54,7 +54,7 @@ void test_ProfileManager_begin_initializes_profiles(void) {
 
 void test_ProfileManager_getProfileNames_returns_valid_pointers(void) {
     uint8_t count = 0;
-    const char** names = profiles->getProfileNames(&count);
+    const char* const* names = profiles->getProfileNames(&count);
 
     TEST_ASSERT_EQUAL_UINT8(6, count);
     TEST_ASSERT_NOT_NULL(names);
@@ -68,7 +68,7 @@ void test_ProfileManager_getProfileNames_returns_valid_pointers(void) {
 
 void test_ProfileManager_getProfileNames_returns_correct_names(void) {
     uint8_t count = 0;
-    const char** names = profiles->getProfileNames(&count);
+    const char* const* names = profiles->getProfileNames(&count);
 
     TEST_ASSERT_EQUAL_STRING("regular_vcr", names[0]);
     TEST_ASSERT_EQUAL_STRING("noisy_vcr", names[1]);
@@ -178,9 +178,9 @@ void test_getCurrentProfile_noisy_vcr_has_correct_defaults(void) {
     profiles->loadProfile(2);  // noisy_vcr is now profile 2
     const TherapyProfile* p = profiles->getCurrentProfile();
 
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, p->timeOnMs);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 67.0f, p->timeOffMs);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 23.5f, p->jitterPercent);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, p->timing.timeOnMs());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 67.0f, p->timing.timeOffMs());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 23.5f, p->timing.jitterPercent());
     TEST_ASSERT_EQUAL_UINT8(100, p->amplitudeMin);
     TEST_ASSERT_EQUAL_UINT8(100, p->amplitudeMax);
     TEST_ASSERT_EQUAL_UINT16(120, p->sessionDurationMin);
@@ -193,9 +193,9 @@ void test_getCurrentProfile_gentle_has_correct_values(void) {
     const TherapyProfile* p = profiles->getCurrentProfile();
 
     TEST_ASSERT_EQUAL_STRING("gentle", p->name);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 80.0f, p->timeOnMs);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 87.0f, p->timeOffMs);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 15.0f, p->jitterPercent);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 80.0f, p->timing.timeOnMs());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 87.0f, p->timing.timeOffMs());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 15.0f, p->timing.jitterPercent());
     TEST_ASSERT_EQUAL_UINT8(30, p->amplitudeMin);
     TEST_ASSERT_EQUAL_UINT8(70, p->amplitudeMax);
     TEST_ASSERT_EQUAL_STRING("sequential", p->patternType);
@@ -224,7 +224,7 @@ void test_getCurrentProfileName_returns_none_when_not_loaded(void) {
 
 void test_getProfileNames_with_null_count(void) {
     // Verify getProfileNames handles null count parameter
-    const char** names = profiles->getProfileNames(nullptr);
+    const char* const* names = profiles->getProfileNames(nullptr);
     TEST_ASSERT_NOT_NULL(names);
     TEST_ASSERT_NOT_NULL(names[0]);
 }
@@ -301,7 +301,7 @@ void test_setParameter_ON_valid_range(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("ON", "150.5"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 150.5f, p->timeOnMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 150.5f, p->timing.timeOnMs());
 }
 
 void test_setParameter_ON_invalid_below_10(void) {
@@ -319,7 +319,7 @@ void test_setParameter_OFF_valid_range(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("OFF", "200"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 200.0f, p->timeOffMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 200.0f, p->timing.timeOffMs());
 }
 
 // =============================================================================
@@ -408,6 +408,15 @@ void test_setParameter_PATTERN_mirrored(void) {
 void test_setParameter_PATTERN_invalid(void) {
     profiles->loadProfile(1);
     TEST_ASSERT_FALSE(profiles->setParameter("PATTERN", "invalid"));
+    TEST_ASSERT_FALSE(profiles->setParameter("PATTERN", "rndpx"));
+}
+
+void test_setParameter_PATTERN_case_insensitive_is_canonical(void) {
+    profiles->loadProfile(1);
+    TEST_ASSERT_TRUE(profiles->setParameter("PATTERN", "MIRRORED"));
+
+    const TherapyProfile* p = profiles->getCurrentProfile();
+    TEST_ASSERT_EQUAL_STRING("mirrored", p->patternType);
 }
 
 // =============================================================================
@@ -419,7 +428,7 @@ void test_setParameter_JITTER_valid(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("JITTER", "50.5"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 50.5f, p->jitterPercent);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 50.5f, p->timing.jitterPercent());
 }
 
 void test_setParameter_JITTER_invalid_negative(void) {
@@ -534,7 +543,7 @@ void test_setParameter_JITTER_zero_is_valid(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("JITTER", "0"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, p->jitterPercent);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, p->timing.jitterPercent());
 }
 
 void test_setParameter_JITTER_100_is_valid(void) {
@@ -542,7 +551,7 @@ void test_setParameter_JITTER_100_is_valid(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("JITTER", "100"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, p->jitterPercent);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, p->timing.jitterPercent());
 }
 
 void test_setParameter_ON_10_is_valid(void) {
@@ -550,7 +559,7 @@ void test_setParameter_ON_10_is_valid(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("ON", "10"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, p->timeOnMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, p->timing.timeOnMs());
 }
 
 void test_setParameter_ON_1000_is_valid(void) {
@@ -558,7 +567,7 @@ void test_setParameter_ON_1000_is_valid(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("ON", "1000"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 1000.0f, p->timeOnMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 1000.0f, p->timing.timeOnMs());
 }
 
 void test_setParameter_OFF_10_is_valid(void) {
@@ -566,7 +575,7 @@ void test_setParameter_OFF_10_is_valid(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("OFF", "10"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, p->timeOffMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, p->timing.timeOffMs());
 }
 
 void test_setParameter_OFF_1000_is_valid(void) {
@@ -574,7 +583,7 @@ void test_setParameter_OFF_1000_is_valid(void) {
     TEST_ASSERT_TRUE(profiles->setParameter("OFF", "1000"));
 
     const TherapyProfile* p = profiles->getCurrentProfile();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 1000.0f, p->timeOffMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 1000.0f, p->timing.timeOffMs());
 }
 
 void test_setParameter_FINGERS_1_is_valid(void) {
@@ -610,7 +619,20 @@ void test_resetToDefaults_restores_builtin_values(void) {
     // Verify original values restored
     const TherapyProfile* p = profiles->getCurrentProfile();
     TEST_ASSERT_EQUAL_UINT16(250, p->frequencyHz);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, p->jitterPercent);  // regular_vcr has 0% jitter
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, p->timing.jitterPercent());  // regular_vcr has 0% jitter
+}
+
+void test_resetToDefaults_restores_builtin_pattern(void) {
+    profiles->loadProfile(5);  // gentle (sequential)
+    profiles->setParameter("PATTERN", "rndp");
+    profiles->setParameter("AMPMAX", "100");
+
+    profiles->resetToDefaults();
+
+    const TherapyProfile* p = profiles->getCurrentProfile();
+    TEST_ASSERT_EQUAL_STRING("gentle", p->name);
+    TEST_ASSERT_EQUAL_STRING("sequential", p->patternType);
+    TEST_ASSERT_EQUAL_UINT8(70, p->amplitudeMax);
 }
 
 // =============================================================================
@@ -668,6 +690,169 @@ void test_settings_roundtrip_with_storage(void) {
     TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, pm2.getDeviceRole());
 }
 
+void test_settings_roundtrip_preserves_i2c_bus_khz(void) {
+    TEST_ASSERT_EQUAL_UINT16(0, profiles->getI2CBusKhz());  // Never negotiated
+    profiles->setI2CBusKhz(1000);
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+
+    ProfileManager pm2;
+    pm2.begin(true);
+    TEST_ASSERT_EQUAL_UINT16(1000, pm2.getI2CBusKhz());
+}
+
+void test_settings_roundtrip_preserves_motor_present_mask(void) {
+    TEST_ASSERT_EQUAL_UINT8(0, profiles->getMotorPresentMask());  // Never probed
+    profiles->setMotorPresentMask(0x0B);
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+
+    ProfileManager pm2;
+    pm2.begin(true);
+    TEST_ASSERT_EQUAL_UINT8(0x0B, pm2.getMotorPresentMask());
+}
+
+void test_settings_with_unknown_pattern_keep_profile_default(void) {
+    SettingsData legacy{};
+    legacy.magic = SETTINGS_MAGIC;
+    legacy.version = SETTINGS_VERSION;
+    legacy.profileId = 5;  // gentle (sequential)
+    legacy.timeOnUs = 80000;
+    legacy.timeOffUs = 87000;
+    legacy.numFingers = 4;
+    memset(legacy.patternType, 'x', sizeof(legacy.patternType));  // Unterminated
+    TEST_ASSERT_TRUE(fsb::writeFile(SETTINGS_FILE, (const uint8_t*)&legacy, sizeof(legacy)));
+
+    ProfileManager pm;
+    pm.begin(true);
+    TEST_ASSERT_EQUAL_STRING("gentle", pm.getCurrentProfileName());
+    TEST_ASSERT_EQUAL_STRING("sequential", pm.getCurrentProfile()->patternType);
+}
+
+void test_legacy_settings_file_migrates_to_log(void) {
+    // Version 1 image: timing fields hold float ms / ms / percent
+    const float timeOnMs = 150.5f, timeOffMs = 67.0f, jitterPercent = 23.5f;
+    SettingsData legacy{};
+    legacy.magic = SETTINGS_MAGIC;
+    legacy.version = 1;
+    legacy.role = 1;
+    legacy.profileId = 1;
+    memcpy(&legacy.timeOnUs, &timeOnMs, sizeof(float));
+    memcpy(&legacy.timeOffUs, &timeOffMs, sizeof(float));
+    memcpy(&legacy.jitterQ16, &jitterPercent, sizeof(float));
+    legacy.numFingers = 4;
+    legacy.therapyLedOff = 1;
+    TEST_ASSERT_TRUE(fsb::writeFile(SETTINGS_FILE, (const uint8_t*)&legacy, sizeof(legacy)));
+
+    ProfileManager pm;
+    pm.begin(true);
+    TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, pm.getDeviceRole());
+    TEST_ASSERT_TRUE(pm.getTherapyLedOff());
+    TEST_ASSERT_TRUE(TherapyTiming(150500, 67000, 15401) == pm.getCurrentProfile()->timing);
+
+    TEST_ASSERT_TRUE(pm.saveSettings());
+    TEST_ASSERT_FALSE(fsb::exists(SETTINGS_FILE));
+
+    ProfileManager pm2;
+    pm2.begin(true);
+    TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, pm2.getDeviceRole());
+    TEST_ASSERT_TRUE(pm2.getTherapyLedOff());
+    TEST_ASSERT_TRUE(TherapyTiming(150500, 67000, 15401) == pm2.getCurrentProfile()->timing);
+}
+
+// Image as firmware before motorPresentMask wrote it
+static SettingsData shortSettingsImage() {
+    SettingsData data{};
+    data.magic = SETTINGS_MAGIC;
+    data.version = SETTINGS_VERSION;
+    data.role = 1;
+    data.profileId = 1;
+    data.timeOnUs = 100000;
+    data.timeOffUs = 67000;
+    data.numFingers = 4;
+    data.debugMode = 1;
+    data.i2cBusKhz = 1000;
+    data.motorPresentMask = 0xFF;  // Not written: lies past the short image
+    return data;
+}
+
+void test_short_legacy_settings_file_loads(void) {
+    SettingsData legacy = shortSettingsImage();
+    TEST_ASSERT_EQUAL(45, SETTINGS_DATA_MIN_SIZE);
+    TEST_ASSERT_TRUE(fsb::writeFile(SETTINGS_FILE, (const uint8_t*)&legacy, SETTINGS_DATA_MIN_SIZE));
+
+    ProfileManager pm;
+    pm.begin(true);
+    TEST_ASSERT_TRUE(pm.hasStoredRole());
+    TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, pm.getDeviceRole());
+    TEST_ASSERT_TRUE(pm.getDebugMode());
+    TEST_ASSERT_EQUAL_UINT16(1000, pm.getI2CBusKhz());
+    TEST_ASSERT_EQUAL_UINT8(0, pm.getMotorPresentMask());  // Never probed
+
+    // Anything shorter is not a settings file
+    TEST_ASSERT_TRUE(fsb::writeFile(SETTINGS_FILE, (const uint8_t*)&legacy, SETTINGS_DATA_MIN_SIZE - 1));
+    ProfileManager pm2;
+    pm2.begin(true);
+    TEST_ASSERT_FALSE(pm2.hasStoredRole());
+}
+
+void test_short_settings_log_loads_and_is_rewritten(void) {
+    SettingsData old = shortSettingsImage();
+    SettingsLog oldLog;
+    TEST_ASSERT_TRUE(oldLog.save((const uint8_t*)&old, SETTINGS_DATA_MIN_SIZE));
+
+    ProfileManager pm;
+    pm.begin(true);
+    TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, pm.getDeviceRole());
+    TEST_ASSERT_TRUE(pm.getDebugMode());
+    TEST_ASSERT_EQUAL_UINT8(0, pm.getMotorPresentMask());
+
+    // Rewritten at the current size: a change now appends and replays
+    SettingsLog current;
+    SettingsData data;
+    TEST_ASSERT_TRUE(current.load((uint8_t*)&data, sizeof(data)));
+    pm.setMotorPresentMask(0x07);
+    TEST_ASSERT_TRUE(pm.saveSettings());
+
+    ProfileManager pm2;
+    pm2.begin(true);
+    TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, pm2.getDeviceRole());
+    TEST_ASSERT_EQUAL_UINT8(0x07, pm2.getMotorPresentMask());
+}
+
+void test_requestSave_waits_for_debounce(void) {
+    _mock_millis = 1000;
+    profiles->setDebugMode(true);
+    profiles->requestSave();
+    TEST_ASSERT_TRUE(profiles->hasPendingSave());
+
+    // Another change restarts the quiet period
+    _mock_millis = 1000 + SETTINGS_SAVE_DEBOUNCE_MS - 1;
+    TEST_ASSERT_FALSE(profiles->saveIfDue());
+    profiles->setTherapyLedOff(true);
+    profiles->requestSave();
+    _mock_millis += SETTINGS_SAVE_DEBOUNCE_MS - 1;
+    TEST_ASSERT_FALSE(profiles->saveIfDue());
+    TEST_ASSERT_FALSE(fsb::exists(SETTINGS_LOG_FILE_A));
+
+    _mock_millis += 1;
+    TEST_ASSERT_TRUE(profiles->saveIfDue());
+    TEST_ASSERT_FALSE(profiles->hasPendingSave());
+
+    ProfileManager pm2;
+    pm2.begin(true);
+    TEST_ASSERT_TRUE(pm2.getDebugMode());
+    TEST_ASSERT_TRUE(pm2.getTherapyLedOff());
+}
+
+void test_eraseSettings_forgets_stored_role(void) {
+    profiles->setDeviceRole(DeviceRole::SECONDARY);
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+    TEST_ASSERT_TRUE(profiles->eraseSettings());
+
+    ProfileManager pm2;
+    pm2.begin(true);
+    TEST_ASSERT_FALSE(pm2.hasStoredRole());
+}
+
 // =============================================================================
 // MAIN - RUN ALL TESTS
 // =============================================================================
@@ -744,6 +929,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_setParameter_PATTERN_sequential);
     RUN_TEST(test_setParameter_PATTERN_mirrored);
     RUN_TEST(test_setParameter_PATTERN_invalid);
+    RUN_TEST(test_setParameter_PATTERN_case_insensitive_is_canonical);
 
     // Set Parameter Tests - JITTER/MIRROR/FINGERS
     RUN_TEST(test_setParameter_JITTER_valid);
@@ -778,6 +964,7 @@ int main(int argc, char **argv) {
 
     // Reset to Defaults Tests
     RUN_TEST(test_resetToDefaults_restores_builtin_values);
+    RUN_TEST(test_resetToDefaults_restores_builtin_pattern);
 
     // Device Role Tests
     RUN_TEST(test_setDeviceRole_PRIMARY);
@@ -787,7 +974,15 @@ int main(int argc, char **argv) {
     // Storage Tests
     RUN_TEST(test_isStorageAvailable_false_when_mount_fails);
     RUN_TEST(test_settings_roundtrip_with_storage);
+    RUN_TEST(test_settings_roundtrip_preserves_i2c_bus_khz);
+    RUN_TEST(test_settings_roundtrip_preserves_motor_present_mask);
     RUN_TEST(test_saveSettings_returns_false_without_storage);
+    RUN_TEST(test_settings_with_unknown_pattern_keep_profile_default);
+    RUN_TEST(test_legacy_settings_file_migrates_to_log);
+    RUN_TEST(test_short_legacy_settings_file_loads);
+    RUN_TEST(test_short_settings_log_loads_and_is_rewritten);
+    RUN_TEST(test_requestSave_waits_for_debounce);
+    RUN_TEST(test_eraseSettings_forgets_stored_role);
     RUN_TEST(test_loadSettings_returns_false_without_storage);
 
     return UNITY_END();
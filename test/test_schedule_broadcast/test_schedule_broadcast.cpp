@@ -0,0 +1,191 @@
+/**
+ * @file test_schedule_broadcast.cpp
+ * @brief Unit tests for schedule_broadcast.h/cpp - periodic-advertising schedule
+ */
+
+#include <unity.h>
+#include "schedule_broadcast.h"
+#include "../../src/sync_protocol.cpp"
+#include "../../src/schedule_broadcast.cpp"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static ScheduleAnchorTracker tracker;
+
+static constexpr uint32_t INTERVAL_US = SYNC_PERIODIC_ADV_INTERVAL_MS * 1000;
+static const ScheduleTrain TRAIN = {5000000ULL, INTERVAL_US};
+
+// Listener clock runs OFFSET_US ahead of the PRIMARY; the controller starts
+// the train START_LATENCY_US after TRAIN.startUs
+static constexpr int64_t OFFSET_US = 2345678;
+static constexpr uint64_t START_LATENCY_US = 61250;
+
+static uint64_t reportAt(uint32_t event, uint32_t jitterUs) {
+    return TRAIN.startUs + START_LATENCY_US + static_cast<uint64_t>(event) * INTERVAL_US +
+           OFFSET_US + jitterUs;
+}
+
+static void fillMacrocycle(Macrocycle& mc) {
+    mc.sequenceId = 31;
+    mc.baseTime = 7000000;
+    mc.clockOffset = 999;
+    mc.durationMs = 100;
+    mc.eventCount = MACROCYCLE_MAX_EVENTS;
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        mc.events[i].deltaTimeMs = static_cast<uint16_t>(i * 167);
+        mc.events[i].finger = static_cast<uint8_t>(i % MAX_ACTUATORS);
+        mc.events[i].amplitude = static_cast<uint8_t>(50 + i);
+        mc.events[i].freqOffset = 0;
+    }
+}
+
+void setUp(void) {
+    tracker.reset();
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// PAYLOAD CODEC
+// =============================================================================
+
+void test_encode_decode_roundtrip(void) {
+    Macrocycle mc;
+    fillMacrocycle(mc);
+
+    uint8_t payload[SYNC_PERIODIC_ADV_MAX_DATA];
+    size_t len = ScheduleBroadcast::encode(payload, sizeof(payload), TRAIN, mc);
+    TEST_ASSERT_TRUE(len > ScheduleBroadcast::HEADER_SIZE);
+    TEST_ASSERT_EQUAL_UINT8(len - 1, payload[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, payload[1]);
+
+    ScheduleTrain train;
+    Macrocycle decoded;
+    TEST_ASSERT_TRUE(ScheduleBroadcast::decode(payload, len, train, decoded));
+    TEST_ASSERT_EQUAL_UINT64(TRAIN.startUs, train.startUs);
+    TEST_ASSERT_EQUAL_UINT32(TRAIN.intervalUs, train.intervalUs);
+    TEST_ASSERT_EQUAL_UINT32(mc.sequenceId, decoded.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(mc.baseTime, decoded.baseTime);
+    TEST_ASSERT_EQUAL_INT64(0, decoded.clockOffset);  // Never broadcast
+    TEST_ASSERT_EQUAL_UINT8(mc.eventCount, decoded.eventCount);
+    TEST_ASSERT_EQUAL_UINT8(mc.events[3].amplitude, decoded.events[3].amplitude);
+}
+
+void test_encode_rejects_small_buffer(void) {
+    Macrocycle mc;
+    fillMacrocycle(mc);
+    uint8_t payload[32];
+    TEST_ASSERT_EQUAL_UINT(0, ScheduleBroadcast::encode(payload, sizeof(payload), TRAIN, mc));
+}
+
+void test_decode_rejects_foreign_payloads(void) {
+    Macrocycle mc;
+    fillMacrocycle(mc);
+    uint8_t payload[SYNC_PERIODIC_ADV_MAX_DATA];
+    size_t len = ScheduleBroadcast::encode(payload, sizeof(payload), TRAIN, mc);
+
+    ScheduleTrain train;
+    Macrocycle decoded;
+    TEST_ASSERT_FALSE(ScheduleBroadcast::decode(payload, len - 1, train, decoded));  // Truncated
+
+    payload[4] = 'X';  // Another vendor's manufacturer data
+    TEST_ASSERT_FALSE(ScheduleBroadcast::decode(payload, len, train, decoded));
+}
+
+// =============================================================================
+// ANCHOR TRACKING
+// =============================================================================
+
+void test_reports_ignored_before_ptp(void) {
+    TEST_ASSERT_FALSE(tracker.onReport(TRAIN, reportAt(0, 500)));
+    TEST_ASSERT_FALSE(tracker.isLocked());
+}
+
+void test_locks_to_train_offset(void) {
+    // PTP offsets are noisy (+-800us); report latency is 300us + jitter
+    static const int32_t ptpNoise[] = {800, -650, 420, -800, 150, 90, -300, 610};
+    tracker.onPtpOffset(OFFSET_US + ptpNoise[0]);
+
+    uint32_t event = 0;
+    for (uint8_t cycle = 0; cycle < 12; cycle++) {
+        for (uint8_t i = 0; i < ScheduleAnchorTracker::WINDOW; i++, event++) {
+            TEST_ASSERT_TRUE(tracker.onReport(TRAIN, reportAt(event, 300 + (event * 37) % 900)));
+        }
+        tracker.onPtpOffset(OFFSET_US + ptpNoise[cycle % 8]);
+    }
+
+    TEST_ASSERT_TRUE(tracker.isLocked());
+    // The bias folds in the train start latency and the latency floor; the
+    // result sits within the EMA-averaged PTP noise of the true offset
+    TEST_ASSERT_INT64_WITHIN(500, OFFSET_US, tracker.getOffset());
+}
+
+void test_offset_follows_drift_between_calibrations(void) {
+    tracker.onPtpOffset(OFFSET_US);
+    uint32_t event = 0;
+    for (uint8_t cycle = 0; cycle < 6; cycle++) {
+        for (uint8_t i = 0; i < ScheduleAnchorTracker::WINDOW; i++, event++) {
+            tracker.onReport(TRAIN, reportAt(event, 300));
+        }
+        tracker.onPtpOffset(OFFSET_US);
+    }
+    TEST_ASSERT_TRUE(tracker.isLocked());
+    int64_t before = tracker.getOffset();
+
+    // Listener clock gains 200us; no PTP update arrives yet
+    for (uint8_t i = 0; i < ScheduleAnchorTracker::WINDOW; i++, event++) {
+        tracker.onReport(TRAIN, reportAt(event, 300) + 200);
+    }
+    TEST_ASSERT_EQUAL_INT64(before + 200, tracker.getOffset());
+}
+
+void test_start_latency_near_half_interval_is_consistent(void) {
+    // Reports straddling the rounding boundary must not split into two events
+    ScheduleTrain train = {TRAIN.startUs, INTERVAL_US};
+    tracker.onPtpOffset(OFFSET_US);
+    for (uint32_t event = 0; event < 3 * ScheduleAnchorTracker::WINDOW; event++) {
+        int64_t noise = (event % 2) ? 900 : -900;
+        uint64_t rx = train.startUs + INTERVAL_US / 2 + event * INTERVAL_US + OFFSET_US;
+        tracker.onPtpOffset(OFFSET_US + noise);
+        tracker.onReport(train, rx + ((event % 3) * 10));
+    }
+    TEST_ASSERT_TRUE(tracker.isLocked());
+    TEST_ASSERT_INT64_WITHIN(2000, OFFSET_US, tracker.getOffset());
+}
+
+void test_new_train_restarts_calibration(void) {
+    tracker.onPtpOffset(OFFSET_US);
+    uint32_t event = 0;
+    for (uint8_t cycle = 0; cycle < 6; cycle++) {
+        for (uint8_t i = 0; i < ScheduleAnchorTracker::WINDOW; i++, event++) {
+            tracker.onReport(TRAIN, reportAt(event, 300));
+        }
+        tracker.onPtpOffset(OFFSET_US);
+    }
+    TEST_ASSERT_TRUE(tracker.isLocked());
+
+    ScheduleTrain restarted = {TRAIN.startUs + 60000000ULL, INTERVAL_US};
+    tracker.onReport(restarted, restarted.startUs + OFFSET_US + 12000);
+    TEST_ASSERT_FALSE(tracker.isLocked());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_encode_decode_roundtrip);
+    RUN_TEST(test_encode_rejects_small_buffer);
+    RUN_TEST(test_decode_rejects_foreign_payloads);
+    RUN_TEST(test_reports_ignored_before_ptp);
+    RUN_TEST(test_locks_to_train_offset);
+    RUN_TEST(test_offset_follows_drift_between_calibrations);
+    RUN_TEST(test_start_latency_near_half_interval_is_consistent);
+    RUN_TEST(test_new_train_restarts_calibration);
+
+    return UNITY_END();
+}
@@ -0,0 +1,232 @@
+/**
+ * @file test_secondary_peers.cpp
+ * @brief Unit tests for secondary_peers.h/cpp - extra SECONDARY sync and fan-out
+ */
+
+// Room for two extra peers regardless of the build's default
+#define BLE_MAX_SECONDARIES 3
+
+#include <unity.h>
+#include "secondary_peers.h"
+#include "../../src/sync_protocol.cpp"
+#include "../../src/secondary_peers.cpp"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static SecondaryPeerSet peers;
+
+static void fillMacrocycle(Macrocycle& mc) {
+    mc.sequenceId = 77;
+    mc.baseTime = 9000000;
+    mc.clockOffset = 0;
+    mc.durationMs = 100;
+    mc.eventCount = 6;
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        mc.events[i].deltaTimeMs = static_cast<uint16_t>(i * 167);
+        mc.events[i].finger = static_cast<uint8_t>(i % MAX_ACTUATORS);
+        mc.events[i].amplitude = static_cast<uint8_t>(60 + i);
+        mc.events[i].freqOffset = 0;
+    }
+}
+
+// One exchange: SECONDARY clock ahead by offsetUs, symmetric one-way delay
+static bool exchange(SecondaryPeer& peer, uint32_t seq, uint64_t t1, int64_t offsetUs,
+                     uint32_t oneWayUs) {
+    peers.beginPing(peer, seq);
+    TEST_ASSERT_TRUE(peers.onPingStamped(seq, t1));
+    uint64_t t2 = t1 + oneWayUs + offsetUs;
+    uint64_t t3 = t2 + 200;
+    uint64_t t4 = t3 - offsetUs + oneWayUs;
+    return peers.onPong(peer, seq, t2, t3, t4, 0);
+}
+
+void setUp(void) {
+    peers.clear();
+    mockSetMillis(1000);
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// PEER TABLE
+// =============================================================================
+
+void test_add_find_remove(void) {
+    TEST_ASSERT_NOT_NULL(peers.add(3, 0));
+    TEST_ASSERT_EQUAL_UINT8(1, peers.count());
+    TEST_ASSERT_NOT_NULL(peers.find(3));
+    TEST_ASSERT_NULL(peers.find(4));
+    TEST_ASSERT_NULL(peers.find(SecondaryPeerSet::HANDLE_NONE));
+
+    TEST_ASSERT_TRUE(peers.remove(3));
+    TEST_ASSERT_FALSE(peers.remove(3));
+    TEST_ASSERT_EQUAL_UINT8(0, peers.count());
+}
+
+void test_add_respects_capacity(void) {
+    for (uint8_t i = 0; i < SecondaryPeerSet::CAPACITY; i++) {
+        TEST_ASSERT_NOT_NULL(peers.add(10 + i, 0));
+    }
+    TEST_ASSERT_NULL(peers.add(99, 0));
+    // Re-adding a tracked handle reuses its slot
+    TEST_ASSERT_NOT_NULL(peers.add(10, 0));
+    TEST_ASSERT_EQUAL_UINT8(SecondaryPeerSet::CAPACITY, peers.count());
+}
+
+// =============================================================================
+// PING/PONG
+// =============================================================================
+
+void test_foreign_ping_stamp_not_claimed(void) {
+    SecondaryPeer* peer = peers.add(3, 0);
+    peers.beginPing(*peer, 5);
+    TEST_ASSERT_FALSE(peers.onPingStamped(6, 1000));  // Main peer's PING
+    TEST_ASSERT_TRUE(peers.onPingStamped(5, 1000));
+}
+
+void test_stale_pong_ignored(void) {
+    SecondaryPeer* peer = peers.add(3, 0);
+    peers.beginPing(*peer, 5);
+    peers.onPingStamped(5, 1000000);
+
+    TEST_ASSERT_FALSE(peers.onPong(*peer, 4, 1005000, 1005200, 1010200, 1234));
+    TEST_ASSERT_EQUAL_UINT32(1234, peer->lastPongMs);
+    TEST_ASSERT_EQUAL_UINT32(0, peer->sync.getOffsetSampleCount());
+}
+
+void test_exchanges_converge_per_peer(void) {
+    SecondaryPeer* a = peers.add(3, 0);
+    SecondaryPeer* b = peers.add(4, 0);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+
+    uint32_t seq = 1;
+    for (uint64_t i = 0; i < 12; i++) {
+        exchange(*peers.find(3), seq++, 1000000 + i * 100000, 25000, 4000);
+        exchange(*peers.find(4), seq++, 1050000 + i * 100000, -7000, 6000);
+    }
+
+    TEST_ASSERT_TRUE(peers.find(3)->sync.isClockSyncValid());
+    TEST_ASSERT_TRUE(peers.find(4)->sync.isClockSyncValid());
+    TEST_ASSERT_INT64_WITHIN(50, 25000, peers.find(3)->sync.getCorrectedOffset());
+    TEST_ASSERT_INT64_WITHIN(50, -7000, peers.find(4)->sync.getCorrectedOffset());
+}
+
+void test_remove_keeps_other_peer_state(void) {
+    peers.add(3, 0);
+    peers.add(4, 0);
+    uint32_t seq = 1;
+    for (uint64_t i = 0; i < 12; i++) {
+        exchange(*peers.find(4), seq++, 1000000 + i * 100000, 15000, 5000);
+    }
+
+    TEST_ASSERT_TRUE(peers.remove(3));
+    SecondaryPeer* b = peers.find(4);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_TRUE(b->sync.isClockSyncValid());
+    TEST_ASSERT_INT64_WITHIN(50, 15000, b->sync.getCorrectedOffset());
+}
+
+void test_retired_peer_takes_no_samples(void) {
+    SecondaryPeer* peer = peers.add(3, 0);
+    peers.beginPing(*peer, 5);
+    peers.onPingStamped(5, 1000000);
+
+    peers.retireAll();
+    TEST_ASSERT_TRUE(peer->retiring);
+    TEST_ASSERT_FALSE(peers.onPong(*peer, 5, 1005000, 1005200, 1010200, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, peer->sync.getOffsetSampleCount());
+
+    // Its disconnect is still recognized as an extra peer's
+    TEST_ASSERT_TRUE(peers.remove(3));
+}
+
+void test_lead_time_covers_synced_peers_only(void) {
+    SecondaryPeer* peer = peers.add(3, 0);
+    TEST_ASSERT_EQUAL_UINT32(1000, peers.maxLeadTimeUs(1000));  // Unsynced: no effect
+
+    uint32_t seq = 1;
+    for (uint64_t i = 0; i < 12; i++) {
+        exchange(*peer, seq++, 1000000 + i * 100000, 0, 20000);
+    }
+    TEST_ASSERT_TRUE(peer->sync.isClockSyncValid());
+    TEST_ASSERT_EQUAL_UINT32(peer->sync.calculateAdaptiveLeadTime(), peers.maxLeadTimeUs(1000));
+    TEST_ASSERT_EQUAL_UINT32(1000000, peers.maxLeadTimeUs(1000000));
+}
+
+// =============================================================================
+// MACROCYCLE FAN-OUT
+// =============================================================================
+
+void test_unprepared_frame_patches_nothing(void) {
+    MacrocycleFanoutFrame frame;
+    char out[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_EQUAL_UINT(0, frame.patch(100, out, sizeof(out)));
+}
+
+void test_patch_matches_direct_serialization(void) {
+    // Offsets whose bytes whiten into the escape set change the frame length
+    static const int64_t offsets[] = {
+        0, 1234, -98765, static_cast<int64_t>(0x8080808080808080ULL),
+        static_cast<int64_t>(0x1B9B848D00FF7F80ULL), INT64_MIN, INT64_MAX,
+    };
+
+    Macrocycle mc;
+    fillMacrocycle(mc);
+    mc.clockOffset = 555;
+    MacrocycleFanoutFrame frame;
+    TEST_ASSERT_TRUE(frame.prepare(mc));
+
+    for (int64_t offset : offsets) {
+        char patched[MESSAGE_BUFFER_SIZE];
+        size_t len = frame.patch(offset, patched, sizeof(patched));
+        TEST_ASSERT_TRUE(len > 0);
+        TEST_ASSERT_EQUAL_UINT(strlen(patched), len);
+
+        Macrocycle direct = mc;
+        direct.clockOffset = offset;
+        char expected[MESSAGE_BUFFER_SIZE];
+        TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(expected, sizeof(expected), direct,
+                                                          MACROCYCLE_WIRE_V6));
+        TEST_ASSERT_EQUAL_STRING(expected, patched);
+
+        Macrocycle decoded;
+        TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(patched, len, decoded));
+        TEST_ASSERT_EQUAL_INT64(offset, decoded.clockOffset);
+        TEST_ASSERT_EQUAL_UINT8(mc.eventCount, decoded.eventCount);
+    }
+}
+
+void test_patch_rejects_small_buffer(void) {
+    Macrocycle mc;
+    fillMacrocycle(mc);
+    MacrocycleFanoutFrame frame;
+    TEST_ASSERT_TRUE(frame.prepare(mc));
+
+    char out[24];
+    TEST_ASSERT_EQUAL_UINT(0, frame.patch(0, out, sizeof(out)));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_add_find_remove);
+    RUN_TEST(test_add_respects_capacity);
+    RUN_TEST(test_foreign_ping_stamp_not_claimed);
+    RUN_TEST(test_stale_pong_ignored);
+    RUN_TEST(test_exchanges_converge_per_peer);
+    RUN_TEST(test_remove_keeps_other_peer_state);
+    RUN_TEST(test_retired_peer_takes_no_samples);
+    RUN_TEST(test_lead_time_covers_synced_peers_only);
+    RUN_TEST(test_unprepared_frame_patches_nothing);
+    RUN_TEST(test_patch_matches_direct_serialization);
+    RUN_TEST(test_patch_rejects_small_buffer);
+
+    return UNITY_END();
+}
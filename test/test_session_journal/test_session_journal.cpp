@@ -0,0 +1,193 @@
+/**
+ * @file test_session_journal.cpp
+ * @brief Unit tests for session_journal.h/cpp - paged session log on fsb
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "session_journal.h"
+#include "fs_backend.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static constexpr uint32_t RECORDS = SESSION_JOURNAL_RECORDS_PER_PAGE;
+static constexpr uint32_t CHUNKS_PER_PAGE = SESSION_JOURNAL_PAGE_BYTES / SESSION_JOURNAL_CHUNK_BYTES;
+static constexpr uint32_t RING_PAGES = SESSION_JOURNAL_SEGMENTS * SESSION_JOURNAL_SEGMENT_PAGES;
+
+static SessionJournal* journal = nullptr;
+
+// Pages are 512 B each: rebuilt per test, not on the stack
+void setUp(void) {
+    fsb::mock::reset();
+    journal = new SessionJournal();
+}
+
+void tearDown(void) {
+    delete journal;
+    journal = nullptr;
+}
+
+static void recordEvents(uint32_t count, uint32_t firstScheduled = 0) {
+    for (uint32_t i = 0; i < count; i++) {
+        journal->record(JournalRecordType::EVENT, static_cast<uint8_t>(i % 4), 100,
+                        static_cast<int32_t>(firstScheduled + i), static_cast<int32_t>(i));
+    }
+}
+
+static void flushAll() {
+    while (journal->hasPendingPage()) {
+        journal->flushPending();
+    }
+}
+
+// Reassemble page `page` (0 = oldest) from its JOURNAL_GET chunks
+static bool readPage(uint32_t page, JournalPage& out) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&out);
+    for (uint32_t c = 0; c < CHUNKS_PER_PAGE; c++) {
+        size_t len = 0;
+        if (!journal->readChunk(page * CHUNKS_PER_PAGE + c, bytes + c * SESSION_JOURNAL_CHUNK_BYTES, len)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_nothing_recorded_outside_session(void) {
+    TEST_ASSERT_TRUE(journal->begin());
+    recordEvents(RECORDS * 3);
+    flushAll();
+    TEST_ASSERT_EQUAL_UINT32(0, journal->chunkCount());
+}
+
+void test_session_pages_roundtrip(void) {
+    TEST_ASSERT_TRUE(journal->begin());
+    journal->startSession(2, 7200);
+    recordEvents(RECORDS + 5);
+
+    // First page sealed by the overflowing record; the rest waits in RAM
+    TEST_ASSERT_TRUE(journal->hasPendingPage());
+    TEST_ASSERT_TRUE(journal->flushPending());
+    TEST_ASSERT_FALSE(journal->hasPendingPage());
+    TEST_ASSERT_EQUAL_UINT32(CHUNKS_PER_PAGE, journal->chunkCount());
+
+    journal->endSession(12, 340);
+    TEST_ASSERT_FALSE(journal->isRecording());
+    flushAll();
+    TEST_ASSERT_EQUAL_UINT32(2 * CHUNKS_PER_PAGE, journal->chunkCount());
+
+    JournalPage page;
+    TEST_ASSERT_TRUE(readPage(0, page));
+    TEST_ASSERT_EQUAL_UINT8(SESSION_JOURNAL_MAGIC, page.header.magic);
+    TEST_ASSERT_EQUAL_UINT8(RECORDS, page.header.count);
+    TEST_ASSERT_EQUAL_UINT32(0, page.header.sequence);
+    TEST_ASSERT_EQUAL_UINT32(1, page.header.sessionId);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(JournalRecordType::SESSION_START), page.records[0].type);
+    TEST_ASSERT_EQUAL_UINT8(2, page.records[0].arg);
+    TEST_ASSERT_EQUAL_INT32(7200, page.records[0].a);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(JournalRecordType::EVENT), page.records[1].type);
+    TEST_ASSERT_EQUAL_INT32(0, page.records[1].a);
+
+    // SESSION_START + RECORDS + 5 events + SESSION_END spill 7 into page 2
+    TEST_ASSERT_TRUE(readPage(1, page));
+    TEST_ASSERT_EQUAL_UINT32(1, page.header.sequence);
+    TEST_ASSERT_EQUAL_UINT8(7, page.header.count);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(JournalRecordType::SESSION_END), page.records[6].type);
+    TEST_ASSERT_EQUAL_INT32(12, page.records[6].a);
+    TEST_ASSERT_EQUAL_INT32(340, page.records[6].b);
+
+    size_t len = 0;
+    uint8_t chunk[SESSION_JOURNAL_CHUNK_BYTES];
+    TEST_ASSERT_FALSE(journal->readChunk(2 * CHUNKS_PER_PAGE, chunk, len));
+}
+
+void test_records_dropped_while_both_pages_busy(void) {
+    TEST_ASSERT_TRUE(journal->begin());
+    journal->startSession(0, 60);
+    // START + events fill page 1 and page 2; nothing flushed in between
+    recordEvents(2 * RECORDS - 1 + 3);
+    TEST_ASSERT_EQUAL_UINT32(3, journal->droppedRecords());
+
+    TEST_ASSERT_TRUE(journal->flushPending());
+    recordEvents(1);  // Room again
+    TEST_ASSERT_EQUAL_UINT32(3, journal->droppedRecords());
+}
+
+void test_resumes_after_reboot(void) {
+    TEST_ASSERT_TRUE(journal->begin());
+    journal->startSession(1, 60);
+    recordEvents(RECORDS);
+    flushAll();
+    recordEvents(RECORDS);
+    journal->endSession(1, 2);
+    flushAll();
+    uint32_t chunks = journal->chunkCount();
+    TEST_ASSERT_EQUAL_UINT32(3 * CHUNKS_PER_PAGE, chunks);
+
+    delete journal;
+    journal = new SessionJournal();
+    TEST_ASSERT_TRUE(journal->begin());
+    TEST_ASSERT_EQUAL_UINT32(chunks, journal->chunkCount());
+
+    journal->startSession(1, 60);
+    TEST_ASSERT_EQUAL_UINT32(2, journal->sessionId());
+    journal->endSession(0, 0);
+    flushAll();
+
+    JournalPage page;
+    TEST_ASSERT_TRUE(readPage(3, page));
+    TEST_ASSERT_EQUAL_UINT32(3, page.header.sequence);
+    TEST_ASSERT_EQUAL_UINT32(2, page.header.sessionId);
+}
+
+void test_ring_wraps_oldest_segment(void) {
+    TEST_ASSERT_TRUE(journal->begin());
+    journal->startSession(0, 0);
+    uint32_t pages = RING_PAGES + SESSION_JOURNAL_SEGMENT_PAGES + 1;
+    for (uint32_t p = 0; p < pages; p++) {
+        recordEvents(RECORDS, p * RECORDS);
+        journal->flushPending();
+    }
+
+    // The segment holding the newest page was rewritten; the ring keeps the
+    // others whole
+    uint32_t kept = RING_PAGES - SESSION_JOURNAL_SEGMENT_PAGES + 1;
+    TEST_ASSERT_EQUAL_UINT32(kept * CHUNKS_PER_PAGE, journal->chunkCount());
+
+    JournalPage page;
+    TEST_ASSERT_TRUE(readPage(0, page));
+    TEST_ASSERT_EQUAL_UINT32(pages - kept, page.header.sequence);
+    TEST_ASSERT_TRUE(readPage(kept - 1, page));
+    TEST_ASSERT_EQUAL_UINT32(pages - 1, page.header.sequence);
+}
+
+void test_storage_unavailable_is_harmless(void) {
+    fsb::mock::setBeginResult(false);
+    TEST_ASSERT_FALSE(journal->begin());
+    journal->startSession(0, 0);
+    recordEvents(RECORDS * 2);
+    TEST_ASSERT_FALSE(journal->flushPending());
+    TEST_ASSERT_EQUAL_UINT32(0, journal->chunkCount());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_nothing_recorded_outside_session);
+    RUN_TEST(test_session_pages_roundtrip);
+    RUN_TEST(test_records_dropped_while_both_pages_busy);
+    RUN_TEST(test_resumes_after_reboot);
+    RUN_TEST(test_ring_wraps_oldest_segment);
+    RUN_TEST(test_storage_unavailable_is_harmless);
+
+    return UNITY_END();
+}
@@ -0,0 +1,244 @@
+/**
+ * @file test_settings_log.cpp
+ * @brief Unit tests for settings_log.h/cpp - append-only settings on fsb
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "settings_log.h"
+#include "fs_backend.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+struct __attribute__((packed)) TestImage {
+    uint8_t flag;
+    uint16_t speed;
+    float value;
+    char name[16];
+};
+
+static TestImage makeImage() {
+    TestImage image;
+    memset(&image, 0, sizeof(image));
+    image.flag = 1;
+    image.speed = 400;
+    image.value = 12.5f;
+    strcpy(image.name, "noisy_vcr");
+    return image;
+}
+
+static bool saveImage(SettingsLog& log, const TestImage& image) {
+    return log.save(reinterpret_cast<const uint8_t*>(&image), sizeof(image));
+}
+
+static bool loadImage(TestImage& image) {
+    SettingsLog log;
+    memset(&image, 0xEE, sizeof(image));
+    return log.load(reinterpret_cast<uint8_t*>(&image), sizeof(image));
+}
+
+static size_t fileSize(const char* path) {
+    uint8_t buf[SETTINGS_LOG_MAX_BYTES + 1];
+    size_t n = 0;
+    return fsb::readFile(path, buf, sizeof(buf), n) ? n : 0;
+}
+
+void setUp(void) {
+    fsb::mock::reset();
+    fsb::begin();
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_load_without_files_fails(void) {
+    TestImage image;
+    TEST_ASSERT_FALSE(loadImage(image));
+}
+
+void test_first_save_writes_whole_image(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    TEST_ASSERT_EQUAL_UINT(sizeof(SettingsLogHeader) + sizeof(image) + SETTINGS_LOG_RECORD_OVERHEAD,
+                           log.logBytes());
+
+    TestImage loaded;
+    TEST_ASSERT_TRUE(loadImage(loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&image, &loaded, sizeof(image));
+}
+
+void test_change_appends_only_changed_field(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    size_t before = log.logBytes();
+
+    image.flag = 0;
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    TEST_ASSERT_EQUAL_UINT(before + 1 + SETTINGS_LOG_RECORD_OVERHEAD, log.logBytes());
+    TEST_ASSERT_EQUAL_UINT(log.logBytes(), fileSize(SETTINGS_LOG_FILE_A));
+
+    TestImage loaded;
+    TEST_ASSERT_TRUE(loadImage(loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&image, &loaded, sizeof(image));
+}
+
+void test_unchanged_save_writes_nothing(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    size_t before = log.logBytes();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    TEST_ASSERT_EQUAL_UINT(before, log.logBytes());
+}
+
+void test_log_compacts_into_other_file(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    uint32_t generation = log.generation();
+
+    for (uint32_t i = 0; i < 200; i++) {
+        image.speed = static_cast<uint16_t>(i);
+        TEST_ASSERT_TRUE(saveImage(log, image));
+        TEST_ASSERT_TRUE(log.logBytes() <= SETTINGS_LOG_MAX_BYTES);
+    }
+    TEST_ASSERT_TRUE(log.generation() > generation);
+    TEST_ASSERT_TRUE(fsb::exists(SETTINGS_LOG_FILE_A) != fsb::exists(SETTINGS_LOG_FILE_B));
+
+    TestImage loaded;
+    TEST_ASSERT_TRUE(loadImage(loaded));
+    TEST_ASSERT_EQUAL_UINT16(199, loaded.speed);
+}
+
+void test_torn_append_keeps_earlier_records(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    image.speed = 1000;
+    TEST_ASSERT_TRUE(saveImage(log, image));
+
+    // Half a record: offset and length only
+    const uint8_t torn[] = {0, 1};
+    TEST_ASSERT_TRUE(fsb::appendFile(SETTINGS_LOG_FILE_A, torn, sizeof(torn)));
+
+    SettingsLog reloaded;
+    TestImage loaded;
+    TEST_ASSERT_TRUE(reloaded.load(reinterpret_cast<uint8_t*>(&loaded), sizeof(loaded)));
+    TEST_ASSERT_EQUAL_UINT16(1000, loaded.speed);
+
+    // Next save rewrites rather than appending after the garbage
+    loaded.flag = 0;
+    TEST_ASSERT_TRUE(reloaded.save(reinterpret_cast<const uint8_t*>(&loaded), sizeof(loaded)));
+    TEST_ASSERT_TRUE(fsb::exists(SETTINGS_LOG_FILE_B));
+    TEST_ASSERT_FALSE(fsb::exists(SETTINGS_LOG_FILE_A));
+
+    TestImage again;
+    TEST_ASSERT_TRUE(loadImage(again));
+    TEST_ASSERT_EQUAL_UINT8(0, again.flag);
+    TEST_ASSERT_EQUAL_UINT16(1000, again.speed);
+}
+
+void test_torn_compaction_falls_back_to_previous_file(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+
+    // A newer file whose base record never completed
+    uint8_t partial[sizeof(SettingsLogHeader) + 4];
+    SettingsLogHeader header = {SETTINGS_LOG_MAGIC, SETTINGS_LOG_VERSION,
+                                static_cast<uint8_t>(sizeof(TestImage)), 0, log.generation() + 1};
+    memcpy(partial, &header, sizeof(header));
+    memset(partial + sizeof(header), 0, 4);
+    partial[sizeof(header) + 1] = sizeof(TestImage);
+    TEST_ASSERT_TRUE(fsb::writeFile(SETTINGS_LOG_FILE_B, partial, sizeof(partial)));
+
+    TestImage loaded;
+    TEST_ASSERT_TRUE(loadImage(loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&image, &loaded, sizeof(image));
+}
+
+void test_different_image_size_is_ignored(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+
+    SettingsLog other;
+    uint8_t small[4];
+    TEST_ASSERT_FALSE(other.load(small, sizeof(small)));
+}
+
+void test_shorter_image_loads_zero_filled_and_is_rewritten(void) {
+    // Written before name was appended
+    TestImage image = makeImage();
+    const size_t oldSize = offsetof(TestImage, name);
+    SettingsLog oldLog;
+    TEST_ASSERT_TRUE(oldLog.save(reinterpret_cast<const uint8_t*>(&image), oldSize));
+    size_t oldBytes = fileSize(SETTINGS_LOG_FILE_A);
+
+    SettingsLog log;
+    TestImage loaded;
+    memset(&loaded, 0xEE, sizeof(loaded));
+    TEST_ASSERT_TRUE(log.load(reinterpret_cast<uint8_t*>(&loaded), sizeof(loaded), oldSize));
+    TEST_ASSERT_EQUAL_MEMORY(&image, &loaded, oldSize);
+    const char zeros[sizeof(loaded.name)] = {};
+    TEST_ASSERT_EQUAL_MEMORY(zeros, loaded.name, sizeof(zeros));
+    TEST_ASSERT_EQUAL(2, log.generation());
+    TEST_ASSERT_EQUAL(oldBytes + sizeof(loaded.name), fileSize(SETTINGS_LOG_FILE_B));
+    TEST_ASSERT_FALSE(fsb::exists(SETTINGS_LOG_FILE_A));
+
+    // Appends now patch the full image
+    strcpy(loaded.name, "gentle");
+    TEST_ASSERT_TRUE(saveImage(log, loaded));
+    TestImage reloaded;
+    TEST_ASSERT_TRUE(loadImage(reloaded));
+    TEST_ASSERT_EQUAL_MEMORY(&loaded, &reloaded, sizeof(loaded));
+}
+
+void test_image_below_min_size_is_ignored(void) {
+    TestImage image = makeImage();
+    SettingsLog oldLog;
+    TEST_ASSERT_TRUE(oldLog.save(reinterpret_cast<const uint8_t*>(&image), offsetof(TestImage, value)));
+
+    SettingsLog log;
+    TestImage loaded;
+    TEST_ASSERT_FALSE(log.load(reinterpret_cast<uint8_t*>(&loaded), sizeof(loaded), offsetof(TestImage, name)));
+    TEST_ASSERT_FALSE(loadImage(loaded));  // Without minSize only the exact size loads
+}
+
+void test_erase_removes_files(void) {
+    SettingsLog log;
+    TestImage image = makeImage();
+    TEST_ASSERT_TRUE(saveImage(log, image));
+    TEST_ASSERT_TRUE(log.erase());
+    TestImage loaded;
+    TEST_ASSERT_FALSE(loadImage(loaded));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_load_without_files_fails);
+    RUN_TEST(test_first_save_writes_whole_image);
+    RUN_TEST(test_change_appends_only_changed_field);
+    RUN_TEST(test_unchanged_save_writes_nothing);
+    RUN_TEST(test_log_compacts_into_other_file);
+    RUN_TEST(test_torn_append_keeps_earlier_records);
+    RUN_TEST(test_torn_compaction_falls_back_to_previous_file);
+    RUN_TEST(test_different_image_size_is_ignored);
+    RUN_TEST(test_shorter_image_loads_zero_filled_and_is_rewritten);
+    RUN_TEST(test_image_below_min_size_is_ignored);
+    RUN_TEST(test_erase_removes_files);
+
+    return UNITY_END();
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_skew_calibration.cpp
+ * @brief Unit tests for skew_calibration.h/cpp - Persisted per-peer skew
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "skew_calibration.h"
+#include "fs_backend.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static const uint8_t PEER_A[SKEW_CAL_ADDR_LEN] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+static const uint8_t PEER_B[SKEW_CAL_ADDR_LEN] = {0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6};
+
+static constexpr int16_t TEMP_25C = 100;  // 0.25 C units
+
+void setUp(void) {
+    fsb::mock::reset();
+    (void)fsb::begin();
+}
+
+void tearDown(void) {
+}
+
+// Address n of a family distinct from PEER_A/PEER_B
+static void makePeer(uint8_t n, uint8_t* addr) {
+    memset(addr, 0xC0, SKEW_CAL_ADDR_LEN);
+    addr[0] = n;
+}
+
+// =============================================================================
+// PERSISTENCE TESTS
+// =============================================================================
+
+void test_missing_file_starts_empty(void) {
+    SkewCalibrationStore store;
+    TEST_ASSERT_FALSE(store.load());
+    TEST_ASSERT_EQUAL_UINT8(0, store.count());
+    TEST_ASSERT_FALSE(store.isDirty());
+}
+
+void test_roundtrip_across_boots(void) {
+    {
+        SkewCalibrationStore store;
+        (void)store.load();
+        store.record(PEER_A, 0.0125f, 0.0004f, TEMP_25C);
+        TEST_ASSERT_TRUE(store.isDirty());
+        TEST_ASSERT_TRUE(store.save());
+        TEST_ASSERT_FALSE(store.isDirty());
+    }
+
+    SkewCalibrationStore rebooted;
+    TEST_ASSERT_TRUE(rebooted.load());
+    TEST_ASSERT_EQUAL_UINT8(1, rebooted.count());
+
+    float skew = 0.0f, sigma = 0.0f;
+    TEST_ASSERT_TRUE(rebooted.lookup(PEER_A, TEMP_25C, skew, sigma));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0125f, skew);
+    // Saved sigma is below the floor: the floor applies
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, SYNC_SKEW_CAL_SIGMA_US_PER_MS, sigma);
+    TEST_ASSERT_FALSE(rebooted.lookup(PEER_B, TEMP_25C, skew, sigma));
+}
+
+void test_corrupt_file_is_ignored(void) {
+    const uint8_t junk[] = {0x00, 0x01, 0x02};
+    TEST_ASSERT_TRUE(fsb::writeFile(SKEW_CAL_FILE, junk, sizeof(junk)));
+
+    SkewCalibrationStore store;
+    TEST_ASSERT_FALSE(store.load());
+    TEST_ASSERT_EQUAL_UINT8(0, store.count());
+}
+
+// =============================================================================
+// AGING AND TEMPERATURE TESTS
+// =============================================================================
+
+void test_entry_expires_after_max_age(void) {
+    SkewCalibrationStore store;
+    (void)store.load();
+    store.record(PEER_A, 0.01f, 0.002f, TEMP_25C);
+    TEST_ASSERT_TRUE(store.save());
+
+    float skew, sigma;
+    for (uint16_t boot = 1; boot <= SYNC_SKEW_CAL_MAX_AGE_BOOTS; boot++) {
+        SkewCalibrationStore next;
+        TEST_ASSERT_TRUE(next.load());
+        TEST_ASSERT_TRUE(next.lookup(PEER_A, TEMP_25C, skew, sigma));
+        // Persist the advanced generation without touching the entry
+        next.record(PEER_B, 0.0f, 0.002f, TEMP_25C);
+        TEST_ASSERT_TRUE(next.save());
+    }
+
+    SkewCalibrationStore stale;
+    TEST_ASSERT_TRUE(stale.load());
+    TEST_ASSERT_FALSE(stale.lookup(PEER_A, TEMP_25C, skew, sigma));
+    TEST_ASSERT_TRUE(stale.lookup(PEER_B, TEMP_25C, skew, sigma));
+}
+
+void test_temperature_delta_widens_then_rejects(void) {
+    SkewCalibrationStore store;
+    (void)store.load();
+    store.record(PEER_A, 0.01f, 0.002f, TEMP_25C);
+
+    float skew, sigma;
+    TEST_ASSERT_TRUE(store.lookup(PEER_A, TEMP_25C + 40, skew, sigma));  // +10 C
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.002f + 10.0f * SYNC_SKEW_CAL_TEMP_SIGMA_PER_C, sigma);
+
+    int16_t tooFar = static_cast<int16_t>(TEMP_25C - (SYNC_SKEW_CAL_MAX_TEMP_DELTA_C + 1.0f) * 4.0f);
+    TEST_ASSERT_FALSE(store.lookup(PEER_A, tooFar, skew, sigma));
+}
+
+void test_unknown_temperature_assumes_worst_case(void) {
+    SkewCalibrationStore store;
+    (void)store.load();
+    store.record(PEER_A, 0.01f, 0.002f, SKEW_CAL_NO_TEMPERATURE);
+
+    float skew, sigma;
+    TEST_ASSERT_TRUE(store.lookup(PEER_A, TEMP_25C, skew, sigma));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f,
+        0.002f + SYNC_SKEW_CAL_MAX_TEMP_DELTA_C * SYNC_SKEW_CAL_TEMP_SIGMA_PER_C, sigma);
+}
+
+// =============================================================================
+// ENTRY MANAGEMENT TESTS
+// =============================================================================
+
+void test_record_updates_existing_peer(void) {
+    SkewCalibrationStore store;
+    (void)store.load();
+    store.record(PEER_A, 0.01f, 0.002f, TEMP_25C);
+    store.record(PEER_B, 0.02f, 0.002f, TEMP_25C);
+    store.record(PEER_A, 0.03f, 0.002f, TEMP_25C);
+    TEST_ASSERT_EQUAL_UINT8(2, store.count());
+
+    float skew, sigma;
+    TEST_ASSERT_TRUE(store.lookup(PEER_A, TEMP_25C, skew, sigma));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.03f, skew);
+}
+
+void test_full_store_evicts_least_recent(void) {
+    SkewCalibrationStore store;
+    (void)store.load();
+    store.record(PEER_A, 0.01f, 0.002f, TEMP_25C);
+    uint8_t addr[SKEW_CAL_ADDR_LEN];
+    for (uint8_t i = 1; i < SYNC_SKEW_CAL_MAX_PEERS; i++) {
+        makePeer(i, addr);
+        store.record(addr, 0.0f, 0.002f, TEMP_25C);
+    }
+    // Touch PEER_A so the oldest is now peer 1
+    store.record(PEER_A, 0.01f, 0.002f, TEMP_25C);
+    store.record(PEER_B, 0.02f, 0.002f, TEMP_25C);
+    TEST_ASSERT_EQUAL_UINT8(SYNC_SKEW_CAL_MAX_PEERS, store.count());
+
+    float skew, sigma;
+    TEST_ASSERT_TRUE(store.lookup(PEER_A, TEMP_25C, skew, sigma));
+    TEST_ASSERT_TRUE(store.lookup(PEER_B, TEMP_25C, skew, sigma));
+    makePeer(1, addr);
+    TEST_ASSERT_FALSE(store.lookup(addr, TEMP_25C, skew, sigma));
+}
+
+void test_clear_forgets_all_peers(void) {
+    SkewCalibrationStore store;
+    (void)store.load();
+    store.record(PEER_A, 0.01f, 0.002f, TEMP_25C);
+    TEST_ASSERT_TRUE(store.save());
+    store.clear();
+    TEST_ASSERT_TRUE(store.save());
+
+    SkewCalibrationStore rebooted;
+    TEST_ASSERT_TRUE(rebooted.load());
+    TEST_ASSERT_EQUAL_UINT8(0, rebooted.count());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_missing_file_starts_empty);
+    RUN_TEST(test_roundtrip_across_boots);
+    RUN_TEST(test_corrupt_file_is_ignored);
+    RUN_TEST(test_entry_expires_after_max_age);
+    RUN_TEST(test_temperature_delta_widens_then_rejects);
+    RUN_TEST(test_unknown_temperature_assumes_worst_case);
+    RUN_TEST(test_record_updates_existing_peer);
+    RUN_TEST(test_full_store_evicts_least_recent);
+    RUN_TEST(test_clear_forgets_all_peers);
+
+    return UNITY_END();
+}
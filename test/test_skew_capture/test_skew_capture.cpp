@@ -0,0 +1,152 @@
+/**
+ * @file test_skew_capture.cpp
+ * @brief Unit tests for skew_capture.h/cpp - pairing captured and local edges
+ */
+
+#include <unity.h>
+#include "skew_capture.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static SkewCapture capture;
+static int32_t skews[SYNC_SKEW_CAPTURE_RING_SIZE];
+
+static constexpr uint64_t T0 = 10000000ULL;
+
+void setUp(void) {
+    capture.reset();
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_begin_is_inert_on_native(void) {
+    TEST_ASSERT_FALSE(capture.begin());
+    TEST_ASSERT_FALSE(capture.isActive());
+}
+
+void test_pairs_secondary_late(void) {
+    capture.onRemoteEdge(T0);
+    capture.onLocalEdge(T0 + 150);
+
+    TEST_ASSERT_EQUAL_UINT8(1, capture.process(T0 + 200, skews, SYNC_SKEW_CAPTURE_RING_SIZE));
+    TEST_ASSERT_EQUAL_INT32(150, skews[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, capture.getStats().paired);
+}
+
+void test_pairs_secondary_early(void) {
+    // The PRIMARY's edge may be staged after the local one
+    capture.onLocalEdge(T0);
+    TEST_ASSERT_EQUAL_UINT8(0, capture.process(T0 + 10, skews, SYNC_SKEW_CAPTURE_RING_SIZE));
+    capture.onRemoteEdge(T0 + 80);
+
+    TEST_ASSERT_EQUAL_UINT8(1, capture.process(T0 + 100, skews, SYNC_SKEW_CAPTURE_RING_SIZE));
+    TEST_ASSERT_EQUAL_INT32(-80, skews[0]);
+}
+
+void test_cluster_pairs_in_order(void) {
+    // A batched cluster pulses several edges microseconds apart on each side
+    for (uint64_t i = 0; i < 3; i++) {
+        capture.onRemoteEdge(T0 + i * 5);
+        capture.onLocalEdge(T0 + 40 + i * 6);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(3, capture.process(T0 + 100, skews, SYNC_SKEW_CAPTURE_RING_SIZE));
+    TEST_ASSERT_EQUAL_INT32(40, skews[0]);
+    TEST_ASSERT_EQUAL_INT32(41, skews[1]);
+    TEST_ASSERT_EQUAL_INT32(42, skews[2]);
+}
+
+void test_missed_pulse_skips_unpartnered_edge(void) {
+    // PRIMARY edge for activation 1 was missed; activation 2 still pairs
+    capture.onLocalEdge(T0);
+    capture.onRemoteEdge(T0 + 100000);
+    capture.onLocalEdge(T0 + 100050);
+
+    TEST_ASSERT_EQUAL_UINT8(1, capture.process(T0 + 100100, skews, SYNC_SKEW_CAPTURE_RING_SIZE));
+    TEST_ASSERT_EQUAL_INT32(50, skews[0]);
+
+    SkewCaptureStats stats = capture.getStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.paired);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.unmatchedLocal);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.unmatchedRemote);
+}
+
+void test_lone_edge_waits_one_window(void) {
+    capture.onRemoteEdge(T0);
+
+    TEST_ASSERT_EQUAL_UINT8(0, capture.process(T0 + SYNC_SKEW_CAPTURE_WINDOW_US, skews,
+                                               SYNC_SKEW_CAPTURE_RING_SIZE));
+    TEST_ASSERT_EQUAL_UINT32(0, capture.getStats().unmatchedRemote);
+
+    TEST_ASSERT_EQUAL_UINT8(0, capture.process(T0 + SYNC_SKEW_CAPTURE_WINDOW_US + 1, skews,
+                                               SYNC_SKEW_CAPTURE_RING_SIZE));
+    TEST_ASSERT_EQUAL_UINT32(1, capture.getStats().unmatchedRemote);
+
+    // The expired edge no longer pairs with a late local activation
+    capture.onLocalEdge(T0 + SYNC_SKEW_CAPTURE_WINDOW_US + 2);
+    TEST_ASSERT_EQUAL_UINT8(0, capture.process(T0 + SYNC_SKEW_CAPTURE_WINDOW_US + 3, skews,
+                                               SYNC_SKEW_CAPTURE_RING_SIZE));
+}
+
+void test_process_respects_capacity(void) {
+    for (uint64_t i = 0; i < 4; i++) {
+        capture.onRemoteEdge(T0 + i * 1000);
+        capture.onLocalEdge(T0 + i * 1000 + 10);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(3, capture.process(T0 + 5000, skews, 3));
+    TEST_ASSERT_EQUAL_UINT8(1, capture.process(T0 + 5000, skews, 3));
+    TEST_ASSERT_EQUAL_UINT32(4, capture.getStats().paired);
+}
+
+void test_full_ring_counts_dropped(void) {
+    // One slot stays free to tell full from empty
+    for (uint8_t i = 0; i < SkewEdgeRing::SIZE; i++) {
+        capture.onRemoteEdge(T0 + i);
+        capture.onLocalEdge(T0 + i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, capture.getStats().dropped);
+    TEST_ASSERT_EQUAL_UINT8(SkewEdgeRing::SIZE - 1,
+                            capture.process(T0 + 100, skews, SYNC_SKEW_CAPTURE_RING_SIZE));
+}
+
+void test_reset_clears_edges_and_stats(void) {
+    capture.onRemoteEdge(T0);
+    capture.onLocalEdge(T0 + 5);
+    capture.process(T0 + 10, skews, SYNC_SKEW_CAPTURE_RING_SIZE);
+    capture.onRemoteEdge(T0 + 20);
+
+    capture.reset();
+
+    SkewCaptureStats stats = capture.getStats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.paired);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped);
+    capture.onLocalEdge(T0 + 25);
+    TEST_ASSERT_EQUAL_UINT8(0, capture.process(T0 + 30, skews, SYNC_SKEW_CAPTURE_RING_SIZE));
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_begin_is_inert_on_native);
+    RUN_TEST(test_pairs_secondary_late);
+    RUN_TEST(test_pairs_secondary_early);
+    RUN_TEST(test_cluster_pairs_in_order);
+    RUN_TEST(test_missed_pulse_skips_unpartnered_edge);
+    RUN_TEST(test_lone_edge_waits_one_window);
+    RUN_TEST(test_process_respects_capacity);
+    RUN_TEST(test_full_ring_counts_dropped);
+    RUN_TEST(test_reset_clears_edges_and_stats);
+
+    return UNITY_END();
+}
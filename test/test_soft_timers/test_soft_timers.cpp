@@ -0,0 +1,179 @@
+/**
+ * @file test_soft_timers.cpp
+ * @brief Unit tests for soft_timers.h/cpp - Fixed-capacity millis() timers
+ */
+
+#include <unity.h>
+#include "soft_timers.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static SoftTimers* timers = nullptr;
+
+static uint8_t firedA = 0;
+static uint8_t firedB = 0;
+static uint8_t firedC = 0;
+static char order[8];
+static uint8_t orderLen = 0;
+
+static void onA() { firedA++; if (orderLen < sizeof(order)) order[orderLen++] = 'A'; }
+static void onB() { firedB++; if (orderLen < sizeof(order)) order[orderLen++] = 'B'; }
+static void onC() { firedC++; if (orderLen < sizeof(order)) order[orderLen++] = 'C'; }
+
+void setUp(void) {
+    static SoftTimers instance;
+    instance = SoftTimers();
+    timers = &instance;
+    firedA = firedB = firedC = 0;
+    orderLen = 0;
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// REGISTRATION TESTS
+// =============================================================================
+
+void test_add_until_capacity(void) {
+    for (uint8_t i = 0; i < SoftTimers::CAPACITY; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, timers->add(onA));
+    }
+    TEST_ASSERT_EQUAL_UINT8(SOFT_TIMER_NONE, timers->add(onA));
+    TEST_ASSERT_FALSE(timers->isActive(0));
+    uint32_t due = 0;
+    TEST_ASSERT_FALSE(timers->nextDue(due));
+}
+
+// =============================================================================
+// ONE-SHOT TESTS
+// =============================================================================
+
+void test_one_shot_fires_once_at_due_time(void) {
+    SoftTimerId a = timers->add(onA);
+    timers->start(a, 1000, 50);
+    TEST_ASSERT_EQUAL_UINT8(0, timers->advance(1049));
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(1050));
+    TEST_ASSERT_FALSE(timers->isActive(a));
+    TEST_ASSERT_EQUAL_UINT8(0, timers->advance(5000));
+    TEST_ASSERT_EQUAL_UINT8(1, firedA);
+}
+
+void test_next_due_is_earliest_and_fires_in_order(void) {
+    SoftTimerId a = timers->add(onA);
+    SoftTimerId b = timers->add(onB);
+    SoftTimerId c = timers->add(onC);
+    timers->start(a, 0, 300);
+    timers->start(b, 0, 100);
+    timers->start(c, 0, 200);
+
+    uint32_t due = 0;
+    TEST_ASSERT_TRUE(timers->nextDue(due));
+    TEST_ASSERT_EQUAL_UINT32(100, due);
+
+    TEST_ASSERT_EQUAL_UINT8(3, timers->advance(1000));
+    TEST_ASSERT_EQUAL_MEMORY("BCA", order, 3);
+}
+
+void test_restart_moves_deadline(void) {
+    SoftTimerId a = timers->add(onA);
+    SoftTimerId b = timers->add(onB);
+    timers->start(a, 0, 100);
+    timers->start(b, 0, 200);
+    timers->start(a, 50, 500);  // Re-arm: now due at 550
+
+    uint32_t due = 0;
+    TEST_ASSERT_TRUE(timers->nextDue(due));
+    TEST_ASSERT_EQUAL_UINT32(200, due);
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(300));
+    TEST_ASSERT_EQUAL_UINT8(0, firedA);
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(550));
+    TEST_ASSERT_EQUAL_UINT8(1, firedA);
+}
+
+void test_stop_disarms(void) {
+    SoftTimerId a = timers->add(onA);
+    SoftTimerId b = timers->add(onB);
+    timers->start(a, 0, 100);
+    timers->start(b, 0, 200);
+    timers->stop(a);
+    timers->stop(a);  // Idempotent
+
+    TEST_ASSERT_FALSE(timers->isActive(a));
+    uint32_t due = 0;
+    TEST_ASSERT_TRUE(timers->nextDue(due));
+    TEST_ASSERT_EQUAL_UINT32(200, due);
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(1000));
+    TEST_ASSERT_EQUAL_UINT8(0, firedA);
+}
+
+// =============================================================================
+// PERIODIC TESTS
+// =============================================================================
+
+void test_periodic_keeps_phase(void) {
+    SoftTimerId a = timers->add(onA);
+    timers->start(a, 0, 100, 100);
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(130));  // 30ms late
+    uint32_t due = 0;
+    TEST_ASSERT_TRUE(timers->nextDue(due));
+    TEST_ASSERT_EQUAL_UINT32(200, due);                // Not 230
+}
+
+void test_periodic_far_behind_skips_missed_periods(void) {
+    SoftTimerId a = timers->add(onA);
+    timers->start(a, 0, 100, 100);
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(1050));
+    uint32_t due = 0;
+    TEST_ASSERT_TRUE(timers->nextDue(due));
+    TEST_ASSERT_EQUAL_UINT32(1150, due);
+    TEST_ASSERT_EQUAL_UINT8(1, firedA);
+}
+
+void test_pop_expired_leaves_callback_to_caller(void) {
+    SoftTimerId a = timers->add(onA);
+    timers->start(a, 0, 10);
+    TEST_ASSERT_EQUAL_UINT8(SOFT_TIMER_NONE, timers->popExpired(9));
+    TEST_ASSERT_EQUAL_UINT8(a, timers->popExpired(10));
+    TEST_ASSERT_EQUAL_UINT8(0, firedA);
+    TEST_ASSERT_TRUE(timers->callback(a) == onA);
+    TEST_ASSERT_TRUE(timers->callback(SOFT_TIMER_NONE) == nullptr);
+}
+
+void test_deadlines_order_across_millis_wrap(void) {
+    SoftTimerId a = timers->add(onA);
+    SoftTimerId b = timers->add(onB);
+    uint32_t now = 0xFFFFFF00u;
+    timers->start(a, now, 0x200);  // Due after the wrap
+    timers->start(b, now, 0x80);   // Due before it
+
+    uint32_t due = 0;
+    TEST_ASSERT_TRUE(timers->nextDue(due));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFF80u, due);
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(0xFFFFFFFFu));
+    TEST_ASSERT_EQUAL_UINT8(0, firedA);
+    TEST_ASSERT_EQUAL_UINT8(1, timers->advance(0x100));
+    TEST_ASSERT_EQUAL_UINT8(1, firedA);
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_add_until_capacity);
+    RUN_TEST(test_one_shot_fires_once_at_due_time);
+    RUN_TEST(test_next_due_is_earliest_and_fires_in_order);
+    RUN_TEST(test_restart_moves_deadline);
+    RUN_TEST(test_stop_disarms);
+    RUN_TEST(test_periodic_keeps_phase);
+    RUN_TEST(test_periodic_far_behind_skips_missed_periods);
+    RUN_TEST(test_pop_expired_leaves_callback_to_caller);
+    RUN_TEST(test_deadlines_order_across_millis_wrap);
+
+    return UNITY_END();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file test_status_snapshot.cpp
+ * @brief Unit tests for status_snapshot.h/cpp - two-slot seqlock status store
+ */
+
+#include <unity.h>
+#include "status_snapshot.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static StatusSeqlock* store = nullptr;
+
+void setUp(void) {
+    store = new StatusSeqlock();
+}
+
+void tearDown(void) {
+    delete store;
+    store = nullptr;
+}
+
+static StatusSnapshot makeSnapshot(uint32_t tag) {
+    StatusSnapshot status;
+    status.publishedMs = tag;
+    status.state = TherapyState::RUNNING;
+    status.therapyRunning = true;
+    status.elapsedSeconds = tag;
+    status.durationSeconds = 2 * tag;
+    status.clockOffsetUs = -static_cast<int64_t>(tag) * 1000000LL;  // Needs both 32-bit halves
+    status.battery.voltage = 3.7f;
+    return status;
+}
+
+// =============================================================================
+// PUBLISH / READ
+// =============================================================================
+
+void test_read_before_publish_fails(void) {
+    StatusSnapshot out;
+    out.publishedMs = 1234;
+    TEST_ASSERT_FALSE(store->read(out));
+    TEST_ASSERT_EQUAL_UINT32(1234, out.publishedMs);  // Untouched
+    TEST_ASSERT_EQUAL_UINT32(0, store->publishCount());
+}
+
+void test_read_returns_latest_publish(void) {
+    for (uint32_t tag = 1; tag <= 5; tag++) {
+        store->publish(makeSnapshot(tag));
+
+        StatusSnapshot out;
+        TEST_ASSERT_TRUE(store->read(out));
+        TEST_ASSERT_EQUAL_UINT32(tag, out.publishedMs);
+        TEST_ASSERT_EQUAL_UINT32(2 * tag, out.durationSeconds);
+        TEST_ASSERT_TRUE(out.clockOffsetUs == -static_cast<int64_t>(tag) * 1000000LL);
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, store->publishCount());
+    TEST_ASSERT_EQUAL_UINT32(0, store->readRetries());
+}
+
+void test_publish_leaves_previous_slot_intact(void) {
+    // A writer preempted mid-publish is writing the other slot: readers
+    // keep seeing the previous snapshot whole
+    store->publish(makeSnapshot(7));
+    store->publish(makeSnapshot(8));
+
+    StatusSnapshot out;
+    TEST_ASSERT_TRUE(store->read(out));
+    TEST_ASSERT_EQUAL_UINT32(8, out.publishedMs);
+    TEST_ASSERT_EQUAL(TherapyState::RUNNING, out.state);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.7f, out.battery.voltage);
+}
+
+// =============================================================================
+// PHONE STATUS
+// =============================================================================
+
+void test_phone_status_string(void) {
+    StatusSnapshot status;
+    TEST_ASSERT_EQUAL_STRING("IDLE", status.phoneStatusString());
+    status.state = TherapyState::RUNNING;
+    TEST_ASSERT_EQUAL_STRING("RUNNING", status.phoneStatusString());
+    status.state = TherapyState::PAUSED;
+    TEST_ASSERT_EQUAL_STRING("PAUSED", status.phoneStatusString());
+    status.state = TherapyState::READY;
+    TEST_ASSERT_EQUAL_STRING("READY", status.phoneStatusString());
+    status.state = TherapyState::CONNECTION_LOST;
+    TEST_ASSERT_EQUAL_STRING("IDLE", status.phoneStatusString());
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_read_before_publish_fails);
+    RUN_TEST(test_read_returns_latest_publish);
+    RUN_TEST(test_publish_leaves_previous_slot_intact);
+    RUN_TEST(test_phone_status_string);
+
+    return UNITY_END();
+}
@@ -4,6 +4,7 @@
  */
 
 #include <unity.h>
+#include <algorithm>
 #include "sync_protocol.h"
 
 // Include source file directly for native testing
@@ -501,6 +502,29 @@ void test_SimpleSyncProtocol_resetLatency(void) {
     TEST_ASSERT_EQUAL_UINT16(0, sync.getSampleCount());
 }
 
+void test_SimpleSyncProtocol_linkStats_round_trip(void) {
+    SimpleSyncProtocol sync;
+
+    // 2M link: 10ms one-way
+    sync.updateLatency(20000);
+    sync.updateLatency(20000);
+    sync.updateLatency(22000);
+    SimpleSyncProtocol::LinkStats fast = sync.getLinkStats();
+
+    // Switch to a fresh PHY: same as a latency + asymmetry reset
+    sync.restoreLinkStats(SimpleSyncProtocol::LinkStats());
+    TEST_ASSERT_EQUAL_UINT32(0, sync.getMeasuredLatency());
+    TEST_ASSERT_EQUAL_UINT16(0, sync.getSampleCount());
+    TEST_ASSERT_EQUAL_UINT16(0, sync.getAsymmetrySampleCount());
+    sync.updateLatency(60000);
+
+    // Back on 2M: warm-started, no new samples needed
+    sync.restoreLinkStats(fast);
+    TEST_ASSERT_EQUAL_UINT16(3, sync.getSampleCount());
+    TEST_ASSERT_EQUAL_UINT32(fast.smoothedLatencyUs, sync.getMeasuredLatency());
+    TEST_ASSERT_EQUAL_UINT32(fast.rttVarianceUs, sync.getRTTVariance());
+}
+
 // =============================================================================
 // CREATEBUZZ WITH DURATION TESTS
 // =============================================================================
@@ -697,13 +721,13 @@ void test_SimpleSyncProtocol_addOffsetSample_fills_buffer(void) {
 void test_SimpleSyncProtocol_addOffsetSample_circular_buffer(void) {
     SimpleSyncProtocol sync;
 
-    // Fill beyond buffer size (OFFSET_SAMPLE_COUNT = 10)
-    for (int i = 0; i < 15; i++) {
+    // Fill beyond buffer size (OFFSET_SAMPLE_COUNT = SYNC_OFFSET_WINDOW_SIZE)
+    for (int i = 0; i < SYNC_OFFSET_WINDOW_SIZE + 5; i++) {
         sync.addOffsetSample(i * 100);
     }
 
     // Should wrap around, count capped at OFFSET_SAMPLE_COUNT
-    TEST_ASSERT_EQUAL_UINT8(10, sync.getOffsetSampleCount());
+    TEST_ASSERT_EQUAL_UINT8(SYNC_OFFSET_WINDOW_SIZE, sync.getOffsetSampleCount());
     TEST_ASSERT_TRUE(sync.isClockSyncValid());
 }
 
@@ -736,6 +760,57 @@ void test_SimpleSyncProtocol_getMedianOffset_even_count(void) {
     TEST_ASSERT_EQUAL_INT64(350, sync.getMedianOffset());
 }
 
+// Reference: sort-from-scratch median + MAD filter over the last window
+static int64_t referenceFilteredMedian(const int64_t* window, uint8_t count) {
+    int64_t sorted[SYNC_OFFSET_WINDOW_SIZE];
+    for (uint8_t i = 0; i < count; i++) sorted[i] = window[i];
+    std::sort(sorted, sorted + count);
+    int64_t prelim = (count % 2 == 0) ? (sorted[count / 2 - 1] + sorted[count / 2]) / 2
+                                      : sorted[count / 2];
+
+    int64_t deviations[SYNC_OFFSET_WINDOW_SIZE];
+    for (uint8_t i = 0; i < count; i++) deviations[i] = llabs(window[i] - prelim);
+    std::sort(deviations, deviations + count);
+    int64_t mad = (count % 2 == 1) ? deviations[count / 2]
+                                   : (deviations[count / 2 - 1] + deviations[count / 2]) / 2;
+    int64_t threshold = mad * 3;
+    if (threshold < SYNC_OUTLIER_THRESHOLD_US) threshold = SYNC_OUTLIER_THRESHOLD_US;
+
+    int64_t filtered[SYNC_OFFSET_WINDOW_SIZE];
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (llabs(sorted[i] - prelim) <= threshold) filtered[n++] = sorted[i];
+    }
+    if (n < SYNC_MIN_VALID_SAMPLES) return prelim;
+    return (n % 2 == 0) ? (filtered[n / 2 - 1] + filtered[n / 2]) / 2 : filtered[n / 2];
+}
+
+void test_SimpleSyncProtocol_incremental_median_matches_full_sort(void) {
+    SimpleSyncProtocol sync;
+    int64_t window[SYNC_OFFSET_WINDOW_SIZE];
+    uint8_t count = 0;
+    uint8_t next = 0;
+    uint32_t lcg = 12345;
+
+    for (int i = 0; i < 200; i++) {
+        // Jitter around a drifting offset, duplicates, and BLE-retransmit outliers
+        lcg = lcg * 1103515245u + 12345u;
+        int64_t offset = 50000 + i * 10 + static_cast<int64_t>((lcg >> 16) % 2000) - 1000;
+        if ((lcg >> 8) % 7 == 0) offset += 40000;
+        if (i % 11 == 0) offset = window[(next + SYNC_OFFSET_WINDOW_SIZE - 1) % SYNC_OFFSET_WINDOW_SIZE];
+        if (i == 0) offset = 50000;
+
+        sync.addOffsetSample(offset);
+        window[next] = offset;
+        next = static_cast<uint8_t>((next + 1) % SYNC_OFFSET_WINDOW_SIZE);
+        if (count < SYNC_OFFSET_WINDOW_SIZE) count++;
+
+        if (count >= SYNC_MIN_VALID_SAMPLES) {
+            TEST_ASSERT_EQUAL_INT64(referenceFilteredMedian(window, count), sync.getMedianOffset());
+        }
+    }
+}
+
 void test_SimpleSyncProtocol_isClockSyncValid_below_threshold(void) {
     SimpleSyncProtocol sync;
 
@@ -1049,6 +1124,27 @@ void test_SimpleSyncProtocol_warmStart_aborts_on_divergent_sample(void) {
     // Should now require full 5 samples (cold start)
 }
 
+void test_SimpleSyncProtocol_seedDriftRate_shortens_cold_start(void) {
+    SimpleSyncProtocol sync;
+    sync.seedDriftRate(0.02f, 0.002f);
+    TEST_ASSERT_EQUAL_INT32(driftRateToQ16(0.02f), sync.getDriftRateQ16());
+
+    for (int i = 0; i < SYNC_SKEW_CAL_MIN_SAMPLES - 1; i++) {
+        sync.addOffsetSample(10000);
+    }
+    TEST_ASSERT_FALSE(sync.isClockSyncValid());
+    sync.addOffsetSample(10000);
+    TEST_ASSERT_TRUE(sync.isClockSyncValid());
+    TEST_ASSERT_EQUAL_INT32(driftRateToQ16(0.02f), sync.getDriftRateQ16());
+
+    // A reset forgets the seed: full cold start again
+    sync.resetClockSync();
+    for (int i = 0; i < SYNC_SKEW_CAL_MIN_SAMPLES; i++) {
+        sync.addOffsetSample(10000);
+    }
+    TEST_ASSERT_FALSE(sync.isClockSyncValid());
+}
+
 void test_SimpleSyncProtocol_getProjectedOffset_applies_drift(void) {
     SimpleSyncProtocol sync;
 
@@ -1229,6 +1325,52 @@ void test_SimpleSyncProtocol_calculateAdaptiveLeadTime_normal_calculation(void)
     TEST_ASSERT_TRUE(leadTime <= 150000);
 }
 
+void test_SimpleSyncProtocol_calculateAnchoredLeadTime_falls_back_when_few_samples(void) {
+    SimpleSyncProtocol sync;
+    TEST_ASSERT_EQUAL_UINT32(sync.calculateAdaptiveLeadTime(), sync.calculateAnchoredLeadTime(2000, 7500));
+}
+
+void test_SimpleSyncProtocol_calculateAnchoredLeadTime_connection_event_bound(void) {
+    SimpleSyncProtocol sync;
+    sync.updateLatency(20000);
+    sync.updateLatency(20000);
+    sync.updateLatency(20000);
+
+    // wait 5ms + 3 x 7.5ms + 15ms overhead = 42.5ms, well under the 70ms RTT floor
+    uint32_t expected = 5000 + SYNC_ANCHORED_LEAD_EVENTS * 7500 +
+                        SYNC_PROCESSING_OVERHEAD_US + SYNC_GENERATION_OVERHEAD_US;
+    TEST_ASSERT_EQUAL_UINT32(expected, sync.calculateAnchoredLeadTime(5000, 7500));
+    TEST_ASSERT_TRUE(sync.calculateAnchoredLeadTime(5000, 7500) < sync.calculateAdaptiveLeadTime());
+
+    // Wait never exceeds one interval (unknown phase)
+    TEST_ASSERT_EQUAL_UINT32(sync.calculateAnchoredLeadTime(7500, 7500),
+                             sync.calculateAnchoredLeadTime(50000, 7500));
+}
+
+void test_SimpleSyncProtocol_calculateAnchoredLeadTime_measured_latency_wins(void) {
+    SimpleSyncProtocol sync;
+    // 80ms one-way: a congested link must not be scheduled on the nominal bound
+    sync.updateLatency(160000);
+    sync.updateLatency(160000);
+    sync.updateLatency(160000);
+
+    uint32_t leadTime = sync.calculateAnchoredLeadTime(1000, 7500);
+    TEST_ASSERT_TRUE(leadTime >= 80000 + SYNC_PROCESSING_OVERHEAD_US + SYNC_GENERATION_OVERHEAD_US);
+    TEST_ASSERT_TRUE(leadTime <= SYNC_MAX_LEAD_TIME_US);
+}
+
+void test_SimpleSyncProtocol_calculateAnchoredLeadTime_clamps(void) {
+    SimpleSyncProtocol sync;
+    sync.updateLatency(2000);
+    sync.updateLatency(2000);
+    sync.updateLatency(2000);
+
+    // Tiny interval: floor
+    TEST_ASSERT_EQUAL_UINT32(SYNC_ANCHORED_MIN_LEAD_TIME_US, sync.calculateAnchoredLeadTime(0, 1250));
+    // Relaxed 60ms link: ceiling
+    TEST_ASSERT_EQUAL_UINT32(SYNC_MAX_LEAD_TIME_US, sync.calculateAnchoredLeadTime(60000, 60000));
+}
+
 void test_SimpleSyncProtocol_getAverageRTT(void) {
     SimpleSyncProtocol sync;
 
@@ -1733,7 +1875,7 @@ void test_SimpleSyncProtocol_rapid_sample_bombardment(void) {
     }
 
     // Should handle circular buffer correctly
-    TEST_ASSERT_EQUAL_UINT8(10, sync.getOffsetSampleCount());  // Capped at buffer size
+    TEST_ASSERT_EQUAL_UINT8(SYNC_OFFSET_WINDOW_SIZE, sync.getOffsetSampleCount());  // Capped at buffer size
     TEST_ASSERT_TRUE(sync.isClockSyncValid());
 
     // Median should be close to 10050 (middle of range)
@@ -1838,6 +1980,27 @@ void test_SimpleSyncProtocol_long_term_drift_accumulation(void) {
     TEST_ASSERT_TRUE(driftRate > 0.05f && driftRate < 0.10f);
 }
 
+void test_SimpleSyncProtocol_drift_rate_is_exact_q16(void) {
+    SimpleSyncProtocol sync;
+    for (int i = 0; i < 5; i++) {
+        sync.addOffsetSample(10000);
+    }
+    mockSetMillis(100);
+    sync.updateOffsetEMA(10000);
+
+    // 0.1 us/ms three times: integer EMA gives the same bits on every MCU
+    // 6553 -> 1965 -> 3341 -> 4304 (alpha = 19661/65536)
+    mockSetMillis(1100);
+    sync.updateOffsetEMA(10100);
+    TEST_ASSERT_EQUAL_INT32(1965, sync.getDriftRateQ16());
+    mockSetMillis(2100);
+    sync.updateOffsetEMA(10200);
+    mockSetMillis(3100);
+    sync.updateOffsetEMA(10300);
+    TEST_ASSERT_EQUAL_INT32(4304, sync.getDriftRateQ16());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0657f, sync.getDriftRate());
+}
+
 void test_SimpleSyncProtocol_drift_direction_reversal(void) {
     SimpleSyncProtocol sync;
 
@@ -2084,6 +2247,490 @@ void test_Macrocycle_baseTime_full_precision(void) {
     TEST_ASSERT_EQUAL_UINT64(mc.baseTime, mc2.baseTime);
 }
 
+// =============================================================================
+// MACROCYCLE V6 (BINARY) WIRE FORMAT TESTS
+// =============================================================================
+
+static void fillFullMacrocycle(Macrocycle& mc) {
+    mc.sequenceId = 42;
+    mc.baseTime = 5050000;
+    mc.clockOffset = -12345;
+    mc.durationMs = 100;
+    mc.eventCount = MACROCYCLE_MAX_EVENTS;
+    for (int i = 0; i < MACROCYCLE_MAX_EVENTS; i++) {
+        mc.events[i].deltaTimeMs = static_cast<uint16_t>(i * 167);
+        mc.events[i].finger = static_cast<uint8_t>(i % MAX_ACTUATORS);
+        mc.events[i].amplitude = static_cast<uint8_t>(50 + i);
+        mc.events[i].freqOffset = static_cast<uint8_t>(i % 3 == 0 ? 0 : 7);
+    }
+}
+
+void test_MacrocycleV6_roundtrip(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MACROCYCLE_WIRE_V6));
+    TEST_ASSERT_EQUAL(0, strncmp(buffer, "MC:", 3));
+    TEST_ASSERT_EQUAL_UINT8(MACROCYCLE_WIRE_V6, static_cast<uint8_t>(buffer[3]));
+
+    Macrocycle mc2;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer), mc2));
+    TEST_ASSERT_EQUAL_UINT32(42, mc2.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(5050000, mc2.baseTime);
+    TEST_ASSERT_EQUAL_INT64(-12345, mc2.clockOffset);
+    TEST_ASSERT_EQUAL_UINT16(100, mc2.durationMs);
+    TEST_ASSERT_EQUAL_UINT8(MACROCYCLE_MAX_EVENTS, mc2.eventCount);
+    for (int i = 0; i < MACROCYCLE_MAX_EVENTS; i++) {
+        TEST_ASSERT_EQUAL_UINT16(mc.events[i].deltaTimeMs, mc2.events[i].deltaTimeMs);
+        TEST_ASSERT_EQUAL_UINT8(mc.events[i].finger, mc2.events[i].finger);
+        TEST_ASSERT_EQUAL_UINT8(mc.events[i].amplitude, mc2.events[i].amplitude);
+        TEST_ASSERT_EQUAL_UINT8(mc.events[i].freqOffset, mc2.events[i].freqOffset);
+        TEST_ASSERT_EQUAL_UINT16(100, mc2.events[i].durationMs);
+    }
+}
+
+void test_MacrocycleV6_extreme_values_roundtrip(void) {
+    // Every byte value the escaper must handle appears in these fields
+    Macrocycle mc;
+    mc.sequenceId = 0x1B0D0480UL;
+    mc.baseTime = 0xFFFFFFFFFFFFFFFFULL;
+    mc.clockOffset = static_cast<int64_t>(0x8000000000000000ULL);
+    mc.durationMs = 0x8D9B;
+    mc.eventCount = 2;
+    mc.events[0].deltaTimeMs = 0x8084;
+    mc.events[0].finger = 0x9B;
+    mc.events[0].amplitude = 0x80;
+    mc.events[0].freqOffset = 0x8D;
+    mc.events[1].deltaTimeMs = 0;
+    mc.events[1].finger = 0;
+    mc.events[1].amplitude = 0xFF;
+    mc.events[1].freqOffset = 0x84;
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MACROCYCLE_WIRE_V6));
+
+    Macrocycle mc2;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer), mc2));
+    TEST_ASSERT_EQUAL_UINT32(mc.sequenceId, mc2.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(mc.baseTime, mc2.baseTime);
+    TEST_ASSERT_EQUAL_INT64(mc.clockOffset, mc2.clockOffset);
+    TEST_ASSERT_EQUAL_UINT16(mc.durationMs, mc2.durationMs);
+    TEST_ASSERT_EQUAL_UINT16(0x8084, mc2.events[0].deltaTimeMs);
+    TEST_ASSERT_EQUAL_UINT8(0x9B, mc2.events[0].finger);
+    TEST_ASSERT_EQUAL_UINT8(0x80, mc2.events[0].amplitude);
+    TEST_ASSERT_EQUAL_UINT8(0x8D, mc2.events[0].freqOffset);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, mc2.events[1].amplitude);
+    TEST_ASSERT_EQUAL_UINT8(0x84, mc2.events[1].freqOffset);
+}
+
+void test_MacrocycleV6_transport_safe_bytes(void) {
+    // The frame travels as an EOT-terminated C string with '\r' stripped
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+    mc.events[0].amplitude = 0x80;  // whitens to 0x00 -> must be escaped
+    mc.events[1].finger = 0x84;     // whitens to EOT
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    memset(buffer, 0x55, sizeof(buffer));
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MACROCYCLE_WIRE_V6));
+
+    size_t len = strlen(buffer);
+    TEST_ASSERT_TRUE(len >= SyncCommand::getMacrocycleSerializedSize(mc, MACROCYCLE_WIRE_V6));
+    for (size_t i = 0; i < len; i++) {
+        TEST_ASSERT_TRUE(buffer[i] != BLE_EOT_CHAR);
+        TEST_ASSERT_TRUE(buffer[i] != '\r');
+    }
+}
+
+void test_MacrocycleV6_typical_fits_one_chunk_at_4_motors(void) {
+    // 4-motor macrocycle (12 events) must fit one BLE_CHUNK_SIZE notification
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+    mc.eventCount = 12;
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MACROCYCLE_WIRE_V6));
+    TEST_ASSERT_EQUAL(87, SyncCommand::getMacrocycleSerializedSize(mc, MACROCYCLE_WIRE_V6));
+    TEST_ASSERT_TRUE(strlen(buffer) + 1 <= BLE_CHUNK_SIZE);  // +1 for EOT
+
+    char v5[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(v5, sizeof(v5), mc));
+    TEST_ASSERT_TRUE(strlen(buffer) < strlen(v5));
+}
+
+void test_MacrocycleV6_buffer_too_small_returns_false(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[40];
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MACROCYCLE_WIRE_V6));
+    TEST_ASSERT_EQUAL_UINT8(0, static_cast<uint8_t>(buffer[0]));
+}
+
+void test_MacrocycleV6_truncated_frame_rejected(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MACROCYCLE_WIRE_V6));
+
+    // Binary frames are length-exact: a lost tail is rejected, not salvaged
+    Macrocycle mc2;
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer) - 3, mc2));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycle(buffer, 10, mc2));
+}
+
+void test_MacrocycleV6_default_version_stays_text(void) {
+    // Callers that do not pass a version keep emitting V5 for older peers
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc));
+    TEST_ASSERT_EQUAL(0, strncmp(buffer, "MC:42|", 6));
+}
+
+// =============================================================================
+// MACROCYCLE V7 (TEMPLATE + DELTA) TESTS
+// =============================================================================
+
+// 3 patterns, each a different permutation of every finger, 167 ms apart
+static void fillPatternMacrocycle(Macrocycle& mc, uint32_t seq) {
+    mc.sequenceId = seq;
+    mc.baseTime = 9000000ULL + seq * 2000000ULL;
+    mc.clockOffset = -5000 + static_cast<int64_t>(seq);
+    mc.durationMs = 100;
+    mc.eventCount = 3 * MAX_ACTUATORS;
+    for (uint8_t p = 0; p < 3; p++) {
+        for (uint8_t k = 0; k < MAX_ACTUATORS; k++) {
+            uint8_t i = static_cast<uint8_t>(p * MAX_ACTUATORS + k);
+            MacrocycleEvent& evt = mc.events[i];
+            evt.deltaTimeMs = static_cast<uint16_t>(i * 167);
+            evt.finger = static_cast<uint8_t>((k + p + seq) % MAX_ACTUATORS);
+            if (p == 1) evt.finger = static_cast<uint8_t>(MAX_ACTUATORS - 1 - k);
+            evt.amplitude = 80;
+            evt.freqOffset = 10;
+            evt.durationMs = 100;
+        }
+    }
+}
+
+static MacrocycleReference referenceOf(const Macrocycle& mc) {
+    MacrocycleReference ref;
+    ref.sequenceId = mc.sequenceId;
+    ref.baseTime = mc.baseTime;
+    ref.clockOffset = mc.clockOffset;
+    return ref;
+}
+
+static void assertMacrocyclesEqual(const Macrocycle& a, const Macrocycle& b) {
+    TEST_ASSERT_EQUAL_UINT32(a.sequenceId, b.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(a.baseTime, b.baseTime);
+    TEST_ASSERT_EQUAL_INT64(a.clockOffset, b.clockOffset);
+    TEST_ASSERT_EQUAL_UINT16(a.durationMs, b.durationMs);
+    TEST_ASSERT_EQUAL_UINT8(a.eventCount, b.eventCount);
+    for (uint8_t i = 0; i < a.eventCount; i++) {
+        TEST_ASSERT_EQUAL_UINT16(a.events[i].deltaTimeMs, b.events[i].deltaTimeMs);
+        TEST_ASSERT_EQUAL_UINT8(a.events[i].finger, b.events[i].finger);
+        TEST_ASSERT_EQUAL_UINT8(a.events[i].amplitude, b.events[i].amplitude);
+        TEST_ASSERT_EQUAL_UINT8(a.events[i].freqOffset, b.events[i].freqOffset);
+        TEST_ASSERT_EQUAL_UINT16(a.events[i].durationMs, b.events[i].durationMs);
+    }
+}
+
+void test_MacrocycleV7_template_roundtrip(void) {
+    Macrocycle mc;
+    fillPatternMacrocycle(mc, 1);
+
+    MacrocycleTemplate tmpl;
+    TEST_ASSERT_TRUE(SyncCommand::buildMacrocycleTemplate(mc, 167, tmpl));
+    TEST_ASSERT_EQUAL_UINT8(3, tmpl.patternCount);
+    TEST_ASSERT_EQUAL_UINT8(MAX_ACTUATORS, tmpl.fingersPerPattern);
+    for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, tmpl.fingers[i]);
+    }
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleTemplate(buffer, sizeof(buffer), tmpl));
+    TEST_ASSERT_EQUAL_UINT8(SyncCommand::MACROCYCLE_FRAME_TEMPLATE,
+                            SyncCommand::getMacrocycleFrameKind(buffer, strlen(buffer)));
+
+    MacrocycleTemplate tmpl2;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleTemplate(buffer, strlen(buffer), tmpl2));
+    TEST_ASSERT_TRUE(tmpl.sameStructure(tmpl2));
+    TEST_ASSERT_EQUAL_UINT8(80, tmpl2.amplitude);
+    TEST_ASSERT_EQUAL_UINT8(10, tmpl2.freqOffset);
+
+    // Not a full macrocycle on its own
+    Macrocycle out;
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer), out));
+}
+
+void test_MacrocycleV7_template_rejects_repeated_finger_pattern(void) {
+    Macrocycle mc;
+    fillPatternMacrocycle(mc, 1);
+    mc.events[MAX_ACTUATORS + 1].finger = mc.events[MAX_ACTUATORS].finger;
+
+    MacrocycleTemplate tmpl;
+    TEST_ASSERT_FALSE(SyncCommand::buildMacrocycleTemplate(mc, 167, tmpl));
+}
+
+void test_MacrocycleV7_delta_roundtrip(void) {
+    Macrocycle first;
+    fillPatternMacrocycle(first, 41);
+    MacrocycleTemplate tmpl;
+    TEST_ASSERT_TRUE(SyncCommand::buildMacrocycleTemplate(first, 167, tmpl));
+
+    Macrocycle next;
+    fillPatternMacrocycle(next, 43);
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                           referenceOf(first)));
+    TEST_ASSERT_EQUAL_UINT8(SyncCommand::MACROCYCLE_FRAME_DELTA,
+                            SyncCommand::getMacrocycleFrameKind(buffer, strlen(buffer)));
+
+    uint32_t refSeq = 0;
+    TEST_ASSERT_TRUE(SyncCommand::getMacrocycleDeltaReference(buffer, strlen(buffer), refSeq));
+    TEST_ASSERT_EQUAL_UINT32(41, refSeq);
+
+    Macrocycle out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleDelta(buffer, strlen(buffer), tmpl,
+                                                             referenceOf(first), out));
+    assertMacrocyclesEqual(next, out);
+}
+
+void test_MacrocycleV7_delta_much_smaller_than_full(void) {
+    Macrocycle first;
+    fillPatternMacrocycle(first, 1);
+    MacrocycleTemplate tmpl;
+    TEST_ASSERT_TRUE(SyncCommand::buildMacrocycleTemplate(first, 167, tmpl));
+
+    Macrocycle next;
+    fillPatternMacrocycle(next, 2);
+    char delta[MESSAGE_BUFFER_SIZE];
+    char full[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleDelta(delta, sizeof(delta), next, tmpl,
+                                                           referenceOf(first)));
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(full, sizeof(full), next, MACROCYCLE_WIRE_V7));
+
+    // Full frames on a V7 link stay V6
+    TEST_ASSERT_EQUAL_UINT8(MACROCYCLE_WIRE_V6, static_cast<uint8_t>(full[3]));
+    // Prefix + 15-byte header + one rank per pattern (plus rare escapes)
+    TEST_ASSERT_TRUE(strlen(delta) <= 4 + 15 + 3 + 4);
+    TEST_ASSERT_TRUE(strlen(delta) * 3 < strlen(full));
+}
+
+void test_MacrocycleV7_delta_carries_jitter_and_per_event_values(void) {
+    Macrocycle first;
+    fillPatternMacrocycle(first, 7);
+    MacrocycleTemplate tmpl;
+    TEST_ASSERT_TRUE(SyncCommand::buildMacrocycleTemplate(first, 167, tmpl));
+
+    Macrocycle next;
+    fillPatternMacrocycle(next, 8);
+    for (uint8_t i = 1; i < next.eventCount; i++) {
+        int8_t jitter = static_cast<int8_t>((i % 2) ? 23 : -17);
+        next.events[i].deltaTimeMs = static_cast<uint16_t>(next.events[i - 1].deltaTimeMs + 167 + jitter);
+    }
+    next.events[2].amplitude = 55;
+    next.events[5].freqOffset = 0x80;  // whitens to 0x00, must survive escaping
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                           referenceOf(first)));
+    Macrocycle out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleDelta(buffer, strlen(buffer), tmpl,
+                                                             referenceOf(first), out));
+    assertMacrocyclesEqual(next, out);
+}
+
+void test_MacrocycleV7_delta_falls_back_when_not_expressible(void) {
+    Macrocycle first;
+    fillPatternMacrocycle(first, 10);
+    MacrocycleTemplate tmpl;
+    TEST_ASSERT_TRUE(SyncCommand::buildMacrocycleTemplate(first, 167, tmpl));
+    char buffer[MESSAGE_BUFFER_SIZE];
+
+    // Gap deviation outside int8
+    Macrocycle next;
+    fillPatternMacrocycle(next, 11);
+    next.events[3].deltaTimeMs = static_cast<uint16_t>(next.events[3].deltaTimeMs + 200);
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                            referenceOf(first)));
+
+    // Pattern that is not a permutation of the template fingers
+    fillPatternMacrocycle(next, 11);
+    next.events[1].finger = next.events[0].finger;
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                            referenceOf(first)));
+
+    // Different event count
+    fillPatternMacrocycle(next, 11);
+    next.eventCount--;
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                            referenceOf(first)));
+
+    // Reference too far back (or not older at all)
+    fillPatternMacrocycle(next, 10 + 256);
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                            referenceOf(first)));
+    fillPatternMacrocycle(next, 10);
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                            referenceOf(first)));
+}
+
+void test_MacrocycleV7_delta_rejects_wrong_reference_and_truncation(void) {
+    Macrocycle first;
+    fillPatternMacrocycle(first, 20);
+    MacrocycleTemplate tmpl;
+    TEST_ASSERT_TRUE(SyncCommand::buildMacrocycleTemplate(first, 167, tmpl));
+
+    Macrocycle next;
+    fillPatternMacrocycle(next, 21);
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleDelta(buffer, sizeof(buffer), next, tmpl,
+                                                           referenceOf(first)));
+
+    Macrocycle out;
+    MacrocycleReference wrong = referenceOf(first);
+    wrong.sequenceId = 19;
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleDelta(buffer, strlen(buffer), tmpl, wrong, out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleDelta(buffer, strlen(buffer) - 1, tmpl,
+                                                              referenceOf(first), out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer), out));
+}
+
+void test_MacrocycleV7_frame_kind(void) {
+    Macrocycle mc;
+    fillPatternMacrocycle(mc, 1);
+    char buffer[MESSAGE_BUFFER_SIZE];
+
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc));
+    TEST_ASSERT_EQUAL_UINT8(SyncCommand::MACROCYCLE_FRAME_FULL,
+                            SyncCommand::getMacrocycleFrameKind(buffer, strlen(buffer)));
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MACROCYCLE_WIRE_V6));
+    TEST_ASSERT_EQUAL_UINT8(SyncCommand::MACROCYCLE_FRAME_FULL,
+                            SyncCommand::getMacrocycleFrameKind(buffer, strlen(buffer)));
+    TEST_ASSERT_EQUAL_UINT8(SyncCommand::MACROCYCLE_FRAME_INVALID,
+                            SyncCommand::getMacrocycleFrameKind("PING:1", 6));
+}
+
+void test_MacrocycleV7_seeded_session_roundtrip(void) {
+    SeededSessionParams params;
+    params.seed = 0xDEADBEEFUL;
+    params.patternType = 2;
+    params.numFingers = 4;
+    params.mirrorPattern = true;
+    params.amplitudeMin = 55;
+    params.amplitudeMax = 100;
+    params.frequencyRandomization = false;
+    params.frequencyMinHz = 210;
+    params.frequencyMaxHz = 260;
+    params.timing = TherapyTiming(100000, 66700, 15401);
+    params.fingerMapCount = 4;
+    for (uint8_t i = 0; i < 4; i++) {
+        params.fingerMap[i] = static_cast<uint8_t>(3 - i);
+        params.baseFrequencyHz[params.fingerMap[i]] = static_cast<uint16_t>(230 + i);
+    }
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeSeededSession(buffer, sizeof(buffer), params));
+    TEST_ASSERT_EQUAL_UINT8(SyncCommand::MACROCYCLE_FRAME_SESSION,
+                            SyncCommand::getMacrocycleFrameKind(buffer, strlen(buffer)));
+
+    SeededSessionParams out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeSeededSession(buffer, strlen(buffer), out));
+    TEST_ASSERT_EQUAL_HEX32(params.seed, out.seed);
+    TEST_ASSERT_EQUAL_UINT8(2, out.patternType);
+    TEST_ASSERT_EQUAL_UINT8(4, out.numFingers);
+    TEST_ASSERT_TRUE(out.mirrorPattern);
+    TEST_ASSERT_EQUAL_UINT8(55, out.amplitudeMin);
+    TEST_ASSERT_EQUAL_UINT8(100, out.amplitudeMax);
+    TEST_ASSERT_FALSE(out.frequencyRandomization);
+    TEST_ASSERT_EQUAL_UINT16(210, out.frequencyMinHz);
+    TEST_ASSERT_EQUAL_UINT16(260, out.frequencyMaxHz);
+    TEST_ASSERT_EQUAL_UINT32(100000, out.timing.timeOnUs);
+    TEST_ASSERT_EQUAL_UINT32(66700, out.timing.timeOffUs);
+    TEST_ASSERT_EQUAL_UINT32(15401, out.timing.jitterQ16);
+    TEST_ASSERT_EQUAL_UINT8(4, out.fingerMapCount);
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT8(params.fingerMap[i], out.fingerMap[i]);
+        TEST_ASSERT_EQUAL_UINT16(params.baseFrequencyHz[i], out.baseFrequencyHz[i]);
+    }
+
+    // Not a macrocycle, and truncation is rejected
+    Macrocycle mc;
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer), mc));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeSeededSession(buffer, strlen(buffer) - 1, out));
+}
+
+void test_MacrocycleV7_tick_roundtrip(void) {
+    MacrocycleReference tick;
+    tick.sequenceId = 0xFFFFFFFEUL;
+    tick.baseTime = 0x0000012345678900ULL;
+    tick.clockOffset = -987654321LL;
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleTick(buffer, sizeof(buffer), 0xCAFEF00DUL, tick));
+    TEST_ASSERT_EQUAL_UINT8(SyncCommand::MACROCYCLE_FRAME_TICK,
+                            SyncCommand::getMacrocycleFrameKind(buffer, strlen(buffer)));
+    // A tick is a few dozen bytes regardless of event count
+    TEST_ASSERT_TRUE(strlen(buffer) <= 40);
+
+    uint32_t seed = 0;
+    MacrocycleReference out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleTick(buffer, strlen(buffer), seed, out));
+    TEST_ASSERT_EQUAL_HEX32(0xCAFEF00DUL, seed);
+    TEST_ASSERT_EQUAL_UINT32(tick.sequenceId, out.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(tick.baseTime, out.baseTime);
+    TEST_ASSERT_EQUAL_INT64(tick.clockOffset, out.clockOffset);
+
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleTick(buffer, strlen(buffer) - 1, seed, out));
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleTick(buffer, 8, 1, tick));
+}
+
+void test_MacrocycleReferenceHistory_lookup(void) {
+    MacrocycleReferenceHistory history;
+    MacrocycleReference ref;
+    TEST_ASSERT_FALSE(history.find(1, ref));
+
+    Macrocycle mc;
+    for (uint32_t seq = 1; seq <= 6; seq++) {
+        fillPatternMacrocycle(mc, seq);
+        history.record(mc);
+    }
+
+    // Only the newest SIZE entries are kept
+    TEST_ASSERT_FALSE(history.find(2, ref));
+    TEST_ASSERT_TRUE(history.find(3, ref));
+    TEST_ASSERT_EQUAL_UINT32(3, ref.sequenceId);
+    fillPatternMacrocycle(mc, 3);
+    TEST_ASSERT_EQUAL_UINT64(mc.baseTime, ref.baseTime);
+
+    TEST_ASSERT_TRUE(history.findNewestInRange(1, 4, ref));
+    TEST_ASSERT_EQUAL_UINT32(4, ref.sequenceId);
+    TEST_ASSERT_FALSE(history.findNewestInRange(7, 9, ref));
+
+    history.clear();
+    TEST_ASSERT_FALSE(history.find(6, ref));
+}
+
+void test_MacrocycleReferenceHistory_sequence_wrap(void) {
+    MacrocycleReferenceHistory history;
+    Macrocycle mc;
+    fillPatternMacrocycle(mc, 0xFFFFFFFFUL);
+    history.record(mc);
+    fillPatternMacrocycle(mc, 0);
+    history.record(mc);
+
+    MacrocycleReference ref;
+    TEST_ASSERT_TRUE(history.findNewestInRange(0xFFFFFFF0UL, 0, ref));
+    TEST_ASSERT_EQUAL_UINT32(0, ref.sequenceId);
+    TEST_ASSERT_TRUE(history.findNewestInRange(0xFFFFFFF0UL, 0xFFFFFFFFUL, ref));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFUL, ref.sequenceId);
+}
+
 // =============================================================================
 // CLOCK-SOURCE SWITCH REGRESSION TESTS
 // =============================================================================
@@ -2215,6 +2862,131 @@ void test_createPongWithAnchor_roundtrip(void) {
     TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)(anchor >> 32));
 }
 
+// =============================================================================
+// SYNC COMMAND VIEW (ZERO-COPY PARSE) TESTS
+// =============================================================================
+
+void test_SyncCommandView_parse_ping(void) {
+    const char* msg = "PING:42|1000000";
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(msg, strlen(msg)));
+    TEST_ASSERT_EQUAL(SyncCommandType::PING, view.getType());
+    TEST_ASSERT_EQUAL_UINT32(42, view.getSequenceId());
+    TEST_ASSERT_EQUAL_UINT64(1000000ULL, view.getTimestamp());
+    TEST_ASSERT_EQUAL_UINT8(0, view.getFieldCount());
+    TEST_ASSERT_FALSE(view.hasField(0));
+}
+
+void test_SyncCommandView_matches_deserialize_for_pong_anchor(void) {
+    // Values above 2^31 in every half exercise unsigned decoding
+    SyncCommand pong = SyncCommand::createPongWithAnchor(
+        0xFFFFFFF0UL, 0x180000001ULL, 0x2FFFFFFFFULL, 0x380000003ULL);
+    char buf[160];
+    TEST_ASSERT_TRUE(pong.serialize(buf, sizeof(buf)));
+
+    SyncCommand parsed;
+    TEST_ASSERT_TRUE(parsed.deserialize(buf));
+
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(buf, strlen(buf)));
+    TEST_ASSERT_EQUAL(SyncCommandType::PONG, view.getType());
+    TEST_ASSERT_EQUAL_UINT32(parsed.getSequenceId(), view.getSequenceId());
+    TEST_ASSERT_EQUAL_UINT64(parsed.getTimestamp(), view.getTimestamp());
+    TEST_ASSERT_EQUAL_UINT8(parsed.getDataCount(), view.getFieldCount());
+
+    char key[4];
+    for (uint8_t i = 0; i < view.getFieldCount(); i++) {
+        snprintf(key, sizeof(key), "%u", (unsigned)i);
+        TEST_ASSERT_EQUAL_UINT32(parsed.getDataUnsigned(key, 0), view.u32(i));
+    }
+    TEST_ASSERT_EQUAL_UINT64(0x180000001ULL, view.u64(0, 1));
+    TEST_ASSERT_EQUAL_UINT64(0x2FFFFFFFFULL, view.u64(2, 3));
+    TEST_ASSERT_EQUAL_UINT64(0x380000003ULL, view.u64(4, 5));
+}
+
+void test_SyncCommandView_respects_length(void) {
+    // Only the first 16 bytes are the message: trailing bytes must be ignored
+    const char msg[] = "PONG:7|100|11|22|99|88";
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(msg, 16));
+    TEST_ASSERT_EQUAL_UINT8(2, view.getFieldCount());
+    TEST_ASSERT_EQUAL_UINT32(11, view.u32(0));
+    TEST_ASSERT_EQUAL_UINT32(22, view.u32(1));
+    TEST_ASSERT_FALSE(view.hasField(2));
+
+    // Length cutting into the timestamp leaves no timestamp token
+    TEST_ASSERT_FALSE(view.parse(msg, 7));
+}
+
+void test_SyncCommandView_u32_defaults(void) {
+    const char* msg = "PONG:1|100|abc|4294967296|4294967295";
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(msg, strlen(msg)));
+    TEST_ASSERT_EQUAL_UINT32(77, view.u32(0, 77));           // Non-numeric
+    TEST_ASSERT_EQUAL_UINT32(77, view.u32(1, 77));           // > UINT32_MAX
+    TEST_ASSERT_EQUAL_UINT32(4294967295UL, view.u32(2, 77));
+    TEST_ASSERT_EQUAL_UINT32(77, view.u32(3, 77));           // Missing
+    TEST_ASSERT_EQUAL_UINT64(0xFFFFFFFFULL, view.u64(3, 2)); // Missing half is 0
+}
+
+void test_SyncCommandView_i32_signed_and_defaults(void) {
+    const char* msg = "PONG:1|100|-2147483648|2147483647|2147483648|-|-12x";
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(msg, strlen(msg)));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, view.i32(0, 77));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, view.i32(1, 77));
+    TEST_ASSERT_EQUAL_INT32(77, view.i32(2, 77));            // > INT32_MAX
+    TEST_ASSERT_EQUAL_INT32(77, view.i32(3, 77));            // Sign only
+    TEST_ASSERT_EQUAL_INT32(-12, view.i32(4, 77));           // Digits up to the junk
+    TEST_ASSERT_EQUAL_INT32(77, view.i32(5, 77));            // Missing
+}
+
+void test_macrocycle_ack_slack_round_trip(void) {
+    char buffer[64];
+    SyncCommandView view;
+
+    TEST_ASSERT_TRUE(SyncCommand::createMacrocycleAck(42, -1234).serialize(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(view.parse(buffer, strlen(buffer)));
+    TEST_ASSERT_EQUAL(SyncCommandType::MACROCYCLE_ACK, view.getType());
+    TEST_ASSERT_EQUAL_UINT32(42, view.getSequenceId());
+    TEST_ASSERT_TRUE(view.hasField(0));
+    TEST_ASSERT_EQUAL_INT32(-1234, view.i32(0));
+
+    // Old SECONDARYs send no slack field
+    TEST_ASSERT_TRUE(SyncCommand::createMacrocycleAck(43).serialize(buffer, sizeof(buffer)));
+    TEST_ASSERT_TRUE(view.parse(buffer, strlen(buffer)));
+    TEST_ASSERT_FALSE(view.hasField(0));
+}
+
+void test_SyncCommandView_malformed_variations(void) {
+    SyncCommandView view;
+    TEST_ASSERT_FALSE(view.parse(nullptr, 0));
+    TEST_ASSERT_FALSE(view.parse("PING", 4));                // Missing colon
+    TEST_ASSERT_FALSE(view.parse("PING:", 5));               // Missing data after colon
+    TEST_ASSERT_FALSE(view.parse(":1|1000", 7));             // Missing command
+    TEST_ASSERT_FALSE(view.parse("PINGX:1|1000", 12));       // Unknown command (prefix match)
+    TEST_ASSERT_FALSE(view.parse("PIN:1|1000", 10));         // Unknown command (truncated)
+    TEST_ASSERT_FALSE(view.parse("PING:abc|1000", 13));      // Non-numeric sequence
+    TEST_ASSERT_FALSE(view.parse("PING:1|", 7));             // Missing timestamp
+    TEST_ASSERT_FALSE(view.parse("PING:4294967296|1", 17));  // Sequence overflow
+}
+
+void test_SyncCommandView_skips_empty_fields_and_caps_count(void) {
+    // Empty tokens are skipped like strtok() in deserialize()
+    const char* msg = "DEBUG_FLASH:3||500|1|2|3|4|5|6|7|8|9|10";
+    SyncCommand parsed;
+    TEST_ASSERT_TRUE(parsed.deserialize(msg));
+
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(msg, strlen(msg)));
+    TEST_ASSERT_EQUAL(SyncCommandType::DEBUG_FLASH, view.getType());
+    TEST_ASSERT_EQUAL_UINT64(500ULL, view.getTimestamp());
+    TEST_ASSERT_EQUAL_UINT8(SYNC_MAX_DATA_PAIRS, view.getFieldCount());
+    TEST_ASSERT_EQUAL_UINT8(parsed.getDataCount(), view.getFieldCount());
+    TEST_ASSERT_EQUAL_UINT32(1, view.u32(0));
+    TEST_ASSERT_EQUAL_UINT32(SYNC_MAX_DATA_PAIRS, view.u32(SYNC_MAX_DATA_PAIRS - 1));
+}
+
 // =============================================================================
 // TEST RUNNER
 // =============================================================================
@@ -2291,6 +3063,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_SimpleSyncProtocol_updateLatency_ema_smoothing);
     RUN_TEST(test_SimpleSyncProtocol_updateLatency_outlier_rejection);
     RUN_TEST(test_SimpleSyncProtocol_resetLatency);
+    RUN_TEST(test_SimpleSyncProtocol_linkStats_round_trip);
 
     // Timing Utility Tests
     RUN_TEST(test_getMicros);
@@ -2327,6 +3100,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_SimpleSyncProtocol_addOffsetSample_circular_buffer);
     RUN_TEST(test_SimpleSyncProtocol_getMedianOffset_odd_count);
     RUN_TEST(test_SimpleSyncProtocol_getMedianOffset_even_count);
+    RUN_TEST(test_SimpleSyncProtocol_incremental_median_matches_full_sort);
     RUN_TEST(test_SimpleSyncProtocol_isClockSyncValid_below_threshold);
     RUN_TEST(test_SimpleSyncProtocol_isClockSyncValid_at_threshold);
     RUN_TEST(test_SimpleSyncProtocol_getOffsetSampleCount);
@@ -2352,6 +3126,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_SimpleSyncProtocol_tryWarmStart_with_expired_cache_fails);
     RUN_TEST(test_SimpleSyncProtocol_warmStart_validates_confirmatory_samples);
     RUN_TEST(test_SimpleSyncProtocol_warmStart_aborts_on_divergent_sample);
+    RUN_TEST(test_SimpleSyncProtocol_seedDriftRate_shortens_cold_start);
     RUN_TEST(test_SimpleSyncProtocol_getProjectedOffset_applies_drift);
     RUN_TEST(test_SimpleSyncProtocol_invalidateWarmStartCache_clears_cache);
 
@@ -2367,6 +3142,10 @@ int main(int argc, char **argv) {
     RUN_TEST(test_SimpleSyncProtocol_calculateAdaptiveLeadTime_minimum_clamp);
     RUN_TEST(test_SimpleSyncProtocol_calculateAdaptiveLeadTime_maximum_clamp);
     RUN_TEST(test_SimpleSyncProtocol_calculateAdaptiveLeadTime_normal_calculation);
+    RUN_TEST(test_SimpleSyncProtocol_calculateAnchoredLeadTime_falls_back_when_few_samples);
+    RUN_TEST(test_SimpleSyncProtocol_calculateAnchoredLeadTime_connection_event_bound);
+    RUN_TEST(test_SimpleSyncProtocol_calculateAnchoredLeadTime_measured_latency_wins);
+    RUN_TEST(test_SimpleSyncProtocol_calculateAnchoredLeadTime_clamps);
     RUN_TEST(test_SimpleSyncProtocol_getAverageRTT);
     RUN_TEST(test_SimpleSyncProtocol_getRTTVariance_initial_zero);
     RUN_TEST(test_SimpleSyncProtocol_getRTTVariance_after_consistent_samples);
@@ -2430,6 +3209,7 @@ int main(int argc, char **argv) {
 
     // Long-term drift tests
     RUN_TEST(test_SimpleSyncProtocol_long_term_drift_accumulation);
+    RUN_TEST(test_SimpleSyncProtocol_drift_rate_is_exact_q16);
     RUN_TEST(test_SimpleSyncProtocol_drift_direction_reversal);
     RUN_TEST(test_SimpleSyncProtocol_corrected_offset_bounds);
 
@@ -2447,6 +3227,27 @@ int main(int argc, char **argv) {
     RUN_TEST(test_Macrocycle_negative_large_clock_offset);
     RUN_TEST(test_Macrocycle_baseTime_full_precision);
 
+    // Macrocycle V6 binary wire format
+    RUN_TEST(test_MacrocycleV6_roundtrip);
+    RUN_TEST(test_MacrocycleV6_extreme_values_roundtrip);
+    RUN_TEST(test_MacrocycleV6_transport_safe_bytes);
+    RUN_TEST(test_MacrocycleV6_typical_fits_one_chunk_at_4_motors);
+    RUN_TEST(test_MacrocycleV6_buffer_too_small_returns_false);
+    RUN_TEST(test_MacrocycleV6_truncated_frame_rejected);
+    RUN_TEST(test_MacrocycleV6_default_version_stays_text);
+    RUN_TEST(test_MacrocycleV7_template_roundtrip);
+    RUN_TEST(test_MacrocycleV7_template_rejects_repeated_finger_pattern);
+    RUN_TEST(test_MacrocycleV7_delta_roundtrip);
+    RUN_TEST(test_MacrocycleV7_delta_much_smaller_than_full);
+    RUN_TEST(test_MacrocycleV7_delta_carries_jitter_and_per_event_values);
+    RUN_TEST(test_MacrocycleV7_delta_falls_back_when_not_expressible);
+    RUN_TEST(test_MacrocycleV7_delta_rejects_wrong_reference_and_truncation);
+    RUN_TEST(test_MacrocycleV7_frame_kind);
+    RUN_TEST(test_MacrocycleV7_seeded_session_roundtrip);
+    RUN_TEST(test_MacrocycleV7_tick_roundtrip);
+    RUN_TEST(test_MacrocycleReferenceHistory_lookup);
+    RUN_TEST(test_MacrocycleReferenceHistory_sequence_wrap);
+
     // Clock-source switch regression guard
     RUN_TEST(test_getMicros_no_false_overflow_after_reset);
 
@@ -2463,5 +3264,15 @@ int main(int argc, char **argv) {
     // Anchor-paired PONG factory: 6-field round-trip
     RUN_TEST(test_createPongWithAnchor_roundtrip);
 
+    // SyncCommandView (zero-copy parse) tests
+    RUN_TEST(test_SyncCommandView_parse_ping);
+    RUN_TEST(test_SyncCommandView_matches_deserialize_for_pong_anchor);
+    RUN_TEST(test_SyncCommandView_respects_length);
+    RUN_TEST(test_SyncCommandView_u32_defaults);
+    RUN_TEST(test_SyncCommandView_i32_signed_and_defaults);
+    RUN_TEST(test_macrocycle_ack_slack_round_trip);
+    RUN_TEST(test_SyncCommandView_malformed_variations);
+    RUN_TEST(test_SyncCommandView_skips_empty_fields_and_caps_count);
+
     return UNITY_END();
 }
@@ -138,8 +138,8 @@ void test_Pattern_default_constructor(void) {
     Pattern p;
 
     TEST_ASSERT_EQUAL_UINT8(MAX_ACTUATORS, p.numFingers);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, p.burstDurationMs);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 668.0f, p.interBurstIntervalMs);
+    TEST_ASSERT_EQUAL_UINT32(100000, p.burstDurationUs);
+    TEST_ASSERT_EQUAL_UINT32(668000, p.interBurstIntervalUs);
 
     // Default sequence is 0,1,2,3
     for (int i = 0; i < 4; i++) {
@@ -148,18 +148,17 @@ void test_Pattern_default_constructor(void) {
     }
 }
 
-void test_Pattern_getTotalDurationMs(void) {
+void test_Pattern_getTotalDurationUs(void) {
     Pattern p;
     p.numFingers = 4;
-    p.burstDurationMs = 100.0f;
+    p.burstDurationUs = 100000;
     for (int i = 0; i < 4; i++) {
-        p.timeOffMs[i] = 500.0f;  // 500ms between each
+        p.timeOffUs[i] = 500000;  // 500ms between each
     }
 
     // Total = sum of (timeOff + burst) for each finger + interBurstInterval
     // = 4 * (500 + 100) + 668 = 3068ms
-    float total = p.getTotalDurationMs();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 3068.0f, total);
+    TEST_ASSERT_EQUAL_UINT32(3068000, p.getTotalDurationUs());
 }
 
 void test_Pattern_getFingerPair(void) {
@@ -186,7 +185,7 @@ void test_Pattern_getFingerPair(void) {
 // =============================================================================
 
 void test_generateRandomPermutation_produces_valid_pattern(void) {
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
@@ -194,7 +193,7 @@ void test_generateRandomPermutation_produces_valid_pattern(void) {
 }
 
 void test_generateRandomPermutation_mirrored(void) {
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true);
 
     // Mirrored: primary and secondary should be identical
     TEST_ASSERT_TRUE(std::ranges::equal(p.primarySequence, p.secondarySequence));
@@ -203,7 +202,7 @@ void test_generateRandomPermutation_mirrored(void) {
 void test_generateRandomPermutation_non_mirrored(void) {
     randomSeed(999);  // Seed to ensure different sequences
 
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, false);
+    Pattern p = generateRandomPermutation(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), false);
 
     // Both should still be valid permutations
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
@@ -213,32 +212,32 @@ void test_generateRandomPermutation_non_mirrored(void) {
 }
 
 void test_generateRandomPermutation_with_jitter(void) {
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 23.5f, true);
+    Pattern p = generateRandomPermutation(4, TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), true);
 
-    // With jitter, timing values will vary but should be positive
+    // With jitter, timing values vary within +-19.6ms of TIME_OFF
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(19623, 67000, p.timeOffUs[i]);
     }
 }
 
 void test_generateRandomPermutation_partial_fingers(void) {
-    Pattern p = generateRandomPermutation(3, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(3, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true);
 
     TEST_ASSERT_EQUAL_UINT8(3, p.numFingers);
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
 }
 
 void test_generateRandomPermutation_burst_duration(void) {
-    Pattern p = generateRandomPermutation(4, 150.0f, 50.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(4, TherapyTiming::fromMs(150.0f, 50.0f, 0.0f), true);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 150.0f, p.burstDurationMs);
+    TEST_ASSERT_EQUAL_UINT32(150000, p.burstDurationUs);
 }
 
 void test_generateRandomPermutation_interBurstInterval(void) {
     // Inter-burst = 4 * (timeOn + timeOff) = 4 * (100 + 67) = 668
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 668.0f, p.interBurstIntervalMs);
+    TEST_ASSERT_EQUAL_UINT32(668000, p.interBurstIntervalUs);
 }
 
 // =============================================================================
@@ -246,7 +245,7 @@ void test_generateRandomPermutation_interBurstInterval(void) {
 // =============================================================================
 
 void test_generateSequentialPattern_forward(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, true, false);
+    Pattern p = generateSequentialPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true, false);
 
     // Sequential forward: 0, 1, 2, 3
     for (int i = 0; i < 4; i++) {
@@ -255,7 +254,7 @@ void test_generateSequentialPattern_forward(void) {
 }
 
 void test_generateSequentialPattern_reverse(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, true, true);
+    Pattern p = generateSequentialPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true, true);
 
     // Sequential reverse: 3, 2, 1, 0
     for (int i = 0; i < 4; i++) {
@@ -264,14 +263,14 @@ void test_generateSequentialPattern_reverse(void) {
 }
 
 void test_generateSequentialPattern_mirrored(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, true, false);
+    Pattern p = generateSequentialPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true, false);
 
     // Mirrored: primary and secondary identical
     TEST_ASSERT_TRUE(std::ranges::equal(p.primarySequence, p.secondarySequence));
 }
 
 void test_generateSequentialPattern_non_mirrored(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, false, false);
+    Pattern p = generateSequentialPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), false, false);
 
     // Non-mirrored: secondary is opposite order of primary
     // Primary: 0,1,2,3  Secondary: 3,2,1,0
@@ -286,7 +285,7 @@ void test_generateSequentialPattern_non_mirrored(void) {
 // =============================================================================
 
 void test_generateMirroredPattern_not_randomized(void) {
-    Pattern p = generateMirroredPattern(4, 100.0f, 67.0f, 0.0f, false);
+    Pattern p = generateMirroredPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), false);
 
     // Not randomized: sequential
     for (int i = 0; i < 4; i++) {
@@ -298,7 +297,7 @@ void test_generateMirroredPattern_not_randomized(void) {
 }
 
 void test_generateMirroredPattern_randomized(void) {
-    Pattern p = generateMirroredPattern(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateMirroredPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), true);
 
     // Randomized: valid permutation
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
@@ -327,7 +326,7 @@ void test_TherapyEngine_default_state(void) {
 void test_TherapyEngine_startSession(void) {
     TherapyEngine engine;
 
-    engine.startSession(7200, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, true);
+    engine.startSession(7200, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 4, true);
 
     TEST_ASSERT_TRUE(engine.isRunning());
     TEST_ASSERT_FALSE(engine.isPaused());
@@ -336,7 +335,7 @@ void test_TherapyEngine_startSession(void) {
 
 void test_TherapyEngine_pause(void) {
     TherapyEngine engine;
-    engine.startSession(7200, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, true);
+    engine.startSession(7200, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 4, true);
 
     engine.pause();
 
@@ -346,7 +345,7 @@ void test_TherapyEngine_pause(void) {
 
 void test_TherapyEngine_resume(void) {
     TherapyEngine engine;
-    engine.startSession(7200, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, true);
+    engine.startSession(7200, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 4, true);
     engine.pause();
 
     engine.resume();
@@ -357,7 +356,7 @@ void test_TherapyEngine_resume(void) {
 
 void test_TherapyEngine_stop(void) {
     TherapyEngine engine;
-    engine.startSession(7200, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, true);
+    engine.startSession(7200, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), 4, true);
 
     engine.stop();
 
@@ -366,11 +365,11 @@ void test_TherapyEngine_stop(void) {
 
 void test_TherapyEngine_resets_stats_on_start(void) {
     TherapyEngine engine;
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.stop();
 
     // Start new session
-    engine.startSession(200, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(200, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     TEST_ASSERT_EQUAL_UINT32(0, engine.getCyclesCompleted());
     TEST_ASSERT_EQUAL_UINT32(0, engine.getTotalActivations());
@@ -385,7 +384,7 @@ void test_TherapyEngine_getElapsedSeconds(void) {
     // Start with non-zero time (startTime == 0 is a guard condition in the code)
     mockSetMillis(1000);
 
-    engine.startSession(7200, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(7200, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Advance time by 5000ms (5 seconds)
     mockAdvanceMillis(5000);
@@ -398,7 +397,7 @@ void test_TherapyEngine_getRemainingSeconds(void) {
     // Start with non-zero time (startTime == 0 is a guard condition in the code)
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Advance time by 30 seconds
     mockAdvanceMillis(30000);
@@ -434,7 +433,7 @@ void test_TherapyEngine_update_does_nothing_when_paused(void) {
     TherapyEngine engine;
     engine.setActivateCallback(mockActivateCallback);
 
-    engine.startSession(7200, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(7200, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.pause();
 
     int countBefore = g_activateCallCount;
@@ -447,7 +446,7 @@ void test_TherapyEngine_session_timeout(void) {
     TherapyEngine engine;
     mockSetMillis(0);
 
-    engine.startSession(10, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);  // 10 second session
+    engine.startSession(10, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);  // 10 second session
 
     // Advance past session duration
     mockAdvanceMillis(11000);
@@ -463,7 +462,7 @@ void test_TherapyEngine_session_timeout(void) {
 void test_TherapyEngine_startSession_sequential_pattern(void) {
     TherapyEngine engine;
 
-    engine.startSession(7200, PatternType::SEQUENTIAL, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(7200, PatternType::SEQUENTIAL, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     TEST_ASSERT_TRUE(engine.isRunning());
 }
@@ -471,7 +470,7 @@ void test_TherapyEngine_startSession_sequential_pattern(void) {
 void test_TherapyEngine_startSession_mirrored_pattern(void) {
     TherapyEngine engine;
 
-    engine.startSession(7200, PatternType::MIRRORED, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(7200, PatternType::MIRRORED, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     TEST_ASSERT_TRUE(engine.isRunning());
 }
@@ -495,7 +494,7 @@ void test_TherapyEngine_setDeactivateCallback(void) {
 
     // Verify deactivate callback is called during pause
     engine.setActivateCallback(mockActivateCallback);
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Pause should deactivate motors if active
     engine.pause();
@@ -514,7 +513,7 @@ void test_TherapyEngine_setFrequencyRandomization(void) {
     engine.setFrequencyRandomization(true, 210, 260);
 
     // Start session to trigger frequency application
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     TEST_ASSERT_TRUE(engine.isRunning());
 }
@@ -525,7 +524,7 @@ void test_TherapyEngine_setFrequencyRandomization_disabled(void) {
     // Disable frequency randomization
     engine.setFrequencyRandomization(false, 210, 260);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     TEST_ASSERT_TRUE(engine.isRunning());
 }
@@ -538,7 +537,7 @@ void test_TherapyEngine_amplitude_range(void) {
     TherapyEngine engine;
 
     // Start session with amplitude range (50-100)
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true, 50, 100);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true, 50, 100);
 
     TEST_ASSERT_TRUE(engine.isRunning());
 }
@@ -547,7 +546,7 @@ void test_TherapyEngine_fixed_amplitude(void) {
     TherapyEngine engine;
 
     // Start session with fixed amplitude (min == max)
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true, 80, 80);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true, 80, 80);
 
     TEST_ASSERT_TRUE(engine.isRunning());
 }
@@ -558,31 +557,31 @@ void test_TherapyEngine_fixed_amplitude(void) {
 
 void test_generateRandomPermutation_high_jitter(void) {
     // Test with 50% jitter (extreme case)
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 50.0f, true);
+    Pattern p = generateRandomPermutation(4, TherapyTiming::fromMs(100.0f, 67.0f, 50.0f), true);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
-    // With high jitter, timing values should still be valid
+    // With high jitter, timing values should still be valid (+-41.75ms)
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(41750, 67000, p.timeOffUs[i]);
     }
 }
 
 void test_generateSequentialPattern_with_jitter(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 23.5f, true, false);
+    Pattern p = generateSequentialPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), true, false);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
     // Jitter should be applied to timing
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(19623, 67000, p.timeOffUs[i]);
     }
 }
 
 void test_generateMirroredPattern_with_jitter(void) {
-    Pattern p = generateMirroredPattern(4, 100.0f, 67.0f, 23.5f, true);
+    Pattern p = generateMirroredPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 23.5f), true);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(19623, 67000, p.timeOffUs[i]);
     }
 }
 
@@ -595,7 +594,7 @@ void test_TherapyEngine_default_pattern_type_fallback(void) {
 
     // Use a non-standard pattern type (default branch in switch)
     // Since we can't easily pass an invalid enum, test with valid types
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     TEST_ASSERT_TRUE(engine.isRunning());
 }
@@ -609,7 +608,7 @@ void test_TherapyEngine_stop_deactivates_motors(void) {
     engine.setDeactivateCallback(mockDeactivateCallback);
     engine.setActivateCallback(mockActivateCallback);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Stop should deactivate motors if active
     engine.stop();
@@ -625,7 +624,7 @@ void test_TherapyEngine_getRemainingSeconds_exceeded(void) {
     TherapyEngine engine;
     mockSetMillis(1000);
 
-    engine.startSession(10, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(10, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Advance past session duration
     mockAdvanceMillis(20000);
@@ -678,7 +677,7 @@ void test_TherapyEngine_setMacrocycleStartCallback(void) {
     engine.setMacrocycleStartCallback(mockMacrocycleStartCallback);
 
     g_macrocycleStartCallCount = 0;
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Macrocycle start callback is called during startSession
     TEST_ASSERT_EQUAL_INT(1, g_macrocycleStartCallCount);
@@ -690,7 +689,7 @@ void test_TherapyEngine_setSendMacrocycleCallback(void) {
 
     g_sendMacrocycleCallCount = 0;
     mockSetMillis(1000);
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // First update should trigger macrocycle generation and send
     engine.update();
@@ -706,7 +705,7 @@ void test_TherapyEngine_setSchedulingCallbacks(void) {
     g_schedulingComplete = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     // Should have scheduled 12 activations (3 patterns * 4 fingers)
@@ -721,7 +720,7 @@ void test_TherapyEngine_setGetLeadTimeCallback(void) {
     g_lastLeadTimeReturned = 0;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     // Lead time callback should have been called
@@ -735,7 +734,7 @@ void test_TherapyEngine_setSetFrequencyCallback(void) {
 
     g_setFrequencyCallCount = 0;
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Randomization covers every physical actuator (not just session
     // fingers): events look frequency up by physical finger index, which
@@ -762,7 +761,7 @@ void test_macrocycle_creates_12_events(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -785,7 +784,7 @@ void test_macrocycle_skips_inactive_finger(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, MAX_ACTUATORS, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), MAX_ACTUATORS, true);
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -813,7 +812,7 @@ void test_macrocycle_sequential_pattern(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::SEQUENTIAL, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::SEQUENTIAL, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -827,7 +826,7 @@ void test_macrocycle_mirrored_pattern(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::MIRRORED, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::MIRRORED, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -842,7 +841,7 @@ void test_macrocycle_with_frequency_randomization(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -861,7 +860,7 @@ void test_macrocycle_duration_matches(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 150.0f, 67.0f, 0.0f, 4, true);  // 150ms ON time
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(150.0f, 67.0f, 0.0f), 4, true);  // 150ms ON time
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -876,7 +875,7 @@ void test_macrocycle_amplitude_range(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true, 50, 100);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true, 50, 100);
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -894,7 +893,7 @@ void test_macrocycle_fixed_amplitude(void) {
     g_macrocycleReceived = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true, 80, 80);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true, 80, 80);
     engine.update();
 
     TEST_ASSERT_TRUE(g_macrocycleReceived);
@@ -913,7 +912,7 @@ void test_macrocycle_sequence_id_increments(void) {
     g_schedulingComplete = true;  // Fast completion
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // First macrocycle
     engine.update();
@@ -945,7 +944,7 @@ void test_executeMacrocycleStep_transitions_to_active(void) {
     g_schedulingComplete = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // First update should transition IDLE -> ACTIVE
     engine.update();
@@ -963,7 +962,7 @@ void test_executeMacrocycleStep_waits_for_completion(void) {
     g_cycleCompleteCallCount = 0;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // First update - IDLE -> ACTIVE
     engine.update();
@@ -985,7 +984,7 @@ void test_executeMacrocycleStep_transitions_to_waiting_relax(void) {
     g_cycleCompleteCallCount = 0;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // First update - IDLE -> ACTIVE
     engine.update();
@@ -1014,7 +1013,7 @@ void test_executeMacrocycleStep_full_cycle(void) {
     g_macrocycleStartCallCount = 0;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // First macrocycle start called during startSession
     TEST_ASSERT_EQUAL_INT(1, g_macrocycleStartCallCount);
@@ -1049,7 +1048,7 @@ void test_TherapyEngine_pause_with_motor_active(void) {
     g_schedulingComplete = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     // Pause during active state - should deactivate motors if any active
@@ -1067,7 +1066,7 @@ void test_TherapyEngine_stop_with_motor_active(void) {
     g_schedulingComplete = false;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.update();
 
     // Stop during active state
@@ -1084,7 +1083,7 @@ void test_TherapyEngine_update_stops_when_shouldStop_set(void) {
     TherapyEngine engine;
     mockSetMillis(1000);
 
-    engine.startSession(100, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(100, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
     engine.stop();  // Sets _shouldStop flag
 
     engine.update();  // Should recognize stop flag
@@ -1101,7 +1100,7 @@ void test_TherapyEngine_zero_duration_session_runs_forever(void) {
     mockSetMillis(1000);
 
     // Duration of 0 means run indefinitely
-    engine.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(0, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Advance a lot of time
     mockAdvanceMillis(1000000);
@@ -1116,12 +1115,472 @@ void test_TherapyEngine_getRemainingSeconds_with_zero_duration(void) {
     mockSetMillis(1000);
 
     // Duration of 0 means run indefinitely
-    engine.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.startSession(0, PatternType::RNDP, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), 4, true);
 
     // Should return 0 when duration is 0
     TEST_ASSERT_EQUAL(0, engine.getRemainingSeconds());
 }
 
+// =============================================================================
+// PIPELINED MACROCYCLE STREAMING TESTS
+// =============================================================================
+
+static Macrocycle g_pipelineSent[4];
+static uint8_t g_pipelineSentCount = 0;
+
+void mockPipelineSendCallback(const Macrocycle& mc) {
+    if (g_pipelineSentCount < 4) {
+        g_pipelineSent[g_pipelineSentCount] = mc;
+    }
+    g_pipelineSentCount++;
+}
+
+static void startPipelinedSession(TherapyEngine& engine, float timeOnMs, float timeOffMs) {
+    g_pipelineSentCount = 0;
+    engine.setSendMacrocycleCallback(mockPipelineSendCallback);
+    engine.setGetLeadTimeCallback(mockGetLeadTimeCallback);
+    engine.setMacrocyclePipelineDepth(2);
+    mockSetMillis(1000);
+    engine.startSession(0, PatternType::RNDP, TherapyTiming::fromMs(timeOnMs, timeOffMs, 0.0f), 4, true);
+}
+
+void test_pipeline_chains_next_base_to_previous_end(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 100.0f, 67.0f);
+
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(1, g_pipelineSentCount);
+    uint64_t base0 = g_pipelineSent[0].baseTime;
+    uint64_t relaxUs = 1336000ULL;  // 2 * 4 * (100 + 67) ms
+    uint64_t expectedBase1 = base0 + g_pipelineSent[0].getTotalDurationMs() * 1000ULL + relaxUs;
+
+    // Step until the next macrocycle goes out
+    for (int i = 0; i < 500 && g_pipelineSentCount < 2; i++) {
+        mockAdvanceMillis(10);
+        engine.update();
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, g_pipelineSentCount);
+
+    // Sent ahead of time (not after the relax window), chained exactly
+    TEST_ASSERT_EQUAL_UINT64(expectedBase1, g_pipelineSent[1].baseTime);
+    TEST_ASSERT_TRUE(getMicros() < expectedBase1);
+    TEST_ASSERT_TRUE(getMicros() + MACROCYCLE_PIPELINE_HORIZON_MS * 1000ULL >= expectedBase1);
+    TEST_ASSERT_EQUAL_UINT32(0, engine.getCyclesCompleted());
+    TEST_ASSERT_EQUAL_UINT8(2, engine.getMacrocyclesInFlight());
+}
+
+void test_pipeline_waits_for_ack_before_next_send(void) {
+    TherapyEngine engine;
+    // Short cycles: the chained base is within the horizon immediately
+    startPipelinedSession(engine, 20.0f, 10.0f);
+
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(1, g_pipelineSentCount);
+
+    // Unacked and not yet playing: hold the next macrocycle
+    mockAdvanceMillis(10);
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(1, g_pipelineSentCount);
+
+    engine.onMacrocycleAck(g_pipelineSent[0].sequenceId);
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(2, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT32(g_pipelineSent[0].sequenceId + 1, g_pipelineSent[1].sequenceId);
+}
+
+void test_pipeline_lost_ack_resumes_once_playing(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 20.0f, 10.0f);
+
+    engine.update();
+    uint64_t base0 = g_pipelineSent[0].baseTime;
+
+    // No ACK ever arrives: the next send waits only until base0
+    while (getMicros() < base0) {
+        engine.update();
+        TEST_ASSERT_EQUAL_UINT8(1, g_pipelineSentCount);
+        mockAdvanceMillis(5);
+    }
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(2, g_pipelineSentCount);
+}
+
+void test_pipeline_depth_caps_in_flight(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 20.0f, 10.0f);
+
+    engine.update();
+    engine.onMacrocycleAck(g_pipelineSent[0].sequenceId);
+    engine.update();
+    engine.onMacrocycleAck(g_pipelineSent[1].sequenceId);
+    engine.update();
+
+    TEST_ASSERT_EQUAL_UINT8(2, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT8(2, engine.getMacrocyclesInFlight());
+}
+
+void test_pipeline_retires_cycles_and_counts_ack_misses(void) {
+    TherapyEngine engine;
+    engine.setCycleCompleteCallback(mockCycleCompleteCallback);
+    startPipelinedSession(engine, 20.0f, 10.0f);
+
+    engine.update();
+    uint64_t end0 = g_pipelineSent[0].baseTime + g_pipelineSent[0].getTotalDurationMs() * 1000ULL;
+    uint64_t relaxUs = 240000ULL;  // 2 * 4 * (20 + 10) ms
+
+    while (getMicros() < end0 + relaxUs) {
+        mockAdvanceMillis(5);
+        engine.update();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, engine.getCyclesCompleted());
+    TEST_ASSERT_EQUAL_INT(1, g_cycleCompleteCallCount);
+    TEST_ASSERT_EQUAL_UINT32(1, engine.getMacrocycleAckMisses());
+}
+
+void test_pipeline_pause_drops_in_flight(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 100.0f, 67.0f);
+
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(1, engine.getMacrocyclesInFlight());
+
+    engine.pause();
+    TEST_ASSERT_EQUAL_UINT8(0, engine.getMacrocyclesInFlight());
+
+    // Resume rebases to now + lead time
+    engine.resume();
+    mockAdvanceMillis(10);
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(2, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT64(getMicros() + 50000ULL, g_pipelineSent[1].baseTime);
+}
+
+void test_pipeline_depth_is_clamped(void) {
+    TherapyEngine engine;
+    TEST_ASSERT_FALSE(engine.isMacrocyclePipelined());
+
+    engine.setMacrocyclePipelineDepth(0);
+    TEST_ASSERT_FALSE(engine.isMacrocyclePipelined());
+
+    engine.setMacrocyclePipelineDepth(200);
+    TEST_ASSERT_TRUE(engine.isMacrocyclePipelined());
+}
+
+// =============================================================================
+// FIXED-SIZE GENERATOR TESTS
+// =============================================================================
+
+// Generated at compile time: the fixed-size generators are constexpr
+static constexpr FixedPattern<4> kConstexprPattern = [] {
+    PatternRng rng(1u, 2u);
+    return generateRandomPermutation<4>(PatternTiming::from(TherapyTiming::fromMs(100.0f, 67.0f, 23.5f)), false, &rng);
+}();
+static_assert(PatternPermutations<5>::COUNT == 120, "5! permutations");
+static_assert(PatternPermutations<4>::rows[23][0] == 3, "last row is the reverse");
+
+void test_PatternPermutations_are_unique_and_ordered(void) {
+    using Table = PatternPermutations<4>;
+    TEST_ASSERT_EQUAL_UINT8(24, Table::COUNT);
+    for (uint8_t row = 0; row < Table::COUNT; row++) {
+        std::array<uint8_t, 4> perm = Table::rows[row];
+        TEST_ASSERT_TRUE(isValidPermutation(perm));
+        if (row > 0) {
+            TEST_ASSERT_TRUE(Table::rows[row - 1] < Table::rows[row]);
+        }
+    }
+    uint8_t identity[] = {0, 1, 2, 3};
+    uint8_t reversed[] = {3, 2, 1, 0};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(identity, Table::rows[0].data(), 4);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(reversed, Table::rows[23].data(), 4);
+}
+
+void test_PatternTiming_from_therapy_timing(void) {
+    PatternTiming timing = PatternTiming::from(TherapyTiming::fromMs(100.0f, 67.0f, 23.5f));
+    TEST_ASSERT_EQUAL_UINT32(100000, timing.timeOnUs);
+    TEST_ASSERT_EQUAL_UINT32(67000, timing.timeOffUs);
+    TEST_ASSERT_EQUAL_UINT32(19623, timing.jitterAmountUs);  // 167 * 0.235 / 2 ms
+
+    timing = PatternTiming::from(TherapyTiming::fromMs(100.0f, 67.0f, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, timing.jitterAmountUs);
+
+    // Full jitter: half the cycle
+    timing = PatternTiming::from(TherapyTiming(100000, 67000, TherapyTiming::Q16_ONE));
+    TEST_ASSERT_EQUAL_UINT32(83500, timing.jitterAmountUs);
+}
+
+void test_TherapyTiming_fromMs_rounds(void) {
+    TherapyTiming timing = TherapyTiming::fromMs(100.0f, 66.7f, 23.5f);
+    TEST_ASSERT_EQUAL_UINT32(100000, timing.timeOnUs);
+    TEST_ASSERT_EQUAL_UINT32(66700, timing.timeOffUs);
+    TEST_ASSERT_EQUAL_UINT32(15401, timing.jitterQ16);  // 0.235 * 65536 = 15400.96
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 23.5f, timing.jitterPercent());
+
+    timing = TherapyTiming::fromMs(-5.0f, 0.0f, -1.0f);
+    TEST_ASSERT_EQUAL_UINT32(0, timing.timeOnUs);
+    TEST_ASSERT_EQUAL_UINT32(0, timing.jitterQ16);
+}
+
+void test_fixed_generator_constexpr_result(void) {
+    std::array<uint8_t, 4> primary = kConstexprPattern.primarySequence;
+    std::array<uint8_t, 4> secondary = kConstexprPattern.secondarySequence;
+    TEST_ASSERT_TRUE(isValidPermutation(primary));
+    TEST_ASSERT_TRUE(isValidPermutation(secondary));
+
+    // Same stream at runtime gives the same pattern
+    PatternRng rng(1u, 2u);
+    FixedPattern<4> runtime = generateRandomPermutation<4>(PatternTiming::from(TherapyTiming::fromMs(100.0f, 67.0f, 23.5f)),
+                                                           false, &rng);
+    TEST_ASSERT_TRUE(runtime.primarySequence == kConstexprPattern.primarySequence);
+    TEST_ASSERT_TRUE(runtime.timeOffUs == kConstexprPattern.timeOffUs);
+}
+
+void test_fixed_generator_jitter_bounds(void) {
+    PatternTiming timing = PatternTiming::from(TherapyTiming::fromMs(100.0f, 67.0f, 23.5f));
+    PatternRng rng(9u, 9u);
+    for (int i = 0; i < 200; i++) {
+        FixedPattern<5> pattern = generateMirroredPattern<5>(timing, true, &rng);
+        TEST_ASSERT_TRUE(pattern.primarySequence == pattern.secondarySequence);
+        for (uint8_t f = 0; f < 5; f++) {
+            TEST_ASSERT_TRUE(pattern.timeOffUs[f] >= timing.timeOffUs - timing.jitterAmountUs);
+            TEST_ASSERT_TRUE(pattern.timeOffUs[f] <= timing.timeOffUs + timing.jitterAmountUs);
+        }
+    }
+}
+
+void test_fixed_sequential_matches_runtime_generator(void) {
+    PatternTiming timing = PatternTiming::from(TherapyTiming::fromMs(100.0f, 67.0f, 0.0f));
+    for (int mirror = 0; mirror < 2; mirror++) {
+        for (int reverse = 0; reverse < 2; reverse++) {
+            Pattern expected = generateSequentialPattern(4, TherapyTiming::fromMs(100.0f, 67.0f, 0.0f), mirror, reverse);
+            FixedPattern<4> fixed = generateSequentialPattern<4>(timing, mirror, reverse);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.primarySequence.data(), fixed.primarySequence.data(), 4);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.secondarySequence.data(), fixed.secondarySequence.data(), 4);
+            TEST_ASSERT_EQUAL_UINT32(67000, fixed.timeOffUs[3]);
+        }
+    }
+}
+
+void test_macrocycle_timing_does_not_drift_with_fractional_off_time(void) {
+    SeededSessionParams params;
+    params.seed = 1;
+    params.patternType = static_cast<uint8_t>(PatternType::SEQUENTIAL);
+    params.numFingers = 4;
+    params.amplitudeMin = params.amplitudeMax = 100;
+    params.timing = TherapyTiming::fromMs(100.0f, 66.7f, 0.0f);
+    params.fingerMapCount = 4;
+    for (uint8_t i = 0; i < 4; i++) {
+        params.fingerMap[i] = i;
+    }
+
+    Macrocycle mc;
+    TEST_ASSERT_TRUE(generateSeededMacrocycle(params, 0, mc));
+    TEST_ASSERT_EQUAL_UINT8(12, mc.eventCount);
+    // 11 steps of 166.7 ms: truncating each step would give 1826
+    TEST_ASSERT_EQUAL_UINT16(1833, mc.events[11].deltaTimeMs);
+}
+
+// =============================================================================
+// SEEDED MACROCYCLE TESTS
+// =============================================================================
+
+void test_PatternRng_matches_pcg32_reference(void) {
+    // pcg32-demo: pcg32_srandom_r(42, 54)
+    PatternRng rng(42u, 54u);
+    TEST_ASSERT_EQUAL_HEX32(0xa15c02b7, rng.next());
+    TEST_ASSERT_EQUAL_HEX32(0x7b47f409, rng.next());
+    TEST_ASSERT_EQUAL_HEX32(0xba1d3330, rng.next());
+}
+
+void test_PatternRng_range_bounds(void) {
+    PatternRng rng(7u, 3u);
+    for (int i = 0; i < 1000; i++) {
+        uint32_t v = rng.range(10, 13);
+        TEST_ASSERT_TRUE(v >= 10 && v < 13);
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, rng.range(5, 5));
+}
+
+static void makeSeededParams(SeededSessionParams& params) {
+    params.seed = 0x1234ABCDu;
+    params.patternType = static_cast<uint8_t>(PatternType::RNDP);
+    params.numFingers = 4;
+    params.mirrorPattern = false;
+    params.amplitudeMin = 60;
+    params.amplitudeMax = 100;
+    params.frequencyRandomization = true;
+    params.frequencyMinHz = 210;
+    params.frequencyMaxHz = 260;
+    params.timing = TherapyTiming::fromMs(100.0f, 67.0f, 23.5f);
+    params.fingerMapCount = 4;
+    for (uint8_t i = 0; i < 4; i++) {
+        params.fingerMap[i] = i;
+    }
+}
+
+static bool macrocyclesEqual(const Macrocycle& a, const Macrocycle& b) {
+    if (a.eventCount != b.eventCount) {
+        return false;
+    }
+    for (uint8_t i = 0; i < a.eventCount; i++) {
+        const MacrocycleEvent& x = a.events[i];
+        const MacrocycleEvent& y = b.events[i];
+        if (x.deltaTimeMs != y.deltaTimeMs || x.finger != y.finger || x.amplitude != y.amplitude ||
+            x.durationMs != y.durationMs || x.getFrequencyHz() != y.getFrequencyHz()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_seeded_macrocycle_is_reproducible(void) {
+    SeededSessionParams params;
+    makeSeededParams(params);
+
+    Macrocycle a, b, c;
+    TEST_ASSERT_TRUE(generateSeededMacrocycle(params, 5, a));
+    randomSeed(999);  // Global RNG state must not matter
+    TEST_ASSERT_TRUE(generateSeededMacrocycle(params, 5, b));
+    TEST_ASSERT_TRUE(generateSeededMacrocycle(params, 6, c));
+
+    TEST_ASSERT_EQUAL_UINT8(12, a.eventCount);
+    TEST_ASSERT_EQUAL_UINT32(5, a.sequenceId);
+    TEST_ASSERT_TRUE(macrocyclesEqual(a, b));
+    TEST_ASSERT_FALSE(macrocyclesEqual(a, c));
+}
+
+void test_seeded_macrocycle_rejects_invalid_params(void) {
+    SeededSessionParams params;
+    makeSeededParams(params);
+    Macrocycle mc;
+
+    params.numFingers = 0;
+    TEST_ASSERT_FALSE(generateSeededMacrocycle(params, 1, mc));
+
+    makeSeededParams(params);
+    params.patternType = 9;
+    TEST_ASSERT_FALSE(generateSeededMacrocycle(params, 1, mc));
+
+    makeSeededParams(params);
+    params.fingerMapCount = 3;  // Fewer entries than fingers
+    TEST_ASSERT_FALSE(generateSeededMacrocycle(params, 1, mc));
+}
+
+void test_seeded_engine_macrocycle_matches_regenerated(void) {
+    TherapyEngine engine;
+    engine.setSeededGeneration(true);
+    engine.setFrequencyRandomization(true, 210, 260);
+    startPipelinedSession(engine, 100.0f, 67.0f);
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(1, g_pipelineSentCount);
+
+    // What SECONDARY would rebuild from the session frame and a tick
+    SeededSessionParams params;
+    engine.getSeededSessionParams(params);
+    Macrocycle regenerated;
+    TEST_ASSERT_TRUE(generateSeededMacrocycle(params, g_pipelineSent[0].sequenceId, regenerated));
+    TEST_ASSERT_TRUE(macrocyclesEqual(g_pipelineSent[0], regenerated));
+}
+
+// Drops finger 2 after the first macrocycle; the next one must cover only
+// the remaining fingers, each pattern a permutation of them
+static void checkMotorDroppedMidSession(bool seeded) {
+    TherapyEngine engine;
+    engine.setSeededGeneration(seeded);
+    startPipelinedSession(engine, 20.0f, 10.0f);
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(1, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT8(12, g_pipelineSent[0].eventCount);
+
+    const uint8_t usable[] = {0, 1, 3};
+    engine.setActiveFingers(usable, 3);
+    for (int i = 0; i < 500 && g_pipelineSentCount < 2; i++) {
+        mockAdvanceMillis(10);
+        engine.update();
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, g_pipelineSentCount);
+
+    const Macrocycle& mc = g_pipelineSent[1];
+    TEST_ASSERT_EQUAL_UINT8(9, mc.eventCount);
+    for (uint8_t p = 0; p < 3; p++) {
+        uint8_t seen = 0;
+        for (uint8_t i = 0; i < 3; i++) {
+            seen |= static_cast<uint8_t>(1u << mc.events[p * 3 + i].primaryFinger);
+        }
+        TEST_ASSERT_EQUAL_HEX8(0x0B, seen);  // {0, 1, 3}, each once
+    }
+
+    if (seeded) {
+        // The session frame SECONDARY would get describes the same cycle
+        SeededSessionParams params;
+        engine.getSeededSessionParams(params);
+        TEST_ASSERT_EQUAL_UINT8(3, params.numFingers);
+        Macrocycle regenerated;
+        TEST_ASSERT_TRUE(generateSeededMacrocycle(params, mc.sequenceId, regenerated));
+        TEST_ASSERT_TRUE(macrocyclesEqual(mc, regenerated));
+    }
+}
+
+void test_motor_dropped_mid_session_keeps_permutations(void) {
+    checkMotorDroppedMidSession(false);
+}
+
+void test_seeded_motor_dropped_mid_session_keeps_permutations(void) {
+    checkMotorDroppedMidSession(true);
+}
+
+void test_schedule_plan_precomputes_session(void) {
+    SeededSessionParams params;
+    makeSeededParams(params);
+    params.numFingers = 2;
+    params.fingerMapCount = 2;
+    params.fingerMap[0] = 0;
+    params.fingerMap[1] = 3;
+
+    SchedulePlan plan;
+    TEST_ASSERT_TRUE(compileSchedulePlan(params, plan));
+    TEST_ASSERT_EQUAL_UINT16(10, plan.frequencySteps);  // (260 - 210) / 5
+    TEST_ASSERT_EQUAL_UINT16(100, plan.durationMs);
+    TEST_ASSERT_EQUAL_UINT32(macrocycleDoubleRelaxUs(TherapyTiming::fromMs(100.0f, 67.0f, 0.0f)), plan.doubleRelaxUs);
+    TEST_ASSERT_EQUAL_UINT8(3, plan.fingerMap[1]);
+    TEST_ASSERT_EQUAL_UINT8(2, plan.fingerMap[2]);  // Past the map: itself
+
+    params.fingerMap[1] = MAX_ACTUATORS;
+    TEST_ASSERT_FALSE(compileSchedulePlan(params, plan));
+}
+
+void test_schedule_plan_keeps_long_time_on(void) {
+    // TIME_ON past 255 ms must reach the events whole (no 8-bit narrowing)
+    SeededSessionParams params;
+    makeSeededParams(params);
+    params.timing = TherapyTiming::fromMs(300.0f, 100.0f, 0.0f);
+
+    SchedulePlan plan;
+    TEST_ASSERT_TRUE(compileSchedulePlan(params, plan));
+    TEST_ASSERT_EQUAL_UINT16(300, plan.durationMs);
+    TEST_ASSERT_EQUAL_UINT32(3200000, plan.doubleRelaxUs);
+
+    Macrocycle mc;
+    generateSeededMacrocycle(plan, 0, mc);
+    TEST_ASSERT_EQUAL_UINT16(300, mc.durationMs);
+    TEST_ASSERT_EQUAL_UINT16(300, mc.events[0].durationMs);
+    TEST_ASSERT_EQUAL_UINT16(400, mc.events[1].deltaTimeMs);
+}
+
+void test_schedule_plan_matches_params_generation(void) {
+    SeededSessionParams params;
+    makeSeededParams(params);
+    SchedulePlan plan;
+    TEST_ASSERT_TRUE(compileSchedulePlan(params, plan));
+
+    for (uint32_t seq = 0; seq < 8; seq++) {
+        Macrocycle fromParams, fromPlan;
+        TEST_ASSERT_TRUE(generateSeededMacrocycle(params, seq, fromParams));
+        generateSeededMacrocycle(plan, seq, fromPlan);
+        TEST_ASSERT_TRUE(macrocyclesEqual(fromParams, fromPlan));
+    }
+}
+
 // =============================================================================
 // MACROCYCLE EVENT TESTS
 // =============================================================================
@@ -1158,7 +1617,7 @@ int main(int argc, char **argv) {
 
     // Pattern Struct Tests
     RUN_TEST(test_Pattern_default_constructor);
-    RUN_TEST(test_Pattern_getTotalDurationMs);
+    RUN_TEST(test_Pattern_getTotalDurationUs);
     RUN_TEST(test_Pattern_getFingerPair);
 
     // Generate Random Permutation Tests
@@ -1267,6 +1726,35 @@ int main(int argc, char **argv) {
     RUN_TEST(test_TherapyEngine_getRemainingSeconds_with_zero_duration);
 
     // Macrocycle Event Tests
+    RUN_TEST(test_pipeline_chains_next_base_to_previous_end);
+    RUN_TEST(test_pipeline_waits_for_ack_before_next_send);
+    RUN_TEST(test_pipeline_lost_ack_resumes_once_playing);
+    RUN_TEST(test_pipeline_depth_caps_in_flight);
+    RUN_TEST(test_pipeline_retires_cycles_and_counts_ack_misses);
+    RUN_TEST(test_pipeline_pause_drops_in_flight);
+    RUN_TEST(test_pipeline_depth_is_clamped);
+
+    // Fixed-size generator tests
+    RUN_TEST(test_PatternPermutations_are_unique_and_ordered);
+    RUN_TEST(test_PatternTiming_from_therapy_timing);
+    RUN_TEST(test_TherapyTiming_fromMs_rounds);
+    RUN_TEST(test_fixed_generator_constexpr_result);
+    RUN_TEST(test_fixed_generator_jitter_bounds);
+    RUN_TEST(test_fixed_sequential_matches_runtime_generator);
+    RUN_TEST(test_macrocycle_timing_does_not_drift_with_fractional_off_time);
+
+    // Seeded macrocycle tests
+    RUN_TEST(test_PatternRng_matches_pcg32_reference);
+    RUN_TEST(test_PatternRng_range_bounds);
+    RUN_TEST(test_seeded_macrocycle_is_reproducible);
+    RUN_TEST(test_seeded_macrocycle_rejects_invalid_params);
+    RUN_TEST(test_seeded_engine_macrocycle_matches_regenerated);
+    RUN_TEST(test_motor_dropped_mid_session_keeps_permutations);
+    RUN_TEST(test_seeded_motor_dropped_mid_session_keeps_permutations);
+    RUN_TEST(test_schedule_plan_precomputes_session);
+    RUN_TEST(test_schedule_plan_keeps_long_time_on);
+    RUN_TEST(test_schedule_plan_matches_params_generation);
+
     RUN_TEST(test_MacrocycleEvent_getFrequencyHz);
     RUN_TEST(test_MacrocycleEvent_constructor);
 
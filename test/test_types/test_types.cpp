@@ -575,6 +575,33 @@ void test_default_numfingers_matches_board(void) {
     TEST_ASSERT_EQUAL_UINT(MAX_ACTUATORS, cfg.numFingers);
 }
 
+// =============================================================================
+// SEEDED SESSION PARAMS TESTS
+// =============================================================================
+
+void test_SeededSessionParams_sameSession_sees_plan_changes(void) {
+    SeededSessionParams a;
+    a.seed = 1234;
+    a.numFingers = 4;
+    a.fingerMapCount = 4;
+    for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+        a.fingerMap[i] = i;
+    }
+    SeededSessionParams b = a;
+    TEST_ASSERT_TRUE(a.sameSession(b));
+
+    // Motor failover: same seed, smaller map
+    b.numFingers = 3;
+    b.fingerMapCount = 3;
+    b.fingerMap[2] = 3;
+    b.fingerMap[3] = 0;
+    TEST_ASSERT_FALSE(a.sameSession(b));
+
+    b = a;
+    b.frequencyRandomization = true;
+    TEST_ASSERT_FALSE(a.sameSession(b));
+}
+
 // =============================================================================
 // TEST RUNNER
 // =============================================================================
@@ -707,5 +734,8 @@ int main(int argc, char **argv) {
     RUN_TEST(test_macrocycle_capacity_matches_actuators);
     RUN_TEST(test_default_numfingers_matches_board);
 
+    // Seeded Session Params Tests
+    RUN_TEST(test_SeededSessionParams_sameSession_sees_plan_changes);
+
     return UNITY_END();
 }
@@ -81,6 +81,41 @@ void test_truncates_past_max_burst() {
     TEST_ASSERT_FLOAT_WITHIN(0.005f, 2.196f, v);
 }
 
+void test_first_sample_sets_estimate_directly() {
+    VbatEstimator e;
+    float v = e.addSample(168);
+    TEST_ASSERT_TRUE(e.hasReading());
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 3.689f, v);
+}
+
+void test_sample_window_rejects_sag_outlier() {
+    VbatEstimator e;
+    e.addSample(168);
+    e.addSample(168);
+    // A gap sample that still caught a sag: median of {168,168,120} = 168
+    float v = e.addSample(120);
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 3.689f, v);
+}
+
+void test_sample_window_slides_to_new_level() {
+    VbatEstimator e;
+    for (size_t i = 0; i < VBAT_SAMPLE_WINDOW; i++) {
+        e.addSample(150);  // 3.294V
+    }
+    // The median only moves once the new level holds the window majority
+    for (size_t i = 0; i < VBAT_SAMPLE_WINDOW / 2; i++) {
+        e.addSample(170);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 3.294f, e.voltage());
+
+    float v = 0.0f;
+    for (size_t i = VBAT_SAMPLE_WINDOW / 2; i < VBAT_SAMPLE_WINDOW; i++) {
+        v = e.addSample(170);  // 3.733V
+    }
+    // Five EMA steps toward 3.733V: 3.733 - 0.439 * 0.7^5 = 3.659
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 3.659f, v);
+}
+
 int main(int, char**) {
     UNITY_BEGIN();
     RUN_TEST(test_raw_to_volts_zero);
@@ -93,5 +128,8 @@ int main(int, char**) {
     RUN_TEST(test_ema_smooths_subsequent_bursts);
     RUN_TEST(test_even_count_median_uses_upper_middle);
     RUN_TEST(test_truncates_past_max_burst);
+    RUN_TEST(test_first_sample_sets_estimate_directly);
+    RUN_TEST(test_sample_window_rejects_sag_outlier);
+    RUN_TEST(test_sample_window_slides_to_new_level);
     return UNITY_END();
 }